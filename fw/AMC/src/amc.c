@@ -194,6 +194,13 @@ static void vTaskFuncMain( void );
  */
 static void vConfigureSharedMemTable( void );
 
+/**
+ * @brief   Add the telemetry channel to the shared memory table, once the
+ *          AMI is serving it, so the AMI can move health requests onto it
+ * @return  N/A
+ */
+static void vPublishTelemetryChannel( void );
+
 
 /******************************************************************************/
 /* Local variables                                                            */
@@ -391,6 +398,9 @@ static void vTaskFuncMain( void )
     PLL_INF( AMC_NAME,
              "ucGcqFalCreated                 %s\n\r",
              ( ullAmcInitStatus & AMC_CFG_GCQ_FAL_CREATED             ? "TRUE" : "FALSE" ) );
+    PLL_INF( AMC_NAME,
+             "ucGcqTelemetryFalCreated        %s\n\r",
+             ( ullAmcInitStatus & AMC_CFG_GCQ_TELEMETRY_FAL_CREATED   ? "TRUE" : "FALSE" ) );
 #if (HAL_EMMC_FEATURE == 1)
     PLL_INF( AMC_NAME,
              "ucEmmcFalCreated                %s\n\r",
@@ -566,6 +576,18 @@ static int iApcCallback( EVLSignal *pxSignal )
                 iStatus = iAMI_SetPdiProgramCompleteResponse( pxSignal, AMI_PROXY_RESULT_ALREADY_IN_PROGRESS );
                 break;
 
+            case APC_PROXY_DRIVER_E_DIGEST_COMPLETE:
+                iStatus = iAMI_SetPartitionDigestResponse( pxSignal, AMI_PROXY_RESULT_SUCCESS );
+                break;
+
+            case APC_PROXY_DRIVER_E_DIGEST_FAILED:
+                iStatus = iAMI_SetPartitionDigestResponse( pxSignal, AMI_PROXY_RESULT_FAILURE );
+                break;
+
+            case APC_PROXY_DRIVER_E_DIGEST_BUSY:
+                iStatus = iAMI_SetPartitionDigestResponse( pxSignal, AMI_PROXY_RESULT_ALREADY_IN_PROGRESS );
+                break;
+
             default:
                 break;
         }
@@ -893,12 +915,28 @@ static int iInitProxies( void )
                                    &xGcqIf,
                                    0,
                                    AMC_TASK_PRIO_DEFAULT,
-                                   AMC_TASK_DEFAULT_STACK ) )
+                                   AMC_TASK_DEFAULT_STACK,
+                                   HAL_AMI_RX_DATA_SIZE,
+                                   HAL_RPU_SHARED_MEMORY_SIZE ) )
         {
             if( OK == iAMI_BindCallback( &iAmiCallback ) )
             {
                 PLL_INF( AMC_NAME, "AMI Proxy Driver initialised and bound\r\n" );
                 ullAmcInitStatus |= AMC_CFG_AMI_INITIALISED;
+
+                /* Without the telemetry channel the AMI keeps using the first one */
+                if( AMC_CFG_GCQ_TELEMETRY_FAL_CREATED == ( ullAmcInitStatus & AMC_CFG_GCQ_TELEMETRY_FAL_CREATED ) )
+                {
+                    if( OK == iAMI_AddChannel( &xGcqTelemetryIf, 0 ) )
+                    {
+                        vPublishTelemetryChannel();
+                        PLL_INF( AMC_NAME, "AMI telemetry channel added\r\n" );
+                    }
+                    else
+                    {
+                        PLL_ERR( AMC_NAME, "Error adding AMI telemetry channel\r\n" );
+                    }
+                }
             }
             else
             {
@@ -1111,7 +1149,8 @@ static void vConfigureSharedMemTable( void )
     xShmTable.ulMagicNum                = HAL_SHARED_MEM_TABLE_MAGIC_NO;
     xShmTable.xRingBuf.ulRingBufOffset  = HAL_SHARED_MEM_TABLE_SIZE;
     xShmTable.xRingBuf.ulRingBufLen     = HAL_RPU_RING_BUFFER_LEN;
-    xShmTable.xStatus.ulStatusOff       = HAL_SHARED_MEM_TABLE_SIZE + HAL_RPU_RING_BUFFER_LEN;
+    xShmTable.xStatus.ulStatusOff       = ( HAL_RPU_TELEMETRY_DATA_BASE - HAL_RPU_SHARED_MEMORY_BASEADDR ) +
+                                          HAL_RPU_TELEMETRY_DATA_LEN;
     xShmTable.xStatus.ulStatusLen       = sizeof( uint32_t );
     xShmTable.xUuid.ulUuidOff           = xShmTable.xStatus.ulStatusOff + xShmTable.xStatus.ulStatusLen;
     xShmTable.xUuid.ulUuidLen           = HAL_UUID_SIZE;
@@ -1122,6 +1161,8 @@ static void vConfigureSharedMemTable( void )
                                           xShmTable.xLogMsg.ulLogMsgBufLen;
     xShmTable.xData.ulDataEnd           = HAL_RPU_SHARED_MEMORY_SIZE;
 
+    /* The telemetry ring and data are reserved above, xTelemetry stays zero until they are served */
+
     /* Copy the populated table into the start of shared memory */
     pucDestAdd = ( uint8_t* )( HAL_RPU_SHARED_MEMORY_BASEADDR );
     pvOSAL_MemCpy( pucDestAdd, ( uint8_t* )&xShmTable, sizeof( xShmTable ) );
@@ -1158,6 +1199,24 @@ static void vConfigureSharedMemTable( void )
                           xShmTable.xUuid.ulUuidLen );
 }
 
+/**
+ * @brief   Add the telemetry channel to the shared memory table
+ */
+static void vPublishTelemetryChannel( void )
+{
+    HALShmTableChannel xTelemetry = { 0 };
+    uintptr_t ulTelemetryAddr = HAL_RPU_SHARED_MEMORY_BASEADDR + offsetof( HALShmTable, xTelemetry );
+
+    xTelemetry.ulGcqOffset     = HAL_GCQ_TELEMETRY_BASEADDR - HAL_GCQ_SHARED_BASEADDR;
+    xTelemetry.ulRingBufOffset = HAL_RPU_TELEMETRY_RING_BUFFER_BASE - HAL_RPU_SHARED_MEMORY_BASEADDR;
+    xTelemetry.ulRingBufLen    = HAL_RPU_TELEMETRY_RING_BUFFER_LEN;
+    xTelemetry.ulDataOffset    = HAL_RPU_TELEMETRY_DATA_BASE - HAL_RPU_SHARED_MEMORY_BASEADDR;
+    xTelemetry.ulDataLen       = HAL_RPU_TELEMETRY_DATA_LEN;
+
+    pvOSAL_MemCpy( ( uint8_t* )ulTelemetryAddr, ( uint8_t* )&xTelemetry, sizeof( xTelemetry ) );
+    HAL_FLUSH_CACHE_DATA( ulTelemetryAddr, sizeof( xTelemetry ) );
+}
+
 /**
  * @brief   Load PDI from OSPI flash on power-up using PLM
  *
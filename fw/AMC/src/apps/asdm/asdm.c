@@ -67,8 +67,6 @@
 /* Value, Max & Average */
 #define SENSOR_RESPONSE_VALUES ( 0x3 )
 
-#define SENSOR_RESP_BUFFER_SIZE ( 512 )
-
 #define TOTAL_POWER_NUM_RECORDS ( 1 )
 #define FPT_NUM_RECORDS         ( 1 )
 #define BOARD_INFO_NUM_RECORDS  ( 1 )
@@ -3727,12 +3725,12 @@ static int iPopulateAsdmGetSdrResponse( ASDM_REPOSITORY_TYPE xRepo,
 }
 
 /**
- * @brief   Returns the buffer populated with associated response
+ * @brief   Populate the associated response directly into the destination
  */
 int iASDM_PopulateResponse( ASDM_API_ID_TYPE xApiType,
                             ASDM_REPOSITORY_TYPE xAsdmRepo,
                             uint8_t ucSensorId,
-                            uint8_t *pucRespBuff,
+                            const ASDMResponseDest *pxDest,
                             uint16_t *pusRespSizeBytes )
 {
     int iStatus = ERROR;
@@ -3740,9 +3738,14 @@ int iASDM_PopulateResponse( ASDM_API_ID_TYPE xApiType,
     if ( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
          ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
          ( TRUE == pxThis->iInitialised ) &&
-         ( NULL != pucRespBuff ) &&
+         ( NULL != pxDest ) &&
+         ( NULL != pxDest->pucBuff ) &&
+         ( ASDM_RESPONSE_MAX_SIZE <= pxDest->ulMaxSize ) &&
          ( NULL != pusRespSizeBytes ) )
     {
+        /* The populate functions serialise straight into the destination */
+        uint8_t *pucRespBuff = pxDest->pucBuff;
+
         switch ( xApiType )
         {
             case ASDM_API_ID_TYPE_GET_SDR_SIZE:
@@ -22,6 +22,9 @@
 #define ASDM_SDR_RESP_BYTE_REPO_TYPE        ( 0x1 )
 #define ASDM_SDR_RESP_BYTE_SIZE             ( 0x2 )
 
+/* Largest response any of the ASDM APIs populates */
+#define ASDM_RESPONSE_MAX_SIZE              ( 512 )
+
 /******************************************************************************/
 /* Enums                                                                      */
 /******************************************************************************/
@@ -77,6 +80,27 @@ typedef enum
 
 } ASDM_SDR_COMPLETION_CODE;
 
+/******************************************************************************/
+/* Structs                                                                    */
+/******************************************************************************/
+
+/**
+ * @struct  ASDMResponseDest
+ * @brief   Where a response is populated
+ *
+ * @note    The response is serialised in place, so pucBuff may point straight
+ *          into the shared memory window. Flushing the data cache over the
+ *          populated bytes is left to the caller, once, after the response is
+ *          complete.
+ */
+typedef struct
+{
+    uint8_t  *pucBuff;      /* Start of the destination */
+    uint32_t ulMaxSize;     /* Bytes available at pucBuff */
+
+} ASDMResponseDest;
+
+
 /******************************************************************************/
 /* Function declarations                                                      */
 /******************************************************************************/
@@ -92,13 +116,13 @@ typedef enum
 int iASDM_Initialise( uint8_t ucNumSensors );
 
 /**
- * @brief   Returns the buffer populated with associated response
+ * @brief   Populate the associated response directly into the destination
  *
  * @param   xApiType          The associated API type
  * @param   xAsdmRepo         The repo type
  * @param   ucSensorId        The sensor ID, if applicable
- * @param   pucRespBuff       The buffer to be populated with the response
- * @param   pusRespSizeBytes  Max buffer size passed in, number of bytes populated returned
+ * @param   pxDest            The destination, must hold ASDM_RESPONSE_MAX_SIZE bytes
+ * @param   pusRespSizeBytes  Number of bytes populated
  *
  * @return  OK          Successfully populated the response
  *          ERROR       Failed to populate the response
@@ -106,7 +130,7 @@ int iASDM_Initialise( uint8_t ucNumSensors );
 int iASDM_PopulateResponse( ASDM_API_ID_TYPE xApiType,
                             ASDM_REPOSITORY_TYPE xAsdmRepo,
                             uint8_t ucSensorId,
-                            uint8_t *pucRespBuff,
+                            const ASDMResponseDest *pxDest,
                             uint16_t *pusRespSizeBytes );
 
 /**
@@ -388,6 +388,9 @@ static const char *pcBimStatusStr[] =
                  case APC_PROXY_DRIVER_E_PARTITION_SELECTION_FAILED:
                  case APC_PROXY_DRIVER_E_POR_TRIGGERED:
                  case APC_PROXY_DRIVER_E_POR_FAILED:
+                 case APC_PROXY_DRIVER_E_DIGEST_COMPLETE:
+                 case APC_PROXY_DRIVER_E_DIGEST_BUSY:
+                 case APC_PROXY_DRIVER_E_DIGEST_FAILED:
                      break;
 
                  default:
@@ -39,7 +39,6 @@
 #define IN_BAND_NAME "AMC_IN_BAND"
 
 #define SENSOR_RESPONSE_VALUES  ( 0x3 )
-#define SENSOR_RESP_BUFFER_SIZE ( 512 )
 #define INVALID_SENSOR_ID       ( 0xFF )
 
 /* Stat & Error definitions */
@@ -52,6 +51,7 @@
     DO( IN_BAND_STATS_AMI_MODULE_RW_REQUEST )       \
     DO( IN_BAND_STATS_AMI_DEBUG_VERBOSITY_REQUEST ) \
     DO( IN_BAND_STATS_AMI_FPT_FLAGS_REQUEST )       \
+    DO( IN_BAND_STATS_AMI_DIGEST_REQUEST )          \
     DO( IN_BAND_STATS_INIT_MUTEX )                  \
     DO( IN_BAND_STATS_TAKE_MUTEX )                  \
     DO( IN_BAND_STATS_RELEASE_MUTEX )               \
@@ -174,6 +174,27 @@ static int iAmiCallback( EVLSignal *pxSignal );
 static int iMapAmiProxyRequestRepo( AMI_PROXY_CMD_SENSOR_REPO xRepo,
                                     ASDM_REPOSITORY_TYPE *pxRepo );
 
+/**
+ * @brief   Read a contiguous block of bytes from a QSFP module memory map
+ *
+ * @param   ucExDeviceId    External device ID
+ * @param   ucPage          Page number
+ * @param   ucByteOffset    Offset of the first byte within the memory map
+ * @param   ucLength        Number of bytes to read
+ * @param   pucData         Pointer to the destination buffer
+ *
+ * @return  OK or ERROR
+ *
+ * @note    Any part of the block in the upper page is fetched with a single
+ *          page read. The AXC has no block read for the lower page, so those
+ *          bytes are read one at a time (still without any extra GCQ hops).
+ */
+static int iReadModuleBlock( uint8_t ucExDeviceId,
+                             uint8_t ucPage,
+                             uint8_t ucByteOffset,
+                             uint8_t ucLength,
+                             uint8_t *pucData );
+
 
 /******************************************************************************/
 /* Function Implementations                                                   */
@@ -325,21 +346,26 @@ static int iAmiCallback( EVLSignal *pxSignal )
                 ASDM_REPOSITORY_TYPE xRepo          = 0;
                 AMI_PROXY_RESULT     xResult        = AMI_PROXY_RESULT_INVALID_VALUE;
                 uint16_t             usResponseSize = 0;
-                uint8_t              ucRespBuffer[ SENSOR_RESP_BUFFER_SIZE ] =
-                {
-                    0
-                };
                 uintptr_t ullDestAddr = ( pxThis->ullSharedMemBaseAddr + xSensorRequest.ullAddress );
                 uint8_t   *pucDestAdd = ( uint8_t* )( ullDestAddr );
+                uint8_t   *pucInline  = NULL;
+                uint32_t  ulInlineSize = 0;
+
+                /* ASDM serialises the response straight into the shared memory */
+                ASDMResponseDest xDest =
+                {
+                    pucDestAdd,
+                    xSensorRequest.ulLength
+                };
 
                 /* Reset iStatus */
                 iStatus = ERROR;
 
-                if (SENSOR_RESP_BUFFER_SIZE > xSensorRequest.ulLength)
+                if (ASDM_RESPONSE_MAX_SIZE > xSensorRequest.ulLength)
                 {
                     PLL_DBG( IN_BAND_NAME,
                              "Response size 0x%x exceeding request size 0x%x",
-                             SENSOR_RESP_BUFFER_SIZE,
+                             ASDM_RESPONSE_MAX_SIZE,
                              xSensorRequest.ulLength );
                     INC_ERROR_COUNTER( IN_BAND_ERRORS_AMI_SENSOR_RESP_SIZE_TOO_SMALL )
                 }
@@ -357,7 +383,7 @@ static int iAmiCallback( EVLSignal *pxSignal )
                                 iStatus = iASDM_PopulateResponse( ASDM_API_ID_TYPE_GET_SDR_SIZE,
                                                                 xRepo,
                                                                 INVALID_SENSOR_ID,
-                                                                ucRespBuffer,
+                                                                &xDest,
                                                                 &usResponseSize );
                                 break;
 
@@ -366,7 +392,7 @@ static int iAmiCallback( EVLSignal *pxSignal )
                                 iStatus = iASDM_PopulateResponse( ASDM_API_ID_TYPE_GET_SDR,
                                                                 xRepo,
                                                                 INVALID_SENSOR_ID,
-                                                                ucRespBuffer,
+                                                                &xDest,
                                                                 &usResponseSize );
                                 break;
 
@@ -375,7 +401,7 @@ static int iAmiCallback( EVLSignal *pxSignal )
                                 iStatus = iASDM_PopulateResponse( ASDM_API_ID_TYPE_GET_SINGLE_SENSOR_DATA,
                                                                 xRepo,
                                                                 xSensorRequest.ulSensorId,
-                                                                ucRespBuffer,
+                                                                &xDest,
                                                                 &usResponseSize );
                                 break;
 
@@ -384,7 +410,7 @@ static int iAmiCallback( EVLSignal *pxSignal )
                                 iStatus = iASDM_PopulateResponse( ASDM_API_ID_TYPE_GET_ALL_SENSOR_DATA,
                                                                 xRepo,
                                                                 INVALID_SENSOR_ID,
-                                                                ucRespBuffer,
+                                                                &xDest,
                                                                 &usResponseSize );
                                 break;
 
@@ -400,14 +426,34 @@ static int iAmiCallback( EVLSignal *pxSignal )
                     }
                 }
 
+                /* Small responses go back inline in the completion entry if the host asked */
+                if (OK != iAMI_GetInlineResponseBuffer( pxSignal, &pucInline, &ulInlineSize ))
+                {
+                    pucInline = NULL;
+                }
+
                 /* Check the response is not greater than the shared memory supplied */
                 if (( OK == iStatus ) &&
-                    ( usResponseSize <= xSensorRequest.ulLength ))
+                    ( NULL != pucInline ) &&
+                    ( usResponseSize <= ulInlineSize ))
                 {
-                    /* Copy the data into the shared memory */
-                    pvOSAL_MemCpy( pucDestAdd, ucRespBuffer, usResponseSize );
-
-                    /* This is required on the target to flush the data */
+                    /* The shared memory copy is never read, so it is not flushed */
+                    pvOSAL_MemCpy( pucInline, pucDestAdd, usResponseSize );
+                    iStatus = iAMI_SetInlineResponseSize( pxSignal, usResponseSize );
+                    if (OK == iStatus)
+                    {
+                        xResult = AMI_PROXY_RESULT_SUCCESS;
+                        INC_STAT_COUNTER( IN_BAND_STATS_AMI_SENSOR_REQUEST_SUCCESS )
+                    }
+                    else
+                    {
+                        INC_ERROR_COUNTER( IN_BAND_ERRORS_AMI_SENSOR_REQUEST_FAILED )
+                    }
+                }
+                else if (( OK == iStatus ) &&
+                         ( usResponseSize <= xSensorRequest.ulLength ))
+                {
+                    /* Already in the shared memory, a single flush publishes it to the host */
                     HAL_FLUSH_CACHE_DATA( ullDestAddr, usResponseSize );
 
                     xResult = AMI_PROXY_RESULT_SUCCESS;
@@ -416,8 +462,16 @@ static int iAmiCallback( EVLSignal *pxSignal )
                 else
                 {
                     /* Single byte response for failure */
+                    if (NULL != pucInline)
+                    {
+                        pucDestAdd = pucInline;
+                    }
                     pucDestAdd[ ASDM_SDR_RESP_BYTE_CC ]   = ASDM_SDR_COMPLETION_CODE_OPERATION_FAILED;
                     pucDestAdd[ ASDM_SDR_RESP_BYTE_SIZE ] = 1;
+                    if (NULL != pucInline)
+                    {
+                        ( void )iAMI_SetInlineResponseSize( pxSignal, ASDM_SDR_RESP_BYTE_SIZE + 1 );
+                    }
                     INC_ERROR_COUNTER( IN_BAND_ERRORS_AMI_SENSOR_REQUEST_FAILED )
                 }
                 iStatus = iAMI_SetSensorCompleteResponse( pxSignal, xResult );
@@ -435,17 +489,38 @@ static int iAmiCallback( EVLSignal *pxSignal )
             {
                 uintptr_t        ullDestAddr  = pxThis->ullSharedMemBaseAddr + xEepromReadWriteRequest.ullAddress;
                 uint8_t          *pucDestAddr = ( uint8_t* )( ullDestAddr );
+                uint8_t          *pucInline   = NULL;
+                uint32_t         ulInlineSize = 0;
                 AMI_PROXY_RESULT xResult      = AMI_PROXY_RESULT_FAILURE;
 
                 switch (xEepromReadWriteRequest.xRequest)
                 {
                     case AMI_PROXY_CMD_RW_REQUEST_READ:
-                        iStatus = iEEPROM_ReadRawValue( pucDestAddr,
-                                                        xEepromReadWriteRequest.ulLength,
-                                                        xEepromReadWriteRequest.ulOffset );
+                        if (OK == iAMI_GetInlineResponseBuffer( pxSignal, &pucInline, &ulInlineSize ))
+                        {
+                            /* The host supplied no shared memory, the data goes back inline */
+                            iStatus = ERROR;
+                            if (xEepromReadWriteRequest.ulLength <= ulInlineSize)
+                            {
+                                iStatus = iEEPROM_ReadRawValue( pucInline,
+                                                                xEepromReadWriteRequest.ulLength,
+                                                                xEepromReadWriteRequest.ulOffset );
+                            }
+                            if (OK == iStatus)
+                            {
+                                iStatus = iAMI_SetInlineResponseSize( pxSignal,
+                                                                      xEepromReadWriteRequest.ulLength );
+                            }
+                        }
+                        else
+                        {
+                            iStatus = iEEPROM_ReadRawValue( pucDestAddr,
+                                                            xEepromReadWriteRequest.ulLength,
+                                                            xEepromReadWriteRequest.ulOffset );
 
-                        /* Flush shared memory so the latest data is available in cache. */
-                        HAL_FLUSH_CACHE_DATA( ullDestAddr, xEepromReadWriteRequest.ulLength );
+                            /* Flush shared memory so the latest data is available in cache. */
+                            HAL_FLUSH_CACHE_DATA( ullDestAddr, xEepromReadWriteRequest.ulLength );
+                        }
                         break;
 
                     case AMI_PROXY_CMD_RW_REQUEST_WRITE:
@@ -482,6 +557,8 @@ static int iAmiCallback( EVLSignal *pxSignal )
             {
                 uintptr_t        ullDestAddr  = pxThis->ullSharedMemBaseAddr + xModuleReadWriteRequest.ullAddress;
                 uint8_t          *pucDestAddr = ( uint8_t* )( ullDestAddr );
+                uint8_t          *pucInline   = NULL;
+                uint32_t         ulInlineSize = 0;
                 AMI_PROXY_RESULT xResult      = AMI_PROXY_RESULT_FAILURE;
 
                 /* Check if the request is valid */
@@ -494,10 +571,25 @@ static int iAmiCallback( EVLSignal *pxSignal )
                     switch (xModuleReadWriteRequest.xRequest)
                     {
                         case AMI_PROXY_CMD_RW_REQUEST_READ:
+                            if (OK == iAMI_GetInlineResponseBuffer( pxSignal, &pucInline, &ulInlineSize ))
+                            {
+                                /* The host supplied no shared memory, the data goes back inline */
+                                if (xModuleReadWriteRequest.ucLength > ulInlineSize)
+                                {
+                                    iStatus = ERROR;
+                                    break;
+                                }
+                                pucDestAddr = pucInline;
+                            }
+
                             if (1 < xModuleReadWriteRequest.ucLength)
                             {
-                                /* TODO: Implement block read. */
-                                iStatus = ERROR;
+                                /* Block read. */
+                                iStatus = iReadModuleBlock( xModuleReadWriteRequest.ucExDeviceId,
+                                            xModuleReadWriteRequest.ucPage,
+                                            xModuleReadWriteRequest.ucByteOffset,
+                                            xModuleReadWriteRequest.ucLength,
+                                            pucDestAddr );
                             }
                             else
                             {
@@ -508,8 +600,19 @@ static int iAmiCallback( EVLSignal *pxSignal )
                                             pucDestAddr );
                             }
 
-                            /* Flush shared memory so the latest data is available in cache. */
-                            HAL_FLUSH_CACHE_DATA( ullDestAddr, xModuleReadWriteRequest.ucLength );
+                            if (NULL != pucInline)
+                            {
+                                if (OK == iStatus)
+                                {
+                                    iStatus = iAMI_SetInlineResponseSize( pxSignal,
+                                                                          xModuleReadWriteRequest.ucLength );
+                                }
+                            }
+                            else
+                            {
+                                /* Flush shared memory so the latest data is available in cache. */
+                                HAL_FLUSH_CACHE_DATA( ullDestAddr, xModuleReadWriteRequest.ucLength );
+                            }
                             break;
 
                         case AMI_PROXY_CMD_RW_REQUEST_WRITE:
@@ -843,6 +946,45 @@ static int iAmiCallback( EVLSignal *pxSignal )
             break;
         }
 
+        case AMI_PROXY_DRIVER_E_PARTITION_DIGEST:
+        {
+            AMIProxyPartitionDigestRequest xDigestRequest = { 0 };
+            INC_STAT_COUNTER( IN_BAND_STATS_AMI_DIGEST_REQUEST )
+
+            if (OK == iAMI_GetPartitionDigestRequest( pxSignal, &xDigestRequest ))
+            {
+                /* Digest is written straight into the host's shared memory buffer */
+                uintptr_t ullDestAddr = pxThis->ullSharedMemBaseAddr + xDigestRequest.ullAddress;
+
+                PLL_DBG( IN_BAND_NAME, "Digest boot device   : 0x%x\r\n", xDigestRequest.ulBootDevice );
+                PLL_DBG( IN_BAND_NAME, "Digest partition     : 0x%x\r\n", xDigestRequest.ulPartition );
+                PLL_DBG( IN_BAND_NAME, "Digest length        : 0x%x\r\n", xDigestRequest.ulLength );
+
+                if (OK == iAPC_DigestPartition( pxSignal,
+                                                ( APC_BOOT_DEVICES )xDigestRequest.ulBootDevice,
+                                                ( int )xDigestRequest.ulPartition,
+                                                xDigestRequest.ulLength,
+                                                ( uint8_t* )ullDestAddr ))
+                {
+                    iStatus = OK;
+                }
+                else
+                {
+                    iStatus = iAMI_SetPartitionDigestResponse( pxSignal, AMI_PROXY_RESULT_PROCESS_REQUEST_FAILED );
+                }
+            }
+            else
+            {
+                iStatus = iAMI_SetPartitionDigestResponse( pxSignal, AMI_PROXY_RESULT_GET_REQUEST_FAILED );
+            }
+
+            if (OK != iStatus)
+            {
+                PLL_ERR( IN_BAND_NAME, "Error digesting partition %d\r\n", xDigestRequest.ulPartition );
+            }
+            break;
+        }
+
         case AMI_PROXY_DRIVER_E_GET_IDENTITY:
         case AMI_PROXY_DRIVER_E_HEARTBEAT:
         default:
@@ -912,3 +1054,49 @@ static int iMapAmiProxyRequestRepo( AMI_PROXY_CMD_SENSOR_REPO xRepo, ASDM_REPOSI
     }
     return iStatus;
 }
+
+/*
+ * @brief   Read a contiguous block of bytes from a QSFP module memory map
+ */
+static int iReadModuleBlock( uint8_t ucExDeviceId,
+                             uint8_t ucPage,
+                             uint8_t ucByteOffset,
+                             uint8_t ucLength,
+                             uint8_t *pucData )
+{
+    int      iStatus  = ERROR;
+    uint32_t ulOffset = ucByteOffset;
+    uint32_t ulEnd    = ( uint32_t )ucByteOffset + ucLength;
+
+    if (( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( NULL != pucData ) &&
+        ( 0 < ucLength ) &&
+        ( AXC_PAGE_SIZE >= ulEnd ))
+    {
+        iStatus = OK;
+
+        /* Lower page - byte at a time */
+        while (( OK == iStatus ) && ( AXC_LOWER_PAGE_SIZE > ulOffset ) && ( ulEnd > ulOffset ))
+        {
+            iStatus = iAXC_GetByte( ucExDeviceId, ucPage, ulOffset, &pucData[ ulOffset - ucByteOffset ] );
+            ulOffset++;
+        }
+
+        /* Upper page - single page read */
+        if (( OK == iStatus ) && ( ulEnd > ulOffset ))
+        {
+            AXCProxyDriverPageData xPageData = { 0 };
+
+            iStatus = iAXC_GetPage( ucExDeviceId, ucPage, &xPageData );
+            if (OK == iStatus)
+            {
+                pvOSAL_MemCpy( &pucData[ ulOffset - ucByteOffset ],
+                               &xPageData.pucPageData[ ulOffset - AXC_LOWER_PAGE_SIZE ],
+                               ulEnd - ulOffset );
+            }
+        }
+    }
+
+    return iStatus;
+}
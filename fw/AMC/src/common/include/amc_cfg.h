@@ -37,6 +37,7 @@
 #define AMC_CFG_OSPI_FAL_CREATED             ( ( uint64_t )1 << 27 )
 #define AMC_CFG_SMBUS_FAL_INITIALISED        ( ( uint64_t )1 << 28 )
 #define AMC_CFG_SMBUS_FAL_CREATED            ( ( uint64_t )1 << 29 )
+#define AMC_CFG_GCQ_TELEMETRY_FAL_CREATED    ( ( uint64_t )1 << 30 )
 
 /* Initialise Proxies */
 #define AMC_CFG_APC_INITIALISED              ( ( uint64_t )1 << 40 )
@@ -208,10 +208,82 @@ GCQ_ERRORS_TYPE xGCQConsumeData( GCQInstance *pxGCQInstance,
  * @param    ulDataLen the length of the data being sent
  *
  * @return   See GCQ_ERRORS_TYPE for possible return values
+ *
+ * @note     Once the host has negotiated a CQ entry extension, a producer may
+ *           send up to the slot size plus the extension size (less its length
+ *           word); the bytes past the slot are written to the extension.
  */
 GCQ_ERRORS_TYPE xGCQProduceData( GCQInstance *pxGCQInstance,
     uint8_t *pucData, uint32_t ulDataLen );
 
+/**
+ * @brief    Function to consume/read all available data from the sGCQ
+ *           Internally the function will:
+ *           - Check driver has been initilaised
+ *           - Check driver has attached to the consumer
+ *           - Read the produced pointer once
+ *           - Copy up to ulMaxSlots slots, handling the ring wrap
+ *           - Write the consumed pointer once for the whole batch
+ *
+ * @param    pxGCQInstance is the instance of the sGCQ
+ * @param    pucData is the buffer to populate, ulMaxSlots * ulSlotLen bytes
+ * @param    ulSlotLen is the length of data to copy from each slot
+ * @param    ulMaxSlots is the maximum number of slots to consume
+ * @param    pulNumSlots is the number of slots actually consumed
+ *
+ * @return   See GCQ_ERRORS_TYPE for possible return values
+ */
+GCQ_ERRORS_TYPE xGCQConsumeDataBatch( GCQInstance *pxGCQInstance,
+    uint8_t *pucData, uint32_t ulSlotLen, uint32_t ulMaxSlots, uint32_t *pulNumSlots );
+
+/**
+ * @brief    Function to produce/send a batch of data to the sGCQ
+ *           Internally the function will:
+ *           - Check driver has been initilaised
+ *           - Read the consumed pointer only if the cached free space is short
+ *           - Copy as many slots as will fit, handling the ring wrap
+ *           - Write the produced pointer once for the whole batch
+ *
+ * @param    pxGCQInstance is the instance of the sGCQ
+ * @param    pucData is the data to send, ulNumSlots * ulSlotLen bytes
+ * @param    ulSlotLen is the length of data to copy into each slot
+ * @param    ulNumSlots is the number of slots to send
+ * @param    pulNumProduced is the number of slots actually sent
+ *
+ * @return   See GCQ_ERRORS_TYPE for possible return values
+ */
+GCQ_ERRORS_TYPE xGCQProduceDataBatch( GCQInstance *pxGCQInstance,
+    uint8_t *pucData, uint32_t ulSlotLen, uint32_t ulNumSlots, uint32_t *pulNumProduced );
+
+/**
+ * @brief    Service completion coalescing, must be called periodically by a
+ *           producer so held back completions are published
+ *           Internally the function will:
+ *           - Check driver has been initilaised
+ *           - Reload the host coalescing and CQ extension config from the
+ *             header between bursts
+ *           - Publish the produced pointer once the max-delay has elapsed
+ *
+ * @param    pxGCQInstance is the instance of the sGCQ
+ * @param    ulNowMs is the current uptime in ms
+ *
+ * @return   See GCQ_ERRORS_TYPE for possible return values
+ *
+ * @note     The produced pointer is held back until either the host max-count
+ *           is reached or max-delay has passed, so a burst of responses is
+ *           seen by the host as a single update.
+ */
+GCQ_ERRORS_TYPE xGCQServiceCoalescing( GCQInstance *pxGCQInstance, uint32_t ulNowMs );
+
+/**
+ * @brief    Publish any completions held back by coalescing immediately
+ *
+ * @param    pxGCQInstance is the instance of the sGCQ
+ *
+ * @return   See GCQ_ERRORS_TYPE for possible return values
+ */
+GCQ_ERRORS_TYPE xGCQFlushCoalescing( GCQInstance *pxGCQInstance );
+
 /**
  * @brief    Gets version information from gcq_version.h
  *
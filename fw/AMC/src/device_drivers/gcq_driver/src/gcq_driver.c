@@ -113,6 +113,23 @@ static inline void prvvGCQFastForward( const GCQInstance *pxGCQInstance,
     prvvGCQRingReadConsumed( pxGCQInstance->pxGCQIOAccess, pxRing );
 }
 
+/**
+ * @brief   Publish the produced slots held back by completion coalescing
+ *
+ * @param   pxGCQInstance the gcq driver instance
+ *
+ * @return  N/A
+ */
+static inline void prvvGCQPublishPending( GCQInstance *pxGCQInstance )
+{
+    if ( 0 != pxGCQInstance->ulCoalescePending )
+    {
+        prvvGCQRingWriteProduced( pxGCQInstance->pxGCQIOAccess, pxGCQInstance->pxGCQProducer );
+        pxGCQInstance->ulCoalescePending = 0;
+        pxGCQInstance->iCoalesceTimerRunning = FALSE;
+    }
+}
+
 /**
  * @brief   Check if the producer has any more free slots
  *
@@ -121,7 +138,7 @@ static inline void prvvGCQFastForward( const GCQInstance *pxGCQInstance,
  *
  * @return  returns true if can produce
  */
-static inline uint32_t prvucGCQCanProduce( const GCQInstance *pxGCQInstance,
+static inline uint32_t prvucGCQCanProduce( GCQInstance *pxGCQInstance,
                                            GCQRing *pxRing )
 {
     uint32_t ulStatus = FALSE;
@@ -134,6 +151,8 @@ static inline uint32_t prvucGCQCanProduce( const GCQInstance *pxGCQInstance,
         }
         else
         {
+            /* The peer can't free slots it has not been told about */
+            prvvGCQPublishPending( pxGCQInstance );
             prvvGCQRingReadConsumed( pxGCQInstance->pxGCQIOAccess, pxRing );
             ulStatus = ( FALSE == prvucGCQRingIsFull( pxRing ) );
         }
@@ -141,6 +160,27 @@ static inline uint32_t prvucGCQCanProduce( const GCQInstance *pxGCQInstance,
     return ulStatus;
 }
 
+/**
+ * @brief   Check if the peer has gone away (e.g. the host has been reset)
+ *
+ * @param   pxGCQInstance the gcq driver instance
+ *
+ * @return  returns TRUE if both producer tail pointers read back as all ones
+ */
+static inline uint32_t prvulGCQPeerGone( const GCQInstance *pxGCQInstance )
+{
+    const GCQIOAccess *pxGCQIOAccess = pxGCQInstance->pxGCQIOAccess;
+
+    uint32_t ulSqTailPointer = pxGCQIOAccess->xGCQReadMem32(
+        pxGCQInstance->ullBaseAddr + GCQ_PRODUCER_SQ_TAIL_POINTER );
+
+    uint32_t ulCqTailPointer = pxGCQIOAccess->xGCQReadMem32(
+        pxGCQInstance->ullBaseAddr + GCQ_PRODUCER_CQ_TAIL_POINTER );
+
+    return ( ( ( uint32_t )-1 == ulSqTailPointer ) &&
+             ( ( uint32_t )-1 == ulCqTailPointer ) );
+}
+
 /**
  * @brief   Check if the consumer has data that can be consumed
  *
@@ -159,14 +199,7 @@ static inline uint32_t prvucGCQCanConsume( const GCQInstance *pxGCQInstance,
         const GCQIOAccess *pxGCQIOAccess = pxGCQInstance->pxGCQIOAccess;
 
         /* Check for errors */
-        uint32_t ulSqTailPointer = pxGCQIOAccess->xGCQReadMem32(
-            pxGCQInstance->ullBaseAddr + GCQ_PRODUCER_SQ_TAIL_POINTER );
-
-        uint32_t ulCqTailPointer = pxGCQIOAccess->xGCQReadMem32(
-            pxGCQInstance->ullBaseAddr + GCQ_PRODUCER_CQ_TAIL_POINTER );
-
-        if ( unlikely( ( ( uint32_t )-1 == ulSqTailPointer ) &&
-           ( ( uint32_t )-1 == ulCqTailPointer ) ) )
+        if ( unlikely( TRUE == prvulGCQPeerGone( pxGCQInstance ) ) )
         {
             ulStatus = FALSE;
         }
@@ -200,6 +233,117 @@ static inline void prvvGCQSoftReset( const GCQInstance *pxGCQInstance,
     prvvGCQRingWriteConsumed( pxGCQInstance->pxGCQIOAccess, pxRing );
 }
 
+/**
+ * @brief   Publish the produced pointer to the peer, or hold it back while
+ *          completion coalescing is enabled and below the count threshold
+ *
+ * @param   pxGCQInstance the gcq driver instance
+ * @param   ulNumSlots is the number of slots just produced
+ *
+ * @return  N/A
+ */
+static inline void prvvGCQPublishProduced( GCQInstance *pxGCQInstance,
+                                           uint32_t ulNumSlots )
+{
+    pxGCQInstance->ulCoalescePending += ulNumSlots;
+
+    if ( ( GCQ_MODE_TYPE_PRODUCER_MODE != pxGCQInstance->xMode ) ||
+         ( 1 >= pxGCQInstance->ulCoalesceCount ) ||
+         ( pxGCQInstance->ulCoalescePending >= pxGCQInstance->ulCoalesceCount ) )
+    {
+        prvvGCQPublishPending( pxGCQInstance );
+    }
+}
+
+/**
+ * @brief   Apply the host config found in the header flags: completion
+ *          coalescing and, if it fits in the ring, the CQ entry extension
+ *
+ * @param   pxGCQInstance the gcq driver instance
+ * @param   ulFlags is the value read from the header flags
+ *
+ * @return  N/A
+ */
+static inline void prvvGCQApplyHostFlags( GCQInstance *pxGCQInstance,
+                                          uint32_t ulFlags )
+{
+    GCQRing *pxRing = pxGCQInstance->pxGCQProducer;
+    uint32_t ulExtSize = 0;
+    uint64_t ullExtAddr = 0;
+
+    pxGCQInstance->ulCoalesceFlags = ulFlags;
+
+    if ( GCQ_HDR_FLAG_COALESCE & ulFlags )
+    {
+        pxGCQInstance->ulCoalesceCount = ulFlags & GCQ_HDR_COALESCE_COUNT_MASK;
+        pxGCQInstance->ulCoalesceDelayMs = ( ulFlags & GCQ_HDR_COALESCE_DELAY_MASK ) >>
+                                           GCQ_HDR_COALESCE_DELAY_SHIFT;
+
+        /* Holding back a full ring would leave no slot for the next entry */
+        if ( pxGCQInstance->ulCoalesceCount >= pxRing->ulRingNumSlots )
+        {
+            pxGCQInstance->ulCoalesceCount = pxRing->ulRingNumSlots - 1;
+        }
+    }
+    else
+    {
+        pxGCQInstance->ulCoalesceCount = 0;
+        pxGCQInstance->ulCoalesceDelayMs = 0;
+    }
+
+    if ( GCQ_HDR_FLAG_CQ_EXT & ulFlags )
+    {
+        ulExtSize = ( ( ulFlags & GCQ_HDR_CQ_EXT_SIZE_MASK ) >> GCQ_HDR_CQ_EXT_SIZE_SHIFT ) *
+                    GCQ_HDR_CQ_EXT_SIZE_UNIT;
+        ullExtAddr = pxRing->ullRingSlotAddr + ( uint64_t )pxRing->ulRingNumSlots * pxRing->ulRingSlotSize;
+
+        /* The host computed the same layout, refuse anything that overruns the ring */
+        if ( ( ullExtAddr + ( uint64_t )pxRing->ulRingNumSlots * ulExtSize ) >
+             ( pxGCQInstance->ullRingAddr + pxGCQInstance->ullRingLen ) )
+        {
+            GCQ_DEBUG( "Error: CQ extension of %ld bytes does not fit in the ring\r\n", ulExtSize );
+            ulExtSize = 0;
+            ullExtAddr = 0;
+        }
+    }
+
+    pxGCQInstance->ulProducerExtSize = ulExtSize;
+    pxGCQInstance->ullProducerExtAddr = ullExtAddr;
+
+    GCQ_DEBUG( "Coalescing count:%ld delay:%ldms CQ ext:%ld\r\n",
+               pxGCQInstance->ulCoalesceCount, pxGCQInstance->ulCoalesceDelayMs, ulExtSize );
+}
+
+/**
+ * @brief   Write the part of an entry which overflows the slot into the
+ *          extension paired with the slot, prefixed by its length
+ *
+ * @param   pxGCQInstance the gcq driver instance
+ * @param   ullSlotAddr is the address of the slot just produced
+ * @param   pucData is the overflow data, may be NULL if ulLen is 0
+ * @param   ulLen is the number of overflow bytes, 32-bit aligned
+ *
+ * @return  N/A
+ */
+static inline void prvvGCQWriteExt( const GCQInstance *pxGCQInstance,
+                                    uint64_t ullSlotAddr,
+                                    const uint8_t *pucData,
+                                    uint32_t ulLen )
+{
+    const GCQRing *pxRing = pxGCQInstance->pxGCQProducer;
+    uint64_t ullExtAddr = pxGCQInstance->ullProducerExtAddr +
+                          ( ( ullSlotAddr - pxRing->ullRingSlotAddr ) / pxRing->ulRingSlotSize ) *
+                          pxGCQInstance->ulProducerExtSize;
+
+    pxGCQInstance->pxGCQIOAccess->xGCQWriteMem32( ullExtAddr, ulLen );
+
+    if ( 0 != ulLen )
+    {
+        prvvGCQCopyToRing( pxGCQInstance->pxGCQIOAccess, ( uint32_t * )pucData,
+                           ullExtAddr + GCQ_CQ_EXT_LEN_SIZE, ulLen );
+    }
+}
+
 /**
  * @brief   Attempt to add data into the producer, can fail if no more
  *          free slots
@@ -476,7 +620,15 @@ GCQ_ERRORS_TYPE xGCQInit( GCQInstance **ppxGCQInstance,
             pxGCQInstance->ullGCQHeaderAddr = ullRingAddr;
             pxGCQInstance->ullBaseAddr      = ullBaseAddr;
             pxGCQInstance->ullRingAddr      = ullRingAddr;
+            pxGCQInstance->ullRingLen       = ullRingLen;
             pxGCQInstance->pxGCQIOAccess    = pxGCQIOAccess;
+            pxGCQInstance->ulCoalesceFlags  = 0;
+            pxGCQInstance->ulCoalesceCount  = 0;
+            pxGCQInstance->ulCoalesceDelayMs = 0;
+            pxGCQInstance->ulCoalescePending = 0;
+            pxGCQInstance->iCoalesceTimerRunning = FALSE;
+            pxGCQInstance->ulProducerExtSize = 0;
+            pxGCQInstance->ullProducerExtAddr = 0;
             pxGCQInstance->ulUpperFirewall  = UPPER_FIREWALL;
             pxGCQInstance->ulLowerFirewall  = LOWER_FIREWALL;
 
@@ -706,6 +858,7 @@ GCQ_ERRORS_TYPE xGCQProduceData( GCQInstance *pxGCQInstance,
     GCQ_ERRORS_TYPE xStatus = GCQ_ERRORS_INVALID_ARG;
 
     uint64_t ullSlotAddr = 0;
+    uint32_t ulSlotLen = ulDataLen;
 
     if ( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
          ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) )
@@ -717,6 +870,14 @@ GCQ_ERRORS_TYPE xGCQProduceData( GCQInstance *pxGCQInstance,
         {
             xStatus = GCQ_ERRORS_INVALID_INSTANCE;
         }
+        else if ( ( 0 != pxGCQInstance->ulProducerExtSize ) &&
+                  ( ulDataLen > pxGCQInstance->ulProducerSlotSize ) &&
+                  ( ulDataLen <= ( pxGCQInstance->ulProducerSlotSize +
+                                   pxGCQInstance->ulProducerExtSize - GCQ_CQ_EXT_LEN_SIZE ) ) )
+        {
+            /* The remainder goes into the extension negotiated by the host */
+            ulSlotLen = pxGCQInstance->ulProducerSlotSize;
+        }
         else if ( ulDataLen > pxGCQInstance->ulProducerSlotSize )
         {
             GCQ_DEBUG( " Error: length 0x%lx specified is larger than slot configured\r\n", ulDataLen );
@@ -741,7 +902,7 @@ GCQ_ERRORS_TYPE xGCQProduceData( GCQInstance *pxGCQInstance,
         {
             GCQ_DEBUG( "Write data to slot addr:0x%llx len:%ld\r\n", ullSlotAddr, ulDataLen );
 
-            for ( uint32_t offset = 0; offset < ulDataLen; offset += 4 )
+            for ( uint32_t offset = 0; offset < ulSlotLen; offset += 4 )
             {
                 pxGCQInstance->pxGCQIOAccess->xGCQWriteMem32(
                     ullSlotAddr + offset,
@@ -751,7 +912,13 @@ GCQ_ERRORS_TYPE xGCQProduceData( GCQInstance *pxGCQInstance,
                            *( uint32_t * )( pucData + offset ) );
             }
 
-            prvvGCQRingWriteProduced( pxGCQInstance->pxGCQIOAccess, pxGCQInstance->pxGCQProducer );
+            /* Always written once negotiated, so a stale length is never seen */
+            if ( 0 != pxGCQInstance->ulProducerExtSize )
+            {
+                prvvGCQWriteExt( pxGCQInstance, ullSlotAddr, pucData + ulSlotLen, ulDataLen - ulSlotLen );
+            }
+
+            prvvGCQPublishProduced( pxGCQInstance, 1 );
         }
         else
         {
@@ -761,6 +928,268 @@ GCQ_ERRORS_TYPE xGCQProduceData( GCQInstance *pxGCQInstance,
     return xStatus;
 }
 
+/**
+ * @brief    Function to consume all available data from the ring buffer
+ */
+GCQ_ERRORS_TYPE xGCQConsumeDataBatch( GCQInstance *pxGCQInstance,
+                                      uint8_t *pucData,
+                                      uint32_t ulSlotLen,
+                                      uint32_t ulMaxSlots,
+                                      uint32_t *pulNumSlots )
+{
+    GCQ_ERRORS_TYPE xStatus = GCQ_ERRORS_INVALID_ARG;
+
+    if ( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+         ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) )
+    {
+        xStatus = GCQ_ERRORS_NONE;
+
+        if ( ( NULL == pxGCQInstance ) ||
+             ( FALSE == pxGCQInstance->iInitialised ) )
+        {
+            xStatus = GCQ_ERRORS_INVALID_INSTANCE;
+        }
+        /* Check if it is attached */
+        else if ( ( GCQ_MODE_TYPE_CONSUMER_MODE == pxGCQInstance->xMode ) &&
+                  ( FALSE == pxThis->ucConsumerAttached ) )
+        {
+            xStatus = GCQ_ERRORS_CONSUMER_NOT_ATTACHED;
+        }
+        else if ( ulSlotLen > pxGCQInstance->ulConsumerSlotSize )
+        {
+            GCQ_DEBUG( " Error: length 0x%lx specified is larger than slot configured\r\n",
+                       ulSlotLen );
+            xStatus = GCQ_ERRORS_INVALID_ARG;
+        }
+        else if ( ( NULL == pucData ) || ( NULL == pulNumSlots ) || ( 0 == ulMaxSlots ) )
+        {
+            xStatus = GCQ_ERRORS_INVALID_ARG;
+        }
+        else if ( !CHECK_32BIT_ALIGNMENT( ulSlotLen ) )
+        {
+            GCQ_DEBUG( " Error: length 0x%lx is not 32bit aligned\r\n", ulSlotLen );
+            xStatus = GCQ_ERRORS_INVALID_ARG;
+        }
+
+        if ( GCQ_ERRORS_NONE == xStatus )
+        {
+            GCQRing *pxRing = pxGCQInstance->pxGCQConsumer;
+            uint32_t ulAvailable = 0;
+            uint32_t ulCount = 0;
+
+            *pulNumSlots = 0;
+
+            /* A peer that has gone away leaves nothing available, as in prvucGCQCanConsume */
+            if ( likely( FALSE == prvulGCQPeerGone( pxGCQInstance ) ) )
+            {
+                /* Single read of the produced pointer for the whole batch */
+                prvvGCQRingReadProduced( pxGCQInstance->pxGCQIOAccess, pxRing );
+                ulAvailable = pxRing->ulRingProduced - pxRing->ulRingConsumed;
+            }
+
+            if ( unlikely( ulAvailable > pxRing->ulRingNumSlots ) )
+            {
+                /* The produced pointer is corrupt */
+                xStatus = GCQ_ERRORS_CONSUMER_NOT_AVAILABLE;
+            }
+            else if ( 0 == ulAvailable )
+            {
+                xStatus = GCQ_ERRORS_CONSUMER_NO_DATA_RECEIVED;
+            }
+            else
+            {
+                if ( ulAvailable > ulMaxSlots )
+                {
+                    ulAvailable = ulMaxSlots;
+                }
+
+                /* The slot index is masked by the ring size, so wrap is implicit */
+                for ( ulCount = 0; ulCount < ulAvailable; ulCount++ )
+                {
+                    uint64_t ullSlotAddr = prvullGCQRingGetSlotPtrConsumed( pxRing );
+
+                    GCQ_DEBUG( "Read data from slot addr:0x%llx len:%ld\r\n", ullSlotAddr, ulSlotLen );
+                    prvvGCQCopyFromRing( pxGCQInstance->pxGCQIOAccess,
+                                         ( uint32_t * )( pucData + ( ulCount * ulSlotLen ) ),
+                                         ullSlotAddr,
+                                         ulSlotLen );
+                    pxRing->ulRingConsumed++;
+                }
+
+                /* Notify the peer once for the whole batch */
+                prvvGCQRingWriteConsumed( pxGCQInstance->pxGCQIOAccess, pxRing );
+                *pulNumSlots = ulCount;
+            }
+        }
+    }
+    return xStatus;
+}
+
+/**
+ * @brief    Function to provide a batch of data and populate the ring buffer
+ */
+GCQ_ERRORS_TYPE xGCQProduceDataBatch( GCQInstance *pxGCQInstance,
+                                      uint8_t *pucData,
+                                      uint32_t ulSlotLen,
+                                      uint32_t ulNumSlots,
+                                      uint32_t *pulNumProduced )
+{
+    GCQ_ERRORS_TYPE xStatus = GCQ_ERRORS_INVALID_ARG;
+
+    if ( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+         ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) )
+    {
+        xStatus = GCQ_ERRORS_NONE;
+
+        if ( ( NULL == pxGCQInstance ) ||
+             ( FALSE == pxGCQInstance->iInitialised ) )
+        {
+            xStatus = GCQ_ERRORS_INVALID_INSTANCE;
+        }
+        else if ( ulSlotLen > pxGCQInstance->ulProducerSlotSize )
+        {
+            GCQ_DEBUG( " Error: length 0x%lx specified is larger than slot configured\r\n", ulSlotLen );
+            xStatus = GCQ_ERRORS_INVALID_ARG;
+        }
+        else if ( ( NULL == pucData ) || ( NULL == pulNumProduced ) || ( 0 == ulNumSlots ) )
+        {
+            xStatus = GCQ_ERRORS_INVALID_ARG;
+        }
+        else if ( !CHECK_32BIT_ALIGNMENT( ulSlotLen ) )
+        {
+            GCQ_DEBUG( " Error: length 0x%lx is not 32bit aligned\r\n", ulSlotLen );
+            xStatus = GCQ_ERRORS_INVALID_ARG;
+        }
+
+        if ( GCQ_ERRORS_NONE == xStatus )
+        {
+            GCQRing *pxRing = pxGCQInstance->pxGCQProducer;
+            uint32_t ulFree = 0;
+            uint32_t ulCount = 0;
+
+            *pulNumProduced = 0;
+
+            /* Only re-read the consumed pointer if the cached view is too small */
+            ulFree = pxRing->ulRingNumSlots - ( pxRing->ulRingProduced - pxRing->ulRingConsumed );
+            if ( ulFree < ulNumSlots )
+            {
+                prvvGCQPublishPending( pxGCQInstance );
+                prvvGCQRingReadConsumed( pxGCQInstance->pxGCQIOAccess, pxRing );
+                ulFree = pxRing->ulRingNumSlots - ( pxRing->ulRingProduced - pxRing->ulRingConsumed );
+            }
+
+            if ( ( 0 == ulFree ) || ( ulFree > pxRing->ulRingNumSlots ) )
+            {
+                GCQ_DEBUG( "Error: No free slots to add batch of %ld\r\n", ulNumSlots );
+                xStatus = GCQ_ERRORS_PRODUCER_NO_FREE_SLOTS;
+            }
+            else
+            {
+                if ( ulFree > ulNumSlots )
+                {
+                    ulFree = ulNumSlots;
+                }
+
+                /* The slot index is masked by the ring size, so wrap is implicit */
+                for ( ulCount = 0; ulCount < ulFree; ulCount++ )
+                {
+                    uint64_t ullSlotAddr = prvullGCQRingGetSlotPtrProduced( pxRing );
+
+                    GCQ_DEBUG( "Write data to slot addr:0x%llx len:%ld\r\n", ullSlotAddr, ulSlotLen );
+                    prvvGCQCopyToRing( pxGCQInstance->pxGCQIOAccess,
+                                       ( uint32_t * )( pucData + ( ulCount * ulSlotLen ) ),
+                                       ullSlotAddr,
+                                       ulSlotLen );
+                    if ( 0 != pxGCQInstance->ulProducerExtSize )
+                    {
+                        prvvGCQWriteExt( pxGCQInstance, ullSlotAddr, NULL, 0 );
+                    }
+                    pxRing->ulRingProduced++;
+                }
+
+                /* Publish the whole batch with a single pointer update */
+                prvvGCQPublishProduced( pxGCQInstance, ulCount );
+                *pulNumProduced = ulCount;
+            }
+        }
+    }
+    return xStatus;
+}
+
+/**
+ * @brief    Service completion coalescing for a producer instance
+ */
+GCQ_ERRORS_TYPE xGCQServiceCoalescing( GCQInstance *pxGCQInstance, uint32_t ulNowMs )
+{
+    GCQ_ERRORS_TYPE xStatus = GCQ_ERRORS_INVALID_ARG;
+
+    if ( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+         ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) )
+    {
+        xStatus = GCQ_ERRORS_NONE;
+
+        if ( ( NULL == pxGCQInstance ) ||
+             ( FALSE == pxGCQInstance->iInitialised ) )
+        {
+            xStatus = GCQ_ERRORS_INVALID_INSTANCE;
+        }
+        else if ( GCQ_MODE_TYPE_PRODUCER_MODE != pxGCQInstance->xMode )
+        {
+            xStatus = GCQ_ERRORS_INVALID_ARG;
+        }
+        else if ( 0 == pxGCQInstance->ulCoalescePending )
+        {
+            /* Only pick up a new host config between bursts */
+            uint32_t ulFlags = pxGCQInstance->pxGCQIOAccess->xGCQReadMem32(
+                pxGCQInstance->ullGCQHeaderAddr + offsetof( GCQHeader, ulHdrFlags ) );
+
+            if ( ulFlags != pxGCQInstance->ulCoalesceFlags )
+            {
+                prvvGCQApplyHostFlags( pxGCQInstance, ulFlags );
+            }
+        }
+        /* The delay runs from the first service call that sees pending slots */
+        else if ( FALSE == pxGCQInstance->iCoalesceTimerRunning )
+        {
+            pxGCQInstance->ulCoalesceStartMs = ulNowMs;
+            pxGCQInstance->iCoalesceTimerRunning = TRUE;
+        }
+
+        if ( ( GCQ_ERRORS_NONE == xStatus ) &&
+             ( TRUE == pxGCQInstance->iCoalesceTimerRunning ) &&
+             ( ( ulNowMs - pxGCQInstance->ulCoalesceStartMs ) >= pxGCQInstance->ulCoalesceDelayMs ) )
+        {
+            prvvGCQPublishPending( pxGCQInstance );
+        }
+    }
+    return xStatus;
+}
+
+/**
+ * @brief    Publish any completions held back by coalescing
+ */
+GCQ_ERRORS_TYPE xGCQFlushCoalescing( GCQInstance *pxGCQInstance )
+{
+    GCQ_ERRORS_TYPE xStatus = GCQ_ERRORS_INVALID_ARG;
+
+    if ( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+         ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) )
+    {
+        xStatus = GCQ_ERRORS_NONE;
+
+        if ( ( NULL == pxGCQInstance ) ||
+             ( FALSE == pxGCQInstance->iInitialised ) )
+        {
+            xStatus = GCQ_ERRORS_INVALID_INSTANCE;
+        }
+        else
+        {
+            prvvGCQPublishPending( pxGCQInstance );
+        }
+    }
+    return xStatus;
+}
+
 /**
  * @brief    Sets this modules version information
  */
@@ -20,7 +20,7 @@
 /*****************************************************************************/
 
 #define GCQ_VER_MAJOR                   (1)
-#define GCQ_VER_MINOR                   (0)
+#define GCQ_VER_MINOR                   (1)
 #define GCQ_VER_PATCH                   (0)
 #define GCQ_VER_DEV_COMMITS             (0)
 
@@ -30,6 +30,23 @@
 #define GCQ_ALLOC_MAGIC                 ( 0x5847513F )
 #define GCQ_MIN_NUM_SLOTS               ( 2 )
 
+/* Completion coalescing config, written by the host into the header flags */
+#define GCQ_HDR_FLAG_COALESCE           ( 0x80000000 )
+#define GCQ_HDR_COALESCE_COUNT_MASK     ( 0x000000FF )
+#define GCQ_HDR_COALESCE_DELAY_SHIFT    ( 8 )
+#define GCQ_HDR_COALESCE_DELAY_MASK     ( 0x00FFFF00 )
+
+/*
+ * CQ entry extension, written by the host into the header flags (since v1.1).
+ * Each CQ slot is paired with an extension of this size, placed after the CQ
+ * slots, whose first word holds the number of payload bytes which follow.
+ */
+#define GCQ_HDR_FLAG_CQ_EXT             ( 0x40000000 )
+#define GCQ_HDR_CQ_EXT_SIZE_SHIFT       ( 24 )
+#define GCQ_HDR_CQ_EXT_SIZE_MASK        ( 0x3F000000 )
+#define GCQ_HDR_CQ_EXT_SIZE_UNIT        ( 16 )
+#define GCQ_CQ_EXT_LEN_SIZE             ( sizeof( uint32_t ) )
+
 /* Producer address offsets */
 #define GCQ_PRODUCER_SQ_TAIL_POINTER    ( 0x0000 )  /* RW */
 #define GCQ_PRODUCER_SQ_MEM_ADDR_LOW    ( 0x0008 )  /* RW */
@@ -61,6 +78,7 @@ typedef struct GCQInstance
     GCQ_MODE_TYPE   xMode;
     const GCQIOAccess *pxGCQIOAccess;
     uint64_t        ullRingAddr;
+    uint64_t        ullRingLen;
     uint32_t        ulConsumerSlotSize;
     uint32_t        ulProducerSlotSize;
     uint64_t        ullGCQHeaderAddr;
@@ -68,6 +86,14 @@ typedef struct GCQInstance
     GCQRing         xGCQCq;
     GCQRing         *pxGCQProducer;
     GCQRing         *pxGCQConsumer;
+    uint32_t        ulCoalesceFlags;
+    uint32_t        ulCoalesceCount;
+    uint32_t        ulCoalesceDelayMs;
+    uint32_t        ulCoalescePending;
+    uint32_t        ulCoalesceStartMs;
+    int             iCoalesceTimerRunning;
+    uint32_t        ulProducerExtSize;
+    uint64_t        ullProducerExtAddr;
     uint32_t        ulLowerFirewall;
 
 } GCQInstance;
@@ -71,6 +71,8 @@ typedef enum
 {
     FW_IF_GCQ_IOCTRL_SET_OPAQUE_HANDLE = MAX_FW_IF_COMMON_IOCTRL_OPTION,
     FW_IF_GCQ_IOCTRL_GET_OPAQUE_HANDLE,
+    FW_IF_GCQ_IOCTRL_READ_BATCH,
+    FW_IF_GCQ_IOCTRL_WRITE_BATCH,
 
     MAX_FW_IF_GCQ_IOCTRL_OPTION
 
@@ -111,6 +113,20 @@ typedef struct
 } FWIfGCQCfg;
 
 
+/**
+ * @struct  FWIfGCQBatch
+ * @brief   argument for FW_IF_GCQ_IOCTRL_READ_BATCH and FW_IF_GCQ_IOCTRL_WRITE_BATCH,
+ *          a contiguous buffer of ulNumSlots entries of ulSlotSize bytes
+ */
+typedef struct
+{
+    uint8_t             *pucData;
+    uint32_t            ulSlotSize;
+    uint32_t            ulNumSlots;     /* in: slots requested, out: slots transferred */
+
+} FWIfGCQBatch;
+
+
 /*****************************************************************************/
 /* Public Functions                                                          */
 /*****************************************************************************/
@@ -42,6 +42,9 @@
     DO( FW_IF_GCQ_STATS_INSTANCE_CREATE_COUNT )        \
     DO( FW_IF_GCQ_STATS_READ_COUNT )                   \
     DO( FW_IF_GCQ_STATS_WRITE_COUNT )                  \
+    DO( FW_IF_GCQ_STATS_READ_BATCH_COUNT )             \
+    DO( FW_IF_GCQ_STATS_WRITE_BATCH_COUNT )            \
+    DO( FW_IF_GCQ_STATS_BATCH_SLOTS_COUNT )            \
     DO( FW_IF_GCQ_STATS_MAX )
 
 #define FW_IF_GCQ_ERRORS( DO )                         \
@@ -506,10 +509,17 @@ static uint32_t prvGCQRead( void *pvFWIf, uint64_t ullSrcPort, uint8_t *pucData,
         }
         else
         {
+            GCQ_ERRORS_TYPE xStatus = GCQ_ERRORS_NONE;
+
+            /* The rx poll doubles as the coalescing timer for our completions */
+            if ( FW_IF_GCQ_MODE_PRODUCER == pxCfg->xMode )
+            {
+                ( void )xGCQServiceCoalescing( pxProfile->pxGCQInstance, ulOSAL_GetUptimeMs() );
+            }
+
             /* vTaskDelay is used outside of function as a block as opposed to a
             spin on the timeout */
-            GCQ_ERRORS_TYPE xStatus = xGCQConsumeData( pxProfile->pxGCQInstance,
-                                                       pucData, *pulSize );
+            xStatus = xGCQConsumeData( pxProfile->pxGCQInstance, pucData, *pulSize );
 
             if ( GCQ_ERRORS_NONE == xStatus )
             {
@@ -544,6 +554,10 @@ static uint32_t prvGCQIOCtrl( void *pvFWIf, uint32_t ulOption, void *pvValue )
         switch ( ulOption )
         {
             case FW_IF_COMMON_IOCTRL_FLUSH_TX:
+                /* Publish any completions held back by coalescing. */
+                xRet = prvxMapIFDriverReturnCode( xGCQFlushCoalescing( pxProfile->pxGCQInstance ) );
+                break;
+
             case FW_IF_COMMON_IOCTRL_FLUSH_RX:
                 /* Handle common IOCTL's. */
                 break;
@@ -566,6 +580,56 @@ static uint32_t prvGCQIOCtrl( void *pvFWIf, uint32_t ulOption, void *pvValue )
                 *( uint32_t* )pvValue = pxProfile->ulIOHandle;
                 break;
 
+            case FW_IF_GCQ_IOCTRL_READ_BATCH:
+            case FW_IF_GCQ_IOCTRL_WRITE_BATCH:
+            {
+                /* Transfer as many slots as possible with a single pointer update. */
+                FWIfGCQBatch *pxBatch = ( FWIfGCQBatch* )pvValue;
+                GCQ_ERRORS_TYPE xStatus = GCQ_ERRORS_INVALID_ARG;
+                uint32_t ulDone = 0;
+
+                if ( ( NULL == pxBatch ) || ( CHECK_INVALID_STATE( pxProfile ) ) )
+                {
+                    xRet = FW_IF_ERRORS_PARAMS;
+                    INC_ERROR_COUNTER( FW_IF_ERRORS_PARAMS_COUNT );
+                    break;
+                }
+
+                if ( FW_IF_GCQ_IOCTRL_READ_BATCH == ulOption )
+                {
+                    xStatus = xGCQConsumeDataBatch( pxProfile->pxGCQInstance,
+                                                    pxBatch->pucData,
+                                                    pxBatch->ulSlotSize,
+                                                    pxBatch->ulNumSlots,
+                                                    &ulDone );
+                    if ( GCQ_ERRORS_NONE == xStatus )
+                    {
+                        INC_STAT_COUNTER( FW_IF_GCQ_STATS_READ_BATCH_COUNT );
+                    }
+                }
+                else
+                {
+                    xStatus = xGCQProduceDataBatch( pxProfile->pxGCQInstance,
+                                                    pxBatch->pucData,
+                                                    pxBatch->ulSlotSize,
+                                                    pxBatch->ulNumSlots,
+                                                    &ulDone );
+                    if ( GCQ_ERRORS_NONE == xStatus )
+                    {
+                        INC_STAT_COUNTER( FW_IF_GCQ_STATS_WRITE_BATCH_COUNT );
+                    }
+                }
+
+                if ( GCQ_ERRORS_NONE == xStatus )
+                {
+                    pxThis->pulStatCounters[ FW_IF_GCQ_STATS_BATCH_SLOTS_COUNT ] += ulDone;
+                }
+
+                pxBatch->ulNumSlots = ulDone;
+                xRet = prvxMapIFDriverReturnCode( xStatus );
+                break;
+            }
+
             default:
                 xRet = FW_IF_ERRORS_UNRECOGNISED_OPTION;
                 PLL_ERR( FW_IF_GCQ_NAME, "Error:  sGCQ IOCTL unrecognised option\r\n" );
@@ -29,6 +29,13 @@
 #define HAL_RPU_RING_BUFFER_BASE        ( HAL_RPU_SHARED_MEMORY_BASEADDR + HAL_SHARED_MEM_TABLE_SIZE )
 #define HAL_RPU_MEMORY_BUFFER_BASE      ( 0x2000000 ) /* 32MB - 128MB RPU Memory (0-32MB RPU code/data) */
 
+/* Telemetry sGCQ, uses the unused top half of the sGCQ block and follows the first ring */
+#define HAL_GCQ_TELEMETRY_BASEADDR          ( HAL_GCQ_SHARED_BASEADDR + 0x800 )
+#define HAL_RPU_TELEMETRY_RING_BUFFER_LEN   ( 0x1000 )
+#define HAL_RPU_TELEMETRY_RING_BUFFER_BASE  ( HAL_RPU_RING_BUFFER_BASE + HAL_RPU_RING_BUFFER_LEN )
+#define HAL_RPU_TELEMETRY_DATA_LEN          ( 0x10000 )
+#define HAL_RPU_TELEMETRY_DATA_BASE         ( HAL_RPU_TELEMETRY_RING_BUFFER_BASE + HAL_RPU_TELEMETRY_RING_BUFFER_LEN )
+
 
 /* FAL */
 #define HAL_FLUSH_CACHE_DATA( addr, size ) Xil_DCacheFlushRange( addr, size )
@@ -104,6 +111,22 @@ typedef struct
 
 } HALShmTableData;
 
+/**
+ * @struct  HALShmTableChannel
+ *
+ * @brief   Stores an extra sGCQ channel - part of the partition table.
+ *          All zero until the channel is ready for use.
+ */
+typedef struct
+{
+    uint32_t ulGcqOffset;       /* From the start of the sGCQ block */
+    uint32_t ulRingBufOffset;
+    uint32_t ulRingBufLen;
+    uint32_t ulDataOffset;
+    uint32_t ulDataLen;
+
+} HALShmTableChannel;
+
 /**
  * @struct  HALShmTable
  *
@@ -118,6 +141,7 @@ typedef struct
     HALShmTableUUID       xUuid;
     HALShmTableLogMsg     xLogMsg;
     HALShmTableData       xData;
+    HALShmTableChannel    xTelemetry;
 
 } HALShmTable;
 
@@ -48,6 +48,9 @@ BIMEvent PROFILE_BIM_APC_EVENTS[ MAX_APC_PROXY_DRIVER_EVENTS ] =
     [APC_PROXY_DRIVER_E_PROGRAM_FAILED]          = { APC_PROXY_DRIVER_E_PROGRAM_FAILED,            0, BIM_STATUS_CRITICAL },
     [APC_PROXY_DRIVER_E_POR_TRIGGERED]           = { APC_PROXY_DRIVER_E_POR_TRIGGERED,             0, BIM_STATUS_HEALTHY  },
     [APC_PROXY_DRIVER_E_POR_FAILED]              = { APC_PROXY_DRIVER_E_POR_FAILED,                0, BIM_STATUS_CRITICAL },
+    [APC_PROXY_DRIVER_E_DIGEST_COMPLETE]         = { APC_PROXY_DRIVER_E_DIGEST_COMPLETE,           0, BIM_STATUS_HEALTHY  },
+    [APC_PROXY_DRIVER_E_DIGEST_BUSY]             = { APC_PROXY_DRIVER_E_DIGEST_BUSY,               0, BIM_STATUS_HEALTHY  },
+    [APC_PROXY_DRIVER_E_DIGEST_FAILED]           = { APC_PROXY_DRIVER_E_DIGEST_FAILED,             0, BIM_STATUS_HEALTHY  },
 };
 
 /* ASC Event table */
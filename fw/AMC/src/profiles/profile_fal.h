@@ -74,6 +74,7 @@ typedef enum
 
 /* FAL objects */
 extern FWIfCfg xGcqIf;
+extern FWIfCfg xGcqTelemetryIf;
 extern FWIfCfg *pxOspiIf;
 extern FWIfCfg *pxEmmcIf;
 extern FWIfCfg xQsfpIf1;
@@ -74,6 +74,9 @@
 #define HAL_APC_PMC_BOOT_REG            ( XPAR_PSV_PMC_GLOBAL_0_BASEADDR + 0x00004 )
 #define HAL_APC_PDI_BIT_MASK            ( 0x14 )
 
+/* AMI */
+#define HAL_AMI_RX_DATA_SIZE            ( 16 )       /* Max in flight host requests */
+
 /* Core libs */
 /* PLL */
 #define HAL_PLM_LOG_ADDRESS             ( 0xF2019000 )
@@ -66,6 +66,7 @@
 
 /* FAL objects */
 FWIfCfg xGcqIf   = { 0 };
+FWIfCfg xGcqTelemetryIf = { 0 };
 FWIfCfg xOspiIf  = { 0 };
 FWIfCfg xEmmcIf  = { 0 };
 
@@ -178,6 +179,17 @@ static FWIfGCQCfg xGcqCfg =
     ""
 };
 
+static FWIfGCQCfg xGcqTelemetryCfg =
+{
+    ( uint64_t )HAL_GCQ_TELEMETRY_BASEADDR,
+    FW_IF_GCQ_MODE_PRODUCER,
+    ( uint64_t )HAL_RPU_TELEMETRY_RING_BUFFER_BASE,
+    HAL_RPU_TELEMETRY_RING_BUFFER_LEN,
+    AMI_PROXY_RESPONSE_SIZE,
+    AMI_PROXY_REQUEST_SIZE,
+    ""
+};
+
 static FWIfGCQInitCfg myGcqIf =
 {
     NULL
@@ -591,6 +603,17 @@ int iFAL_Initialise( uint64_t *pullAmcInitStatus )
                 PLL_ERR( FAL_PROFILE_NAME, "Error creating sGCQ\r\n" );
                 iStatus = ERROR;
             }
+
+            /* The host falls back to the first sGCQ without this one */
+            if( FW_IF_ERRORS_NONE == ulFW_IF_GCQ_Create( &xGcqTelemetryIf, &xGcqTelemetryCfg ) )
+            {
+                PLL_DBG( FAL_PROFILE_NAME, "Telemetry sGCQ created OK\r\n" );
+                *pullAmcInitStatus |= AMC_CFG_GCQ_TELEMETRY_FAL_CREATED;
+            }
+            else
+            {
+                PLL_ERR( FAL_PROFILE_NAME, "Error creating telemetry sGCQ\r\n" );
+            }
         }
 
         /* Create instance of the OSPI based on the global configuration */
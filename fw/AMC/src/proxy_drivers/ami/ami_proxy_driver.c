@@ -20,20 +20,34 @@
 /* Defines                                                                    */
 /******************************************************************************/
 
-#define AMI_TASK_SLEEP_MS               ( 100 )
+/* Fallback poll of the GCQ, responses posted to the mailbox wake the task immediately */
+#define AMI_TASK_POLL_MS                ( 1 )
 
 #define AMI_NAME                        "AMI"
 
 #define AMI_MAX_MSG_SIZE                ( 64 )
-#define AMI_MBOX_SIZE                   ( 10 )
 
-/* Maximum number of in flight requests/responses */
-#define AMI_RXDATA_SIZE                 ( 8 )
-#define AMI_CHECK_VALID_INDEX( x )      ( x < AMI_RXDATA_SIZE )
+/*
+ * The number of in flight requests/responses is set by the profile, each request
+ * produces a single response so the mailboxes are sized to match
+ */
+#define AMI_RXDATA_MIN_SIZE             ( 2 )
+#define AMI_CHECK_VALID_INDEX( x )      ( x < pxThis->ucRxDataSize )
+
+/* Heavy (flash) requests may only use half of the table, the rest is kept for the fast path */
+#define AMI_RXDATA_HEAVY_MAX( n )       ( ( n ) / 2 )
 
 #define AMI_RESPONSE_HDR_SIZE           ( 1 )
 #define AMI_RESPONSE_PAYLOAD_SIZE       ( 2 )
 #define AMI_RESPONSE_SIZE               ( 4 )
+
+/* Service time returned in the second payload word, identify uses the whole payload */
+#define AMI_RESPONSE_SVC_TIME_VALID     ( 1UL << 31 )
+#define AMI_RESPONSE_SVC_TIME_MASK      ( ~AMI_RESPONSE_SVC_TIME_VALID )
+
+/* Opcodes are below 0x10 apart from identify, which takes the unused slot 0x1 */
+#define AMI_OPCODE_SLOT_IDENTIFY        ( 0x1 )
+#define AMI_OPCODE_SLOTS                ( AMI_PROXY_SVC_TIME_OPCODES )
 #define AMI_REQUEST_HDR_SIZE            ( 2 )
 
 #define APC_LOAD_VER_MAJOR( v )         ( ( v )           & 0x000000FF )
@@ -78,6 +92,21 @@
     DO( AMI_PROXY_STATS_GET_EEPROM_RW_REQUEST )        \
     DO( AMI_PROXY_STATS_STATUS_RETRIEVAL )             \
     DO( AMI_PROXY_STATS_GET_MODULE_RW_REQUEST )        \
+    DO( AMI_PROXY_STATS_PARTITION_DIGEST_MBOX_POST )   \
+    DO( AMI_PROXY_STATS_PARTITION_DIGEST_MBOX_PEND )   \
+    DO( AMI_PROXY_STATS_GET_PARTITION_DIGEST_REQUEST ) \
+    DO( AMI_PROXY_STATS_CREATE_WAKE_SEM )              \
+    DO( AMI_PROXY_STATS_TASK_WAKEUPS )                 \
+    DO( AMI_PROXY_STATS_MAX_REQUESTS_PER_WAKEUP )      \
+    DO( AMI_PROXY_STATS_CREATE_WORKER_MBOX )           \
+    DO( AMI_PROXY_STATS_WORKER_MBOX_POST )             \
+    DO( AMI_PROXY_STATS_WORKER_MBOX_PEND )             \
+    DO( AMI_PROXY_STATS_MAX_RX_DATA_IN_USE )           \
+    DO( AMI_PROXY_STATS_INLINE_RESPONSE )              \
+    DO( AMI_PROXY_STATS_SVC_STATS_MBOX_POST )          \
+    DO( AMI_PROXY_STATS_SVC_STATS_MBOX_PEND )          \
+    DO( AMI_PROXY_STATS_REQUEST_REJECTED )             \
+    DO( AMI_PROXY_STATS_CHANNEL_ADDED )                \
     DO( AMI_PROXY_STATS_MAX )
 
 #define AMI_PROXY_ERRORS( DO )                         \
@@ -97,6 +126,7 @@
     DO( AMI_PROXY_ERRORS_GET_MODULE_RW_REQUEST )       \
     DO( AMI_PROXY_ERRORS_GET_DEBUG_VERBOSITY_REQUEST ) \
     DO( AMI_PROXY_ERRORS_SET_FPT_FLAGS_REQUEST )       \
+    DO( AMI_PROXY_ERRORS_PARTITION_DIGEST_REQUEST )    \
     DO( AMI_PROXY_RAISE_EVENT_PDI_DOWNLOAD_FAILED )    \
     DO( AMI_PROXY_RAISE_EVENT_PDI_COPY_FAILED )        \
     DO( AMI_PROXY_RAISE_EVENT_GET_IDENTIFY_FAILED )    \
@@ -107,9 +137,17 @@
     DO( AMI_PROXY_RAISE_EVENT_MODULE_RW_FAILED )       \
     DO( AMI_PROXY_RAISE_EVENT_FPT_FLAGS_FAILED )       \
     DO( AMI_PROXY_RAISE_EVENT_DEBUG_VERBOSITY_FAILED ) \
+    DO( AMI_PROXY_RAISE_EVENT_PARTITION_DIGEST_FAILED )\
     DO( AMI_PROXY_INIT_FW_IF_OPEN_FAILED )             \
     DO( AMI_PROXY_INIT_MUTEX_CREATE_FAILED )           \
     DO( AMI_PROXY_INIT_MBOX_CREATE_FAILED )            \
+    DO( AMI_PROXY_INIT_WAKE_SEM_CREATE_FAILED )        \
+    DO( AMI_PROXY_INIT_WORKER_MBOX_CREATE_FAILED )     \
+    DO( AMI_PROXY_INIT_WORKER_TASK_CREATE_FAILED )     \
+    DO( AMI_PROXY_INIT_RX_DATA_ALLOC_FAILED )          \
+    DO( AMI_PROXY_ERRORS_WORKER_POST_FAILED )          \
+    DO( AMI_PROXY_RX_DATA_HEAVY_LIMIT_REACHED )        \
+    DO( AMI_PROXY_RX_DATA_FREE_FAILED )                \
     DO( AMI_PROXY_INIT_TASK_CREATE_FAILED )            \
     DO( AMI_PROXY_VALIDATION_FAILED )                  \
     DO( AMI_PROXY_UNSUPPORTED_OPCODE_RX )              \
@@ -119,6 +157,11 @@
     DO( AMI_PROXY_BIND_CB_FAILED )                     \
     DO( AMI_PROXY_RX_DATA_INDEX_FAILED )               \
     DO( AMI_PROXY_ERRORS_INIT_EVL_RECORD_FAILED )      \
+    DO( AMI_PROXY_ERRORS_INLINE_RESPONSE )             \
+    DO( AMI_PROXY_ERRORS_SVC_STATS_REQUEST )           \
+    DO( AMI_PROXY_ERRORS_REQUEST_TOO_SHORT )           \
+    DO( AMI_PROXY_ERRORS_REQUEST_OUT_OF_BOUNDS )       \
+    DO( AMI_PROXY_ERRORS_NO_FREE_CHANNELS )            \
     DO( AMI_PROXY_ERRORS_MAX )
 
 #define PRINT_STAT_COUNTER( x )             PLL_INF( AMI_NAME, "%50s . . . . %d\r\n",          \
@@ -131,7 +174,7 @@
 #define INC_STAT_COUNTER( x )               { if( x < AMI_PROXY_STATS_MAX )pxThis->pulStatCounters[ x ]++; }
 #define INC_ERROR_COUNTER( x )              { if( x < AMI_PROXY_ERRORS_MAX )pxThis->pulErrorCounters[ x ]++; }
 #define INC_ERROR_COUNTER_WITH_STATE( x )   { pxThis->xState = MODULE_STATE_ERROR; INC_ERROR_COUNTER( x ) }
-#define SET_STAT_COUNTER( x, y )            { if( x < AMI_PROXY_ERRORS_MAX )pxThis->pulStatCounters[ x ] = y; }
+#define SET_STAT_COUNTER( x, y )            { if( x < AMI_PROXY_STATS_MAX )pxThis->pulStatCounters[ x ] = y; }
 
 
 /******************************************************************************/
@@ -155,6 +198,8 @@ typedef enum
     AMI_MSG_TYPE_MODULE_RW_COMPLETE       = 8,
     AMI_MSG_TYPE_DEBUG_VERBOSITY_COMPLETE = 9,
     AMI_MSG_TYPE_FPT_FLAGS_COMPLETE       = 10,
+    AMI_MSG_TYPE_PARTITION_DIGEST_COMPLETE = 11,
+    AMI_MSG_TYPE_SVC_STATS_COMPLETE       = 12,
 
     MAX_AMI_MSG_TYPE
 
@@ -176,6 +221,8 @@ typedef enum
     AMI_CMD_OPCODE_PDI_PROGRAM_REQ     = 0xB,
     AMI_CMD_OPCODE_SENSOR_REQ          = 0xC,
     AMI_CMD_OPCODE_PDI_COPY_REQ        = 0xD,
+    AMI_CMD_OPCODE_PARTITION_DIGEST_REQ = 0xE,
+    AMI_CMD_OPCODE_SVC_STATS_REQ       = 0xF,
     AMI_CMD_OPCODE_IDENTIFY_REQ        = 0x202,
 
     MAX_AMI_CMD_OPCODE
@@ -222,6 +269,7 @@ UTIL_MAKE_ENUM_AND_STRINGS( AMI_PROXY_ERRORS, AMI_PROXY_ERRORS, AMI_PROXY_ERRORS
 typedef struct
 {
     uint8_t 			ucInUse;
+    uint8_t             ucHeavy;
     AMI_CMD_OPCODE_REQ	xOpCode;
     uint16_t			usCid;
     union
@@ -234,11 +282,28 @@ typedef struct
         AMIProxyEepromRWRequest     xEepromReadWriteRequest;
         AMIProxyModuleRWRequest     xModuleReadWriteRequest;
         AMIProxyFptFlagsRequest     xFptFlagsRequest;
+        AMIProxyPartitionDigestRequest xDigestRequest;
         uint8_t                     ucDebugVerbosityRequest;
     };
+    uint32_t            ulRxTimeMs;     /* Uptime when the request was consumed */
+    uint16_t            usInlineMax;    /* Inline response capacity, 0 if not requested */
+    uint16_t            usInlineLen;
+    uint8_t             pucInline[ AMI_PROXY_RESPONSE_INLINE_SIZE ];
+    uint8_t             ucChannel;      /* Channel the request arrived on, the response goes back on it */
 
 } AMIProxyRxData;
 
+/**
+ * @struct  AMIProxyChannel
+ * @brief   Firmware Interface the host sends requests on
+ */
+typedef struct
+{
+    FWIfCfg             *pxFwIf;
+    uint32_t            ulFwIfPort;
+
+} AMIProxyChannel;
+
 /**
  * @struct  AMIProxyPrivateData
  * @brief   Structure to hold ths proxy driver's private data
@@ -250,20 +315,35 @@ typedef struct
     int             iInitialised;
     uint8_t         ucMyId;
 
-    FWIfCfg         *pxFwIf;
-    uint32_t        ulFwIfPort;
+    AMIProxyChannel pxChannel[ AMI_PROXY_MAX_CHANNELS ];
+    uint8_t         ucNumChannels;
+    uint8_t         ucRxChannel;
+    uint32_t        ulSharedMemSize;
 
     EVLRecord       *pxEvlRecord;
+    EVLRecord       *pxWorkerEvlRecord;
 
     void            *pvOsalMutexHdl;
     void            *pvOsalMBoxHdl;
+    void            *pvOsalWakeSemHdl;
     void            *pvOsalTaskHdl;
+    void            *pvOsalWorkerMBoxHdl;
+    void            *pvOsalWorkerTaskHdl;
 
-    AMIProxyRxData  xRxData[ AMI_RXDATA_SIZE ];
+    AMIProxyRxData  *pxRxData;
+    uint8_t         *pucRxFreeList;
+    uint8_t         ucRxDataSize;
+    uint8_t         ucRxFreeCount;
+    uint8_t         ucHeavyInUse;
+
+    uint32_t        pulInlineResp[ ( AMI_PROXY_RESPONSE_SIZE +
+                                     AMI_PROXY_RESPONSE_INLINE_SIZE ) / sizeof( uint32_t ) ];
 
     uint32_t        pulStatCounters[ AMI_PROXY_STATS_MAX ];
     uint32_t        pulErrorCounters[ AMI_PROXY_ERRORS_MAX ];
 
+    AMIProxyServiceTime pxServiceTime[ AMI_PROXY_SVC_TIME_OPCODES ];
+
     MODULE_STATE    xState;
 
     uint32_t        ulLowerFirewall;
@@ -371,7 +451,8 @@ typedef struct
     uint32_t ulSID:8;
     uint32_t ulAddrType:3;
     uint32_t ulSensorId:8;
-    uint32_t ulResvd:5;
+    uint32_t ulInlineResp:1;
+    uint32_t ulResvd:4;
     uint32_t ulPad;
 
 } AMIProxyCmdReqSensorPayload;
@@ -424,7 +505,8 @@ typedef struct
     uint32_t ucReqType:1;
     uint32_t ucLen:8;
     uint32_t ucOffset:8;
-    uint32_t ucReserved:15;
+    uint32_t ucInlineResp:1;
+    uint32_t ucReserved:14;
 
 } AMIProxyCmdEepromPayload;
 
@@ -440,7 +522,8 @@ typedef struct
     uint8_t  ucByteOffset;
     uint8_t  ucLen;
     uint32_t ulReqType:1;
-    uint32_t ulReserved:31;
+    uint32_t ulInlineResp:1;
+    uint32_t ulReserved:30;
 
 } AMIProxyCmdModulePayload;
 
@@ -461,6 +544,33 @@ typedef struct
     uint32_t ulFlags;           /* Flags value (for write) */
 } AMIProxyCmdFptFlagsPayload;
 
+/**
+ * @struct  AMIProxyCmdDigestPayload
+ * @brief   The partition digest request payload
+ */
+typedef struct
+{
+    uint64_t ullAddress;        /* Shared memory offset to write the MD5 digest to */
+    uint32_t ulBootDevice;      /* 0 = Primary, 1 = Secondary */
+    uint32_t ulPartition;       /* Partition ID */
+    uint32_t ulLength;          /* Number of bytes to digest from the partition base */
+    uint32_t ulRsvd;
+
+} AMIProxyCmdDigestPayload;
+
+/**
+ * @struct  AMIProxyCmdSvcStatsPayload
+ * @brief   The service stats request payload
+ */
+typedef struct
+{
+    uint32_t ulOpCode:16;       /* Opcode to return the service time of */
+    uint32_t ulClear:1;         /* Clear the opcode's service time once read */
+    uint32_t ulInlineResp:1;    /* Must be set, the stats are only returned inline */
+    uint32_t ulResvd:14;
+
+} AMIProxyCmdSvcStatsPayload;
+
 /**
  * @struct  AMI_CMD_REQUEST
  * @brief   The request command header & payload
@@ -478,6 +588,8 @@ typedef struct
         AMIProxyCmdEepromPayload    xEepromPayload;
         AMIProxyCmdModulePayload    xModulePayload;
         AMIProxyCmdFptFlagsPayload  xFptFlagsPayload;
+        AMIProxyCmdDigestPayload    xDigestPayload;
+        AMIProxyCmdSvcStatsPayload  xSvcStatsPayload;
         uint8_t                     ucDebugVerbosityPayload;
     };
 
@@ -485,6 +597,21 @@ typedef struct
 
 STATIC_ASSERT( sizeof( AMIProxyCmdResp ) < AMI_PROXY_REQUEST_SIZE );
 
+/**
+ * @struct  AMIProxyOpCodeDesc
+ * @brief   How a request opcode is validated and dispatched
+ */
+typedef struct
+{
+    AMI_CMD_OPCODE_REQ xOpCode;
+    uint16_t           usMinCount;      /* Smallest payload the host may send, in bytes */
+    int                ( *pxHandler )( AMI_CMD_REQUEST *pxCmdRequest );
+    void               ( *pxGetShmRange )( AMI_CMD_REQUEST *pxCmdRequest,
+                                           uint64_t *pullAddress, uint32_t *pulLength );
+    uint32_t           ulHandlerError;  /* AMI_PROXY_ERRORS_MAX if the handler counts its own */
+
+} AMIProxyOpCodeDesc;
+
 
 /******************************************************************************/
 /* Local Variables                                                            */
@@ -495,15 +622,27 @@ static AMIProxyPrivateData xLocalData =
     UPPER_FIREWALL,             /* ulUpperFirewall */
     FALSE,                      /* iInitialised */
     0,                          /* ucMyId */
-    NULL,                       /* pxFwIf */
-    0,                          /* ulFwIfPort */
+    { { 0 } },                  /* pxChannel */
+    0,                          /* ucNumChannels */
+    0,                          /* ucRxChannel */
+    0,                          /* ulSharedMemSize */
     NULL,                       /* pxEvlRecord */
+    NULL,                       /* pxWorkerEvlRecord */
     NULL,                       /* pvOsalMutexHdl */
     NULL,                       /* pvOsalMBoxHdl */
+    NULL,                       /* pvOsalWakeSemHdl */
     NULL,                       /* pvOsalTaskHdl */
-    { { 0 } },                  /* xRxData */
+    NULL,                       /* pvOsalWorkerMBoxHdl */
+    NULL,                       /* pvOsalWorkerTaskHdl */
+    NULL,                       /* pxRxData */
+    NULL,                       /* pucRxFreeList */
+    0,                          /* ucRxDataSize */
+    0,                          /* ucRxFreeCount */
+    0,                          /* ucHeavyInUse */
+    { 0 },                      /* pulInlineResp */
     { 0 },                      /* pulStatCounters */
     { 0 },                      /* pulErrorCounters */
+    { { 0 } },                  /* pxServiceTime */
     MODULE_STATE_UNINITIALISED, /* xState */
     LOWER_FIREWALL              /* ulLowerFirewall */
 };
@@ -526,14 +665,55 @@ static AMIProxyPrivateData *pxThis = &xLocalData;
 static void vProxyDriverTask( void *pvArgs );
 
 /**
- * @brief   Find the next free data index
+ * @brief   Worker task declaration, raises the events for heavy (flash) requests
+ *
+ * @param   pvArgs  Pointer to task args (unused)
+ *
+ * @return  N/A
+ *
+ */
+static void vProxyWorkerTask( void *pvArgs );
+
+/**
+ * @brief   Take a data index from the free list
+ *
+ * @param   pucIndex The allocated index
+ * @param   iHeavy   TRUE if the request is handled by the worker task
+ *
+ * @return  OK/ERROR
+ *
+ */
+static int iAllocRxDataIndex( uint8_t *pucIndex, int iHeavy );
+
+/**
+ * @brief   Return a data index to the free list
+ *
+ * @param   ucIndex The index to release
+ *
+ * @return  OK/ERROR
+ *
+ */
+static int iFreeRxDataIndex( uint8_t ucIndex );
+
+/**
+ * @brief   Pass a heavy request event to the worker task
+ *
+ * @param   pxSignal The event to raise
+ *
+ * @return  OK/ERROR
+ *
+ */
+static int iPostWorkerSignal( EVLSignal *pxSignal );
+
+/**
+ * @brief   Post a message to the mailbox and wake the task to send it
  *
- * @param   pucIndex The next free index
+ * @param   pxMsg The message to post
  *
  * @return  OK/ERROR
  *
  */
-static int iFindNextFreeRxDataIndex( uint8_t *pucIndex );
+static int iPostMBoxMsg( AMIProxyMboxMsg *pxMsg );
 
 /**
  * @brief   Handle the heartbeat request
@@ -585,6 +765,228 @@ static int iHandleDebugVerbosityRequest( AMI_CMD_REQUEST *pxCmdRequest );
  */
 static int iHandleFptFlagsRequest( AMI_CMD_REQUEST *pxCmdRequest );
 
+/**
+ * @brief   Handle the partition digest request
+ *
+ * @param   pxCmdRequest The request details
+ *
+ * @return  OK/ERROR
+ *
+ */
+static int iHandlePartitionDigestRequest( AMI_CMD_REQUEST *pxCmdRequest );
+
+/**
+ * @brief   Handle the service stats request
+ *
+ * @param   pxCmdRequest The request details
+ *
+ * @return  OK/ERROR
+ *
+ */
+static int iHandleSvcStatsRequest( AMI_CMD_REQUEST *pxCmdRequest );
+
+/**
+ * @brief   Map an opcode to its slot in the opcode table and service times
+ *
+ * @param   xOpCode The request opcode
+ *
+ * @return  The slot, AMI_OPCODE_SLOTS if the opcode has none
+ *
+ */
+static uint8_t ucOpCodeSlot( AMI_CMD_OPCODE_REQ xOpCode );
+
+/**
+ * @brief   Add a served request to its opcode's service time,
+ *          service time requests themselves are not recorded
+ *
+ * @param   xOpCode     The request opcode
+ * @param   ulServiceMs Time from GCQ consume to response produce
+ *
+ * @return  N/A
+ *
+ */
+static void vRecordServiceTime( AMI_CMD_OPCODE_REQ xOpCode, uint32_t ulServiceMs );
+
+/**
+ * @brief   Handle the pdi download request
+ *
+ * @param   pxCmdRequest The request details
+ *
+ * @return  OK/ERROR
+ *
+ */
+static int iHandlePdiDownloadRequest( AMI_CMD_REQUEST *pxCmdRequest );
+
+/**
+ * @brief   Handle the pdi copy request
+ *
+ * @param   pxCmdRequest The request details
+ *
+ * @return  OK/ERROR
+ *
+ */
+static int iHandlePdiCopyRequest( AMI_CMD_REQUEST *pxCmdRequest );
+
+/**
+ * @brief   Handle the pdi program request
+ *
+ * @param   pxCmdRequest The request details
+ *
+ * @return  OK/ERROR
+ *
+ */
+static int iHandlePdiProgramRequest( AMI_CMD_REQUEST *pxCmdRequest );
+
+/**
+ * @brief   Handle the sensor request
+ *
+ * @param   pxCmdRequest The request details
+ *
+ * @return  OK/ERROR
+ *
+ */
+static int iHandleSensorRequest( AMI_CMD_REQUEST *pxCmdRequest );
+
+/**
+ * @brief   Handle the identify request
+ *
+ * @param   pxCmdRequest The request details
+ *
+ * @return  OK/ERROR
+ *
+ */
+static int iHandleIdentifyRequest( AMI_CMD_REQUEST *pxCmdRequest );
+
+/**
+ * @brief   Handle the boot select request
+ *
+ * @param   pxCmdRequest The request details
+ *
+ * @return  OK/ERROR
+ *
+ */
+static int iHandleBootSelectRequest( AMI_CMD_REQUEST *pxCmdRequest );
+
+/**
+ * @brief   Get the shared memory range written by a sensor request
+ *
+ * @param   pxCmdRequest The request details
+ * @param   pullAddress  Offset from the shared memory base
+ * @param   pulLength    Number of bytes from the offset
+ *
+ * @return  N/A
+ *
+ */
+static void vGetSensorShmRange( AMI_CMD_REQUEST *pxCmdRequest, uint64_t *pullAddress, uint32_t *pulLength );
+
+/**
+ * @brief   Get the shared memory range read by a pdi download or program request
+ *
+ * @param   pxCmdRequest The request details
+ * @param   pullAddress  Offset from the shared memory base
+ * @param   pulLength    Number of bytes from the offset
+ *
+ * @return  N/A
+ *
+ */
+static void vGetPdiShmRange( AMI_CMD_REQUEST *pxCmdRequest, uint64_t *pullAddress, uint32_t *pulLength );
+
+/**
+ * @brief   Get the shared memory range used by an eeprom read/write request
+ *
+ * @param   pxCmdRequest The request details
+ * @param   pullAddress  Offset from the shared memory base
+ * @param   pulLength    Number of bytes from the offset
+ *
+ * @return  N/A
+ *
+ */
+static void vGetEepromShmRange( AMI_CMD_REQUEST *pxCmdRequest, uint64_t *pullAddress, uint32_t *pulLength );
+
+/**
+ * @brief   Get the shared memory range used by a module read/write request
+ *
+ * @param   pxCmdRequest The request details
+ * @param   pullAddress  Offset from the shared memory base
+ * @param   pulLength    Number of bytes from the offset
+ *
+ * @return  N/A
+ *
+ */
+static void vGetModuleShmRange( AMI_CMD_REQUEST *pxCmdRequest, uint64_t *pullAddress, uint32_t *pulLength );
+
+/**
+ * @brief   Get the shared memory range written by a partition digest request
+ *
+ * @param   pxCmdRequest The request details
+ * @param   pullAddress  Offset from the shared memory base
+ * @param   pulLength    Number of bytes from the offset
+ *
+ * @return  N/A
+ *
+ */
+static void vGetDigestShmRange( AMI_CMD_REQUEST *pxCmdRequest, uint64_t *pullAddress, uint32_t *pulLength );
+
+/**
+ * @brief   Check a request against its opcode descriptor
+ *
+ * @param   pxCmdRequest The request details
+ * @param   ppxDesc      The opcode descriptor, set if the request is valid
+ *
+ * @return  OK if the request can be dispatched, ERROR if it must be rejected
+ *
+ */
+static int iValidateRequest( AMI_CMD_REQUEST *pxCmdRequest, const AMIProxyOpCodeDesc **ppxDesc );
+
+/**
+ * @brief   Complete a request straight away without raising an event
+ *
+ * @param   pxCmdRequest The request details
+ * @param   xResult      Result code returned to the host
+ *
+ * @return  N/A
+ *
+ */
+static void vRejectRequest( AMI_CMD_REQUEST *pxCmdRequest, AMI_PROXY_RESULT xResult );
+
+/*
+ * Request validation & dispatch, indexed by ucOpCodeSlot( ), slots 0x7 - 0x9 are unused.
+ * Payload sizes must match the host, which sets the header count to the payload it sends.
+ * PDI copy addresses the RPU buffer rather than the shared memory, so it has no range.
+ */
+static const AMIProxyOpCodeDesc pxOpCodeTable[ AMI_OPCODE_SLOTS ] =
+{
+    /* 0x0 */ { AMI_CMD_OPCODE_BOOT_SEL_REQ, sizeof( AMIProxyCmdDataPayload ),
+                iHandleBootSelectRequest, NULL, AMI_PROXY_ERRORS_MAX },
+    /* 0x1 */ { AMI_CMD_OPCODE_IDENTIFY_REQ, 0,
+                iHandleIdentifyRequest, NULL, AMI_PROXY_ERRORS_MAX },
+    /* 0x2 */ { AMI_CMD_OPCODE_HEARTBEAT_REQ, sizeof( AMIProxyCmdHeartbeatPayload ),
+                iHandleHeartbeatRequest, NULL, AMI_PROXY_ERRORS_GET_HEARTBEAT_REQUEST },
+    /* 0x3 */ { AMI_CMD_OPCODE_EEPROM_RW_REQ, sizeof( AMIProxyCmdEepromPayload ),
+                iHandleEepromRequest, vGetEepromShmRange, AMI_PROXY_ERRORS_GET_EEPROM_RW_REQUEST },
+    /* 0x4 */ { AMI_CMD_OPCODE_MODULE_RW_REQ, sizeof( AMIProxyCmdModulePayload ),
+                iHandleModuleRequest, vGetModuleShmRange, AMI_PROXY_ERRORS_GET_MODULE_RW_REQUEST },
+    /* 0x5 */ { AMI_CMD_OPCODE_DEBUG_VERBOSITY_REQ, sizeof( uint8_t ),
+                iHandleDebugVerbosityRequest, NULL, AMI_PROXY_ERRORS_GET_DEBUG_VERBOSITY_REQUEST },
+    /* 0x6 */ { AMI_CMD_OPCODE_FPT_FLAGS_REQ, sizeof( AMIProxyCmdFptFlagsPayload ),
+                iHandleFptFlagsRequest, NULL, AMI_PROXY_ERRORS_SET_FPT_FLAGS_REQUEST },
+    /* 0x7 */ { 0, 0, NULL, NULL, AMI_PROXY_ERRORS_MAX },
+    /* 0x8 */ { 0, 0, NULL, NULL, AMI_PROXY_ERRORS_MAX },
+    /* 0x9 */ { 0, 0, NULL, NULL, AMI_PROXY_ERRORS_MAX },
+    /* 0xA */ { AMI_CMD_OPCODE_PDI_DOWNLOAD_REQ, sizeof( AMIProxyCmdDataPayload ),
+                iHandlePdiDownloadRequest, vGetPdiShmRange, AMI_PROXY_ERRORS_MAX },
+    /* 0xB */ { AMI_CMD_OPCODE_PDI_PROGRAM_REQ, sizeof( AMIProxyCmdDataPayload ),
+                iHandlePdiProgramRequest, vGetPdiShmRange, AMI_PROXY_ERRORS_MAX },
+    /* 0xC */ { AMI_CMD_OPCODE_SENSOR_REQ, sizeof( AMIProxyCmdReqSensorPayload ),
+                iHandleSensorRequest, vGetSensorShmRange, AMI_PROXY_ERRORS_MAX },
+    /* 0xD */ { AMI_CMD_OPCODE_PDI_COPY_REQ, sizeof( AMIProxyCmdDataPayload ),
+                iHandlePdiCopyRequest, NULL, AMI_PROXY_ERRORS_MAX },
+    /* 0xE */ { AMI_CMD_OPCODE_PARTITION_DIGEST_REQ, sizeof( AMIProxyCmdDigestPayload ),
+                iHandlePartitionDigestRequest, vGetDigestShmRange, AMI_PROXY_ERRORS_PARTITION_DIGEST_REQUEST },
+    /* 0xF */ { AMI_CMD_OPCODE_SVC_STATS_REQ, sizeof( AMIProxyCmdSvcStatsPayload ),
+                iHandleSvcStatsRequest, NULL, AMI_PROXY_ERRORS_SVC_STATS_REQUEST }
+};
+
 
 /******************************************************************************/
 /* Public Function implementations                                            */
@@ -595,30 +997,53 @@ static int iHandleFptFlagsRequest( AMI_CMD_REQUEST *pxCmdRequest );
  * @brief   Main initialisation point for the AMI Proxy Driver
  */
 int iAMI_Initialise( uint8_t ucProxyId, FWIfCfg *pxFwIf, uint32_t ulFwIfPort,
-                     uint32_t ulTaskPrio, uint32_t ulTaskStack )
+                     uint32_t ulTaskPrio, uint32_t ulTaskStack, uint8_t ucRxDataSize,
+                     uint32_t ulSharedMemSize )
 {
     int iStatus = ERROR;
 
     if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
         ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
         ( FALSE == pxThis->iInitialised ) &&
-        ( NULL != pxFwIf ) )
+        ( NULL != pxFwIf ) &&
+        ( AMI_RXDATA_MIN_SIZE <= ucRxDataSize ) )
     {
         /* Store parameters locally */
-        pxThis->ucMyId     = ucProxyId;
-        pxThis->pxFwIf     = pxFwIf;
-        pxThis->ulFwIfPort = ulFwIfPort;
+        pxThis->ucMyId       = ucProxyId;
+        pxThis->pxChannel[ 0 ].pxFwIf     = pxFwIf;
+        pxThis->pxChannel[ 0 ].ulFwIfPort = ulFwIfPort;
+        pxThis->ucNumChannels = 1;
+        pxThis->ucRxDataSize = ucRxDataSize;
+        pxThis->ulSharedMemSize = ulSharedMemSize;
+
+        pxThis->pxRxData = ( AMIProxyRxData* )pvOSAL_MemAlloc( ucRxDataSize * sizeof( AMIProxyRxData ) );
+        pxThis->pucRxFreeList = ( uint8_t* )pvOSAL_MemAlloc( ucRxDataSize * sizeof( uint8_t ) );
 
-        /* initalise evl record*/
-        if ( OK != iEVL_CreateRecord( &pxThis->pxEvlRecord ) )
+        /* initalise evl records, the worker raises its events through its own record */
+        if( ( NULL == pxThis->pxRxData ) || ( NULL == pxThis->pucRxFreeList ) )
+        {
+            PLL_ERR( AMI_NAME, "Error allocating rx data table\r\n" );
+            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_INIT_RX_DATA_ALLOC_FAILED )
+        }
+        else if( ( OK != iEVL_CreateRecord( &pxThis->pxEvlRecord ) ) ||
+                 ( OK != iEVL_CreateRecord( &pxThis->pxWorkerEvlRecord ) ) )
         {
             PLL_ERR( AMI_NAME, "Error initialising EVLRecord\r\n" );
             INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_INIT_EVL_RECORD_FAILED );
         }
         else
         {
+            int i = 0;
 
-            if( FW_IF_ERRORS_NONE != pxThis->pxFwIf->open( pxThis->pxFwIf ) )
+            pvOSAL_MemSet( pxThis->pxRxData, 0, ucRxDataSize * sizeof( AMIProxyRxData ) );
+            for( i = 0; i < ucRxDataSize; i++ )
+            {
+                pxThis->pucRxFreeList[ i ] = ( uint8_t )( ucRxDataSize - 1 - i );
+            }
+            pxThis->ucRxFreeCount = ucRxDataSize;
+            pxThis->ucHeavyInUse = 0;
+
+            if( FW_IF_ERRORS_NONE != pxFwIf->open( pxFwIf ) )
             {
                 PLL_ERR( AMI_NAME, "Error opening FW_IF\r\n" );
                 INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_INIT_FW_IF_OPEN_FAILED )
@@ -632,12 +1057,38 @@ int iAMI_Initialise( uint8_t ucProxyId, FWIfCfg *pxFwIf, uint32_t ulFwIfPort,
                     PLL_ERR( AMI_NAME, "Error initialising mutex\r\n" );
                     INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_INIT_MUTEX_CREATE_FAILED )
                 }
-                else if( OSAL_ERRORS_NONE != iOSAL_MBox_Create( &pxThis->pvOsalMBoxHdl, AMI_MBOX_SIZE,
+                else if( OSAL_ERRORS_NONE != iOSAL_MBox_Create( &pxThis->pvOsalMBoxHdl, ucRxDataSize,
                                                     sizeof( AMIProxyMboxMsg ), "ami_proxy mbox" ) )
                 {
                     PLL_ERR( AMI_NAME, "Error initialising mbox\r\n" );
                     INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_INIT_MBOX_CREATE_FAILED )
                 }
+                else if( OSAL_ERRORS_NONE != iOSAL_Semaphore_Create( &pxThis->pvOsalWakeSemHdl,
+                                                                     0,
+                                                                     1,
+                                                                     "ami_proxy wake" ) )
+                {
+                    PLL_ERR( AMI_NAME, "Error initialising wake semaphore\r\n" );
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_INIT_WAKE_SEM_CREATE_FAILED )
+                }
+                else if( OSAL_ERRORS_NONE != iOSAL_MBox_Create( &pxThis->pvOsalWorkerMBoxHdl,
+                                                                AMI_RXDATA_HEAVY_MAX( ucRxDataSize ),
+                                                                sizeof( EVLSignal ),
+                                                                "ami_proxy worker mbox" ) )
+                {
+                    PLL_ERR( AMI_NAME, "Error initialising worker mbox\r\n" );
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_INIT_WORKER_MBOX_CREATE_FAILED )
+                }
+                else if( OSAL_ERRORS_NONE != iOSAL_Task_Create( &pxThis->pvOsalWorkerTaskHdl,
+                                                                vProxyWorkerTask,
+                                                                ulTaskStack,
+                                                                NULL,
+                                                                ulTaskPrio,
+                                                                "ami_proxy worker" ) )
+                {
+                    PLL_ERR( AMI_NAME, "Error initialising worker task\r\n" );
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_INIT_WORKER_TASK_CREATE_FAILED )
+                }
                 else if( OSAL_ERRORS_NONE != iOSAL_Task_Create( &pxThis->pvOsalTaskHdl,
                                                                 vProxyDriverTask,
                                                                 ulTaskStack,
@@ -652,6 +1103,8 @@ int iAMI_Initialise( uint8_t ucProxyId, FWIfCfg *pxFwIf, uint32_t ulFwIfPort,
                 {
                     INC_STAT_COUNTER( AMI_PROXY_STATS_CREATE_MUTEX )
                     INC_STAT_COUNTER( AMI_PROXY_STATS_CREATE_MBOX )
+                    INC_STAT_COUNTER( AMI_PROXY_STATS_CREATE_WAKE_SEM )
+                    INC_STAT_COUNTER( AMI_PROXY_STATS_CREATE_WORKER_MBOX )
                     INC_STAT_COUNTER( AMI_PROXY_STATS_INIT_OVERALL_COMPLETE )
                     pxThis->iInitialised = TRUE;
                     pxThis->xState = MODULE_STATE_OK;
@@ -668,22 +1121,54 @@ int iAMI_Initialise( uint8_t ucProxyId, FWIfCfg *pxFwIf, uint32_t ulFwIfPort,
 }
 
 /**
- * @brief   Bind into this proxy driver
+ * @brief   Add another Firmware Interface for the host to send requests on
  */
-int iAMI_BindCallback( EVL_CALLBACK *pxCallback )
+int iAMI_AddChannel( FWIfCfg *pxFwIf, uint32_t ulFwIfPort )
 {
     int iStatus = ERROR;
 
     if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
         ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
         ( TRUE == pxThis->iInitialised ) &&
-        ( NULL != pxCallback ) &&
-        ( NULL != pxThis->pxEvlRecord ) )
+        ( NULL != pxFwIf ) )
     {
-        iStatus = iEVL_BindCallback( pxThis->pxEvlRecord, pxCallback );
-        if( ERROR == iStatus )
+        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl, OSAL_TIMEOUT_WAIT_FOREVER ) )
         {
-            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_BIND_CB_FAILED )
+            INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
+
+            if( AMI_PROXY_MAX_CHANNELS <= pxThis->ucNumChannels )
+            {
+                PLL_ERR( AMI_NAME, "Error no free channels\r\n" );
+                INC_ERROR_COUNTER( AMI_PROXY_ERRORS_NO_FREE_CHANNELS )
+            }
+            else if( FW_IF_ERRORS_NONE != pxFwIf->open( pxFwIf ) )
+            {
+                PLL_ERR( AMI_NAME, "Error opening FW_IF\r\n" );
+                INC_ERROR_COUNTER( AMI_PROXY_INIT_FW_IF_OPEN_FAILED )
+            }
+            else
+            {
+                /* The task only reads the count, so publish the channel before it */
+                pxThis->pxChannel[ pxThis->ucNumChannels ].pxFwIf     = pxFwIf;
+                pxThis->pxChannel[ pxThis->ucNumChannels ].ulFwIfPort = ulFwIfPort;
+                pxThis->ucNumChannels++;
+                INC_STAT_COUNTER( AMI_PROXY_STATS_CHANNEL_ADDED )
+                iStatus = OK;
+            }
+
+            if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
+                iStatus = ERROR;
+            }
+            else
+            {
+                INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
+            }
+        }
+        else
+        {
+            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
         }
     }
     else
@@ -693,28 +1178,58 @@ int iAMI_BindCallback( EVL_CALLBACK *pxCallback )
     return iStatus;
 }
 
-
-/* Set Functions **************************************************************/
-
 /**
- * Set the pdi download response once complete
+ * @brief   Bind into this proxy driver
  */
-int iAMI_SetPdiDownloadCompleteResponse( EVLSignal *pxSignal, AMI_PROXY_RESULT xResult )
+int iAMI_BindCallback( EVL_CALLBACK *pxCallback )
 {
     int iStatus = ERROR;
 
     if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
         ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
-        ( NULL != pxSignal ) &&
-        ( TRUE == pxThis->iInitialised ) )
+        ( TRUE == pxThis->iInitialised ) &&
+        ( NULL != pxCallback ) &&
+        ( NULL != pxThis->pxEvlRecord ) &&
+        ( NULL != pxThis->pxWorkerEvlRecord ) )
     {
-        AMIProxyMboxMsg xMsg = { 0 };
+        iStatus = iEVL_BindCallback( pxThis->pxEvlRecord, pxCallback );
+        if( OK == iStatus )
+        {
+            iStatus = iEVL_BindCallback( pxThis->pxWorkerEvlRecord, pxCallback );
+        }
+
+        if( ERROR == iStatus )
+        {
+            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_BIND_CB_FAILED )
+        }
+    }
+    else
+    {
+        INC_ERROR_COUNTER( AMI_PROXY_VALIDATION_FAILED )
+    }
+    return iStatus;
+}
+
+
+/* Set Functions **************************************************************/
+
+/**
+ * Set the pdi download response once complete
+ */
+int iAMI_SetPdiDownloadCompleteResponse( EVLSignal *pxSignal, AMI_PROXY_RESULT xResult )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( NULL != pxSignal ) &&
+        ( TRUE == pxThis->iInitialised ) )
+    {
+        AMIProxyMboxMsg xMsg = { 0 };
         xMsg.ucRxDataIndex = pxSignal->ucInstance;
         xMsg.eMsgType = AMI_MSG_TYPE_PDI_DOWNLOAD_COMPLETE;
         xMsg.xResult = xResult;
-        if( OSAL_ERRORS_NONE == iOSAL_MBox_Post( pxThis->pvOsalMBoxHdl,
-                                                 ( void* )&xMsg,
-                                                 OSAL_TIMEOUT_NO_WAIT ) )
+        if( OK == iPostMBoxMsg( &xMsg ) )
         {
             INC_STAT_COUNTER( AMI_PROXY_STATS_PDI_DOWNLOAD_MBOX_POST )
             iStatus = OK;
@@ -747,9 +1262,7 @@ int iAMI_SetPdiCopyCompleteResponse( EVLSignal *pxSignal, AMI_PROXY_RESULT xResu
         xMsg.ucRxDataIndex = pxSignal->ucInstance;
         xMsg.eMsgType = AMI_MSG_TYPE_PDI_COPY_COMPLETE;
         xMsg.xResult = xResult;
-        if( OSAL_ERRORS_NONE == iOSAL_MBox_Post( pxThis->pvOsalMBoxHdl,
-                                                 ( void* )&xMsg,
-                                                 OSAL_TIMEOUT_NO_WAIT ) )
+        if( OK == iPostMBoxMsg( &xMsg ) )
         {
             INC_STAT_COUNTER( AMI_PROXY_STATS_PDI_COPY_MBOX_POST )
             iStatus = OK;
@@ -782,9 +1295,7 @@ int iAMI_SetPdiProgramCompleteResponse( EVLSignal *pxSignal, AMI_PROXY_RESULT xR
         xMsg.ucRxDataIndex = pxSignal->ucInstance;
         xMsg.eMsgType = AMI_MSG_TYPE_PDI_PROGRAM_COMPLETE;
         xMsg.xResult = xResult;
-        if( OSAL_ERRORS_NONE == iOSAL_MBox_Post( pxThis->pvOsalMBoxHdl,
-                                                 ( void* )&xMsg,
-                                                 OSAL_TIMEOUT_NO_WAIT ) )
+        if( OK == iPostMBoxMsg( &xMsg ) )
         {
             INC_STAT_COUNTER( AMI_PROXY_STATS_PDI_PROGRAM_MBOX_POST )
             iStatus = OK;
@@ -817,9 +1328,7 @@ int iAMI_SetSensorCompleteResponse( EVLSignal *pxSignal, AMI_PROXY_RESULT xResul
         xMsg.ucRxDataIndex = pxSignal->ucInstance;
         xMsg.eMsgType = AMI_MSG_TYPE_SENSOR_COMPLETE;
         xMsg.xResult = xResult;
-        if( OSAL_ERRORS_NONE == iOSAL_MBox_Post( pxThis->pvOsalMBoxHdl,
-                                                 ( void* )&xMsg,
-                                                 OSAL_TIMEOUT_NO_WAIT ) )
+        if( OK == iPostMBoxMsg( &xMsg ) )
         {
             INC_STAT_COUNTER( AMI_PROXY_STATS_SENSOR_MBOX_POST )
             iStatus = OK;
@@ -856,9 +1365,7 @@ int iAMI_SetIdentityResponse( EVLSignal *pxSignal,
         xMsg.eMsgType = AMI_MSG_TYPE_IDENTITY_COMPLETE;
         xMsg.xResult = xResult;
         pvOSAL_MemCpy( &xMsg.xIdentity, pxIdentityResponse, sizeof( xMsg.xIdentity ) );
-        if( OSAL_ERRORS_NONE == iOSAL_MBox_Post( pxThis->pvOsalMBoxHdl,
-                                                 ( void* )&xMsg,
-                                                 OSAL_TIMEOUT_NO_WAIT ) )
+        if( OK == iPostMBoxMsg( &xMsg ) )
         {
             INC_STAT_COUNTER( AMI_PROXY_STATS_IDENTITY_MBOX_POST )
             iStatus = OK;
@@ -891,9 +1398,7 @@ int iAMI_SetBootSelectCompleteResponse( EVLSignal *pxSignal, AMI_PROXY_RESULT xR
         xMsg.ucRxDataIndex = pxSignal->ucInstance;
         xMsg.eMsgType = AMI_MSG_TYPE_BOOT_SELECT_COMPLETE;
         xMsg.xResult = xResult;
-        if( OSAL_ERRORS_NONE == iOSAL_MBox_Post( pxThis->pvOsalMBoxHdl,
-                                                 ( void* )&xMsg,
-                                                 OSAL_TIMEOUT_NO_WAIT ) )
+        if( OK == iPostMBoxMsg( &xMsg ) )
         {
             INC_STAT_COUNTER( AMI_PROXY_STATS_BOOT_SELECT_MBOX_POST )
             iStatus = OK;
@@ -926,9 +1431,7 @@ int iAMI_SetEepromReadWriteCompleteResponse( EVLSignal *pxSignal, AMI_PROXY_RESU
         xMsg.ucRxDataIndex = pxSignal->ucInstance;
         xMsg.eMsgType = AMI_MSG_TYPE_EEPROM_RW_COMPLETE;
         xMsg.xResult = xResult;
-        if( OSAL_ERRORS_NONE == iOSAL_MBox_Post( pxThis->pvOsalMBoxHdl,
-                                                 ( void* )&xMsg,
-                                                 OSAL_TIMEOUT_NO_WAIT ) )
+        if( OK == iPostMBoxMsg( &xMsg ) )
         {
             INC_STAT_COUNTER( AMI_PROXY_STATS_EEPROM_RW_MBOX_POST )
             iStatus = OK;
@@ -961,9 +1464,7 @@ int iAMI_SetModuleReadWriteCompleteResponse( EVLSignal *pxSignal, AMI_PROXY_RESU
         xMsg.ucRxDataIndex = pxSignal->ucInstance;
         xMsg.eMsgType = AMI_MSG_TYPE_MODULE_RW_COMPLETE;
         xMsg.xResult = xResult;
-        if( OSAL_ERRORS_NONE == iOSAL_MBox_Post( pxThis->pvOsalMBoxHdl,
-                                                 ( void* )&xMsg,
-                                                 OSAL_TIMEOUT_NO_WAIT ) )
+        if( OK == iPostMBoxMsg( &xMsg ) )
         {
             INC_STAT_COUNTER( AMI_PROXY_STATS_MODULE_RW_MBOX_POST )
             iStatus = OK;
@@ -996,9 +1497,7 @@ int iAMI_SetDebugVerbosityResponse( EVLSignal *pxSignal, AMI_PROXY_RESULT xResul
         xMsg.ucRxDataIndex = pxSignal->ucInstance;
         xMsg.eMsgType = AMI_MSG_TYPE_DEBUG_VERBOSITY_COMPLETE;
         xMsg.xResult = xResult;
-        if( OSAL_ERRORS_NONE == iOSAL_MBox_Post( pxThis->pvOsalMBoxHdl,
-                                                 ( void* )&xMsg,
-                                                 OSAL_TIMEOUT_NO_WAIT ) )
+        if( OK == iPostMBoxMsg( &xMsg ) )
         {
             INC_STAT_COUNTER( AMI_PROXY_STATS_MODULE_RW_MBOX_POST )
             iStatus = OK;
@@ -1032,9 +1531,7 @@ int iAMI_SetFptFlagsResponse( EVLSignal *pxSignal, AMI_PROXY_RESULT xResult, uin
         xMsg.eMsgType = AMI_MSG_TYPE_FPT_FLAGS_COMPLETE;
         xMsg.xResult = xResult;
         xMsg.ulFptFlags = ulFlags;
-        if( OSAL_ERRORS_NONE == iOSAL_MBox_Post( pxThis->pvOsalMBoxHdl,
-                                                 ( void* )&xMsg,
-                                                 OSAL_TIMEOUT_NO_WAIT ) )
+        if( OK == iPostMBoxMsg( &xMsg ) )
         {
             INC_STAT_COUNTER( AMI_PROXY_STATS_BOOT_SELECT_MBOX_POST )
             iStatus = OK;
@@ -1051,6 +1548,39 @@ int iAMI_SetFptFlagsResponse( EVLSignal *pxSignal, AMI_PROXY_RESULT xResult, uin
     return iStatus;
 }
 
+/**
+ * @brief   Set the partition digest response
+ */
+int iAMI_SetPartitionDigestResponse( EVLSignal *pxSignal, AMI_PROXY_RESULT xResult )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( TRUE == pxThis->iInitialised ) &&
+        ( NULL != pxSignal ) )
+    {
+        AMIProxyMboxMsg xMsg = { 0 };
+        xMsg.ucRxDataIndex = pxSignal->ucInstance;
+        xMsg.eMsgType = AMI_MSG_TYPE_PARTITION_DIGEST_COMPLETE;
+        xMsg.xResult = xResult;
+        if( OK == iPostMBoxMsg( &xMsg ) )
+        {
+            INC_STAT_COUNTER( AMI_PROXY_STATS_PARTITION_DIGEST_MBOX_POST )
+            iStatus = OK;
+        }
+        else
+        {
+            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MAILBOX_POST_FAILED )
+        }
+    }
+    else
+    {
+        INC_ERROR_COUNTER( AMI_PROXY_VALIDATION_FAILED )
+    }
+    return iStatus;
+}
+
 /* Get Functions **************************************************************/
 
 /**
@@ -1077,36 +1607,36 @@ int iAMI_GetPdiDownloadRequest( EVLSignal *pxSignal,
             INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
 
             if( AMI_CHECK_VALID_INDEX( ucIndex ) &&
-                ( TRUE == pxThis->xRxData[ ucIndex ].ucInUse ) &&
-                AMI_CMD_OPCODE_PDI_DOWNLOAD_REQ == pxThis->xRxData[ ucIndex ].xOpCode )
+                ( TRUE == pxThis->pxRxData[ ucIndex ].ucInUse ) &&
+                AMI_CMD_OPCODE_PDI_DOWNLOAD_REQ == pxThis->pxRxData[ ucIndex ].xOpCode )
             {
                 pxDownloadRequest->iBootDevice =
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.iBootDevice;
+                            pxThis->pxRxData[ ucIndex ].xDownloadRequest.iBootDevice;
                 pxDownloadRequest->ullAddress =
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.ullAddress;
+                            pxThis->pxRxData[ ucIndex ].xDownloadRequest.ullAddress;
                 pxDownloadRequest->ulLength =
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.ulLength;
+                            pxThis->pxRxData[ ucIndex ].xDownloadRequest.ulLength;
                 pxDownloadRequest->ulPartitionSel =
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.ulPartitionSel;
+                            pxThis->pxRxData[ ucIndex ].xDownloadRequest.ulPartitionSel;
                 pvOSAL_MemCpy( pxDownloadRequest->pucPdiMd5,
-                               pxThis->xRxData[ ucIndex ].xDownloadRequest.pucPdiMd5,
+                               pxThis->pxRxData[ ucIndex ].xDownloadRequest.pucPdiMd5,
                                sizeof( pxDownloadRequest->pucPdiMd5 ) );
                 pxDownloadRequest->ulPdiSize =
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.ulPdiSize;
+                            pxThis->pxRxData[ ucIndex ].xDownloadRequest.ulPdiSize;
                 pxDownloadRequest->usPacketNum =
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.usPacketNum;
+                            pxThis->pxRxData[ ucIndex ].xDownloadRequest.usPacketNum;
                 pxDownloadRequest->ulPacketSize =
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.ulPacketSize;
+                            pxThis->pxRxData[ ucIndex ].xDownloadRequest.ulPacketSize;
                 pxDownloadRequest->iUpdateFpt =
-                             pxThis->xRxData[ ucIndex ].xDownloadRequest.iUpdateFpt;
+                             pxThis->pxRxData[ ucIndex ].xDownloadRequest.iUpdateFpt;
                 pxDownloadRequest->iPdiProgram =
-                             pxThis->xRxData[ ucIndex ].xDownloadRequest.iPdiProgram;
+                             pxThis->pxRxData[ ucIndex ].xDownloadRequest.iPdiProgram;
                 pxDownloadRequest->iApuPdiProgram =
-                             pxThis->xRxData[ ucIndex ].xDownloadRequest.iApuPdiProgram;
+                             pxThis->pxRxData[ ucIndex ].xDownloadRequest.iApuPdiProgram;
                 pxDownloadRequest->iRpuPdiProgram =
-                             pxThis->xRxData[ ucIndex ].xDownloadRequest.iRpuPdiProgram;
+                             pxThis->pxRxData[ ucIndex ].xDownloadRequest.iRpuPdiProgram;
                 pxDownloadRequest->iLastPacket =
-                             pxThis->xRxData[ ucIndex ].xDownloadRequest.iLastPacket;
+                             pxThis->pxRxData[ ucIndex ].xDownloadRequest.iLastPacket;
                 iStatus = OK;
             }
             else
@@ -1161,21 +1691,21 @@ int iAMI_GetPdiCopyRequest( EVLSignal *pxSignal,
             INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
 
             if( AMI_CHECK_VALID_INDEX( ucIndex ) &&
-                ( TRUE == pxThis->xRxData[ ucIndex ].ucInUse ) &&
-                AMI_CMD_OPCODE_PDI_COPY_REQ == pxThis->xRxData[ ucIndex ].xOpCode )
+                ( TRUE == pxThis->pxRxData[ ucIndex ].ucInUse ) &&
+                AMI_CMD_OPCODE_PDI_COPY_REQ == pxThis->pxRxData[ ucIndex ].xOpCode )
             {
                 pxCopyRequest->ullAddress =
-                            pxThis->xRxData[ ucIndex ].xCopyRequest.ullAddress;
+                            pxThis->pxRxData[ ucIndex ].xCopyRequest.ullAddress;
                 pxCopyRequest->ulMaxLength =
-                            pxThis->xRxData[ ucIndex ].xCopyRequest.ulMaxLength;
+                            pxThis->pxRxData[ ucIndex ].xCopyRequest.ulMaxLength;
                 pxCopyRequest->ulSrcDevice =
-                            pxThis->xRxData[ ucIndex ].xCopyRequest.ulSrcDevice;
+                            pxThis->pxRxData[ ucIndex ].xCopyRequest.ulSrcDevice;
                 pxCopyRequest->ulSrcPartition =
-                            pxThis->xRxData[ ucIndex ].xCopyRequest.ulSrcPartition;
+                            pxThis->pxRxData[ ucIndex ].xCopyRequest.ulSrcPartition;
                 pxCopyRequest->ulDestDevice =
-                            pxThis->xRxData[ ucIndex ].xCopyRequest.ulDestDevice;
+                            pxThis->pxRxData[ ucIndex ].xCopyRequest.ulDestDevice;
                 pxCopyRequest->ulDestPartition =
-                            pxThis->xRxData[ ucIndex ].xCopyRequest.ulDestPartition;
+                            pxThis->pxRxData[ ucIndex ].xCopyRequest.ulDestPartition;
                 iStatus = OK;
             }
             else
@@ -1230,27 +1760,27 @@ int iAMI_GetPdiProgramRequest( EVLSignal *pxSignal,
             INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
 
             if( AMI_CHECK_VALID_INDEX( ucIndex ) &&
-                ( TRUE == pxThis->xRxData[ ucIndex ].ucInUse ) &&
-                AMI_CMD_OPCODE_PDI_PROGRAM_REQ == pxThis->xRxData[ ucIndex ].xOpCode )
+                ( TRUE == pxThis->pxRxData[ ucIndex ].ucInUse ) &&
+                AMI_CMD_OPCODE_PDI_PROGRAM_REQ == pxThis->pxRxData[ ucIndex ].xOpCode )
             {
                 pxProgramRequest->iBootDevice =
-                            pxThis->xRxData[ ucIndex ].xProgramRequest.iBootDevice;
+                            pxThis->pxRxData[ ucIndex ].xProgramRequest.iBootDevice;
                 pxProgramRequest->ullAddress =
-                            pxThis->xRxData[ ucIndex ].xProgramRequest.ullAddress;
+                            pxThis->pxRxData[ ucIndex ].xProgramRequest.ullAddress;
                 pxProgramRequest->ulLength =
-                            pxThis->xRxData[ ucIndex ].xProgramRequest.ulLength;
+                            pxThis->pxRxData[ ucIndex ].xProgramRequest.ulLength;
                 pxProgramRequest->ulPartitionSel =
-                            pxThis->xRxData[ ucIndex ].xProgramRequest.ulPartitionSel;
+                            pxThis->pxRxData[ ucIndex ].xProgramRequest.ulPartitionSel;
                 pxProgramRequest->usPacketNum =
-                            pxThis->xRxData[ ucIndex ].xProgramRequest.usPacketNum;
+                            pxThis->pxRxData[ ucIndex ].xProgramRequest.usPacketNum;
                 pxProgramRequest->ulPacketSize =
-                            pxThis->xRxData[ ucIndex ].xProgramRequest.ulPacketSize;
+                            pxThis->pxRxData[ ucIndex ].xProgramRequest.ulPacketSize;
                 pxProgramRequest->iUpdateFpt =
-                             pxThis->xRxData[ ucIndex ].xProgramRequest.iUpdateFpt;
+                             pxThis->pxRxData[ ucIndex ].xProgramRequest.iUpdateFpt;
                 pxProgramRequest->iPdiProgram =
-                             pxThis->xRxData[ ucIndex ].xProgramRequest.iPdiProgram;
+                             pxThis->pxRxData[ ucIndex ].xProgramRequest.iPdiProgram;
                 pxProgramRequest->iLastPacket =
-                             pxThis->xRxData[ ucIndex ].xProgramRequest.iLastPacket;
+                             pxThis->pxRxData[ ucIndex ].xProgramRequest.iLastPacket;
                 iStatus = OK;
             }
             else
@@ -1305,19 +1835,19 @@ int iAMI_GetSensorRequest( EVLSignal *pxSignal,
             INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
 
             if( AMI_CHECK_VALID_INDEX( ucIndex ) &&
-                ( TRUE == pxThis->xRxData[ ucIndex ].ucInUse ) &&
-                AMI_CMD_OPCODE_SENSOR_REQ == pxThis->xRxData[ ucIndex ].xOpCode )
+                ( TRUE == pxThis->pxRxData[ ucIndex ].ucInUse ) &&
+                AMI_CMD_OPCODE_SENSOR_REQ == pxThis->pxRxData[ ucIndex ].xOpCode )
             {
                 pxSensorRequest->ullAddress =
-                            pxThis->xRxData[ ucIndex ].xSensorRequest.ullAddress;
+                            pxThis->pxRxData[ ucIndex ].xSensorRequest.ullAddress;
                 pxSensorRequest->ulLength =
-                            pxThis->xRxData[ ucIndex ].xSensorRequest.ulLength;
+                            pxThis->pxRxData[ ucIndex ].xSensorRequest.ulLength;
                 pxSensorRequest->ulSensorId =
-                            pxThis->xRxData[ ucIndex ].xSensorRequest.ulSensorId;
+                            pxThis->pxRxData[ ucIndex ].xSensorRequest.ulSensorId;
                 pxSensorRequest->xRepo =
-                            pxThis->xRxData[ ucIndex ].xSensorRequest.xRepo;
+                            pxThis->pxRxData[ ucIndex ].xSensorRequest.xRepo;
                 pxSensorRequest->xRequest =
-                            pxThis->xRxData[ ucIndex ].xSensorRequest.xRequest;
+                            pxThis->pxRxData[ ucIndex ].xSensorRequest.xRequest;
                 iStatus = OK;
             }
             else
@@ -1372,11 +1902,11 @@ int iAMI_GetBootSelectRequest( EVLSignal *pxSignal,
             INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
 
             if( AMI_CHECK_VALID_INDEX( ucIndex ) &&
-                ( TRUE == pxThis->xRxData[ ucIndex ].ucInUse ) &&
-                AMI_CMD_OPCODE_BOOT_SEL_REQ == pxThis->xRxData[ ucIndex ].xOpCode )
+                ( TRUE == pxThis->pxRxData[ ucIndex ].ucInUse ) &&
+                AMI_CMD_OPCODE_BOOT_SEL_REQ == pxThis->pxRxData[ ucIndex ].xOpCode )
             {
                 pxBootSelectRequest->ulPartitionSel =
-                            pxThis->xRxData[ ucIndex ].xBootSelectRequest.ulPartitionSel;
+                            pxThis->pxRxData[ ucIndex ].xBootSelectRequest.ulPartitionSel;
                 iStatus = OK;
             }
             else
@@ -1431,17 +1961,17 @@ int iAMI_GetEepromReadWriteRequest( EVLSignal *pxSignal,
             INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
 
             if( AMI_CHECK_VALID_INDEX( ucIndex ) &&
-                ( TRUE == pxThis->xRxData[ ucIndex ].ucInUse ) &&
-                AMI_CMD_OPCODE_EEPROM_RW_REQ == pxThis->xRxData[ ucIndex ].xOpCode )
+                ( TRUE == pxThis->pxRxData[ ucIndex ].ucInUse ) &&
+                AMI_CMD_OPCODE_EEPROM_RW_REQ == pxThis->pxRxData[ ucIndex ].xOpCode )
             {
                 pxEepromReadWriteRequest->xRequest =
-                            pxThis->xRxData[ ucIndex ].xEepromReadWriteRequest.xRequest;
+                            pxThis->pxRxData[ ucIndex ].xEepromReadWriteRequest.xRequest;
                 pxEepromReadWriteRequest->ullAddress =
-                            pxThis->xRxData[ ucIndex ].xEepromReadWriteRequest.ullAddress;
+                            pxThis->pxRxData[ ucIndex ].xEepromReadWriteRequest.ullAddress;
                 pxEepromReadWriteRequest->ulLength =
-                            pxThis->xRxData[ ucIndex ].xEepromReadWriteRequest.ulLength;
+                            pxThis->pxRxData[ ucIndex ].xEepromReadWriteRequest.ulLength;
                 pxEepromReadWriteRequest->ulOffset =
-                            pxThis->xRxData[ ucIndex ].xEepromReadWriteRequest.ulOffset;
+                            pxThis->pxRxData[ ucIndex ].xEepromReadWriteRequest.ulOffset;
 
                 iStatus = OK;
             }
@@ -1497,21 +2027,21 @@ int iAMI_GetModuleReadWriteRequest( EVLSignal *pxSignal,
             INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
 
             if( AMI_CHECK_VALID_INDEX( ucIndex ) &&
-                ( TRUE == pxThis->xRxData[ ucIndex ].ucInUse ) &&
-                ( AMI_CMD_OPCODE_MODULE_RW_REQ == pxThis->xRxData[ ucIndex ].xOpCode ) )
+                ( TRUE == pxThis->pxRxData[ ucIndex ].ucInUse ) &&
+                ( AMI_CMD_OPCODE_MODULE_RW_REQ == pxThis->pxRxData[ ucIndex ].xOpCode ) )
             {
                 pxModuleReadWriteRequest->xRequest =
-                            pxThis->xRxData[ ucIndex ].xModuleReadWriteRequest.xRequest;
+                            pxThis->pxRxData[ ucIndex ].xModuleReadWriteRequest.xRequest;
                 pxModuleReadWriteRequest->ullAddress =
-                            pxThis->xRxData[ ucIndex ].xModuleReadWriteRequest.ullAddress;
+                            pxThis->pxRxData[ ucIndex ].xModuleReadWriteRequest.ullAddress;
                 pxModuleReadWriteRequest->ucExDeviceId =
-                            pxThis->xRxData[ ucIndex ].xModuleReadWriteRequest.ucExDeviceId;
+                            pxThis->pxRxData[ ucIndex ].xModuleReadWriteRequest.ucExDeviceId;
                 pxModuleReadWriteRequest->ucPage =
-                            pxThis->xRxData[ ucIndex ].xModuleReadWriteRequest.ucPage;
+                            pxThis->pxRxData[ ucIndex ].xModuleReadWriteRequest.ucPage;
                 pxModuleReadWriteRequest->ucByteOffset =
-                            pxThis->xRxData[ ucIndex ].xModuleReadWriteRequest.ucByteOffset;
+                            pxThis->pxRxData[ ucIndex ].xModuleReadWriteRequest.ucByteOffset;
                 pxModuleReadWriteRequest->ucLength =
-                            pxThis->xRxData[ ucIndex ].xModuleReadWriteRequest.ucLength;
+                            pxThis->pxRxData[ ucIndex ].xModuleReadWriteRequest.ucLength;
 
                 iStatus = OK;
             }
@@ -1567,10 +2097,10 @@ int iAMI_GetDebugVerbosityRequest( EVLSignal *pxSignal,
             INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
 
             if( AMI_CHECK_VALID_INDEX( ucIndex ) &&
-                ( TRUE == pxThis->xRxData[ ucIndex ].ucInUse ) &&
-                ( AMI_CMD_OPCODE_DEBUG_VERBOSITY_REQ == pxThis->xRxData[ ucIndex ].xOpCode ) )
+                ( TRUE == pxThis->pxRxData[ ucIndex ].ucInUse ) &&
+                ( AMI_CMD_OPCODE_DEBUG_VERBOSITY_REQ == pxThis->pxRxData[ ucIndex ].xOpCode ) )
             {
-                *pucDebugVerbosityRequest = pxThis->xRxData[ ucIndex ].ucDebugVerbosityRequest;
+                *pucDebugVerbosityRequest = pxThis->pxRxData[ ucIndex ].ucDebugVerbosityRequest;
                 iStatus = OK;
             }
             else
@@ -1625,28 +2155,28 @@ int iAMI_GetFptFlagsRequest( EVLSignal *pxSignal,
             INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
 
             if( AMI_CHECK_VALID_INDEX( ucIndex ) &&
-                ( TRUE == pxThis->xRxData[ ucIndex ].ucInUse ) &&
-                ( AMI_CMD_OPCODE_FPT_FLAGS_REQ == pxThis->xRxData[ ucIndex ].xOpCode ) )
+                ( TRUE == pxThis->pxRxData[ ucIndex ].ucInUse ) &&
+                ( AMI_CMD_OPCODE_FPT_FLAGS_REQ == pxThis->pxRxData[ ucIndex ].xOpCode ) )
             {
                 pxFptFlagsRequest->xRequest =
-                            pxThis->xRxData[ ucIndex ].xFptFlagsRequest.xRequest;
+                            pxThis->pxRxData[ ucIndex ].xFptFlagsRequest.xRequest;
                 pxFptFlagsRequest->ulBootDevice =
-                            pxThis->xRxData[ ucIndex ].xFptFlagsRequest.ulBootDevice;
+                            pxThis->pxRxData[ ucIndex ].xFptFlagsRequest.ulBootDevice;
                 pxFptFlagsRequest->ulPartitionId =
-                            pxThis->xRxData[ ucIndex ].xFptFlagsRequest.ulPartitionId;
+                            pxThis->pxRxData[ ucIndex ].xFptFlagsRequest.ulPartitionId;
                 pxFptFlagsRequest->ulType =
-                            pxThis->xRxData[ ucIndex ].xFptFlagsRequest.ulType;
+                            pxThis->pxRxData[ ucIndex ].xFptFlagsRequest.ulType;
                 pxFptFlagsRequest->ulBaseAddr =
-                            pxThis->xRxData[ ucIndex ].xFptFlagsRequest.ulBaseAddr;
+                            pxThis->pxRxData[ ucIndex ].xFptFlagsRequest.ulBaseAddr;
                 pxFptFlagsRequest->ulSize =
-                            pxThis->xRxData[ ucIndex ].xFptFlagsRequest.ulSize;
+                            pxThis->pxRxData[ ucIndex ].xFptFlagsRequest.ulSize;
                 pvOSAL_MemCpy( pxFptFlagsRequest->pdi_md5,
-                               pxThis->xRxData[ ucIndex ].xFptFlagsRequest.pdi_md5,
+                               pxThis->pxRxData[ ucIndex ].xFptFlagsRequest.pdi_md5,
                                sizeof( pxFptFlagsRequest->pdi_md5 ) );
                 pxFptFlagsRequest->ulPdiSize =
-                            pxThis->xRxData[ ucIndex ].xFptFlagsRequest.ulPdiSize;
+                            pxThis->pxRxData[ ucIndex ].xFptFlagsRequest.ulPdiSize;
                 pxFptFlagsRequest->ulFlags =
-                            pxThis->xRxData[ ucIndex ].xFptFlagsRequest.ulFlags;
+                            pxThis->pxRxData[ ucIndex ].xFptFlagsRequest.ulFlags;
 
                 iStatus = OK;
             }
@@ -1678,6 +2208,178 @@ int iAMI_GetFptFlagsRequest( EVLSignal *pxSignal,
     return iStatus;
 }
 
+/**
+ * @brief   Get the partition digest request
+ */
+int iAMI_GetPartitionDigestRequest( EVLSignal *pxSignal,
+    AMIProxyPartitionDigestRequest *pxDigestRequest )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( TRUE == pxThis->iInitialised ) &&
+        ( NULL != pxSignal ) &&
+        ( NULL != pxDigestRequest ) )
+    {
+        INC_STAT_COUNTER( AMI_PROXY_STATS_GET_PARTITION_DIGEST_REQUEST )
+
+        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
+                                                  OSAL_TIMEOUT_WAIT_FOREVER ) )
+        {
+            uint8_t ucIndex = pxSignal->ucInstance;
+
+            INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
+
+            if( AMI_CHECK_VALID_INDEX( ucIndex ) &&
+                ( TRUE == pxThis->pxRxData[ ucIndex ].ucInUse ) &&
+                ( AMI_CMD_OPCODE_PARTITION_DIGEST_REQ == pxThis->pxRxData[ ucIndex ].xOpCode ) )
+            {
+                pvOSAL_MemCpy( pxDigestRequest,
+                               &pxThis->pxRxData[ ucIndex ].xDigestRequest,
+                               sizeof( *pxDigestRequest ) );
+                iStatus = OK;
+            }
+            else
+            {
+                PLL_ERR( AMI_NAME, "Error invalid get partition digest request for instance\r\n" );
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_PARTITION_DIGEST_REQUEST )
+            }
+
+            if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
+                iStatus = ERROR;
+            }
+            else
+            {
+                INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
+            }
+        }
+        else
+        {
+            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
+        }
+    }
+    else
+    {
+        INC_ERROR_COUNTER( AMI_PROXY_VALIDATION_FAILED )
+    }
+    return iStatus;
+}
+
+/**
+ * @brief   Get the buffer to return response data inline in the completion entry
+ */
+int iAMI_GetInlineResponseBuffer( EVLSignal *pxSignal, uint8_t **ppucData, uint32_t *pulSize )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( TRUE == pxThis->iInitialised ) &&
+        ( NULL != pxSignal ) &&
+        ( NULL != ppucData ) &&
+        ( NULL != pulSize ) )
+    {
+        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
+                                                  OSAL_TIMEOUT_WAIT_FOREVER ) )
+        {
+            uint8_t ucIndex = pxSignal->ucInstance;
+
+            INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
+
+            /* Not an error if the host did not ask, the caller falls back to shared memory */
+            if( AMI_CHECK_VALID_INDEX( ucIndex ) &&
+                ( TRUE == pxThis->pxRxData[ ucIndex ].ucInUse ) &&
+                ( 0 != pxThis->pxRxData[ ucIndex ].usInlineMax ) )
+            {
+                *ppucData = pxThis->pxRxData[ ucIndex ].pucInline;
+                *pulSize = pxThis->pxRxData[ ucIndex ].usInlineMax;
+                iStatus = OK;
+            }
+
+            if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
+                iStatus = ERROR;
+            }
+            else
+            {
+                INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
+            }
+        }
+        else
+        {
+            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
+        }
+    }
+    else
+    {
+        INC_ERROR_COUNTER( AMI_PROXY_VALIDATION_FAILED )
+    }
+    return iStatus;
+}
+
+/**
+ * @brief   Commit the data written to the inline response buffer
+ */
+int iAMI_SetInlineResponseSize( EVLSignal *pxSignal, uint32_t ulSize )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( TRUE == pxThis->iInitialised ) &&
+        ( NULL != pxSignal ) )
+    {
+        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
+                                                  OSAL_TIMEOUT_WAIT_FOREVER ) )
+        {
+            uint8_t ucIndex = pxSignal->ucInstance;
+
+            INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
+
+            if( AMI_CHECK_VALID_INDEX( ucIndex ) &&
+                ( TRUE == pxThis->pxRxData[ ucIndex ].ucInUse ) &&
+                ( ulSize <= pxThis->pxRxData[ ucIndex ].usInlineMax ) )
+            {
+                AMIProxyRxData *pxRxData = &pxThis->pxRxData[ ucIndex ];
+
+                /* Clear the word padding so stale data never reaches the host */
+                pvOSAL_MemSet( &pxRxData->pucInline[ ulSize ], 0,
+                               MIN( AMI_PROXY_RESPONSE_INLINE_SIZE - ulSize, 3 ) );
+                pxRxData->usInlineLen = ( uint16_t )ulSize;
+                iStatus = OK;
+            }
+            else
+            {
+                PLL_ERR( AMI_NAME, "Error invalid inline response for instance\r\n" );
+                INC_ERROR_COUNTER( AMI_PROXY_ERRORS_INLINE_RESPONSE )
+            }
+
+            if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
+                iStatus = ERROR;
+            }
+            else
+            {
+                INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
+            }
+        }
+        else
+        {
+            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
+        }
+    }
+    else
+    {
+        INC_ERROR_COUNTER( AMI_PROXY_VALIDATION_FAILED )
+    }
+    return iStatus;
+}
+
 /**
  * @brief   Display the current stats/errors
  */
@@ -1711,6 +2413,53 @@ int iAMI_PrintStatistics( void )
     return iStatus;
 }
 
+/**
+ * @brief   Display the per-opcode service times
+ */
+int iAMI_PrintServiceTimes( void )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) )
+    {
+        int i = 0;
+        int j = 0;
+
+        PLL_INF( AMI_NAME, "============================================================\n\r" );
+        PLL_INF( AMI_NAME, "AMI Proxy Service Times (ms):\n\r" );
+        for( i = 0; i < AMI_PROXY_SVC_TIME_OPCODES; i++ )
+        {
+            AMIProxyServiceTime *pxTime = &pxThis->pxServiceTime[ i ];
+
+            if( 0 != pxTime->ulCount )
+            {
+                PLL_INF( AMI_NAME, "Opcode 0x%02x: count %d min %d max %d avg %d\r\n",
+                         ( AMI_OPCODE_SLOT_IDENTIFY == i ) ? ( AMI_CMD_OPCODE_IDENTIFY_REQ ) : ( i ),
+                         pxTime->ulCount, pxTime->ulMinMs, pxTime->ulMaxMs,
+                         pxTime->ulTotalMs / pxTime->ulCount );
+                for( j = 0; j < AMI_PROXY_SVC_TIME_BUCKETS; j++ )
+                {
+                    if( 0 != pxTime->pulHistogram[ j ] )
+                    {
+                        PLL_INF( AMI_NAME, "%20s%5d ms . . . . %d\r\n",
+                                 ( ( AMI_PROXY_SVC_TIME_BUCKETS - 1 ) == j ) ? ">=" : "<",
+                                 ( ( AMI_PROXY_SVC_TIME_BUCKETS - 1 ) == j ) ? ( 1 << ( j - 1 ) ) : ( 1 << j ),
+                                 pxTime->pulHistogram[ j ] );
+                    }
+                }
+            }
+        }
+        PLL_INF( AMI_NAME, "============================================================\n\r" );
+        iStatus = OK;
+    }
+    else
+    {
+        INC_ERROR_COUNTER( AMI_PROXY_VALIDATION_FAILED )
+    }
+    return iStatus;
+}
+
 /**
  * @brief   Set all stats/error values back to zero
  */
@@ -1724,6 +2473,7 @@ int iAMI_ClearStatistics( void )
     {
         pvOSAL_MemSet( pxThis->pulStatCounters, 0, sizeof( pxThis->pulStatCounters ) );
         pvOSAL_MemSet( pxThis->pulErrorCounters, 0, sizeof( pxThis->pulErrorCounters ) );
+        pvOSAL_MemSet( pxThis->pxServiceTime, 0, sizeof( pxThis->pxServiceTime ) );
         iStatus = OK;
     }
     else
@@ -1788,432 +2538,68 @@ static void vProxyDriverTask( void *pvArgs )
     AMIProxyMboxMsg xMBoxData   = { 0 };
     AMI_CMD_REQUEST xCmdRequest = { { { { 0 } } } };
     uint32_t ulStartMs = 0;
+    uint32_t ulCmdRequestSize = 0;
+    uint32_t ulRequests = 0;
+    int iChannel = 0;
 
     for( ;; )
     {
+        /*
+         * Sleep until a response is posted to the mailbox, the GCQ is polled
+         * again after AMI_TASK_POLL_MS if nothing arrives
+         */
+        if( OSAL_ERRORS_NONE == iOSAL_Semaphore_Pend( pxThis->pvOsalWakeSemHdl, AMI_TASK_POLL_MS ) )
+        {
+            INC_STAT_COUNTER( AMI_PROXY_STATS_TASK_WAKEUPS )
+        }
+
         ulStartMs = ulOSAL_GetUptimeMs();
-        uint32_t ulCmdRequestSize = sizeof(AMI_CMD_REQUEST);
+        ulRequests = 0;
+        ulCmdRequestSize = sizeof( AMI_CMD_REQUEST );
 
-        /* Check on incoming FW_IF data (rx path) */
-        if( FW_IF_ERRORS_NONE == pxThis->pxFwIf->read( pxThis->pxFwIf, ( uint64_t )pxThis->ulFwIfPort,
-                                                       ( uint8_t* )&xCmdRequest, &ulCmdRequestSize,
-                                                       FW_IF_TIMEOUT_NO_WAIT ) )
+        /*
+         * Drain all incoming FW_IF data (rx path), added channels carry the
+         * short telemetry requests so they are drained before the first one
+         */
+        for( iChannel = ( int )pxThis->ucNumChannels - 1; iChannel >= 0; iChannel-- )
         {
-            int iStatus = ERROR;
-            uint8_t ucIndex = 0;
+            AMIProxyChannel *pxChannel = &pxThis->pxChannel[ iChannel ];
 
-            /* Handle request based on opcode, Store data internally and raise event */
-            switch( xCmdRequest.xHdr.ulOpCode )
+            pxThis->ucRxChannel = ( uint8_t )iChannel;
+            while( FW_IF_ERRORS_NONE == pxChannel->pxFwIf->read( pxChannel->pxFwIf, ( uint64_t )pxChannel->ulFwIfPort,
+                                                                 ( uint8_t* )&xCmdRequest, &ulCmdRequestSize,
+                                                                 FW_IF_TIMEOUT_NO_WAIT ) )
             {
-                case AMI_CMD_OPCODE_PDI_DOWNLOAD_REQ:
-                    if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
-                                                              OSAL_TIMEOUT_WAIT_FOREVER ) )
-                    {
-                        INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
+                const AMIProxyOpCodeDesc *pxDesc = NULL;
 
-                        iStatus = iFindNextFreeRxDataIndex( &ucIndex );
-                        if( ERROR != iStatus )
-                        {
-                            pxThis->xRxData[ ucIndex ].usCid = xCmdRequest.xHdr.usCid;
-                            pxThis->xRxData[ ucIndex ].xOpCode = xCmdRequest.xHdr.ulOpCode;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.iBootDevice =
-                            	xCmdRequest.xPdiDownloadPayload.ulBootDevice;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.ullAddress =
-                                xCmdRequest.xPdiDownloadPayload.ullAddress;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.ulLength =
-                                xCmdRequest.xPdiDownloadPayload.ulSize;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.ulPartitionSel =
-                                xCmdRequest.xPdiDownloadPayload.ulPartitionSel;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.usPacketNum =
-                                xCmdRequest.xPdiDownloadPayload.usPacketNum;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.ulPacketSize =
-                                xCmdRequest.xPdiDownloadPayload.ulPacketSize;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.iUpdateFpt =
-                                xCmdRequest.xPdiDownloadPayload.ulUpdateFpt;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.iPdiProgram =
-                                xCmdRequest.xPdiDownloadPayload.ulPdiProgram;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.iApuPdiProgram =
-                                xCmdRequest.xPdiDownloadPayload.ulApuPdiProgram;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.iRpuPdiProgram =
-                                xCmdRequest.xPdiDownloadPayload.ulRpuPdiProgram;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.iLastPacket =
-                                xCmdRequest.xPdiDownloadPayload.usLastPacket;
-                            pvOSAL_MemCpy( pxThis->xRxData[ ucIndex ].xDownloadRequest.pucPdiMd5,
-                                           xCmdRequest.xPdiDownloadPayload.pucPdiMd5,
-                                           sizeof( pxThis->xRxData[ ucIndex ].xDownloadRequest.pucPdiMd5 ) );
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.ulPdiSize =
-                                xCmdRequest.xPdiDownloadPayload.ulPdiSize;
-                            pxThis->xRxData[ ucIndex ].ucInUse = TRUE;
-                        }
-                        else
-                        {
-                            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
-                        }
-
-                        if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
-                        {
-                            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
-                        }
-
-                        if( ERROR != iStatus )
-                        {
-                            INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
-
-                            /* Raise event using the index as the method to track the event */
-                            EVLSignal xNewSignal = { pxThis->ucMyId,
-                                                    AMI_PROXY_DRIVER_E_PDI_DOWNLOAD_START,
-                                                    ucIndex,
-                                                    0 };
-                            iStatus = iEVL_RaiseEvent( pxThis->pxEvlRecord, &xNewSignal );
-                            if( ERROR == iStatus )
-                            {
-                                PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n",
-                                         AMI_PROXY_DRIVER_E_PDI_DOWNLOAD_START );
-                                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RAISE_EVENT_PDI_DOWNLOAD_FAILED )
-                            }
-                        }
-                    }
-                    else
-                    {
-                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
-                    }
-                    break;
-
-                case AMI_CMD_OPCODE_PDI_COPY_REQ:
-                    if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
-                                                              OSAL_TIMEOUT_WAIT_FOREVER ) )
-                    {
-                        INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
-
-                        iStatus = iFindNextFreeRxDataIndex( &ucIndex );
-                        if( ERROR != iStatus )
-                        {
-                            pxThis->xRxData[ ucIndex ].usCid = xCmdRequest.xHdr.usCid;
-                            pxThis->xRxData[ ucIndex ].xOpCode = xCmdRequest.xHdr.ulOpCode;
-                            pxThis->xRxData[ ucIndex ].xCopyRequest.ullAddress =
-                                                                xCmdRequest.xPdiCopyPayload.ullAddress;
-                            pxThis->xRxData[ ucIndex ].xCopyRequest.ulMaxLength =
-                                                                xCmdRequest.xPdiCopyPayload.ulSize;
-                            pxThis->xRxData[ ucIndex ].xCopyRequest.ulSrcDevice =
-                                                                xCmdRequest.xPdiCopyPayload.ulSrcDevice;
-                            pxThis->xRxData[ ucIndex ].xCopyRequest.ulSrcPartition =
-                                                                xCmdRequest.xPdiCopyPayload.ulSrcPartition;
-                            pxThis->xRxData[ ucIndex ].xCopyRequest.ulDestDevice =
-                                                                xCmdRequest.xPdiCopyPayload.ulDestDevice;
-                            pxThis->xRxData[ ucIndex ].xCopyRequest.ulDestPartition =
-                                                                xCmdRequest.xPdiCopyPayload.ulDestPartition;
-                            pxThis->xRxData[ ucIndex ].ucInUse = TRUE;
-                        }
-                        else
-                        {
-                            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
-                        }
-
-                        if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
-                        {
-                            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
-                        }
-
-                        if( ERROR != iStatus )
-                        {
-                            INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
-
-                            /* Raise event using the index as the method to track the event */
-                            EVLSignal xNewSignal = { pxThis->ucMyId,
-                                                    AMI_PROXY_DRIVER_E_PDI_COPY_START,
-                                                    ucIndex,
-                                                    0 };
-                            iStatus = iEVL_RaiseEvent( pxThis->pxEvlRecord, &xNewSignal );
-                            if( ERROR == iStatus )
-                            {
-                                PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n",
-                                         AMI_PROXY_DRIVER_E_PDI_COPY_START );
-                                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RAISE_EVENT_PDI_COPY_FAILED )
-                            }
-                        }
-                    }
-                    else
-                    {
-                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
-                    }
-                    break;
-
-                case AMI_CMD_OPCODE_PDI_PROGRAM_REQ:
-                    if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
-                                                              OSAL_TIMEOUT_WAIT_FOREVER ) )
-                    {
-                        INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
-
-                        iStatus = iFindNextFreeRxDataIndex( &ucIndex );
-                        if( ERROR != iStatus )
-                        {
-                            pxThis->xRxData[ ucIndex ].usCid = xCmdRequest.xHdr.usCid;
-                            pxThis->xRxData[ ucIndex ].xOpCode = xCmdRequest.xHdr.ulOpCode;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.iBootDevice =
-                                xCmdRequest.xPdiDownloadPayload.ulBootDevice;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.ullAddress =
-                                xCmdRequest.xPdiDownloadPayload.ullAddress;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.ulLength =
-                                xCmdRequest.xPdiDownloadPayload.ulSize;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.ulPartitionSel =
-                                xCmdRequest.xPdiDownloadPayload.ulPartitionSel;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.usPacketNum =
-                                xCmdRequest.xPdiDownloadPayload.usPacketNum;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.ulPacketSize =
-                                xCmdRequest.xPdiDownloadPayload.ulPacketSize;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.iUpdateFpt =
-                                xCmdRequest.xPdiDownloadPayload.ulUpdateFpt;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.iPdiProgram =
-                                xCmdRequest.xPdiDownloadPayload.ulPdiProgram;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.iApuPdiProgram =
-                                xCmdRequest.xPdiDownloadPayload.ulApuPdiProgram;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.iRpuPdiProgram =
-                                xCmdRequest.xPdiDownloadPayload.ulRpuPdiProgram;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.iLastPacket =
-                                xCmdRequest.xPdiDownloadPayload.usLastPacket;
-                            pvOSAL_MemCpy( pxThis->xRxData[ ucIndex ].xDownloadRequest.pucPdiMd5,
-                                           xCmdRequest.xPdiDownloadPayload.pucPdiMd5,
-                                           sizeof( pxThis->xRxData[ ucIndex ].xDownloadRequest.pucPdiMd5 ) );
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.ulPdiSize =
-                                xCmdRequest.xPdiDownloadPayload.ulPdiSize;
-                            pxThis->xRxData[ ucIndex ].ucInUse = TRUE;
-                        }
-                        else
-                        {
-                            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
-                        }
-
-                        if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
-                        {
-                            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
-                        }
-
-                        if( ERROR != iStatus )
-                        {
-                            INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
-
-                            /* Raise event using the index as the method to track the event */
-                            EVLSignal xNewSignal = { pxThis->ucMyId,
-                                                    AMI_PROXY_DRIVER_E_PDI_DOWNLOAD_START,
-                                                    ucIndex,
-                                                    0 };
-                            iStatus = iEVL_RaiseEvent( pxThis->pxEvlRecord, &xNewSignal );
-                            if( ERROR == iStatus )
-                            {
-                                PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n",
-                                         AMI_PROXY_DRIVER_E_PDI_PROGRAM_START );
-                                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RAISE_EVENT_PDI_DOWNLOAD_FAILED )
-                            }
-                        }
-                    }
-                    else
-                    {
-                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
-                    }
-                    break;
-
-                case AMI_CMD_OPCODE_SENSOR_REQ:
-                    if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
-                                                              OSAL_TIMEOUT_WAIT_FOREVER ) )
-                    {
-                        INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
-
-                        iStatus = iFindNextFreeRxDataIndex( &ucIndex );
-                        if( ERROR != iStatus )
-                        {
-                            pxThis->xRxData[ ucIndex ].usCid = xCmdRequest.xHdr.usCid;
-                            pxThis->xRxData[ ucIndex ].xOpCode = xCmdRequest.xHdr.ulOpCode;
-                            pxThis->xRxData[ ucIndex ].xSensorRequest.ullAddress =
-                                                            xCmdRequest.xSensorPayload.ullAddress;
-                            pxThis->xRxData[ ucIndex ].xSensorRequest.ulLength =
-                                                            xCmdRequest.xSensorPayload.ulSize;
-                            pxThis->xRxData[ ucIndex ].xSensorRequest.ulSensorId =
-                                                            xCmdRequest.xSensorPayload.ulSensorId;
-                            pxThis->xRxData[ ucIndex ].xSensorRequest.xRepo =
-                                                            xCmdRequest.xSensorPayload.ulSID;
-                            pxThis->xRxData[ ucIndex ].xSensorRequest.xRequest =
-                                                            xCmdRequest.xSensorPayload.ulAID;
-                            pxThis->xRxData[ ucIndex ].ucInUse = TRUE;
-                        }
-                        else
-                        {
-                            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
-                        }
-
-                        if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
-                        {
-                            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
-                        }
-
-                        if( ERROR != iStatus )
-                        {
-                            INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
-
-                            /* Raise event using the index as the method to track the event */
-                            EVLSignal xNewSignal = { pxThis->ucMyId,
-                                                    AMI_PROXY_DRIVER_E_SENSOR_READ, ucIndex, 0 };
-                            iStatus = iEVL_RaiseEvent( pxThis->pxEvlRecord, &xNewSignal );
-                            if( ERROR == iStatus )
-                            {
-                                PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n",
-                                         AMI_PROXY_DRIVER_E_SENSOR_READ );
-                                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RAISE_EVENT_SENSOR_READ_FAILED )
-                            }
-                        }
-                    }
-                    else
-                    {
-                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
-                    }
-                    break;
-
-                case AMI_CMD_OPCODE_IDENTIFY_REQ:
-                    if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
-                                                              OSAL_TIMEOUT_WAIT_FOREVER ) )
-                    {
-                        INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
-
-                        iStatus = iFindNextFreeRxDataIndex( &ucIndex );
-                        if( ERROR != iStatus )
-                        {
-                            pxThis->xRxData[ ucIndex ].usCid = xCmdRequest.xHdr.usCid;
-                            pxThis->xRxData[ ucIndex ].xOpCode = xCmdRequest.xHdr.ulOpCode;
-                            pxThis->xRxData[ ucIndex ].ucInUse = TRUE;
-                        }
-                        else
-                        {
-                            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
-                        }
-
-                        if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
-                        {
-                            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
-                        }
-
-                        if( ERROR != iStatus )
-                        {
-                            INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
-
-                            /* Raise event using the index as the method to track the event */
-                            EVLSignal xNewSignal = { pxThis->ucMyId,
-                                                     AMI_PROXY_DRIVER_E_GET_IDENTITY,
-                                                     ucIndex,
-                                                     0 };
-                            iStatus = iEVL_RaiseEvent( pxThis->pxEvlRecord, &xNewSignal );
-                            if( ERROR == iStatus )
-                            {
-                                PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n",
-                                         AMI_PROXY_DRIVER_E_GET_IDENTITY );
-                                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RAISE_EVENT_GET_IDENTIFY_FAILED )
-                            }
-                        }
-                    }
-                    else
-                    {
-                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
-                    }
-                    break;
-
-                case AMI_CMD_OPCODE_BOOT_SEL_REQ:
-                    if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
-                                                              OSAL_TIMEOUT_WAIT_FOREVER ) )
-                    {
-                        INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
-
-                        iStatus = iFindNextFreeRxDataIndex( &ucIndex );
-                        if( ERROR != iStatus )
-                        {
-                            pxThis->xRxData[ ucIndex ].usCid = xCmdRequest.xHdr.usCid;
-                            pxThis->xRxData[ ucIndex ].xOpCode = xCmdRequest.xHdr.ulOpCode;
-                            pxThis->xRxData[ ucIndex ].xBootSelectRequest.ulPartitionSel =
-                                                    xCmdRequest.xBootSelectPayload.ulPartitionSel;
-                            pxThis->xRxData[ ucIndex ].ucInUse = TRUE;
-                        }
-                        else
-                        {
-                            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
-                        }
-
-                        if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
-                        {
-                            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
-                        }
+                ulRequests++;
+                ulCmdRequestSize = sizeof( AMI_CMD_REQUEST );
 
-                        if( ERROR != iStatus )
-                        {
-                            INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
-
-                            /* Raise event using the index as the method to track the event */
-                            EVLSignal xNewSignal = { pxThis->ucMyId,
-                                                     AMI_PROXY_DRIVER_E_BOOT_SELECT,
-                                                     ucIndex,
-                                                     0 };
-                            iStatus = iEVL_RaiseEvent( pxThis->pxEvlRecord, &xNewSignal );
-                            if( ERROR == iStatus )
-                            {
-                                PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n",
-                                         AMI_PROXY_DRIVER_E_BOOT_SELECT );
-                                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RAISE_EVENT_BOOT_SELECT_FAILED )
-                            }
-                        }
-                    }
-                    else
-                    {
-                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
-                    }
-                    break;
-
-                case AMI_CMD_OPCODE_HEARTBEAT_REQ:
-                    iStatus = iHandleHeartbeatRequest( &xCmdRequest );
-                    if( ERROR == iStatus )
-                    {
-                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_GET_HEARTBEAT_REQUEST )
-                    }
-                    break;
-
-                case AMI_CMD_OPCODE_EEPROM_RW_REQ:
-                    iStatus = iHandleEepromRequest( &xCmdRequest );
-                    if( ERROR == iStatus )
-                    {
-                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_GET_EEPROM_RW_REQUEST )
-                    }
-                    break;
-
-                case AMI_CMD_OPCODE_MODULE_RW_REQ:
-                    iStatus = iHandleModuleRequest( &xCmdRequest );
-                    if( ERROR == iStatus )
-                    {
-                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_GET_MODULE_RW_REQUEST )
-                    }
-                    break;
-
-                case AMI_CMD_OPCODE_DEBUG_VERBOSITY_REQ:
-                    iStatus = iHandleDebugVerbosityRequest( &xCmdRequest );
-                    if( ERROR == iStatus )
-                    {
-                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_GET_DEBUG_VERBOSITY_REQUEST )
-                    }
-                    break;
-
-                case AMI_CMD_OPCODE_FPT_FLAGS_REQ:
-                    iStatus = iHandleFptFlagsRequest( &xCmdRequest );
-                    if( ERROR == iStatus )
+                /* Reject malformed requests here, the rest store their data and raise an event */
+                if( OK != iValidateRequest( &xCmdRequest, &pxDesc ) )
+                {
+                    vRejectRequest( &xCmdRequest, AMI_PROXY_RESULT_INVALID_VALUE );
+                }
+                else if( OK != pxDesc->pxHandler( &xCmdRequest ) )
+                {
+                    /* Handlers that raise their own events count their own errors */
+                    if( AMI_PROXY_ERRORS_MAX != pxDesc->ulHandlerError )
                     {
-                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_SET_FPT_FLAGS_REQUEST )
+                        INC_ERROR_COUNTER_WITH_STATE( pxDesc->ulHandlerError )
                     }
-                    break;
-
-                default:
-                    PLL_ERR( AMI_NAME, "Error unsupported opcode received 0x%x\r\n", xCmdRequest.xHdr.ulOpCode );
-                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_UNSUPPORTED_OPCODE_RX )
-                    break;
+                }
             }
         }
 
-        /* Check for new MBox data (tx path) */
-        if( OSAL_ERRORS_NONE == iOSAL_MBox_Pend( pxThis->pvOsalMBoxHdl,
-                                                 ( void* )&xMBoxData,
-                                                 OSAL_TIMEOUT_NO_WAIT ) )
+        if( ulRequests > pxThis->pulStatCounters[ AMI_PROXY_STATS_MAX_REQUESTS_PER_WAKEUP ] )
+        {
+            SET_STAT_COUNTER( AMI_PROXY_STATS_MAX_REQUESTS_PER_WAKEUP, ulRequests )
+        }
+
+        /* Drain all new MBox data (tx path) */
+        while( OSAL_ERRORS_NONE == iOSAL_MBox_Pend( pxThis->pvOsalMBoxHdl,
+                                                    ( void* )&xMBoxData,
+                                                    OSAL_TIMEOUT_NO_WAIT ) )
         {
             AMIProxyCmdResp xCmdResponse = { { { { { { 0 } } } } } };
             uint32_t xCmdResponseSize = sizeof( AMIProxyCmdResp );
@@ -2275,6 +2661,16 @@ static void vProxyDriverTask( void *pvArgs )
                     xCmdResponse.ulPayload[ 0 ] = xMBoxData.ulFptFlags;
                     break;
 
+                case AMI_MSG_TYPE_PARTITION_DIGEST_COMPLETE:
+                    /* Digest is returned in shared memory */
+                    INC_STAT_COUNTER( AMI_PROXY_STATS_PARTITION_DIGEST_MBOX_PEND )
+                    break;
+
+                case AMI_MSG_TYPE_SVC_STATS_COMPLETE:
+                    /* Stats are returned inline */
+                    INC_STAT_COUNTER( AMI_PROXY_STATS_SVC_STATS_MBOX_PEND )
+                    break;
+
                 default:
                     PLL_ERR( AMI_NAME, "Error unknown mailbox message type 0x%x\r\n", xMBoxData.eMsgType );
                     INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_UNKNOWN_MAILBOX_MSG )
@@ -2282,74 +2678,695 @@ static void vProxyDriverTask( void *pvArgs )
                     break;
             }
 
-            if( TRUE == ulValidMsg )
+            if( ( TRUE == ulValidMsg ) && AMI_CHECK_VALID_INDEX( ucIndex ) )
             {
-                xCmdResponse.xHdr.usCid = pxThis->xRxData[ ucIndex ].usCid;
+                AMIProxyChannel *pxChannel = &pxThis->pxChannel[ pxThis->pxRxData[ ucIndex ].ucChannel ];
+
+                xCmdResponse.xHdr.usCid = pxThis->pxRxData[ ucIndex ].usCid;
                 xCmdResponse.xHdr.usCState = AMI_CMD_STATE_COMPLETED;
                 xCmdResponse.ulRCode = xMBoxData.xResult;
-                int iStatus = pxThis->pxFwIf->write( pxThis->pxFwIf, ( uint64_t )pxThis->ulFwIfPort,
-                                                 ( uint8_t* )&xCmdResponse,
-                                                  xCmdResponseSize,
-                                                  FW_IF_TIMEOUT_NO_WAIT );
-                if( FW_IF_ERRORS_NONE == iStatus )
+
+                /* Let the host split its latency into transport and firmware time */
+                uint32_t ulServiceMs = UTIL_ELAPSED_TIME_MS( pxThis->pxRxData[ ucIndex ].ulRxTimeMs )
+                vRecordServiceTime( pxThis->pxRxData[ ucIndex ].xOpCode, ulServiceMs );
+                if( AMI_CMD_OPCODE_IDENTIFY_REQ != pxThis->pxRxData[ ucIndex ].xOpCode )
                 {
-                    if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
-                                                              OSAL_TIMEOUT_WAIT_FOREVER ) )
-                    {
-                        INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
+                    xCmdResponse.ulPayload[ 1 ] = AMI_RESPONSE_SVC_TIME_VALID |
+                                                  ( ulServiceMs & AMI_RESPONSE_SVC_TIME_MASK );
+                }
 
-                        pxThis->xRxData[ ucIndex ].ucInUse = FALSE;
-                        if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
-                        {
-                            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
-                        }
-                        else
+                int iStatus = FW_IF_ERRORS_NONE;
+                /* The ring copies whole words, pad the inline data up to the next one */
+                uint16_t usInlineLen = ( pxThis->pxRxData[ ucIndex ].usInlineLen + 3 ) & ~3;
+
+                if( 0 != usInlineLen )
+                {
+                    /* Data follows the response in the CQ entry extension negotiated by the host */
+                    xCmdResponse.xHdr.usSpecific = 1;
+                    pvOSAL_MemCpy( pxThis->pulInlineResp, &xCmdResponse, xCmdResponseSize );
+                    pvOSAL_MemCpy( ( uint8_t* )pxThis->pulInlineResp + xCmdResponseSize,
+                                   pxThis->pxRxData[ ucIndex ].pucInline,
+                                   usInlineLen );
+                    iStatus = pxChannel->pxFwIf->write( pxChannel->pxFwIf, ( uint64_t )pxChannel->ulFwIfPort,
+                                                        ( uint8_t* )pxThis->pulInlineResp,
+                                                        xCmdResponseSize + usInlineLen,
+                                                        FW_IF_TIMEOUT_NO_WAIT );
+                    if( FW_IF_ERRORS_NONE == iStatus )
+                    {
+                        INC_STAT_COUNTER( AMI_PROXY_STATS_INLINE_RESPONSE )
+                    }
+                    else
+                    {
+                        /*
+                         * Let the host see a plain response rather than no response. The
+                         * data only existed inline, so it must not be reported as success
+                         * or the host would fall back to stale data in shared memory.
+                         */
+                        PLL_ERR( AMI_NAME, "Error FW_IF inline write failed 0x%x\r\n", iStatus );
+                        INC_ERROR_COUNTER( AMI_PROXY_ERRORS_INLINE_RESPONSE )
+                        xCmdResponse.xHdr.usSpecific = 0;
+                        if( AMI_PROXY_RESULT_SUCCESS == xCmdResponse.ulRCode )
                         {
-                            INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
+                            xCmdResponse.ulRCode = AMI_PROXY_RESULT_FAILURE;
                         }
+                        usInlineLen = 0;
+                    }
+                }
+
+                if( 0 == usInlineLen )
+                {
+                    iStatus = pxChannel->pxFwIf->write( pxChannel->pxFwIf, ( uint64_t )pxChannel->ulFwIfPort,
+                                                        ( uint8_t* )&xCmdResponse,
+                                                        xCmdResponseSize,
+                                                        FW_IF_TIMEOUT_NO_WAIT );
+                }
+                if( FW_IF_ERRORS_NONE != iStatus )
+                {
+                    PLL_ERR( AMI_NAME, "Error FW_IF write failed 0x%x\r\n", iStatus );
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_FW_IF_WRITE_FAILED )
+                }
+
+                /* The request is complete either way, a failed write must not leak its slot */
+                if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
+                                                          OSAL_TIMEOUT_WAIT_FOREVER ) )
+                {
+                    INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
+
+                    if( OK != iFreeRxDataIndex( ucIndex ) )
+                    {
+                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_FREE_FAILED )
+                    }
+
+                    if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+                    {
+                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
                     }
                     else
                     {
-                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
+                        INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
                     }
                 }
                 else
                 {
-                    PLL_ERR( AMI_NAME, "Error FW_IF write failed 0x%x\r\n", iStatus );
-                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_FW_IF_WRITE_FAILED )
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
+                }
+            }
+        }
+        pxThis->pulStatCounters[ AMI_PROXY_STATS_TASK_TIME_MS ] = UTIL_ELAPSED_TIME_MS( ulStartMs )
+    }
+}
+
+/**
+ * @brief   Worker task, raises the events for heavy (flash) requests so the
+ *          callbacks for them never hold up the fast path
+ */
+static void vProxyWorkerTask( void *pvArgs )
+{
+    EVLSignal xSignal = { 0 };
+
+    for( ;; )
+    {
+        if( OSAL_ERRORS_NONE == iOSAL_MBox_Pend( pxThis->pvOsalWorkerMBoxHdl,
+                                                 ( void* )&xSignal,
+                                                 OSAL_TIMEOUT_WAIT_FOREVER ) )
+        {
+            INC_STAT_COUNTER( AMI_PROXY_STATS_WORKER_MBOX_PEND )
+
+            if( ERROR == iEVL_RaiseEvent( pxThis->pxWorkerEvlRecord, &xSignal ) )
+            {
+                PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n", xSignal.ucEventType );
+
+                if( AMI_PROXY_DRIVER_E_PDI_COPY_START == xSignal.ucEventType )
+                {
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RAISE_EVENT_PDI_COPY_FAILED )
                 }
+                else
+                {
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RAISE_EVENT_PDI_DOWNLOAD_FAILED )
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief   Take a data index from the free list, should be called within mutex to protect data
+ */
+static int iAllocRxDataIndex( uint8_t *pucIndex, int iHeavy )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( TRUE == pxThis->iInitialised ) &&
+        ( NULL != pucIndex ) )
+    {
+        if( ( TRUE == iHeavy ) &&
+            ( AMI_RXDATA_HEAVY_MAX( pxThis->ucRxDataSize ) <= pxThis->ucHeavyInUse ) )
+        {
+            INC_ERROR_COUNTER( AMI_PROXY_RX_DATA_HEAVY_LIMIT_REACHED )
+        }
+        else if( 0 < pxThis->ucRxFreeCount )
+        {
+            uint8_t ucInUse = 0;
+
+            *pucIndex = pxThis->pucRxFreeList[ --pxThis->ucRxFreeCount ];
+            pxThis->pxRxData[ *pucIndex ].ucHeavy = ( uint8_t )iHeavy;
+            pxThis->pxRxData[ *pucIndex ].ulRxTimeMs = ulOSAL_GetUptimeMs();
+            pxThis->pxRxData[ *pucIndex ].usInlineMax = 0;
+            pxThis->pxRxData[ *pucIndex ].usInlineLen = 0;
+            pxThis->pxRxData[ *pucIndex ].ucChannel = pxThis->ucRxChannel;
+            if( TRUE == iHeavy )
+            {
+                pxThis->ucHeavyInUse++;
+            }
+
+            ucInUse = pxThis->ucRxDataSize - pxThis->ucRxFreeCount;
+            if( ucInUse > pxThis->pulStatCounters[ AMI_PROXY_STATS_MAX_RX_DATA_IN_USE ] )
+            {
+                SET_STAT_COUNTER( AMI_PROXY_STATS_MAX_RX_DATA_IN_USE, ucInUse )
+            }
+            iStatus = OK;
+        }
+    }
+    else
+    {
+        INC_ERROR_COUNTER( AMI_PROXY_VALIDATION_FAILED )
+    }
+    return iStatus;
+}
+
+/**
+ * @brief   Return a data index to the free list, should be called within mutex to protect data
+ */
+static int iFreeRxDataIndex( uint8_t ucIndex )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( TRUE == pxThis->iInitialised ) &&
+        AMI_CHECK_VALID_INDEX( ucIndex ) )
+    {
+        /* Guard against a double free corrupting the free list */
+        if( ( TRUE == pxThis->pxRxData[ ucIndex ].ucInUse ) &&
+            ( pxThis->ucRxDataSize > pxThis->ucRxFreeCount ) )
+        {
+            if( ( TRUE == pxThis->pxRxData[ ucIndex ].ucHeavy ) && ( 0 < pxThis->ucHeavyInUse ) )
+            {
+                pxThis->ucHeavyInUse--;
+            }
+            pxThis->pxRxData[ ucIndex ].ucInUse = FALSE;
+            pxThis->pxRxData[ ucIndex ].ucHeavy = FALSE;
+            pxThis->pucRxFreeList[ pxThis->ucRxFreeCount++ ] = ucIndex;
+            iStatus = OK;
+        }
+    }
+    else
+    {
+        INC_ERROR_COUNTER( AMI_PROXY_VALIDATION_FAILED )
+    }
+    return iStatus;
+}
+
+/**
+ * @brief   Pass a heavy request event to the worker task
+ */
+static int iPostWorkerSignal( EVLSignal *pxSignal )
+{
+    int iStatus = ERROR;
+
+    if( NULL != pxSignal )
+    {
+        if( OSAL_ERRORS_NONE == iOSAL_MBox_Post( pxThis->pvOsalWorkerMBoxHdl,
+                                                 ( void* )pxSignal,
+                                                 OSAL_TIMEOUT_NO_WAIT ) )
+        {
+            INC_STAT_COUNTER( AMI_PROXY_STATS_WORKER_MBOX_POST )
+            iStatus = OK;
+        }
+        else
+        {
+            PLL_ERR( AMI_NAME, "Error passing event 0x%x to the worker\r\n", pxSignal->ucEventType );
+            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_WORKER_POST_FAILED )
+        }
+    }
+
+    return iStatus;
+}
+
+/**
+ * @brief   Post a message to the mailbox and wake the task to send it
+ */
+static int iPostMBoxMsg( AMIProxyMboxMsg *pxMsg )
+{
+    int iStatus = ERROR;
+
+    if( NULL != pxMsg )
+    {
+        if( OSAL_ERRORS_NONE == iOSAL_MBox_Post( pxThis->pvOsalMBoxHdl,
+                                                 ( void* )pxMsg,
+                                                 OSAL_TIMEOUT_NO_WAIT ) )
+        {
+            /* Binary semaphore, a post while the task is already awake is not an error */
+            ( void )iOSAL_Semaphore_Post( pxThis->pvOsalWakeSemHdl );
+            iStatus = OK;
+        }
+    }
+
+    return iStatus;
+}
+
+/**
+ * @brief   Handle the pdi download request
+ */
+static int iHandlePdiDownloadRequest( AMI_CMD_REQUEST *pxCmdRequest )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( NULL != pxCmdRequest ) &&
+        ( TRUE == pxThis->iInitialised ) )
+    {
+        uint8_t ucIndex = 0;
+
+        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
+                                                  OSAL_TIMEOUT_WAIT_FOREVER ) )
+        {
+            INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
+
+            iStatus = iAllocRxDataIndex( &ucIndex, TRUE );
+            if( ERROR != iStatus )
+            {
+                pxThis->pxRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
+                pxThis->pxRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.iBootDevice =
+                    pxCmdRequest->xPdiDownloadPayload.ulBootDevice;
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.ullAddress =
+                    pxCmdRequest->xPdiDownloadPayload.ullAddress;
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.ulLength =
+                    pxCmdRequest->xPdiDownloadPayload.ulSize;
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.ulPartitionSel =
+                    pxCmdRequest->xPdiDownloadPayload.ulPartitionSel;
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.usPacketNum =
+                    pxCmdRequest->xPdiDownloadPayload.usPacketNum;
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.ulPacketSize =
+                    pxCmdRequest->xPdiDownloadPayload.ulPacketSize;
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.iUpdateFpt =
+                    pxCmdRequest->xPdiDownloadPayload.ulUpdateFpt;
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.iPdiProgram =
+                    pxCmdRequest->xPdiDownloadPayload.ulPdiProgram;
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.iApuPdiProgram =
+                    pxCmdRequest->xPdiDownloadPayload.ulApuPdiProgram;
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.iRpuPdiProgram =
+                    pxCmdRequest->xPdiDownloadPayload.ulRpuPdiProgram;
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.iLastPacket =
+                    pxCmdRequest->xPdiDownloadPayload.usLastPacket;
+                pvOSAL_MemCpy( pxThis->pxRxData[ ucIndex ].xDownloadRequest.pucPdiMd5,
+                               pxCmdRequest->xPdiDownloadPayload.pucPdiMd5,
+                               sizeof( pxThis->pxRxData[ ucIndex ].xDownloadRequest.pucPdiMd5 ) );
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.ulPdiSize =
+                    pxCmdRequest->xPdiDownloadPayload.ulPdiSize;
+                pxThis->pxRxData[ ucIndex ].ucInUse = TRUE;
+            }
+            else
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
+            }
+
+            if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
+            }
+
+            if( ERROR != iStatus )
+            {
+                INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
+
+                /* Raise event from the worker, using the index as the method to track the event */
+                EVLSignal xNewSignal = { pxThis->ucMyId,
+                                        AMI_PROXY_DRIVER_E_PDI_DOWNLOAD_START,
+                                        ucIndex,
+                                        0 };
+                iStatus = iPostWorkerSignal( &xNewSignal );
+            }
+        }
+        else
+        {
+            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
+        }
+    }
+    return iStatus;
+}
+
+/**
+ * @brief   Handle the pdi copy request
+ */
+static int iHandlePdiCopyRequest( AMI_CMD_REQUEST *pxCmdRequest )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( NULL != pxCmdRequest ) &&
+        ( TRUE == pxThis->iInitialised ) )
+    {
+        uint8_t ucIndex = 0;
+
+        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
+                                                  OSAL_TIMEOUT_WAIT_FOREVER ) )
+        {
+            INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
+
+            iStatus = iAllocRxDataIndex( &ucIndex, TRUE );
+            if( ERROR != iStatus )
+            {
+                pxThis->pxRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
+                pxThis->pxRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
+                pxThis->pxRxData[ ucIndex ].xCopyRequest.ullAddress =
+                                                    pxCmdRequest->xPdiCopyPayload.ullAddress;
+                pxThis->pxRxData[ ucIndex ].xCopyRequest.ulMaxLength =
+                                                    pxCmdRequest->xPdiCopyPayload.ulSize;
+                pxThis->pxRxData[ ucIndex ].xCopyRequest.ulSrcDevice =
+                                                    pxCmdRequest->xPdiCopyPayload.ulSrcDevice;
+                pxThis->pxRxData[ ucIndex ].xCopyRequest.ulSrcPartition =
+                                                    pxCmdRequest->xPdiCopyPayload.ulSrcPartition;
+                pxThis->pxRxData[ ucIndex ].xCopyRequest.ulDestDevice =
+                                                    pxCmdRequest->xPdiCopyPayload.ulDestDevice;
+                pxThis->pxRxData[ ucIndex ].xCopyRequest.ulDestPartition =
+                                                    pxCmdRequest->xPdiCopyPayload.ulDestPartition;
+                pxThis->pxRxData[ ucIndex ].ucInUse = TRUE;
+            }
+            else
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
+            }
+
+            if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
+            }
+
+            if( ERROR != iStatus )
+            {
+                INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
+
+                /* Raise event from the worker, using the index as the method to track the event */
+                EVLSignal xNewSignal = { pxThis->ucMyId,
+                                        AMI_PROXY_DRIVER_E_PDI_COPY_START,
+                                        ucIndex,
+                                        0 };
+                iStatus = iPostWorkerSignal( &xNewSignal );
+            }
+        }
+        else
+        {
+            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
+        }
+    }
+    return iStatus;
+}
+
+/**
+ * @brief   Handle the pdi program request
+ */
+static int iHandlePdiProgramRequest( AMI_CMD_REQUEST *pxCmdRequest )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( NULL != pxCmdRequest ) &&
+        ( TRUE == pxThis->iInitialised ) )
+    {
+        uint8_t ucIndex = 0;
+
+        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
+                                                  OSAL_TIMEOUT_WAIT_FOREVER ) )
+        {
+            INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
+
+            iStatus = iAllocRxDataIndex( &ucIndex, TRUE );
+            if( ERROR != iStatus )
+            {
+                pxThis->pxRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
+                pxThis->pxRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.iBootDevice =
+                    pxCmdRequest->xPdiDownloadPayload.ulBootDevice;
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.ullAddress =
+                    pxCmdRequest->xPdiDownloadPayload.ullAddress;
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.ulLength =
+                    pxCmdRequest->xPdiDownloadPayload.ulSize;
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.ulPartitionSel =
+                    pxCmdRequest->xPdiDownloadPayload.ulPartitionSel;
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.usPacketNum =
+                    pxCmdRequest->xPdiDownloadPayload.usPacketNum;
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.ulPacketSize =
+                    pxCmdRequest->xPdiDownloadPayload.ulPacketSize;
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.iUpdateFpt =
+                    pxCmdRequest->xPdiDownloadPayload.ulUpdateFpt;
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.iPdiProgram =
+                    pxCmdRequest->xPdiDownloadPayload.ulPdiProgram;
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.iApuPdiProgram =
+                    pxCmdRequest->xPdiDownloadPayload.ulApuPdiProgram;
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.iRpuPdiProgram =
+                    pxCmdRequest->xPdiDownloadPayload.ulRpuPdiProgram;
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.iLastPacket =
+                    pxCmdRequest->xPdiDownloadPayload.usLastPacket;
+                pvOSAL_MemCpy( pxThis->pxRxData[ ucIndex ].xDownloadRequest.pucPdiMd5,
+                               pxCmdRequest->xPdiDownloadPayload.pucPdiMd5,
+                               sizeof( pxThis->pxRxData[ ucIndex ].xDownloadRequest.pucPdiMd5 ) );
+                pxThis->pxRxData[ ucIndex ].xDownloadRequest.ulPdiSize =
+                    pxCmdRequest->xPdiDownloadPayload.ulPdiSize;
+                pxThis->pxRxData[ ucIndex ].ucInUse = TRUE;
+            }
+            else
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
+            }
+
+            if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
+            }
+
+            if( ERROR != iStatus )
+            {
+                INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
+
+                /* Raise event from the worker, using the index as the method to track the event */
+                EVLSignal xNewSignal = { pxThis->ucMyId,
+                                        AMI_PROXY_DRIVER_E_PDI_DOWNLOAD_START,
+                                        ucIndex,
+                                        0 };
+                iStatus = iPostWorkerSignal( &xNewSignal );
+            }
+        }
+        else
+        {
+            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
+        }
+    }
+    return iStatus;
+}
+
+/**
+ * @brief   Handle the sensor request
+ */
+static int iHandleSensorRequest( AMI_CMD_REQUEST *pxCmdRequest )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( NULL != pxCmdRequest ) &&
+        ( TRUE == pxThis->iInitialised ) )
+    {
+        uint8_t ucIndex = 0;
+
+        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
+                                                  OSAL_TIMEOUT_WAIT_FOREVER ) )
+        {
+            INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
+
+            iStatus = iAllocRxDataIndex( &ucIndex, FALSE );
+            if( ERROR != iStatus )
+            {
+                pxThis->pxRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
+                pxThis->pxRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
+                pxThis->pxRxData[ ucIndex ].xSensorRequest.ullAddress =
+                                                pxCmdRequest->xSensorPayload.ullAddress;
+                pxThis->pxRxData[ ucIndex ].xSensorRequest.ulLength =
+                                                pxCmdRequest->xSensorPayload.ulSize;
+                pxThis->pxRxData[ ucIndex ].xSensorRequest.ulSensorId =
+                                                pxCmdRequest->xSensorPayload.ulSensorId;
+                pxThis->pxRxData[ ucIndex ].xSensorRequest.xRepo =
+                                                pxCmdRequest->xSensorPayload.ulSID;
+                pxThis->pxRxData[ ucIndex ].xSensorRequest.xRequest =
+                                                pxCmdRequest->xSensorPayload.ulAID;
+                pxThis->pxRxData[ ucIndex ].usInlineMax =
+                    ( TRUE == pxCmdRequest->xSensorPayload.ulInlineResp ) ?
+                    ( uint16_t )MIN( pxCmdRequest->xSensorPayload.ulSize,
+                                          AMI_PROXY_RESPONSE_INLINE_SIZE ) : ( 0 );
+                pxThis->pxRxData[ ucIndex ].ucInUse = TRUE;
+            }
+            else
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
+            }
+
+            if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
+            }
+
+            if( ERROR != iStatus )
+            {
+                INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
+
+                /* Raise event using the index as the method to track the event */
+                EVLSignal xNewSignal = { pxThis->ucMyId,
+                                        AMI_PROXY_DRIVER_E_SENSOR_READ, ucIndex, 0 };
+                iStatus = iEVL_RaiseEvent( pxThis->pxEvlRecord, &xNewSignal );
+                if( ERROR == iStatus )
+                {
+                    PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n",
+                             AMI_PROXY_DRIVER_E_SENSOR_READ );
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RAISE_EVENT_SENSOR_READ_FAILED )
+                }
+            }
+        }
+        else
+        {
+            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
+        }
+    }
+    return iStatus;
+}
+
+/**
+ * @brief   Handle the identify request
+ */
+static int iHandleIdentifyRequest( AMI_CMD_REQUEST *pxCmdRequest )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( NULL != pxCmdRequest ) &&
+        ( TRUE == pxThis->iInitialised ) )
+    {
+        uint8_t ucIndex = 0;
+
+        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
+                                                  OSAL_TIMEOUT_WAIT_FOREVER ) )
+        {
+            INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
+
+            iStatus = iAllocRxDataIndex( &ucIndex, FALSE );
+            if( ERROR != iStatus )
+            {
+                pxThis->pxRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
+                pxThis->pxRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
+                pxThis->pxRxData[ ucIndex ].ucInUse = TRUE;
+            }
+            else
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
+            }
+
+            if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
+            }
+
+            if( ERROR != iStatus )
+            {
+                INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
+
+                /* Raise event using the index as the method to track the event */
+                EVLSignal xNewSignal = { pxThis->ucMyId,
+                                         AMI_PROXY_DRIVER_E_GET_IDENTITY,
+                                         ucIndex,
+                                         0 };
+                iStatus = iEVL_RaiseEvent( pxThis->pxEvlRecord, &xNewSignal );
+                if( ERROR == iStatus )
+                {
+                    PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n",
+                             AMI_PROXY_DRIVER_E_GET_IDENTITY );
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RAISE_EVENT_GET_IDENTIFY_FAILED )
+                }
+            }
+        }
+        else
+        {
+            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
+        }
+    }
+    return iStatus;
+}
+
+/**
+ * @brief   Handle the boot select request
+ */
+static int iHandleBootSelectRequest( AMI_CMD_REQUEST *pxCmdRequest )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( NULL != pxCmdRequest ) &&
+        ( TRUE == pxThis->iInitialised ) )
+    {
+        uint8_t ucIndex = 0;
+
+        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
+                                                  OSAL_TIMEOUT_WAIT_FOREVER ) )
+        {
+            INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
+
+            iStatus = iAllocRxDataIndex( &ucIndex, FALSE );
+            if( ERROR != iStatus )
+            {
+                pxThis->pxRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
+                pxThis->pxRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
+                pxThis->pxRxData[ ucIndex ].xBootSelectRequest.ulPartitionSel =
+                                        pxCmdRequest->xBootSelectPayload.ulPartitionSel;
+                pxThis->pxRxData[ ucIndex ].ucInUse = TRUE;
+            }
+            else
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
             }
-        }
-        pxThis->pulStatCounters[ AMI_PROXY_STATS_TASK_TIME_MS ] = UTIL_ELAPSED_TIME_MS( ulStartMs )
-        iOSAL_Task_SleepMs( AMI_TASK_SLEEP_MS );
-    }
-}
 
-/**
- * @brief   Find the next free rxdata instance, should be called within mutex to protect data
- */
-static int iFindNextFreeRxDataIndex( uint8_t *pucIndex )
-{
-    int iStatus = ERROR;
+            if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
+            }
 
-    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
-        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
-        ( TRUE == pxThis->iInitialised ) )
-    {
-        int i = 0;
-        for( i = 0; i < AMI_RXDATA_SIZE; i++ )
-        {
-            if( FALSE == pxThis->xRxData[ i ].ucInUse )
+            if( ERROR != iStatus )
             {
-                *pucIndex = i;
-                iStatus = OK;
-                break;
+                INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
+
+                /* Raise event using the index as the method to track the event */
+                EVLSignal xNewSignal = { pxThis->ucMyId,
+                                         AMI_PROXY_DRIVER_E_BOOT_SELECT,
+                                         ucIndex,
+                                         0 };
+                iStatus = iEVL_RaiseEvent( pxThis->pxEvlRecord, &xNewSignal );
+                if( ERROR == iStatus )
+                {
+                    PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n",
+                             AMI_PROXY_DRIVER_E_BOOT_SELECT );
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RAISE_EVENT_BOOT_SELECT_FAILED )
+                }
             }
         }
-    }
-    else
-    {
-        INC_ERROR_COUNTER( AMI_PROXY_VALIDATION_FAILED )
+        else
+        {
+            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
+        }
     }
     return iStatus;
 }
@@ -2373,12 +3390,12 @@ static int iHandleHeartbeatRequest( AMI_CMD_REQUEST *pxCmdRequest )
         {
             INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
 
-            iStatus = iFindNextFreeRxDataIndex( &ucIndex );
+            iStatus = iAllocRxDataIndex( &ucIndex, FALSE );
             if( ERROR != iStatus )
             {
-                pxThis->xRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
-                pxThis->xRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
-                pxThis->xRxData[ ucIndex ].ucInUse = TRUE;
+                pxThis->pxRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
+                pxThis->pxRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
+                pxThis->pxRxData[ ucIndex ].ucInUse = TRUE;
             }
             else
             {
@@ -2423,9 +3440,7 @@ static int iHandleHeartbeatRequest( AMI_CMD_REQUEST *pxCmdRequest )
             xMsg.xResult = AMI_PROXY_RESULT_SUCCESS;
             xHeartbeatResponse.ucHeartbeatCount = pxCmdRequest->xHeartbeatPayload.ucHeartbeatCount;
             pvOSAL_MemCpy( &xMsg.xHeartbeat, &xHeartbeatResponse, sizeof( xMsg.xHeartbeat ) );
-            if( OSAL_ERRORS_NONE == iOSAL_MBox_Post( pxThis->pvOsalMBoxHdl,
-                                                     ( void* )&xMsg,
-                                                     OSAL_TIMEOUT_NO_WAIT ) )
+            if( OK == iPostMBoxMsg( &xMsg ) )
             {
                 INC_STAT_COUNTER( AMI_PROXY_STATS_HEARTBEAT_MBOX_POST )
                 iStatus = OK;
@@ -2458,20 +3473,24 @@ static int iHandleEepromRequest( AMI_CMD_REQUEST *pxCmdRequest )
         {
             INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
 
-            iStatus = iFindNextFreeRxDataIndex( &ucIndex );
+            iStatus = iAllocRxDataIndex( &ucIndex, FALSE );
             if( ERROR != iStatus )
             {
-                pxThis->xRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
-                pxThis->xRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
-                pxThis->xRxData[ ucIndex ].xEepromReadWriteRequest.xRequest =
+                pxThis->pxRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
+                pxThis->pxRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
+                pxThis->pxRxData[ ucIndex ].xEepromReadWriteRequest.xRequest =
                     pxCmdRequest->xEepromPayload.ucReqType;
-                pxThis->xRxData[ ucIndex ].xEepromReadWriteRequest.ullAddress =
+                pxThis->pxRxData[ ucIndex ].xEepromReadWriteRequest.ullAddress =
                     pxCmdRequest->xEepromPayload.ullAddress;
-                pxThis->xRxData[ ucIndex ].xEepromReadWriteRequest.ulLength =
+                pxThis->pxRxData[ ucIndex ].xEepromReadWriteRequest.ulLength =
                     pxCmdRequest->xEepromPayload.ucLen;
-                pxThis->xRxData[ ucIndex ].xEepromReadWriteRequest.ulOffset =
+                pxThis->pxRxData[ ucIndex ].xEepromReadWriteRequest.ulOffset =
                     pxCmdRequest->xEepromPayload.ucOffset;
-                pxThis->xRxData[ ucIndex ].ucInUse = TRUE;
+                pxThis->pxRxData[ ucIndex ].usInlineMax =
+                    ( TRUE == pxCmdRequest->xEepromPayload.ucInlineResp ) ?
+                    ( uint16_t )MIN( pxCmdRequest->xEepromPayload.ucLen,
+                                          AMI_PROXY_RESPONSE_INLINE_SIZE ) : ( 0 );
+                pxThis->pxRxData[ ucIndex ].ucInUse = TRUE;
             }
             else
             {
@@ -2527,24 +3546,28 @@ static int iHandleModuleRequest( AMI_CMD_REQUEST *pxCmdRequest )
         {
             INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
 
-            iStatus = iFindNextFreeRxDataIndex( &ucIndex );
+            iStatus = iAllocRxDataIndex( &ucIndex, FALSE );
             if( ERROR != iStatus )
             {
-                pxThis->xRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
-                pxThis->xRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
-                pxThis->xRxData[ ucIndex ].xModuleReadWriteRequest.xRequest =
+                pxThis->pxRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
+                pxThis->pxRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
+                pxThis->pxRxData[ ucIndex ].xModuleReadWriteRequest.xRequest =
                     pxCmdRequest->xModulePayload.ulReqType;
-                pxThis->xRxData[ ucIndex ].xModuleReadWriteRequest.ullAddress =
+                pxThis->pxRxData[ ucIndex ].xModuleReadWriteRequest.ullAddress =
                     pxCmdRequest->xModulePayload.ullAddress;
-                pxThis->xRxData[ ucIndex ].xModuleReadWriteRequest.ucExDeviceId =
+                pxThis->pxRxData[ ucIndex ].xModuleReadWriteRequest.ucExDeviceId =
                     pxCmdRequest->xModulePayload.ucExDeviceId;
-                pxThis->xRxData[ ucIndex ].xModuleReadWriteRequest.ucPage =
+                pxThis->pxRxData[ ucIndex ].xModuleReadWriteRequest.ucPage =
                     pxCmdRequest->xModulePayload.ucPage;
-                pxThis->xRxData[ ucIndex ].xModuleReadWriteRequest.ucByteOffset =
+                pxThis->pxRxData[ ucIndex ].xModuleReadWriteRequest.ucByteOffset =
                     pxCmdRequest->xModulePayload.ucByteOffset;
-                pxThis->xRxData[ ucIndex ].xModuleReadWriteRequest.ucLength =
+                pxThis->pxRxData[ ucIndex ].xModuleReadWriteRequest.ucLength =
                     pxCmdRequest->xModulePayload.ucLen;
-                pxThis->xRxData[ ucIndex ].ucInUse = TRUE;
+                pxThis->pxRxData[ ucIndex ].usInlineMax =
+                    ( TRUE == pxCmdRequest->xModulePayload.ulInlineResp ) ?
+                    ( uint16_t )MIN( pxCmdRequest->xModulePayload.ucLen,
+                                          AMI_PROXY_RESPONSE_INLINE_SIZE ) : ( 0 );
+                pxThis->pxRxData[ ucIndex ].ucInUse = TRUE;
             }
             else
             {
@@ -2600,13 +3623,13 @@ static int iHandleDebugVerbosityRequest( AMI_CMD_REQUEST *pxCmdRequest )
         {
             INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
 
-            iStatus = iFindNextFreeRxDataIndex( &ucIndex );
+            iStatus = iAllocRxDataIndex( &ucIndex, FALSE );
             if( ERROR != iStatus )
             {
-                pxThis->xRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
-                pxThis->xRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
-                pxThis->xRxData[ ucIndex ].ucDebugVerbosityRequest = pxCmdRequest->ucDebugVerbosityPayload;
-                pxThis->xRxData[ ucIndex ].ucInUse = TRUE;
+                pxThis->pxRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
+                pxThis->pxRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
+                pxThis->pxRxData[ ucIndex ].ucDebugVerbosityRequest = pxCmdRequest->ucDebugVerbosityPayload;
+                pxThis->pxRxData[ ucIndex ].ucInUse = TRUE;
             }
             else
             {
@@ -2661,10 +3684,10 @@ static int iHandleFptFlagsRequest( AMI_CMD_REQUEST *pxCmdRequest )
         {
             INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
 
-            iStatus = iFindNextFreeRxDataIndex( &ucIndex );
+            iStatus = iAllocRxDataIndex( &ucIndex, FALSE );
             if( ERROR != iStatus )
             {
-                AMIProxyRxData *pxRxData = &pxThis->xRxData[ucIndex];
+                AMIProxyRxData *pxRxData = &pxThis->pxRxData[ucIndex];
                 pxRxData->usCid = pxCmdRequest->xHdr.usCid;
                 pxRxData->xOpCode = pxCmdRequest->xHdr.ulOpCode;
                 pxRxData->xFptFlagsRequest.xRequest = pxCmdRequest->xFptFlagsPayload.ulReqType;
@@ -2724,3 +3747,338 @@ static int iHandleFptFlagsRequest( AMI_CMD_REQUEST *pxCmdRequest )
     }
     return iStatus;
 }
+
+/**
+ * @brief   Handle the partition digest request
+ */
+static int iHandlePartitionDigestRequest( AMI_CMD_REQUEST *pxCmdRequest )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( NULL != pxCmdRequest ) &&
+        ( TRUE == pxThis->iInitialised ) )
+    {
+        uint8_t ucIndex = 0;
+
+        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
+                                                  OSAL_TIMEOUT_WAIT_FOREVER ) )
+        {
+            INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
+
+            iStatus = iAllocRxDataIndex( &ucIndex, FALSE );
+            if( ERROR != iStatus )
+            {
+                AMIProxyRxData *pxRxData = &pxThis->pxRxData[ ucIndex ];
+                pxRxData->usCid = pxCmdRequest->xHdr.usCid;
+                pxRxData->xOpCode = pxCmdRequest->xHdr.ulOpCode;
+                pxRxData->xDigestRequest.ullAddress = pxCmdRequest->xDigestPayload.ullAddress;
+                pxRxData->xDigestRequest.ulBootDevice = pxCmdRequest->xDigestPayload.ulBootDevice;
+                pxRxData->xDigestRequest.ulPartition = pxCmdRequest->xDigestPayload.ulPartition;
+                pxRxData->xDigestRequest.ulLength = pxCmdRequest->xDigestPayload.ulLength;
+                pxRxData->ucInUse = TRUE;
+            }
+            else
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
+            }
+
+            if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
+            }
+
+            if( ERROR != iStatus )
+            {
+                INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
+                EVLSignal xNewSignal = { pxThis->ucMyId,
+                                         AMI_PROXY_DRIVER_E_PARTITION_DIGEST,
+                                         ucIndex,
+                                         0 };
+                iStatus = iEVL_RaiseEvent( pxThis->pxEvlRecord, &xNewSignal );
+                if( ERROR == iStatus )
+                {
+                    PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n",
+                             AMI_PROXY_DRIVER_E_PARTITION_DIGEST );
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RAISE_EVENT_PARTITION_DIGEST_FAILED )
+                }
+            }
+        }
+        else
+        {
+            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
+        }
+    }
+    return iStatus;
+}
+
+/**
+ * @brief   Handle the service stats request
+ */
+static int iHandleSvcStatsRequest( AMI_CMD_REQUEST *pxCmdRequest )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( NULL != pxCmdRequest ) &&
+        ( TRUE == pxThis->iInitialised ) )
+    {
+        AMIProxyMboxMsg xMsg = { 0 };
+        uint8_t ucIndex = 0;
+        uint8_t ucSlot = ucOpCodeSlot( pxCmdRequest->xSvcStatsPayload.ulOpCode );
+
+        xMsg.xResult = AMI_PROXY_RESULT_INVALID_VALUE;
+
+        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
+                                                  OSAL_TIMEOUT_WAIT_FOREVER ) )
+        {
+            INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
+
+            iStatus = iAllocRxDataIndex( &ucIndex, FALSE );
+            if( ERROR != iStatus )
+            {
+                AMIProxyRxData *pxRxData = &pxThis->pxRxData[ ucIndex ];
+
+                pxRxData->usCid = pxCmdRequest->xHdr.usCid;
+                pxRxData->xOpCode = pxCmdRequest->xHdr.ulOpCode;
+                pxRxData->ucInUse = TRUE;
+
+                /* Answered here, the stats are owned by this task so no app is involved */
+                if( ( TRUE == pxCmdRequest->xSvcStatsPayload.ulInlineResp ) &&
+                    ( AMI_PROXY_SVC_TIME_OPCODES > ucSlot ) )
+                {
+                    pvOSAL_MemCpy( pxRxData->pucInline,
+                                   &pxThis->pxServiceTime[ ucSlot ],
+                                   sizeof( AMIProxyServiceTime ) );
+                    pxRxData->usInlineLen = sizeof( AMIProxyServiceTime );
+
+                    if( TRUE == pxCmdRequest->xSvcStatsPayload.ulClear )
+                    {
+                        pvOSAL_MemSet( &pxThis->pxServiceTime[ ucSlot ], 0, sizeof( AMIProxyServiceTime ) );
+                    }
+                    xMsg.xResult = AMI_PROXY_RESULT_SUCCESS;
+                }
+            }
+            else
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
+            }
+
+            if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
+            }
+            else
+            {
+                INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
+            }
+        }
+        else
+        {
+            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
+        }
+
+        if( OK == iStatus )
+        {
+            xMsg.ucRxDataIndex = ucIndex;
+            xMsg.eMsgType = AMI_MSG_TYPE_SVC_STATS_COMPLETE;
+            if( OK == iPostMBoxMsg( &xMsg ) )
+            {
+                INC_STAT_COUNTER( AMI_PROXY_STATS_SVC_STATS_MBOX_POST )
+            }
+            else
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MAILBOX_POST_FAILED )
+                iStatus = ERROR;
+            }
+        }
+    }
+    return iStatus;
+}
+
+/**
+ * @brief   Map an opcode to its slot in the opcode table and service times
+ */
+static uint8_t ucOpCodeSlot( AMI_CMD_OPCODE_REQ xOpCode )
+{
+    uint8_t ucSlot = AMI_OPCODE_SLOTS;
+
+    if( AMI_CMD_OPCODE_IDENTIFY_REQ == xOpCode )
+    {
+        ucSlot = AMI_OPCODE_SLOT_IDENTIFY;
+    }
+    else if( ( AMI_OPCODE_SLOT_IDENTIFY != xOpCode ) && ( AMI_OPCODE_SLOTS > xOpCode ) )
+    {
+        ucSlot = ( uint8_t )xOpCode;
+    }
+
+    return ucSlot;
+}
+
+/**
+ * @brief   Get the shared memory range written by a sensor request
+ */
+static void vGetSensorShmRange( AMI_CMD_REQUEST *pxCmdRequest, uint64_t *pullAddress, uint32_t *pulLength )
+{
+    *pullAddress = pxCmdRequest->xSensorPayload.ullAddress;
+    *pulLength   = pxCmdRequest->xSensorPayload.ulSize;
+}
+
+/**
+ * @brief   Get the shared memory range read by a pdi download or program request
+ */
+static void vGetPdiShmRange( AMI_CMD_REQUEST *pxCmdRequest, uint64_t *pullAddress, uint32_t *pulLength )
+{
+    *pullAddress = pxCmdRequest->xPdiDownloadPayload.ullAddress;
+    *pulLength   = pxCmdRequest->xPdiDownloadPayload.ulSize;
+}
+
+/**
+ * @brief   Get the shared memory range used by an eeprom read/write request
+ */
+static void vGetEepromShmRange( AMI_CMD_REQUEST *pxCmdRequest, uint64_t *pullAddress, uint32_t *pulLength )
+{
+    *pullAddress = pxCmdRequest->xEepromPayload.ullAddress;
+    *pulLength   = pxCmdRequest->xEepromPayload.ucLen;
+}
+
+/**
+ * @brief   Get the shared memory range used by a module read/write request
+ */
+static void vGetModuleShmRange( AMI_CMD_REQUEST *pxCmdRequest, uint64_t *pullAddress, uint32_t *pulLength )
+{
+    *pullAddress = pxCmdRequest->xModulePayload.ullAddress;
+    *pulLength   = pxCmdRequest->xModulePayload.ucLen;
+}
+
+/**
+ * @brief   Get the shared memory range written by a partition digest request
+ */
+static void vGetDigestShmRange( AMI_CMD_REQUEST *pxCmdRequest, uint64_t *pullAddress, uint32_t *pulLength )
+{
+    *pullAddress = pxCmdRequest->xDigestPayload.ullAddress;
+    *pulLength   = MD5_SIZE;
+}
+
+/**
+ * @brief   Check a request against its opcode descriptor
+ */
+static int iValidateRequest( AMI_CMD_REQUEST *pxCmdRequest, const AMIProxyOpCodeDesc **ppxDesc )
+{
+    int iStatus = ERROR;
+
+    if( ( NULL != pxCmdRequest ) && ( NULL != ppxDesc ) )
+    {
+        const AMIProxyOpCodeDesc *pxDesc = NULL;
+        uint8_t ucSlot = ucOpCodeSlot( pxCmdRequest->xHdr.ulOpCode );
+
+        if( AMI_OPCODE_SLOTS > ucSlot )
+        {
+            pxDesc = &pxOpCodeTable[ ucSlot ];
+        }
+
+        if( ( NULL == pxDesc ) ||
+            ( NULL == pxDesc->pxHandler ) ||
+            ( pxDesc->xOpCode != pxCmdRequest->xHdr.ulOpCode ) )
+        {
+            PLL_ERR( AMI_NAME, "Error unsupported opcode received 0x%x\r\n", pxCmdRequest->xHdr.ulOpCode );
+            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_UNSUPPORTED_OPCODE_RX )
+        }
+        else if( pxDesc->usMinCount > pxCmdRequest->xHdr.ulCount )
+        {
+            PLL_ERR( AMI_NAME, "Error opcode 0x%x payload too short (%d < %d)\r\n",
+                     pxCmdRequest->xHdr.ulOpCode, pxCmdRequest->xHdr.ulCount, pxDesc->usMinCount );
+            INC_ERROR_COUNTER( AMI_PROXY_ERRORS_REQUEST_TOO_SHORT )
+        }
+        else
+        {
+            uint64_t ullAddress = 0;
+            uint32_t ulLength = 0;
+
+            if( NULL != pxDesc->pxGetShmRange )
+            {
+                pxDesc->pxGetShmRange( pxCmdRequest, &ullAddress, &ulLength );
+            }
+
+            /* Written so that neither side can wrap */
+            if( ( pxThis->ulSharedMemSize < ullAddress ) ||
+                ( ( pxThis->ulSharedMemSize - ( uint32_t )ullAddress ) < ulLength ) )
+            {
+                PLL_ERR( AMI_NAME, "Error opcode 0x%x range 0x%llx + 0x%x outside shared memory\r\n",
+                         pxCmdRequest->xHdr.ulOpCode, ullAddress, ulLength );
+                INC_ERROR_COUNTER( AMI_PROXY_ERRORS_REQUEST_OUT_OF_BOUNDS )
+            }
+            else
+            {
+                *ppxDesc = pxDesc;
+                iStatus = OK;
+            }
+        }
+    }
+
+    return iStatus;
+}
+
+/**
+ * @brief   Complete a request straight away without raising an event
+ */
+static void vRejectRequest( AMI_CMD_REQUEST *pxCmdRequest, AMI_PROXY_RESULT xResult )
+{
+    if( NULL != pxCmdRequest )
+    {
+        AMIProxyCmdResp xCmdResponse = { { { { { { 0 } } } } } };
+        AMIProxyChannel *pxChannel = &pxThis->pxChannel[ pxThis->ucRxChannel ];
+
+        /* No RxData is taken, so a flood of bad requests cannot starve valid ones */
+        xCmdResponse.xHdr.usCid = pxCmdRequest->xHdr.usCid;
+        xCmdResponse.xHdr.usCState = AMI_CMD_STATE_COMPLETED;
+        xCmdResponse.ulRCode = xResult;
+
+        if( FW_IF_ERRORS_NONE == pxChannel->pxFwIf->write( pxChannel->pxFwIf, ( uint64_t )pxChannel->ulFwIfPort,
+                                                           ( uint8_t* )&xCmdResponse,
+                                                           sizeof( AMIProxyCmdResp ),
+                                                           FW_IF_TIMEOUT_NO_WAIT ) )
+        {
+            INC_STAT_COUNTER( AMI_PROXY_STATS_REQUEST_REJECTED )
+        }
+        else
+        {
+            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_FW_IF_WRITE_FAILED )
+        }
+    }
+}
+
+/**
+ * @brief   Add a served request to its opcode's service time
+ */
+static void vRecordServiceTime( AMI_CMD_OPCODE_REQ xOpCode, uint32_t ulServiceMs )
+{
+    uint8_t ucSlot = ucOpCodeSlot( xOpCode );
+
+    /* Reading the statistics must not change them */
+    if( ( AMI_PROXY_SVC_TIME_OPCODES > ucSlot ) && ( AMI_CMD_OPCODE_SVC_STATS_REQ != xOpCode ) )
+    {
+        AMIProxyServiceTime *pxTime = &pxThis->pxServiceTime[ ucSlot ];
+        uint8_t ucBucket = 0;
+
+        /* log2 bucket, 0ms in the first and everything beyond the range in the last */
+        while( ( 0 != ( ulServiceMs >> ucBucket ) ) && ( ( AMI_PROXY_SVC_TIME_BUCKETS - 1 ) > ucBucket ) )
+        {
+            ucBucket++;
+        }
+
+        if( ( 0 == pxTime->ulCount ) || ( ulServiceMs < pxTime->ulMinMs ) )
+        {
+            pxTime->ulMinMs = ulServiceMs;
+        }
+        if( ulServiceMs > pxTime->ulMaxMs )
+        {
+            pxTime->ulMaxMs = ulServiceMs;
+        }
+        pxTime->ulCount++;
+        pxTime->ulTotalMs += ulServiceMs;
+        pxTime->pulHistogram[ ucBucket ]++;
+    }
+}
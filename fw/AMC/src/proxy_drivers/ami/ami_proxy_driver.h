@@ -21,6 +21,13 @@
 
 #define AMI_PROXY_REQUEST_SIZE              ( 512 )
 #define AMI_PROXY_RESPONSE_SIZE             ( 16 )
+#define AMI_PROXY_RESPONSE_EXT_SIZE         ( 240 )
+#define AMI_PROXY_RESPONSE_INLINE_SIZE      ( AMI_PROXY_RESPONSE_EXT_SIZE - sizeof( uint32_t ) )
+
+#define AMI_PROXY_SVC_TIME_OPCODES          ( 16 )
+#define AMI_PROXY_SVC_TIME_BUCKETS          ( 12 )
+
+#define AMI_PROXY_MAX_CHANNELS              ( 2 )
 
 
 /******************************************************************************/
@@ -44,6 +51,7 @@ typedef enum
     AMI_PROXY_DRIVER_E_MODULE_READ_WRITE,
     AMI_PROXY_DRIVER_E_DEBUG_VERBOSITY,
     AMI_PROXY_DRIVER_E_FPT_FLAGS,
+    AMI_PROXY_DRIVER_E_PARTITION_DIGEST,
 
     MAX_AMI_PROXY_DRIVER_EVENTS
 
@@ -121,6 +129,24 @@ typedef enum
 /* Structs                                                                    */
 /******************************************************************************/
 
+/**
+ * @struct  AMIProxyServiceTime
+ * @brief   Time taken to serve one opcode, from GCQ consume to response produce
+ *
+ * @note    Bucket 0 counts requests served within 1ms, bucket n those taking
+ *          [ 2^(n-1), 2^n ) ms and the last bucket everything slower.
+ *          This is also the layout returned by the service stats request.
+ */
+typedef struct
+{
+    uint32_t ulCount;
+    uint32_t ulMinMs;
+    uint32_t ulMaxMs;
+    uint32_t ulTotalMs;
+    uint32_t pulHistogram[ AMI_PROXY_SVC_TIME_BUCKETS ];
+
+} AMIProxyServiceTime;
+
 /**
  * @struct  AMIProxySensorRequest
  * @brief   Sensor request
@@ -246,6 +272,19 @@ typedef struct
 
 } AMIProxyFptFlagsRequest;
 
+/**
+ * @struct  AMIProxyPartitionDigestRequest
+ * @brief   Digest the start of a partition
+ */
+typedef struct
+{
+    uint64_t ullAddress;                /* Shared memory offset to write the digest to */
+    uint32_t ulBootDevice;              /* Primary or Secondary boot device */
+    uint32_t ulPartition;               /* Partition index */
+    uint32_t ulLength;                  /* Number of bytes to digest */
+
+} AMIProxyPartitionDigestRequest;
+
 /**
  * @struct  AMI_PROXY_IDENTITY_RESPONSE
  * @brief   Identity reponse
@@ -288,14 +327,41 @@ typedef struct
  * @param   ulFwIfPort  Port to use on the Firmware Interface
  * @param   ulTaskPrio  Priority of the Proxy driver task (if RR disabled)
  * @param   ulTaskStack Stack size of the Proxy driver task
+ * @param   ucRxDataSize Maximum number of in flight requests (at least 2)
+ * @param   ulSharedMemSize Size of the shared memory window, host buffers must lie inside it
  *
  * @return  OK          Proxy driver initialised correctly
  *          ERROR       Proxy driver not initialised, or was already initialised
  *
  * @note    Proxy drivers can have 0 or more firmware interfaces
+ *
+ * @note    PDI download, program and copy requests are handed to a worker task
+ *          (using the same priority and stack size) and may only use half of
+ *          the in flight requests, so they can never block the fast path
+ *
+ * @note    Requests with an unknown opcode, a short payload or a buffer outside
+ *          the shared memory are completed straight away with
+ *          AMI_PROXY_RESULT_INVALID_VALUE
  */
 int iAMI_Initialise( uint8_t ucProxyId, FWIfCfg *pxFwIf, uint32_t ulFwIfPort,
-                     uint32_t ulTaskPrio, uint32_t ulTaskStack );
+                     uint32_t ulTaskPrio, uint32_t ulTaskStack, uint8_t ucRxDataSize,
+                     uint32_t ulSharedMemSize );
+
+/**
+ * @brief   Add another Firmware Interface for the host to send requests on
+ *
+ * @param   pxFwIf      Handle to the Firmware Interface to use
+ * @param   ulFwIfPort  Port to use on the Firmware Interface
+ *
+ * @return  OK          Firmware Interface opened and added
+ *          ERROR       Firmware Interface not added
+ *
+ * @note    Up to AMI_PROXY_MAX_CHANNELS interfaces (including the one passed
+ *          to iAMI_Initialise) are served by the same task, added channels are
+ *          drained first and each response is written to the channel its
+ *          request arrived on
+ */
+int iAMI_AddChannel( FWIfCfg *pxFwIf, uint32_t ulFwIfPort );
 
 /**
  * @brief   Bind into this proxy driver
@@ -424,6 +490,17 @@ int iAMI_SetDebugVerbosityResponse( EVLSignal *pxSignal, AMI_PROXY_RESULT xResul
  */
 int iAMI_SetFptFlagsResponse( EVLSignal *pxSignal, AMI_PROXY_RESULT xResult, uint32_t ulFlags );
 
+/**
+ * @brief   Set the response after the partition digest has completed
+ *
+ * @param   pxSignal    Current event occurance (used for tracking)
+ * @param   xResult     The result of the partition digest request
+ *
+ * @return  OK          Data passed to proxy driver successfully
+ *          ERROR       Data not passed successfully
+ */
+int iAMI_SetPartitionDigestResponse( EVLSignal *pxSignal, AMI_PROXY_RESULT xResult );
+
 /* Get Functions **************************************************************/
 
 /**
@@ -545,6 +622,44 @@ int iAMI_GetDebugVerbosityRequest( EVLSignal *pxSignal,
 int iAMI_GetFptFlagsRequest( EVLSignal *pxSignal,
     AMIProxyFptFlagsRequest *pxFptFlagsRequest );
 
+/**
+ * @brief   Get the partition digest request
+ *
+ * @param   pxSignal                Current event occurance (used for tracking)
+ * @param   pxDigestRequest         Pointer to partition digest request structure
+ *
+ * @return  OK                      Data retrieved from proxy driver successfully
+ *          ERROR                   Data not retrieved successfully
+ */
+int iAMI_GetPartitionDigestRequest( EVLSignal *pxSignal,
+    AMIProxyPartitionDigestRequest *pxDigestRequest );
+
+/**
+ * @brief   Get the buffer to return response data inline in the completion entry
+ *
+ * @param   pxSignal                Current event occurance (used for tracking)
+ * @param   ppucData                Pointer to store the inline buffer
+ * @param   pulSize                 Pointer to store the usable size of the inline buffer
+ *
+ * @return  OK                      Host asked for the response inline
+ *          ERROR                   Response must be written to shared memory
+ *
+ * @note    Only sensor, eeprom and module requests may be answered inline. The data
+ *          must be committed with iAMI_SetInlineResponseSize before the response is set.
+ */
+int iAMI_GetInlineResponseBuffer( EVLSignal *pxSignal, uint8_t **ppucData, uint32_t *pulSize );
+
+/**
+ * @brief   Commit the data written to the inline response buffer
+ *
+ * @param   pxSignal                Current event occurance (used for tracking)
+ * @param   ulSize                  Number of bytes written to the inline buffer
+ *
+ * @return  OK                      Data will be sent with the response
+ *          ERROR                   Inline response not requested or size too large
+ */
+int iAMI_SetInlineResponseSize( EVLSignal *pxSignal, uint32_t ulSize );
+
 /**
  * @brief   Print all the stats gathered by the application
  *
@@ -553,6 +668,14 @@ int iAMI_GetFptFlagsRequest( EVLSignal *pxSignal,
  */
 int iAMI_PrintStatistics( void );
 
+/**
+ * @brief   Print the per-opcode service times and histograms
+ *
+ * @return  OK          Service times printed successfully
+ *          ERROR       Service times not printed successfully
+ */
+int iAMI_PrintServiceTimes( void );
+
 /**
  * @brief   Clear all the stats in the application
  *
@@ -53,6 +53,13 @@ static void vPrintStats( void );
  */
 static void vClearStats( void );
 
+/**
+ * @brief   Debug function to print the per-opcode service times
+ *
+ * @return  N/A
+ */
+static void vPrintServiceTimes( void );
+
 /**
  * @brief   Debug function to bind a callback to this module
  *
@@ -213,6 +220,7 @@ void vAMI_DebugInit( DAL_HDL pxParentHandle )
         {
             pxDAL_NewDebugFunction( "print_stats",    pxAmiTop, vPrintStats );
             pxDAL_NewDebugFunction( "clear_stats",    pxAmiTop, vClearStats );
+            pxDAL_NewDebugFunction( "print_service_times", pxAmiTop, vPrintServiceTimes );
             pxDAL_NewDebugFunction( "bind_callbacks", pxAmiTop, vBindCallbacks );
             pxSetDir = pxDAL_NewSubDirectory( "sets", pxAmiTop );
             pxGetDir = pxDAL_NewSubDirectory( "gets", pxAmiTop );
@@ -264,6 +272,17 @@ static void vClearStats( void )
     }
 }
 
+/**
+ * @brief   Debug function to print the per-opcode service times
+ */
+static void vPrintServiceTimes( void )
+{
+    if( OK != iAMI_PrintServiceTimes() )
+    {
+        PLL_DAL( AMI_DBG_NAME, "Error printing service times\r\n" );
+    }
+}
+
 /**
  * @brief   Debug function to bind a callback to this module
  */
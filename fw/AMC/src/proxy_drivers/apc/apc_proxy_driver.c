@@ -45,6 +45,9 @@
 
 #define APC_COPY_CHUNK_LEN      ( 0x1000 )           /* 4KB */
 
+#define APC_MD5_BLOCK_LEN       ( 64 )
+#define APC_MD5_ROTL( x, n )    ( ( ( x ) << ( n ) ) | ( ( x ) >> ( 32 - ( n ) ) ) )
+
 #ifndef APC_FPT_HDR_MAGIC_NUM
 #define APC_FPT_HDR_MAGIC_NUM   ( 0x92F7A516 )
 #endif
@@ -68,6 +71,8 @@
     DO( APC_PROXY_STATS_MBOX_UPDATE_FPT_FLAGS_PEND ) \
     DO( APC_PROXY_STATS_MBOX_LOAD_PDI_POST )         \
     DO( APC_PROXY_STATS_MBOX_LOAD_PDI_PEND )         \
+    DO( APC_PROXY_STATS_MBOX_DIGEST_POST )           \
+    DO( APC_PROXY_STATS_MBOX_DIGEST_PEND )           \
     DO( APC_PROXY_STATS_PDI_LOAD_COMPLETE )          \
     DO( APC_PROXY_STATS_TASK_CREATE )                \
     DO( APC_PROXY_STATS_FPT_CREATED )                \
@@ -78,6 +83,7 @@
     DO( APC_PROXY_STATS_FPT_FLAGS_UPDATED )          \
     DO( APC_PROXY_STATS_IMAGE_DOWNLOAD_COMPLETE )    \
     DO( APC_PROXY_STATS_IMAGE_COPY_COMPLETE )        \
+    DO( APC_PROXY_STATS_PARTITION_DIGEST_COMPLETE )  \
     DO( APC_PROXY_STATS_PARTITION_SELECTED )         \
     DO( APC_PROXY_STATS_POR_TRIGGERED )              \
     DO( APC_PROXY_STATS_TASK_TIME_MS )               \
@@ -101,6 +107,7 @@
     DO( APC_PROXY_ERRORS_MBOX_SYSTEM_POR_POST_FAILED )      \
     DO( APC_PROXY_ERRORS_MBOX_UPDATE_FPT_FLAGS_POST_FAILED ) \
     DO( APC_PROXY_ERRORS_MBOX_LOAD_PDI_POST_FAILED )         \
+    DO( APC_PROXY_ERRORS_MBOX_DIGEST_POST_FAILED )           \
     DO( APC_PROXY_ERRORS_PDI_LOAD_FAILED )                   \
     DO( APC_PROXY_ERRORS_XLOADER_INSTANCE_NULL )             \
     DO( APC_PROXY_ERRORS_MBOX_PEND_FAILED )                  \
@@ -117,6 +124,7 @@
     DO( APC_PROXY_ERRORS_PACKET_SIZE_ERROR )                 \
     DO( APC_PROXY_ERRORS_IMAGE_DOWNLOAD_FAILED )             \
     DO( APC_PROXY_ERRORS_IMAGE_COPY_FAILED )                 \
+    DO( APC_PROXY_ERRORS_PARTITION_DIGEST_FAILED )           \
     DO( APC_PROXY_ERRORS_PARTITION_SELECTION_FAILED )        \
     DO( APC_PROXY_ERRORS_POR_FAILED )                        \
     DO( APC_PROXY_ERRORS_COPY_BUFFER_CREATION_FAILED )       \
@@ -171,6 +179,7 @@ typedef enum
     APC_MSG_TYPE_PARTITION_SELECT,
     APC_MSG_TYPE_SYSTEM_POR,
     APC_MSG_TYPE_UPDATE_FPT_FLAGS,
+    APC_MSG_TYPE_DIGEST_PARTITION,
     MAX_APC_MSG_TYPE
 
 } APC_MSG_TYPES;
@@ -267,6 +276,31 @@ typedef struct
 
 } APCMboxUpdateFptFlags;
 
+/**
+ * @struct  APCMboxDigestPartition
+ * @brief   Structure to post the partition digest data in the mailbox
+ */
+typedef struct
+{
+    APC_BOOT_DEVICES xBootDevice;
+    int iPartition;
+    uint32_t ulLength;
+    uint8_t *pucDigest;
+
+} APCMboxDigestPartition;
+
+/**
+ * @struct  APCMd5Context
+ * @brief   Running state of an MD5 calculation
+ */
+typedef struct
+{
+    uint32_t pulState[ 4 ];
+    uint64_t ullLength;
+    uint8_t  pucBlock[ APC_MD5_BLOCK_LEN ];
+
+} APCMd5Context;
+
 /**
  * @struct  APCMboxMsg
  * @brief   Data posted via the APC Proxy driver mailbox
@@ -281,6 +315,7 @@ typedef struct
         APCMboxDownloadImage  xDownloadImageData;
         APCMboxCopyImage      xCopyImageData;
         APCMboxUpdateFptFlags xUpdateFptFlagsData;
+        APCMboxDigestPartition xDigestPartitionData;
         int iSelectedPartition;
 
     };
@@ -396,6 +431,56 @@ static int iWriteFptPartitionToFlash( APC_BOOT_DEVICES xBootDevice, int iPartiti
  */
 static int iVerifyDownload( APCMboxDownloadImage *pxImageData );
 
+/**
+ * @brief   Calculate the MD5 digest of the start of a partition
+ *
+ * @param   pxDigestData Pointer to data regarding the range to digest
+ *
+ * @return  OK if the digest was calculated
+ *          ERROR if the partition could not be read
+ */
+static int iDigestPartition( APCMboxDigestPartition *pxDigestData );
+
+/**
+ * @brief   Process a single MD5 block
+ *
+ * @param   pulState    MD5 state words
+ * @param   pucBlock    APC_MD5_BLOCK_LEN bytes of input
+ *
+ * @return  N/A
+ */
+static void vMd5Transform( uint32_t *pulState, const uint8_t *pucBlock );
+
+/**
+ * @brief   Reset an MD5 calculation
+ *
+ * @param   pxCtx   MD5 state
+ *
+ * @return  N/A
+ */
+static void vMd5Init( APCMd5Context *pxCtx );
+
+/**
+ * @brief   Add data to an MD5 calculation
+ *
+ * @param   pxCtx   MD5 state
+ * @param   pucData Data to add
+ * @param   ulLen   Number of bytes in pucData
+ *
+ * @return  N/A
+ */
+static void vMd5Update( APCMd5Context *pxCtx, const uint8_t *pucData, uint32_t ulLen );
+
+/**
+ * @brief   Complete an MD5 calculation
+ *
+ * @param   pxCtx       MD5 state
+ * @param   pucDigest   Buffer of MD5_SIZE bytes to store the digest in
+ *
+ * @return  N/A
+ */
+static void vMd5Final( APCMd5Context *pxCtx, uint8_t *pucDigest );
+
 /**
  * @brief   Attempt to reload all FPT data, from target boot device
  *
@@ -862,6 +947,62 @@ int iAPC_CopyImage( EVLSignal *pxSignal,
     return iStatus;
 }
 
+/**
+ * @brief   Calculate the MD5 digest of the start of a partition
+ */
+int iAPC_DigestPartition( EVLSignal *pxSignal,
+                          APC_BOOT_DEVICES xBootDevice,
+                          int iPartition,
+                          uint32_t ulLength,
+                          uint8_t *pucDigest )
+{
+    int iStatus = ERROR;
+
+    if ( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( TRUE == pxThis->iInitialised ) &&
+        ( MAX_APC_BOOT_DEVICES > xBootDevice ) &&
+        ( TRUE == pxThis->piValidFpt[ xBootDevice ] ) &&
+        ( NULL != pucDigest ) &&
+        ( NULL != pxSignal ) )
+    {
+        if ( ( 0 <= iPartition ) &&
+             ( iPartition < pxThis->pxFptHeader[ xBootDevice ].ucNumEntries ) &&
+             ( 0 < ulLength ) &&
+             ( ulLength <= pxThis->ppxFptPartitions[ xBootDevice ][ iPartition ].ulPartitionSize ) )
+        {
+            APCMboxMsg xMsg = { 0 };
+            xMsg.eMsgType                          = APC_MSG_TYPE_DIGEST_PARTITION;
+            xMsg.ucRequestId                       = pxSignal->ucInstance;
+            xMsg.xDigestPartitionData.xBootDevice  = xBootDevice;
+            xMsg.xDigestPartitionData.iPartition   = iPartition;
+            xMsg.xDigestPartitionData.ulLength     = ulLength;
+            xMsg.xDigestPartitionData.pucDigest    = pucDigest;
+
+            if ( OSAL_ERRORS_NONE == iOSAL_MBox_Post( pxThis->pvOsalMBoxHdl,
+                                                     ( void* )&xMsg,
+                                                     OSAL_TIMEOUT_NO_WAIT ) )
+            {
+                INC_STAT_COUNTER( APC_PROXY_STATS_MBOX_DIGEST_POST )
+                iStatus = OK;
+            }
+            else
+            {
+                INC_ERROR_COUNTER_WITH_STATE( APC_PROXY_ERRORS_MBOX_DIGEST_POST_FAILED )
+            }
+        }
+        else
+        {
+            INC_ERROR_COUNTER_WITH_STATE( APC_PROXY_ERRORS_INVALID_FPT_PARTITION_REQUESTED )
+        }
+    }
+    else
+    {
+        INC_ERROR_COUNTER( APC_PROXY_ERRORS_VALIDATION_FAILED )
+    }
+    return iStatus;
+}
+
 /**
  * @brief   Live-load a PDI image onto the device
  */
@@ -1640,6 +1781,46 @@ static void vProxyDriverTask( void *pArg )
                 }
                 break;
 
+            case APC_MSG_TYPE_DIGEST_PARTITION:
+                INC_STAT_COUNTER( APC_PROXY_STATS_MBOX_DIGEST_PEND )
+
+                /* Reads only, but must not overlap a write to the same flash */
+                if ( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalFlashLockHdl, OSAL_TIMEOUT_NO_WAIT ) )
+                {
+                    INC_STAT_COUNTER( APC_PROXY_STATS_MUTEX_TAKE )
+
+                    if ( OK == iDigestPartition( &xMBoxData.xDigestPartitionData ) )
+                    {
+                        INC_STAT_COUNTER( APC_PROXY_STATS_PARTITION_DIGEST_COMPLETE )
+                        xSignal.ucEventType = APC_PROXY_DRIVER_E_DIGEST_COMPLETE;
+                    }
+                    else
+                    {
+                        INC_ERROR_COUNTER_WITH_STATE( APC_PROXY_ERRORS_PARTITION_DIGEST_FAILED )
+                        xSignal.ucEventType = APC_PROXY_DRIVER_E_DIGEST_FAILED;
+                    }
+
+                    if ( OSAL_ERRORS_NONE == iOSAL_Mutex_Release( pxThis->pvOsalFlashLockHdl ) )
+                    {
+                        INC_STAT_COUNTER( APC_PROXY_STATS_MUTEX_RELEASE )
+                    }
+                    else
+                    {
+                        INC_ERROR_COUNTER_WITH_STATE( APC_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
+                    }
+                }
+                else
+                {
+                    INC_ERROR_COUNTER_WITH_STATE( APC_PROXY_ERRORS_MUTEX_TAKE_FAILED )
+                    xSignal.ucEventType = APC_PROXY_DRIVER_E_DIGEST_BUSY;
+                }
+
+                if ( OK != iEVL_RaiseEvent( pxThis->pxEvlRecord, &xSignal ) )
+                {
+                    INC_ERROR_COUNTER_WITH_STATE( APC_PROXY_ERRORS_RAISE_EVENT_FAILED )
+                }
+                break;
+
             default:
                 INC_ERROR_COUNTER_WITH_STATE( APC_PROXY_ERRORS_MBOX_PEND_FAILED )
                 PLL_ERR( APC_NAME, "Error: unknown command type (%d)\r\n", xMBoxData.eMsgType );
@@ -2475,3 +2656,219 @@ static int iVerifyDownload( APCMboxDownloadImage *pxImageData )
     }
     return iStatus;
 }
+
+/**
+ * @brief   Calculate the MD5 digest of the start of a partition
+ */
+static int iDigestPartition( APCMboxDigestPartition *pxDigestData )
+{
+    int iStatus = ERROR;
+
+    if ( ( NULL != pxDigestData ) &&
+         ( MAX_APC_BOOT_DEVICES > pxDigestData->xBootDevice ) &&
+         ( NULL != pxDigestData->pucDigest ) )
+    {
+        APCMd5Context xCtx       = { { 0 } };
+        APC_BOOT_DEVICES xDevice = pxDigestData->xBootDevice;
+        uint32_t ulSrcOffset     =
+            pxThis->ppxFptPartitions[ xDevice ][ pxDigestData->iPartition ].ulPartitionBaseAddr;
+        uint32_t ulRemLen        = pxDigestData->ulLength;
+        uint32_t ulReadLen       = APC_COPY_CHUNK_LEN;
+        uint32_t ulStartMs       = ulOSAL_GetUptimeMs();
+
+        vMd5Init( &xCtx );
+        iStatus = OK;
+
+        while( ( OK == iStatus ) && ( 0 < ulRemLen ) )
+        {
+            ulReadLen = ( ulRemLen < APC_COPY_CHUNK_LEN ) ? ( ulRemLen ) : ( APC_COPY_CHUNK_LEN );
+
+            if ( ( FW_IF_ERRORS_NONE ==
+                   pxThis->ppxFwIf[ xDevice ]->read( pxThis->ppxFwIf[ xDevice ],
+                                                     ( uint64_t )ulSrcOffset, pxThis->pucChunkBuffer,
+                                                     &ulReadLen, 0 ) ) &&
+                 ( 0 < ulReadLen ) )
+            {
+                HAL_FLUSH_CACHE_DATA( ( uintptr_t )pxThis->pucChunkBuffer, ulReadLen );
+                vMd5Update( &xCtx, pxThis->pucChunkBuffer, ulReadLen );
+                ulRemLen    -= ulReadLen;
+                ulSrcOffset += ulReadLen;
+            }
+            else
+            {
+                PLL_ERR( APC_NAME, "Read ERROR (%d bytes) with %d bytes remaining\r\n", ulReadLen, ulRemLen );
+                INC_ERROR_COUNTER_WITH_STATE( APC_PROXY_ERRORS_FW_IF_READ_FAILED )
+                iStatus = ERROR;
+            }
+        }
+
+        if ( OK == iStatus )
+        {
+            vMd5Final( &xCtx, pxDigestData->pucDigest );
+
+            /* Flush the digest so the host sees it in shared memory */
+            HAL_FLUSH_CACHE_DATA( ( uintptr_t )pxDigestData->pucDigest, MD5_SIZE );
+        }
+
+        PLL_DBG( APC_NAME,
+                 "Digest of %d bytes from p%d %s - %dms\r\n",
+                 pxDigestData->ulLength,
+                 pxDigestData->iPartition,
+                 ( OK == iStatus )?( "complete" ):( "failure" ),
+                 ulOSAL_GetUptimeMs() - ulStartMs );
+    }
+    return iStatus;
+}
+
+/**
+ * @brief   Process a single 64 byte MD5 block (RFC 1321)
+ */
+static void vMd5Transform( uint32_t *pulState, const uint8_t *pucBlock )
+{
+    static const uint32_t pulK[ APC_MD5_BLOCK_LEN ] =
+    {
+        0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+        0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+        0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+        0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+        0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+        0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+        0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+        0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+    };
+    static const uint8_t pucShift[ 16 ] =
+    {
+        7, 12, 17, 22, 5, 9, 14, 20, 4, 11, 16, 23, 6, 10, 15, 21
+    };
+    uint32_t pulWords[ 16 ] = { 0 };
+    uint32_t ulA = pulState[ 0 ];
+    uint32_t ulB = pulState[ 1 ];
+    uint32_t ulC = pulState[ 2 ];
+    uint32_t ulD = pulState[ 3 ];
+    int i = 0;
+
+    for( i = 0; i < 16; i++ )
+    {
+        pulWords[ i ] = ( uint32_t )pucBlock[ i * 4 ] |
+                        ( ( uint32_t )pucBlock[ ( i * 4 ) + 1 ] << 8 ) |
+                        ( ( uint32_t )pucBlock[ ( i * 4 ) + 2 ] << 16 ) |
+                        ( ( uint32_t )pucBlock[ ( i * 4 ) + 3 ] << 24 );
+    }
+
+    for( i = 0; i < APC_MD5_BLOCK_LEN; i++ )
+    {
+        uint32_t ulF = 0;
+        uint32_t ulG = 0;
+        uint32_t ulTmp = 0;
+
+        switch( i / 16 )
+        {
+        case 0:
+            ulF = ( ulB & ulC ) | ( ~ulB & ulD );
+            ulG = i;
+            break;
+        case 1:
+            ulF = ( ulD & ulB ) | ( ~ulD & ulC );
+            ulG = ( ( 5 * i ) + 1 ) % 16;
+            break;
+        case 2:
+            ulF = ulB ^ ulC ^ ulD;
+            ulG = ( ( 3 * i ) + 5 ) % 16;
+            break;
+        default:
+            ulF = ulC ^ ( ulB | ~ulD );
+            ulG = ( 7 * i ) % 16;
+            break;
+        }
+
+        ulTmp = ulD;
+        ulD   = ulC;
+        ulC   = ulB;
+        ulB   = ulB + APC_MD5_ROTL( ulA + ulF + pulK[ i ] + pulWords[ ulG ],
+                                    pucShift[ ( ( i / 16 ) * 4 ) + ( i % 4 ) ] );
+        ulA   = ulTmp;
+    }
+
+    pulState[ 0 ] += ulA;
+    pulState[ 1 ] += ulB;
+    pulState[ 2 ] += ulC;
+    pulState[ 3 ] += ulD;
+}
+
+/**
+ * @brief   Reset an MD5 calculation
+ */
+static void vMd5Init( APCMd5Context *pxCtx )
+{
+    if ( NULL != pxCtx )
+    {
+        pxCtx->pulState[ 0 ] = 0x67452301;
+        pxCtx->pulState[ 1 ] = 0xefcdab89;
+        pxCtx->pulState[ 2 ] = 0x98badcfe;
+        pxCtx->pulState[ 3 ] = 0x10325476;
+        pxCtx->ullLength     = 0;
+    }
+}
+
+/**
+ * @brief   Add data to an MD5 calculation
+ */
+static void vMd5Update( APCMd5Context *pxCtx, const uint8_t *pucData, uint32_t ulLen )
+{
+    if ( ( NULL != pxCtx ) && ( NULL != pucData ) )
+    {
+        uint32_t ulUsed = ( uint32_t )( pxCtx->ullLength % APC_MD5_BLOCK_LEN );
+
+        pxCtx->ullLength += ulLen;
+
+        while( 0 < ulLen )
+        {
+            uint32_t ulCopy = APC_MD5_BLOCK_LEN - ulUsed;
+
+            if ( ulCopy > ulLen )
+            {
+                ulCopy = ulLen;
+            }
+
+            pvOSAL_MemCpy( &pxCtx->pucBlock[ ulUsed ], pucData, ulCopy );
+            ulUsed  += ulCopy;
+            pucData += ulCopy;
+            ulLen   -= ulCopy;
+
+            if ( APC_MD5_BLOCK_LEN == ulUsed )
+            {
+                vMd5Transform( pxCtx->pulState, pxCtx->pucBlock );
+                ulUsed = 0;
+            }
+        }
+    }
+}
+
+/**
+ * @brief   Complete an MD5 calculation
+ */
+static void vMd5Final( APCMd5Context *pxCtx, uint8_t *pucDigest )
+{
+    if ( ( NULL != pxCtx ) && ( NULL != pucDigest ) )
+    {
+        static const uint8_t pucPad[ APC_MD5_BLOCK_LEN ] = { 0x80 };
+        uint8_t  pucBits[ 8 ] = { 0 };
+        uint64_t ullBits      = pxCtx->ullLength * 8;
+        uint32_t ulUsed       = ( uint32_t )( pxCtx->ullLength % APC_MD5_BLOCK_LEN );
+        uint32_t ulPadLen     = ( ulUsed < 56 ) ? ( 56 - ulUsed ) : ( 120 - ulUsed );
+        int i = 0;
+
+        for( i = 0; i < 8; i++ )
+        {
+            pucBits[ i ] = ( uint8_t )( ullBits >> ( 8 * i ) );
+        }
+
+        vMd5Update( pxCtx, pucPad, ulPadLen );
+        vMd5Update( pxCtx, pucBits, sizeof( pucBits ) );
+
+        for( i = 0; i < 16; i++ )
+        {
+            pucDigest[ i ] = ( uint8_t )( pxCtx->pulState[ i / 4 ] >> ( 8 * ( i % 4 ) ) );
+        }
+    }
+}
@@ -51,6 +51,9 @@ typedef enum
     APC_PROXY_DRIVER_E_PROGRAM_FAILED     = 15,
     APC_PROXY_DRIVER_E_POR_TRIGGERED      = 16,
     APC_PROXY_DRIVER_E_POR_FAILED         = 17,
+    APC_PROXY_DRIVER_E_DIGEST_COMPLETE    = 18,
+    APC_PROXY_DRIVER_E_DIGEST_BUSY        = 19,
+    APC_PROXY_DRIVER_E_DIGEST_FAILED      = 20,
     MAX_APC_PROXY_DRIVER_EVENTS
 
 } APC_PROXY_DRIVER_EVENTS;
@@ -246,6 +249,27 @@ int iAPC_CopyImage( EVLSignal *pxSignal,
                     uint32_t ulCpyAddr,
                     uint32_t ulAllocatedSize );
 
+/**
+ * iAPC_DigestPartition() - Calculate the MD5 digest of the start of a partition
+ *
+ * @pxSignal:     Current event occurance (used for tracking)
+ * @xBootDevice:  Target boot device
+ * @iPartition:   The partition in the FPT to read
+ * @ulLength:     Number of bytes to digest, from the partition base address
+ * @pucDigest:    Buffer of MD5_SIZE bytes to store the digest in
+ *
+ * @return  OK    Request queued successfully
+ *          ERROR Request not queued
+ *
+ * @note    The digest is calculated by the APC task; APC_PROXY_DRIVER_E_DIGEST_COMPLETE
+ *          is raised once `pucDigest` is valid.
+ */
+int iAPC_DigestPartition( EVLSignal *pxSignal,
+                          APC_BOOT_DEVICES xBootDevice,
+                          int iPartition,
+                          uint32_t ulLength,
+                          uint8_t *pucDigest );
+
 /**
  * iAPC_PdiProgram() - Program PDI image to a location in memory
  *
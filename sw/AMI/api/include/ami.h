@@ -169,7 +169,8 @@ int ami_get_api_version(struct ami_version *ami_version);
  *
  * This function should only be called if the function you called returned
  * AMI_STATUS_ERROR - otherwise, you may get the string for an error
- * from a previous, unrelated function call.
+ * from a previous, unrelated function call. The last error is tracked per
+ * thread, so it always refers to a call made from the calling thread.
  *
  * Return: Error code string.
  */
@@ -134,10 +134,43 @@ enum AMI_PCIE_DEVICE_ID {
  * generated, killing the process. The same will happen if a device exceeds
  * its fatal sensor thresholds.
  *
+ * The parsed devices map is cached for the lifetime of the process and is
+ * refreshed whenever the driver is reloaded, a device is removed or rescanned
+ * through this API, or the cached copy is more than a second old.
+ *
  * Return: AMI_STATUS_OK or AMI_STATUS_ERROR
  */
 int ami_dev_find_next(ami_device **dev, int b, int d, int f, ami_device *prev);
 
+/**
+ * ami_dev_enumerate_all() - Find all devices attached to the AMI driver.
+ * @devs: Pointer to hold an allocated list of device handles.
+ * @num: Variable to hold the number of handles in `devs`.
+ * @with_sensors: Discover the sensors of each device as well.
+ *
+ * This is a bulk alternative to iterating with `ami_dev_find_next` followed
+ * by `ami_sensor_discover`. Each device is registered (and, optionally, has
+ * its sensors discovered) on a separate thread, so the total runtime is
+ * roughly that of the slowest device rather than the sum of all devices.
+ *
+ * Handles are returned in the same order as `ami_dev_find_next` would
+ * return them. Devices which fail to initialise are skipped; an error is
+ * only returned if no device could be brought up. `*devs` must be NULL on
+ * entry and the list must be freed with `ami_dev_delete_all`.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR
+ */
+int ami_dev_enumerate_all(ami_device ***devs, int *num, bool with_sensors);
+
+/**
+ * ami_dev_delete_all() - Free a list returned by `ami_dev_enumerate_all`.
+ * @devs: Pointer to list of device handles.
+ * @num: Number of handles in the list.
+ *
+ * Return: None
+ */
+void ami_dev_delete_all(ami_device ***devs, int num);
+
 /**
  * ami_dev_find() - Wrapper around `ami_dev_find_next`.
  * @bdf: Human readable BDF of the device to search for.
@@ -169,10 +202,32 @@ int ami_dev_bringup(const char *bdf, ami_device **dev);
  * ami_dev_delete() - Free the memory held by a device struct
  * @dev: Device handle.
  *
+ * This drops one reference to the handle (see `ami_dev_ref`) and sets `*dev`
+ * to NULL. The handle itself is only freed once the last reference is gone.
+ *
  * Return: None
  */
 void ami_dev_delete(ami_device **dev);
 
+/**
+ * ami_dev_ref() - Take an additional reference to a device handle.
+ * @dev: Device handle.
+ *
+ * Device handles may be shared between threads without any external
+ * locking. Everything discovered about a device (BDF, sensor list, etc.) is
+ * immutable once published and sensor readings are taken into per-call
+ * buffers, so concurrent getters on the same handle scale with the number of
+ * threads. Each thread (or other owner) that keeps the handle should take
+ * its own reference and release it with `ami_dev_delete`.
+ *
+ * The exceptions are the functions which replace the handle itself
+ * (`ami_dev_pci_reload`, `ami_dev_hot_reset` and `ami_prog_device_boot`);
+ * these must only be called when no other thread is using the device.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR
+ */
+int ami_dev_ref(ami_device *dev);
+
 /**
  * ami_dev_request_access() - Request elevated device permissions.
  * @dev: Device handle.
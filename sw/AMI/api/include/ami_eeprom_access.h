@@ -18,6 +18,15 @@ extern "C" {
 /* Public API includes */
 #include "ami_device.h"
 
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+#define AMI_EEPROM_SIZE		(256)  /* Addressable EEPROM size */
+
+/* Flags for `ami_eeprom_read_all` */
+#define AMI_EEPROM_READ_CACHED	(1 << 0)  /* Serve the contents from the host cache */
+
 /*****************************************************************************/
 /* Function Declarations                                                     */
 /*****************************************************************************/
@@ -33,6 +42,20 @@ extern "C" {
  */
 int ami_eeprom_read(ami_device *dev, uint8_t offset, uint8_t num, uint8_t *val);
 
+/**
+ * ami_eeprom_read_all() - Read the entire EEPROM.
+ * @dev: Device handle.
+ * @flags: Bitwise OR of the AMI_EEPROM_READ_* flags (or 0).
+ * @buf: Buffer to store the contents; must hold AMI_EEPROM_SIZE bytes.
+ *
+ * The EEPROM is read in as few requests as the driver allows. If
+ * AMI_EEPROM_READ_CACHED is set, a copy held by this handle is returned if
+ * present; the copy is dropped by `ami_eeprom_write` or a failed read.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
+ */
+int ami_eeprom_read_all(ami_device *dev, uint32_t flags, uint8_t *buf);
+
 /**
  * ami_eeprom_write() - Write one or more bytes of data to the EEPROM.
  * @dev: Device handle.
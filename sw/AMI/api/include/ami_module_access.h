@@ -18,6 +18,20 @@ extern "C" {
 /* Public API includes */
 #include "ami_device.h"
 
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+#define AMI_MODULE_PAGE_SIZE	(128)  /* Size of the lower page and of each upper page */
+#define AMI_MODULE_MAP_SIZE	(2 * AMI_MODULE_PAGE_SIZE)
+
+/* Flags for `ami_module_read_page` */
+#define AMI_MODULE_READ_LOWER	(1 << 0)  /* Also read the lower page */
+#define AMI_MODULE_READ_CACHED	(1 << 1)  /* Serve the upper page from the host cache */
+
+/* Module ID which selects every module in `ami_module_cache_invalidate` */
+#define AMI_MODULE_ALL		(0xFF)
+
 /*****************************************************************************/
 /* Function Declarations                                                     */
 /*****************************************************************************/
@@ -36,6 +50,44 @@ extern "C" {
 int ami_module_read(ami_device *dev, uint8_t device_id, uint8_t page,
 	uint8_t offset, uint8_t num, uint8_t *val);
 
+/**
+ * ami_module_read_page() - Read a whole page of a QSFP module.
+ * @dev: Device handle.
+ * @device_id: Module ID.
+ * @page: Upper page number to read.
+ * @flags: Bitwise OR of the AMI_MODULE_READ_* flags (or 0).
+ * @buf: Buffer to store the page.
+ *
+ * By default, `buf` must hold AMI_MODULE_PAGE_SIZE bytes and receives bytes
+ * 128-255 of the module memory map with `page` selected. The page is fetched
+ * in a single request rather than a byte at a time.
+ *
+ * If AMI_MODULE_READ_LOWER is set, `buf` must hold AMI_MODULE_MAP_SIZE bytes;
+ * the lower page is stored first, followed by the upper page. The lower page
+ * holds live monitor and flag values and is never cached.
+ *
+ * If AMI_MODULE_READ_CACHED is set, a copy of the upper page held by this
+ * handle is returned if present; otherwise the page is read from the module
+ * and cached. This is intended for static data (identity, vendor info,
+ * thresholds) during inventory scans. The cache for a module is dropped when
+ * it is written to or when any access to it fails (e.g. it was removed), but
+ * the host is not notified of insertions - callers that keep a handle open
+ * across a module swap must call `ami_module_cache_invalidate`.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
+ */
+int ami_module_read_page(ami_device *dev, uint8_t device_id, uint8_t page,
+	uint32_t flags, uint8_t *buf);
+
+/**
+ * ami_module_cache_invalidate() - Drop cached pages for a QSFP module.
+ * @dev: Device handle.
+ * @device_id: Module ID or AMI_MODULE_ALL.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
+ */
+int ami_module_cache_invalidate(ami_device *dev, uint8_t device_id);
+
 /**
  * ami_module_write() - Write one or more bytes of data to a QSFP module.
  * @dev: Device handle.
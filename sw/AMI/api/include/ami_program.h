@@ -14,6 +14,7 @@ extern "C" {
 
 /* Standard includes */
 #include <stdint.h>
+#include <stdbool.h>
 
 /* Public API includes */
 #include "ami_device.h"
@@ -23,6 +24,7 @@ extern "C" {
 /*****************************************************************************/
 #define PDI_CHUNK_MULTIPLIER    (1024)
 #define PDI_CHUNK_SIZE          (4096)  /* Multiple of 1024 */
+#define AMI_PARTITION_DIGEST_SIZE (16)  /* MD5 digest size in bytes */
 
 /*****************************************************************************/
 /* Structs, Enums                                                            */
@@ -184,6 +186,39 @@ int ami_prog_copy_partition(ami_device *dev, uint32_t src_device,
 	uint32_t src_part, uint32_t dest_device, uint32_t dest_part,
 	ami_event_handler progress_handler);
 
+/**
+ * ami_prog_get_partition_digest() - Get the digest of a device partition.
+ * @dev: Device handle.
+ * @boot_device: Target boot device.
+ * @partition: Partition to digest.
+ * @length: Number of bytes to digest from the start of the partition.
+ * @digest: Buffer of `AMI_PARTITION_DIGEST_SIZE` bytes to hold the digest.
+ *
+ * The digest is an MD5 checksum computed by the AMC over the partition
+ * contents, so it can be compared against the MD5 of an image on the host
+ * without reading the partition back.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
+ */
+int ami_prog_get_partition_digest(ami_device *dev, uint8_t boot_device,
+	uint32_t partition, uint32_t length, uint8_t *digest);
+
+/**
+ * ami_prog_partition_matches() - Check if a partition already holds an image.
+ * @dev: Device handle.
+ * @path: Full path to PDI file.
+ * @boot_device: Target boot device.
+ * @partition: Partition to compare against.
+ * @match: Variable to hold the result.
+ *
+ * The MD5 of the image is compared against the digest of the first
+ * image-size bytes of the partition.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
+ */
+int ami_prog_partition_matches(ami_device *dev, const char *path,
+	uint8_t boot_device, uint32_t partition, bool *match);
+
 /**
  * ami_prog_get_fpt_header() - Get the FPT header information.
  * @dev: Device handle.
@@ -130,6 +130,71 @@ struct ami_sensor {
 	ami_sensor_internal *sensor_data;
 };
 
+/**
+ * struct ami_sensor_event - Describes a change reported by `ami_sensor_watch`.
+ * @sensor_name: Name of the top-level sensor.
+ * @type: Sensor type which changed (a single `enum ami_sensor_type` value).
+ * @value: New sensor value.
+ * @prev_value: Previously reported value (0 for the first report).
+ * @status: New sensor status.
+ * @prev_status: Previously reported status (AMI_SENSOR_STATUS_INVALID for
+ *   the first report).
+ *
+ * Values use the same units as the `ami_sensor_get_*_value` getters.
+ */
+struct ami_sensor_event {
+	const char               *sensor_name;
+	enum ami_sensor_type      type;
+	long                      value;
+	long                      prev_value;
+	enum ami_sensor_status    status;
+	enum ami_sensor_status    prev_status;
+};
+
+/**
+ * typedef ami_sensor_watch_handler - Sensor watch callback.
+ * @dev: Device handle being watched.
+ * @event: Description of the change.
+ * @data: User data passed in through `struct ami_sensor_watch_cfg`.
+ *
+ * Called from the device's sampling thread. The event is only valid for
+ * the duration of the callback. The callback must not call
+ * `ami_sensor_watch` or `ami_sensor_unwatch` on the same device.
+ */
+typedef void (*ami_sensor_watch_handler)(ami_device *dev,
+	const struct ami_sensor_event *event, void *data);
+
+/**
+ * struct ami_sensor_deadband - Deadband override for one or more sensors.
+ * @sensor_name: Sensor name to match (NULL matches every sensor).
+ * @type: Bitmask of `enum ami_sensor_type` to match (0 matches every type).
+ * @deadband: Minimum absolute change in value needed to report an event.
+ *   A negative deadband excludes matching sensors from the watch.
+ */
+struct ami_sensor_deadband {
+	const char  *sensor_name;
+	uint32_t     type;
+	long         deadband;
+};
+
+/**
+ * struct ami_sensor_watch_cfg - Sensor watch configuration.
+ * @interval_ms: Sampling interval in milliseconds (must be non-zero).
+ * @callback: Function to call when a sensor changes.
+ * @data: User data passed into `callback`.
+ * @default_deadband: Deadband applied to sensors with no matching override.
+ * @deadbands: Optional list of deadband overrides (last match wins).
+ * @num_deadbands: Number of entries in `deadbands`.
+ */
+struct ami_sensor_watch_cfg {
+	uint32_t                            interval_ms;
+	ami_sensor_watch_handler            callback;
+	void                               *data;
+	long                                default_deadband;
+	const struct ami_sensor_deadband   *deadbands;
+	int                                 num_deadbands;
+};
+
 /*****************************************************************************/
 /* Public API function declarations                                          */
 /*****************************************************************************/
@@ -146,6 +211,42 @@ struct ami_sensor {
  */
 int ami_sensor_discover(ami_device *dev);
 
+/**
+ * ami_sensor_watch() - Subscribe to sensor changes.
+ * @dev: Device handle.
+ * @cfg: Watch configuration.
+ * @watch_id: Variable to hold an identifier for use with `ami_sensor_unwatch`.
+ *
+ * All subscriptions on a device share a single sampling thread which is
+ * started by the first subscription and stopped by the last. Each sensor is
+ * read at most once per sampling tick no matter how many subscriptions
+ * exist. The callback is invoked once per sensor type with its initial
+ * value and status, and afterwards only when the value moves by more than
+ * its deadband from the last reported value or when its status changes.
+ * A status of AMI_SENSOR_STATUS_OK_CACHED is considered equal to
+ * AMI_SENSOR_STATUS_OK for the purpose of change detection.
+ *
+ * `ami_sensor_discover` must have been called on the device first. The
+ * configuration (including any deadbands) is copied and need not outlive
+ * this call. Watches are stopped automatically by `ami_dev_delete`.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR
+ */
+int ami_sensor_watch(ami_device *dev, const struct ami_sensor_watch_cfg *cfg,
+	int *watch_id);
+
+/**
+ * ami_sensor_unwatch() - Remove a subscription created by `ami_sensor_watch`.
+ * @dev: Device handle.
+ * @watch_id: Identifier returned by `ami_sensor_watch`.
+ *
+ * Once this function returns, the callback for the subscription will not be
+ * called again.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR
+ */
+int ami_sensor_unwatch(ami_device *dev, int watch_id);
+
 /**
  * ami_sensor_set_refresh() - Set the sensor update interval.
  * @dev: Device handle.
@@ -49,8 +49,8 @@
 /* Global variables                                                          */
 /*****************************************************************************/
 
-volatile enum ami_error ami_last_error = AMI_ERROR_NONE;
-static char last_error_str[MAX_ERROR_STR] = { 0 };
+__thread volatile enum ami_error ami_last_error = AMI_ERROR_NONE;
+static __thread char last_error_str[MAX_ERROR_STR] = { 0 };
 
 /*****************************************************************************/
 /* Local function definitions                                                */
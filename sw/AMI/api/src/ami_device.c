@@ -15,6 +15,8 @@
 #include <errno.h>
 #include <libgen.h>
 #include <dirent.h>
+#include <time.h>
+#include <pthread.h>
 #include <sys/stat.h>
 #include <sys/ioctl.h>
 
@@ -74,6 +76,85 @@
 #define SYSFS_PCI_RESCAN		"/sys/bus/pci/rescan"
 #define SYSFS_PCI_DEVICES_DIR		"/sys/bus/pci/devices"
 
+/* Discovery cache */
+
+/*
+ * sysfs does not update the mtime of an attribute when its contents change,
+ * so the devices map can only be trusted for a short while even if the inode
+ * and mtime still match (these do change when the driver is reloaded).
+ */
+#define DEV_MAP_CACHE_TTL_MS		(1000)
+#define MS_PER_SEC			(1000)
+#define NS_PER_MS			(1000000)
+
+/*****************************************************************************/
+/* Structs                                                                   */
+/*****************************************************************************/
+
+/**
+ * struct dev_map_entry - a single parsed line of the devices map file
+ * @bdf: device BDF
+ * @cdev_num: character device number
+ * @hwmon_num: hwmon device number
+ */
+struct dev_map_entry {
+	uint16_t  bdf;
+	int       cdev_num;
+	int       hwmon_num;
+};
+
+/**
+ * struct dev_map_cache - process wide cache of the devices map file
+ * @lock: protects all other fields
+ * @valid: true if `entries` holds a usable copy of the map
+ * @st_dev: device ID of the map file when it was parsed
+ * @st_ino: inode number of the map file when it was parsed
+ * @mtime: modification time of the map file when it was parsed
+ * @stamp: monotonic time (in ms) at which the map was parsed
+ * @num_entries: number of devices in `entries`
+ * @entries: parsed devices map
+ *
+ * The cache is only ever populated after the driver version has been checked,
+ * so a hit also implies that the driver is compatible with this library.
+ */
+struct dev_map_cache {
+	pthread_mutex_t        lock;
+	bool                   valid;
+	dev_t                  st_dev;
+	ino_t                  st_ino;
+	struct timespec        mtime;
+	uint64_t               stamp;
+	int                    num_entries;
+	struct dev_map_entry  *entries;
+};
+
+/**
+ * struct dev_enum_job - per device work item for `ami_dev_enumerate_all`
+ * @entry: devices map entry to bring up
+ * @with_sensors: discover sensors after registering the device
+ * @thread: worker thread handle
+ * @thread_created: true if `thread` must be joined
+ * @dev: resulting device handle
+ * @ret: AMI_STATUS_OK or AMI_STATUS_ERROR
+ */
+struct dev_enum_job {
+	struct dev_map_entry   entry;
+	bool                   with_sensors;
+	pthread_t              thread;
+	bool                   thread_created;
+	ami_device            *dev;
+	int                    ret;
+};
+
+/*****************************************************************************/
+/* Global variables                                                          */
+/*****************************************************************************/
+
+static struct dev_map_cache dev_map_cache = {
+	.lock = PTHREAD_MUTEX_INITIALIZER,
+	.valid = false,
+};
+
 /*****************************************************************************/
 /* Local function declarations                                               */
 /*****************************************************************************/
@@ -150,6 +231,69 @@ static int pci_rescan(void);
  */
 static int do_app_setup(ami_device *dev, enum ami_ioc_app_setup arg);
 
+/**
+ * check_driver_version() - Check that the driver is compatible with the API.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR
+ */
+static int check_driver_version(void);
+
+/**
+ * new_device_handle() - Allocate and register a handle for a devices map entry.
+ * @dev: Variable to store new handle.
+ * @entry: Parsed devices map entry.
+ *
+ * Note that, if registration fails, the handle is still returned in `dev`
+ * and must be deleted by the caller.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR
+ */
+static int new_device_handle(ami_device **dev, const struct dev_map_entry *entry);
+
+/**
+ * read_dev_map() - Parse the entire devices map file.
+ * @entries: Variable to store the allocated list of entries.
+ * @num: Variable to store the number of entries.
+ *
+ * The returned list must be freed by the caller. If there are no devices,
+ * `entries` is set to NULL and `num` to 0.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR
+ */
+static int read_dev_map(struct dev_map_entry **entries, int *num);
+
+/**
+ * dev_map_cache_get() - Get a copy of the (possibly cached) devices map.
+ * @entries: Variable to store the allocated list of entries.
+ * @num: Variable to store the number of entries.
+ *
+ * The cache is refreshed if the devices map file has been replaced or
+ * modified or if the cached data is older than DEV_MAP_CACHE_TTL_MS.
+ * If the map file cannot be stat'ed, the driver version does not match,
+ * or the map cannot be parsed, nothing is cached and an error is returned -
+ * callers are expected to fall back to reading the map directly so that
+ * the appropriate error is reported. The returned list must be freed by
+ * the caller.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR
+ */
+static int dev_map_cache_get(struct dev_map_entry **entries, int *num);
+
+/**
+ * dev_map_cache_invalidate() - Drop any cached devices map data.
+ *
+ * Return: None
+ */
+static void dev_map_cache_invalidate(void);
+
+/**
+ * enumerate_worker() - Thread entry point for `ami_dev_enumerate_all`.
+ * @data: Pointer to a `struct dev_enum_job`.
+ *
+ * Return: Always NULL; the result is stored in the job struct.
+ */
+static void *enumerate_worker(void *data);
+
 /*****************************************************************************/
 /* Local function definitions                                                */
 /*****************************************************************************/
@@ -225,10 +369,12 @@ static int pci_remove(uint16_t bdf)
 	);
 
 	if ((file = open(path, O_WRONLY)) != AMI_INVALID_FD) {
-		if (write(file, SYSFS_ENABLE, strlen(SYSFS_ENABLE)) != AMI_LINUX_STATUS_ERROR)
+		if (write(file, SYSFS_ENABLE, strlen(SYSFS_ENABLE)) != AMI_LINUX_STATUS_ERROR) {
+			dev_map_cache_invalidate();
 			ret = AMI_STATUS_OK;
-		else
+		} else {
 			ret = AMI_API_ERROR(AMI_ERROR_EIO);
+		}
 
 		close(file);
 	} else {
@@ -331,10 +477,12 @@ static int pci_rescan(void)
 	int file = AMI_INVALID_FD;
 
 	if ((file = open(SYSFS_PCI_RESCAN, O_WRONLY)) != AMI_INVALID_FD) {
-		if (write(file, SYSFS_ENABLE, strlen(SYSFS_ENABLE)) != AMI_LINUX_STATUS_ERROR)
+		if (write(file, SYSFS_ENABLE, strlen(SYSFS_ENABLE)) != AMI_LINUX_STATUS_ERROR) {
+			dev_map_cache_invalidate();
 			ret = AMI_STATUS_OK;
-		else
+		} else {
 			ret = AMI_API_ERROR(AMI_ERROR_EIO);
+		}
 
 		close(file);
 	} else {
@@ -370,6 +518,231 @@ static int do_app_setup(ami_device *dev, enum ami_ioc_app_setup arg)
 	return ret;
 }
 
+/*
+ * Check the driver version.
+ */
+static int check_driver_version(void)
+{
+	struct ami_version driver_ver = { 0 };
+
+	if (ami_get_driver_version(&driver_ver) == AMI_STATUS_ERROR)
+		return AMI_STATUS_ERROR;
+
+	if ((GIT_TAG_VER_MAJOR != driver_ver.major) || (GIT_TAG_VER_MINOR != driver_ver.minor))
+		return AMI_API_ERROR(AMI_ERROR_EVER);
+
+	return AMI_STATUS_OK;
+}
+
+/*
+ * Allocate and register a new device handle.
+ */
+static int new_device_handle(ami_device **dev, const struct dev_map_entry *entry)
+{
+	if (!dev || !entry)
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+	*dev = (ami_device*)calloc(1, sizeof(ami_device));
+
+	if (!(*dev))
+		return AMI_API_ERROR(AMI_ERROR_ENOMEM);
+
+	(*dev)->bdf = entry->bdf;
+	(*dev)->cdev = AMI_INVALID_FD;
+	(*dev)->cdev_num = entry->cdev_num;
+	(*dev)->hwmon_num = entry->hwmon_num;
+	(*dev)->refcount = 1;
+	pthread_mutex_init(&(*dev)->watch_lock, NULL);
+	pthread_mutex_init(&(*dev)->cache_lock, NULL);
+	snprintf(
+		(*dev)->cdev_name,
+		AMI_DEV_NAME_MAX,
+		"ami-bdf-%02x:%02x.%x",
+		AMI_PCI_BUS(entry->bdf),
+		AMI_PCI_DEV(entry->bdf),
+		AMI_PCI_FUNC(entry->bdf)
+	);
+
+	return ami_dev_register(*dev);
+}
+
+/*
+ * Parse the devices map file.
+ */
+static int read_dev_map(struct dev_map_entry **entries, int *num)
+{
+	int ret = AMI_STATUS_OK;
+	FILE *file = NULL;
+	char *line = NULL;
+	size_t len = 0;
+	int current_line = 0;
+	int num_entries = 0;
+	int max_entries = 0;
+	struct dev_map_entry *list = NULL;
+	int map[AMI_BDF_MAP_MAX] = { 0 };
+
+	if (!entries || !num)
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+	file = fopen(AMI_DEVICES_MAP, "r");
+
+	if (!file)
+		return AMI_API_ERROR(AMI_ERROR_EBADF);
+
+	while (getline(&line, &len, file) != AMI_LINUX_STATUS_ERROR) {
+		/* First line is the number of devices. */
+		if (0 == current_line++)
+			continue;
+
+		if (sscanf(line, "%02x:%02x.%1x %d %d",
+				&map[AMI_BDF_MAP_BUS], &map[AMI_BDF_MAP_DEV],
+				&map[AMI_BDF_MAP_FUNC], &map[AMI_BDF_MAP_DEVN],
+				&map[AMI_BDF_MAP_HWMON]) != AMI_BDF_MAP_MAX) {
+			ret = AMI_API_ERROR(AMI_ERROR_EFMT);
+			break;
+		}
+
+		if (num_entries == max_entries) {
+			struct dev_map_entry *tmp = NULL;
+
+			max_entries = (max_entries) ? (max_entries * 2) : (AMI_BDF_MAP_MAX);
+			tmp = (struct dev_map_entry*)realloc(
+				list,
+				max_entries * sizeof(struct dev_map_entry)
+			);
+
+			if (!tmp) {
+				ret = AMI_API_ERROR(AMI_ERROR_ENOMEM);
+				break;
+			}
+
+			list = tmp;
+		}
+
+		list[num_entries].bdf = AMI_MK_BDF(
+			map[AMI_BDF_MAP_BUS],
+			map[AMI_BDF_MAP_DEV],
+			map[AMI_BDF_MAP_FUNC]
+		);
+		list[num_entries].cdev_num = map[AMI_BDF_MAP_DEVN];
+		list[num_entries].hwmon_num = map[AMI_BDF_MAP_HWMON];
+		num_entries++;
+	}
+
+	fclose(file);
+
+	if (line)
+		free(line);
+
+	if (ret == AMI_STATUS_OK) {
+		*entries = list;
+		*num = num_entries;
+	} else {
+		free(list);
+	}
+
+	return ret;
+}
+
+/*
+ * Get a copy of the devices map, refreshing the cache if necessary.
+ */
+static int dev_map_cache_get(struct dev_map_entry **entries, int *num)
+{
+	int ret = AMI_STATUS_ERROR;
+	struct stat st = { 0 };
+	struct timespec now = { 0 };
+	uint64_t now_ms = 0;
+
+	if (!entries || !num)
+		return AMI_STATUS_ERROR;
+
+	if ((stat(AMI_DEVICES_MAP, &st) == AMI_LINUX_STATUS_ERROR) ||
+			(clock_gettime(CLOCK_MONOTONIC, &now) == AMI_LINUX_STATUS_ERROR))
+		return AMI_STATUS_ERROR;
+
+	now_ms = ((uint64_t)now.tv_sec * MS_PER_SEC) + (now.tv_nsec / NS_PER_MS);
+
+	pthread_mutex_lock(&dev_map_cache.lock);
+
+	if (dev_map_cache.valid &&
+			((dev_map_cache.st_dev != st.st_dev) ||
+			(dev_map_cache.st_ino != st.st_ino) ||
+			(dev_map_cache.mtime.tv_sec != st.st_mtim.tv_sec) ||
+			(dev_map_cache.mtime.tv_nsec != st.st_mtim.tv_nsec) ||
+			((now_ms - dev_map_cache.stamp) > DEV_MAP_CACHE_TTL_MS))) {
+		free(dev_map_cache.entries);
+		dev_map_cache.entries = NULL;
+		dev_map_cache.num_entries = 0;
+		dev_map_cache.valid = false;
+	}
+
+	if (!dev_map_cache.valid &&
+			(check_driver_version() == AMI_STATUS_OK) &&
+			(read_dev_map(&dev_map_cache.entries,
+				&dev_map_cache.num_entries) == AMI_STATUS_OK)) {
+		dev_map_cache.st_dev = st.st_dev;
+		dev_map_cache.st_ino = st.st_ino;
+		dev_map_cache.mtime = st.st_mtim;
+		dev_map_cache.stamp = now_ms;
+		dev_map_cache.valid = true;
+	}
+
+	if (dev_map_cache.valid) {
+		*entries = NULL;
+		*num = dev_map_cache.num_entries;
+		ret = AMI_STATUS_OK;
+
+		if (dev_map_cache.num_entries) {
+			size_t size = dev_map_cache.num_entries * sizeof(struct dev_map_entry);
+
+			*entries = (struct dev_map_entry*)malloc(size);
+
+			if (*entries)
+				memcpy(*entries, dev_map_cache.entries, size);
+			else
+				ret = AMI_STATUS_ERROR;
+		}
+	}
+
+	pthread_mutex_unlock(&dev_map_cache.lock);
+	return ret;
+}
+
+/*
+ * Drop the devices map cache.
+ */
+static void dev_map_cache_invalidate(void)
+{
+	pthread_mutex_lock(&dev_map_cache.lock);
+	free(dev_map_cache.entries);
+	dev_map_cache.entries = NULL;
+	dev_map_cache.num_entries = 0;
+	dev_map_cache.valid = false;
+	pthread_mutex_unlock(&dev_map_cache.lock);
+}
+
+/*
+ * Bring up a single device for `ami_dev_enumerate_all`.
+ */
+static void *enumerate_worker(void *data)
+{
+	struct dev_enum_job *job = (struct dev_enum_job*)data;
+
+	if (!job)
+		return NULL;
+
+	job->ret = new_device_handle(&job->dev, &job->entry);
+
+	if ((job->ret == AMI_STATUS_OK) && job->with_sensors)
+		job->ret = ami_sensor_discover(job->dev);
+
+	if ((job->ret != AMI_STATUS_OK) && job->dev)
+		ami_dev_delete(&job->dev);
+
+	return NULL;
+}
+
 /*****************************************************************************/
 /* Private API function definitions                                          */
 /*****************************************************************************/
@@ -381,25 +754,29 @@ int ami_open_cdev(ami_device *dev)
 {
 	int ret = AMI_STATUS_ERROR;
 	int fd = AMI_INVALID_FD;
+	int expected = AMI_INVALID_FD;
 	char path[AMI_DEV_NAME_MAX] = { 0 };
 
 	if (!dev)
 		return AMI_API_ERROR(AMI_ERROR_EINVAL);
 
-	if (dev->cdev != AMI_INVALID_FD)
+	if (__atomic_load_n(&dev->cdev, __ATOMIC_ACQUIRE) != AMI_INVALID_FD)
 		return AMI_STATUS_OK;  /* Device already opened */
 
 	uint8_t bus = (dev->bdf >> 8) & 0xFF;
 	uint8_t device = (dev->bdf >> 3) & 0x1F;
 	uint8_t func = dev->bdf & 0x7;
 
-	snprintf(dev->cdev_name, AMI_DEV_NAME_MAX, "ami-bdf-%02x:%02x.%x", bus, device, func);
-	snprintf(path, AMI_DEV_NAME_MAX, "/dev/%.32s", dev->cdev_name);
+	snprintf(path, AMI_DEV_NAME_MAX, "/dev/ami-bdf-%02x:%02x.%x", bus, device, func);
 
 	fd = open(path, O_RDWR | O_NONBLOCK);
 
 	if (fd != AMI_INVALID_FD) {
-		dev->cdev = fd;
+		/* Another thread may have opened the device in the meantime. */
+		if (!__atomic_compare_exchange_n(&dev->cdev, &expected, fd, false,
+				__ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+			close(fd);
+
 		ret = AMI_STATUS_OK;
 	} else {
 		ret = AMI_API_ERROR(AMI_ERROR_EBADF);
@@ -416,10 +793,12 @@ int ami_close_cdev(ami_device *dev)
 	if (!dev)
 		return AMI_API_ERROR(AMI_ERROR_EINVAL);
 
-	if (dev->cdev == AMI_INVALID_FD)
+	int fd = __atomic_exchange_n(&dev->cdev, AMI_INVALID_FD, __ATOMIC_ACQ_REL);
+
+	if (fd == AMI_INVALID_FD)
 		return AMI_STATUS_OK;  /* Device already closed */
 
-	if (close(dev->cdev) != AMI_LINUX_STATUS_ERROR)
+	if (close(fd) != AMI_LINUX_STATUS_ERROR)
 		return AMI_STATUS_OK;
 
 	return AMI_API_ERROR(AMI_ERROR_EBADF);
@@ -492,20 +871,46 @@ int ami_dev_find_next(ami_device **dev, int b, int d, int f, ami_device *prev)
 	bool passed_prev = false;
 	int previous_dev = 0;
 	int current_line = 0;
-	struct ami_version driver_ver = { 0 };
+	struct dev_map_entry *entries = NULL;
+	int num_entries = 0;
 	/* Parsed values. */
 	int map[AMI_BDF_MAP_MAX] = { 0, 0, 0, AMI_STATUS_ERROR, AMI_STATUS_ERROR };
 
 	if (!dev || *dev)
 		return AMI_API_ERROR(AMI_ERROR_EINVAL);
 
+	/* Fast path - serve the lookup from the discovery cache. */
+	if (dev_map_cache_get(&entries, &num_entries) == AMI_STATUS_OK) {
+		int i = 0;
+		bool found = false;
+
+		for (i = 0; i < num_entries; i++) {
+			if (!passed_prev && (!prev || (previous_dev == prev->cdev_num)))
+				passed_prev = true;
+
+			if ((passed_prev) &&
+				((b == AMI_ANY_DEV) || (AMI_PCI_BUS(entries[i].bdf) == b)) &&
+				((d == AMI_ANY_DEV) || (AMI_PCI_DEV(entries[i].bdf) == d)) &&
+				((f == AMI_ANY_DEV) || (AMI_PCI_FUNC(entries[i].bdf) == f))) {
+				found = true;
+				ret = new_device_handle(dev, &entries[i]);
+				break;
+			}
+
+			previous_dev = entries[i].cdev_num;
+		}
+
+		free(entries);
+
+		if (!found)
+			ret = AMI_API_ERROR(AMI_ERROR_ENODEV);
+
+		return ret;
+	}
+
 	/* Check driver version */
-	if (ami_get_driver_version(&driver_ver) != AMI_STATUS_ERROR) {
-		if ((GIT_TAG_VER_MAJOR != driver_ver.major) || (GIT_TAG_VER_MINOR != driver_ver.minor))
-			return AMI_API_ERROR(AMI_ERROR_EVER);
-	} else {
+	if (check_driver_version() != AMI_STATUS_OK)
 		return AMI_STATUS_ERROR;
-	}
 
 	file = fopen(AMI_DEVICES_MAP, "r");
 
@@ -537,23 +942,19 @@ int ami_dev_find_next(ami_device **dev, int b, int d, int f, ami_device *prev)
 					((b == AMI_ANY_DEV) || (map[AMI_BDF_MAP_BUS] == b)) &&
 					((d == AMI_ANY_DEV) || (map[AMI_BDF_MAP_DEV] == d)) &&
 					((f == AMI_ANY_DEV) || (map[AMI_BDF_MAP_FUNC] == f))) {
-					/* Initialise device attributes. */
-					found = true;
-					*dev = (ami_device*)calloc(1, sizeof(ami_device));
-
-					if (*dev) {
-						(*dev)->bdf = AMI_MK_BDF(
+					struct dev_map_entry entry = {
+						.bdf = AMI_MK_BDF(
 							map[AMI_BDF_MAP_BUS],
 							map[AMI_BDF_MAP_DEV],
 							map[AMI_BDF_MAP_FUNC]
-						);
-						(*dev)->cdev = AMI_INVALID_FD;
-						(*dev)->cdev_num = map[AMI_BDF_MAP_DEVN];
-						(*dev)->hwmon_num = map[AMI_BDF_MAP_HWMON];
-						ret = ami_dev_register(*dev);
-					} else {
-						ret = AMI_API_ERROR(AMI_ERROR_ENOMEM);
-					}
+						),
+						.cdev_num = map[AMI_BDF_MAP_DEVN],
+						.hwmon_num = map[AMI_BDF_MAP_HWMON],
+					};
+
+					/* Initialise device attributes. */
+					found = true;
+					ret = new_device_handle(dev, &entry);
 					break;
 				}
 
@@ -579,6 +980,99 @@ int ami_dev_find_next(ami_device **dev, int b, int d, int f, ami_device *prev)
 	return ret;
 }
 
+/*
+ * Discover all devices (and optionally their sensors) in parallel.
+ */
+int ami_dev_enumerate_all(ami_device ***devs, int *num, bool with_sensors)
+{
+	int ret = AMI_STATUS_ERROR;
+	struct dev_map_entry *entries = NULL;
+	struct dev_enum_job *jobs = NULL;
+	int num_entries = 0;
+	int num_found = 0;
+	int i = 0;
+
+	if (!devs || *devs || !num)
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+	if (dev_map_cache_get(&entries, &num_entries) != AMI_STATUS_OK) {
+		if (check_driver_version() != AMI_STATUS_OK)
+			return AMI_STATUS_ERROR;
+
+		if (read_dev_map(&entries, &num_entries) != AMI_STATUS_OK)
+			return AMI_STATUS_ERROR;
+	}
+
+	if (num_entries == 0)
+		return AMI_API_ERROR(AMI_ERROR_ENODEV);
+
+	jobs = (struct dev_enum_job*)calloc(num_entries, sizeof(struct dev_enum_job));
+	*devs = (ami_device**)calloc(num_entries, sizeof(ami_device*));
+
+	if (!jobs || !(*devs)) {
+		ret = AMI_API_ERROR(AMI_ERROR_ENOMEM);
+		goto fail;
+	}
+
+	/*
+	 * Registration and hwmon discovery are dominated by syscall latency,
+	 * so each device is brought up on its own thread.
+	 */
+	for (i = 0; i < num_entries; i++) {
+		jobs[i].entry = entries[i];
+		jobs[i].with_sensors = with_sensors;
+		jobs[i].ret = AMI_STATUS_ERROR;
+
+		if (pthread_create(&jobs[i].thread, NULL,
+				enumerate_worker, &jobs[i]) == AMI_LINUX_STATUS_OK)
+			jobs[i].thread_created = true;
+		else
+			enumerate_worker(&jobs[i]);  /* Do it inline instead. */
+	}
+
+	/* Devices are returned in devices map order. */
+	for (i = 0; i < num_entries; i++) {
+		if (jobs[i].thread_created)
+			pthread_join(jobs[i].thread, NULL);
+
+		if ((jobs[i].ret == AMI_STATUS_OK) && jobs[i].dev)
+			(*devs)[num_found++] = jobs[i].dev;
+	}
+
+	if (num_found) {
+		*num = num_found;
+		ret = AMI_STATUS_OK;
+	} else {
+		ret = AMI_API_ERROR(AMI_ERROR_ENODEV);
+	}
+
+fail:
+	if (ret != AMI_STATUS_OK) {
+		free(*devs);
+		*devs = NULL;
+	}
+
+	free(jobs);
+	free(entries);
+	return ret;
+}
+
+/*
+ * Free a list of device handles.
+ */
+void ami_dev_delete_all(ami_device ***devs, int num)
+{
+	int i = 0;
+
+	if (devs && *devs) {
+		for (i = 0; i < num; i++)
+			ami_dev_delete(&(*devs)[i]);
+
+		free(*devs);
+		*devs = NULL;
+	}
+}
+
 /*
  * Find a PCIe device with a specific BDF.
  */
@@ -622,9 +1116,18 @@ int ami_dev_bringup(const char *bdf, ami_device **dev)
 void ami_dev_delete(ami_device **dev)
 {
 	if (dev && *dev) {
+		/* Only the last reference actually frees the handle. */
+		if (__atomic_sub_fetch(&(*dev)->refcount, 1, __ATOMIC_ACQ_REL) > 0) {
+			*dev = NULL;
+			return;
+		}
+
+		/* Stop any sensor watches before the sensor data goes away. */
+		ami_sensor_watch_stop(*dev);
+
 		/* Free sensor data. */
-		if ((*dev)->sensors) {
-			struct ami_sensor *sensor = (*dev)->sensors;
+		if ((*dev)->sensor_list) {
+			struct ami_sensor *sensor = (*dev)->sensor_list->head;
 			struct ami_sensor *next = NULL;
 
 			while (sensor) {
@@ -642,19 +1145,37 @@ void ami_dev_delete(ami_device **dev)
 				sensor = next;
 			}
 
-			(*dev)->num_sensors = 0;
-			(*dev)->num_total_sensors = 0;
-			(*dev)->sensors = NULL;
+			free((*dev)->sensor_list);
+			(*dev)->sensor_list = NULL;
 		}
 
+		/* Free cached EEPROM/module data. */
+		ami_module_cache_invalidate(*dev, AMI_MODULE_ALL);
+		free((*dev)->eeprom_cache);
+		(*dev)->eeprom_cache = NULL;
+
 		/* Cleanup device. */
 		ami_dev_deregister(*dev);
 		ami_close_cdev(*dev);
+		pthread_mutex_destroy(&(*dev)->watch_lock);
+		pthread_mutex_destroy(&(*dev)->cache_lock);
 		free(*dev);
 		*dev = NULL;
 	}
 }
 
+/*
+ * Take an additional reference on a device handle.
+ */
+int ami_dev_ref(ami_device *dev)
+{
+	if (!dev)
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+	__atomic_add_fetch(&dev->refcount, 1, __ATOMIC_RELAXED);
+	return AMI_STATUS_OK;
+}
+
 /*
  * Request elevated device permissions.
  */
@@ -663,7 +1184,7 @@ int ami_dev_request_access(ami_device *dev)
 	if (!dev)
 		return AMI_API_ERROR(AMI_ERROR_EINVAL);
 
-	dev->cap_override = true;
+	__atomic_store_n(&dev->cap_override, true, __ATOMIC_RELEASE);
 	return AMI_STATUS_OK;
 }
 
@@ -682,7 +1203,7 @@ int ami_dev_pci_reload(ami_device **dev, const char *bdf)
 
 	if (dev) {
 		bdf_num = (*dev)->bdf;
-		has_sensors = ((*dev)->sensors != NULL);
+		has_sensors = ((*dev)->sensor_list != NULL);
 		ami_dev_delete(dev);
 	} else {
 		bdf_num = ami_parse_bdf(bdf);
@@ -740,7 +1261,7 @@ int ami_dev_hot_reset(ami_device **dev)
 		return AMI_API_ERROR(AMI_ERROR_EBADF);
 
 	/* Remove device */
-	has_sensors = ((*dev)->sensors != NULL);
+	has_sensors = ((*dev)->sensor_list != NULL);
 	bdf = (*dev)->bdf;
 	ami_dev_delete(dev);
 	ret = pci_remove(bdf);
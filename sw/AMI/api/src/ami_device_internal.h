@@ -13,6 +13,7 @@
 
 /* Public API includes */
 #include "ami_device.h"
+#include "ami_module_access.h"
 
 /* Private API includes */
 #include "ami_internal.h"
@@ -31,6 +32,35 @@
 /* Structs                                                                   */
 /*****************************************************************************/
 
+/**
+ * struct ami_module_page - cached copy of a QSFP module upper page
+ * @device_id: module ID
+ * @page: upper page number
+ * @data: page contents (bytes 128-255 of the memory map)
+ * @next: next cached page
+ */
+struct ami_module_page {
+	uint8_t                  device_id;
+	uint8_t                  page;
+	uint8_t                  data[AMI_MODULE_PAGE_SIZE];
+	struct ami_module_page  *next;
+};
+
+/**
+ * struct ami_sensor_list - sensors discovered for a device
+ * @head: list of supported sensors
+ * @num_sensors: number of suported sensors (eg. vccint, 12v_pex, etc...)
+ * @num_total_sensors: total number of sensors  (e.g. vccint temp, vccint power, etc...)
+ *
+ * Published through a single pointer so the counts are always seen
+ * together with the list they describe.
+ */
+struct ami_sensor_list {
+	struct ami_sensor  *head;
+	int                 num_sensors;
+	int                 num_total_sensors;
+};
+
 /**
  * struct ami_device - represents a single PCI device
  * @bdf: device BDF
@@ -38,13 +68,27 @@
  * @cdev_num: character device number
  * @cdev: character device file handle (may be invalid)
  * @hwmon_num: hwmon device number
- * @num_sensors: number of suported sensors (eg. vccint, 12v_pex, etc...)
- * @num_total_sensors: total number of sensors  (e.g. vccint temp, vccint power, etc...)
- * @sensors: list of supported sensors (head)
+ * @sensor_list: discovered sensors (NULL until discovered)
+ * @cdev_name: character device name
+ * @watcher: sensor sampling thread (NULL if no sensor watches are active)
+ * @watch_lock: serialises starting/stopping of `watcher`
+ * @refcount: number of references held on this handle
+ * @cache_lock: protects `module_cache` and `eeprom_cache`
+ * @module_cache: cached QSFP module pages (head)
+ * @eeprom_cache: cached EEPROM contents (NULL if not cached)
+ * @cache_gen: bumped whenever cached data is dropped
  *
  * If `cap_override` is set to true, all IOCTL's (and any other relevant API)
  * issued using this device handle will bypass any permission checks
  * and execute code that would, normally, only be reachable with root/sudo!
+ *
+ * A handle may be shared between threads. `bdf`, `cdev_num`, `hwmon_num` and
+ * `cdev_name` are set at discovery and never change. `cdev`, `cap_override`
+ * and `sensor_list` are only ever published with atomic operations and, once
+ * set, are not modified again until the last reference is dropped. Nothing
+ * on the read path writes to the handle, so no lock is needed there. The
+ * optional EEPROM/module read caches are the exception and are guarded by
+ * `cache_lock`.
  */
 struct ami_device {
 	uint16_t            bdf;
@@ -52,10 +96,15 @@ struct ami_device {
 	int                 cdev_num;
 	int                 cdev;
 	int                 hwmon_num;
-	int                 num_sensors;
-	int                 num_total_sensors;
-	struct ami_sensor  *sensors;
+	struct ami_sensor_list *sensor_list;
 	char                cdev_name[AMI_DEV_NAME_MAX];
+	struct ami_sensor_watcher *watcher;
+	pthread_mutex_t     watch_lock;
+	int                 refcount;
+	pthread_mutex_t     cache_lock;
+	struct ami_module_page *module_cache;
+	uint8_t            *eeprom_cache;
+	unsigned int        cache_gen;
 };
 
 /*****************************************************************************/
@@ -9,7 +9,9 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <errno.h>
+#include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
 #include <sys/ioctl.h>
 
 /* Public API includes */
@@ -20,6 +22,32 @@
 #include "ami_internal.h"
 #include "ami_device_internal.h"
 
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+/* Largest power-of-two transfer that fits the 8-bit ioctl length. */
+#define EEPROM_CHUNK_SIZE	(128)
+
+/*****************************************************************************/
+/* Local functions                                                           */
+/*****************************************************************************/
+
+/**
+ * drop_eeprom_cache() - Discard the cached EEPROM contents.
+ * @dev: Device handle.
+ *
+ * Return: None.
+ */
+static void drop_eeprom_cache(ami_device *dev)
+{
+	pthread_mutex_lock(&dev->cache_lock);
+	free(dev->eeprom_cache);
+	dev->eeprom_cache = NULL;
+	dev->cache_gen++;
+	pthread_mutex_unlock(&dev->cache_lock);
+}
+
 /*****************************************************************************/
 /* Public API function definitions                                           */
 /*****************************************************************************/
@@ -56,6 +84,60 @@ int ami_eeprom_read(ami_device *dev, uint8_t offset, uint8_t num, uint8_t *val)
 	return ret;
 }
 
+/*
+ * ami_eeprom_read_all() - Read the entire EEPROM.
+ */
+int ami_eeprom_read_all(ami_device *dev, uint32_t flags, uint8_t *buf)
+{
+	int ret = AMI_STATUS_OK;
+	int offset = 0;
+	unsigned int gen = 0;
+	bool hit = false;
+
+	if (!dev || !buf)
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+	if (flags & AMI_EEPROM_READ_CACHED) {
+		pthread_mutex_lock(&dev->cache_lock);
+
+		if (dev->eeprom_cache) {
+			memcpy(buf, dev->eeprom_cache, AMI_EEPROM_SIZE);
+			hit = true;
+		}
+
+		gen = dev->cache_gen;
+		pthread_mutex_unlock(&dev->cache_lock);
+
+		if (hit)
+			return AMI_STATUS_OK;
+	}
+
+	for (offset = 0; (offset < AMI_EEPROM_SIZE) && (ret == AMI_STATUS_OK); offset += EEPROM_CHUNK_SIZE)
+		ret = ami_eeprom_read(dev, offset, EEPROM_CHUNK_SIZE, &buf[offset]);
+
+	if (ret != AMI_STATUS_OK) {
+		drop_eeprom_cache(dev);
+		return AMI_STATUS_ERROR; /* last error is set by ami_eeprom_read */
+	}
+
+	if (flags & AMI_EEPROM_READ_CACHED) {
+		pthread_mutex_lock(&dev->cache_lock);
+
+		/* Skip caching if a write raced with the read. */
+		if (gen == dev->cache_gen) {
+			if (!dev->eeprom_cache)
+				dev->eeprom_cache = (uint8_t*)malloc(AMI_EEPROM_SIZE);
+
+			if (dev->eeprom_cache)
+				memcpy(dev->eeprom_cache, buf, AMI_EEPROM_SIZE);
+		}
+
+		pthread_mutex_unlock(&dev->cache_lock);
+	}
+
+	return AMI_STATUS_OK;
+}
+
 /*
  * ami_eeprom_write() - Write one or more bytes of data to the EEPROM.
  */
@@ -85,5 +167,8 @@ int ami_eeprom_write(ami_device *dev, uint8_t offset, uint8_t num, uint8_t *val)
 		ret = AMI_STATUS_OK;
 	}
 
+	/* Any cached copy is stale once a write has been attempted. */
+	drop_eeprom_cache(dev);
+
 	return ret;
 }
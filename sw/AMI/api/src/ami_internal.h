@@ -85,10 +85,10 @@ struct ami_event_data {
 
 /*
  * Global variable to keep track of the last API error.
- * Declared volatile to mimic the behaviour of errno, so it can be used
- * from signal handlers or separate threads.
+ * Declared thread local and volatile to mimic the behaviour of errno, so it
+ * can be used from signal handlers and each thread sees its own error.
  */
-extern volatile enum ami_error ami_last_error;
+extern __thread volatile enum ami_error ami_last_error;
 
 /*****************************************************************************/
 /* Private API function definitions                                          */
@@ -64,7 +64,7 @@ static int do_bar_transaction(ami_device *dev, uint8_t idx, uint64_t offset,
 	data.addr = (unsigned long)val;
 	data.bar_idx = idx;
 	data.offset = offset;
-	data.cap_override = dev->cap_override;
+	data.cap_override = __atomic_load_n(&dev->cap_override, __ATOMIC_ACQUIRE);
 
 	errno = 0;
 
@@ -9,7 +9,9 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <errno.h>
+#include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
 #include <sys/ioctl.h>
 
 /* Public API includes */
@@ -65,9 +67,75 @@ static int do_module_rw(unsigned long ioc, ami_device *dev, uint8_t device_id,
 		ret = AMI_STATUS_OK;
 	}
 
+	/* A write, or a failure (e.g. module removed), makes cached pages stale. */
+	if ((ioc == AMI_IOC_WRITE_MODULE) || (ret != AMI_STATUS_OK))
+		ami_module_cache_invalidate(dev, device_id);
+
 	return ret;
 }
 
+/**
+ * find_cached_page() - Look up a cached module page.
+ * @dev: Device handle (`cache_lock` must be held).
+ * @device_id: Module ID.
+ * @page: Upper page number.
+ *
+ * Return: The cached page or NULL.
+ */
+static struct ami_module_page *find_cached_page(ami_device *dev,
+	uint8_t device_id, uint8_t page)
+{
+	struct ami_module_page *entry = NULL;
+
+	for (entry = dev->module_cache; entry; entry = entry->next) {
+		if ((entry->device_id == device_id) && (entry->page == page))
+			break;
+	}
+
+	return entry;
+}
+
+/**
+ * cache_page() - Store a copy of a module page.
+ * @dev: Device handle.
+ * @device_id: Module ID.
+ * @page: Upper page number.
+ * @gen: Value of `cache_gen` sampled before the page was read.
+ * @data: Page contents (AMI_MODULE_PAGE_SIZE bytes).
+ *
+ * The page is not stored if the cache was invalidated while it was being
+ * read. Caching is best effort, so allocation failures are ignored.
+ *
+ * Return: None.
+ */
+static void cache_page(ami_device *dev, uint8_t device_id, uint8_t page,
+	unsigned int gen, const uint8_t *data)
+{
+	struct ami_module_page *entry = NULL;
+
+	pthread_mutex_lock(&dev->cache_lock);
+
+	if (gen == dev->cache_gen) {
+		entry = find_cached_page(dev, device_id, page);
+
+		if (!entry) {
+			entry = (struct ami_module_page*)calloc(1, sizeof(struct ami_module_page));
+
+			if (entry) {
+				entry->device_id = device_id;
+				entry->page = page;
+				entry->next = dev->module_cache;
+				dev->module_cache = entry;
+			}
+		}
+
+		if (entry)
+			memcpy(entry->data, data, AMI_MODULE_PAGE_SIZE);
+	}
+
+	pthread_mutex_unlock(&dev->cache_lock);
+}
+
 /*****************************************************************************/
 /* Public API function definitions                                           */
 /*****************************************************************************/
@@ -92,6 +160,84 @@ int ami_module_read(ami_device *dev, uint8_t device_id, uint8_t page,
 	);
 }
 
+/*
+ * Read a whole page from a QSFP module.
+ */
+int ami_module_read_page(ami_device *dev, uint8_t device_id, uint8_t page,
+	uint32_t flags, uint8_t *buf)
+{
+	struct ami_module_page *entry = NULL;
+	uint8_t *upper = buf;
+	unsigned int gen = 0;
+	bool hit = false;
+
+	if (!dev || !buf)
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+	if (flags & AMI_MODULE_READ_LOWER) {
+		/* Lower page is only addressable as page 0. */
+		if (do_module_rw(AMI_IOC_READ_MODULE, dev, device_id, 0, 0,
+				AMI_MODULE_PAGE_SIZE, buf) != AMI_STATUS_OK)
+			return AMI_STATUS_ERROR; /* last error is set by do_module_rw */
+
+		upper = &buf[AMI_MODULE_PAGE_SIZE];
+	}
+
+	if (flags & AMI_MODULE_READ_CACHED) {
+		pthread_mutex_lock(&dev->cache_lock);
+
+		if ((entry = find_cached_page(dev, device_id, page))) {
+			memcpy(upper, entry->data, AMI_MODULE_PAGE_SIZE);
+			hit = true;
+		}
+
+		gen = dev->cache_gen;
+		pthread_mutex_unlock(&dev->cache_lock);
+
+		if (hit)
+			return AMI_STATUS_OK;
+	}
+
+	if (do_module_rw(AMI_IOC_READ_MODULE, dev, device_id, page,
+			AMI_MODULE_PAGE_SIZE, AMI_MODULE_PAGE_SIZE, upper) != AMI_STATUS_OK)
+		return AMI_STATUS_ERROR; /* last error is set by do_module_rw */
+
+	if (flags & AMI_MODULE_READ_CACHED)
+		cache_page(dev, device_id, page, gen, upper);
+
+	return AMI_STATUS_OK;
+}
+
+/*
+ * Drop cached pages for a QSFP module.
+ */
+int ami_module_cache_invalidate(ami_device *dev, uint8_t device_id)
+{
+	struct ami_module_page **link = NULL;
+	struct ami_module_page *entry = NULL;
+
+	if (!dev)
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+	pthread_mutex_lock(&dev->cache_lock);
+
+	link = &dev->module_cache;
+
+	while ((entry = *link)) {
+		if ((device_id == AMI_MODULE_ALL) || (entry->device_id == device_id)) {
+			*link = entry->next;
+			free(entry);
+		} else {
+			link = &entry->next;
+		}
+	}
+
+	dev->cache_gen++;
+	pthread_mutex_unlock(&dev->cache_lock);
+
+	return AMI_STATUS_OK;
+}
+
 /*
  * Write one or more bytes of data to a QSFP module
  */
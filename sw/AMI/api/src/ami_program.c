@@ -135,7 +135,7 @@ static int do_image_download(ami_device *dev, const char *path, uint8_t boot_dev
 		payload.size = img_size;
 		payload.addr = (unsigned long)(&img_data[0]);
 		payload.pdi_size = img_size;
-		payload.cap_override = dev->cap_override;
+		payload.cap_override = __atomic_load_n(&dev->cap_override, __ATOMIC_ACQUIRE);
 		payload.boot_device = boot_device;
 		payload.partition = partition;
 		payload.efd = AMI_INVALID_FD;
@@ -356,6 +356,71 @@ int ami_prog_copy_partition(ami_device *dev, uint32_t src_device, uint32_t src_p
 	return ret;
 }
 
+/*
+ * Get the digest of a device partition.
+ */
+int ami_prog_get_partition_digest(ami_device *dev, uint8_t boot_device,
+	uint32_t partition, uint32_t length, uint8_t *digest)
+{
+	int ret = AMI_STATUS_ERROR;
+	struct ami_ioc_partition_digest_value data = { 0 };
+
+	if (!dev || !digest || (length == 0))
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+	if (ami_open_cdev(dev) != AMI_STATUS_OK)
+		return AMI_STATUS_ERROR; /* last error is set by ami_open_cdev */
+
+	data.boot_device = boot_device;
+	data.partition = partition;
+	data.length = length;
+
+	errno = 0;
+	if (ioctl(dev->cdev, AMI_IOC_GET_PARTITION_DIGEST, &data) == AMI_LINUX_STATUS_ERROR) {
+		ret = AMI_API_ERROR_M(
+			AMI_ERROR_EIO,
+			"errno %d (%s)",
+			errno,
+			strerror(errno)
+		);
+	} else {
+		ret = AMI_STATUS_OK;
+		memcpy(digest, data.digest, AMI_PARTITION_DIGEST_SIZE);
+	}
+
+	return ret;
+}
+
+/*
+ * Check if a partition already holds an image.
+ */
+int ami_prog_partition_matches(ami_device *dev, const char *path,
+	uint8_t boot_device, uint32_t partition, bool *match)
+{
+	int ret = AMI_STATUS_ERROR;
+	uint8_t *img_data = NULL;
+	uint32_t img_size = 0;
+	uint8_t img_md5[MD5_SIZE] = { 0 };
+	uint8_t part_md5[MD5_SIZE] = { 0 };
+
+	if (!dev || !path || !match)
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+	if (read_file(path, &img_data, &img_size) != AMI_STATUS_OK)
+		return AMI_STATUS_ERROR;  /* last error is set by read_file */
+
+	calculate_md5(img_data, img_size, img_md5);
+	free(img_data);  /* allocated by `read_file` */
+
+	ret = ami_prog_get_partition_digest(dev, boot_device, partition,
+		img_size, part_md5);
+
+	if (ret == AMI_STATUS_OK)
+		*match = (memcmp(img_md5, part_md5, MD5_SIZE) == 0);
+
+	return ret;
+}
+
 /*
  * Get the FPT header.
  */
@@ -15,6 +15,8 @@
 #include <unistd.h>
 #include <sys/stat.h>
 #include <errno.h>
+#include <time.h>
+#include <pthread.h>
 
 /* Private API includes */
 #include "ami_internal.h"
@@ -35,6 +37,10 @@
 #define SENSOR_STATUS_NAME_NO_DATA		"Data Not Available"
 #define SENSOR_STATUS_NAME_NA			"Not Applicable or Default Value"
 
+/* For sensor watches */
+#define WATCH_MS_PER_SEC	(1000)
+#define WATCH_NS_PER_MS		(1000000)
+
 /*****************************************************************************/
 /* Local function declarations                                               */
 /*****************************************************************************/
@@ -151,14 +157,25 @@ static int find_sensor_by_name(ami_device *dev, const char *name,
 
 /**
  * populate_device_sensors() - Create top level sensor structs from sensor data.
- * @dev: Device handle.
+ * @head: Variable to store the list of top level sensors.
+ * @num: Variable to store the number of top level sensors.
  * @data: All sensor data collected.
  *
- * This function should only be called once as pami of the discovery step.
+ * The list is built privately and only attached to a device handle once it is
+ * complete (see `ami_sensor_discover`).
  *
  * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
  */
-static int populate_device_sensors(ami_device *dev, struct ami_sensor_data *data);
+static int populate_device_sensors(struct ami_sensor **head, int *num,
+	struct ami_sensor_data *data);
+
+/**
+ * free_sensors() - Free a list of top level sensors and their data.
+ * @sensors: List of sensors (head).
+ *
+ * Return: None
+ */
+static void free_sensors(struct ami_sensor *sensors);
 
 /**
  * parse_sensor_status() - Convert a sensor status string to enum.
@@ -199,6 +216,59 @@ static int get_value(ami_device *dev, const char *sensor_name,
 	enum ami_sensor_attr_type attr, enum ami_sensor_type type, void *val,
 	enum ami_sensor_status *status);
 
+/**
+ * watch_now_ms() - Get the current monotonic time in milliseconds.
+ *
+ * Return: Time in milliseconds.
+ */
+static uint64_t watch_now_ms(void);
+
+/**
+ * watch_create() - Allocate a sampling thread context for a device.
+ * @dev: Device handle.
+ *
+ * This builds a flat list of all sensor data structs so that each one can be
+ * sampled exactly once per tick. The thread itself is not started.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR
+ */
+static int watch_create(ami_device *dev);
+
+/**
+ * watch_destroy() - Free a sampling thread context and all its subscriptions.
+ * @w: Watcher context. The thread must already have been joined.
+ *
+ * Return: None
+ */
+static void watch_destroy(struct ami_sensor_watcher *w);
+
+/**
+ * watch_free_sub() - Free a single subscription.
+ * @sub: Subscription to free.
+ *
+ * Return: None
+ */
+static void watch_free_sub(struct ami_sensor_watch_sub *sub);
+
+/**
+ * watch_sample() - Sample all sensors which a due subscription is interested in.
+ * @w: Watcher context.
+ * @now: Current time in milliseconds.
+ *
+ * Must be called with the watcher lock held.
+ *
+ * Return: None
+ */
+static void watch_sample(struct ami_sensor_watcher *w, uint64_t now);
+
+/**
+ * watch_thread() - Per device sensor sampling thread.
+ * @data: Pointer to a `struct ami_sensor_watcher`.
+ *
+ * Return: Always NULL.
+ */
+static void *watch_thread(void *data);
+
 /*****************************************************************************/
 /* Local function definitions                                                */
 /*****************************************************************************/
@@ -515,11 +585,17 @@ static int find_sensor_by_name(ami_device *dev, const char *name,
 {
 	int ret = AMI_STATUS_ERROR;
 
-	/* Cache last value */
-	static ami_device *last_dev = NULL;
-	static struct ami_sensor *last = NULL;
+	/* Cache last value (per thread, as devices may be discovered in parallel) */
+	static __thread ami_device *last_dev = NULL;
+	static __thread struct ami_sensor *last = NULL;
+	struct ami_sensor_list *list = NULL;
 
-	if (!dev || !dev->sensors || !name || !sensor)
+	if (!dev || !name || !sensor)
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+	list = __atomic_load_n(&dev->sensor_list, __ATOMIC_ACQUIRE);
+
+	if (!list)
 		return AMI_API_ERROR(AMI_ERROR_EINVAL);
 
 	/* Check cached value. */
@@ -527,7 +603,7 @@ static int find_sensor_by_name(ami_device *dev, const char *name,
 		*sensor = last;
 		ret = AMI_STATUS_OK;
 	} else {
-		struct ami_sensor *next = dev->sensors;
+		struct ami_sensor *next = list->head;
 
 		while (next) {
 			if (strcmp(next->name, name) == 0) {
@@ -548,18 +624,21 @@ static int find_sensor_by_name(ami_device *dev, const char *name,
 /*
  * Create top level sensor structs.
  */
-static int populate_device_sensors(ami_device *dev, struct ami_sensor_data *data)
+static int populate_device_sensors(struct ami_sensor **head, int *num,
+	struct ami_sensor_data *data)
 {
 	int ret = AMI_STATUS_OK;
 	struct ami_sensor *sensors_tail = NULL;
 	struct ami_sensor_data *next = data;
 
-	if (!dev || dev->sensors)
+	if (!head || *head || !num)
 		return AMI_API_ERROR(AMI_ERROR_EINVAL);
 
 	while (next) {
-		struct ami_sensor *sensor = NULL;
-		find_sensor_by_name(dev, next->name.value_s, &sensor);
+		struct ami_sensor *sensor = *head;
+
+		while (sensor && (strcmp(sensor->name, next->name.value_s) != 0))
+			sensor = sensor->next;
 
 		if (!sensor) {
 			sensor = \
@@ -574,21 +653,22 @@ static int populate_device_sensors(ami_device *dev, struct ami_sensor_data *data
 				(ami_sensor_internal*)calloc(1, sizeof(struct ami_sensor_internal));
 
 			if (!sensor->sensor_data) {
+				free(sensor);
 				ret = AMI_API_ERROR(AMI_ERROR_ENOMEM);
 				break;
 			}
 
 			strcpy(sensor->name, next->name.value_s);
 
-			if (dev->sensors) {
+			if (*head) {
 				sensors_tail->next = sensor;
 				sensors_tail = sensor;
 			} else {
-				dev->sensors = sensor;
+				*head = sensor;
 				sensors_tail = sensor;
 			}
 
-			dev->num_sensors++;
+			(*num)++;
 		}
 
 		switch (next->type) {
@@ -622,6 +702,26 @@ static int populate_device_sensors(ami_device *dev, struct ami_sensor_data *data
 	return ret;
 }
 
+/*
+ * Free a sensor list.
+ */
+static void free_sensors(struct ami_sensor *sensors)
+{
+	struct ami_sensor *next = NULL;
+
+	while (sensors) {
+		next = sensors->next;
+
+		free(sensors->sensor_data->temp);
+		free(sensors->sensor_data->power);
+		free(sensors->sensor_data->current);
+		free(sensors->sensor_data->voltage);
+		free(sensors->sensor_data);
+		free(sensors);
+		sensors = next;
+	}
+}
+
 /*
  * Convert a status string to enum value.
  */
@@ -702,6 +802,11 @@ static int get_value(ami_device *dev, const char *sensor_name,
 	if (!data)
 		return AMI_API_ERROR(AMI_ERROR_EINVAL);
 
+	/*
+	 * Sensor data is shared by every thread using this device handle, so
+	 * fresh readings are taken into a local copy of the attribute and only
+	 * ever returned to the caller - never written back.
+	 */
 	switch (attr) {
 		/* String */
 		case AMI_SENSOR_ATTR_NAME:
@@ -710,97 +815,107 @@ static int get_value(ami_device *dev, const char *sensor_name,
 
 		/* Number */
 		case AMI_SENSOR_ATTR_STATUS:
-			ret = read_sensor_attr(&data->status);
+		{
+			struct ami_sensor_attr snap = data->status;
+
+			ret = read_sensor_attr(&snap);
 
 			if (!ret)
 				*((enum ami_sensor_status*)val) = \
-					parse_sensor_status(data->status.value_s);
+					parse_sensor_status(snap.value_s);
 			break;
+		}
 
 		case AMI_SENSOR_ATTR_VALUE:
+		{
+			struct ami_sensor_attr snap = data->value;
+
 			/* If user requested status, use IOCTL instead. */
 			if (status) {
+				struct ami_sensor_attr status_snap = data->status;
 				bool f = false;
 				ret = get_single_sensor_val(dev, type, data->sid,
-					&data->value, &data->status, &f);
+					&snap, &status_snap, &f);
 
 				if (!ret) {
-					*status = parse_sensor_status(data->status.value_s);
+					*status = parse_sensor_status(status_snap.value_s);
 
 					if ((*status == AMI_SENSOR_STATUS_OK) && (f == false))
 						*status = AMI_SENSOR_STATUS_OK_CACHED;
 				}
 			} else {
 				/* Read hwmon otherwise... */
-				ret = read_sensor_attr(&data->value);
+				ret = read_sensor_attr(&snap);
 			}
 
 			if (!ret)
-				*((long*)val) = data->value.value_l;
+				*((long*)val) = snap.value_l;
 			break;
+		}
 
 		case AMI_SENSOR_ATTR_MAX:
-			if (data->max.valid) {
-				ret = read_sensor_attr(&data->max);
-
-				if (!ret)
-					*((long*)val) = data->max.value_l;
-			} else {
-				ret = AMI_API_ERROR(AMI_ERROR_EINVAL);
-			}
-			break;
-
 		case AMI_SENSOR_ATTR_AVG:
-			if (data->average.valid) {
-				ret = read_sensor_attr(&data->average);
+		{
+			struct ami_sensor_attr snap = (attr == AMI_SENSOR_ATTR_MAX) ?
+				(data->max) : (data->average);
+
+			if (snap.valid) {
+				ret = read_sensor_attr(&snap);
 
 				if (!ret)
-					*((long*)val) = data->average.value_l;
+					*((long*)val) = snap.value_l;
 			} else {
 				ret = AMI_API_ERROR(AMI_ERROR_EINVAL);
 			}
 			break;
+		}
 
 		/*
 		* The limits don't change over the lifetime of a device so we only
 		* need to read hwmon once - assume that if the limit value is non-zero
-		* the hwmon entry has already been read.
+		* the hwmon entry has already been read. The cached value is
+		* published atomically so concurrent readers see either 0 or the
+		* final limit.
 		*/
 		case AMI_SENSOR_ATTR_WARN_LIMIT:
-			if (data->warn_limit.valid) {
-				if (data->warn_limit.value_l == 0)
-					ret = read_sensor_attr(&data->warn_limit);
-
-				if (!ret)
-					*((long*)val) = data->warn_limit.value_l;
-			} else {
+		case AMI_SENSOR_ATTR_CRIT_LIMIT:
+		case AMI_SENSOR_ATTR_FATAL_LIMIT:
+		{
+			struct ami_sensor_attr *limit = NULL;
+			long cached = 0;
+
+			if (attr == AMI_SENSOR_ATTR_WARN_LIMIT)
+				limit = &data->warn_limit;
+			else if (attr == AMI_SENSOR_ATTR_CRIT_LIMIT)
+				limit = &data->crit_limit;
+			else
+				limit = &data->fatal_limit;
+
+			if (!limit->valid) {
 				ret = AMI_API_ERROR(AMI_ERROR_EINVAL);
+				break;
 			}
-			break;
 
-		case AMI_SENSOR_ATTR_CRIT_LIMIT:
-			if (data->crit_limit.valid) {
-				if (data->crit_limit.value_l == 0)
-					ret = read_sensor_attr(&data->crit_limit);
+			cached = __atomic_load_n(&limit->value_l, __ATOMIC_RELAXED);
 
-				if (!ret)
-					*((long*)val) = data->crit_limit.value_l;
-			} else {
-				ret = AMI_API_ERROR(AMI_ERROR_EINVAL);
-			}
-			break;
+			if (cached == 0) {
+				struct ami_sensor_attr snap = { 0 };
 
-		case AMI_SENSOR_ATTR_FATAL_LIMIT:
-			if (data->fatal_limit.valid) {
-				if (data->fatal_limit.value_l == 0)
-					ret = read_sensor_attr(&data->fatal_limit);
+				snap.valid = limit->valid;
+				snap.type = limit->type;
+				memcpy(snap.hwmon, limit->hwmon, AMI_HWMON_PATH_MAX_SIZE);
+				ret = read_sensor_attr(&snap);
 
-				if (!ret)
-					*((long*)val) = data->fatal_limit.value_l;
-			} else {
-				ret = AMI_API_ERROR(AMI_ERROR_EINVAL);
+				if (!ret) {
+					cached = snap.value_l;
+					__atomic_store_n(&limit->value_l, cached, __ATOMIC_RELAXED);
+				}
 			}
+
+			if (!ret)
+				*((long*)val) = cached;
 			break;
+		}
 
 		/* The unit is a special case. */
 		case AMI_SENSOR_ATTR_UNIT_MOD:
@@ -815,6 +930,280 @@ static int get_value(ami_device *dev, const char *sensor_name,
 	return ret;
 }
 
+/*
+ * Get monotonic time in ms.
+ */
+static uint64_t watch_now_ms(void)
+{
+	struct timespec ts = { 0 };
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * WATCH_MS_PER_SEC) + (ts.tv_nsec / WATCH_NS_PER_MS);
+}
+
+/*
+ * Allocate a watcher context.
+ */
+static int watch_create(ami_device *dev)
+{
+	struct ami_sensor_watcher *w = NULL;
+	struct ami_sensor_list *list = NULL;
+	struct ami_sensor *sensor = NULL;
+	pthread_condattr_t attr;
+	int n = 0;
+
+	if (!dev || dev->watcher)
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+	list = __atomic_load_n(&dev->sensor_list, __ATOMIC_ACQUIRE);
+
+	if (!list)
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+	w = (struct ami_sensor_watcher*)calloc(1, sizeof(struct ami_sensor_watcher));
+
+	if (!w)
+		return AMI_API_ERROR(AMI_ERROR_ENOMEM);
+
+	w->data = (struct ami_sensor_data**)calloc(
+		list->num_total_sensors, sizeof(struct ami_sensor_data*));
+	w->owner = (struct ami_sensor**)calloc(
+		list->num_total_sensors, sizeof(struct ami_sensor*));
+
+	if (!w->data || !w->owner) {
+		free(w->data);
+		free(w->owner);
+		free(w);
+		return AMI_API_ERROR(AMI_ERROR_ENOMEM);
+	}
+
+	for (sensor = list->head; sensor; sensor = sensor->next) {
+		struct ami_sensor_data *types[AMI_SENSOR_TYPE_MAX] = {
+			sensor->sensor_data->temp,
+			sensor->sensor_data->current,
+			sensor->sensor_data->voltage,
+			sensor->sensor_data->power,
+		};
+		int i = 0;
+
+		for (i = 0; (i < AMI_SENSOR_TYPE_MAX) && (n < list->num_total_sensors); i++) {
+			if (!types[i])
+				continue;
+
+			w->data[n] = types[i];
+			w->owner[n] = sensor;
+			n++;
+		}
+	}
+
+	w->dev = dev;
+	w->num_data = n;
+	w->next_id = 1;
+
+	/* Timed waits are measured against the monotonic clock. */
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&w->wake, &attr);
+	pthread_condattr_destroy(&attr);
+	pthread_mutex_init(&w->lock, NULL);
+
+	dev->watcher = w;
+	return AMI_STATUS_OK;
+}
+
+/*
+ * Free a watcher context.
+ */
+static void watch_destroy(struct ami_sensor_watcher *w)
+{
+	struct ami_sensor_watch_sub *sub = NULL;
+
+	if (!w)
+		return;
+
+	while (w->subs) {
+		sub = w->subs;
+		w->subs = sub->next;
+		watch_free_sub(sub);
+	}
+
+	pthread_cond_destroy(&w->wake);
+	pthread_mutex_destroy(&w->lock);
+	free(w->data);
+	free(w->owner);
+	free(w);
+}
+
+/*
+ * Free a subscription.
+ */
+static void watch_free_sub(struct ami_sensor_watch_sub *sub)
+{
+	if (sub) {
+		free(sub->deadband);
+		free(sub->last_value);
+		free(sub->last_status);
+		free(sub->reported);
+		free(sub);
+	}
+}
+
+/*
+ * Sample sensors and notify subscribers.
+ */
+static void watch_sample(struct ami_sensor_watcher *w, uint64_t now)
+{
+	ami_device *dev = w->dev;
+	struct ami_sensor_watch_sub *sub = NULL;
+	int i = 0;
+
+	for (i = 0; i < w->num_data; i++) {
+		struct ami_sensor_data *data = w->data[i];
+		/* Sample into local copies so that getters are not disturbed. */
+		struct ami_sensor_attr value = data->value;
+		struct ami_sensor_attr status = data->status;
+		enum ami_sensor_status cur_status = AMI_SENSOR_STATUS_INVALID;
+		bool wanted = false;
+		bool fresh = false;
+
+		for (sub = w->subs; sub; sub = sub->next) {
+			if ((sub->next_due_ms <= now) && (sub->deadband[i] >= 0)) {
+				wanted = true;
+				break;
+			}
+		}
+
+		if (!wanted)
+			continue;
+
+		if (get_single_sensor_val(dev, data->type, data->sid,
+				&value, &status, &fresh) != AMI_STATUS_OK)
+			continue;
+
+		cur_status = parse_sensor_status(status.value_s);
+
+		if ((cur_status == AMI_SENSOR_STATUS_OK) && !fresh)
+			cur_status = AMI_SENSOR_STATUS_OK_CACHED;
+
+		for (sub = w->subs; sub; sub = sub->next) {
+			enum ami_sensor_status a = cur_status;
+			enum ami_sensor_status b = sub->last_status[i];
+			long delta = value.value_l - sub->last_value[i];
+
+			if ((sub->next_due_ms > now) || (sub->deadband[i] < 0))
+				continue;
+
+			if (a == AMI_SENSOR_STATUS_OK_CACHED)
+				a = AMI_SENSOR_STATUS_OK;
+
+			if (b == AMI_SENSOR_STATUS_OK_CACHED)
+				b = AMI_SENSOR_STATUS_OK;
+
+			if (delta < 0)
+				delta = -delta;
+
+			if (!sub->reported[i] || (a != b) || (delta > sub->deadband[i])) {
+				struct ami_sensor_event event = {
+					.sensor_name = w->owner[i]->name,
+					.type = data->type,
+					.value = value.value_l,
+					.prev_value = sub->last_value[i],
+					.status = cur_status,
+					.prev_status = sub->last_status[i],
+				};
+
+				sub->reported[i] = true;
+				sub->last_value[i] = value.value_l;
+				sub->last_status[i] = cur_status;
+				sub->callback(dev, &event, sub->data);
+			}
+		}
+	}
+
+	/* Schedule the next sample for every subscription that was serviced. */
+	for (sub = w->subs; sub; sub = sub->next) {
+		if (sub->next_due_ms <= now)
+			sub->next_due_ms = now + sub->interval_ms;
+	}
+}
+
+/*
+ * Sampling thread.
+ */
+static void *watch_thread(void *data)
+{
+	struct ami_sensor_watcher *w = (struct ami_sensor_watcher*)data;
+
+	if (!w)
+		return NULL;
+
+	pthread_mutex_lock(&w->lock);
+
+	while (!w->quit) {
+		struct ami_sensor_watch_sub *sub = NULL;
+		uint64_t now = watch_now_ms();
+		uint64_t wake = UINT64_MAX;
+		bool due = false;
+
+		for (sub = w->subs; sub; sub = sub->next) {
+			if (sub->next_due_ms <= now)
+				due = true;
+			else if (sub->next_due_ms < wake)
+				wake = sub->next_due_ms;
+		}
+
+		if (due) {
+			watch_sample(w, now);
+			continue;
+		}
+
+		if (wake == UINT64_MAX) {
+			pthread_cond_wait(&w->wake, &w->lock);
+		} else {
+			struct timespec ts = {
+				.tv_sec = wake / WATCH_MS_PER_SEC,
+				.tv_nsec = (wake % WATCH_MS_PER_SEC) * WATCH_NS_PER_MS,
+			};
+
+			pthread_cond_timedwait(&w->wake, &w->lock, &ts);
+		}
+	}
+
+	pthread_mutex_unlock(&w->lock);
+	return NULL;
+}
+
+/*****************************************************************************/
+/* Private API function definitions                                          */
+/*****************************************************************************/
+
+/*
+ * Stop watching a device.
+ */
+void ami_sensor_watch_stop(ami_device *dev)
+{
+	struct ami_sensor_watcher *w = NULL;
+
+	if (!dev)
+		return;
+
+	pthread_mutex_lock(&dev->watch_lock);
+	w = dev->watcher;
+	dev->watcher = NULL;
+	pthread_mutex_unlock(&dev->watch_lock);
+
+	if (!w)
+		return;
+
+	pthread_mutex_lock(&w->lock);
+	w->quit = true;
+	pthread_cond_signal(&w->wake);
+	pthread_mutex_unlock(&w->lock);
+
+	pthread_join(w->thread, NULL);
+	watch_destroy(w);
+}
+
 /*****************************************************************************/
 /* Public API function definitions                                           */
 /*****************************************************************************/
@@ -834,7 +1223,14 @@ int ami_sensor_discover(ami_device *dev)
 	struct ami_sensor_data *sensors_tail = NULL;
 	char hwmon_sensors[AMI_HWMON_PATH_MAX_SIZE] = { 0 };
 
-	if (!dev)
+	/* Built privately and published in one go once complete. */
+	struct ami_sensor *top = NULL;
+	struct ami_sensor_list *list = NULL;
+	struct ami_sensor_list *expected = NULL;
+	int num_top = 0;
+	int num_total = 0;
+
+	if (!dev || __atomic_load_n(&dev->sensor_list, __ATOMIC_ACQUIRE))
 		return AMI_API_ERROR(AMI_ERROR_EINVAL);
 
 	snprintf(
@@ -917,7 +1313,7 @@ int ami_sensor_discover(ami_device *dev)
 				sensors_tail = data;
 			}
 
-			dev->num_total_sensors++;
+			num_total++;
 		}
 
 		switch (attr) {
@@ -984,12 +1380,204 @@ int ami_sensor_discover(ami_device *dev)
 
 	globfree(&glb);
 
-	if (ret == AMI_STATUS_OK)
-		return populate_device_sensors(dev, sensors);
+	if (ret == AMI_STATUS_OK) {
+		ret = populate_device_sensors(&top, &num_top, sensors);
+	} else {
+		while (sensors) {
+			data = sensors->next;
+			free(sensors);
+			sensors = data;
+		}
+	}
+
+	if (ret == AMI_STATUS_OK) {
+		list = (struct ami_sensor_list*)malloc(sizeof(struct ami_sensor_list));
+
+		if (!list)
+			ret = AMI_API_ERROR(AMI_ERROR_ENOMEM);
+	}
+
+	if (ret != AMI_STATUS_OK) {
+		free_sensors(top);
+		return ret;
+	}
+
+	list->head = top;
+	list->num_sensors = num_top;
+	list->num_total_sensors = num_total;
+
+	/*
+	 * The sensor list is immutable once published, so readers on other
+	 * threads never need to take a lock. The counts live in the same
+	 * allocation as the list, so they are published (or discarded) with
+	 * it. If another thread discovered the same sensors first, keep its
+	 * list and discard ours.
+	 */
+	if (!__atomic_compare_exchange_n(&dev->sensor_list, &expected, list, false,
+			__ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+		free_sensors(list->head);
+		free(list);
+	}
+
+	return AMI_STATUS_OK;
+}
+
+/*
+ * Subscribe to sensor changes.
+ */
+int ami_sensor_watch(ami_device *dev, const struct ami_sensor_watch_cfg *cfg,
+	int *watch_id)
+{
+	int ret = AMI_STATUS_ERROR;
+	struct ami_sensor_watcher *w = NULL;
+	struct ami_sensor_watch_sub *sub = NULL;
+	bool new_watcher = false;
+	int i = 0;
+	int j = 0;
+
+	if (!dev || !cfg || !cfg->callback || (cfg->interval_ms == 0) || !watch_id ||
+			((cfg->num_deadbands > 0) && !cfg->deadbands))
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
 
+	if (!__atomic_load_n(&dev->sensor_list, __ATOMIC_ACQUIRE))
+		return AMI_API_ERROR_M(AMI_ERROR_EINVAL, "sensors not discovered");
+
+	/* Open the cdev here so the sampling thread never races to do so. */
+	if (ami_open_cdev(dev) != AMI_STATUS_OK)
+		return AMI_STATUS_ERROR;
+
+	pthread_mutex_lock(&dev->watch_lock);
+
+	if (!dev->watcher) {
+		if (watch_create(dev) != AMI_STATUS_OK)
+			goto unlock;
+
+		new_watcher = true;
+	}
+
+	w = dev->watcher;
+	sub = (struct ami_sensor_watch_sub*)calloc(1, sizeof(struct ami_sensor_watch_sub));
+
+	if (sub) {
+		sub->deadband = (long*)calloc(w->num_data, sizeof(long));
+		sub->last_value = (long*)calloc(w->num_data, sizeof(long));
+		sub->last_status = (enum ami_sensor_status*)calloc(
+			w->num_data, sizeof(enum ami_sensor_status));
+		sub->reported = (bool*)calloc(w->num_data, sizeof(bool));
+	}
+
+	if (!sub || !sub->deadband || !sub->last_value || !sub->last_status || !sub->reported) {
+		watch_free_sub(sub);
+		ret = AMI_API_ERROR(AMI_ERROR_ENOMEM);
+		goto fail;
+	}
+
+	sub->interval_ms = cfg->interval_ms;
+	sub->callback = cfg->callback;
+	sub->data = cfg->data;
+
+	/* Resolve deadbands up front; the last matching override wins. */
+	for (i = 0; i < w->num_data; i++) {
+		sub->deadband[i] = cfg->default_deadband;
+		sub->last_status[i] = AMI_SENSOR_STATUS_INVALID;
+
+		for (j = 0; j < cfg->num_deadbands; j++) {
+			const struct ami_sensor_deadband *db = &cfg->deadbands[j];
+
+			if ((!db->sensor_name || (strcmp(db->sensor_name, w->owner[i]->name) == 0)) &&
+					(!db->type || (db->type & w->data[i]->type)))
+				sub->deadband[i] = db->deadband;
+		}
+	}
+
+	if (new_watcher) {
+		sub->id = w->next_id++;
+		w->subs = sub;
+
+		if (pthread_create(&w->thread, NULL, watch_thread, (void*)w)) {
+			ret = AMI_API_ERROR(AMI_ERROR_ERET);
+			goto fail;
+		}
+	} else {
+		pthread_mutex_lock(&w->lock);
+		sub->id = w->next_id++;
+		sub->next = w->subs;
+		w->subs = sub;
+		pthread_cond_signal(&w->wake);
+		pthread_mutex_unlock(&w->lock);
+	}
+
+	*watch_id = sub->id;
+	ret = AMI_STATUS_OK;
+	goto unlock;
+
+fail:
+	if (new_watcher) {
+		dev->watcher = NULL;
+		watch_destroy(w);
+	}
+
+unlock:
+	pthread_mutex_unlock(&dev->watch_lock);
 	return ret;
 }
 
+/*
+ * Remove a sensor subscription.
+ */
+int ami_sensor_unwatch(ami_device *dev, int watch_id)
+{
+	struct ami_sensor_watcher *w = NULL;
+	struct ami_sensor_watch_sub **prev = NULL;
+	struct ami_sensor_watch_sub *sub = NULL;
+	bool last = false;
+
+	if (!dev)
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+	pthread_mutex_lock(&dev->watch_lock);
+	w = dev->watcher;
+
+	if (w) {
+		pthread_mutex_lock(&w->lock);
+
+		for (prev = &w->subs; *prev; prev = &(*prev)->next) {
+			if ((*prev)->id == watch_id) {
+				sub = *prev;
+				*prev = sub->next;
+				break;
+			}
+		}
+
+		last = (w->subs == NULL);
+
+		/*
+		 * Stop the thread along with the last subscription. This is decided
+		 * and done under `watch_lock` so a concurrent `ami_sensor_watch`
+		 * either lands before this point or starts a fresh watcher.
+		 */
+		if (last)
+			w->quit = true;
+
+		pthread_cond_signal(&w->wake);
+		pthread_mutex_unlock(&w->lock);
+
+		if (last) {
+			pthread_join(w->thread, NULL);
+			dev->watcher = NULL;
+			watch_destroy(w);
+		}
+	}
+
+	pthread_mutex_unlock(&dev->watch_lock);
+
+	if (!sub)
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+	watch_free_sub(sub);
+	return AMI_STATUS_OK;
+}
+
 /*
  * Set the sensor refresh timeout.
  */
@@ -1084,20 +1672,28 @@ int ami_sensor_get_type(ami_device *dev, const char *sensor_name, uint32_t *type
  */
 int ami_sensor_get_sensors(ami_device *dev, struct ami_sensor **sensors, int *num)
 {
+	struct ami_sensor_list *list = NULL;
+
 	if (!dev || !sensors || *sensors || !num)
 		return AMI_API_ERROR(AMI_ERROR_EINVAL);
 
-	*sensors = dev->sensors;
-	*num = dev->num_sensors;
+	list = __atomic_load_n(&dev->sensor_list, __ATOMIC_ACQUIRE);
+
+	*sensors = (list) ? (list->head) : (NULL);
+	*num = (list) ? (list->num_sensors) : (0);
 	return AMI_STATUS_OK;
 }
 
 int ami_sensor_get_num_total(ami_device *dev, int *num)
 {
+	struct ami_sensor_list *list = NULL;
+
 	if (!dev || !num)
 		return AMI_API_ERROR(AMI_ERROR_EINVAL);
 
-	*num = dev->num_total_sensors;
+	list = __atomic_load_n(&dev->sensor_list, __ATOMIC_ACQUIRE);
+
+	*num = (list) ? (list->num_total_sensors) : (0);
 	return AMI_STATUS_OK;
 }
 
@@ -137,4 +137,73 @@ struct ami_sensor_internal {
 	struct ami_sensor_data *power;
 };
 
+/**
+ * struct ami_sensor_watch_sub - A single `ami_sensor_watch` subscription.
+ * @id: subscription identifier
+ * @interval_ms: sampling interval
+ * @next_due_ms: monotonic time (in ms) at which the next sample is due
+ * @callback: user callback
+ * @data: user callback data
+ * @deadband: resolved deadband per watched sensor (negative to ignore)
+ * @last_value: last reported value per watched sensor
+ * @last_status: last reported status per watched sensor
+ * @reported: whether an initial event has been reported per watched sensor
+ * @next: pointer to next subscription
+ *
+ * The per sensor arrays are indexed in the same order as the `data` array
+ * of the owning `struct ami_sensor_watcher`.
+ */
+struct ami_sensor_watch_sub {
+	int                             id;
+	uint32_t                        interval_ms;
+	uint64_t                        next_due_ms;
+	ami_sensor_watch_handler        callback;
+	void                           *data;
+	long                           *deadband;
+	long                           *last_value;
+	enum ami_sensor_status         *last_status;
+	bool                           *reported;
+	struct ami_sensor_watch_sub    *next;
+};
+
+/**
+ * struct ami_sensor_watcher - Per device sensor sampling thread.
+ * @lock: protects all fields below (held while sampling and in callbacks)
+ * @wake: used to wake the thread early when subscriptions change
+ * @thread: sampling thread
+ * @quit: boolean indicating if the thread should stop
+ * @dev: device being watched
+ * @next_id: next subscription identifier to hand out
+ * @num_data: number of entries in `data` and `owner`
+ * @data: flat list of every sensor data struct belonging to the device
+ * @owner: top level sensor for each entry in `data`
+ * @subs: list of subscriptions (head)
+ */
+struct ami_sensor_watcher {
+	pthread_mutex_t                 lock;
+	pthread_cond_t                  wake;
+	pthread_t                       thread;
+	bool                            quit;
+	ami_device                     *dev;
+	int                             next_id;
+	int                             num_data;
+	struct ami_sensor_data        **data;
+	struct ami_sensor             **owner;
+	struct ami_sensor_watch_sub    *subs;
+};
+
+/*****************************************************************************/
+/* Private API function declarations                                         */
+/*****************************************************************************/
+
+/**
+ * ami_sensor_watch_stop() - Stop the sampling thread and drop all subscriptions.
+ * @dev: Device handle.
+ *
+ * This is a no-op if the device is not being watched.
+ *
+ * Return: None
+ */
+void ami_sensor_watch_stop(ami_device *dev);
+
 #endif  /* AMI_SENSOR_INTERNAL_H */
@@ -15,6 +15,7 @@
 #include <stdbool.h>
 #include <string.h>
 #include <unistd.h>
+#include <sys/stat.h>
 
 /* External includes */
 #include "cmocka.h"
@@ -45,6 +46,7 @@ static struct wrapper w_close  = { REAL, REAL, 0, 0 };
 static struct wrapper w_open   = { REAL, REAL, 0, 0 };
 static struct wrapper w_read   = { REAL, REAL, 0, 0 };
 static struct wrapper w_write  = { REAL, REAL, 0, 0 };
+static struct wrapper w_stat   = { REAL, REAL, 0, 0 };
 
 /*****************************************************************************/
 /* Redefinitions/Wrapping                                                    */
@@ -69,31 +71,43 @@ uint16_t __wrap_ami_parse_bdf(const char *bdf)
 	return (uint16_t)mock();
 }
 
+void __wrap_ami_sensor_watch_stop(ami_device *dev)
+{
+	return;
+}
+
+int __wrap_ami_module_cache_invalidate(ami_device *dev, uint8_t device_id)
+{
+	return AMI_STATUS_OK;
+}
+
 int __wrap_ami_sensor_discover(ami_device *dev)
 {
 	function_called();
 
 	if ((int)mock() == AMI_STATUS_OK) {
 		/* Create dummy data */
-		dev->num_sensors = 1;
-		dev->num_total_sensors = 4;
+		struct ami_sensor *sensors = malloc(sizeof(struct ami_sensor));
 
-		dev->sensors = malloc(sizeof(struct ami_sensor));
+		dev->sensor_list = malloc(sizeof(struct ami_sensor_list));
+		dev->sensor_list->head = sensors;
+		dev->sensor_list->num_sensors = 1;
+		dev->sensor_list->num_total_sensors = 4;
 
-		dev->sensors[0].next = NULL;
-		dev->sensors[0].sensor_data = malloc(sizeof(struct ami_sensor_internal));
+		sensors[0].next = NULL;
+		sensors[0].sensor_data = malloc(sizeof(struct ami_sensor_internal));
 
-		dev->sensors[0].sensor_data->temp = malloc(sizeof(struct ami_sensor_data));
-		dev->sensors[0].sensor_data->temp->next = NULL;
+		sensors[0].sensor_data->temp = malloc(sizeof(struct ami_sensor_data));
+		sensors[0].sensor_data->temp->next = NULL;
 
-		dev->sensors[0].sensor_data->power = malloc(sizeof(struct ami_sensor_data));
-		dev->sensors[0].sensor_data->power->next = NULL;
+		sensors[0].sensor_data->power = malloc(sizeof(struct ami_sensor_data));
+		sensors[0].sensor_data->power->next = NULL;
 
-		dev->sensors[0].sensor_data->current = malloc(sizeof(struct ami_sensor_data));
-		dev->sensors[0].sensor_data->current->next = NULL;
+		sensors[0].sensor_data->current = malloc(sizeof(struct ami_sensor_data));
+		sensors[0].sensor_data->current->next = NULL;
 
-		dev->sensors[0].sensor_data->voltage = malloc(sizeof(struct ami_sensor_data));
-		dev->sensors[0].sensor_data->voltage->next = NULL;
+		sensors[0].sensor_data->voltage = malloc(sizeof(struct ami_sensor_data));
+		sensors[0].sensor_data->voltage->next = NULL;
 
 		return AMI_STATUS_OK;
 	}
@@ -285,6 +299,33 @@ ssize_t __wrap_write(int fildes, const void *buf, size_t nbyte)
 	return ret;
 }
 
+extern int __real_stat(const char *path, struct stat *buf);
+
+int __wrap_stat(const char *path, struct stat *buf)
+{
+	int ret = AMI_LINUX_STATUS_ERROR;
+
+	switch (w_stat.current) {
+	case OK:
+		/* Must use `will_return` to supply the modification time */
+		memset(buf, 0, sizeof(struct stat));
+		buf->st_ino = 1;
+		buf->st_mtim.tv_sec = (time_t)mock();
+		ret = AMI_LINUX_STATUS_OK;
+		break;
+
+	case REAL:
+		ret = __real_stat(path, buf);
+		break;
+
+	default:
+		break;
+	}
+
+	WRAPPER_DONE(stat);
+	return ret;
+}
+
 ssize_t __wrap_getline(char **restrict lineptr, size_t *restrict n,
 	FILE *restrict stream)
 {
@@ -534,6 +575,201 @@ void test_fail_ami_dev_find_next(void **state)
 	assert_null(dev);
 }
 
+void test_happy_ami_dev_enumerate_all(void **state)
+{
+	ami_device **devs = NULL;
+	int num = 0;
+
+	/* Happy path - single device with sensors */
+	expect_function_call(__wrap_ami_sensor_discover);
+	will_return(__wrap_ami_sensor_discover, AMI_STATUS_OK);
+	will_return(__wrap_getline, "1");
+	will_return(__wrap_getline, "c1:00.0 1 2");
+	will_return(__wrap_getline, "EOF");
+	will_return(__wrap_ami_get_driver_version, GIT_TAG_VER_MAJOR);
+	will_return(__wrap_ami_get_driver_version, GIT_TAG_VER_MINOR);
+	will_return(__wrap_ami_get_driver_version, AMI_STATUS_OK);
+	assert_int_equal(
+		ami_dev_enumerate_all(&devs, &num, true),
+		AMI_STATUS_OK
+	);
+	assert_non_null(devs);
+	assert_int_equal(num, 1);
+	assert_int_equal(devs[0]->cdev_num, 1);
+	assert_int_equal(devs[0]->hwmon_num, 2);
+	assert_int_equal(devs[0]->bdf, AMI_MK_BDF(0xC1, 0x00, 0x00));
+	assert_non_null(devs[0]->sensor_list);
+
+	ami_dev_delete_all(&devs, num);
+	assert_null(devs);
+}
+
+void test_fail_ami_dev_enumerate_all(void **state)
+{
+	ami_device **devs = NULL;
+	int num = 0;
+
+	/* Failure path - invalid arguments */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_dev_enumerate_all(NULL, &num, false),
+		AMI_STATUS_ERROR
+	);
+
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_dev_enumerate_all(&devs, NULL, false),
+		AMI_STATUS_ERROR
+	);
+
+	/* Failure path - no devices */
+	will_return(__wrap_getline, "0");
+	will_return(__wrap_getline, "EOF");
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_ENODEV);
+	will_return(__wrap_ami_get_driver_version, GIT_TAG_VER_MAJOR);
+	will_return(__wrap_ami_get_driver_version, GIT_TAG_VER_MINOR);
+	will_return(__wrap_ami_get_driver_version, AMI_STATUS_OK);
+	assert_int_equal(
+		ami_dev_enumerate_all(&devs, &num, false),
+		AMI_STATUS_ERROR
+	);
+	assert_null(devs);
+
+	/* Failure path - bad devices file format */
+	will_return(__wrap_getline, "1");
+	will_return(__wrap_getline, "invalid");
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EFMT);
+	will_return(__wrap_ami_get_driver_version, GIT_TAG_VER_MAJOR);
+	will_return(__wrap_ami_get_driver_version, GIT_TAG_VER_MINOR);
+	will_return(__wrap_ami_get_driver_version, AMI_STATUS_OK);
+	assert_int_equal(
+		ami_dev_enumerate_all(&devs, &num, false),
+		AMI_STATUS_ERROR
+	);
+	assert_null(devs);
+
+	/* Failure path - driver version mismatch */
+	will_return(__wrap_ami_get_driver_version, 99);
+	will_return(__wrap_ami_get_driver_version, GIT_TAG_VER_MINOR);
+	will_return(__wrap_ami_get_driver_version, AMI_STATUS_OK);
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EVER);
+	assert_int_equal(
+		ami_dev_enumerate_all(&devs, &num, false),
+		AMI_STATUS_ERROR
+	);
+	assert_null(devs);
+}
+
+/*
+ * NOTE: The devices map cache is process wide. Lookups which should be served
+ * from the cache queue no `getline` or driver version mocks, so falling back
+ * to the devices file would fail the test.
+ */
+
+void test_happy_ami_dev_map_cache(void **state)
+{
+	ami_device *dev = NULL;
+	ami_device **devs = NULL;
+	int num = 0;
+
+	/* Happy path - first lookup reads the devices file and fills the cache */
+	WRAPPER_ACTION(OK, stat);
+	will_return(__wrap_stat, 100);
+	will_return(__wrap_ami_get_driver_version, GIT_TAG_VER_MAJOR);
+	will_return(__wrap_ami_get_driver_version, GIT_TAG_VER_MINOR);
+	will_return(__wrap_ami_get_driver_version, AMI_STATUS_OK);
+	will_return(__wrap_getline, "2");
+	will_return(__wrap_getline, "c1:00.0 1 2");
+	will_return(__wrap_getline, "c2:00.0 3 4");
+	will_return(__wrap_getline, "EOF");
+	WRAPPER_ACTION(OK, open);
+	will_return(__wrap_ioctl, AMI_LINUX_STATUS_OK);
+	assert_int_equal(
+		ami_dev_find_next(&dev, 0xC1, AMI_ANY_DEV, AMI_ANY_DEV, NULL),
+		AMI_STATUS_OK
+	);
+	assert_non_null(dev);
+	assert_int_equal(dev->bdf, AMI_MK_BDF(0xC1, 0x00, 0x00));
+
+	WRAPPER_ACTION(OK, close);
+	will_return(__wrap_ioctl, AMI_LINUX_STATUS_OK);
+	ami_dev_delete(&dev);
+
+	/* Happy path - unchanged devices file is served from the cache */
+	WRAPPER_ACTION(OK, stat);
+	will_return(__wrap_stat, 100);
+	WRAPPER_ACTION(OK, open);
+	will_return(__wrap_ioctl, AMI_LINUX_STATUS_OK);
+	assert_int_equal(
+		ami_dev_find_next(&dev, 0xC2, AMI_ANY_DEV, AMI_ANY_DEV, NULL),
+		AMI_STATUS_OK
+	);
+	assert_non_null(dev);
+	assert_int_equal(dev->cdev_num, 3);
+	assert_int_equal(dev->hwmon_num, 4);
+	assert_int_equal(dev->bdf, AMI_MK_BDF(0xC2, 0x00, 0x00));
+
+	WRAPPER_ACTION(OK, close);
+	will_return(__wrap_ioctl, AMI_LINUX_STATUS_OK);
+	ami_dev_delete(&dev);
+
+	/* Happy path - a stale entry is not served once the devices file changes */
+	WRAPPER_ACTION(OK, stat);
+	will_return(__wrap_stat, 200);
+	will_return(__wrap_ami_get_driver_version, GIT_TAG_VER_MAJOR);
+	will_return(__wrap_ami_get_driver_version, GIT_TAG_VER_MINOR);
+	will_return(__wrap_ami_get_driver_version, AMI_STATUS_OK);
+	will_return(__wrap_getline, "1");
+	will_return(__wrap_getline, "c3:00.0 5 6");
+	will_return(__wrap_getline, "EOF");
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_ENODEV);
+	assert_int_equal(
+		ami_dev_find_next(&dev, 0xC1, AMI_ANY_DEV, AMI_ANY_DEV, NULL),
+		AMI_STATUS_ERROR
+	);
+	assert_null(dev);
+
+	/* Happy path - enumeration is served from the refreshed cache */
+	WRAPPER_ACTION(OK, stat);
+	will_return(__wrap_stat, 200);
+	WRAPPER_ACTION(OK, open);
+	will_return(__wrap_ioctl, AMI_LINUX_STATUS_OK);
+	assert_int_equal(
+		ami_dev_enumerate_all(&devs, &num, false),
+		AMI_STATUS_OK
+	);
+	assert_non_null(devs);
+	assert_int_equal(num, 1);
+	assert_int_equal(devs[0]->cdev_num, 5);
+	assert_int_equal(devs[0]->hwmon_num, 6);
+	assert_int_equal(devs[0]->bdf, AMI_MK_BDF(0xC3, 0x00, 0x00));
+
+	WRAPPER_ACTION(OK, close);
+	will_return(__wrap_ioctl, AMI_LINUX_STATUS_OK);
+	ami_dev_delete_all(&devs, num);
+	assert_null(devs);
+
+	/* Failure path - devices file gone, the cached map is not used */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EBADF);
+	WRAPPER_ACTION(FAIL, stat);
+	WRAPPER_ACTION(FAIL, fopen);
+	will_return(__wrap_ami_get_driver_version, GIT_TAG_VER_MAJOR);
+	will_return(__wrap_ami_get_driver_version, GIT_TAG_VER_MINOR);
+	will_return(__wrap_ami_get_driver_version, AMI_STATUS_OK);
+	assert_int_equal(
+		ami_dev_find_next(&dev, 0xC3, AMI_ANY_DEV, AMI_ANY_DEV, NULL),
+		AMI_STATUS_ERROR
+	);
+	assert_null(dev);
+}
+
 void test_happy_ami_dev_find(void **state)
 {
 	ami_device *dev = NULL;
@@ -569,6 +805,58 @@ void test_fail_ami_dev_find(void **state)
 	assert_null(dev);
 }
 
+void test_happy_ami_dev_ref(void **state)
+{
+	ami_device *dev = NULL;
+	ami_device *ref = NULL;
+
+	WRAPPER_ACTION(OK, open);
+	will_return(__wrap_getline, "1");
+	will_return(__wrap_getline, "c1:00.0 1 2");
+	will_return(__wrap_ami_get_driver_version, GIT_TAG_VER_MAJOR);
+	will_return(__wrap_ami_get_driver_version, GIT_TAG_VER_MINOR);
+	will_return(__wrap_ami_get_driver_version, AMI_STATUS_OK);
+	will_return(__wrap_ioctl, AMI_LINUX_STATUS_OK);
+	assert_int_equal(
+		ami_dev_find_next(&dev, 0xC1, 0x00, 0x00, NULL),
+		AMI_STATUS_OK
+	);
+	assert_non_null(dev);
+	assert_int_equal(dev->refcount, 1);
+
+	/* Happy path - an extra reference keeps the handle alive */
+	assert_int_equal(ami_dev_ref(dev), AMI_STATUS_OK);
+	assert_int_equal(dev->refcount, 2);
+
+	ref = dev;
+	ami_dev_delete(&dev);
+	assert_null(dev);
+	assert_int_equal(ref->refcount, 1);
+	assert_int_equal(ref->bdf, AMI_MK_BDF(0xC1, 0x00, 0x00));
+	assert_int_not_equal(ref->cdev, AMI_INVALID_FD);
+
+	/* Happy path - the last reference deregisters and frees the handle */
+	WRAPPER_ACTION(OK, close);
+	will_return(__wrap_ioctl, AMI_LINUX_STATUS_OK);
+	ami_dev_delete(&ref);
+	assert_null(ref);
+
+	/* Happy path - nothing to delete */
+	ami_dev_delete(&ref);
+	ami_dev_delete(NULL);
+}
+
+void test_fail_ami_dev_ref(void **state)
+{
+	/* Failure path - invalid `dev` argument */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_dev_ref(NULL),
+		AMI_STATUS_ERROR
+	);
+}
+
 void test_happy_ami_dev_bringup(void **state)
 {
 	ami_device *dev = NULL;
@@ -1829,8 +2117,13 @@ int main(void)
 	const struct CMUnitTest tests[] = {
 		cmocka_unit_test(test_happy_ami_dev_find_next),
 		cmocka_unit_test(test_fail_ami_dev_find_next),
+		cmocka_unit_test(test_happy_ami_dev_enumerate_all),
+		cmocka_unit_test(test_fail_ami_dev_enumerate_all),
+		cmocka_unit_test(test_happy_ami_dev_map_cache),
 		cmocka_unit_test(test_happy_ami_dev_find),
 		cmocka_unit_test(test_fail_ami_dev_find),
+		cmocka_unit_test(test_happy_ami_dev_ref),
+		cmocka_unit_test(test_fail_ami_dev_ref),
 		cmocka_unit_test(test_happy_ami_dev_bringup),
 		cmocka_unit_test(test_fail_ami_dev_bringup),
 		cmocka_unit_test(test_happy_ami_dev_request_access),
@@ -0,0 +1,226 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * test_ami_eeprom_access.c - Unit test file for ami_eeprom_access.c
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+/* Standard includes */
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+
+/* External includes */
+#include "cmocka.h"
+
+/* AMI API includes */
+#include "ami_ioctl.h"
+#include "ami_internal.h"
+#include "ami_device_internal.h"
+#include "ami_eeprom_access.h"
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+/* Must match the transfer size used by ami_eeprom_access.c */
+#define EEPROM_CHUNK_SIZE	(128)
+
+/*****************************************************************************/
+/* Redefinitions/Wrapping                                                    */
+/*****************************************************************************/
+
+int __wrap_ami_set_last_error(enum ami_error err, const char *ctxt, ...)
+{
+	check_expected(err);
+	function_called();
+	return AMI_STATUS_OK;
+}
+
+int __wrap_ami_open_cdev(ami_device *dev)
+{
+	return (int)mock();
+}
+
+extern int __real_ioctl(int fd, unsigned long request, ...);
+
+/*
+ * A successful read also consumes the byte to fill the user buffer with.
+ */
+int __wrap_ioctl(int fd, unsigned long request, ...)
+{
+	int ret = (int)mock();
+
+	if ((ret == AMI_LINUX_STATUS_OK) && (request == AMI_IOC_READ_EEPROM)) {
+		struct ami_ioc_eeprom_payload *data = NULL;
+		va_list args;
+
+		va_start(args, request);
+		data = va_arg(args, struct ami_ioc_eeprom_payload*);
+		va_end(args);
+
+		memset((void*)data->addr, (int)mock(), data->len);
+	}
+
+	return ret;
+}
+
+/*****************************************************************************/
+/* Local functions                                                           */
+/*****************************************************************************/
+
+/*
+ * Queue the mocks for a full EEPROM read returning `fill` in every byte.
+ */
+static void expect_eeprom_read_all(int fill)
+{
+	int i = 0;
+
+	for (i = 0; i < (AMI_EEPROM_SIZE / EEPROM_CHUNK_SIZE); i++) {
+		will_return(__wrap_ami_open_cdev, AMI_STATUS_OK);
+		will_return(__wrap_ioctl, AMI_LINUX_STATUS_OK);
+		will_return(__wrap_ioctl, fill);
+	}
+}
+
+/*
+ * Check that every byte of an EEPROM sized buffer is `fill`.
+ */
+static void assert_eeprom_buf(const uint8_t *buf, int fill)
+{
+	int i = 0;
+
+	for (i = 0; i < AMI_EEPROM_SIZE; i++)
+		assert_int_equal(buf[i], fill);
+}
+
+/*****************************************************************************/
+/* Tests                                                                     */
+/*****************************************************************************/
+
+void test_happy_ami_eeprom_read_all(void **state)
+{
+	ami_device dev = { 0 };
+	uint8_t buf[AMI_EEPROM_SIZE] = { 0 };
+	uint8_t val = 0;
+
+	pthread_mutex_init(&dev.cache_lock, NULL);
+
+	/* Happy path - uncached read is not kept */
+	expect_eeprom_read_all(0xA5);
+	assert_int_equal(
+		ami_eeprom_read_all(&dev, 0, buf),
+		AMI_STATUS_OK
+	);
+	assert_eeprom_buf(buf, 0xA5);
+	assert_null(dev.eeprom_cache);
+
+	/* Happy path - first cached read goes to the device */
+	expect_eeprom_read_all(0x11);
+	assert_int_equal(
+		ami_eeprom_read_all(&dev, AMI_EEPROM_READ_CACHED, buf),
+		AMI_STATUS_OK
+	);
+	assert_eeprom_buf(buf, 0x11);
+	assert_non_null(dev.eeprom_cache);
+
+	/* Happy path - second cached read is served from the cache */
+	memset(buf, 0, sizeof(buf));
+	assert_int_equal(
+		ami_eeprom_read_all(&dev, AMI_EEPROM_READ_CACHED, buf),
+		AMI_STATUS_OK
+	);
+	assert_eeprom_buf(buf, 0x11);
+
+	/* Happy path - a write invalidates the cache */
+	will_return(__wrap_ami_open_cdev, AMI_STATUS_OK);
+	will_return(__wrap_ioctl, AMI_LINUX_STATUS_OK);
+	assert_int_equal(
+		ami_eeprom_write(&dev, 0, 1, &val),
+		AMI_STATUS_OK
+	);
+	assert_null(dev.eeprom_cache);
+
+	/* Happy path - cached read after invalidation goes to the device */
+	expect_eeprom_read_all(0x33);
+	assert_int_equal(
+		ami_eeprom_read_all(&dev, AMI_EEPROM_READ_CACHED, buf),
+		AMI_STATUS_OK
+	);
+	assert_eeprom_buf(buf, 0x33);
+	assert_non_null(dev.eeprom_cache);
+
+	free(dev.eeprom_cache);
+	pthread_mutex_destroy(&dev.cache_lock);
+}
+
+void test_fail_ami_eeprom_read_all(void **state)
+{
+	ami_device dev = { 0 };
+	uint8_t buf[AMI_EEPROM_SIZE] = { 0 };
+
+	pthread_mutex_init(&dev.cache_lock, NULL);
+
+	/* Failure path - invalid `dev` argument */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_eeprom_read_all(NULL, 0, buf),
+		AMI_STATUS_ERROR
+	);
+
+	/* Failure path - invalid `buf` argument */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_eeprom_read_all(&dev, 0, NULL),
+		AMI_STATUS_ERROR
+	);
+
+	/* Failure path - ami_open_cdev fails */
+	will_return(__wrap_ami_open_cdev, AMI_STATUS_ERROR);
+	assert_int_equal(
+		ami_eeprom_read_all(&dev, AMI_EEPROM_READ_CACHED, buf),
+		AMI_STATUS_ERROR
+	);
+	assert_null(dev.eeprom_cache);
+
+	/* Failure path - a failed read drops the cached copy */
+	expect_eeprom_read_all(0x11);
+	assert_int_equal(
+		ami_eeprom_read_all(&dev, AMI_EEPROM_READ_CACHED, buf),
+		AMI_STATUS_OK
+	);
+	assert_non_null(dev.eeprom_cache);
+
+	will_return(__wrap_ami_open_cdev, AMI_STATUS_OK);
+	will_return(__wrap_ioctl, AMI_LINUX_STATUS_OK);
+	will_return(__wrap_ioctl, 0x22);
+	will_return(__wrap_ami_open_cdev, AMI_STATUS_OK);
+	will_return(__wrap_ioctl, AMI_LINUX_STATUS_ERROR);
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EIO);
+	assert_int_equal(
+		ami_eeprom_read_all(&dev, 0, buf),
+		AMI_STATUS_ERROR
+	);
+	assert_null(dev.eeprom_cache);
+
+	pthread_mutex_destroy(&dev.cache_lock);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_happy_ami_eeprom_read_all),
+		cmocka_unit_test(test_fail_ami_eeprom_read_all),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
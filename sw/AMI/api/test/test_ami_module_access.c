@@ -0,0 +1,318 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * test_ami_module_access.c - Unit test file for ami_module_access.c
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+/* Standard includes */
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+
+/* External includes */
+#include "cmocka.h"
+
+/* AMI API includes */
+#include "ami_ioctl.h"
+#include "ami_internal.h"
+#include "ami_device_internal.h"
+#include "ami_module_access.h"
+
+/*****************************************************************************/
+/* Redefinitions/Wrapping                                                    */
+/*****************************************************************************/
+
+int __wrap_ami_set_last_error(enum ami_error err, const char *ctxt, ...)
+{
+	check_expected(err);
+	function_called();
+	return AMI_STATUS_OK;
+}
+
+int __wrap_ami_open_cdev(ami_device *dev)
+{
+	return (int)mock();
+}
+
+extern int __real_ioctl(int fd, unsigned long request, ...);
+
+/*
+ * A successful read also consumes the byte to fill the user buffer with.
+ */
+int __wrap_ioctl(int fd, unsigned long request, ...)
+{
+	int ret = (int)mock();
+
+	if ((ret == AMI_LINUX_STATUS_OK) && (request == AMI_IOC_READ_MODULE)) {
+		struct ami_ioc_module_payload *data = NULL;
+		va_list args;
+
+		va_start(args, request);
+		data = va_arg(args, struct ami_ioc_module_payload*);
+		va_end(args);
+
+		memset((void*)data->addr, (int)mock(), data->len);
+	}
+
+	return ret;
+}
+
+/*****************************************************************************/
+/* Local functions                                                           */
+/*****************************************************************************/
+
+/*
+ * Queue the mocks for a single page read returning `fill` in every byte.
+ */
+static void expect_page_read(int fill)
+{
+	will_return(__wrap_ami_open_cdev, AMI_STATUS_OK);
+	will_return(__wrap_ioctl, AMI_LINUX_STATUS_OK);
+	will_return(__wrap_ioctl, fill);
+}
+
+/*
+ * Check that every byte of a page sized buffer is `fill`.
+ */
+static void assert_page(const uint8_t *buf, int fill)
+{
+	int i = 0;
+
+	for (i = 0; i < AMI_MODULE_PAGE_SIZE; i++)
+		assert_int_equal(buf[i], fill);
+}
+
+/*****************************************************************************/
+/* Tests                                                                     */
+/*****************************************************************************/
+
+void test_happy_ami_module_read_page(void **state)
+{
+	ami_device dev = { 0 };
+	uint8_t buf[AMI_MODULE_MAP_SIZE] = { 0 };
+
+	pthread_mutex_init(&dev.cache_lock, NULL);
+
+	/* Happy path - upper page only */
+	expect_page_read(0x44);
+	assert_int_equal(
+		ami_module_read_page(&dev, 1, 0, 0, buf),
+		AMI_STATUS_OK
+	);
+	assert_page(buf, 0x44);
+	assert_null(dev.module_cache);
+
+	/* Happy path - lower and upper page */
+	expect_page_read(0x01);
+	expect_page_read(0x02);
+	assert_int_equal(
+		ami_module_read_page(&dev, 1, 0, AMI_MODULE_READ_LOWER, buf),
+		AMI_STATUS_OK
+	);
+	assert_page(buf, 0x01);
+	assert_page(&buf[AMI_MODULE_PAGE_SIZE], 0x02);
+
+	/* Happy path - first cached read goes to the device */
+	expect_page_read(0x55);
+	assert_int_equal(
+		ami_module_read_page(&dev, 1, 3, AMI_MODULE_READ_CACHED, buf),
+		AMI_STATUS_OK
+	);
+	assert_page(buf, 0x55);
+	assert_non_null(dev.module_cache);
+
+	/* Happy path - second cached read is served from the cache */
+	memset(buf, 0, sizeof(buf));
+	assert_int_equal(
+		ami_module_read_page(&dev, 1, 3, AMI_MODULE_READ_CACHED, buf),
+		AMI_STATUS_OK
+	);
+	assert_page(buf, 0x55);
+
+	/* Happy path - lower page is always read from the device */
+	expect_page_read(0x66);
+	assert_int_equal(
+		ami_module_read_page(&dev, 1, 3,
+			AMI_MODULE_READ_LOWER | AMI_MODULE_READ_CACHED, buf),
+		AMI_STATUS_OK
+	);
+	assert_page(buf, 0x66);
+	assert_page(&buf[AMI_MODULE_PAGE_SIZE], 0x55);
+
+	/* Happy path - a write invalidates the module's pages */
+	will_return(__wrap_ami_open_cdev, AMI_STATUS_OK);
+	will_return(__wrap_ioctl, AMI_LINUX_STATUS_OK);
+	assert_int_equal(
+		ami_module_write(&dev, 1, 3, 0, 1, buf),
+		AMI_STATUS_OK
+	);
+	assert_null(dev.module_cache);
+
+	/* Happy path - cached read after a write goes to the device */
+	expect_page_read(0x77);
+	assert_int_equal(
+		ami_module_read_page(&dev, 1, 3, AMI_MODULE_READ_CACHED, buf),
+		AMI_STATUS_OK
+	);
+	assert_page(buf, 0x77);
+
+	assert_int_equal(ami_module_cache_invalidate(&dev, AMI_MODULE_ALL), AMI_STATUS_OK);
+	pthread_mutex_destroy(&dev.cache_lock);
+}
+
+void test_fail_ami_module_read_page(void **state)
+{
+	ami_device dev = { 0 };
+	uint8_t buf[AMI_MODULE_MAP_SIZE] = { 0 };
+
+	pthread_mutex_init(&dev.cache_lock, NULL);
+
+	/* Failure path - invalid `dev` argument */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_module_read_page(NULL, 1, 0, 0, buf),
+		AMI_STATUS_ERROR
+	);
+
+	/* Failure path - invalid `buf` argument */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_module_read_page(&dev, 1, 0, 0, NULL),
+		AMI_STATUS_ERROR
+	);
+
+	/* Failure path - ami_open_cdev fails */
+	will_return(__wrap_ami_open_cdev, AMI_STATUS_ERROR);
+	assert_int_equal(
+		ami_module_read_page(&dev, 1, 0, AMI_MODULE_READ_CACHED, buf),
+		AMI_STATUS_ERROR
+	);
+	assert_null(dev.module_cache);
+
+	/* Failure path - lower page read fails, upper page is not read */
+	will_return(__wrap_ami_open_cdev, AMI_STATUS_OK);
+	will_return(__wrap_ioctl, AMI_LINUX_STATUS_ERROR);
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EIO);
+	assert_int_equal(
+		ami_module_read_page(&dev, 1, 0, AMI_MODULE_READ_LOWER, buf),
+		AMI_STATUS_ERROR
+	);
+
+	/* Failure path - a failed read drops the module's cached pages */
+	expect_page_read(0x11);
+	assert_int_equal(
+		ami_module_read_page(&dev, 1, 3, AMI_MODULE_READ_CACHED, buf),
+		AMI_STATUS_OK
+	);
+	assert_non_null(dev.module_cache);
+
+	will_return(__wrap_ami_open_cdev, AMI_STATUS_OK);
+	will_return(__wrap_ioctl, AMI_LINUX_STATUS_ERROR);
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EIO);
+	assert_int_equal(
+		ami_module_read_page(&dev, 1, 4, AMI_MODULE_READ_CACHED, buf),
+		AMI_STATUS_ERROR
+	);
+	assert_null(dev.module_cache);
+
+	pthread_mutex_destroy(&dev.cache_lock);
+}
+
+void test_happy_ami_module_cache_invalidate(void **state)
+{
+	ami_device dev = { 0 };
+	uint8_t buf[AMI_MODULE_PAGE_SIZE] = { 0 };
+	unsigned int gen = 0;
+
+	pthread_mutex_init(&dev.cache_lock, NULL);
+
+	/* Cache one page for each of two modules */
+	expect_page_read(0x10);
+	assert_int_equal(
+		ami_module_read_page(&dev, 0, 3, AMI_MODULE_READ_CACHED, buf),
+		AMI_STATUS_OK
+	);
+	expect_page_read(0x20);
+	assert_int_equal(
+		ami_module_read_page(&dev, 1, 3, AMI_MODULE_READ_CACHED, buf),
+		AMI_STATUS_OK
+	);
+
+	/* Happy path - only the given module is dropped */
+	gen = dev.cache_gen;
+	assert_int_equal(ami_module_cache_invalidate(&dev, 0), AMI_STATUS_OK);
+	assert_int_not_equal(dev.cache_gen, gen);
+
+	assert_int_equal(
+		ami_module_read_page(&dev, 1, 3, AMI_MODULE_READ_CACHED, buf),
+		AMI_STATUS_OK
+	);
+	assert_page(buf, 0x20);
+
+	/* Happy path - read after invalidation goes to the device */
+	expect_page_read(0x30);
+	assert_int_equal(
+		ami_module_read_page(&dev, 0, 3, AMI_MODULE_READ_CACHED, buf),
+		AMI_STATUS_OK
+	);
+	assert_page(buf, 0x30);
+
+	/* ...and is cached again */
+	assert_int_equal(
+		ami_module_read_page(&dev, 0, 3, AMI_MODULE_READ_CACHED, buf),
+		AMI_STATUS_OK
+	);
+	assert_page(buf, 0x30);
+
+	/* Happy path - every module is dropped */
+	assert_int_equal(ami_module_cache_invalidate(&dev, AMI_MODULE_ALL), AMI_STATUS_OK);
+	assert_null(dev.module_cache);
+
+	expect_page_read(0x40);
+	assert_int_equal(
+		ami_module_read_page(&dev, 1, 3, AMI_MODULE_READ_CACHED, buf),
+		AMI_STATUS_OK
+	);
+	assert_page(buf, 0x40);
+
+	/* Happy path - nothing cached */
+	assert_int_equal(ami_module_cache_invalidate(&dev, AMI_MODULE_ALL), AMI_STATUS_OK);
+	assert_int_equal(ami_module_cache_invalidate(&dev, AMI_MODULE_ALL), AMI_STATUS_OK);
+	assert_null(dev.module_cache);
+
+	pthread_mutex_destroy(&dev.cache_lock);
+}
+
+void test_fail_ami_module_cache_invalidate(void **state)
+{
+	/* Failure path - invalid `dev` argument */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_module_cache_invalidate(NULL, AMI_MODULE_ALL),
+		AMI_STATUS_ERROR
+	);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_happy_ami_module_read_page),
+		cmocka_unit_test(test_fail_ami_module_read_page),
+		cmocka_unit_test(test_happy_ami_module_cache_invalidate),
+		cmocka_unit_test(test_fail_ami_module_cache_invalidate),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
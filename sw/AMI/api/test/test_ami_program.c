@@ -585,6 +585,120 @@ void test_fail_ami_prog_get_fpt_partition(void **state)
 	);
 }
 
+void test_happy_ami_prog_get_partition_digest(void **state)
+{
+	ami_device dev = { 0 };
+	uint8_t digest[AMI_PARTITION_DIGEST_SIZE] = { 0 };
+
+	/* Happy path */
+	will_return(__wrap_ami_open_cdev, AMI_STATUS_OK);
+	will_return(__wrap_ioctl, AMI_LINUX_STATUS_OK);
+	assert_int_equal(
+		ami_prog_get_partition_digest(&dev, 0, 0, 1, digest),
+		AMI_STATUS_OK
+	);
+}
+
+void test_fail_ami_prog_get_partition_digest(void **state)
+{
+	ami_device dev = { 0 };
+	uint8_t digest[AMI_PARTITION_DIGEST_SIZE] = { 0 };
+
+	/* Failure path - invalid `dev` argument */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_prog_get_partition_digest(NULL, 0, 0, 1, digest),
+		AMI_STATUS_ERROR
+	);
+
+	/* Failure path - invalid `digest` argument */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_prog_get_partition_digest(&dev, 0, 0, 1, NULL),
+		AMI_STATUS_ERROR
+	);
+
+	/* Failure path - invalid `length` argument */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_prog_get_partition_digest(&dev, 0, 0, 0, digest),
+		AMI_STATUS_ERROR
+	);
+
+	/* Failure path - ioctl fails */
+	will_return(__wrap_ami_open_cdev, AMI_STATUS_OK);
+	will_return(__wrap_ioctl, AMI_LINUX_STATUS_ERROR);
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EIO);
+	assert_int_equal(
+		ami_prog_get_partition_digest(&dev, 0, 0, 1, digest),
+		AMI_STATUS_ERROR
+	);
+
+	/* Failure path - ami_open_cdev fails */
+	will_return(__wrap_ami_open_cdev, AMI_STATUS_ERROR);
+	assert_int_equal(
+		ami_prog_get_partition_digest(&dev, 0, 0, 1, digest),
+		AMI_STATUS_ERROR
+	);
+}
+
+void test_happy_ami_prog_partition_matches(void **state)
+{
+	ami_device dev = { 0 };
+	bool match = true;
+
+	/* Happy path - image read and digest fetched; ioctl leaves digest zeroed */
+	WRAPPER_ACTION(OK, fopen);
+	WRAPPER_ACTION_C(OK, fseek, 2);
+	WRAPPER_ACTION(OK, ftell);
+	WRAPPER_ACTION(OK, fread);
+	will_return(__wrap_fread, "a");
+	WRAPPER_ACTION(OK, ferror);
+	WRAPPER_ACTION(OK, fclose);
+	will_return(__wrap_ami_open_cdev, AMI_STATUS_OK);
+	will_return(__wrap_ioctl, AMI_LINUX_STATUS_OK);
+	assert_int_equal(
+		ami_prog_partition_matches(&dev, "a", 0, 0, &match),
+		AMI_STATUS_OK
+	);
+	assert_false(match);
+}
+
+void test_fail_ami_prog_partition_matches(void **state)
+{
+	ami_device dev = { 0 };
+	bool match = false;
+
+	/* Failure path - invalid `path` argument */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_prog_partition_matches(&dev, NULL, 0, 0, &match),
+		AMI_STATUS_ERROR
+	);
+
+	/* Failure path - invalid `match` argument */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_prog_partition_matches(&dev, "a", 0, 0, NULL),
+		AMI_STATUS_ERROR
+	);
+
+	/* Failure path - fopen fails */
+	WRAPPER_ACTION(FAIL, fopen);
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EBADF);
+	assert_int_equal(
+		ami_prog_partition_matches(&dev, "a", 0, 0, &match),
+		AMI_STATUS_ERROR
+	);
+}
+
 /*****************************************************************************/
 
 int main(void)
@@ -600,6 +714,10 @@ int main(void)
 		cmocka_unit_test(test_fail_ami_prog_get_fpt_header),
 		cmocka_unit_test(test_happy_ami_prog_get_fpt_partition),
 		cmocka_unit_test(test_fail_ami_prog_get_fpt_partition),
+		cmocka_unit_test(test_happy_ami_prog_get_partition_digest),
+		cmocka_unit_test(test_fail_ami_prog_get_partition_digest),
+		cmocka_unit_test(test_happy_ami_prog_partition_matches),
+		cmocka_unit_test(test_fail_ami_prog_partition_matches),
 	};
 
 	return cmocka_run_group_tests(tests, NULL, NULL);
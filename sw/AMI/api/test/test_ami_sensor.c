@@ -16,6 +16,8 @@
 #include <string.h>
 #include <unistd.h>
 #include <glob.h>
+#include <time.h>
+#include <pthread.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 
@@ -58,6 +60,26 @@ static struct ami_sensor_internal test_sensor_data = {
 
 static struct ami_sensor test_sensor = { 0 };
 
+static struct ami_sensor_list test_sensor_list = {
+	&test_sensor,
+	1,
+	4
+};
+
+/* Device and sensor list published by `__wrap_globfree` (if set) */
+static ami_device *test_race_dev = NULL;
+static struct ami_sensor_list *test_race_list = NULL;
+
+/* Sensor watch events, written by the sampling thread */
+#define TEST_WATCH_MAX_EVENTS   (8)
+#define TEST_WATCH_TIMEOUT_SEC  (5)
+
+static pthread_mutex_t test_watch_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t test_watch_cond = PTHREAD_COND_INITIALIZER;
+static struct ami_sensor_event test_watch_events[TEST_WATCH_MAX_EVENTS];
+static void *test_watch_data[TEST_WATCH_MAX_EVENTS];
+static int test_watch_num_events = 0;
+
 /*****************************************************************************/
 /* Redefinitions/Wrapping                                                    */
 /*****************************************************************************/
@@ -93,6 +115,12 @@ int __wrap_glob(const char *restrict pattern, int flags,
 
 int __wrap_globfree(glob_t *pglob)
 {
+	/* Simulate another thread publishing its sensors mid-discovery. */
+	if (test_race_dev) {
+		test_race_dev->sensor_list = test_race_list;
+		test_race_dev = NULL;
+	}
+
 	return AMI_LINUX_STATUS_OK;
 }
 
@@ -278,14 +306,64 @@ int __wrap_ioctl(int fd, unsigned long request, void *argp)
 /* Local functions                                                           */
 /*****************************************************************************/
 
+/*
+ * Sensor watch callback; records the event for the test thread.
+ */
+static void test_watch_callback(ami_device *dev, const struct ami_sensor_event *event,
+	void *data)
+{
+	pthread_mutex_lock(&test_watch_lock);
+
+	if (test_watch_num_events < TEST_WATCH_MAX_EVENTS) {
+		test_watch_events[test_watch_num_events] = *event;
+		test_watch_data[test_watch_num_events] = data;
+		test_watch_num_events++;
+	}
+
+	pthread_cond_broadcast(&test_watch_cond);
+	pthread_mutex_unlock(&test_watch_lock);
+}
+
+/*
+ * Wait until the sampling thread has reported `num` events in total.
+ */
+static int test_watch_wait_events(int num)
+{
+	struct timespec ts = { 0 };
+	int ret = 0;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	ts.tv_sec += TEST_WATCH_TIMEOUT_SEC;
+
+	pthread_mutex_lock(&test_watch_lock);
+
+	while ((test_watch_num_events < num) && (ret == 0))
+		ret = pthread_cond_timedwait(&test_watch_cond, &test_watch_lock, &ts);
+
+	ret = test_watch_num_events;
+	pthread_mutex_unlock(&test_watch_lock);
+	return ret;
+}
+
+/*
+ * Queue the mocks for one sample of a single sensor by the sampling thread.
+ */
+static void test_watch_expect_sample(struct ami_ioc_sensor_value *data)
+{
+	will_return(__wrap_ami_open_cdev, AMI_STATUS_OK);
+	will_return(__wrap_ioctl, AMI_LINUX_STATUS_OK);
+	will_return(__wrap_ioctl, data);
+	will_return(__wrap_ioctl, sizeof(*data));
+}
+
 /**
  * Delete all device sensor data.
 */
 static void delete_sensors(ami_device *dev)
 {
 
-	if (dev->sensors) {
-		struct ami_sensor *sensor = dev->sensors;
+	if (dev->sensor_list) {
+		struct ami_sensor *sensor = dev->sensor_list->head;
 		struct ami_sensor *next = NULL;
 
 		while (sensor) {
@@ -303,9 +381,8 @@ static void delete_sensors(ami_device *dev)
 			sensor = next;
 		}
 
-		dev->num_sensors = 0;
-		dev->num_total_sensors = 0;
-		dev->sensors = NULL;
+		free(dev->sensor_list);
+		dev->sensor_list = NULL;
 	}
 }
 
@@ -430,15 +507,12 @@ void test_happy_ami_sensor_discover(void **state)
 	/* find_sensor_data will fail once */
 	expect_function_call(__wrap_ami_set_last_error);
 	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
-	/* find_sensor_by_name will fail once */
-	expect_function_call(__wrap_ami_set_last_error);
-	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
 	assert_int_equal(
 		ami_sensor_discover(&dev),
 		AMI_STATUS_OK
 	);
-	assert_int_equal(dev.num_sensors, 2);
-	assert_int_equal(dev.num_total_sensors, 3);
+	assert_int_equal(dev.sensor_list->num_sensors, 2);
+	assert_int_equal(dev.sensor_list->num_total_sensors, 3);
 	delete_sensors(&dev);
 
 	/* Happy path - single temperature sensor */
@@ -456,15 +530,12 @@ void test_happy_ami_sensor_discover(void **state)
 	/* find_sensor_data will fail once */
 	expect_function_call(__wrap_ami_set_last_error);
 	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
-	/* find_sensor_by_name will fail once */
-	expect_function_call(__wrap_ami_set_last_error);
-	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
 	assert_int_equal(
 		ami_sensor_discover(&dev),
 		AMI_STATUS_OK
 	);
-	assert_int_equal(dev.num_sensors, 1);
-	assert_int_equal(dev.num_total_sensors, 1);
+	assert_int_equal(dev.sensor_list->num_sensors, 1);
+	assert_int_equal(dev.sensor_list->num_total_sensors, 1);
 	delete_sensors(&dev);
 
 	/* Happy path - single voltage sensor */
@@ -482,15 +553,12 @@ void test_happy_ami_sensor_discover(void **state)
 	/* find_sensor_data will fail once */
 	expect_function_call(__wrap_ami_set_last_error);
 	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
-	/* find_sensor_by_name will fail once */
-	expect_function_call(__wrap_ami_set_last_error);
-	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
 	assert_int_equal(
 		ami_sensor_discover(&dev),
 		AMI_STATUS_OK
 	);
-	assert_int_equal(dev.num_sensors, 1);
-	assert_int_equal(dev.num_total_sensors, 1);
+	assert_int_equal(dev.sensor_list->num_sensors, 1);
+	assert_int_equal(dev.sensor_list->num_total_sensors, 1);
 	delete_sensors(&dev);
 
 	/* Happy path - single current sensor */
@@ -508,15 +576,12 @@ void test_happy_ami_sensor_discover(void **state)
 	/* find_sensor_data will fail once */
 	expect_function_call(__wrap_ami_set_last_error);
 	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
-	/* find_sensor_by_name will fail once */
-	expect_function_call(__wrap_ami_set_last_error);
-	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
 	assert_int_equal(
 		ami_sensor_discover(&dev),
 		AMI_STATUS_OK
 	);
-	assert_int_equal(dev.num_sensors, 1);
-	assert_int_equal(dev.num_total_sensors, 1);
+	assert_int_equal(dev.sensor_list->num_sensors, 1);
+	assert_int_equal(dev.sensor_list->num_total_sensors, 1);
 	delete_sensors(&dev);
 
 	/* Happy path - single power sensor */
@@ -534,15 +599,12 @@ void test_happy_ami_sensor_discover(void **state)
 	/* find_sensor_data will fail once */
 	expect_function_call(__wrap_ami_set_last_error);
 	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
-	/* find_sensor_by_name will fail once */
-	expect_function_call(__wrap_ami_set_last_error);
-	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
 	assert_int_equal(
 		ami_sensor_discover(&dev),
 		AMI_STATUS_OK
 	);
-	assert_int_equal(dev.num_sensors, 1);
-	assert_int_equal(dev.num_total_sensors, 1);
+	assert_int_equal(dev.sensor_list->num_sensors, 1);
+	assert_int_equal(dev.sensor_list->num_total_sensors, 1);
 	delete_sensors(&dev);
 }
 
@@ -597,6 +659,59 @@ void test_fail_ami_sensor_discover(void **state)
 		ami_sensor_discover(&dev),
 		AMI_STATUS_ERROR
 	);
+
+	/* Failure path - sensors already published */
+	dev.sensor_list = &test_sensor_list;
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_sensor_discover(&dev),
+		AMI_STATUS_ERROR
+	);
+	assert_ptr_equal(dev.sensor_list, &test_sensor_list);
+	assert_int_equal(dev.sensor_list->num_sensors, 1);
+	assert_int_equal(dev.sensor_list->num_total_sensors, 4);
+}
+
+void test_happy_ami_sensor_discover_race(void **state)
+{
+	ami_device dev = { 0 };
+
+	char *files_temp[] = {
+		"/sys/class/hwmon/hwmon2/temp1_label",
+		"/sys/class/hwmon/hwmon2/temp1_input",
+		NULL
+	};
+
+	/* Happy path - another thread publishes first, its list is kept */
+	test_race_dev = &dev;
+	test_race_list = &test_sensor_list;
+	WRAPPER_ACTION(OK, open);
+	WRAPPER_ACTION(OK, close);
+	WRAPPER_ACTION(OK, read);
+	will_return(__wrap_read, "device");
+	will_return(__wrap_glob, AMI_LINUX_STATUS_OK);
+	will_return(__wrap_glob, 2);
+	will_return(__wrap_glob, files_temp);
+	will_return(__wrap_stat, __S_IFREG);
+	will_return(__wrap_stat, AMI_LINUX_STATUS_OK);
+	will_return(__wrap_stat, __S_IFREG);
+	will_return(__wrap_stat, AMI_LINUX_STATUS_OK);
+	/* find_sensor_data will fail once */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_sensor_discover(&dev),
+		AMI_STATUS_OK
+	);
+	assert_null(test_race_dev);
+	assert_ptr_equal(dev.sensor_list, &test_sensor_list);
+	assert_ptr_equal(dev.sensor_list->head, &test_sensor);
+	assert_ptr_equal(dev.sensor_list->head->next, NULL);
+
+	/* The counts are still the ones published with the winning list */
+	assert_int_equal(dev.sensor_list->num_sensors, 1);
+	assert_int_equal(dev.sensor_list->num_total_sensors, 4);
 }
 
 /*
@@ -797,9 +912,7 @@ void test_happy_ami_sensor_get_type(void **state)
 	ami_device dev = { 0 };
 	uint32_t type = 0;
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	assert_int_equal(
 		ami_sensor_get_type(&dev, "foo", &type),
@@ -841,11 +954,19 @@ void test_happy_ami_sensor_get_sensors(void **state)
 {
 	ami_device dev = { 0 };
 	struct ami_sensor sensor = { 0 };
+	struct ami_sensor_list list = { &sensor, 1, 4 };
 	struct ami_sensor *sensors = NULL;
 	int num_sensors = 0;
 
-	dev.sensors = &sensor;
-	dev.num_sensors = 1;
+	/* Happy path - nothing discovered yet */
+	assert_int_equal(
+		ami_sensor_get_sensors(&dev, &sensors, &num_sensors),
+		AMI_STATUS_OK
+	);
+	assert_int_equal(num_sensors, 0);
+	assert_null(sensors);
+
+	dev.sensor_list = &list;
 
 	/* Happy path - correct values returned */
 	assert_int_equal(
@@ -903,7 +1024,17 @@ void test_happy_ami_sensor_get_num_total(void **state)
 {
 	int num = 0;
 	ami_device dev = { 0 };
-	dev.num_total_sensors = 4;
+	struct ami_sensor_list list = { NULL, 1, 4 };
+
+	/* Happy path - nothing discovered yet */
+	num = -1;
+	assert_int_equal(
+		ami_sensor_get_num_total(&dev, &num),
+		AMI_STATUS_OK
+	);
+	assert_int_equal(num, 0);
+
+	dev.sensor_list = &list;
 
 	/* Happy path - correct values returned */
 	assert_int_equal(
@@ -948,9 +1079,7 @@ void test_happy_ami_sensor_get_temp_value(void **state)
 		.val = 123
 	};
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	/* Happy path - retrieve value with no status */
 	WRAPPER_ACTION(OK, open);
@@ -1031,9 +1160,7 @@ void test_happy_ami_sensor_get_voltage_value(void **state)
 		.val = 123
 	};
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	/* Happy path - retrieve value with no status */
 	WRAPPER_ACTION(OK, open);
@@ -1114,9 +1241,7 @@ void test_happy_ami_sensor_get_current_value(void **state)
 		.val = 123
 	};
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	/* Happy path - retrieve value with no status */
 	WRAPPER_ACTION(OK, open);
@@ -1197,9 +1322,7 @@ void test_happy_ami_sensor_get_power_value(void **state)
 		.val = 123
 	};
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	/* Happy path - retrieve value with no status */
 	WRAPPER_ACTION(OK, open);
@@ -1272,9 +1395,7 @@ void test_happy_ami_sensor_get_temp_status(void **state)
 	ami_device dev = { 0 };
 	enum ami_sensor_status val = AMI_SENSOR_STATUS_INVALID;
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	/* Happy path - retrieve correct value */
 	WRAPPER_ACTION(OK, open);
@@ -1331,9 +1452,7 @@ void test_happy_ami_sensor_get_voltage_status(void **state)
 	ami_device dev = { 0 };
 	enum ami_sensor_status val = AMI_SENSOR_STATUS_INVALID;
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	/* Happy path - retrieve correct value */
 	WRAPPER_ACTION(OK, open);
@@ -1390,9 +1509,7 @@ void test_happy_ami_sensor_get_current_status(void **state)
 	ami_device dev = { 0 };
 	enum ami_sensor_status val = AMI_SENSOR_STATUS_INVALID;
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	/* Happy path - retrieve correct value */
 	WRAPPER_ACTION(OK, open);
@@ -1449,9 +1566,7 @@ void test_happy_ami_sensor_get_power_status(void **state)
 	ami_device dev = { 0 };
 	enum ami_sensor_status val = AMI_SENSOR_STATUS_INVALID;
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	/* Happy path - retrieve correct value */
 	WRAPPER_ACTION(OK, open);
@@ -1508,9 +1623,7 @@ void test_happy_ami_sensor_get_temp_uptime_max(void **state)
 	ami_device dev = { 0 };
 	long val = 0;
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	/* Happy path - retrieve correct value */
 	WRAPPER_ACTION(OK, open);
@@ -1565,9 +1678,7 @@ void test_fail_ami_sensor_get_temp_uptime_max(void **state)
 	);
 
 	/* Failure path - value not valid */
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 	test_temp.max.valid = false;
 	expect_function_call(__wrap_ami_set_last_error);
 	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
@@ -1583,9 +1694,7 @@ void test_happy_ami_sensor_get_voltage_uptime_max(void **state)
 	ami_device dev = { 0 };
 	long val = 0;
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	/* Happy path - retrieve correct value */
 	WRAPPER_ACTION(OK, open);
@@ -1640,9 +1749,7 @@ void test_fail_ami_sensor_get_voltage_uptime_max(void **state)
 	);
 
 	/* Failure path - value not valid */
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 	test_voltage.max.valid = false;
 	expect_function_call(__wrap_ami_set_last_error);
 	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
@@ -1658,9 +1765,7 @@ void test_happy_ami_sensor_get_current_uptime_max(void **state)
 	ami_device dev = { 0 };
 	long val = 0;
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	/* Happy path - retrieve correct value */
 	WRAPPER_ACTION(OK, open);
@@ -1715,9 +1820,7 @@ void test_fail_ami_sensor_get_current_uptime_max(void **state)
 	);
 
 	/* Failure path - value not valid */
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 	test_current.max.valid = false;
 	expect_function_call(__wrap_ami_set_last_error);
 	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
@@ -1733,9 +1836,7 @@ void test_happy_ami_sensor_get_power_uptime_max(void **state)
 	ami_device dev = { 0 };
 	long val = 0;
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	/* Happy path - retrieve correct value */
 	WRAPPER_ACTION(OK, open);
@@ -1790,9 +1891,7 @@ void test_fail_ami_sensor_get_power_uptime_max(void **state)
 	);
 
 	/* Failure path - value not valid */
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 	test_power.max.valid = false;
 	expect_function_call(__wrap_ami_set_last_error);
 	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
@@ -1808,9 +1907,7 @@ void test_happy_ami_sensor_get_temp_uptime_average(void **state)
 	ami_device dev = { 0 };
 	long val = 0;
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	/* Happy path - retrieve correct value */
 	WRAPPER_ACTION(OK, open);
@@ -1865,9 +1962,7 @@ void test_fail_ami_sensor_get_temp_uptime_average(void **state)
 	);
 
 	/* Failure path - value not valid */
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 	test_temp.average.valid = false;
 	expect_function_call(__wrap_ami_set_last_error);
 	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
@@ -1883,9 +1978,7 @@ void test_happy_ami_sensor_get_voltage_uptime_average(void **state)
 	ami_device dev = { 0 };
 	long val = 0;
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	/* Happy path - retrieve correct value */
 	WRAPPER_ACTION(OK, open);
@@ -1940,9 +2033,7 @@ void test_fail_ami_sensor_get_voltage_uptime_average(void **state)
 	);
 
 	/* Failure path - value not valid */
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 	test_voltage.average.valid = false;
 	expect_function_call(__wrap_ami_set_last_error);
 	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
@@ -1958,9 +2049,7 @@ void test_happy_ami_sensor_get_current_uptime_average(void **state)
 	ami_device dev = { 0 };
 	long val = 0;
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	/* Happy path - retrieve correct value */
 	WRAPPER_ACTION(OK, open);
@@ -2015,9 +2104,7 @@ void test_fail_ami_sensor_get_current_uptime_average(void **state)
 	);
 
 	/* Failure path - value not valid */
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 	test_current.average.valid = false;
 	expect_function_call(__wrap_ami_set_last_error);
 	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
@@ -2033,9 +2120,7 @@ void test_happy_ami_sensor_get_power_uptime_average(void **state)
 	ami_device dev = { 0 };
 	long val = 0;
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	/* Happy path - retrieve correct value */
 	WRAPPER_ACTION(OK, open);
@@ -2090,9 +2175,7 @@ void test_fail_ami_sensor_get_power_uptime_average(void **state)
 	);
 
 	/* Failure path - value not valid */
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 	test_power.average.valid = false;
 	expect_function_call(__wrap_ami_set_last_error);
 	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
@@ -2108,9 +2191,7 @@ void test_happy_ami_sensor_get_temp_unit_mod(void **state)
 	ami_device dev = { 0 };
 	enum ami_sensor_unit_mod mod = AMI_SENSOR_UNIT_MOD_NONE;
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	/* Happy path - retrieve correct value */
 	assert_int_equal(
@@ -2162,9 +2243,7 @@ void test_happy_ami_sensor_get_voltage_unit_mod(void **state)
 	ami_device dev = { 0 };
 	enum ami_sensor_unit_mod mod = AMI_SENSOR_UNIT_MOD_NONE;
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	/* Happy path - retrieve correct value */
 	assert_int_equal(
@@ -2216,9 +2295,7 @@ void test_happy_ami_sensor_get_current_unit_mod(void **state)
 	ami_device dev = { 0 };
 	enum ami_sensor_unit_mod mod = AMI_SENSOR_UNIT_MOD_NONE;
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	/* Happy path - retrieve correct value */
 	assert_int_equal(
@@ -2270,9 +2347,7 @@ void test_happy_ami_sensor_get_power_unit_mod(void **state)
 	ami_device dev = { 0 };
 	enum ami_sensor_unit_mod mod = AMI_SENSOR_UNIT_MOD_NONE;
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	/* Happy path - retrieve correct value */
 	assert_int_equal(
@@ -2330,9 +2405,7 @@ void test_happy_parse_sensor_status(void **state)
 	ami_device dev = { 0 };
 	enum ami_sensor_status val = AMI_SENSOR_STATUS_INVALID;
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	/* Happy path - sensor OK */
 	WRAPPER_ACTION(OK, open);
@@ -2384,9 +2457,7 @@ void test_fail_parse_sensor_status(void **state)
 	ami_device dev = { 0 };
 	enum ami_sensor_status val = AMI_SENSOR_STATUS_INVALID;
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	/* Failure path - invalid status string */
 	WRAPPER_ACTION(OK, open);
@@ -2454,9 +2525,6 @@ void test_fail_populate_device_sensors(void **state)
 	/* find_sensor_data will fail once */
 	expect_function_call(__wrap_ami_set_last_error);
 	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
-	/* find_sensor_by_name will fail once */
-	expect_function_call(__wrap_ami_set_last_error);
-	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
 	expect_function_call(__wrap_ami_set_last_error);
 	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_ENOMEM);
 	assert_int_equal(
@@ -2481,9 +2549,6 @@ void test_fail_populate_device_sensors(void **state)
 	/* find_sensor_data will fail once */
 	expect_function_call(__wrap_ami_set_last_error);
 	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
-	/* find_sensor_by_name will fail once */
-	expect_function_call(__wrap_ami_set_last_error);
-	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
 	expect_function_call(__wrap_ami_set_last_error);
 	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_ENOMEM);
 	assert_int_equal(
@@ -2508,9 +2573,7 @@ void test_fail_get_single_sensor_val(void **state)
 		.val = 123
 	};
 
-	dev.sensors = &test_sensor;
-	dev.num_sensors = 1;
-	dev.num_total_sensors = 4;
+	dev.sensor_list = &test_sensor_list;
 
 	/* Failure path - ami_open_cdev fails */
 	will_return(__wrap_ami_open_cdev, AMI_STATUS_ERROR);
@@ -2530,6 +2593,203 @@ void test_fail_get_single_sensor_val(void **state)
 	);
 }
 
+/*
+ * The sampling thread consumes the mocks queued before each call, the test
+ * thread only waits for the resulting callback meanwhile. Every watch only
+ * covers the temperature so that each tick samples a single sensor.
+ */
+
+void test_happy_ami_sensor_watch(void **state)
+{
+	ami_device dev = { 0 };
+	int id_a = 0;
+	int id_b = 0;
+	int id_c = 0;
+	int a = 0;
+	int b = 0;
+
+	struct ami_ioc_sensor_value data = {
+		.status = AMI_SENSOR_OK_STR,
+		.fresh = true,
+		.val = 123
+	};
+
+	struct ami_sensor_deadband temp_only = { NULL, AMI_SENSOR_TYPE_TEMP, 0 };
+
+	struct ami_sensor_watch_cfg cfg = {
+		.interval_ms      = 60000,
+		.callback         = test_watch_callback,
+		.data             = &a,
+		.default_deadband = -1,
+		.deadbands        = &temp_only,
+		.num_deadbands    = 1,
+	};
+
+	test_temp.type = AMI_SENSOR_TYPE_TEMP;
+	test_current.type = AMI_SENSOR_TYPE_CURRENT;
+	test_voltage.type = AMI_SENSOR_TYPE_VOLTAGE;
+	test_power.type = AMI_SENSOR_TYPE_POWER;
+	test_temp.sid = 1;
+
+	dev.sensor_list = &test_sensor_list;
+	pthread_mutex_init(&dev.watch_lock, NULL);
+	test_watch_num_events = 0;
+
+	/* Happy path - first subscription starts the thread and reports the initial value */
+	will_return(__wrap_ami_open_cdev, AMI_STATUS_OK);
+	test_watch_expect_sample(&data);
+	assert_int_equal(ami_sensor_watch(&dev, &cfg, &id_a), AMI_STATUS_OK);
+	assert_non_null(dev.watcher);
+	assert_int_equal(test_watch_wait_events(1), 1);
+	assert_string_equal(test_watch_events[0].sensor_name, "foo");
+	assert_int_equal(test_watch_events[0].type, AMI_SENSOR_TYPE_TEMP);
+	assert_int_equal(test_watch_events[0].value, 123);
+	assert_int_equal(test_watch_events[0].status, AMI_SENSOR_STATUS_OK);
+	assert_int_equal(test_watch_events[0].prev_status, AMI_SENSOR_STATUS_INVALID);
+	assert_ptr_equal(test_watch_data[0], &a);
+
+	/* Happy path - second subscription shares the thread and gets its own initial report */
+	cfg.data = &b;
+	data.fresh = false;
+	will_return(__wrap_ami_open_cdev, AMI_STATUS_OK);
+	test_watch_expect_sample(&data);
+	assert_int_equal(ami_sensor_watch(&dev, &cfg, &id_b), AMI_STATUS_OK);
+	assert_int_not_equal(id_a, id_b);
+	assert_int_equal(test_watch_wait_events(2), 2);
+	assert_int_equal(test_watch_events[1].value, 123);
+	assert_int_equal(test_watch_events[1].status, AMI_SENSOR_STATUS_OK_CACHED);
+	assert_ptr_equal(test_watch_data[1], &b);
+
+	/* Happy path - removing one subscription keeps the thread running */
+	assert_int_equal(ami_sensor_unwatch(&dev, id_a), AMI_STATUS_OK);
+	assert_non_null(dev.watcher);
+
+	/* Happy path - removing the last subscription stops the thread */
+	assert_int_equal(ami_sensor_unwatch(&dev, id_b), AMI_STATUS_OK);
+	assert_null(dev.watcher);
+
+	/* Happy path - a subscription made after the last one was removed is served */
+	cfg.data = &a;
+	data.val = 456;
+	will_return(__wrap_ami_open_cdev, AMI_STATUS_OK);
+	test_watch_expect_sample(&data);
+	assert_int_equal(ami_sensor_watch(&dev, &cfg, &id_c), AMI_STATUS_OK);
+	assert_non_null(dev.watcher);
+	assert_int_equal(test_watch_wait_events(3), 3);
+	assert_int_equal(test_watch_events[2].value, 456);
+	assert_ptr_equal(test_watch_data[2], &a);
+	assert_int_equal(ami_sensor_unwatch(&dev, id_c), AMI_STATUS_OK);
+	assert_null(dev.watcher);
+
+	/* No further callbacks once unsubscribed */
+	assert_int_equal(test_watch_num_events, 3);
+	pthread_mutex_destroy(&dev.watch_lock);
+}
+
+void test_fail_ami_sensor_watch(void **state)
+{
+	ami_device dev = { 0 };
+	ami_device no_sensors = { 0 };
+	int id = 0;
+	int unused = 0;
+
+	struct ami_ioc_sensor_value data = {
+		.status = AMI_SENSOR_OK_STR,
+		.fresh = true,
+		.val = 123
+	};
+
+	struct ami_sensor_deadband temp_only = { NULL, AMI_SENSOR_TYPE_TEMP, 0 };
+
+	struct ami_sensor_watch_cfg cfg = {
+		.interval_ms      = 60000,
+		.callback         = test_watch_callback,
+		.data             = NULL,
+		.default_deadband = -1,
+		.deadbands        = &temp_only,
+		.num_deadbands    = 1,
+	};
+
+	struct ami_sensor_watch_cfg bad_cfg = cfg;
+
+	dev.sensor_list = &test_sensor_list;
+	pthread_mutex_init(&dev.watch_lock, NULL);
+	pthread_mutex_init(&no_sensors.watch_lock, NULL);
+	test_watch_num_events = 0;
+
+	/* Failure path - invalid `dev` argument */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(ami_sensor_watch(NULL, &cfg, &id), AMI_STATUS_ERROR);
+
+	/* Failure path - invalid `cfg` argument */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(ami_sensor_watch(&dev, NULL, &id), AMI_STATUS_ERROR);
+
+	/* Failure path - invalid `watch_id` argument */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(ami_sensor_watch(&dev, &cfg, NULL), AMI_STATUS_ERROR);
+
+	/* Failure path - no callback */
+	bad_cfg.callback = NULL;
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(ami_sensor_watch(&dev, &bad_cfg, &id), AMI_STATUS_ERROR);
+
+	/* Failure path - zero interval */
+	bad_cfg = cfg;
+	bad_cfg.interval_ms = 0;
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(ami_sensor_watch(&dev, &bad_cfg, &id), AMI_STATUS_ERROR);
+
+	/* Failure path - deadband count without deadbands */
+	bad_cfg = cfg;
+	bad_cfg.deadbands = NULL;
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(ami_sensor_watch(&dev, &bad_cfg, &id), AMI_STATUS_ERROR);
+
+	/* Failure path - sensors not discovered */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(ami_sensor_watch(&no_sensors, &cfg, &id), AMI_STATUS_ERROR);
+	assert_null(no_sensors.watcher);
+
+	/* Failure path - ami_open_cdev fails */
+	will_return(__wrap_ami_open_cdev, AMI_STATUS_ERROR);
+	assert_int_equal(ami_sensor_watch(&dev, &cfg, &id), AMI_STATUS_ERROR);
+	assert_null(dev.watcher);
+
+	/* Failure path - invalid `dev` argument to unwatch */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(ami_sensor_unwatch(NULL, 1), AMI_STATUS_ERROR);
+
+	/* Failure path - unwatch with no active watch */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(ami_sensor_unwatch(&dev, 1), AMI_STATUS_ERROR);
+
+	/* Failure path - unknown id leaves the existing subscription alone */
+	cfg.data = &unused;
+	will_return(__wrap_ami_open_cdev, AMI_STATUS_OK);
+	test_watch_expect_sample(&data);
+	assert_int_equal(ami_sensor_watch(&dev, &cfg, &id), AMI_STATUS_OK);
+	assert_int_equal(test_watch_wait_events(1), 1);
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(ami_sensor_unwatch(&dev, id + 1), AMI_STATUS_ERROR);
+	assert_non_null(dev.watcher);
+	assert_int_equal(ami_sensor_unwatch(&dev, id), AMI_STATUS_OK);
+	assert_null(dev.watcher);
+
+	pthread_mutex_destroy(&dev.watch_lock);
+	pthread_mutex_destroy(&no_sensors.watch_lock);
+}
+
 /*****************************************************************************/
 
 int main(void)
@@ -2537,6 +2797,7 @@ int main(void)
 	const struct CMUnitTest tests[] = {
 		cmocka_unit_test(test_happy_ami_sensor_discover),
 		cmocka_unit_test(test_fail_ami_sensor_discover),
+		cmocka_unit_test(test_happy_ami_sensor_discover_race),
 		cmocka_unit_test(test_fail_parse_hwmon),
 		cmocka_unit_test(test_happy_ami_sensor_set_refresh),
 		cmocka_unit_test(test_fail_ami_sensor_set_refresh),
@@ -2593,6 +2854,8 @@ int main(void)
 		cmocka_unit_test(test_fail_read_hwmon),
 		cmocka_unit_test(test_fail_populate_device_sensors),
 		cmocka_unit_test(test_fail_get_single_sensor_val),
+		cmocka_unit_test(test_happy_ami_sensor_watch),
+		cmocka_unit_test(test_fail_ami_sensor_watch),
 	};
 
 	return cmocka_run_group_tests(tests, setup_data, NULL);
@@ -46,13 +46,6 @@
  */
 static int do_cmd_none(struct app_option *options, int num_args, char **args);
 
-/**
- * init_profile_from_device() - Helper function to get the V80|Rave profile based on PCIE device id
- *
- * Return: PROFILE_V80, PROFILE_RAVE or PROFILE_DEFAULT
- */
-static uint16_t init_profile_from_device(void);
-
 /*****************************************************************************/
 /* Global variables                                                          */
 /*****************************************************************************/
@@ -97,7 +90,8 @@ static struct app_cmd cmd_none = {
 	.short_options = short_options,
 	.long_options  = long_options,
 	.root_required = false,
-	.help_msg      = NULL
+	.help_msg      = NULL,
+	.needs         = APP_NEEDS_NONE
 };
 
 /*
@@ -146,6 +140,8 @@ static const struct app_cmd_map commands[] =  {
 		PROFILE_V80,	"\tWrite data to a QSFP module\r\n" },
 	{ "debug_verbosity", &cmd_debug_verbosity,
 		PROFILE_DEFAULT,"\tSet the AMC debug level\r\n" },
+	{ "batch",           &cmd_batch,
+		PROFILE_DEFAULT,"\tRun a script of commands in one process\r\n" },
 };
 
 /*****************************************************************************/
@@ -161,7 +157,7 @@ static const char *get_profile_help_msg(void)
 	size_t offset = 0;
 	uint16_t current_profile;
 
-	current_profile = init_profile_from_device();
+	current_profile = app_profile();
 
 	offset += snprintf(buffer + offset, sizeof(buffer) - offset,
 			APP_NAME " - command line tool for the AMI driver API\r\n"
@@ -170,9 +166,11 @@ static const char *get_profile_help_msg(void)
 			"\t" APP_NAME " {command} -h | --help\r\n"
 			"\t" APP_NAME " -h | --help\r\n"
 			"\t" APP_NAME " --version\r\n"
+			"\t" APP_NAME " --timing {command} [arguments]\r\n"
 			"Options:\r\n"
 			"\t-h --help          Show this screen\r\n"
 			"\t--version          Show version\r\n"
+			"\t--timing           Print startup timings to stderr\r\n"
 			"Commands:\r\n" );
 
 	for (size_t i = 0; i < ARRAY_SIZE(commands); i++) {
@@ -227,37 +225,6 @@ int find_app_command(const char *name)
 /* Local function definitions                                                */
 /*****************************************************************************/
 
-/*
- * Initialize device profile
- */
-static uint16_t init_profile_from_device(void)
-{
-	uint16_t num_devs = 0;
-	uint16_t pci_dev_id;
-	uint16_t current_profile = PROFILE_DEFAULT;
-	ami_device *dev = NULL;
-
-	if (ami_dev_get_num_devices(&num_devs) != AMI_STATUS_OK) {
-		APP_API_ERROR("Error getting number of devices");
-		return current_profile;
-	}
-	/* Find device */
-	if (ami_dev_find_next(&dev, AMI_ANY_DEV, AMI_ANY_DEV, AMI_ANY_DEV, NULL) != AMI_STATUS_OK) {
-		APP_API_ERROR("could not find the requested device");
-		return current_profile;
-	}
-
-	if (ami_dev_get_pci_device(dev, &pci_dev_id) != AMI_STATUS_OK) {
-		APP_API_ERROR("could not get pci device id");
-		return current_profile;
-	}
-
-	// use pci_dev_id to choose profile
-	current_profile = (pci_dev_id == AMI_PCIE_DEVICE_ID_RAVE) ? PROFILE_RAVE : PROFILE_V80;
-	return current_profile;
-}
-
-
 /*
  * Empty command callback.
  */
@@ -290,7 +257,7 @@ static int do_cmd_none(struct app_option *options, int num_args, char **args)
 						GIT_TAG_VER_DEV_COMMITS
 					);
 
-					if (ami_get_driver_version(&driver_ver) == AMI_STATUS_OK) {
+					if (app_driver_version(&driver_ver) == AMI_STATUS_OK) {
 						printf(
 							driver_version_str,
 							driver_ver.major,
@@ -325,9 +292,10 @@ static int do_cmd_none(struct app_option *options, int num_args, char **args)
 	return ret;
 }
 
-/*****************************************************************************/
-
-int main(int argc, char *argv[])
+/*
+ * Parse and run a single command line.
+ */
+int run_app_command(int argc, char *argv[])
 {
 	int ret = EXIT_FAILURE;
 	int long_ind = 0;
@@ -336,9 +304,11 @@ int main(int argc, char *argv[])
 	int n_args = 0;
 	int cmd_ind = APP_INVALID_INDEX;
 	struct app_cmd *cmd = NULL;
+	uint64_t start = app_timing_start();
 
 	struct app_option *options_head = NULL;
 	struct app_option *options_tail = NULL;
+	struct app_option *next_opt = NULL;
 
 	/*
 	 * Check if user specified a command;
@@ -355,11 +325,14 @@ int main(int argc, char *argv[])
 
 	if (cmd_ind == APP_INVALID_INDEX) {
 		APP_USER_ERROR("unrecognised command", get_profile_help_msg());
-		exit(EXIT_FAILURE);
+		return EXIT_FAILURE;
 	}
 
 	cmd = commands[cmd_ind].command;
 
+	/* Start a fresh scan, this may not be the first command line parsed. */
+	optind = 0;
+
 	/*
 	 * Parse options for the identified command (or no command).
 	 */
@@ -371,8 +344,7 @@ int main(int argc, char *argv[])
 			case '?':
 			case ':':
 				APP_USER_ERROR("invalid arguments", cmd->help_msg);
-				exit(EXIT_FAILURE);
-				break;
+				goto cleanup;
 
 			/* All other options. */
 			default:
@@ -380,6 +352,11 @@ int main(int argc, char *argv[])
 				struct app_option *option = \
 					(struct app_option*)calloc(1, sizeof *option);
 
+				if (!option) {
+					APP_ERROR("could not allocate option");
+					goto cleanup;
+				}
+
 				option->long_ind = long_ind;
 				option->val = opt;
 				option->arg = optarg;
@@ -403,6 +380,8 @@ int main(int argc, char *argv[])
 			n_args = argc - optind - 1;
 	}
 
+	app_timing_stop(APP_PHASE_PARSE, start);
+
 	/* Check if help was requested */
 	if (NULL != find_app_option('h', options_head)) {
 		if (cmd->help_msg)
@@ -418,16 +397,20 @@ int main(int argc, char *argv[])
 		if (cmd->root_required && (geteuid() != 0))
 			APP_WARN("this command requires elevated permissions but you are not running as root!\r\n");
 
-		/* Execute command callback. */
-		ret = cmd->callback(
-			options_head,
-			n_args,
-			((n_args != 0) ? (&argv[optind + 1]) : (NULL))
-		);
+		start = app_timing_start();
+
+		/* Bring up what the command depends on, then run it. */
+		if (app_subsys_require(cmd->needs) == EXIT_SUCCESS)
+			ret = cmd->callback(
+				options_head,
+				n_args,
+				((n_args != 0) ? (&argv[optind + 1]) : (NULL))
+			);
+
+		app_timing_stop(APP_PHASE_COMMAND, start);
 	}
 
-	/* Cleanup. */
-	struct app_option *next_opt = NULL;
+cleanup:
 	options_tail = options_head;
 
 	while (options_tail) {
@@ -438,3 +421,23 @@ int main(int argc, char *argv[])
 
 	return ret;
 }
+
+/*****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	int ret = EXIT_FAILURE;
+
+	/* Global flags precede the command and are hidden from its parser. */
+	if ((argc > CMD_INDEX) && (strcmp(argv[CMD_INDEX], "--timing") == 0)) {
+		app_timing_enable();
+		argv[CMD_INDEX] = argv[0];
+		argc--;
+		argv++;
+	}
+
+	ret = run_app_command(argc, argv);
+	app_timing_report(stderr);
+
+	return ret;
+}
@@ -13,6 +13,9 @@
 /* API includes */
 #include "ami.h"
 
+/* App includes */
+#include "subsys.h"
+
 /*****************************************************************************/
 /* Defines                                                                   */
 /*****************************************************************************/
@@ -79,6 +82,8 @@ struct app_option {
  * @short_options: List of short options that this command accepts.
  * @long_options: List of long options that this command accepts.
  * @help_msg: Message to print when -h/--help option is given.
+ * @needs: Subsystems used by this command (`APP_NEEDS_*`); these are
+ *     brought up before the callback runs, everything else is left alone.
  */
 struct app_cmd {
 	app_command           callback;
@@ -86,6 +91,7 @@ struct app_cmd {
 	const char           *short_options;
 	const struct option  *long_options;
 	const char           *help_msg;
+	uint32_t              needs;
 };
 
 /**
@@ -113,6 +119,19 @@ struct app_cmd_map {
  */
 int find_app_command(const char *name);
 
+/**
+ * run_app_command() - Parse and run a single command line.
+ * @argc: Number of arguments, including the program name.
+ * @argv: Arguments; `argv[1]` is the command name.
+ *
+ * This is what `main` does for a normal invocation. It may be called again
+ * from within the same process (see the "batch" command); the getopt state
+ * is reset every time.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int run_app_command(int argc, char *argv[]);
+
 /**
  * find_app_option() - Check if a specific option exists in a list of options.
  * @val: Value of the option. For short options this is the char
@@ -12,6 +12,7 @@
 #include <stdbool.h>
 #include <libgen.h>
 #include <unistd.h>
+#include <pthread.h>
 #include <poll.h>  /* Linux only */
 
 /* App includes */
@@ -33,6 +34,35 @@
 
 #define APP_DEV_COMPAT_STR	"COMPAT"
 
+/* Device handle cache (see `app_dev_find`) */
+#define APP_DEV_CACHE_MAX	(32)
+#define APP_DEV_CACHE_KEY_LEN	(32)
+
+/*****************************************************************************/
+/* Structs                                                                   */
+/*****************************************************************************/
+
+/**
+ * struct app_dev_cache_entry - A device handle kept open between commands.
+ * @bdf: Device argument the handle was opened with.
+ * @dev: Device handle (the cache owns one reference).
+ */
+struct app_dev_cache_entry {
+	char        bdf[APP_DEV_CACHE_KEY_LEN];
+	ami_device *dev;
+};
+
+/*****************************************************************************/
+/* Global variables                                                          */
+/*****************************************************************************/
+
+static struct app_dev_cache_entry dev_cache[APP_DEV_CACHE_MAX];
+static int dev_cache_num = 0;
+static bool dev_cache_enabled = false;
+static pthread_mutex_t dev_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static bool interactive = true;
+
 /*****************************************************************************/
 /* Local function definitions                                                */
 /*****************************************************************************/
@@ -433,7 +463,7 @@ int write_hex_data(const char *fname, void *values, uint32_t num_values,
 	if (!fname || !values)
 		return EXIT_FAILURE;
 
-	file = fopen(fname, "w");
+	file = open_output_file(fname);
 
 	if (file) {
 		int i = 0;
@@ -530,6 +560,11 @@ bool confirm_action(const char *prompt, char yes, int attempts)
 	int num_attempts = 0;
 	struct pollfd mypoll = { STDIN_FILENO, POLLIN | POLLPRI };
 
+	if (!interactive) {
+		APP_WARN("confirmation is required but no prompt is possible - aborting");
+		return false;
+	}
+
 	do {
 		fflush(stdin);
 		printf("%s", prompt);
@@ -638,6 +673,8 @@ int parse_output_options(struct app_option *options, enum app_out_format *fmt,
 			*fmt = APP_OUT_FORMAT_TABLE;
 		else if (strcmp(opt->arg, "json") == 0)
 			*fmt = APP_OUT_FORMAT_JSON;
+		else if (strcmp(opt->arg, "cbor") == 0)
+			*fmt = APP_OUT_FORMAT_CBOR;
 		else
 			APP_WARN("invalid output format");
 	}
@@ -650,7 +687,7 @@ int parse_output_options(struct app_option *options, enum app_out_format *fmt,
 		}
 
 		o_given = true;
-		*stream = fopen(opt->arg, "w");
+		*stream = open_output_file(opt->arg);
 
 		/* Defaults to stdout */
 		if (!(*stream))
@@ -690,3 +727,96 @@ void warn_compat_mode(ami_device *dev)
 		APP_WARN("device is running in compatibility mode - you may experience issues!\r\n");
 	}
 }
+
+/*
+ * Enable or disable interactive prompts.
+ */
+void app_set_interactive(bool enable)
+{
+	interactive = enable;
+}
+
+/*
+ * Enable or disable the device handle cache.
+ */
+void app_dev_cache_enable(bool enable)
+{
+	if (!enable)
+		app_dev_cache_flush();
+
+	pthread_mutex_lock(&dev_cache_lock);
+	dev_cache_enabled = enable;
+	pthread_mutex_unlock(&dev_cache_lock);
+}
+
+/*
+ * Drop all cached device handles.
+ */
+void app_dev_cache_flush(void)
+{
+	int i = 0;
+
+	pthread_mutex_lock(&dev_cache_lock);
+
+	for (i = 0; i < dev_cache_num; i++)
+		ami_dev_delete(&dev_cache[i].dev);
+
+	dev_cache_num = 0;
+	pthread_mutex_unlock(&dev_cache_lock);
+}
+
+/*
+ * Find a device, reusing a cached handle if possible.
+ */
+int app_dev_find(const char *bdf, ami_device **dev)
+{
+	int ret = AMI_STATUS_ERROR;
+	int i = 0;
+
+	if (!bdf || !dev)
+		return AMI_STATUS_ERROR;
+
+	pthread_mutex_lock(&dev_cache_lock);
+
+	if (!dev_cache_enabled || (strlen(bdf) >= APP_DEV_CACHE_KEY_LEN)) {
+		pthread_mutex_unlock(&dev_cache_lock);
+		return ami_dev_find(bdf, dev);
+	}
+
+	for (i = 0; i < dev_cache_num; i++) {
+		if (strcmp(dev_cache[i].bdf, bdf) == 0) {
+			ret = ami_dev_ref(dev_cache[i].dev);
+
+			if (ret == AMI_STATUS_OK)
+				*dev = dev_cache[i].dev;
+
+			pthread_mutex_unlock(&dev_cache_lock);
+			return ret;
+		}
+	}
+
+	/* Don't serialise concurrent lookups of different devices. */
+	pthread_mutex_unlock(&dev_cache_lock);
+	ret = ami_dev_find(bdf, dev);
+
+	if (ret != AMI_STATUS_OK)
+		return ret;
+
+	pthread_mutex_lock(&dev_cache_lock);
+
+	for (i = 0; i < dev_cache_num; i++)
+		if (strcmp(dev_cache[i].bdf, bdf) == 0)
+			break;
+
+	/* Keep a reference for later commands; the caller owns the other. */
+	if (dev_cache_enabled && (i == dev_cache_num) &&
+			(dev_cache_num < APP_DEV_CACHE_MAX) &&
+			(ami_dev_ref(*dev) == AMI_STATUS_OK)) {
+		strcpy(dev_cache[dev_cache_num].bdf, bdf);
+		dev_cache[dev_cache_num].dev = *dev;
+		dev_cache_num++;
+	}
+
+	pthread_mutex_unlock(&dev_cache_lock);
+	return ret;
+}
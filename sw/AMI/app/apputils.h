@@ -162,4 +162,50 @@ int parse_output_options(struct app_option *options, enum app_out_format *fmt,
  */
 void warn_compat_mode(ami_device *dev);
 
+/**
+ * app_set_interactive() - Enable or disable interactive prompts.
+ * @enable: Whether the user can be prompted.
+ *
+ * When disabled, `confirm_action` returns false without prompting, so
+ * commands which need a confirmation must be given their "skip" option.
+ *
+ * Return: None.
+ */
+void app_set_interactive(bool enable);
+
+/**
+ * app_dev_cache_enable() - Enable or disable the device handle cache.
+ * @enable: Whether `app_dev_find` should keep handles open.
+ *
+ * Disabling the cache also drops all cached handles.
+ *
+ * Return: None.
+ */
+void app_dev_cache_enable(bool enable);
+
+/**
+ * app_dev_cache_flush() - Drop all cached device handles.
+ *
+ * Must be called before anything which replaces a device handle
+ * (`ami_dev_hot_reset`, `ami_dev_pci_reload`, `ami_prog_device_boot`),
+ * as no other reference may be held at that point.
+ *
+ * Return: None.
+ */
+void app_dev_cache_flush(void);
+
+/**
+ * app_dev_find() - Find a device by BDF, reusing a cached handle if possible.
+ * @bdf: Device BDF string.
+ * @dev: Pointer to hold the device handle.
+ *
+ * Same as `ami_dev_find`. When the cache is enabled, the first lookup of a
+ * BDF keeps an extra reference to the handle, and later lookups take a new
+ * reference to the same handle instead of opening the device again. In
+ * both cases the caller releases its handle with `ami_dev_delete`.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR
+ */
+int app_dev_find(const char *bdf, ami_device **dev);
+
 #endif /* AMI_APP_UTILS_H */
@@ -78,7 +78,8 @@ struct app_cmd cmd_bar_rd = {
 	.short_options = short_options,
 	.long_options  = long_options,
 	.root_required = true,
-	.help_msg      = help_msg
+	.help_msg      = help_msg,
+	.needs         = APP_NEEDS_DEVICES
 };
 
 /*****************************************************************************/
@@ -154,7 +155,7 @@ static int do_cmd_bar_rd(struct app_option *options, int num_args, char **args)
 	}
 
 	/* Find device */
-	if (ami_dev_find(device->arg, &dev) != AMI_STATUS_OK) {
+	if (app_dev_find(device->arg, &dev) != AMI_STATUS_OK) {
 		APP_API_ERROR("could not find the requested device");
 		return EXIT_FAILURE;
 	}
@@ -0,0 +1,540 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * cmd_batch.c - This file contains the implementation for the command "batch"
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+/* Standard includes */
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <unistd.h>
+#include <getopt.h>
+
+/* App includes */
+#include "commands.h"
+#include "apputils.h"
+#include "json_writer.h"
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+#define BATCH_STDIN		"-"
+#define BATCH_COMMENT		'#'
+#define BATCH_MAX_ARGS		(64)
+#define BATCH_READ_CHUNK	(4096)
+
+#define NS_PER_US		(1000L)
+#define US_PER_S		(1000000L)
+
+/*****************************************************************************/
+/* Structs                                                                   */
+/*****************************************************************************/
+
+/**
+ * struct batch_capture - Redirected standard output and error of a command.
+ * @out: Temporary file receiving stdout.
+ * @err: Temporary file receiving stderr.
+ * @saved_out: Duplicate of the original stdout descriptor.
+ * @saved_err: Duplicate of the original stderr descriptor.
+ */
+struct batch_capture {
+	FILE *out;
+	FILE *err;
+	int   saved_out;
+	int   saved_err;
+};
+
+/*****************************************************************************/
+/* Function declarations                                                     */
+/*****************************************************************************/
+
+/**
+ * do_cmd_batch() - "batch" command callback.
+ * @options:  Ordered list of options passed in at the command line
+ * @num_args:  Number of non-option arguments (excluding command)
+ * @args:  List of non-option arguments (excluding command)
+ *
+ * `args` may be an invalid pointer. It is the function's responsibility
+ * to validate the `num_args` parameter.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+static int do_cmd_batch(struct app_option *options, int num_args, char **args);
+
+/*****************************************************************************/
+/* Global variables                                                          */
+/*****************************************************************************/
+
+/*
+ * h: Help
+ * k: Keep going after a command fails
+ */
+static const char short_options[] = "hk";
+
+static const struct option long_options[] = {
+	{ "help",       no_argument, NULL, 'h' },  /* help screen */
+	{ "keep-going", no_argument, NULL, 'k' },  /* don't stop on failure */
+	{ },
+};
+
+static const char help_msg[] = \
+	"batch - run a script of commands in a single process\r\n"
+	"\r\nUsage:\r\n"
+	"\t" APP_NAME " batch [options...] <file|->\r\n"
+	"\r\nOptions:\r\n"
+	"\t-h --help            Show this screen\r\n"
+	"\t-k --keep-going      Run the remaining commands after a failure\r\n"
+	"\r\nEach line of the script (or of stdin for '-') is one command, written\r\n"
+	"as on the command line without the leading '" APP_NAME "'. Blank lines\r\n"
+	"and lines starting with '#' are ignored; quotes group arguments.\r\n"
+	"Device handles are opened once and reused by later commands.\r\n"
+	"\r\nFor every command a single JSON line is printed to stdout with the\r\n"
+	"keys \"line\", \"command\", \"status\", \"duration_us\", \"stdout\" and\r\n"
+	"\"stderr\". Prompts are disabled, so commands which ask for\r\n"
+	"confirmation must be given their '-y' option.\r\n"
+;
+
+struct app_cmd cmd_batch = {
+	.callback      = &do_cmd_batch,
+	.short_options = short_options,
+	.long_options  = long_options,
+	.root_required = false,
+	.help_msg      = help_msg,
+	.needs         = APP_NEEDS_NONE
+};
+
+/*
+ * Commands which replace the device handle (hot reset, PCI reload);
+ * no cached handle may be open while they run.
+ */
+static const char *uncached_commands[] = {
+	"reload",
+	"device_boot",
+};
+
+/*****************************************************************************/
+/* Local function definitions                                                */
+/*****************************************************************************/
+
+/**
+ * split_line() - Split a script line into arguments in place.
+ * @line: Line to split (modified).
+ * @argv: Array to hold the arguments.
+ * @max: Size of `argv`.
+ *
+ * Arguments are separated by whitespace. Single quotes preserve everything
+ * up to the closing quote, double quotes do the same but allow `\"` and
+ * `\\` escapes, and a backslash outside quotes escapes the next character.
+ * An unquoted '#' at the start of an argument ends the line.
+ *
+ * Return: Number of arguments, or -1 on unbalanced quotes or too many
+ *         arguments.
+ */
+static int split_line(char *line, char **argv, int max)
+{
+	int argc = 0;
+	char *src = line;
+	char *dst = line;
+
+	while (*src) {
+		char quote = 0;
+
+		while (isspace((unsigned char)*src))
+			src++;
+
+		if (!*src || (*src == BATCH_COMMENT))
+			break;
+
+		if (argc >= max)
+			return -1;
+
+		argv[argc++] = dst;
+
+		while (*src && (quote || !isspace((unsigned char)*src))) {
+			if (quote) {
+				if (*src == quote) {
+					quote = 0;
+					src++;
+				} else if ((quote == '"') && (*src == '\\') &&
+						((src[1] == '"') || (src[1] == '\\'))) {
+					*dst++ = src[1];
+					src += 2;
+				} else {
+					*dst++ = *src++;
+				}
+			} else if ((*src == '\'') || (*src == '"')) {
+				quote = *src++;
+			} else if ((*src == '\\') && src[1]) {
+				*dst++ = src[1];
+				src += 2;
+			} else {
+				*dst++ = *src++;
+			}
+		}
+
+		if (quote)
+			return -1;
+
+		/* `dst` never overtakes `src`, so this can't clobber input. */
+		if (*src)
+			src++;
+
+		*dst++ = '\0';
+	}
+
+	return argc;
+}
+
+/**
+ * capture_begin() - Redirect stdout and stderr into temporary files.
+ * @cap: Capture state.
+ *
+ * Descriptors are redirected rather than the `FILE` streams, so output
+ * written with any API (or by child processes) is captured.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ */
+static int capture_begin(struct batch_capture *cap)
+{
+	cap->out = tmpfile();
+	cap->err = tmpfile();
+	cap->saved_out = -1;
+	cap->saved_err = -1;
+
+	if (!cap->out || !cap->err)
+		goto fail;
+
+	fflush(stdout);
+	fflush(stderr);
+
+	cap->saved_out = dup(STDOUT_FILENO);
+	cap->saved_err = dup(STDERR_FILENO);
+
+	if ((cap->saved_out < 0) || (cap->saved_err < 0))
+		goto fail;
+
+	if ((dup2(fileno(cap->out), STDOUT_FILENO) < 0) ||
+			(dup2(fileno(cap->err), STDERR_FILENO) < 0)) {
+		dup2(cap->saved_out, STDOUT_FILENO);
+		goto fail;
+	}
+
+	return EXIT_SUCCESS;
+
+fail:
+	if (cap->saved_out >= 0)
+		close(cap->saved_out);
+
+	if (cap->saved_err >= 0)
+		close(cap->saved_err);
+
+	if (cap->out)
+		fclose(cap->out);
+
+	if (cap->err)
+		fclose(cap->err);
+
+	cap->out = NULL;
+	cap->err = NULL;
+	return EXIT_FAILURE;
+}
+
+/**
+ * read_capture() - Read back a temporary capture file.
+ * @f: Capture file.
+ *
+ * Return: Allocated, NUL terminated contents or NULL.
+ */
+static char *read_capture(FILE *f)
+{
+	char *buf = NULL;
+	size_t len = 0;
+	size_t n = 0;
+
+	rewind(f);
+
+	do {
+		char *tmp = (char*)realloc(buf, len + BATCH_READ_CHUNK + 1);
+
+		if (!tmp) {
+			free(buf);
+			return NULL;
+		}
+
+		buf = tmp;
+		n = fread(buf + len, 1, BATCH_READ_CHUNK, f);
+		len += n;
+	} while (n == BATCH_READ_CHUNK);
+
+	buf[len] = '\0';
+	return buf;
+}
+
+/**
+ * capture_end() - Restore stdout and stderr and collect what was written.
+ * @cap: Capture state.
+ * @out: Variable to hold the captured stdout (must be freed).
+ * @err: Variable to hold the captured stderr (must be freed).
+ *
+ * Return: None.
+ */
+static void capture_end(struct batch_capture *cap, char **out, char **err)
+{
+	fflush(stdout);
+	fflush(stderr);
+
+	dup2(cap->saved_out, STDOUT_FILENO);
+	dup2(cap->saved_err, STDERR_FILENO);
+	close(cap->saved_out);
+	close(cap->saved_err);
+
+	*out = read_capture(cap->out);
+	*err = read_capture(cap->err);
+
+	fclose(cap->out);
+	fclose(cap->err);
+}
+
+/**
+ * elapsed_us() - Time elapsed between two timestamps.
+ * @start: Start time.
+ * @end: End time.
+ *
+ * Return: Elapsed time in microseconds.
+ */
+static int64_t elapsed_us(const struct timespec *start, const struct timespec *end)
+{
+	return ((int64_t)(end->tv_sec - start->tv_sec) * US_PER_S) +
+		((end->tv_nsec - start->tv_nsec) / NS_PER_US);
+}
+
+/**
+ * print_result() - Print the JSON line describing one command.
+ * @line_num: Line number in the script.
+ * @command: Command text.
+ * @status: Exit status of the command.
+ * @duration_us: Run time of the command.
+ * @out: Captured stdout (may be NULL).
+ * @err: Captured stderr (may be NULL).
+ *
+ * Return: None.
+ */
+static void print_result(int line_num, const char *command, int status,
+	int64_t duration_us, const char *out, const char *err)
+{
+	struct json_writer jw = { 0 };
+	char *buf = NULL;
+	size_t len = 0;
+	FILE *stream = open_memstream(&buf, &len);
+
+	if (!stream)
+		return;
+
+	/* Build the line separately so it reaches stdout in a single write. */
+	json_writer_init_compact(&jw, stream);
+	json_writer_begin_object(&jw);
+	json_writer_key(&jw, "line");
+	json_writer_int(&jw, line_num);
+	json_writer_key(&jw, "command");
+	json_writer_string(&jw, command);
+	json_writer_key(&jw, "status");
+	json_writer_int(&jw, status);
+	json_writer_key(&jw, "duration_us");
+	json_writer_int(&jw, duration_us);
+	json_writer_key(&jw, "stdout");
+	json_writer_string(&jw, out);
+	json_writer_key(&jw, "stderr");
+	json_writer_string(&jw, err);
+	json_writer_finish(&jw);
+	fclose(stream);
+
+	if (buf) {
+		fwrite(buf, sizeof(char), len, stdout);
+		fputc('\n', stdout);
+		fflush(stdout);
+		free(buf);
+	}
+}
+
+/**
+ * is_uncached_command() - Check if a command replaces device handles.
+ * @name: Command name.
+ *
+ * Return: true if cached handles must be dropped around the command.
+ */
+static bool is_uncached_command(const char *name)
+{
+	int i = 0;
+
+	for (i = 0; i < ARRAY_SIZE(uncached_commands); i++)
+		if (strcmp(uncached_commands[i], name) == 0)
+			return true;
+
+	return false;
+}
+
+/**
+ * run_batch_line() - Run a single script line.
+ * @line_num: Line number in the script.
+ * @line: Line to run (modified).
+ * @status: Variable to hold the exit status of the command.
+ *
+ * Return: false if the line was blank or a comment, true otherwise.
+ */
+static bool run_batch_line(int line_num, char *line, int *status)
+{
+	int argc = 0;
+	char *argv[BATCH_MAX_ARGS + 2] = { 0 };
+	char *command = NULL;
+	char *out = NULL;
+	char *err = NULL;
+	bool uncached = false;
+	struct batch_capture cap = { 0 };
+	struct timespec start = { 0 };
+	struct timespec end = { 0 };
+
+	line[strcspn(line, "\r\n")] = '\0';
+
+	while (isspace((unsigned char)*line))
+		line++;
+
+	/* Keep the original text for the result. */
+	command = strdup(line);
+
+	if (!command) {
+		*status = EXIT_FAILURE;
+		print_result(line_num, line, *status, 0, "", "Error: out of memory\r\n");
+		return true;
+	}
+
+	argv[0] = APP_NAME;
+	argc = split_line(line, &argv[1], BATCH_MAX_ARGS);
+
+	if (argc == 0) {
+		free(command);
+		return false;
+	}
+
+	*status = EXIT_FAILURE;
+
+	if (argc < 0) {
+		print_result(line_num, command, *status, 0, "",
+			"Error: could not parse command\r\n");
+		free(command);
+		return true;
+	}
+
+	if (strcmp(argv[1], "batch") == 0) {
+		print_result(line_num, command, *status, 0, "",
+			"Error: batch scripts cannot be nested\r\n");
+		free(command);
+		return true;
+	}
+
+	uncached = is_uncached_command(argv[1]);
+
+	if (uncached)
+		app_dev_cache_flush();
+
+	if (capture_begin(&cap) != EXIT_SUCCESS) {
+		print_result(line_num, command, *status, 0, "",
+			"Error: could not capture command output\r\n");
+		free(command);
+		return true;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	*status = run_app_command(argc + 1, argv);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	capture_end(&cap, &out, &err);
+
+	/* Handles opened by the command itself are stale after a reset. */
+	if (uncached)
+		app_dev_cache_flush();
+
+	print_result(line_num, command, *status, elapsed_us(&start, &end), out, err);
+
+	free(out);
+	free(err);
+	free(command);
+	return true;
+}
+
+/*****************************************************************************/
+/* Function implementations                                                  */
+/*****************************************************************************/
+
+/**
+ * "batch" command callback.
+ * @options:  Ordered list of options passed in at the command line
+ * @num_args:  Number of non-option arguments (excluding command)
+ * @args:  List of non-option arguments (excluding command)
+ *
+ * `args` may be an invalid pointer. It is the function's responsibility
+ * to validate the `num_args` parameter.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+static int do_cmd_batch(struct app_option *options, int num_args, char **args)
+{
+	int ret = EXIT_SUCCESS;
+	int status = EXIT_SUCCESS;
+	int line_num = 0;
+	bool keep_going = false;
+	char *line = NULL;
+	size_t line_size = 0;
+	FILE *script = NULL;
+
+	if (num_args != 1) {
+		APP_USER_ERROR("a single script file must be given", help_msg);
+		return EXIT_FAILURE;
+	}
+
+	keep_going = (NULL != find_app_option('k', options));
+
+	if (strcmp(args[0], BATCH_STDIN) == 0)
+		script = stdin;
+	else
+		script = fopen(args[0], "r");
+
+	if (!script) {
+		APP_ERROR("could not open script file");
+		return EXIT_FAILURE;
+	}
+
+	app_set_interactive(false);
+	app_dev_cache_enable(true);
+
+	while (getline(&line, &line_size, script) != -1) {
+		line_num++;
+
+		if (!run_batch_line(line_num, line, &status))
+			continue;
+
+		if (status != EXIT_SUCCESS) {
+			ret = EXIT_FAILURE;
+
+			if (!keep_going)
+				break;
+		}
+	}
+
+	app_dev_cache_enable(false);
+	app_set_interactive(true);
+
+	free(line);
+
+	if (script != stdin)
+		fclose(script);
+
+	return ret;
+}
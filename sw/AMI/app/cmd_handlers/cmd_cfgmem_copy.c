@@ -11,6 +11,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <string.h>
+#include <time.h>
 #include <getopt.h>
 
 /* API includes */
@@ -19,6 +20,9 @@
 
 /* App includes */
 #include "commands.h"
+#include "apputils.h"
+#include "printer.h"
+#include "throughput.h"
 
 /*****************************************************************************/
 /* Defines                                                                   */
@@ -26,6 +30,25 @@
 
 #define COPY_CHUNK_DUR_MS       (10396) /* Est duration for partition chunk copy (ms) */
 #define SECOND_IN_MS            (1000)
+#define NS_IN_MS                (1000000)
+#define PROGRESS_BAR_WIDTH      (50)
+#define COPY_RATE_OP            "cfgmem_copy"
+
+/*****************************************************************************/
+/* Structs                                                                   */
+/*****************************************************************************/
+
+/**
+ * struct copy_progress - State shared with the copy progress handler.
+ * @start: Time the copy was started (CLOCK_MONOTONIC).
+ * @est_ms: Estimated duration of the copy.
+ * @state: Last progress bar state.
+ */
+struct copy_progress {
+	struct timespec start;
+	uint64_t        est_ms;
+	char            state;
+};
 
 /*****************************************************************************/
 /* Function declarations                                                     */
@@ -45,12 +68,20 @@
 static int do_cmd_cfgmem_copy(struct app_option *options, int num_args, char **args);
 
 /**
- * calc_est_time() - Local function to calc est copy duration.
- * @part_size: Size of src partition.
+ * default_rate() - Local function to get the throughput assumed for a
+ *                  device model which has not been measured yet.
+ *
+ * Return: Seed throughput (with no samples).
+ */
+static struct app_rate default_rate(void);
+
+/**
+ * elapsed_ms() - Local function to get the time since a given start time.
+ * @start: Start time (CLOCK_MONOTONIC).
  *
- * Return: Result of duration calc.
+ * Return: Elapsed time in milliseconds.
  */
-static uint32_t calc_est_time(uint32_t part_size);
+static uint64_t elapsed_ms(const struct timespec *start);
 
 /**
  * progress_handler() - Event handler for the copy operation.
@@ -58,9 +89,9 @@ static uint32_t calc_est_time(uint32_t part_size);
  * @ctr: Event counter, unused.
  * @data: NULL, unused.
  *
- * The progress handling is currently limited and simply prints out a character
- * regardless of the actual event that gets raised. This may still be useful,
- * however, to indicate that the application itself is not hanging.
+ * The driver does not report copy progress, so this is called once per
+ * event poll timeout. The progress bar and ETA are driven by the elapsed
+ * time against the estimate made from the measured throughput.
  *
  * Return: None.
  */
@@ -70,6 +101,9 @@ static void progress_handler(enum ami_event_status status, uint64_t ctr, void *d
 /* Global variables                                                          */
 /*****************************************************************************/
 
+/* The API passes no data to the copy progress handler. */
+static struct copy_progress copy_progress = { 0 };
+
 /*
  * h: Help
  * d: Device
@@ -93,6 +127,8 @@ static const char help_msg[] = \
 	"\t-d <b>:[d].[f]             Specify the device BDF\r\n"
 	"\t-i <device:partition>      Device (primary or secondary):Partition to copy from (source)\r\n"
 	"\t-p <device:partition>      Device (primary or secondary):Partition to copy to (destination)\r\n"
+	"\r\nThe measured copy throughput is saved per card model (in\r\n"
+	"$XDG_CACHE_HOME/ami_tool/throughput) to refine later time estimates.\r\n"
 ;
 
 struct app_cmd cmd_cfgmem_copy = {
@@ -100,34 +136,73 @@ struct app_cmd cmd_cfgmem_copy = {
 	.short_options = short_options,
 	.long_options  = long_options,
 	.root_required = true,
-	.help_msg      = help_msg
+	.help_msg      = help_msg,
+	.needs         = APP_NEEDS_DEVICES
 };
 
 /*****************************************************************************/
 /* Function implementations                                                  */
 /*****************************************************************************/
 
-/**
- * Display "dumb" progress to the user.
+/*
+ * Display the elapsed time against the estimate.
  */
 static void progress_handler(enum ami_event_status status, uint64_t ctr, void *data)
 {
-	putchar('.');
+	uint64_t elapsed = elapsed_ms(&copy_progress.start);
+	uint64_t est = copy_progress.est_ms;
+
+	/* Don't claim completion before the copy has returned. */
+	copy_progress.state = print_progress_bar(
+		(elapsed < est) ? elapsed : est - (est / PROGRESS_BAR_WIDTH),
+		est,
+		PROGRESS_BAR_WIDTH,
+		'[',
+		']',
+		'#',
+		'.',
+		copy_progress.state
+	);
+
+	if (elapsed < est)
+		printf("ETA %llus   ", (unsigned long long)
+			((est - elapsed + SECOND_IN_MS - 1) / SECOND_IN_MS));
+	else
+		printf("overdue by %llus ", (unsigned long long)
+			((elapsed - est) / SECOND_IN_MS));
+
 	fflush(stdout);
 }
 
 /*
- * Local function to calc est copy duration.
+ * Throughput assumed for an unmeasured device model.
  */
-static uint32_t calc_est_time(uint32_t part_size)
+static struct app_rate default_rate(void)
 {
-	uint32_t est_dur_seconds = 0;
-	uint32_t est_num_chunks = 0;
-	/* calc est copy duration */
-	est_num_chunks = (part_size + ((PDI_CHUNK_SIZE * PDI_CHUNK_MULTIPLIER) - 1)) /
-						(PDI_CHUNK_SIZE * PDI_CHUNK_MULTIPLIER);
-	est_dur_seconds = ((est_num_chunks * COPY_CHUNK_DUR_MS) / SECOND_IN_MS) + 1;
-	return est_dur_seconds;
+	struct app_rate rate = { 0 };
+
+	/* One chunk per `COPY_CHUNK_DUR_MS` */
+	rate.bytes_per_sec = ((double)PDI_CHUNK_SIZE * PDI_CHUNK_MULTIPLIER *
+		SECOND_IN_MS) / COPY_CHUNK_DUR_MS;
+	rate.samples = 0;
+
+	return rate;
+}
+
+/*
+ * Time since `start`.
+ */
+static uint64_t elapsed_ms(const struct timespec *start)
+{
+	struct timespec now = { 0 };
+	int64_t ms = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	ms = ((int64_t)(now.tv_sec - start->tv_sec) * SECOND_IN_MS) +
+		((now.tv_nsec - start->tv_nsec) / NS_IN_MS);
+
+	return (ms < 0) ? 0 : (uint64_t)ms;
 }
 
 /**
@@ -157,7 +232,12 @@ static int do_cmd_cfgmem_copy(struct app_option *options, int num_args, char **a
 	uint32_t dest_device = 0;
 	uint32_t dest_partition = 0;
 	struct ami_fpt_partition part = { 0 };
-	uint32_t est_dur_seconds = 0;
+	uint32_t copy_size = 0;
+	struct app_rate rate = default_rate();
+	char rate_id[APP_RATE_KEY_LEN] = { 0 };
+	char rate_str[APP_RATE_STR_LEN] = { 0 };
+	bool have_key = false;
+	uint64_t took_ms = 0;
 
 	/* Must have device, source partition, destination partition. */
 	if (!options) {
@@ -176,7 +256,7 @@ static int do_cmd_cfgmem_copy(struct app_option *options, int num_args, char **a
 	}
 
 	/* Find device */
-	if (ami_dev_find(device->arg, &dev) != AMI_STATUS_OK) {
+	if (app_dev_find(device->arg, &dev) != AMI_STATUS_OK) {
 		APP_API_ERROR("could not find the requested device");
 		return AMI_STATUS_ERROR;
 	}
@@ -246,7 +326,7 @@ static int do_cmd_cfgmem_copy(struct app_option *options, int num_args, char **a
 		return EXIT_FAILURE;
 	}
 
-	est_dur_seconds = calc_est_time(part.size);
+	copy_size = part.size;
 
 	/* Validate destination partition type */
 	ret = ami_prog_get_fpt_partition(dev, dest_device, dest_partition, &part);
@@ -263,8 +343,21 @@ static int do_cmd_cfgmem_copy(struct app_option *options, int num_args, char **a
 		return EXIT_FAILURE;
 	}
 
-	printf("Estimated time to copy partition: %d (seconds)\r\n",
-			est_dur_seconds);
+	/* Seed the estimate with the throughput measured on this card model. */
+	have_key = (rate_key(dev, COPY_RATE_OP, rate_id, sizeof(rate_id)) == EXIT_SUCCESS);
+
+	if (have_key)
+		rate_load(rate_id, &rate);
+
+	rate_format(rate_str, sizeof(rate_str), rate.bytes_per_sec);
+	copy_progress.est_ms = rate_estimate_ms(&rate, copy_size);
+	copy_progress.state = 0;
+
+	printf("Estimated time to copy partition: %llu (seconds) at %s%s\r\n",
+		(unsigned long long)((copy_progress.est_ms + SECOND_IN_MS - 1) / SECOND_IN_MS),
+		rate_str, (rate.samples == 0) ? " (default)" : "");
+
+	clock_gettime(CLOCK_MONOTONIC, &copy_progress.start);
 
 	ret = ami_prog_copy_partition(
 			dev,
@@ -274,12 +367,23 @@ static int do_cmd_cfgmem_copy(struct app_option *options, int num_args, char **a
 			dest_partition,
 			progress_handler
 		);
+	took_ms = elapsed_ms(&copy_progress.start);
 	printf("\r\n");
 
-	if (ret == AMI_STATUS_ERROR)
+	if (ret == AMI_STATUS_ERROR) {
 		APP_API_ERROR("could not copy partition");
-	else
-		printf("Done. Partition copied successfully.\r\n");
+	} else {
+		rate_update(&rate, copy_size, (double)took_ms / SECOND_IN_MS);
+		rate_format(rate_str, sizeof(rate_str), (double)copy_size *
+			SECOND_IN_MS / (took_ms ? took_ms : 1));
+
+		printf("Done. Partition copied successfully in %llu.%llus (%s).\r\n",
+			(unsigned long long)(took_ms / SECOND_IN_MS),
+			(unsigned long long)((took_ms % SECOND_IN_MS) / 100), rate_str);
+
+		if (have_key && (rate_store(rate_id, &rate) != EXIT_SUCCESS))
+			APP_WARN("could not save the measured copy throughput");
+	}
 
 	ami_dev_delete(&dev);
 	return ret;
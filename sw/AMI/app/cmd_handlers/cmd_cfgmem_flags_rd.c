@@ -75,7 +75,8 @@ struct app_cmd cmd_cfgmem_flags_rd = {
 	.short_options = short_options,
 	.long_options  = long_options,
 	.root_required = false,
-	.help_msg      = help_msg
+	.help_msg      = help_msg,
+	.needs         = APP_NEEDS_DEVICES
 };
 
 /*****************************************************************************/
@@ -144,7 +145,7 @@ static int do_cmd_cfgmem_flags_rd(struct app_option *options, int num_args, char
 	}
 
 	/* Find device */
-	if (ami_dev_find(device->arg, &dev) != AMI_STATUS_OK) {
+	if (app_dev_find(device->arg, &dev) != AMI_STATUS_OK) {
 		APP_API_ERROR("could not find the requested device");
 		return AMI_STATUS_ERROR;
 	}
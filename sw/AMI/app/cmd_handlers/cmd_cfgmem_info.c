@@ -20,6 +20,7 @@
 /* App includes */
 #include "meta.h"
 #include "commands.h"
+#include "fanout.h"
 
 /*****************************************************************************/
 /* Function declarations                                                     */
@@ -38,6 +39,16 @@
  */
 static int do_cmd_cfgmem_info(struct app_option *options, int num_args, char **args);
 
+/**
+ * cfgmem_info_job() - Print the FPT information of a single device.
+ * @dev: Device handle.
+ * @options: Options passed in at the command line.
+ * @data: Pointer to the selected boot device.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+static int cfgmem_info_job(ami_device *dev, struct app_option *options, void *data);
+
 /*****************************************************************************/
 /* Global variables                                                          */
 /*****************************************************************************/
@@ -62,8 +73,9 @@ static const char help_msg[] = \
 	"\r\nOptions:\r\n"
 	"\t-h --help            Show this screen\r\n"
 	"\t-d <b>:[d].[f]       Specify the device BDF\r\n"
+	"\t                     (a comma-separated list or 'all' for several devices)\r\n"
 	"\t-t <type>            Specify the boot device type (primary or secondary)\r\n"
-	"\t-f <table|json>      Set the output format\r\n"
+	"\t-f <table|json|cbor> Set the output format\r\n"
 	"\t-o <file>            Specify output file\r\n"
 ;
 
@@ -72,13 +84,22 @@ struct app_cmd cmd_cfgmem_info = {
 	.short_options = short_options,
 	.long_options  = long_options,
 	.root_required = false,
-	.help_msg      = help_msg
+	.help_msg      = help_msg,
+	.needs         = APP_NEEDS_DEVICES
 };
 
 /*****************************************************************************/
 /* Function implementations                                                  */
 /*****************************************************************************/
 
+/*
+ * Per-device part of the "cfgmem_info" command.
+ */
+static int cfgmem_info_job(ami_device *dev, struct app_option *options, void *data)
+{
+	return print_fpt_info(dev, *(int*)data, options);
+}
+
 /**
  * "cfgmem_info" command callback.
  * @options:  Ordered list of options passed in at the command line
@@ -92,13 +113,11 @@ struct app_cmd cmd_cfgmem_info = {
  */
 static int do_cmd_cfgmem_info(struct app_option *options, int num_args, char **args)
 {
-	int ret = EXIT_FAILURE;
 	/* Required options */
 	struct app_option *device = NULL;
 	struct app_option *boot_device_type = NULL;
 
 	/* Required data */
-	ami_device *dev = NULL;
 	int selected_boot_device = 0;
 
 	/* Must have device at least. */
@@ -125,14 +144,10 @@ static int do_cmd_cfgmem_info(struct app_option *options, int num_args, char **a
 		return AMI_STATUS_ERROR;
 	}
 
-	/* Find device */
-	if (ami_dev_find(device->arg, &dev) != AMI_STATUS_OK) {
-		APP_API_ERROR("could not find the requested device");
-		return AMI_STATUS_ERROR;
-	}
-
-	ret = print_fpt_info(dev, selected_boot_device, options);
-
-	ami_dev_delete(&dev);
-	return ret;
+	return for_each_device(
+		device->arg,
+		options,
+		&cfgmem_info_job,
+		&selected_boot_device
+	);
 }
@@ -10,6 +10,7 @@
 #include <stddef.h>
 #include <stdio.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
 #include <getopt.h>
 #include <unistd.h>
@@ -66,11 +67,13 @@ static void progress_handler(enum ami_event_status status, uint64_t ctr, void *d
  * p: Partition number
  * y: Skip user confirmation
  * q: Quit after programming
+ * s: Skip programming if the partition already holds the image
  */
-static const char short_options[] = "hd:t:i:p:yq";
+static const char short_options[] = "hd:t:i:p:yqs";
 
 static const struct option long_options[] = {
 	{ "help", no_argument, NULL, 'h' },  /* help screen */
+	{ "skip-if-identical", no_argument, NULL, 's' },  /* digest check */
 	{ },
 };
 
@@ -78,7 +81,7 @@ static const char help_msg[] = \
 	"cfgmem_program - program a PDI onto the target device\r\n"
 	"\r\nThis command requires root/sudo permissions.\r\n"
 	"\r\nUsage:\r\n"
-	"\t" APP_NAME " cfgmem_program -d <bdf> -t <type> -i <path> -p <n> [-y | -q]\r\n"
+	"\t" APP_NAME " cfgmem_program -d <bdf> -t <type> -i <path> -p <n> [-y | -q | -s]\r\n"
 	"\r\nOptions:\r\n"
 	"\t-h --help             Show this screen\r\n"
 	"\t-d <b>:[d].[f]        Specify the device BDF\r\n"
@@ -87,6 +90,8 @@ static const char help_msg[] = \
 	"\t-p <partition>        Partition to flash\r\n"
 	"\t-y                    Skip confirmation\r\n"
 	"\t-q                    Quit after programming\r\n"
+	"\t-s --skip-if-identical Skip programming if the partition already\r\n"
+	"\t                      holds the image (compared by MD5 digest)\r\n"
 ;
 
 struct app_cmd cmd_cfgmem_program = {
@@ -94,7 +99,8 @@ struct app_cmd cmd_cfgmem_program = {
 	.short_options	= short_options,
 	.long_options	= long_options,
 	.root_required	= true,
-	.help_msg		= help_msg
+	.help_msg		= help_msg,
+	.needs		= APP_NEEDS_DEVICES
 };
 
 /*****************************************************************************/
@@ -196,7 +202,7 @@ static int do_cmd_cfgmem_program(struct app_option *options, int num_args, char
 	}
 
 	/* Find device */
-	if (ami_dev_find(device->arg, &dev) != AMI_STATUS_OK) {
+	if (app_dev_find(device->arg, &dev) != AMI_STATUS_OK) {
 		APP_API_ERROR("could not find the requested device");
 		return AMI_STATUS_ERROR;
 	}
@@ -253,6 +259,28 @@ static int do_cmd_cfgmem_program(struct app_option *options, int num_args, char
 		partition_number
 	);
 
+	if (NULL != find_app_option('s', options)) {
+		bool match = false;
+
+		printf("\r\nComparing image against partition %d...\r\n", partition_number);
+
+		if (ami_prog_partition_matches(dev, image->arg, selected_boot_device,
+				partition_number, &match) != AMI_STATUS_OK) {
+			APP_API_ERROR("could not compare image against partition");
+			ami_dev_delete(&dev);
+			return EXIT_FAILURE;
+		}
+
+		if (match) {
+			printf("\r\nOK. Partition %d already holds this image, skipping.\r\n",
+				partition_number);
+			ami_dev_delete(&dev);
+			return EXIT_SUCCESS;
+		}
+
+		printf("Partition contents differ from image.\r\n");
+	}
+
 	if ((NULL != find_app_option('y', options)) || confirm_action(APP_CONFIRM_PROMPT, 'Y', 3)) {
 		printf("\r\nUpdating base flash image...\r\n");
 
@@ -19,6 +19,7 @@
 
 /* App includes */
 #include "commands.h"
+#include "apputils.h"
 
 /*****************************************************************************/
 /* Function declarations                                                     */
@@ -79,7 +80,8 @@ struct app_cmd cmd_debug_verbosity = {
 	.short_options = short_options,
 	.long_options  = long_options,
 	.root_required = false,
-	.help_msg      = help_msg
+	.help_msg      = help_msg,
+	.needs         = APP_NEEDS_DEVICES
 };
 
 /*****************************************************************************/
@@ -158,7 +160,7 @@ static int do_cmd_debug_verbosity(struct app_option *options, int num_args, char
 	}
 
 	/* Find device */
-	if (ami_dev_find(device->arg, &dev) != AMI_STATUS_OK) {
+	if (app_dev_find(device->arg, &dev) != AMI_STATUS_OK) {
 		APP_API_ERROR("could not find the requested device");
 		return EXIT_FAILURE;
 	}
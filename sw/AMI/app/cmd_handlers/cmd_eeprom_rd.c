@@ -21,6 +21,25 @@
 #include "apputils.h"
 #include "amiapp.h"
 #include "printer.h"
+#include "fanout.h"
+
+/*****************************************************************************/
+/* Structs                                                                   */
+/*****************************************************************************/
+
+/**
+ * struct eeprom_rd_args - Parsed "eeprom_rd" arguments.
+ * @offset: Offset to read from.
+ * @num: Number of bytes to read.
+ * @all: Read the whole EEPROM.
+ * @output: Output file (NULL to print a hexdump).
+ */
+struct eeprom_rd_args {
+	uint8_t offset;
+	uint32_t num;
+	bool all;
+	const char *output;
+};
 
 /*****************************************************************************/
 /* Function declarations                                                     */
@@ -33,6 +52,16 @@
  */
 static int do_cmd_eeprom_rd(struct app_option *options, int num_args, char **args);
 
+/**
+ * eeprom_rd_job() - Read the EEPROM of a single device.
+ * @dev: Device handle.
+ * @options: Options passed in at the command line.
+ * @data: Pointer to the parsed `struct eeprom_rd_args`.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+static int eeprom_rd_job(ami_device *dev, struct app_option *options, void *data);
+
 /*****************************************************************************/
 /* Global variables                                                          */
 /*****************************************************************************/
@@ -43,11 +72,13 @@ static int do_cmd_eeprom_rd(struct app_option *options, int num_args, char **arg
  * a: Offset
  * l: length
  * o: Output file
+ * A: Read the whole EEPROM
  */
-static const char short_options[] = "hd:a:l:o:";
+static const char short_options[] = "hd:a:l:o:A";
 
 static const struct option long_options[] = {
 	{ "help", no_argument,  NULL, 'h' },  /* help screen */
+	{ "all",  no_argument,  NULL, 'A' },  /* whole EEPROM */
 	{ },
 };
 
@@ -55,12 +86,15 @@ static const char help_msg[] = \
 	"eeprom_rd - Read the device EEPROM\r\n"
 	"\r\nUsage:\r\n"
 	"\t" APP_NAME " eeprom_rd -d <bdf> -a <addr>\r\n"
+	"\t" APP_NAME " eeprom_rd -d <bdf> -A\r\n"
 	"\r\nOptions:\r\n"
 	"\t-h --help          Show this screen\r\n"
 	"\t-d <b>:[d].[f]     Specify the device BDF\r\n"
+	"\t                   (a comma-separated list or 'all' for several devices)\r\n"
 	"\t-a <addr>          Specify the offset to read from\r\n"
 	"\t-l <len>           Number of registers to read (default=1)\r\n"
 	"\t-o <file>          Output file\r\n"
+	"\t-A --all           Read the whole EEPROM\r\n"
 ;
 
 struct app_cmd cmd_eeprom_rd = {
@@ -68,13 +102,67 @@ struct app_cmd cmd_eeprom_rd = {
 	.short_options = short_options,
 	.long_options  = long_options,
 	.root_required = false,
-	.help_msg      = help_msg
+	.help_msg      = help_msg,
+	.needs         = APP_NEEDS_DEVICES
 };
 
 /*****************************************************************************/
 /* Function implementations                                                  */
 /*****************************************************************************/
 
+/*
+ * Per-device part of the "eeprom_rd" command.
+ */
+static int eeprom_rd_job(ami_device *dev, struct app_option *options, void *data)
+{
+	int ret = EXIT_FAILURE;
+	struct eeprom_rd_args *rd = (struct eeprom_rd_args*)data;
+	uint16_t bdf = 0;
+	uint8_t *buf = NULL;
+
+	ami_dev_get_pci_bdf(dev, &bdf);
+
+	my_fprintf(
+		NULL,
+		"Reading %u byte(s) from device %02x:%02x.%01x"
+		" at offset 0x%02x\r\n\r\n",
+		rd->num, AMI_PCI_BUS(bdf), AMI_PCI_DEV(bdf), AMI_PCI_FUNC(bdf),
+		rd->offset
+	);
+
+	buf = (uint8_t*)calloc(rd->num, sizeof(uint8_t));
+
+	if (buf) {
+		if (rd->all)
+			ret = ami_eeprom_read_all(dev, 0, buf);
+		else
+			ret = ami_eeprom_read(dev, rd->offset, (uint8_t)rd->num, buf);
+
+		if (ret == AMI_STATUS_OK) {
+			ret = EXIT_SUCCESS;
+
+			if (rd->output) {
+				if (write_hex_data(rd->output, buf, rd->num, sizeof(uint8_t)) == EXIT_SUCCESS) {
+					my_fprintf(NULL, "Data written to output file.\r\n");
+				} else {
+					APP_ERROR("could not write data to output file");
+				}
+			} else {
+				print_hexdump(rd->offset, buf, rd->num, APP_HEXDUMP_GROUPS_8, sizeof(uint8_t));
+			}
+		} else {
+			ret = EXIT_FAILURE;
+			APP_API_ERROR("could not read data");
+		}
+
+		free(buf);
+	} else {
+		APP_ERROR("could not allocate memory");
+	}
+
+	return ret;
+}
+
 /**
  * "eeprom_rd" command callback.
  * @options:  Ordered list of options passed in at the command line
@@ -88,17 +176,16 @@ struct app_cmd cmd_eeprom_rd = {
  */
 static int do_cmd_eeprom_rd(struct app_option *options, int num_args, char **args)
 {
-	int ret = EXIT_FAILURE;
 	struct app_option *opt = NULL;
 	struct app_option *device = NULL;
-	ami_device *dev = NULL;
-	uint16_t bdf = 0;
 
 	/* Positional arguments */
-	uint8_t offset = 0;
-	uint8_t num = 1;  /* Default to a single register */
-
-	uint8_t *buf = NULL;
+	struct eeprom_rd_args rd = {
+		.offset = 0,
+		.num = 1,  /* Default to a single register */
+		.all = false,
+		.output = NULL
+	};
 
 	if (!options) {
 		APP_USER_ERROR("not enough options", help_msg);
@@ -119,61 +206,28 @@ static int do_cmd_eeprom_rd(struct app_option *options, int num_args, char **arg
 			APP_ERROR("output file already exists");
 			return EXIT_FAILURE;
 		}
-	}
 
-	/* Offset */
-	if (!(opt = find_app_option('a', options))) {
-		APP_USER_ERROR("Offset not specified", help_msg);
-		return EXIT_FAILURE;
-	} else {
-		offset = (uint8_t)strtoul(opt->arg, NULL, 0);
-	}
-
-	/* Size */
-	if ((opt = find_app_option('l', options)) != NULL) {
-		num = (uint8_t)strtoul(opt->arg, NULL, 0);
-	}
-
-	/* Find device */
-	if (ami_dev_find(device->arg, &dev) != AMI_STATUS_OK) {
-		APP_API_ERROR("could not find the requested device");
-		return EXIT_FAILURE;
+		rd.output = opt->arg;
 	}
 
-	ami_dev_get_pci_bdf(dev, &bdf);
-
-	printf(
-		"Reading %d byte(s) from device %02x:%02x.%01x"
-		" at offset 0x%02x\r\n\r\n",
-		num, AMI_PCI_BUS(bdf), AMI_PCI_DEV(bdf), AMI_PCI_FUNC(bdf), offset
-	);
-
-	buf = (uint8_t*)calloc(num, sizeof(uint8_t));
-
-	if (buf) {
-		ret = ami_eeprom_read(dev, offset, num, buf);
-
-		if (ret == AMI_STATUS_OK) {
-			ret = EXIT_SUCCESS;
-
-			if ((opt = find_app_option('o', options))) {
-				if (write_hex_data(opt->arg, buf, num, sizeof(uint8_t)) == EXIT_SUCCESS) {
-					printf("Data written to output file.\r\n");
-				} else {
-					APP_ERROR("could not write data to output file");
-				}
-			} else {
-				print_hexdump(offset, buf, num, APP_HEXDUMP_GROUPS_8, sizeof(uint8_t));
-			}
+	if (find_app_option('A', options)) {
+		/* Whole EEPROM */
+		rd.all = true;
+		rd.num = AMI_EEPROM_SIZE;
+	} else {
+		/* Offset */
+		if (!(opt = find_app_option('a', options))) {
+			APP_USER_ERROR("Offset not specified", help_msg);
+			return EXIT_FAILURE;
 		} else {
-			APP_API_ERROR("could not read data");
+			rd.offset = (uint8_t)strtoul(opt->arg, NULL, 0);
 		}
 
-		free(buf);
-	} else {
-		APP_ERROR("could not allocate memory");
+		/* Size */
+		if ((opt = find_app_option('l', options)) != NULL) {
+			rd.num = (uint8_t)strtoul(opt->arg, NULL, 0);
+		}
 	}
 
-	ami_dev_delete(&dev);
-	return ret;
+	return for_each_device(device->arg, options, &eeprom_rd_job, &rd);
 }
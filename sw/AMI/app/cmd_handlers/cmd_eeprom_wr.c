@@ -70,7 +70,8 @@ struct app_cmd cmd_eeprom_wr = {
 	.short_options = short_options,
 	.long_options  = long_options,
 	.root_required = false,
-	.help_msg      = help_msg
+	.help_msg      = help_msg,
+	.needs         = APP_NEEDS_DEVICES
 };
 
 /*****************************************************************************/
@@ -113,7 +114,7 @@ static int do_cmd_eeprom_wr(struct app_option *options, int num_args, char **arg
 	}
 
 	/* Find device */
-	if (ami_dev_find(opt->arg, &dev) != AMI_STATUS_OK) {
+	if (app_dev_find(opt->arg, &dev) != AMI_STATUS_OK) {
 		APP_API_ERROR("could not find the requested device");
 		return EXIT_FAILURE;
 	}
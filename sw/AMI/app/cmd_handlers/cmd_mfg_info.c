@@ -19,6 +19,7 @@
 /* App includes */
 #include "commands.h"
 #include "meta.h"
+#include "fanout.h"
 
 /*****************************************************************************/
 /* Function declarations                                                     */
@@ -37,6 +38,16 @@
  */
 static int do_cmd_mfg_info(struct app_option *options, int num_args, char **args);
 
+/**
+ * mfg_info_job() - Print the "mfg_info" information of a single device.
+ * @dev: Device handle.
+ * @options: Options passed in at the command line.
+ * @data: Not used.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+static int mfg_info_job(ami_device *dev, struct app_option *options, void *data);
+
 /*****************************************************************************/
 /* Global variables                                                          */
 /*****************************************************************************/
@@ -61,7 +72,8 @@ static const char help_msg[] = \
 	"\r\nOptions:\r\n"
 	"\t-h --help            Show this screen\r\n"
 	"\t-d <b>:[d].[f]       Specify the device BDF\r\n"
-	"\t-f <table|json>      Set the output format\r\n"
+	"\t                     (a comma-separated list or 'all' for several devices)\r\n"
+	"\t-f <table|json|cbor> Set the output format\r\n"
 	"\t-o <file>            Specify output file\r\n"
 ;
 
@@ -70,13 +82,22 @@ struct app_cmd cmd_mfg_info = {
 	.short_options = short_options,
 	.long_options  = long_options,
 	.root_required = false,
-	.help_msg      = help_msg
+	.help_msg      = help_msg,
+	.needs         = APP_NEEDS_DEVICES
 };
 
 /*****************************************************************************/
 /* Function implementations                                                  */
 /*****************************************************************************/
 
+/*
+ * Per-device part of the "mfg_info" command.
+ */
+static int mfg_info_job(ami_device *dev, struct app_option *options, void *data)
+{
+	return print_mfg_info(dev, options);
+}
+
 /**
  * "mfg_info" command callback.
  * @options:  Ordered list of options passed in at the command line
@@ -90,9 +111,7 @@ struct app_cmd cmd_mfg_info = {
  */
 static int do_cmd_mfg_info(struct app_option *options, int num_args, char **args)
 {
-	int ret = EXIT_FAILURE;
 	struct app_option *device = NULL;
-	ami_device *dev = NULL;
 
 	/* Must have at least a device. */
 	if (!options) {
@@ -108,13 +127,5 @@ static int do_cmd_mfg_info(struct app_option *options, int num_args, char **args
 		return EXIT_FAILURE;
 	}
 
-	/* Find device */
-	if (ami_dev_find(device->arg, &dev) != AMI_STATUS_OK) {
-		APP_API_ERROR("could not find the requested device");
-		return EXIT_FAILURE;
-	}
-
-	ret = print_mfg_info(dev, options);
-	ami_dev_delete(&dev);
-	return ret;
+	return for_each_device(device->arg, options, &mfg_info_job, NULL);
 }
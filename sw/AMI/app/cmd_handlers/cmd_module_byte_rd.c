@@ -22,6 +22,27 @@
 #include "apputils.h"
 #include "amiapp.h"
 #include "printer.h"
+#include "fanout.h"
+
+/*****************************************************************************/
+/* Structs                                                                   */
+/*****************************************************************************/
+
+/**
+ * struct module_byte_rd_args - Parsed "module_byte_rd" arguments.
+ * @cage: Cage (module) ID.
+ * @page: Page number.
+ * @off: Byte offset.
+ * @num: Number of bytes to read.
+ * @all: Read the whole page.
+ */
+struct module_byte_rd_args {
+	uint8_t cage;
+	uint8_t page;
+	uint32_t off;
+	uint32_t num;
+	bool all;
+};
 
 /*****************************************************************************/
 /* Function declarations                                                     */
@@ -40,6 +61,16 @@
  */
 static int do_cmd_module_byte_rd(struct app_option *options, int num_args, char **args);
 
+/**
+ * module_byte_rd_job() - Read module bytes from a single device.
+ * @dev: Device handle.
+ * @options: Options passed in at the command line.
+ * @data: Pointer to the parsed `struct module_byte_rd_args`.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+static int module_byte_rd_job(ami_device *dev, struct app_option *options, void *data);
+
 /*****************************************************************************/
 /* Global variables                                                          */
 /*****************************************************************************/
@@ -50,24 +81,31 @@ static int do_cmd_module_byte_rd(struct app_option *options, int num_args, char
  * c: Cage (module) ID
  * p: Page number
  * b: Byte offset
+ * l: Length
+ * A: Read the whole page
  */
-static const char short_options[] = "hd:c:p:b:";
+static const char short_options[] = "hd:c:p:b:l:A";
 
 static const struct option long_options[] = {
 	{ "help", no_argument, NULL, 'h' },  /* help screen */
+	{ "all",  no_argument, NULL, 'A' },  /* whole page */
 	{ },
 };
 
 static const char help_msg[] = \
 	"module_byte_rd - Read from a QSFP module\r\n"
 	"\r\nUsage:\r\n"
-	"\t" APP_NAME " module_byte_rd -d <bdf> -c <n> -p <n> -b <n>\r\n"
+	"\t" APP_NAME " module_byte_rd -d <bdf> -c <n> -p <n> -b <n> [-l <n>]\r\n"
+	"\t" APP_NAME " module_byte_rd -d <bdf> -c <n> -p <n> -A\r\n"
 	"\r\nOptions:\r\n"
 	"\t-h --help          Show this screen\r\n"
 	"\t-d <b>:[d].[f]     Specify the device BDF\r\n"
+	"\t                   (a comma-separated list or 'all' for several devices)\r\n"
 	"\t-c <cage>          Module ID to read from\r\n"
 	"\t-p <page>          Page number to read\r\n"
 	"\t-b <byte>          Specify the offset to read from\r\n"
+	"\t-l <len>           Number of bytes to read (default=1)\r\n"
+	"\t-A --all           Read the whole page (page 0 includes the lower page)\r\n"
 ;
 
 struct app_cmd cmd_module_byte_rd = {
@@ -75,13 +113,61 @@ struct app_cmd cmd_module_byte_rd = {
 	.short_options = short_options,
 	.long_options  = long_options,
 	.root_required = false,
-	.help_msg      = help_msg
+	.help_msg      = help_msg,
+	.needs         = APP_NEEDS_DEVICES
 };
 
 /*****************************************************************************/
 /* Function implementations                                                  */
 /*****************************************************************************/
 
+/*
+ * Per-device part of the "module_byte_rd" command.
+ */
+static int module_byte_rd_job(ami_device *dev, struct app_option *options, void *data)
+{
+	int ret = EXIT_FAILURE;
+	struct module_byte_rd_args *rd = (struct module_byte_rd_args*)data;
+	uint16_t bdf = 0;
+	uint8_t buf[AMI_MODULE_MAP_SIZE] = { 0 };
+
+	ami_dev_get_pci_bdf(dev, &bdf);
+
+	if (rd->num == 1) {
+		my_fprintf(
+			NULL,
+			"Reading byte 0x%02x from page %d (device %02x:%02x.%01x, cage %d)\r\n",
+			rd->off, rd->page, AMI_PCI_BUS(bdf), AMI_PCI_DEV(bdf), AMI_PCI_FUNC(bdf), rd->cage
+		);
+	} else {
+		my_fprintf(
+			NULL,
+			"Reading %u byte(s) at offset 0x%02x from page %d (device %02x:%02x.%01x, cage %d)\r\n\r\n",
+			rd->num, rd->off, rd->page, AMI_PCI_BUS(bdf), AMI_PCI_DEV(bdf), AMI_PCI_FUNC(bdf), rd->cage
+		);
+	}
+
+	if (rd->all)
+		ret = ami_module_read_page(dev, rd->cage, rd->page,
+			(rd->page == 0) ? (AMI_MODULE_READ_LOWER) : (0), buf);
+	else
+		ret = ami_module_read(dev, rd->cage, rd->page, (uint8_t)rd->off, (uint8_t)rd->num, buf);
+
+	if (ret == AMI_STATUS_OK) {
+		ret = EXIT_SUCCESS;
+
+		if (rd->num == 1)
+			my_fprintf(NULL, "Value 0x%02x\r\n", buf[0]);
+		else
+			print_hexdump(rd->off, buf, rd->num, APP_HEXDUMP_GROUPS_8, sizeof(uint8_t));
+	} else {
+		ret = EXIT_FAILURE;
+		APP_API_ERROR("could not read data");
+	}
+
+	return ret;
+}
+
 /**
  * "module_byte_rd" command callback.
  * @options:  Ordered list of options passed in at the command line
@@ -95,17 +181,17 @@ struct app_cmd cmd_module_byte_rd = {
  */
 static int do_cmd_module_byte_rd(struct app_option *options, int num_args, char **args)
 {
-	int ret = EXIT_FAILURE;
 	struct app_option *opt = NULL;
 	struct app_option *device = NULL;
-	ami_device *dev = NULL;
-	uint16_t bdf = 0;
-	uint8_t val = 0;
 
 	/* Parsed options */
-	uint8_t cage = 0;
-	uint8_t page = 0;
-	uint8_t off = 0;
+	struct module_byte_rd_args rd = {
+		.cage = 0,
+		.page = 0,
+		.off = 0,
+		.num = 1,
+		.all = false
+	};
 
 	if (!options) {
 		APP_USER_ERROR("not enough options", help_msg);
@@ -125,7 +211,7 @@ static int do_cmd_module_byte_rd(struct app_option *options, int num_args, char
 		APP_USER_ERROR("cage not specified", help_msg);
 		return EXIT_FAILURE;
 	} else {
-		cage = (uint8_t)strtoul(opt->arg, NULL, 0);
+		rd.cage = (uint8_t)strtoul(opt->arg, NULL, 0);
 	}
 
 	/* Page */
@@ -133,37 +219,32 @@ static int do_cmd_module_byte_rd(struct app_option *options, int num_args, char
 		APP_USER_ERROR("page not specified", help_msg);
 		return EXIT_FAILURE;
 	} else {
-		page = (uint8_t)strtoul(opt->arg, NULL, 0);
-	}
-
-	/* Offset */
-	if (!(opt = find_app_option('b', options))) {
-		APP_USER_ERROR("byte offset not specified", help_msg);
-		return EXIT_FAILURE;
-	} else {
-		off = (uint8_t)strtoul(opt->arg, NULL, 0);
-	}
-
-	/* Find device */
-	if (ami_dev_find(device->arg, &dev) != AMI_STATUS_OK) {
-		APP_API_ERROR("could not find the requested device");
-		return EXIT_FAILURE;
+		rd.page = (uint8_t)strtoul(opt->arg, NULL, 0);
 	}
 
-	ami_dev_get_pci_bdf(dev, &bdf);
-
-	printf(
-		"Reading byte 0x%02x from page %d (device %02x:%02x.%01x, cage %d)\r\n",
-		off, page, AMI_PCI_BUS(bdf), AMI_PCI_DEV(bdf), AMI_PCI_FUNC(bdf), cage
-	);
-
-	if (ami_module_read( dev, cage, page, off, 1, &val) == AMI_STATUS_OK) {
-		ret = EXIT_SUCCESS;
-		printf("Value 0x%02x\r\n", val);
+	if (find_app_option('A', options)) {
+		/* Whole page - the lower page is only addressable as page 0 */
+		rd.all = true;
+		rd.off = (rd.page == 0) ? (0) : (AMI_MODULE_PAGE_SIZE);
+		rd.num = AMI_MODULE_MAP_SIZE - rd.off;
 	} else {
-		APP_API_ERROR("could not read data");
+		/* Offset */
+		if (!(opt = find_app_option('b', options))) {
+			APP_USER_ERROR("byte offset not specified", help_msg);
+			return EXIT_FAILURE;
+		} else {
+			rd.off = (uint8_t)strtoul(opt->arg, NULL, 0);
+		}
+
+		/* Length */
+		if ((opt = find_app_option('l', options)) != NULL)
+			rd.num = (uint32_t)strtoul(opt->arg, NULL, 0);
+
+		if ((rd.num == 0) || ((rd.off + rd.num) > AMI_MODULE_MAP_SIZE)) {
+			APP_USER_ERROR("invalid length", help_msg);
+			return EXIT_FAILURE;
+		}
 	}
 
-	ami_dev_delete(&dev);
-	return ret;
+	return for_each_device(device->arg, options, &module_byte_rd_job, &rd);
 }
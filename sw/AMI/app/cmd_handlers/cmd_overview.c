@@ -2,7 +2,7 @@
 /*
  * cmd_overview.c - This file contains the implementation for the command "overview"
  *
- * Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+ * Copyright (c) 2023-2026 Advanced Micro Devices, Inc. All rights reserved.
  */
 
 /* Standard includes */
@@ -39,14 +39,17 @@ static int do_cmd_overview(struct app_option *options, int num_args, char **args
 
 /*
  * h: Help
+ * d: Device(s)
  * f: Output format
  * o: Output file
  * v: Verbose output
+ * F: Fields to show (long option only)
  */
-static const char short_options[] = "hf:o:v";
+static const char short_options[] = "hd:f:o:v";
 
 static const struct option long_options[] = {
-	{ "help", no_argument, NULL, 'h' },  /* help screen */
+	{ "help",   no_argument,       NULL, 'h' },  /* help screen */
+	{ "fields", required_argument, NULL, 'F' },  /* field projection */
 	{ },
 };
 
@@ -56,9 +59,12 @@ static const char help_msg[] = \
 	"\t" APP_NAME " overview [options...]\r\n"
 	"\r\nOptions:\r\n"
 	"\t-h --help            Show this screen\r\n"
-	"\t-f <table|json>      Set the output format\r\n"
+	"\t-d <bdf,...|all>     Only show the given devices (default: all)\r\n"
+	"\t-f <table|json|cbor> Set the output format\r\n"
 	"\t-o <file>            Specify output file\r\n"
 	"\t-v                   Print verbose information\r\n"
+	"\t--fields <f,...>     Only query and show the given fields, in order:\r\n"
+	"\t                     bdf, name, serial, uuid, amc, state, hwmon, cdev\r\n"
 ;
 
 struct app_cmd cmd_overview = {
@@ -66,7 +72,8 @@ struct app_cmd cmd_overview = {
 	.short_options = short_options,
 	.long_options  = long_options,
 	.root_required = false,
-	.help_msg      = help_msg
+	.help_msg      = help_msg,
+	.needs         = APP_NEEDS_DRIVER | APP_NEEDS_DEVICES
 };
 
 /*****************************************************************************/
@@ -95,7 +95,8 @@ struct app_cmd cmd_pdi_program = {
 	.short_options	= short_options,
 	.long_options	= long_options,
 	.root_required	= true,
-	.help_msg		= help_msg
+	.help_msg		= help_msg,
+	.needs		= APP_NEEDS_DEVICES
 };
 
 /*****************************************************************************/
@@ -181,7 +182,7 @@ static int do_cmd_pdi_program(struct app_option *options, int num_args, char **a
 	}
 
 	/* Find device */
-	if (ami_dev_find(device->arg, &dev) != AMI_STATUS_OK) {
+	if (app_dev_find(device->arg, &dev) != AMI_STATUS_OK) {
 		APP_API_ERROR("could not find the requested device");
 		return AMI_STATUS_ERROR;
 	}
@@ -99,7 +99,8 @@ struct app_cmd cmd_reload = {
 	.short_options = short_options,
 	.long_options  = long_options,
 	.root_required = true,
-	.help_msg      = help_msg
+	.help_msg      = help_msg,
+	.needs         = APP_NEEDS_DEVICES
 };
 
 /*****************************************************************************/
@@ -16,6 +16,7 @@
 #include "commands.h"
 #include "apputils.h"
 #include "sensors.h"
+#include "fanout.h"
 
 /*****************************************************************************/
 /* Function declarations                                                     */
@@ -34,6 +35,16 @@
  */
 static int do_cmd_sensors(struct app_option *options, int num_args, char **args);
 
+/**
+ * sensors_job() - Print the sensors of a single device.
+ * @dev: Device handle.
+ * @options: Options passed in at the command line.
+ * @data: Not used.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+static int sensors_job(ami_device *dev, struct app_option *options, void *data);
+
 /*****************************************************************************/
 /* Global variables                                                          */
 /*****************************************************************************/
@@ -46,14 +57,18 @@ static int do_cmd_sensors(struct app_option *options, int num_args, char **args)
  * o: Output file
  * n: Sensor name
  * x: Extra attributes
+ * w: Watch interval
+ * W: Watch statistics window
  *
  * `x` can be specified multiple times or passed in as a comma-separated list
  * `f` must be specified together with `o`
  */
-static const char short_options[] = "hd:vf:o:n:x:";
+static const char short_options[] = "hd:vf:o:n:x:w:W:";
 
 static const struct option long_options[] = {
-	{ "help", no_argument, NULL, 'h' },  /* help screen */
+	{ "help", no_argument, NULL, 'h' },          /* help screen */
+	{ "watch", required_argument, NULL, 'w' },   /* watch mode */
+	{ "window", required_argument, NULL, 'W' },  /* watch window */
 	{ },
 };
 
@@ -64,13 +79,18 @@ static const char help_msg[] = \
 	"\r\nOptions:\r\n"
 	"\t-h --help             Show this screen.\r\n"
 	"\t-d <b>:[d].[f]        Specify the device BDF\r\n"
-	"\t-f <table|json>       Set the output format\r\n"
+	"\t                      (a comma-separated list or 'all' for several devices)\r\n"
+	"\t-f <table|json|cbor>  Set the output format\r\n"
 	"\t-o <file>             Specify output file\r\n"
 	"\t-n <sensor>           Fetch specific sensor\r\n"
 	"\t-x <field,...>        Print extra fields\r\n"
 	"\t                      Possible values are:\r\n"
 	"\t                        {max, average, limits}\r\n"
 	"\t-v                    Print all extra fields\r\n"
+	"\t-w --watch <ms>       Keep redrawing the table every <ms> milliseconds\r\n"
+	"\t                      (requires -d, cannot be used with -o, -f, -x, -v)\r\n"
+	"\t-W --window <n>       In watch mode, add min/max/average columns\r\n"
+	"\t                      over the last <n> samples\r\n"
 ;
 
 struct app_cmd cmd_sensors = {
@@ -78,13 +98,22 @@ struct app_cmd cmd_sensors = {
 	.short_options = short_options,
 	.long_options  = long_options,
 	.root_required = false,
-	.help_msg      = help_msg
+	.help_msg      = help_msg,
+	.needs         = APP_NEEDS_DEVICES | APP_NEEDS_SENSORS
 };
 
 /*****************************************************************************/
 /* Function implementations                                                  */
 /*****************************************************************************/
 
+/*
+ * Per-device part of the "sensors" command.
+ */
+static int sensors_job(ami_device *dev, struct app_option *options, void *data)
+{
+	return report_device_sensors(dev, options);
+}
+
 /**
  * "sensors" command callback.
  * @options:  Ordered list of options passed in at the command line
@@ -98,6 +127,26 @@ struct app_cmd cmd_sensors = {
  */
 static int do_cmd_sensors(struct app_option *options, int num_args, char **args)
 {
+	struct app_option *device = find_app_option('d', options);
+	bool watch = (find_app_option('w', options) != NULL);
+
 	/* options are not required */
+	if (!watch && find_app_option('W', options)) {
+		APP_USER_ERROR("-W can only be used together with --watch", help_msg);
+		return EXIT_FAILURE;
+	}
+
+	/* Watch mode redraws a single table, so it cannot fan out. */
+	if (watch && device && is_device_list(device->arg)) {
+		APP_USER_ERROR("--watch cannot be used with several devices", help_msg);
+		return EXIT_FAILURE;
+	}
+
+	if (watch)
+		return watch_sensors(options);
+
+	if (device && is_device_list(device->arg))
+		return for_each_device(device->arg, options, &sensors_job, NULL);
+
 	return report_sensors(options);
 }
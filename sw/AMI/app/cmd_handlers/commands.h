@@ -74,4 +74,7 @@ extern struct app_cmd cmd_module_byte_wr;
 /* "debug_verbosity" handler */
 extern struct app_cmd cmd_debug_verbosity;
 
+/* "batch" handler */
+extern struct app_cmd cmd_batch;
+
 #endif /* AMI_APP_COMMANDS_H */
@@ -0,0 +1,480 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * fanout.c - This file contains utilities for running commands against
+ *            several devices at once
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+/* Standard includes */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+
+/* API includes */
+#include "ami.h"
+#include "ami_device.h"
+
+/* App includes */
+#include "amiapp.h"
+#include "printer.h"
+#include "apputils.h"
+#include "fanout.h"
+
+/*****************************************************************************/
+/* Structs                                                                   */
+/*****************************************************************************/
+
+/**
+ * struct parallel_pool - State shared by the workers of `run_parallel`.
+ * @lock: Protects `next` and `ret`.
+ * @next: Index of the next job to run.
+ * @num_jobs: Total number of jobs.
+ * @job: Function to run for each job.
+ * @data: Data passed to `job`.
+ * @ret: Set to EXIT_FAILURE if any job failed.
+ */
+struct parallel_pool {
+	pthread_mutex_t lock;
+	int next;
+	int num_jobs;
+	app_parallel_job job;
+	void *data;
+	int ret;
+};
+
+/**
+ * struct open_ctx - Data for opening an explicit list of devices.
+ * @bdfs: BDF strings given by the user.
+ * @devs: Device handles, in the same order as `bdfs`.
+ */
+struct open_ctx {
+	char **bdfs;
+	ami_device **devs;
+};
+
+/**
+ * struct device_ctx - Data for running a command against several devices.
+ * @devs: Device handles.
+ * @caps: Captured output of each device.
+ * @options: Options passed in at the command line.
+ * @job: Command implementation.
+ * @data: Data passed to `job`.
+ */
+struct device_ctx {
+	ami_device **devs;
+	struct print_capture *caps;
+	struct app_option *options;
+	app_device_job job;
+	void *data;
+};
+
+/*****************************************************************************/
+/* Local function declarations                                               */
+/*****************************************************************************/
+
+/**
+ * parallel_worker() - Run jobs until there are none left.
+ * @arg: Pointer to the `struct parallel_pool`.
+ *
+ * Return: NULL
+ */
+static void *parallel_worker(void *arg);
+
+/**
+ * open_device() - Open a single device from an explicit list.
+ * @index: Index into the list.
+ * @data: Pointer to the `struct open_ctx`.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+static int open_device(int index, void *data);
+
+/**
+ * run_device_job() - Run a command against a single device, capturing
+ *   its output.
+ * @index: Index of the device.
+ * @data: Pointer to the `struct device_ctx`.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+static int run_device_job(int index, void *data);
+
+/**
+ * get_bdf_str() - Format the BDF of a device.
+ * @dev: Device handle.
+ * @bdf_str: Buffer to hold the BDF string.
+ *
+ * Return: None.
+ */
+static void get_bdf_str(ami_device *dev, char bdf_str[AMI_BDF_STR_LEN]);
+
+/**
+ * merge_output() - Print the captured output of all devices in order.
+ * @devs: Device handles.
+ * @caps: Captured output of each device.
+ * @num: Number of devices.
+ * @options: Options passed in at the command line.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+static int merge_output(ami_device **devs, struct print_capture *caps, int num,
+	struct app_option *options);
+
+/*****************************************************************************/
+/* Local function definitions                                                */
+/*****************************************************************************/
+
+/*
+ * Worker thread.
+ */
+static void *parallel_worker(void *arg)
+{
+	struct parallel_pool *pool = (struct parallel_pool*)arg;
+	int i = 0;
+
+	while (true) {
+		pthread_mutex_lock(&pool->lock);
+		i = pool->next++;
+		pthread_mutex_unlock(&pool->lock);
+
+		if (i >= pool->num_jobs)
+			break;
+
+		if (pool->job(i, pool->data) != EXIT_SUCCESS) {
+			pthread_mutex_lock(&pool->lock);
+			pool->ret = EXIT_FAILURE;
+			pthread_mutex_unlock(&pool->lock);
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Open a listed device.
+ */
+static int open_device(int index, void *data)
+{
+	struct open_ctx *ctx = (struct open_ctx*)data;
+
+	if (app_dev_find(ctx->bdfs[index], &ctx->devs[index]) != AMI_STATUS_OK) {
+		fprintf(
+			stderr,
+			"Error: could not find device %s\r\n%s",
+			ctx->bdfs[index],
+			ami_get_last_error()
+		);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Run a command on a worker thread.
+ */
+static int run_device_job(int index, void *data)
+{
+	struct device_ctx *ctx = (struct device_ctx*)data;
+	int ret = EXIT_FAILURE;
+
+	if (print_capture_begin(&ctx->caps[index]) != EXIT_SUCCESS) {
+		APP_ERROR("could not capture device output");
+		return EXIT_FAILURE;
+	}
+
+	ret = ctx->job(ctx->devs[index], ctx->options, ctx->data);
+	print_capture_end(&ctx->caps[index]);
+
+	return ret;
+}
+
+/*
+ * Format a device BDF.
+ */
+static void get_bdf_str(ami_device *dev, char bdf_str[AMI_BDF_STR_LEN])
+{
+	uint16_t bdf = 0;
+
+	if (ami_dev_get_pci_bdf(dev, &bdf) != AMI_STATUS_OK)
+		APP_WARN("could not retrieve device BDF");
+
+	snprintf(
+		bdf_str,
+		AMI_BDF_STR_LEN,
+		"%02x:%02x.%01x",
+		AMI_PCI_BUS(bdf),
+		AMI_PCI_DEV(bdf),
+		AMI_PCI_FUNC(bdf)
+	);
+}
+
+/*
+ * Merge device output.
+ */
+static int merge_output(ami_device **devs, struct print_capture *caps, int num,
+	struct app_option *options)
+{
+	int i = 0;
+	int ret = EXIT_SUCCESS;
+	char bdf_str[AMI_BDF_STR_LEN] = { 0 };
+	struct app_option *output = find_app_option('o', options);
+	struct app_option *format = find_app_option('f', options);
+	FILE *stream = NULL;
+
+	/* Same layout as `sensors` without a device. */
+	for (i = 0; i < num; i++) {
+		get_bdf_str(devs[i], bdf_str);
+		printf("\r\n%s:\r\n\r\n", bdf_str);
+
+		if (caps[i].out)
+			fwrite(caps[i].out, sizeof(char), caps[i].out_len, stdout);
+	}
+
+	if (!output)
+		return EXIT_SUCCESS;
+
+	stream = fopen(output->arg, "w");
+
+	if (!stream) {
+		APP_ERROR("could not open output file");
+		return EXIT_FAILURE;
+	}
+
+	setvbuf(stream, NULL, _IOFBF, JSON_WRITER_BUF_SIZE);
+
+	if (format && ((strcmp(format->arg, "json") == 0) ||
+			(strcmp(format->arg, "cbor") == 0))) {
+		struct json_writer jw = { 0 };
+
+		if (strcmp(format->arg, "cbor") == 0)
+			ret = print_cbor_stream_begin(&jw, stream);
+		else
+			ret = print_json_stream_begin(&jw, stream);
+
+		if (ret == EXIT_SUCCESS) {
+			for (i = 0; i < num; i++) {
+				get_bdf_str(devs[i], bdf_str);
+				json_writer_key(&jw, bdf_str);
+				json_writer_raw(&jw, caps[i].file, caps[i].file_len);
+			}
+
+			ret = print_json_stream_end(&jw);
+		}
+	} else {
+		for (i = 0; i < num; i++) {
+			if (!caps[i].file)
+				continue;
+
+			get_bdf_str(devs[i], bdf_str);
+			fprintf(stream, "\r\n%s:\r\n\r\n", bdf_str);
+			fwrite(caps[i].file, sizeof(char), caps[i].file_len, stream);
+		}
+	}
+
+	if (ferror(stream))
+		ret = EXIT_FAILURE;
+
+	fclose(stream);
+	return ret;
+}
+
+/*****************************************************************************/
+/* Public function definitions                                               */
+/*****************************************************************************/
+
+/*
+ * Check for a multi-device argument.
+ */
+bool is_device_list(const char *arg)
+{
+	if (!arg)
+		return false;
+
+	return ((strcmp(arg, APP_FANOUT_ALL_DEVICES) == 0) ||
+		(strstr(arg, APP_FANOUT_SEPARATOR) != NULL));
+}
+
+/*
+ * Run jobs on a thread pool.
+ */
+int run_parallel(int num_jobs, app_parallel_job job, void *data)
+{
+	int i = 0;
+	int num_threads = 0;
+	pthread_t threads[APP_FANOUT_MAX_THREADS];
+	struct parallel_pool pool = {
+		.next = 0,
+		.num_jobs = num_jobs,
+		.job = job,
+		.data = data,
+		.ret = EXIT_SUCCESS
+	};
+
+	if (!job || (num_jobs < 0))
+		return EXIT_FAILURE;
+
+	pthread_mutex_init(&pool.lock, NULL);
+
+	/* The calling thread is kept free; it only waits for the workers. */
+	for (i = 0; (i < num_jobs) && (i < APP_FANOUT_MAX_THREADS); i++) {
+		if (pthread_create(&threads[num_threads], NULL,
+				parallel_worker, &pool) != 0)
+			break;
+
+		num_threads++;
+	}
+
+	/* Do any remaining work inline if no thread could be created. */
+	if (num_threads == 0)
+		parallel_worker(&pool);
+
+	for (i = 0; i < num_threads; i++)
+		pthread_join(threads[i], NULL);
+
+	pthread_mutex_destroy(&pool.lock);
+	return pool.ret;
+}
+
+/*
+ * Open a list of devices.
+ */
+int open_device_list(const char *arg, ami_device ***devs, int *num)
+{
+	int ret = EXIT_FAILURE;
+	int i = 0;
+	int num_bdfs = 0;
+	char *list = NULL;
+	char *tok = NULL;
+	char *saveptr = NULL;
+	struct open_ctx ctx = { 0 };
+
+	if (!devs || !num || *devs)
+		return EXIT_FAILURE;
+
+	if (!arg || (strcmp(arg, APP_FANOUT_ALL_DEVICES) == 0)) {
+		if (ami_dev_enumerate_all(devs, num, false) != AMI_STATUS_OK) {
+			APP_API_ERROR("could not find any devices");
+			return EXIT_FAILURE;
+		}
+
+		return EXIT_SUCCESS;
+	}
+
+	list = strdup(arg);
+
+	if (!list) {
+		APP_ERROR("could not allocate memory");
+		return EXIT_FAILURE;
+	}
+
+	/* Upper bound of the number of entries. */
+	num_bdfs = 1;
+	for (tok = list; *tok; tok++) {
+		if (*tok == APP_FANOUT_SEPARATOR[0])
+			num_bdfs++;
+	}
+
+	ctx.bdfs = (char**)calloc(num_bdfs, sizeof(char*));
+	ctx.devs = (ami_device**)calloc(num_bdfs, sizeof(ami_device*));
+
+	if (!ctx.bdfs || !ctx.devs) {
+		APP_ERROR("could not allocate memory");
+		goto done;
+	}
+
+	/* Empty entries (e.g. a trailing comma) are ignored. */
+	i = 0;
+	for (tok = strtok_r(list, APP_FANOUT_SEPARATOR, &saveptr); tok;
+			tok = strtok_r(NULL, APP_FANOUT_SEPARATOR, &saveptr))
+		ctx.bdfs[i++] = tok;
+
+	num_bdfs = i;
+
+	if (num_bdfs == 0) {
+		APP_ERROR("no devices specified");
+		goto done;
+	}
+
+	if (run_parallel(num_bdfs, &open_device, &ctx) == EXIT_SUCCESS) {
+		*devs = ctx.devs;
+		*num = num_bdfs;
+		ctx.devs = NULL;
+		ret = EXIT_SUCCESS;
+	}
+
+done:
+	ami_dev_delete_all(&ctx.devs, num_bdfs);
+	free(ctx.bdfs);
+	free(list);
+	return ret;
+}
+
+/*
+ * Run a command against several devices.
+ */
+int for_each_device(const char *arg, struct app_option *options,
+	app_device_job job, void *data)
+{
+	int ret = EXIT_FAILURE;
+	int i = 0;
+	int num = 0;
+	ami_device **devs = NULL;
+	struct print_capture *caps = NULL;
+	struct app_option *opt = NULL;
+	struct device_ctx ctx = { 0 };
+
+	if (!arg || !job)
+		return EXIT_FAILURE;
+
+	if (!is_device_list(arg)) {
+		ami_device *dev = NULL;
+
+		if (app_dev_find(arg, &dev) != AMI_STATUS_OK) {
+			APP_API_ERROR("could not find the requested device");
+			return EXIT_FAILURE;
+		}
+
+		ret = job(dev, options, data);
+		ami_dev_delete(&dev);
+		return ret;
+	}
+
+	/* The merged output file is only written at the end. */
+	if ((opt = find_app_option('o', options)) && (access(opt->arg, F_OK) == 0)) {
+		APP_ERROR("output file already exists");
+		return EXIT_FAILURE;
+	}
+
+	if (open_device_list(arg, &devs, &num) != EXIT_SUCCESS)
+		return EXIT_FAILURE;
+
+	caps = (struct print_capture*)calloc(num, sizeof(struct print_capture));
+
+	if (!caps) {
+		APP_ERROR("could not allocate memory");
+		goto done;
+	}
+
+	ctx.devs = devs;
+	ctx.caps = caps;
+	ctx.options = options;
+	ctx.job = job;
+	ctx.data = data;
+
+	ret = run_parallel(num, &run_device_job, &ctx);
+
+	if (merge_output(devs, caps, num, options) != EXIT_SUCCESS)
+		ret = EXIT_FAILURE;
+
+	for (i = 0; i < num; i++)
+		print_capture_free(&caps[i]);
+
+done:
+	free(caps);
+	ami_dev_delete_all(&devs, num);
+	return ret;
+}
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * fanout.h - This file contains utilities for running commands against
+ *            several devices at once
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+#ifndef AMI_APP_FANOUT_H
+#define AMI_APP_FANOUT_H
+
+/* Standard includes */
+#include <stdbool.h>
+
+/* API includes */
+#include "ami_device.h"
+
+/* App includes */
+#include "amiapp.h"
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+#define APP_FANOUT_MAX_THREADS	(8)
+#define APP_FANOUT_ALL_DEVICES	"all"
+#define APP_FANOUT_SEPARATOR	","
+
+/*****************************************************************************/
+/* Typedefs                                                                  */
+/*****************************************************************************/
+
+/**
+ * typedef app_parallel_job - Function run by `run_parallel` for each job.
+ * @index: Index of the job.
+ * @data: Implementation specific data.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+typedef int (*app_parallel_job)(int index, void *data);
+
+/**
+ * typedef app_device_job - Function run by `for_each_device` for each device.
+ * @dev: Device handle.
+ * @options: Options passed in at the command line.
+ * @data: Implementation specific data.
+ *
+ * When several devices are selected, this is called from worker threads
+ * with the output of the thread captured (see `print_capture_begin`), so
+ * it must print through the `printer.h` helpers and open its output file
+ * with `open_output_file` or `parse_output_options`.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+typedef int (*app_device_job)(ami_device *dev, struct app_option *options,
+	void *data);
+
+/*****************************************************************************/
+/* Public function declarations                                              */
+/*****************************************************************************/
+
+/**
+ * is_device_list() - Check if a `-d` argument selects more than one device.
+ * @arg: Argument to check.
+ *
+ * Return: true for "all" or a comma-separated list of BDFs.
+ */
+bool is_device_list(const char *arg);
+
+/**
+ * run_parallel() - Run a number of jobs on a bounded pool of threads.
+ * @num_jobs: Number of jobs.
+ * @job: Function to run for each job index.
+ * @data: Data passed to `job`.
+ *
+ * At most `APP_FANOUT_MAX_THREADS` jobs run at the same time. Jobs are
+ * run inline if no thread could be created.
+ *
+ * Return: EXIT_SUCCESS if all jobs succeeded, EXIT_FAILURE otherwise.
+ */
+int run_parallel(int num_jobs, app_parallel_job job, void *data);
+
+/**
+ * open_device_list() - Open all devices selected by a `-d` argument.
+ * @arg: "all", a single BDF or a comma-separated list of BDFs
+ *       (NULL is the same as "all").
+ * @devs: Pointer to hold the allocated list of device handles.
+ * @num: Variable to hold the number of handles in `devs`.
+ *
+ * Devices are opened concurrently. For "all", a device which cannot be
+ * brought up is skipped; for an explicit list, every device must be found.
+ * The list must be freed with `ami_dev_delete_all`.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int open_device_list(const char *arg, ami_device ***devs, int *num);
+
+/**
+ * for_each_device() - Run a command against every selected device.
+ * @arg: Argument of the `-d` option.
+ * @options: Options passed in at the command line.
+ * @job: Function to run for each device.
+ * @data: Data passed to `job`.
+ *
+ * A single BDF runs `job` directly. Otherwise the devices are handled
+ * concurrently and their output is merged in device order: the screen
+ * output of each device is printed under a BDF heading and, if an output
+ * file was requested, the per-device JSON documents are merged into a
+ * single document keyed by BDF (other formats are concatenated under BDF
+ * headings, like the screen output).
+ *
+ * Return: EXIT_SUCCESS if `job` succeeded for all devices, EXIT_FAILURE
+ *         otherwise.
+ */
+int for_each_device(const char *arg, struct app_option *options,
+	app_device_job job, void *data);
+
+#endif  /* AMI_APP_FANOUT_H */
@@ -34,16 +34,6 @@
 		exit(EXIT_FAILURE);                     \
 	} while (0)
 
-/* Sadly, strdup is not portable. */
-static char *json_strdup(const char *str)
-{
-	char *ret = (char*) malloc(strlen(str) + 1);
-	if (ret == NULL)
-		out_of_memory();
-	strcpy(ret, str);
-	return ret;
-}
-
 /* String buffer */
 
 typedef struct
@@ -84,24 +74,12 @@ static void sb_grow(SB *sb, int need)
 	sb->end = sb->start + alloc;
 }
 
-static void sb_put(SB *sb, const char *bytes, int count)
-{
-	sb_need(sb, count);
-	memcpy(sb->cur, bytes, count);
-	sb->cur += count;
-}
-
 #define sb_putc(sb, c) do {         \
 		if ((sb)->cur >= (sb)->end) \
 			sb_grow(sb, 1);         \
 		*(sb)->cur++ = (c);         \
 	} while (0)
 
-static void sb_puts(SB *sb, const char *str)
-{
-	sb_put(sb, str, strlen(str));
-}
-
 static char *sb_finish(SB *sb)
 {
 	*sb->cur = 0;
@@ -202,58 +180,6 @@ static int utf8_validate_cz(const char *s)
 	}
 }
 
-/* Validate a null-terminated UTF-8 string. */
-static bool utf8_validate(const char *s)
-{
-	int len;
-
-	for (; *s != 0; s += len) {
-		len = utf8_validate_cz(s);
-		if (len == 0)
-			return false;
-	}
-
-	return true;
-}
-
-/*
- * Read a single UTF-8 character starting at @s,
- * returning the length, in bytes, of the character read.
- *
- * This function assumes input is valid UTF-8,
- * and that there are enough characters in front of @s.
- */
-static int utf8_read_char(const char *s, uchar_t *out)
-{
-	const unsigned char *c = (const unsigned char*) s;
-
-	assert(utf8_validate_cz(s));
-
-	if (c[0] <= 0x7F) {
-		/* 00..7F */
-		*out = c[0];
-		return 1;
-	} else if (c[0] <= 0xDF) {
-		/* C2..DF (unless input is invalid) */
-		*out = ((uchar_t)c[0] & 0x1F) << 6 |
-		       ((uchar_t)c[1] & 0x3F);
-		return 2;
-	} else if (c[0] <= 0xEF) {
-		/* E0..EF */
-		*out = ((uchar_t)c[0] &  0xF) << 12 |
-		       ((uchar_t)c[1] & 0x3F) << 6  |
-		       ((uchar_t)c[2] & 0x3F);
-		return 3;
-	} else {
-		/* F0..F4 (unless input is invalid) */
-		*out = ((uchar_t)c[0] &  0x7) << 18 |
-		       ((uchar_t)c[1] & 0x3F) << 12 |
-		       ((uchar_t)c[2] & 0x3F) << 6  |
-		       ((uchar_t)c[3] & 0x3F);
-		return 4;
-	}
-}
-
 /*
  * Write a single UTF-8 character to @s,
  * returning the length, in bytes, of the character written.
@@ -309,22 +235,6 @@ static bool from_surrogate_pair(uint16_t uc, uint16_t lc, uchar_t *unicode)
 	}
 }
 
-/*
- * Construct a UTF-16 surrogate pair given a Unicode codepoint.
- *
- * @unicode must be U+10000..U+10FFFF.
- */
-static void to_surrogate_pair(uchar_t unicode, uint16_t *uc, uint16_t *lc)
-{
-	uchar_t n;
-
-	assert(unicode >= 0x10000 && unicode <= 0x10FFFF);
-
-	n = unicode - 0x10000;
-	*uc = ((n >> 10) & 0x3FF) | 0xD800;
-	*lc = (n & 0x3FF) | 0xDC00;
-}
-
 #define is_space(c) ((c) == '\t' || (c) == '\n' || (c) == '\r' || (c) == ' ')
 #define is_digit(c) ((c) >= '0' && (c) <= '9')
 
@@ -338,26 +248,10 @@ static bool parse_hex16     (const char **sp, uint16_t         *out);
 static bool expect_literal  (const char **sp, const char *str);
 static void skip_space      (const char **sp);
 
-static void emit_value              (SB *out, const JsonNode *node);
-static void emit_value_indented     (SB *out, const JsonNode *node, const char *space, int indent_level);
-static void emit_string             (SB *out, const char *str);
-static void emit_number             (SB *out, double num);
-static void emit_array              (SB *out, const JsonNode *array);
-static void emit_array_indented     (SB *out, const JsonNode *array, const char *space, int indent_level);
-static void emit_object             (SB *out, const JsonNode *object);
-static void emit_object_indented    (SB *out, const JsonNode *object, const char *space, int indent_level);
-
-static int write_hex16(char *out, uint16_t val);
-
 static JsonNode *mknode(JsonTag tag);
 static void append_node(JsonNode *parent, JsonNode *child);
-static void prepend_node(JsonNode *parent, JsonNode *child);
 static void append_member(JsonNode *object, char *key, JsonNode *value);
 
-/* Assertion-friendly validity checks */
-static bool tag_is_valid(unsigned int tag);
-static bool number_is_valid(const char *num);
-
 JsonNode *json_decode(const char *json)
 {
 	const char *s = json;
@@ -376,34 +270,6 @@ JsonNode *json_decode(const char *json)
 	return ret;
 }
 
-char *json_encode(const JsonNode *node)
-{
-	return json_stringify(node, NULL);
-}
-
-char *json_encode_string(const char *str)
-{
-	SB sb;
-	sb_init(&sb);
-
-	emit_string(&sb, str);
-
-	return sb_finish(&sb);
-}
-
-char *json_stringify(const JsonNode *node, const char *space)
-{
-	SB sb;
-	sb_init(&sb);
-
-	if (space != NULL)
-		emit_value_indented(&sb, node, space, 0);
-	else
-		emit_value(&sb, node);
-
-	return sb_finish(&sb);
-}
-
 void json_delete(JsonNode *node)
 {
 	if (node != NULL) {
@@ -511,11 +377,6 @@ static JsonNode *mkstring(char *s)
 	return ret;
 }
 
-JsonNode *json_mkstring(const char *s)
-{
-	return mkstring(json_strdup(s));
-}
-
 JsonNode *json_mknumber(double n)
 {
 	JsonNode *node = mknode(JSON_NUMBER);
@@ -546,19 +407,6 @@ static void append_node(JsonNode *parent, JsonNode *child)
 	parent->children.tail = child;
 }
 
-static void prepend_node(JsonNode *parent, JsonNode *child)
-{
-	child->parent = parent;
-	child->prev = NULL;
-	child->next = parent->children.head;
-
-	if (parent->children.head != NULL)
-		parent->children.head->prev = child;
-	else
-		parent->children.tail = child;
-	parent->children.head = child;
-}
-
 static void append_member(JsonNode *object, char *key, JsonNode *value)
 {
 	value->key = key;
@@ -573,31 +421,6 @@ void json_append_element(JsonNode *array, JsonNode *element)
 	append_node(array, element);
 }
 
-void json_prepend_element(JsonNode *array, JsonNode *element)
-{
-	assert(array->tag == JSON_ARRAY);
-	assert(element->parent == NULL);
-
-	prepend_node(array, element);
-}
-
-void json_append_member(JsonNode *object, const char *key, JsonNode *value)
-{
-	assert(object->tag == JSON_OBJECT);
-	assert(value->parent == NULL);
-
-	append_member(object, json_strdup(key), value);
-}
-
-void json_prepend_member(JsonNode *object, const char *key, JsonNode *value)
-{
-	assert(object->tag == JSON_OBJECT);
-	assert(value->parent == NULL);
-
-	value->key = json_strdup(key);
-	prepend_node(object, value);
-}
-
 void json_remove_from_parent(JsonNode *node)
 {
 	JsonNode *parent = node->parent;
@@ -971,284 +794,6 @@ static void skip_space(const char **sp)
 	*sp = s;
 }
 
-static void emit_value(SB *out, const JsonNode *node)
-{
-	assert(tag_is_valid(node->tag));
-	switch (node->tag) {
-		case JSON_NULL:
-			sb_puts(out, "null");
-			break;
-		case JSON_BOOL:
-			sb_puts(out, node->bool_ ? "true" : "false");
-			break;
-		case JSON_STRING:
-			emit_string(out, node->string_);
-			break;
-		case JSON_NUMBER:
-			emit_number(out, node->number_);
-			break;
-		case JSON_ARRAY:
-			emit_array(out, node);
-			break;
-		case JSON_OBJECT:
-			emit_object(out, node);
-			break;
-		default:
-			assert(false);
-	}
-}
-
-void emit_value_indented(SB *out, const JsonNode *node, const char *space, int indent_level)
-{
-	assert(tag_is_valid(node->tag));
-	switch (node->tag) {
-		case JSON_NULL:
-			sb_puts(out, "null");
-			break;
-		case JSON_BOOL:
-			sb_puts(out, node->bool_ ? "true" : "false");
-			break;
-		case JSON_STRING:
-			emit_string(out, node->string_);
-			break;
-		case JSON_NUMBER:
-			emit_number(out, node->number_);
-			break;
-		case JSON_ARRAY:
-			emit_array_indented(out, node, space, indent_level);
-			break;
-		case JSON_OBJECT:
-			emit_object_indented(out, node, space, indent_level);
-			break;
-		default:
-			assert(false);
-	}
-}
-
-static void emit_array(SB *out, const JsonNode *array)
-{
-	const JsonNode *element;
-
-	sb_putc(out, '[');
-	json_foreach(element, array) {
-		emit_value(out, element);
-		if (element->next != NULL)
-			sb_putc(out, ',');
-	}
-	sb_putc(out, ']');
-}
-
-static void emit_array_indented(SB *out, const JsonNode *array, const char *space, int indent_level)
-{
-	const JsonNode *element = array->children.head;
-	int i;
-
-	if (element == NULL) {
-		sb_puts(out, "[]");
-		return;
-	}
-
-	sb_puts(out, "[\n");
-	while (element != NULL) {
-		for (i = 0; i < indent_level + 1; i++)
-			sb_puts(out, space);
-		emit_value_indented(out, element, space, indent_level + 1);
-
-		element = element->next;
-		sb_puts(out, element != NULL ? ",\n" : "\n");
-	}
-	for (i = 0; i < indent_level; i++)
-		sb_puts(out, space);
-	sb_putc(out, ']');
-}
-
-static void emit_object(SB *out, const JsonNode *object)
-{
-	const JsonNode *member;
-
-	sb_putc(out, '{');
-	json_foreach(member, object) {
-		emit_string(out, member->key);
-		sb_putc(out, ':');
-		emit_value(out, member);
-		if (member->next != NULL)
-			sb_putc(out, ',');
-	}
-	sb_putc(out, '}');
-}
-
-static void emit_object_indented(SB *out, const JsonNode *object, const char *space, int indent_level)
-{
-	const JsonNode *member = object->children.head;
-	int i;
-
-	if (member == NULL) {
-		sb_puts(out, "{}");
-		return;
-	}
-
-	sb_puts(out, "{\n");
-	while (member != NULL) {
-		for (i = 0; i < indent_level + 1; i++)
-			sb_puts(out, space);
-		emit_string(out, member->key);
-		sb_puts(out, ": ");
-		emit_value_indented(out, member, space, indent_level + 1);
-
-		member = member->next;
-		sb_puts(out, member != NULL ? ",\n" : "\n");
-	}
-	for (i = 0; i < indent_level; i++)
-		sb_puts(out, space);
-	sb_putc(out, '}');
-}
-
-void emit_string(SB *out, const char *str)
-{
-	bool escape_unicode = false;
-	const char *s = str;
-	char *b;
-
-	assert(utf8_validate(str));
-
-	/*
-	 * 14 bytes is enough space to write up to two
-	 * \uXXXX escapes and two quotation marks.
-	 */
-	sb_need(out, 14);
-	b = out->cur;
-
-	*b++ = '"';
-	while (*s != 0) {
-		unsigned char c = *s++;
-
-		/* Encode the next character, and write it to b. */
-		switch (c) {
-			case '"':
-				*b++ = '\\';
-				*b++ = '"';
-				break;
-			case '\\':
-				*b++ = '\\';
-				*b++ = '\\';
-				break;
-			case '\b':
-				*b++ = '\\';
-				*b++ = 'b';
-				break;
-			case '\f':
-				*b++ = '\\';
-				*b++ = 'f';
-				break;
-			case '\n':
-				*b++ = '\\';
-				*b++ = 'n';
-				break;
-			case '\r':
-				*b++ = '\\';
-				*b++ = 'r';
-				break;
-			case '\t':
-				*b++ = '\\';
-				*b++ = 't';
-				break;
-			default: {
-				int len;
-
-				s--;
-				len = utf8_validate_cz(s);
-
-				if (len == 0) {
-					/*
-					 * Handle invalid UTF-8 character gracefully in production
-					 * by writing a replacement character (U+FFFD)
-					 * and skipping a single byte.
-					 *
-					 * This should never happen when assertions are enabled
-					 * due to the assertion at the beginning of this function.
-					 */
-					assert(false);
-					if (escape_unicode) {
-						strcpy(b, "\\uFFFD");
-						b += 6;
-					} else {
-						*b++ = 0xEF;
-						*b++ = 0xBF;
-						*b++ = 0xBD;
-					}
-					s++;
-				} else if (c < 0x1F || (c >= 0x80 && escape_unicode)) {
-					/* Encode using \u.... */
-					uint32_t unicode;
-
-					s += utf8_read_char(s, &unicode);
-
-					if (unicode <= 0xFFFF) {
-						*b++ = '\\';
-						*b++ = 'u';
-						b += write_hex16(b, unicode);
-					} else {
-						/* Produce a surrogate pair. */
-						uint16_t uc, lc;
-						assert(unicode <= 0x10FFFF);
-						to_surrogate_pair(unicode, &uc, &lc);
-						*b++ = '\\';
-						*b++ = 'u';
-						b += write_hex16(b, uc);
-						*b++ = '\\';
-						*b++ = 'u';
-						b += write_hex16(b, lc);
-					}
-				} else {
-					/* Write the character directly. */
-					while (len--)
-						*b++ = *s++;
-				}
-
-				break;
-			}
-		}
-
-		/*
-		 * Update *out to know about the new bytes,
-		 * and set up b to write another encoded character.
-		 */
-		out->cur = b;
-		sb_need(out, 14);
-		b = out->cur;
-	}
-	*b++ = '"';
-
-	out->cur = b;
-}
-
-static void emit_number(SB *out, double num)
-{
-	/*
-	 * This isn't exactly how JavaScript renders numbers,
-	 * but it should produce valid JSON for reasonable numbers
-	 * preserve precision well enough, and avoid some oddities
-	 * like 0.3 -> 0.299999999999999988898 .
-	 */
-	char buf[64];
-	sprintf(buf, "%.16g", num);
-
-	if (number_is_valid(buf))
-		sb_puts(out, buf);
-	else
-		sb_puts(out, "null");
-}
-
-static bool tag_is_valid(unsigned int tag)
-{
-	return (/* tag >= JSON_NULL && */ tag <= JSON_OBJECT);
-}
-
-static bool number_is_valid(const char *num)
-{
-	return (parse_number(&num, NULL) && *num == '\0');
-}
-
 static bool expect_literal(const char **sp, const char *str)
 {
 	const char *s = *sp;
@@ -1294,88 +839,3 @@ static bool parse_hex16(const char **sp, uint16_t *out)
 	return true;
 }
 
-/*
- * Encodes a 16-bit number into hexadecimal,
- * writing exactly 4 hex chars.
- */
-static int write_hex16(char *out, uint16_t val)
-{
-	const char *hex = "0123456789ABCDEF";
-
-	*out++ = hex[(val >> 12) & 0xF];
-	*out++ = hex[(val >> 8)  & 0xF];
-	*out++ = hex[(val >> 4)  & 0xF];
-	*out++ = hex[ val        & 0xF];
-
-	return 4;
-}
-
-bool json_check(const JsonNode *node, char errmsg[256])
-{
-	#define problem(...) do { \
-			if (errmsg != NULL) \
-				snprintf(errmsg, 256, __VA_ARGS__); \
-			return false; \
-		} while (0)
-
-	if (node->key != NULL && !utf8_validate(node->key))
-		problem("key contains invalid UTF-8");
-
-	if (!tag_is_valid(node->tag))
-		problem("tag is invalid (%u)", node->tag);
-
-	if (node->tag == JSON_BOOL) {
-		if (node->bool_ != false && node->bool_ != true)
-			problem("bool_ is neither false (%d) nor true (%d)", (int)false, (int)true);
-	} else if (node->tag == JSON_STRING) {
-		if (node->string_ == NULL)
-			problem("string_ is NULL");
-		if (!utf8_validate(node->string_))
-			problem("string_ contains invalid UTF-8");
-	} else if (node->tag == JSON_ARRAY || node->tag == JSON_OBJECT) {
-		JsonNode *head = node->children.head;
-		JsonNode *tail = node->children.tail;
-
-		if (head == NULL || tail == NULL) {
-			if (head != NULL)
-				problem("tail is NULL, but head is not");
-			if (tail != NULL)
-				problem("head is NULL, but tail is not");
-		} else {
-			JsonNode *child;
-			JsonNode *last = NULL;
-
-			if (head->prev != NULL)
-				problem("First child's prev pointer is not NULL");
-
-			for (child = head; child != NULL; last = child, child = child->next) {
-				if (child == node)
-					problem("node is its own child");
-				if (child->next == child)
-					problem("child->next == child (cycle)");
-				if (child->next == head)
-					problem("child->next == head (cycle)");
-
-				if (child->parent != node)
-					problem("child does not point back to parent");
-				if (child->next != NULL && child->next->prev != child)
-					problem("child->next does not point back to child");
-
-				if (node->tag == JSON_ARRAY && child->key != NULL)
-					problem("Array element's key is not NULL");
-				if (node->tag == JSON_OBJECT && child->key == NULL)
-					problem("Object member's key is NULL");
-
-				if (!json_check(child, errmsg))
-					return false;
-			}
-
-			if (last != tail)
-				problem("tail does not match pointer found by starting at head and following next links");
-		}
-	}
-
-	return true;
-
-	#undef problem
-}
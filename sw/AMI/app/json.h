@@ -66,12 +66,9 @@ struct JsonNode
 	};
 };
 
-/*** Encoding, decoding, and validation ***/
+/*** Decoding and validation ***/
 
 JsonNode   *json_decode         (const char *json);
-char       *json_encode         (const JsonNode *node);
-char       *json_encode_string  (const char *str);
-char       *json_stringify      (const JsonNode *node, const char *space);
 void        json_delete         (JsonNode *node);
 
 bool        json_validate       (const char *json);
@@ -92,26 +89,12 @@ JsonNode   *json_first_child    (const JsonNode *node);
 
 JsonNode *json_mknull(void);
 JsonNode *json_mkbool(bool b);
-JsonNode *json_mkstring(const char *s);
 JsonNode *json_mknumber(double n);
 JsonNode *json_mkarray(void);
 JsonNode *json_mkobject(void);
 
 void json_append_element(JsonNode *array, JsonNode *element);
-void json_prepend_element(JsonNode *array, JsonNode *element);
-void json_append_member(JsonNode *object, const char *key, JsonNode *value);
-void json_prepend_member(JsonNode *object, const char *key, JsonNode *value);
 
 void json_remove_from_parent(JsonNode *node);
 
-/*** Debugging ***/
-
-/*
- * Look for structure and encoding problems in a JsonNode or its descendents.
- *
- * If a problem is detected, return false, writing a description of the problem
- * to errmsg (unless errmsg is NULL).
- */
-bool json_check(const JsonNode *node, char errmsg[256]);
-
 #endif
@@ -0,0 +1,640 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * json_writer.c - This file contains a streaming JSON writer
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+/* Standard includes */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <string.h>
+#include <inttypes.h>
+#include <float.h>
+#include <math.h>
+
+/* App includes */
+#include "json_writer.h"
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+#define JSON_WRITER_INDENT	"\t"
+
+/*****************************************************************************/
+/* Local function declarations                                               */
+/*****************************************************************************/
+
+/**
+ * write_indent() - Indent the next line to the current nesting level.
+ * @jw: Writer handle.
+ *
+ * Return: None.
+ */
+static void write_indent(struct json_writer *jw);
+
+/**
+ * write_separator() - Separate a new member from the previous one.
+ * @jw: Writer handle.
+ *
+ * Writes the newline (and comma, if this is not the first member) and
+ * indentation that precede a member of the innermost container.
+ *
+ * Return: None.
+ */
+static void write_separator(struct json_writer *jw);
+
+/**
+ * write_escaped() - Write a quoted and escaped JSON string.
+ * @jw: Writer handle.
+ * @str: String to write.
+ *
+ * Return: None.
+ */
+static void write_escaped(struct json_writer *jw, const char *str);
+
+/**
+ * write_null() - Write a null token.
+ * @jw: Writer handle.
+ *
+ * Return: None.
+ */
+static void write_null(struct json_writer *jw);
+
+/**
+ * cbor_head() - Write the initial byte(s) of a CBOR data item.
+ * @jw: Writer handle.
+ * @major: Major type of the item.
+ * @arg: Argument of the item (value, length or tag number).
+ *
+ * The argument is written in the shortest form that holds it.
+ *
+ * Return: None.
+ */
+static void cbor_head(struct json_writer *jw, uint8_t major, uint64_t arg);
+
+/**
+ * cbor_text() - Write a CBOR text string.
+ * @jw: Writer handle.
+ * @str: String to write.
+ *
+ * Return: None.
+ */
+static void cbor_text(struct json_writer *jw, const char *str);
+
+/**
+ * cbor_float() - Write a CBOR floating point number.
+ * @jw: Writer handle.
+ * @num: Finite number to write.
+ *
+ * Return: None.
+ */
+static void cbor_float(struct json_writer *jw, double num);
+
+/**
+ * begin_value() - Prepare the stream for a value or container.
+ * @jw: Writer handle.
+ *
+ * Return: true if the value may be written, false otherwise.
+ */
+static bool begin_value(struct json_writer *jw);
+
+/**
+ * begin_container() - Open an object or array.
+ * @jw: Writer handle.
+ * @is_array: Open an array rather than an object.
+ *
+ * Return: None.
+ */
+static void begin_container(struct json_writer *jw, bool is_array);
+
+/**
+ * end_container() - Close the innermost object or array.
+ * @jw: Writer handle.
+ * @is_array: Expect the innermost container to be an array.
+ *
+ * Return: None.
+ */
+static void end_container(struct json_writer *jw, bool is_array);
+
+/*****************************************************************************/
+/* Local function definitions                                                */
+/*****************************************************************************/
+
+/*
+ * Indent to the current depth.
+ */
+static void write_indent(struct json_writer *jw)
+{
+	int i = 0;
+
+	if (jw->cbor || jw->compact)
+		return;
+
+	for (i = 0; i < jw->depth; i++)
+		fputs(jw->space, jw->stream);
+}
+
+/*
+ * Write member separator.
+ */
+static void write_separator(struct json_writer *jw)
+{
+	int d = jw->depth - 1;
+
+	if (jw->cbor) {
+		jw->n_members[d]++;
+		return;
+	}
+
+	if (jw->compact) {
+		if (jw->n_members[d] != 0)
+			fputc(',', jw->stream);
+
+		jw->n_members[d]++;
+		return;
+	}
+
+	fputs((jw->n_members[d] == 0) ? ("\n") : (",\n"), jw->stream);
+	jw->n_members[d]++;
+	write_indent(jw);
+}
+
+/*
+ * Write a quoted string, escaping quotes, backslashes and control characters.
+ */
+static void write_escaped(struct json_writer *jw, const char *str)
+{
+	const unsigned char *s = (const unsigned char*)str;
+
+	fputc('"', jw->stream);
+
+	while (*s) {
+		unsigned char c = *s++;
+
+		switch (c) {
+			case '"':
+				fputs("\\\"", jw->stream);
+				break;
+
+			case '\\':
+				fputs("\\\\", jw->stream);
+				break;
+
+			case '\b':
+				fputs("\\b", jw->stream);
+				break;
+
+			case '\f':
+				fputs("\\f", jw->stream);
+				break;
+
+			case '\n':
+				fputs("\\n", jw->stream);
+				break;
+
+			case '\r':
+				fputs("\\r", jw->stream);
+				break;
+
+			case '\t':
+				fputs("\\t", jw->stream);
+				break;
+
+			default:
+				if (c < 0x1F)
+					fprintf(jw->stream, "\\u%04X", c);
+				else
+					fputc(c, jw->stream);
+				break;
+		}
+	}
+
+	fputc('"', jw->stream);
+}
+
+/*
+ * Write null in the current encoding.
+ */
+static void write_null(struct json_writer *jw)
+{
+	if (jw->cbor)
+		fputc(CBOR_NULL, jw->stream);
+	else
+		fputs("null", jw->stream);
+}
+
+/*
+ * Write a major type and its argument.
+ */
+static void cbor_head(struct json_writer *jw, uint8_t major, uint64_t arg)
+{
+	uint8_t buf[9] = { 0 };
+	int n = 0;
+	int i = 0;
+
+	major <<= 5;
+
+	if (arg < 24) {
+		buf[0] = major | (uint8_t)arg;
+		n = 0;
+	} else if (arg <= UINT8_MAX) {
+		buf[0] = major | 24;
+		n = 1;
+	} else if (arg <= UINT16_MAX) {
+		buf[0] = major | 25;
+		n = 2;
+	} else if (arg <= UINT32_MAX) {
+		buf[0] = major | 26;
+		n = 4;
+	} else {
+		buf[0] = major | 27;
+		n = 8;
+	}
+
+	/* Network byte order */
+	for (i = 0; i < n; i++)
+		buf[n - i] = (uint8_t)(arg >> (8 * i));
+
+	fwrite(buf, 1, n + 1, jw->stream);
+}
+
+/*
+ * Write a text string.
+ */
+static void cbor_text(struct json_writer *jw, const char *str)
+{
+	size_t len = strlen(str);
+
+	cbor_head(jw, CBOR_MAJOR_TEXT, len);
+	fwrite(str, 1, len, jw->stream);
+}
+
+/*
+ * Write a float, using single precision if nothing is lost.
+ */
+static void cbor_float(struct json_writer *jw, double num)
+{
+	float single = 0;
+	uint64_t bits = 0;
+	uint32_t bits32 = 0;
+	uint8_t buf[9] = { 0 };
+	int n = 0;
+	int i = 0;
+
+	if (fabs(num) <= FLT_MAX)
+		single = (float)num;
+
+	if ((double)single == num) {
+		memcpy(&bits32, &single, sizeof(bits32));
+		buf[0] = CBOR_FLOAT32;
+		bits = bits32;
+		n = 4;
+	} else {
+		memcpy(&bits, &num, sizeof(bits));
+		buf[0] = CBOR_FLOAT64;
+		n = 8;
+	}
+
+	for (i = 0; i < n; i++)
+		buf[n - i] = (uint8_t)(bits >> (8 * i));
+
+	fwrite(buf, 1, n + 1, jw->stream);
+}
+
+/*
+ * Check writer state before writing a value.
+ */
+static bool begin_value(struct json_writer *jw)
+{
+	if (!jw || !jw->stream || jw->error)
+		return false;
+
+	if (jw->depth == 0)
+		return true;
+
+	if (jw->is_array[jw->depth - 1]) {
+		write_separator(jw);
+		return true;
+	}
+
+	/* Object members must be preceded by a key. */
+	if (!jw->after_key) {
+		jw->error = true;
+		return false;
+	}
+
+	jw->after_key = false;
+	return true;
+}
+
+/*
+ * Open a container.
+ */
+static void begin_container(struct json_writer *jw, bool is_array)
+{
+	if (!begin_value(jw))
+		return;
+
+	if (jw->depth >= JSON_WRITER_MAX_DEPTH) {
+		jw->error = true;
+		return;
+	}
+
+	if (jw->cbor)
+		fputc((is_array) ? (CBOR_ARRAY_INDEF) : (CBOR_MAP_INDEF), jw->stream);
+	else
+		fputc((is_array) ? ('[') : ('{'), jw->stream);
+
+	jw->is_array[jw->depth] = is_array;
+	jw->n_members[jw->depth] = 0;
+	jw->depth++;
+}
+
+/*
+ * Close a container.
+ */
+static void end_container(struct json_writer *jw, bool is_array)
+{
+	int d = 0;
+
+	if (!jw || !jw->stream || (jw->depth == 0))
+		return;
+
+	d = jw->depth - 1;
+
+	if ((jw->is_array[d] != is_array) || jw->after_key)
+		jw->error = true;
+
+	jw->after_key = false;
+	jw->depth--;
+
+	if (jw->cbor) {
+		fputc(CBOR_BREAK, jw->stream);
+		return;
+	}
+
+	if ((jw->n_members[d] != 0) && !jw->compact) {
+		fputc('\n', jw->stream);
+		write_indent(jw);
+	}
+
+	fputc((jw->is_array[d]) ? (']') : ('}'), jw->stream);
+}
+
+/*****************************************************************************/
+/* Public function definitions                                               */
+/*****************************************************************************/
+
+/*
+ * Initialise a writer.
+ */
+int json_writer_init(struct json_writer *jw, FILE *stream)
+{
+	if (!jw || !stream)
+		return EXIT_FAILURE;
+
+	jw->stream = stream;
+	jw->space = JSON_WRITER_INDENT;
+	jw->depth = 0;
+	jw->after_key = false;
+	jw->error = false;
+	jw->cbor = false;
+	jw->compact = false;
+
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Initialise a single line writer.
+ */
+int json_writer_init_compact(struct json_writer *jw, FILE *stream)
+{
+	if (json_writer_init(jw, stream) != EXIT_SUCCESS)
+		return EXIT_FAILURE;
+
+	jw->compact = true;
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Initialise a CBOR writer.
+ */
+int json_writer_init_cbor(struct json_writer *jw, FILE *stream)
+{
+	if (json_writer_init(jw, stream) != EXIT_SUCCESS)
+		return EXIT_FAILURE;
+
+	jw->cbor = true;
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Open an object.
+ */
+void json_writer_begin_object(struct json_writer *jw)
+{
+	begin_container(jw, false);
+}
+
+/*
+ * Close an object.
+ */
+void json_writer_end_object(struct json_writer *jw)
+{
+	end_container(jw, false);
+}
+
+/*
+ * Open an array.
+ */
+void json_writer_begin_array(struct json_writer *jw)
+{
+	begin_container(jw, true);
+}
+
+/*
+ * Close an array.
+ */
+void json_writer_end_array(struct json_writer *jw)
+{
+	end_container(jw, true);
+}
+
+/*
+ * Write an object key.
+ */
+void json_writer_key(struct json_writer *jw, const char *key)
+{
+	if (!jw || !jw->stream || jw->error)
+		return;
+
+	if (!key || (jw->depth == 0) || jw->is_array[jw->depth - 1] ||
+			jw->after_key) {
+		jw->error = true;
+		return;
+	}
+
+	write_separator(jw);
+
+	if (jw->cbor) {
+		cbor_text(jw, key);
+	} else {
+		write_escaped(jw, key);
+		fputs((jw->compact) ? (":") : (": "), jw->stream);
+	}
+
+	jw->after_key = true;
+}
+
+/*
+ * Write a string.
+ */
+void json_writer_string(struct json_writer *jw, const char *str)
+{
+	if (!begin_value(jw))
+		return;
+
+	if (!str)
+		write_null(jw);
+	else if (jw->cbor)
+		cbor_text(jw, str);
+	else
+		write_escaped(jw, str);
+}
+
+/*
+ * Write a number.
+ */
+void json_writer_number(struct json_writer *jw, double num)
+{
+	if (!begin_value(jw))
+		return;
+
+	if (!isfinite(num))
+		write_null(jw);
+	else if (jw->cbor)
+		cbor_float(jw, num);
+	else
+		fprintf(jw->stream, "%.16g", num);
+}
+
+/*
+ * Write an integer.
+ */
+void json_writer_int(struct json_writer *jw, int64_t num)
+{
+	if (!begin_value(jw))
+		return;
+
+	if (!jw->cbor)
+		fprintf(jw->stream, "%" PRId64, num);
+	else if (num < 0)
+		cbor_head(jw, CBOR_MAJOR_NINT, (uint64_t)(-1 - num));
+	else
+		cbor_head(jw, CBOR_MAJOR_UINT, (uint64_t)num);
+}
+
+/*
+ * Write a boolean.
+ */
+void json_writer_bool(struct json_writer *jw, bool b)
+{
+	if (!begin_value(jw))
+		return;
+
+	if (jw->cbor)
+		fputc((b) ? (CBOR_TRUE) : (CBOR_FALSE), jw->stream);
+	else
+		fputs((b) ? ("true") : ("false"), jw->stream);
+}
+
+/*
+ * Write null.
+ */
+void json_writer_null(struct json_writer *jw)
+{
+	if (!begin_value(jw))
+		return;
+
+	write_null(jw);
+}
+
+/*
+ * Write a pre-serialised value.
+ */
+void json_writer_raw(struct json_writer *jw, const char *json, size_t len)
+{
+	size_t i = 0;
+
+	if (!json || (len == 0)) {
+		json_writer_null(jw);
+		return;
+	}
+
+	if (jw && jw->cbor) {
+		const uint8_t *item = (const uint8_t*)json;
+
+		/* A nested document does not need its own magic number. */
+		if ((len > 3) && (item[0] == 0xD9) && (item[1] == 0xD9) &&
+				(item[2] == 0xF7)) {
+			json += 3;
+			len -= 3;
+		}
+
+		if (begin_value(jw))
+			fwrite(json, 1, len, jw->stream);
+		return;
+	}
+
+	/* Trim surrounding whitespace. */
+	while ((len > 0) && isspace((unsigned char)json[0])) {
+		json++;
+		len--;
+	}
+
+	while ((len > 0) && isspace((unsigned char)json[len - 1]))
+		len--;
+
+	if (len == 0) {
+		json_writer_null(jw);
+		return;
+	}
+
+	if (!begin_value(jw))
+		return;
+
+	for (i = 0; i < len; i++) {
+		fputc(json[i], jw->stream);
+
+		if (json[i] == '\n')
+			write_indent(jw);
+	}
+}
+
+/*
+ * Close all open containers.
+ */
+int json_writer_finish(struct json_writer *jw)
+{
+	if (!jw || !jw->stream)
+		return EXIT_FAILURE;
+
+	/* A dangling key still needs a value to keep the output valid. */
+	if (jw->after_key) {
+		write_null(jw);
+		jw->after_key = false;
+		jw->error = true;
+	}
+
+	while (jw->depth > 0)
+		end_container(jw, jw->is_array[jw->depth - 1]);
+
+	if (ferror(jw->stream))
+		jw->error = true;
+
+	return (jw->error) ? (EXIT_FAILURE) : (EXIT_SUCCESS);
+}
@@ -0,0 +1,243 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * json_writer.h - This file contains a streaming JSON writer
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+#ifndef AMI_APP_JSON_WRITER_H
+#define AMI_APP_JSON_WRITER_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+#define JSON_WRITER_MAX_DEPTH	(16)
+#define JSON_WRITER_BUF_SIZE	(8192)
+
+/* CBOR major types (RFC 8949 section 3.1) */
+#define CBOR_MAJOR_UINT		(0)
+#define CBOR_MAJOR_NINT		(1)
+#define CBOR_MAJOR_BYTES	(2)
+#define CBOR_MAJOR_TEXT		(3)
+#define CBOR_MAJOR_ARRAY	(4)
+#define CBOR_MAJOR_MAP		(5)
+#define CBOR_MAJOR_TAG		(6)
+#define CBOR_MAJOR_SIMPLE	(7)
+
+/* CBOR initial bytes with a fixed meaning */
+#define CBOR_FALSE		(0xF4)
+#define CBOR_TRUE		(0xF5)
+#define CBOR_NULL		(0xF6)
+#define CBOR_FLOAT32		(0xFA)
+#define CBOR_FLOAT64		(0xFB)
+#define CBOR_BREAK		(0xFF)
+#define CBOR_ARRAY_INDEF	(0x9F)
+#define CBOR_MAP_INDEF		(0xBF)
+
+/* Self-described CBOR tag, used as a magic number at the start of a file */
+#define CBOR_TAG_SELF_DESCRIBE	(55799)
+
+/*****************************************************************************/
+/* Structs                                                                   */
+/*****************************************************************************/
+
+/**
+ * struct json_writer - State of a streaming JSON document.
+ * @stream: Output stream.
+ * @space: Indentation string for a single nesting level.
+ * @depth: Number of currently open containers.
+ * @is_array: Whether the container at each depth is an array.
+ * @n_members: Number of members written to the container at each depth.
+ * @after_key: A key has been written and is waiting for its value.
+ * @error: Set when the document was used incorrectly or a write failed.
+ * @cbor: Encode the document as CBOR rather than text.
+ * @compact: Write text on a single line, without any whitespace.
+ *
+ * The writer emits tokens as soon as they are produced, so no part of the
+ * document is held in memory. Text output is tab indented, matching the
+ * layout that files written by `-f json` have always had.
+ *
+ * In CBOR mode (RFC 8949) the same calls produce the same document in
+ * binary form: containers are indefinite-length maps and arrays, keys and
+ * strings are text strings, `json_writer_int` values are integers and
+ * `json_writer_number` values are floats. Only the encoding differs, so a
+ * value builder supports both formats without knowing which one is used.
+ */
+struct json_writer {
+	FILE *stream;
+	const char *space;
+	int depth;
+	bool is_array[JSON_WRITER_MAX_DEPTH];
+	int n_members[JSON_WRITER_MAX_DEPTH];
+	bool after_key;
+	bool error;
+	bool cbor;
+	bool compact;
+};
+
+/*****************************************************************************/
+/* Public function declarations                                              */
+/*****************************************************************************/
+
+/**
+ * json_writer_init() - Start a new JSON document.
+ * @jw: Writer to initialise.
+ * @stream: Output stream.
+ *
+ * The buffering of `stream` is left alone; whoever opens the stream should
+ * make it fully buffered (see `JSON_WRITER_BUF_SIZE`) before writing to it.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ */
+int json_writer_init(struct json_writer *jw, FILE *stream);
+
+/**
+ * json_writer_init_compact() - Start a new single line JSON document.
+ * @jw: Writer to initialise.
+ * @stream: Output stream.
+ *
+ * Like `json_writer_init`, but no newlines or indentation are written,
+ * which suits line based formats such as JSON Lines.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ */
+int json_writer_init_compact(struct json_writer *jw, FILE *stream);
+
+/**
+ * json_writer_init_cbor() - Start a new CBOR document.
+ * @jw: Writer to initialise.
+ * @stream: Output stream, which should be opened in binary mode.
+ *
+ * Like `json_writer_init`, but the document is encoded as CBOR.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ */
+int json_writer_init_cbor(struct json_writer *jw, FILE *stream);
+
+/**
+ * json_writer_begin_object() - Open a JSON object.
+ * @jw: Writer handle.
+ *
+ * Return: None.
+ */
+void json_writer_begin_object(struct json_writer *jw);
+
+/**
+ * json_writer_end_object() - Close the innermost JSON object.
+ * @jw: Writer handle.
+ *
+ * Return: None.
+ */
+void json_writer_end_object(struct json_writer *jw);
+
+/**
+ * json_writer_begin_array() - Open a JSON array.
+ * @jw: Writer handle.
+ *
+ * Return: None.
+ */
+void json_writer_begin_array(struct json_writer *jw);
+
+/**
+ * json_writer_end_array() - Close the innermost JSON array.
+ * @jw: Writer handle.
+ *
+ * Return: None.
+ */
+void json_writer_end_array(struct json_writer *jw);
+
+/**
+ * json_writer_key() - Write the key of the next object member.
+ * @jw: Writer handle.
+ * @key: Member name.
+ *
+ * Must be followed by exactly one value or container.
+ *
+ * Return: None.
+ */
+void json_writer_key(struct json_writer *jw, const char *key);
+
+/**
+ * json_writer_string() - Write a string value.
+ * @jw: Writer handle.
+ * @str: String to write (NULL writes `null`).
+ *
+ * Return: None.
+ */
+void json_writer_string(struct json_writer *jw, const char *str);
+
+/**
+ * json_writer_number() - Write a numeric value.
+ * @jw: Writer handle.
+ * @num: Number to write (non-finite values are written as `null`).
+ *
+ * In CBOR mode the value is written as a single precision float when
+ * that is lossless, and as a double otherwise.
+ *
+ * Return: None.
+ */
+void json_writer_number(struct json_writer *jw, double num);
+
+/**
+ * json_writer_int() - Write an integer value.
+ * @jw: Writer handle.
+ * @num: Integer to write.
+ *
+ * Produces the same JSON text as `json_writer_number` for integers, but is
+ * typed as an integer in CBOR mode and never loses precision.
+ *
+ * Return: None.
+ */
+void json_writer_int(struct json_writer *jw, int64_t num);
+
+/**
+ * json_writer_bool() - Write a boolean value.
+ * @jw: Writer handle.
+ * @b: Value to write.
+ *
+ * Return: None.
+ */
+void json_writer_bool(struct json_writer *jw, bool b);
+
+/**
+ * json_writer_null() - Write a null value.
+ * @jw: Writer handle.
+ *
+ * Return: None.
+ */
+void json_writer_null(struct json_writer *jw);
+
+/**
+ * json_writer_raw() - Write a value which has already been serialised.
+ * @jw: Writer handle.
+ * @json: A complete JSON value, such as a document written by another
+ *        writer. Leading and trailing whitespace is ignored.
+ * @len: Length of `json`.
+ *
+ * The value is re-indented to the current nesting level, so documents
+ * produced independently can be merged into a single one. In CBOR mode
+ * `json` must hold a single encoded CBOR item, which is copied verbatim
+ * apart from a leading self-described CBOR tag.
+ *
+ * Return: None.
+ */
+void json_writer_raw(struct json_writer *jw, const char *json, size_t len);
+
+/**
+ * json_writer_finish() - Complete the document.
+ * @jw: Writer handle.
+ *
+ * Any containers still open are closed first, so the output is always
+ * well formed even if the caller bailed out half way through. The stream
+ * is not flushed.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE if any error occurred.
+ */
+int json_writer_finish(struct json_writer *jw);
+
+#endif  /* AMI_APP_JSON_WRITER_H */
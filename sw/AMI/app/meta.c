@@ -12,10 +12,10 @@
 #include <string.h>
 #include <unistd.h>
 #include <time.h>
+#include <pthread.h>
 
 /* API includes */
 #include "ami.h"
-#include "json.h"
 #include "ami_version.h"
 #include "ami_program.h"
 #include "ami_mfg_info.h"
@@ -24,6 +24,9 @@
 #include "meta.h"
 #include "printer.h"
 #include "apputils.h"
+#include "fanout.h"
+#include "table.h"
+#include "subsys.h"
 
 /*****************************************************************************/
 /* Defines                                                                   */
@@ -43,20 +46,14 @@
 
 #define VERSION_HEADER_AMI	(0)
 
-/* Default fields */
-#define OVERVIEW_COL_BDF	(0)
-#define OVERVIEW_COL_NAME	(1)
-#define OVERVIEW_COL_SERIAL	(2)
-#define OVERVIEW_COL_UUID	(3)
-#define OVERVIEW_COL_AMC	(4)
-#define OVERVIEW_COL_STATE	(5)
-#define NUM_OVERVIEW_COLS	(6)
-
-/* Verbose only fields */
-#define OVERVIEW_COL_HWMON	(6)
-#define OVERVIEW_COL_CDEV	(7)
-/* Device overview table information */
-#define NUM_OVERVIEW_COLS_V	(8)
+/* Device overview (see `overview_fields`) */
+#define OVERVIEW_OPT_FIELDS		'F'
+#define OVERVIEW_FIELD_SEPARATOR	","
+#define OVERVIEW_VALUE_LEN		(AMI_MFG_INFO_MAX_STR)
+#define OVERVIEW_SERIAL_WIDTH		(16)	/* Longest EEPROM serial number */
+#define OVERVIEW_AMC_WIDTH		(20)	/* "255.255.255* (65535)" */
+#define OVERVIEW_STATE_WIDTH		(12)	/* "MISSING_INFO" */
+#define OVERVIEW_NUM_WIDTH		(5)
 
 /* PCI info */
 #define NUM_PCIEINFO_COLS	(2)
@@ -124,6 +121,116 @@
 
 #define NOT_APPLICABLE_FIELD		"N/A"
 
+/*****************************************************************************/
+/* Enums                                                                     */
+/*****************************************************************************/
+
+/**
+ * enum overview_field - Fields reported by the "overview" command.
+ * @OVERVIEW_FIELD_BDF: PCI BDF.
+ * @OVERVIEW_FIELD_NAME: Device name.
+ * @OVERVIEW_FIELD_SERIAL: Board serial number.
+ * @OVERVIEW_FIELD_UUID: Logic UUID.
+ * @OVERVIEW_FIELD_AMC: AMC version.
+ * @OVERVIEW_FIELD_STATE: Device state.
+ * @OVERVIEW_FIELD_HWMON: HWMON number (verbose only by default).
+ * @OVERVIEW_FIELD_CDEV: Character device number (verbose only by default).
+ * @NUM_OVERVIEW_FIELDS: Number of fields.
+ */
+enum overview_field {
+	OVERVIEW_FIELD_BDF = 0,
+	OVERVIEW_FIELD_NAME,
+	OVERVIEW_FIELD_SERIAL,
+	OVERVIEW_FIELD_UUID,
+	OVERVIEW_FIELD_AMC,
+	OVERVIEW_FIELD_STATE,
+	OVERVIEW_FIELD_HWMON,
+	OVERVIEW_FIELD_CDEV,
+
+	NUM_OVERVIEW_FIELDS
+};
+
+/*****************************************************************************/
+/* Structs                                                                   */
+/*****************************************************************************/
+
+/**
+ * struct overview_field_info - Schema of a field of the "overview" command.
+ * @name: Name used with `--fields`.
+ * @key: JSON key (NULL if the field is not part of the device object).
+ * @header: Table heading.
+ * @width: Widest value the field can take in the table.
+ * @verbose: Only shown by default with `-v`.
+ */
+struct overview_field_info {
+	const char *name;
+	const char *key;
+	const char *header;
+	int         width;
+	bool        verbose;
+};
+
+/**
+ * struct overview_cell - Value of a single field of a single device.
+ * @status: Result of the query (AMI_STATUS_OK or AMI_STATUS_ERROR).
+ * @val: Value, by field type.
+ * @val.str: Name, serial number, UUID or state.
+ * @val.num: HWMON or cdev number.
+ * @val.bdf: PCI BDF.
+ * @val.amc: AMC version.
+ */
+struct overview_cell {
+	int status;
+	union {
+		char               str[OVERVIEW_VALUE_LEN];
+		int                num;
+		uint16_t           bdf;
+		struct amc_version amc;
+	} val;
+};
+
+/**
+ * struct overview_data - Devices shown by the "overview" command.
+ * @devs: Device handles, in display order.
+ * @num_devs: Number of handles in `devs`.
+ * @fields: Selected fields (`enum overview_field`), in display order.
+ * @num_fields: Number of entries in `fields`.
+ * @cells: Collected values, `num_fields` per device.
+ * @pending: Number of outstanding queries of each device.
+ * @next_row: Next device to print when streaming the table.
+ * @table: Table rows are streamed to (NULL to only collect).
+ * @lock: Protects `pending`, `next_row` and the table output.
+ *
+ * Every (device, field) query is a separate job on the worker pool, so
+ * the command takes roughly as long as the slowest single query.
+ */
+struct overview_data {
+	ami_device **devs;
+	int num_devs;
+	int fields[NUM_OVERVIEW_FIELDS];
+	int num_fields;
+	struct overview_cell *cells;
+	int *pending;
+	int next_row;
+	struct table_stream *table;
+	pthread_mutex_t lock;
+};
+
+/*****************************************************************************/
+/* Global variables                                                          */
+/*****************************************************************************/
+
+static const struct overview_field_info overview_fields[NUM_OVERVIEW_FIELDS] = {
+	[OVERVIEW_FIELD_BDF]    = { "bdf",    NULL,            "BDF",           AMI_BDF_STR_LEN - 1,     false },
+	[OVERVIEW_FIELD_NAME]   = { "name",   "name",          "Device",        AMI_DEV_NAME_SIZE - 1,   false },
+	[OVERVIEW_FIELD_SERIAL] = { "serial", "serial_number", "Serial Number", OVERVIEW_SERIAL_WIDTH,   false },
+	[OVERVIEW_FIELD_UUID]   = { "uuid",   "uuid",          "UUID",          AMI_LOGIC_UUID_SIZE - 1, false },
+	[OVERVIEW_FIELD_AMC]    = { "amc",    "amc",           "AMC",           OVERVIEW_AMC_WIDTH,      false },
+	[OVERVIEW_FIELD_STATE]  = { "state",  "state",         "State",         OVERVIEW_STATE_WIDTH,    false },
+	[OVERVIEW_FIELD_HWMON]  = { "hwmon",  "hwmon",         "HWMON",         OVERVIEW_NUM_WIDTH,      true  },
+	[OVERVIEW_FIELD_CDEV]   = { "cdev",   "cdev",          "CDEV",          OVERVIEW_NUM_WIDTH,      true  },
+};
+
 /*****************************************************************************/
 /* Local function definitions                                                */
 /*****************************************************************************/
@@ -255,11 +362,8 @@ static int populate_fpt_values(ami_device *dev, void *values,
 						break;
 
 					case APP_OUT_FORMAT_JSON:
-						json_append_member(
-							(JsonNode*)values,
-							"version",
-							json_mknumber(hdr->version)
-						);
+						json_writer_key((struct json_writer*)values, "version");
+						json_writer_int((struct json_writer*)values, hdr->version);
 						break;
 
 					default:
@@ -277,11 +381,8 @@ static int populate_fpt_values(ami_device *dev, void *values,
 						break;
 
 					case APP_OUT_FORMAT_JSON:
-						json_append_member(
-							(JsonNode*)values,
-							"header_size",
-							json_mknumber(hdr->hdr_size)
-						);
+						json_writer_key((struct json_writer*)values, "header_size");
+						json_writer_int((struct json_writer*)values, hdr->hdr_size);
 						break;
 
 					default:
@@ -299,11 +400,8 @@ static int populate_fpt_values(ami_device *dev, void *values,
 						break;
 
 					case APP_OUT_FORMAT_JSON:
-						json_append_member(
-							(JsonNode*)values,
-							"entry_size",
-							json_mknumber(hdr->entry_size)
-						);
+						json_writer_key((struct json_writer*)values, "entry_size");
+						json_writer_int((struct json_writer*)values, hdr->entry_size);
 						break;
 
 					default:
@@ -321,11 +419,8 @@ static int populate_fpt_values(ami_device *dev, void *values,
 						break;
 
 					case APP_OUT_FORMAT_JSON:
-						json_append_member(
-							(JsonNode*)values,
-							"entries",
-							json_mknumber(hdr->num_entries)
-						);
+						json_writer_key((struct json_writer*)values, "entries");
+						json_writer_int((struct json_writer*)values, hdr->num_entries);
 						break;
 
 					default:
@@ -403,7 +498,7 @@ static int populate_version_values(ami_device *dev, void *values,
 	/* dev and data may be NULL */
 
 	/* Get the driver version. */
-	if (ami_get_driver_version(&driver_ver) != AMI_STATUS_OK)
+	if (app_driver_version(&driver_ver) != AMI_STATUS_OK)
 		return EXIT_FAILURE;
 
 	switch (fmt) {
@@ -466,30 +561,43 @@ static int populate_version_values(ami_device *dev, void *values,
 
 		case APP_OUT_FORMAT_JSON:
 		{
-			JsonNode *parent = (JsonNode*)values;
-			JsonNode *api_ver = json_mkobject();
-			JsonNode *drv_ver = json_mkobject();
-
-			/* Construct API version */
-			json_append_member(api_ver, "major", json_mknumber(GIT_TAG_VER_MAJOR));
-			json_append_member(api_ver, "minor", json_mknumber(GIT_TAG_VER_MINOR));
-			json_append_member(api_ver, "patch", json_mknumber(GIT_TAG_VER_PATCH));
-			json_append_member(api_ver, "commits", json_mknumber(GIT_TAG_VER_DEV_COMMITS));
-			json_append_member(api_ver, "status", json_mknumber(GIT_STATUS));
-			json_append_member(api_ver, "branch", json_mkstring(GIT_BRANCH));
-			json_append_member(api_ver, "hash", json_mkstring(GIT_HASH));
-			json_append_member(api_ver, "date", json_mkstring(GIT_DATE));
-
-			/* Construct driver version*/
-			json_append_member(drv_ver, "major", json_mknumber(driver_ver.major));
-			json_append_member(drv_ver, "minor", json_mknumber(driver_ver.minor));
-			json_append_member(drv_ver, "patch", json_mknumber(driver_ver.patch));
-			json_append_member(drv_ver, "commits", json_mknumber(driver_ver.dev_commits));
-			json_append_member(drv_ver, "status", json_mknumber(driver_ver.status));
-
-			/* Add to parent */
-			json_append_member(parent, "api", api_ver);
-			json_append_member(parent, "driver", drv_ver);
+			struct json_writer *jw = (struct json_writer*)values;
+
+			/* Stream API version */
+			json_writer_key(jw, "api");
+			json_writer_begin_object(jw);
+			json_writer_key(jw, "major");
+			json_writer_int(jw, GIT_TAG_VER_MAJOR);
+			json_writer_key(jw, "minor");
+			json_writer_int(jw, GIT_TAG_VER_MINOR);
+			json_writer_key(jw, "patch");
+			json_writer_int(jw, GIT_TAG_VER_PATCH);
+			json_writer_key(jw, "commits");
+			json_writer_int(jw, GIT_TAG_VER_DEV_COMMITS);
+			json_writer_key(jw, "status");
+			json_writer_int(jw, GIT_STATUS);
+			json_writer_key(jw, "branch");
+			json_writer_string(jw, GIT_BRANCH);
+			json_writer_key(jw, "hash");
+			json_writer_string(jw, GIT_HASH);
+			json_writer_key(jw, "date");
+			json_writer_string(jw, GIT_DATE);
+			json_writer_end_object(jw);
+
+			/* Stream driver version */
+			json_writer_key(jw, "driver");
+			json_writer_begin_object(jw);
+			json_writer_key(jw, "major");
+			json_writer_int(jw, driver_ver.major);
+			json_writer_key(jw, "minor");
+			json_writer_int(jw, driver_ver.minor);
+			json_writer_key(jw, "patch");
+			json_writer_int(jw, driver_ver.patch);
+			json_writer_key(jw, "commits");
+			json_writer_int(jw, driver_ver.dev_commits);
+			json_writer_key(jw, "status");
+			json_writer_int(jw, driver_ver.status);
+			json_writer_end_object(jw);
 			break;
 		}
 
@@ -649,51 +757,44 @@ static int construct_partition_row(struct ami_fpt_partition *part, int part_num,
 }
 
 /**
- * construct_partition_node() - Construct a single Json node with partition information
+ * construct_partition_node() - Write a single JSON object with partition information
  * @part: Partition data.
  * @part_num: Partition number.
- * @parent: Parent JSON object.
- * @n_fields: Number of expected elements in the JSON node.
+ * @jw: Writer positioned inside the parent JSON object.
+ * @n_fields: Number of expected elements in the JSON object.
  *
  * Return: EXIT_SUCCESS or EXIT_FAILURE
  */
 static int construct_partition_node(struct ami_fpt_partition *part, int part_num,
-	JsonNode *parent, int n_fields)
+	struct json_writer *jw, int n_fields)
 {
 	int col = 0;
 	char id_string[PARTITION_ID_STR_LEN] = { 0 };
-	JsonNode *row = NULL;
 	char pdi_md5_string[33] = { 0 };
+	const char *status = NULL;
 
-	if (!part || !parent)
+	if (!part || !jw)
 		return EXIT_FAILURE;
 
-	row = json_mkobject();
+	sprintf(id_string, "%d", part_num);
+	json_writer_key(jw, id_string);
+	json_writer_begin_object(jw);
 
 	for (col = 0; (col < n_fields) && (col < NUM_PARTITION_COLS); col++) {
 		switch (col) {
 			case PARTITION_COL_TYPE:
-				json_append_member(
-					row,
-					"type",
-					json_mkstring(fpt_partition_type_to_str(part->type))
-				);
+				json_writer_key(jw, "type");
+				json_writer_string(jw, fpt_partition_type_to_str(part->type));
 				break;
 
 			case PARTITION_COL_ADDR:
-				json_append_member(
-					row,
-					"address",
-					json_mknumber(part->base_addr)
-				);
+				json_writer_key(jw, "address");
+				json_writer_int(jw, part->base_addr);
 				break;
 
 			case PARTITION_COL_SIZE:
-				json_append_member(
-					row,
-					"size",
-					json_mknumber(part->size)
-				);
+				json_writer_key(jw, "size");
+				json_writer_int(jw, part->size);
 				break;
 
 			case PARTITION_COL_PDI_MD5:
@@ -702,35 +803,41 @@ static int construct_partition_node(struct ami_fpt_partition *part, int part_num
 					part->pdi_md5[4], part->pdi_md5[5], part->pdi_md5[6], part->pdi_md5[7],
 					part->pdi_md5[8], part->pdi_md5[9], part->pdi_md5[10], part->pdi_md5[11],
 					part->pdi_md5[12], part->pdi_md5[13], part->pdi_md5[14], part->pdi_md5[15]);
-				json_append_member(row, "pdi_md5", json_mkstring(pdi_md5_string));
+				json_writer_key(jw, "pdi_md5");
+				json_writer_string(jw, pdi_md5_string);
 				break;
 
 			case PARTITION_COL_PDI_SIZE:
-				json_append_member(row, "pdi_size", json_mknumber(part->pdi_size));
+				json_writer_key(jw, "pdi_size");
+				json_writer_int(jw, part->pdi_size);
 				break;
 
 			case PARTITION_COL_LOAD:
-				if (part->type == AMI_FPT_TYPE_PDI_USER) {
-					json_append_member(row, "Power-up Load", json_mkstring(
-						part->user.powerup_flag ? "Enabled" : "Disabled"));
-				} else {
-					json_append_member(row, "Power-up Load", json_mkstring("N/A"));
-				}
+				json_writer_key(jw, "Power-up Load");
+
+				if (part->type == AMI_FPT_TYPE_PDI_USER)
+					json_writer_string(jw,
+						part->user.powerup_flag ? "Enabled" : "Disabled");
+				else
+					json_writer_string(jw, "N/A");
 				break;
 
 			case PARTITION_COL_STATUS:
 				if (part->type == AMI_FPT_TYPE_PDI_USER) {
 					if (part->user.powerup_error == 0)
-						json_append_member(row, "status", json_mkstring("Not Loaded"));
+						status = "Not Loaded";
 					else if (part->user.powerup_error == 1)
-						json_append_member(row, "status", json_mkstring("Loaded"));
+						status = "Loaded";
 					else
-						json_append_member(row, "status", json_mkstring("Error"));
+						status = "Error";
 				} else if (part->user.powerup_error) {
-					json_append_member(row, "status", json_mkstring("Active"));
+					status = "Active";
 				} else {
-					json_append_member(row, "status", json_mkstring("In-Active"));
+					status = "In-Active";
 				}
+
+				json_writer_key(jw, "status");
+				json_writer_string(jw, status);
 				break;
 
 			default:
@@ -738,8 +845,7 @@ static int construct_partition_node(struct ami_fpt_partition *part, int part_num
 		}
 	}
 
-	sprintf(id_string, "%d", part_num);
-	json_append_member(parent, id_string, row);
+	json_writer_end_object(jw);
 	return EXIT_SUCCESS;
 }
 
@@ -787,7 +893,7 @@ static int populate_partition_values(ami_device *dev, void *values,
 				construct_partition_node(
 					&part,
 					i,
-					(JsonNode*)values,
+					(struct json_writer*)values,
 					*n_fields
 				);
 				break;
@@ -803,389 +909,392 @@ static int populate_partition_values(ami_device *dev, void *values,
 }
 
 /**
- * populate_overview_header() - Fill in the fields of the device overview table header.
- * @dev: AMI device handle. Not used.
- * @header: Pointer to pre-allocated header.
- * @num_fields: Number of elements in header.
- * @data: Implementation data. Not used.
+ * parse_overview_fields() - Select the fields shown by the "overview" command.
+ * @arg: Comma-separated list of field names (NULL for the default fields).
+ * @verbose: Add the verbose-only fields to the default fields.
+ * @ov: Overview data to fill in.
  *
  * Return: EXIT_SUCCESS or EXIT_FAILURE.
  */
-static int populate_overview_header(ami_device *dev, char **header,
-	int num_fields, void *data)
+static int parse_overview_fields(const char *arg, bool verbose,
+	struct overview_data *ov)
 {
-	int i = 0;
 	int ret = EXIT_SUCCESS;
+	int i = 0;
+	char *list = NULL;
+	char *tok = NULL;
+	char *saveptr = NULL;
 
-	if (!header)
-		return EXIT_FAILURE;
+	ov->num_fields = 0;
 
-	/* dev and data may be NULL */
-	for (i = 0; (i < num_fields) && (i < NUM_OVERVIEW_COLS_V); i++) {
-		if (!header[i]) {
-			ret = EXIT_FAILURE;
-			break;
-		}
+	if (!arg) {
+		for (i = 0; i < NUM_OVERVIEW_FIELDS; i++)
+			if (verbose || !overview_fields[i].verbose)
+				ov->fields[ov->num_fields++] = i;
 
-		switch (i) {
-			case OVERVIEW_COL_BDF:
-				sprintf(header[i], "%s", "BDF");
-				break;
+		return EXIT_SUCCESS;
+	}
 
-			case OVERVIEW_COL_NAME:
-				sprintf(header[i], "%s", "Device");
-				break;
+	list = strdup(arg);
 
-			case OVERVIEW_COL_SERIAL:
-				sprintf(header[i], "%s", "Serial Number");
-				break;
+	if (!list)
+		return EXIT_FAILURE;
 
-			case OVERVIEW_COL_UUID:
-				sprintf(header[i], "%s", "UUID");
-				break;
+	for (tok = strtok_r(list, OVERVIEW_FIELD_SEPARATOR, &saveptr); tok;
+			tok = strtok_r(NULL, OVERVIEW_FIELD_SEPARATOR, &saveptr)) {
+		int field = NUM_OVERVIEW_FIELDS;
 
-			case OVERVIEW_COL_HWMON:
-				sprintf(header[i], "%s", "HWMON");
+		for (i = 0; i < NUM_OVERVIEW_FIELDS; i++) {
+			if (strcmp(tok, overview_fields[i].name) == 0) {
+				field = i;
 				break;
+			}
+		}
 
-			case OVERVIEW_COL_CDEV:
-				sprintf(header[i], "%s", "CDEV");
-				break;
+		if (field == NUM_OVERVIEW_FIELDS) {
+			APP_ERROR("unknown overview field");
+			ret = EXIT_FAILURE;
+			break;
+		}
 
-			case OVERVIEW_COL_STATE:
-				sprintf(header[i], "%s", "State");
+		/* Ignore duplicates, so the field count stays bounded. */
+		for (i = 0; i < ov->num_fields; i++)
+			if (ov->fields[i] == field)
 				break;
 
-			case OVERVIEW_COL_AMC:
-				sprintf(header[i], "%s", "AMC");
-				break;
+		if (i == ov->num_fields)
+			ov->fields[ov->num_fields++] = field;
+	}
 
-			default:
-				break;
-		}
+	if ((ret == EXIT_SUCCESS) && (ov->num_fields == 0)) {
+		APP_ERROR("no overview fields selected");
+		ret = EXIT_FAILURE;
 	}
 
+	free(list);
 	return ret;
 }
 
 /**
- * construct_overview_node() - Construct a single Json node with device information
+ * query_overview_field() - Read a single overview field of a device.
  * @dev: Device handle.
- * @parent: Parent JSON object.
- * @n_fields: Number of expected elements in the JSON node.
+ * @field: Field to read (`enum overview_field`).
+ * @cell: Cell to hold the value.
  *
- * Return: EXIT_SUCCESS or EXIT_FAILURE
+ * Return: None. `cell->status` holds the result of the query.
  */
-static int construct_overview_node(ami_device *dev, JsonNode *parent, int n_fields)
+static void query_overview_field(ami_device *dev, int field,
+	struct overview_cell *cell)
 {
-	int col = 0;
-	uint16_t bdf = 0;
-	char bdf_string[AMI_BDF_STR_LEN] = { 0 };
-	JsonNode *row = NULL;
-	JsonNode *uuid_node = NULL;
-	JsonNode *name_node = NULL;
-	JsonNode *serial_node = NULL;
-	JsonNode *cdev_node = NULL;
-	JsonNode *state_node = NULL;
-	JsonNode *amc_node = NULL;
-	JsonNode *hwmon_node = NULL;
-
-	if (!dev || !parent)
-		return EXIT_FAILURE;
+	switch (field) {
+		case OVERVIEW_FIELD_BDF:
+			cell->status = ami_dev_get_pci_bdf(dev, &cell->val.bdf);
+			break;
 
-	row = json_mkobject();
+		case OVERVIEW_FIELD_NAME:
+			cell->status = ami_dev_get_name(dev, cell->val.str);
+			break;
 
-	for (col = 0; (col < n_fields) && (col < NUM_OVERVIEW_COLS_V); col++) {
-		switch (col) {
-			case OVERVIEW_COL_UUID:
-			{
-				char uuid[AMI_LOGIC_UUID_SIZE] = { 0 };
+		case OVERVIEW_FIELD_SERIAL:
+			cell->status = ami_mfg_get_info(dev, AMI_MFG_BOARD_SERIAL,
+				cell->val.str);
+			break;
 
-				if (ami_dev_read_uuid(dev, uuid) == AMI_STATUS_OK)
-					uuid_node = json_mkstring(uuid);
-				else
-					uuid_node = json_mknull();
+		case OVERVIEW_FIELD_UUID:
+			cell->status = ami_dev_read_uuid(dev, cell->val.str);
+			break;
 
-				json_append_member(row, "uuid", uuid_node);
-				break;
-			}
+		case OVERVIEW_FIELD_AMC:
+			cell->status = ami_dev_get_amc_version(dev, &cell->val.amc);
+			break;
 
-			case OVERVIEW_COL_NAME:
-			{
-				char name[AMI_DEV_NAME_SIZE] = { 0 };
+		case OVERVIEW_FIELD_STATE:
+			cell->status = ami_dev_get_state(dev, cell->val.str);
+			break;
 
-				if (ami_dev_get_name(dev, name) == AMI_STATUS_OK)
-					name_node = json_mkstring(name);
-				else
-					name_node = json_mknull();
+		case OVERVIEW_FIELD_HWMON:
+			cell->status = ami_dev_get_hwmon_num(dev, &cell->val.num);
+			break;
 
-				json_append_member(row, "name", name_node);
-				break;
-			}
+		case OVERVIEW_FIELD_CDEV:
+			cell->status = ami_dev_get_cdev_num(dev, &cell->val.num);
+			break;
 
-			case OVERVIEW_COL_SERIAL:
-			{
-				char serial[AMI_MFG_INFO_MAX_STR] = { 0 };
+		default:
+			cell->status = AMI_STATUS_ERROR;
+			break;
+	}
+}
 
-				if (ami_mfg_get_info(dev, AMI_MFG_BOARD_SERIAL, serial) == AMI_STATUS_OK)
-					serial_node = json_mkstring(serial);
-				else
-					serial_node = json_mknull();
+/**
+ * format_overview_cell() - Format an overview field for the table.
+ * @field: Field (`enum overview_field`).
+ * @cell: Value of the field.
+ * @buf: Buffer to hold the string.
+ * @size: Size of `buf`.
+ *
+ * The value is clipped to the width of the field in `overview_fields`.
+ *
+ * Return: None.
+ */
+static void format_overview_cell(int field, const struct overview_cell *cell,
+	char *buf, size_t size)
+{
+	const struct overview_field_info *info = &overview_fields[field];
+	bool ok = (cell->status == AMI_STATUS_OK);
+
+	buf[0] = '\0';
+
+	switch (field) {
+		case OVERVIEW_FIELD_BDF:
+			if (ok)
+				snprintf(
+					buf,
+					size,
+					"%02x:%02x.%01x",
+					AMI_PCI_BUS(cell->val.bdf),
+					AMI_PCI_DEV(cell->val.bdf),
+					AMI_PCI_FUNC(cell->val.bdf)
+				);
+			break;
 
-				json_append_member(row, "serial_number", serial_node);
-				break;
-			}
+		case OVERVIEW_FIELD_NAME:
+		case OVERVIEW_FIELD_STATE:
+			snprintf(buf, size, "%.*s", info->width,
+				ok ? cell->val.str : "Unknown");
+			break;
 
-			case OVERVIEW_COL_HWMON:
-			{
-				int hwmon = 0;
+		case OVERVIEW_FIELD_SERIAL:
+		case OVERVIEW_FIELD_UUID:
+			snprintf(buf, size, "%.*s", info->width,
+				ok ? cell->val.str : NOT_APPLICABLE_FIELD);
+			break;
 
-				if (ami_dev_get_hwmon_num(dev, &hwmon) == AMI_STATUS_OK)
-					hwmon_node = json_mknumber(hwmon);
-				else
-					hwmon_node = json_mknull();
+		case OVERVIEW_FIELD_AMC:
+			if (ok)
+				snprintf(
+					buf,
+					size,
+					"%d.%d.%d%c (%d)",
+					cell->val.amc.major,
+					cell->val.amc.minor,
+					cell->val.amc.patch,
+					(cell->val.amc.local_changes == 0) ? (' ') : ('*'),
+					cell->val.amc.dev_commits
+				);
+			else
+				snprintf(buf, size, "%s", "Unknown");
+			break;
 
-				json_append_member(row, "hwmon", hwmon_node);
-				break;
-			}
+		case OVERVIEW_FIELD_HWMON:
+		case OVERVIEW_FIELD_CDEV:
+			if (ok)
+				snprintf(buf, size, "%d", cell->val.num);
+			break;
 
-			case OVERVIEW_COL_CDEV:
-			{
-				int cdev = 0;
+		default:
+			break;
+	}
+}
 
-				if (ami_dev_get_cdev_num(dev, &cdev) == AMI_STATUS_OK)
-					cdev_node = json_mknumber(cdev);
-				else
-					cdev_node = json_mknull();
+/**
+ * write_overview_cell() - Write an overview field to a JSON/CBOR document.
+ * @field: Field (`enum overview_field`).
+ * @cell: Value of the field.
+ * @jw: JSON writer, positioned inside the object of the device.
+ *
+ * Fields without a JSON key (the BDF, which keys the device object) are
+ * skipped.
+ *
+ * Return: None.
+ */
+static void write_overview_cell(int field, const struct overview_cell *cell,
+	struct json_writer *jw)
+{
+	const struct overview_field_info *info = &overview_fields[field];
 
-				json_append_member(row, "cdev", cdev_node);
-				break;
-			}
+	if (!info->key)
+		return;
 
-			case OVERVIEW_COL_STATE:
-			{
-				char state[AMI_DEV_STATE_SIZE] = { 0 };
+	json_writer_key(jw, info->key);
 
-				if (ami_dev_get_state(dev, state) == AMI_STATUS_OK)
-					state_node = json_mkstring(state);
-				else
-					state_node = json_mknull();
+	if (cell->status != AMI_STATUS_OK) {
+		json_writer_null(jw);
+		return;
+	}
 
-				json_append_member(row, "state", state_node);
-				break;
-			}
+	switch (field) {
+		case OVERVIEW_FIELD_NAME:
+		case OVERVIEW_FIELD_SERIAL:
+		case OVERVIEW_FIELD_UUID:
+		case OVERVIEW_FIELD_STATE:
+			json_writer_string(jw, cell->val.str);
+			break;
 
-			case OVERVIEW_COL_AMC:
-			{
-				struct amc_version ver = { 0 };
-
-				if (ami_dev_get_amc_version(dev, &ver) == AMI_STATUS_OK) {
-					amc_node = json_mkobject();
-					json_append_member(amc_node, "major", json_mknumber(ver.major));
-					json_append_member(amc_node, "minor", json_mknumber(ver.minor));
-					json_append_member(amc_node, "patch", json_mknumber(ver.patch));
-					json_append_member(amc_node, "commits", json_mknumber(ver.dev_commits));
-					json_append_member(amc_node, "local_changes", json_mknumber(ver.local_changes));
-				} else {
-					amc_node = json_mknull();
-				}
+		case OVERVIEW_FIELD_AMC:
+			json_writer_begin_object(jw);
+			json_writer_key(jw, "major");
+			json_writer_int(jw, cell->val.amc.major);
+			json_writer_key(jw, "minor");
+			json_writer_int(jw, cell->val.amc.minor);
+			json_writer_key(jw, "patch");
+			json_writer_int(jw, cell->val.amc.patch);
+			json_writer_key(jw, "commits");
+			json_writer_int(jw, cell->val.amc.dev_commits);
+			json_writer_key(jw, "local_changes");
+			json_writer_int(jw, cell->val.amc.local_changes);
+			json_writer_end_object(jw);
+			break;
 
-				json_append_member(row, "amc", amc_node);
-				break;
-			}
+		case OVERVIEW_FIELD_HWMON:
+		case OVERVIEW_FIELD_CDEV:
+			json_writer_int(jw, cell->val.num);
+			break;
 
-			default:
-				break;
-		}
+		default:
+			json_writer_null(jw);
+			break;
 	}
-
-	ami_dev_get_pci_bdf(dev, &bdf);
-	sprintf(
-		bdf_string,
-		"%02x:%02x.%01x",
-		AMI_PCI_BUS(bdf), AMI_PCI_DEV(bdf), AMI_PCI_FUNC(bdf)
-	);
-	json_append_member(parent, bdf_string, row);
-
-	return EXIT_SUCCESS;
 }
 
 /**
- * construct_overview_row() - Construct a single table row with device information
- * @dev: Device handle.
- * @row: Row to fill in.
- * @n_fields: Number of expected elements in the row.
+ * print_overview_row() - Print the table row of a single device.
+ * @ov: Overview data.
+ * @index: Index of the device.
  *
- * Return: EXIT_SUCCESS or EXIT_FAILURE
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
  */
-static int construct_overview_row(ami_device *dev, char **row, int n_fields)
+static int print_overview_row(struct overview_data *ov, int index)
 {
-	int col = 0;
-
-	if (!dev || !row)
-		return EXIT_FAILURE;
-
-	for (col = 0; (col < n_fields) && (col < NUM_OVERVIEW_COLS_V); col++) {
-		switch (col) {
-			case OVERVIEW_COL_BDF:
-			{
-				uint16_t bdf = 0;
-
-				if (ami_dev_get_pci_bdf(dev, &bdf) == AMI_STATUS_OK)
-					sprintf(
-						row[col],
-						"%02x:%02x.%01x",
-						AMI_PCI_BUS(bdf), AMI_PCI_DEV(bdf), AMI_PCI_FUNC(bdf)
-					);
-
-				break;
-			}
-
-			case OVERVIEW_COL_NAME:
-			{
-				char name[AMI_DEV_NAME_SIZE] = { 0 };
-
-				if (ami_dev_get_name(dev, name) == AMI_STATUS_OK)
-					sprintf(row[col], "%s", name);
-				else
-					sprintf(row[col], "%s", "Unknown");
-				break;
-			}
+	int i = 0;
+	char buf[NUM_OVERVIEW_FIELDS][OVERVIEW_VALUE_LEN] = { { 0 } };
+	char *values[NUM_OVERVIEW_FIELDS] = { 0 };
+
+	for (i = 0; i < ov->num_fields; i++) {
+		format_overview_cell(
+			ov->fields[i],
+			&ov->cells[(index * ov->num_fields) + i],
+			buf[i],
+			sizeof(buf[i])
+		);
+		values[i] = buf[i];
+	}
 
-			case OVERVIEW_COL_SERIAL:
-			{
-				char serial[AMI_MFG_INFO_MAX_STR] = { 0 };
+	return print_table_stream_row(ov->table, values);
+}
 
-				if (ami_mfg_get_info(dev, AMI_MFG_BOARD_SERIAL, serial) == AMI_STATUS_OK)
-					sprintf(row[col], "%s", serial);
-				else
-					sprintf(row[col], "%s", "N/A");
-				break;
-			}
-			case OVERVIEW_COL_UUID:
-			{
-				char uuid[AMI_LOGIC_UUID_SIZE] = { 0 };
+/**
+ * overview_query_job() - Read a single field of a single device.
+ * @index: Index of the query (device index * number of fields + field index).
+ * @data: Pointer to the `struct overview_data`.
+ *
+ * Queries of all devices are handed out in one pool, so a slow field of
+ * one device doesn't hold up the others. When streaming a table, the job
+ * completing the last outstanding field of the next row in device order
+ * prints that row (and any completed rows following it).
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ */
+static int overview_query_job(int index, void *data)
+{
+	int ret = EXIT_SUCCESS;
+	struct overview_data *ov = (struct overview_data*)data;
+	int dev = index / ov->num_fields;
 
-				if (ami_dev_read_uuid(dev, uuid) == AMI_STATUS_OK)
-					sprintf(row[col], "%s", uuid);
-				else
-					sprintf(row[col], "%s", "N/A");
+	query_overview_field(
+		ov->devs[dev],
+		ov->fields[index % ov->num_fields],
+		&ov->cells[index]
+	);
 
-				break;
-			}
+	pthread_mutex_lock(&ov->lock);
+	ov->pending[dev]--;
 
-			case OVERVIEW_COL_HWMON:
-			{
-				int hwmon = 0;
+	if (ov->table) {
+		while ((ov->next_row < ov->num_devs) &&
+				(ov->pending[ov->next_row] == 0)) {
+			if (print_overview_row(ov, ov->next_row) != EXIT_SUCCESS)
+				ret = EXIT_FAILURE;
 
-				if (ami_dev_get_hwmon_num(dev, &hwmon) == AMI_STATUS_OK)
-					sprintf(row[col], "%d", hwmon);
+			ov->next_row++;
+		}
+	}
 
-				break;
-			}
+	pthread_mutex_unlock(&ov->lock);
+	return ret;
+}
 
-			case OVERVIEW_COL_CDEV:
-			{
-				int cdev = 0;
+/**
+ * collect_overview() - Query the selected fields of all devices.
+ * @ov: Overview data, with the devices and fields filled in.
+ * @table: Table to stream completed rows to (NULL to only collect).
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ */
+static int collect_overview(struct overview_data *ov, struct table_stream *table)
+{
+	int ret = EXIT_FAILURE;
+	int i = 0;
 
-				if (ami_dev_get_cdev_num(dev, &cdev) == AMI_STATUS_OK)
-					sprintf(row[col], "%d", cdev);
+	if (ov->num_devs == 0)
+		return EXIT_SUCCESS;
 
-				break;
-			}
+	ov->cells = (struct overview_cell*)calloc(
+		ov->num_devs * ov->num_fields, sizeof(struct overview_cell));
+	ov->pending = (int*)calloc(ov->num_devs, sizeof(int));
 
-			case OVERVIEW_COL_STATE:
-			{
-				char state[AMI_DEV_STATE_SIZE] = { 0 };
+	if (!ov->cells || !ov->pending)
+		return EXIT_FAILURE;
 
-				if (ami_dev_get_state(dev, state) == AMI_STATUS_OK)
-					sprintf(row[col], "%s", state);
-				else
-					sprintf(row[col], "%s", "Unknown");
-				break;
-			}
+	for (i = 0; i < ov->num_devs; i++)
+		ov->pending[i] = ov->num_fields;
 
-			case OVERVIEW_COL_AMC:
-			{
-				struct amc_version ver = { 0 };
+	ov->next_row = 0;
+	ov->table = table;
+	pthread_mutex_init(&ov->lock, NULL);
 
-			if (ami_dev_get_amc_version(dev, &ver) == AMI_STATUS_OK)
-				sprintf(
-					row[col],
-					"%d.%d.%d%c (%d)",
-					ver.major,
-					ver.minor,
-					ver.patch,
-					(ver.local_changes == 0) ? (' ') : ('*'),
-					ver.dev_commits
-				);
-			else
-					sprintf(row[col], "%s", "Unknown");
-				break;
-			}
+	ret = run_parallel(ov->num_devs * ov->num_fields, &overview_query_job, ov);
 
-			default:
-				break;
-		}
-	}
+	pthread_mutex_destroy(&ov->lock);
+	ov->table = NULL;
 
-	return EXIT_SUCCESS;
+	return ret;
 }
 
 /**
- * populate_overview_values() - Populate an arbitrary data structure with device
- *   overview information for printing.
- * @dev: Device handle. Not used.
- * @values: Pointer to data structure
- * @n_rows:  Pointer to number of rows (records) in data structure.
- * @n_fields:  Pointer to number of elements in each row.
- * @fmt: Format of data structure. Used to determine type of `values`.
- * @data: Implementation data. Not used.
+ * write_overview_devices() - Write the collected overview of every device.
+ * @ov: Overview data, filled in by `collect_overview`.
+ * @jw: JSON writer, positioned inside the "physical_functions" object.
  *
- * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ * Return: None.
  */
-static int populate_overview_values(ami_device *dev, void *values,
-	int *n_rows, int *n_fields, enum app_out_format fmt, void *data)
+static void write_overview_devices(struct overview_data *ov, struct json_writer *jw)
 {
-	int i = 0;
-	ami_device *device = NULL;
-	ami_device *prev = NULL;
+	int i = 0, j = 0;
 
-	if (!values || !n_rows || !n_fields)
-		return EXIT_FAILURE;
+	for (i = 0; i < ov->num_devs; i++) {
+		uint16_t bdf = 0;
+		char bdf_string[AMI_BDF_STR_LEN] = { 0 };
 
-	/* dev and data may be NULL */
-	while ((i < *n_rows) &&
-		(ami_dev_find_next(&device, AMI_ANY_DEV, AMI_ANY_DEV, AMI_ANY_DEV, prev)
-			== AMI_STATUS_OK)) {
-
-		switch (fmt) {
-			case APP_OUT_FORMAT_TABLE:
-				construct_overview_row(device, ((char***)values)[i], *n_fields);
-				break;
+		ami_dev_get_pci_bdf(ov->devs[i], &bdf);
+		sprintf(
+			bdf_string,
+			"%02x:%02x.%01x",
+			AMI_PCI_BUS(bdf), AMI_PCI_DEV(bdf), AMI_PCI_FUNC(bdf)
+		);
 
-			case APP_OUT_FORMAT_JSON:
-				construct_overview_node(device, (JsonNode*)values, *n_fields);
-				break;
+		json_writer_key(jw, bdf_string);
+		json_writer_begin_object(jw);
 
-			default:
-				break;
-		}
+		for (j = 0; j < ov->num_fields; j++)
+			write_overview_cell(
+				ov->fields[j],
+				&ov->cells[(i * ov->num_fields) + j],
+				jw
+			);
 
-		/* Move to next device. */
-		ami_dev_delete(&prev);
-		prev = device;
-		device = NULL;
-		i++;
+		json_writer_end_object(jw);
 	}
-
-	/* Check if we could iterate over the devices */
-	if (i < *n_rows)
-		APP_WARN("could not fetch device data");
-
-	/* Delete final device. */
-	ami_dev_delete(&prev);
-	return EXIT_SUCCESS;
 }
 
 /**
@@ -1264,14 +1373,13 @@ static int populate_pcieinfo_values(ami_device *dev, void *values,
 
 				case APP_OUT_FORMAT_JSON:
 				{
-					JsonNode *vendor_node = NULL;
+					struct json_writer *jw = (struct json_writer*)values;
 
+					json_writer_key(jw, "vendor");
 					if (r == AMI_STATUS_OK)
-						vendor_node = json_mknumber(vendor);
+						json_writer_int(jw, vendor);
 					else
-						vendor_node = json_mknull();
-
-					json_append_member((JsonNode*)values, "vendor", vendor_node);
+						json_writer_null(jw);
 					break;
 				}
 
@@ -1294,14 +1402,13 @@ static int populate_pcieinfo_values(ami_device *dev, void *values,
 
 				case APP_OUT_FORMAT_JSON:
 				{
-					JsonNode *device_node = NULL;
+					struct json_writer *jw = (struct json_writer*)values;
 
+					json_writer_key(jw, "device");
 					if (r == AMI_STATUS_OK)
-						device_node = json_mknumber(device);
+						json_writer_int(jw, device);
 					else
-						device_node = json_mknull();
-
-					json_append_member((JsonNode*)values, "device", device_node);
+						json_writer_null(jw);
 					break;
 				}
 
@@ -1324,20 +1431,19 @@ static int populate_pcieinfo_values(ami_device *dev, void *values,
 
 				case APP_OUT_FORMAT_JSON:
 				{
-					JsonNode *link_node = NULL;
+					struct json_writer *jw = (struct json_writer*)values;
 
+					json_writer_key(jw, "link_speed");
 					if (r == AMI_STATUS_OK) {
-						JsonNode *max_node = json_mknumber(max);
-						JsonNode *current_node = json_mknumber(current);
-
-						link_node = json_mkobject();
-						json_append_member(link_node, "max", max_node);
-						json_append_member(link_node, "current", current_node);
+						json_writer_begin_object(jw);
+						json_writer_key(jw, "max");
+						json_writer_int(jw, max);
+						json_writer_key(jw, "current");
+						json_writer_int(jw, current);
+						json_writer_end_object(jw);
 					} else {
-						link_node = json_mknull();
+						json_writer_null(jw);
 					}
-
-					json_append_member((JsonNode*)values, "link_speed", link_node);
 					break;
 				}
 
@@ -1360,20 +1466,19 @@ static int populate_pcieinfo_values(ami_device *dev, void *values,
 
 				case APP_OUT_FORMAT_JSON:
 				{
-					JsonNode *width_node = NULL;
+					struct json_writer *jw = (struct json_writer*)values;
 
+					json_writer_key(jw, "link_width");
 					if (r == AMI_STATUS_OK) {
-						JsonNode *max_node = json_mknumber(max);
-						JsonNode *current_node = json_mknumber(current);
-
-						width_node = json_mkobject();
-						json_append_member(width_node, "max", max_node);
-						json_append_member(width_node, "current", current_node);
+						json_writer_begin_object(jw);
+						json_writer_key(jw, "max");
+						json_writer_int(jw, max);
+						json_writer_key(jw, "current");
+						json_writer_int(jw, current);
+						json_writer_end_object(jw);
 					} else {
-						width_node = json_mknull();
+						json_writer_null(jw);
 					}
-
-					json_append_member((JsonNode*)values, "link_width", width_node);
 					break;
 				}
 
@@ -1396,14 +1501,13 @@ static int populate_pcieinfo_values(ami_device *dev, void *values,
 
 				case APP_OUT_FORMAT_JSON:
 				{
-					JsonNode *numa_node = NULL;
+					struct json_writer *jw = (struct json_writer*)values;
 
+					json_writer_key(jw, "numa_node");
 					if (r == AMI_STATUS_OK)
-						numa_node = json_mknumber(numa);
+						json_writer_int(jw, numa);
 					else
-						numa_node = json_mknull();
-
-					json_append_member((JsonNode*)values, "numa_node", numa_node);
+						json_writer_null(jw);
 					break;
 				}
 
@@ -1430,14 +1534,13 @@ static int populate_pcieinfo_values(ami_device *dev, void *values,
 
 				case APP_OUT_FORMAT_JSON:
 				{
-					JsonNode *cpu_node = NULL;
+					struct json_writer *jw = (struct json_writer*)values;
 
+					json_writer_key(jw, "cpu_affinity");
 					if (r == AMI_STATUS_OK)
-						cpu_node = json_mkstring(buf);
+						json_writer_string(jw, buf);
 					else
-						cpu_node = json_mknull();
-
-					json_append_member((JsonNode*)values, "cpu_affinity", cpu_node);
+						json_writer_null(jw);
 					break;
 				}
 
@@ -1658,11 +1761,8 @@ static int populate_mfg_info_values(ami_device *dev, void *values,
 						break;
 
 					case APP_OUT_FORMAT_JSON:
-						json_append_member(
-							(JsonNode*)values,
-							header,
-							json_mkstring(eeprom_buf)
-						);
+						json_writer_key((struct json_writer*)values, header);
+						json_writer_string((struct json_writer*)values, eeprom_buf);
 						break;
 
 					default:
@@ -1709,11 +1809,8 @@ static int populate_mfg_info_values(ami_device *dev, void *values,
 						break;
 
 					case APP_OUT_FORMAT_JSON:
-						json_append_member(
-							(JsonNode*)values,
-							header,
-							json_mkstring(manufacturing_date_str)
-						);
+						json_writer_key((struct json_writer*)values, header);
+						json_writer_string((struct json_writer*)values, manufacturing_date_str);
 						break;
 
 					default:
@@ -1745,11 +1842,8 @@ static int populate_mfg_info_values(ami_device *dev, void *values,
 						break;
 
 					case APP_OUT_FORMAT_JSON:
-						json_append_member(
-							(JsonNode*)values,
-							header,
-							json_mkstring(oem_str)
-						);
+						json_writer_key((struct json_writer*)values, header);
+						json_writer_string((struct json_writer*)values, oem_str);
 						break;
 
 					default:
@@ -1781,15 +1875,30 @@ static int populate_mfg_info_values(ami_device *dev, void *values,
 int print_overview(struct app_option *options)
 {
 	int ret = EXIT_FAILURE;
+	int i = 0;
 	enum app_out_format format = APP_OUT_FORMAT_TABLE;  /* default: table */
 	FILE *stream = NULL;
 	uint16_t num_devices = 0;
 	bool verbose = false;
+	struct app_option *device = NULL;
+	struct app_option *fields = NULL;
+	struct overview_data ov = { 0 };
+	struct table_stream table = { 0 };
+	char *header[NUM_OVERVIEW_FIELDS] = { 0 };
+	int widths[NUM_OVERVIEW_FIELDS] = { 0 };
 
 	if (parse_output_options(options, &format, &verbose, &stream,
 			NULL, NULL) == EXIT_FAILURE)
 		return EXIT_FAILURE;
 
+	/* Only the selected fields are ever queried. */
+	fields = find_app_option(OVERVIEW_OPT_FIELDS, options);
+
+	if (parse_overview_fields(fields ? fields->arg : NULL, verbose, &ov) != EXIT_SUCCESS) {
+		ret = EXIT_FAILURE;
+		goto fail;
+	}
+
 	/* Print version information. */
 	ret = print_table_data(
 		NULL,
@@ -1808,70 +1917,98 @@ int print_overview(struct app_option *options)
 		goto fail;
 	}
 
-	/* Print device overview. */
-	ret = ami_dev_get_num_devices(&num_devices);
+	/* Open the requested devices (default: all of them). */
+	device = find_app_option('d', options);
 
-	if (ret == EXIT_FAILURE) {
-		APP_API_ERROR("failed to fetch device data");
-		goto fail;
+	if (device) {
+		if (open_device_list(device->arg, &ov.devs, &ov.num_devs) != EXIT_SUCCESS) {
+			ret = EXIT_FAILURE;
+			goto fail;
+		}
+	} else {
+		ret = ami_dev_get_num_devices(&num_devices);
+
+		if (ret == EXIT_FAILURE) {
+			APP_API_ERROR("failed to fetch device data");
+			goto fail;
+		}
+
+		if ((num_devices != 0) &&
+				(open_device_list(NULL, &ov.devs, &ov.num_devs) != EXIT_SUCCESS)) {
+			ret = EXIT_FAILURE;
+			goto fail;
+		}
 	}
 
-	ret = print_table_data(
-		NULL,
-		((verbose) ? (NUM_OVERVIEW_COLS_V) : (NUM_OVERVIEW_COLS)),
-		num_devices,
-		(format == APP_OUT_FORMAT_TABLE) ? (stream) : (NULL),
+	/*
+	 * The column widths come from the field schema, so the header can be
+	 * printed before any value is known and rows printed as they complete.
+	 */
+	for (i = 0; i < ov.num_fields; i++) {
+		header[i] = (char*)overview_fields[ov.fields[i]].header;
+		widths[i] = overview_fields[ov.fields[i]].width;
+	}
+
+	ret = print_table_stream_begin(
+		&table,
+		header,
+		ov.num_fields,
+		widths,
 		TABLE_DIVIDER_HEADER_ONLY,
-		&populate_overview_values,
-		&populate_overview_header,
-		NULL,
+		(format == APP_OUT_FORMAT_TABLE) ? (stream) : (NULL),
 		NULL
 	);
 
-	if (ret)
+	if (ret == EXIT_SUCCESS) {
+		if (collect_overview(&ov, &table) != EXIT_SUCCESS)
+			APP_WARN("could not fetch device data");
+
+		print_table_stream_end(&table);
+	} else {
 		APP_ERROR("could not print overview data");
+	}
 
 	/* Write to file. */
 	if (stream && (ret != EXIT_FAILURE) && (format != APP_OUT_FORMAT_TABLE)) {
 		switch (format) {
 		case APP_OUT_FORMAT_JSON:
+		case APP_OUT_FORMAT_CBOR:
 		{
-			JsonNode *v = NULL;
-			JsonNode *o = NULL;
-
-			ret = gen_json_data(
-				NULL,
-				NUM_VERSION_COLS,
-				NUM_VERSION_ROWS,
-				&populate_version_values,
-				NULL,
-				&v
-			);
+			struct json_writer jw = { 0 };
+			int n_rows = NUM_VERSION_ROWS;
+			int n_fields = NUM_VERSION_COLS;
+
+			if (format == APP_OUT_FORMAT_CBOR)
+				ret = print_cbor_stream_begin(&jw, stream);
+			else
+				ret = print_json_stream_begin(&jw, stream);
 
 			if (ret == EXIT_SUCCESS) {
-				ret = gen_json_data(
+				json_writer_key(&jw, "version");
+				json_writer_begin_object(&jw);
+				ret = populate_version_values(
 					NULL,
-					((verbose) ? (NUM_OVERVIEW_COLS_V) : (NUM_OVERVIEW_COLS)),
-					num_devices,
-					&populate_overview_values,
-					NULL,
-					&o
+					&jw,
+					&n_rows,
+					&n_fields,
+					APP_OUT_FORMAT_JSON,
+					NULL
 				);
+				json_writer_end_object(&jw);
 
 				if (ret == EXIT_SUCCESS) {
-					JsonNode *parent = NULL;
-
-					parent = json_mkobject();
-					json_append_member(parent, "version", v);
-					json_append_member(parent, "physical_functions", o);
-
-					print_json_obj(parent, stream);
-					json_delete(parent);
+					/* Values were collected while printing the table. */
+					json_writer_key(&jw, "physical_functions");
+					json_writer_begin_object(&jw);
+					if (ov.cells)
+						write_overview_devices(&ov, &jw);
+					json_writer_end_object(&jw);
 				} else {
-					APP_ERROR("could not create overview json");
+					APP_ERROR("could not create version json");
 				}
-			} else {
-				APP_ERROR("could not create version json");
+
+				if (print_json_stream_end(&jw) != EXIT_SUCCESS)
+					ret = EXIT_FAILURE;
 			}
 			break;
 		}
@@ -1883,6 +2020,10 @@ int print_overview(struct app_option *options)
 	}
 
 fail:
+	free(ov.cells);
+	free(ov.pending);
+	ami_dev_delete_all(&ov.devs, ov.num_devs);
+
 	if (stream)
 		fclose(stream);
 
@@ -1925,7 +2066,7 @@ int print_pcieinfo(ami_device *dev, struct app_option *options)
 	if (stream && (ret != EXIT_FAILURE) && (format != APP_OUT_FORMAT_TABLE)) {
 		switch (format) {
 			case APP_OUT_FORMAT_JSON:
-				ret = print_json_data(
+				ret = print_json_stream(
 					dev,
 					NUM_PCIEINFO_COLS,
 					NUM_PCIEINFO_ROWS,
@@ -1939,6 +2080,21 @@ int print_pcieinfo(ami_device *dev, struct app_option *options)
 
 				break;
 
+			case APP_OUT_FORMAT_CBOR:
+				ret = print_cbor_stream(
+					dev,
+					NUM_PCIEINFO_COLS,
+					NUM_PCIEINFO_ROWS,
+					stream,
+					&populate_pcieinfo_values,
+					NULL
+				);
+
+				if (ret)
+					APP_ERROR("could not create pcieinfo cbor");
+
+				break;
+
 			default:
 				break;
 		}
@@ -1974,10 +2130,10 @@ int print_fpt_info(ami_device *dev, uint8_t boot_device, struct app_option *opti
 		goto fail;
 	} else if ((hdr.version == 0) && (hdr.hdr_size == 0) &&
 		   (hdr.entry_size == 0) && (hdr.num_entries == 0)) {
-		printf("No %s FPT available\r\n", (boot_device == 0)?("Primary"):("Secondary"));
+		my_fprintf(NULL, "No %s FPT available\r\n", (boot_device == 0)?("Primary"):("Secondary"));
 		goto fail;
 	} else {
-		printf("\r\n%s FPT: \r\n", (boot_device == 0)?("Primary"):("Secondary"));
+		my_fprintf(NULL, "\r\n%s FPT: \r\n", (boot_device == 0)?("Primary"):("Secondary"));
 	}
 
 	/* Print FPT header information. */
@@ -2015,44 +2171,56 @@ int print_fpt_info(ami_device *dev, uint8_t boot_device, struct app_option *opti
 	if (stream && (ret != EXIT_FAILURE) && (format != APP_OUT_FORMAT_TABLE)) {
 		switch (format) {
 			case APP_OUT_FORMAT_JSON:
+			case APP_OUT_FORMAT_CBOR:
 			{
-				JsonNode *h = NULL;
-				JsonNode *p = NULL;
+				struct json_writer jw = { 0 };
+				int n_rows = NUM_FPT_HEADER_ROWS;
+				int n_fields = NUM_FPT_HEADER_COLS;
 
-				ret = gen_json_data(
+				if (format == APP_OUT_FORMAT_CBOR)
+					ret = print_cbor_stream_begin(&jw, stream);
+				else
+					ret = print_json_stream_begin(&jw, stream);
+
+				if (ret != EXIT_SUCCESS)
+					break;
+
+				json_writer_key(&jw, "header");
+				json_writer_begin_object(&jw);
+				ret = populate_fpt_values(
 					dev,
-					NUM_FPT_HEADER_COLS,
-					NUM_FPT_HEADER_ROWS,
-					&populate_fpt_values,
-					&hdr,
-					&h
+					&jw,
+					&n_rows,
+					&n_fields,
+					APP_OUT_FORMAT_JSON,
+					&hdr
 				);
+				json_writer_end_object(&jw);
 
 				if (ret == EXIT_SUCCESS) {
-					ret = gen_json_data(
+					n_rows = hdr.num_entries;
+					n_fields = NUM_PARTITION_COLS;
+
+					json_writer_key(&jw, "partitions");
+					json_writer_begin_object(&jw);
+					ret = populate_partition_values(
 						dev,
-						NUM_PARTITION_COLS,
-						hdr.num_entries,
-						&populate_partition_values,
-						&boot_device,
-						&p
+						&jw,
+						&n_rows,
+						&n_fields,
+						APP_OUT_FORMAT_JSON,
+						&boot_device
 					);
+					json_writer_end_object(&jw);
 
-					if (ret == EXIT_SUCCESS) {
-						JsonNode *parent = NULL;
-
-						parent = json_mkobject();
-						json_append_member(parent, "header", h);
-						json_append_member(parent, "partitions", p);
-
-						print_json_obj(parent, stream);
-						json_delete(parent);
-					} else {
+					if (ret != EXIT_SUCCESS)
 						APP_ERROR("could not create partition json");
-					}
 				} else {
 					APP_ERROR("could not create FPT header json");
 				}
+
+				if (print_json_stream_end(&jw) != EXIT_SUCCESS)
+					ret = EXIT_FAILURE;
 				break;
 			}
 
@@ -2105,7 +2273,7 @@ int print_mfg_info(ami_device *dev, struct app_option *options)
 	if (stream && (ret != EXIT_FAILURE) && (format != APP_OUT_FORMAT_TABLE)) {
 		switch (format) {
 			case APP_OUT_FORMAT_JSON:
-				ret = print_json_data(
+				ret = print_json_stream(
 					dev,
 					NUM_MFG_INFO_COLS,
 					NUM_MFG_INFO_ROWS,
@@ -2118,6 +2286,20 @@ int print_mfg_info(ami_device *dev, struct app_option *options)
 					APP_ERROR("could not create mfg_info json");
 			break;
 
+			case APP_OUT_FORMAT_CBOR:
+				ret = print_cbor_stream(
+					dev,
+					NUM_MFG_INFO_COLS,
+					NUM_MFG_INFO_ROWS,
+					stream,
+					&populate_mfg_info_values,
+					NULL
+				);
+
+				if (ret)
+					APP_ERROR("could not create mfg_info cbor");
+			break;
+
 			default:
 				break;
 		}
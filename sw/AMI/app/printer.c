@@ -14,28 +14,139 @@
 #include <math.h>
 
 /* App includes */
-#include "json.h"
 #include "table.h"
 #include "printer.h"
 
+/*****************************************************************************/
+/* Global variables                                                          */
+/*****************************************************************************/
+
+/* Output capture of the current thread (NULL if printing directly). */
+static __thread struct print_capture *capture = NULL;
+
+/*****************************************************************************/
+/* Local function declarations                                               */
+/*****************************************************************************/
+
+/**
+ * out_stream() - Get the stream standing in for stdout.
+ *
+ * Return: The capture stream of the calling thread, or stdout.
+ */
+static FILE *out_stream(void);
+
+/*****************************************************************************/
+/* Local function definitions                                                */
+/*****************************************************************************/
+
+/*
+ * Get the screen output stream.
+ */
+static FILE *out_stream(void)
+{
+	return (capture) ? (capture->out_stream) : (stdout);
+}
+
 /*****************************************************************************/
 /* Public function definitions                                               */
 /*****************************************************************************/
 
+/*
+ * Start capturing output.
+ */
+int print_capture_begin(struct print_capture *cap)
+{
+	if (!cap)
+		return EXIT_FAILURE;
+
+	cap->out_stream = open_memstream(&cap->out, &cap->out_len);
+
+	if (!cap->out_stream)
+		return EXIT_FAILURE;
+
+	cap->file_stream = NULL;
+	capture = cap;
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Stop capturing output.
+ */
+void print_capture_end(struct print_capture *cap)
+{
+	if (!cap)
+		return;
+
+	if (capture == cap)
+		capture = NULL;
+
+	/* The file stream is owned (and closed) by whoever opened it. */
+	cap->file_stream = NULL;
+
+	if (cap->out_stream) {
+		fclose(cap->out_stream);
+		cap->out_stream = NULL;
+	}
+}
+
+/*
+ * Free capture buffers.
+ */
+void print_capture_free(struct print_capture *cap)
+{
+	if (!cap)
+		return;
+
+	free(cap->out);
+	free(cap->file);
+	cap->out = NULL;
+	cap->file = NULL;
+	cap->out_len = 0;
+	cap->file_len = 0;
+}
+
+/*
+ * Open an output file.
+ */
+FILE *open_output_file(const char *fname)
+{
+	FILE *fp = NULL;
+
+	if (!capture) {
+		if (!fname)
+			return NULL;
+
+		/* Nothing has been written yet, so the buffer can still change. */
+		fp = fopen(fname, "w");
+		if (fp)
+			setvbuf(fp, NULL, _IOFBF, JSON_WRITER_BUF_SIZE);
+
+		return fp;
+	}
+
+	/* Only a single output file per job. */
+	if (capture->file_stream || capture->file)
+		return NULL;
+
+	capture->file_stream = open_memstream(&capture->file, &capture->file_len);
+	return capture->file_stream;
+}
+
 /*
  * Print to stdout and write to a secondary stream.
  */
 void my_fprintf(FILE *stream, const char *format, ...)
 {
 	va_list args_stdout, args_stream;
+	FILE *out = out_stream();
 
 	/* Write to stdout. */
 	va_start(args_stdout, format);
-	vfprintf(stdout, format, args_stdout);
+	vfprintf(out, format, args_stdout);
 	va_end(args_stdout);
 
 	/* Write to output stream. */
-	if (stream && (stream != stdout)) {
+	if (stream && (stream != stdout) && (stream != out)) {
 		va_start(args_stream, format);
 		vfprintf(stream, format, args_stream);
 		va_end(args_stream);
@@ -47,11 +158,13 @@ void my_fprintf(FILE *stream, const char *format, ...)
  */
 void my_putc(const char c, FILE *stream)
 {
+	FILE *out = out_stream();
+
 	/* Write to stdout. */
-	putc(c, stdout);
+	putc(c, out);
 
 	/* Write to output stream. */
-	if (stream && (stream != stdout)) {
+	if (stream && (stream != stdout) && (stream != out)) {
 		putc(c, stream);
 	}
 }
@@ -81,22 +194,23 @@ void print_hexdump(uint64_t start_addr, void *values, uint32_t num_values,
 
 	for (i = 0; i < num_values; i++) {
 		if ((i % num_groups) == 0)
-			printf(
+			my_fprintf(
+				NULL,
 				"[ " "0x%016" PRIx64 " ]\t",
 				start_addr + (i * value_size)
 			);
 
 		switch (value_size) {
 			case sizeof(uint8_t):
-				printf(" %02x", ((uint8_t*)values)[i]);
+				my_fprintf(NULL, " %02x", ((uint8_t*)values)[i]);
 				break;
 
 			case sizeof(uint16_t):
-				printf(" %04x", ((uint16_t*)values)[i]);
+				my_fprintf(NULL, " %04x", ((uint16_t*)values)[i]);
 				break;
 
 			case sizeof(uint32_t):
-				printf(" %08x", ((uint32_t*)values)[i]);
+				my_fprintf(NULL, " %08x", ((uint32_t*)values)[i]);
 				break;
 
 			default:
@@ -105,12 +219,12 @@ void print_hexdump(uint64_t start_addr, void *values, uint32_t num_values,
 
 		/* Check if last element */
 		if (((i + 1) % num_groups) == 0)
-			printf("\r\n");
+			my_fprintf(NULL, "\r\n");
 	}
 
 	/* Print final new line only if it wasn't printed in the loop */
 	if ((i % num_groups) != 0)
-		printf("\r\n");
+		my_fprintf(NULL, "\r\n");
 }
 
 /*
@@ -235,77 +349,114 @@ int print_table_data(ami_device *dev, int n_fields, int n_rows, FILE *stream,
 }
 
 /*
- * Generate a JSON data object.
+ * Start a streamed JSON document.
  */
-int gen_json_data(ami_device *dev, int n_fields, int n_rows,
-	app_value_builder populate_values, void *data, JsonNode **out)
+int print_json_stream_begin(struct json_writer *jw, FILE *stream)
+{
+	if (!jw || !stream)
+		return EXIT_FAILURE;
+
+	if (json_writer_init(jw, stream) != EXIT_SUCCESS)
+		return EXIT_FAILURE;
+
+	fputs("\r\n", stream);
+	json_writer_begin_object(jw);
+
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Start streaming a CBOR document.
+ */
+int print_cbor_stream_begin(struct json_writer *jw, FILE *stream)
+{
+	/* Tag 55799 with a 16 bit argument */
+	static const uint8_t magic[] = { 0xD9, 0xD9, 0xF7 };
+
+	if (!jw || !stream)
+		return EXIT_FAILURE;
+
+	if (json_writer_init_cbor(jw, stream) != EXIT_SUCCESS)
+		return EXIT_FAILURE;
+
+	fwrite(magic, sizeof(magic[0]), sizeof(magic), stream);
+	json_writer_begin_object(jw);
+
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Finish a streamed JSON document.
+ */
+int print_json_stream_end(struct json_writer *jw)
 {
 	int ret = EXIT_FAILURE;
-	JsonNode *parent = json_mkobject();
 
-	if (!out)
+	if (!jw || !jw->stream)
 		return EXIT_FAILURE;
 
-	/* Note that `dev`, and `data` may be NULL */
+	ret = json_writer_finish(jw);
 
-	/* Add data to parent. */
-	ret = populate_values(dev, parent, &n_rows, &n_fields,
-		APP_OUT_FORMAT_JSON, data);
+	/* Binary documents are not line based. */
+	if (!jw->cbor)
+		fputs("\r\n", jw->stream);
 
-	if (ret == EXIT_SUCCESS)
-		*out = parent;
+	if (fflush(jw->stream) != 0)
+		ret = EXIT_FAILURE;
 
 	return ret;
 }
 
 /*
- * Print a JSON object.
+ * Stream data in JSON format.
  */
-int print_json_obj(JsonNode *obj, FILE *stream)
+int print_json_stream(ami_device *dev, int n_fields, int n_rows, FILE *stream,
+	app_value_builder populate_values, void *data)
 {
-	char *json = NULL;
+	int ret = EXIT_FAILURE;
+	struct json_writer jw = { 0 };
 
-	if (!obj || !stream)
+	/* Note that `dev`, and `data` may be NULL */
+
+	if (!populate_values)
 		return EXIT_FAILURE;
 
-	/* Generate JSON string. */
-	json = json_stringify(obj, "\t");
-	fprintf(stream, "\r\n%s\r\n", json);
+	if (print_json_stream_begin(&jw, stream) != EXIT_SUCCESS)
+		return EXIT_FAILURE;
 
-	/* Cleanup. */
-	free(json);
+	ret = populate_values(dev, &jw, &n_rows, &n_fields,
+		APP_OUT_FORMAT_JSON, data);
 
-	return EXIT_SUCCESS;
+	/* Always terminate the document, even if populating failed. */
+	if (print_json_stream_end(&jw) != EXIT_SUCCESS)
+		ret = EXIT_FAILURE;
+
+	return ret;
 }
 
 /*
- * Print data in JSON format.
+ * Stream data in CBOR format.
  */
-int print_json_data(ami_device *dev, int n_fields, int n_rows, FILE *stream,
+int print_cbor_stream(ami_device *dev, int n_fields, int n_rows, FILE *stream,
 	app_value_builder populate_values, void *data)
 {
 	int ret = EXIT_FAILURE;
-	JsonNode *parent = json_mkobject();
+	struct json_writer jw = { 0 };
 
 	/* Note that `dev`, and `data` may be NULL */
 
-	/* For JSON, `stream` must be specified. */
-	if (!stream)
+	if (!populate_values)
+		return EXIT_FAILURE;
+
+	if (print_cbor_stream_begin(&jw, stream) != EXIT_SUCCESS)
 		return EXIT_FAILURE;
 
-	ret = gen_json_data(
-		dev,
-		n_fields,
-		n_rows,
-		populate_values,
-		data,
-		&parent
-	);
+	ret = populate_values(dev, &jw, &n_rows, &n_fields,
+		APP_OUT_FORMAT_JSON, data);
 
-	if (ret == EXIT_SUCCESS)
-		ret = print_json_obj(parent, stream);
+	if (print_json_stream_end(&jw) != EXIT_SUCCESS)
+		ret = EXIT_FAILURE;
 
-	json_delete(parent);
 	return ret;
 }
 
@@ -15,7 +15,7 @@
 #include <stdio.h>
 
 /* External Includes */
-#include "json.h"
+#include "json_writer.h"
 
 /* API Includes */
 #include "ami_device.h"
@@ -38,15 +38,43 @@
  * enum app_out_format - Output format for commands which report info.
  * @APP_OUT_FORMAT_TABLE: Format data into a table.
  * @APP_OUT_FORMAT_JSON: Format data as JSON.
+ * @APP_OUT_FORMAT_CBOR: Format data as CBOR (same document as JSON).
  * @APP_OUT_FORMAT_INVALID: Unrecognised output format.
  */
 enum app_out_format {
 	APP_OUT_FORMAT_TABLE,
 	APP_OUT_FORMAT_JSON,
+	APP_OUT_FORMAT_CBOR,
 
 	APP_OUT_FORMAT_INVALID = -1,
 };
 
+/*****************************************************************************/
+/* Structs                                                                   */
+/*****************************************************************************/
+
+/**
+ * struct print_capture - Output of a job running on a worker thread.
+ * @out: Everything the job printed to stdout.
+ * @out_len: Length of `out`.
+ * @file: Everything the job wrote to its output file (NULL if none).
+ * @file_len: Length of `file`.
+ * @out_stream: Stream standing in for stdout while capturing.
+ * @file_stream: Stream standing in for the output file while capturing.
+ *
+ * Commands running against several devices at once must not interleave
+ * their output, so each job prints into memory and the caller emits the
+ * buffers in order once every job is done.
+ */
+struct print_capture {
+	char *out;
+	size_t out_len;
+	char *file;
+	size_t file_len;
+	FILE *out_stream;
+	FILE *file_stream;
+};
+
 /*****************************************************************************/
 /* Typedefs                                                                  */
 /*****************************************************************************/
@@ -60,8 +88,9 @@ enum app_out_format {
  * @fmt: Output format/format of data structure.
  * @data: Implementation specific data.
  *
- * Fuctions of this type should be passed to the functions `print_json`
- * and `print_table` to print arbitrary data in a specific format.
+ * Fuctions of this type should be passed to the functions `print_json_stream`
+ * and `print_table` to print arbitrary data in a specific format. For JSON
+ * and CBOR, `values` is a `struct json_writer`.
  *
  * Return: EXIT_SUCCESS or EXIT_FAILURE
  */
@@ -112,6 +141,46 @@ void my_fprintf(FILE *stream, const char *format, ...);
  */
 void my_putc(const char c, FILE *stream);
 
+/**
+ * print_capture_begin() - Redirect the output of the calling thread.
+ * @cap: Capture buffers (zero initialised).
+ *
+ * Until `print_capture_end` is called, everything printed through
+ * `my_fprintf`, `my_putc` and `print_hexdump` from this thread is stored
+ * in `cap->out`, and the file opened by `open_output_file` is stored in
+ * `cap->file`. The buffers must be released with `print_capture_free`.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ */
+int print_capture_begin(struct print_capture *cap);
+
+/**
+ * print_capture_end() - Stop redirecting the output of the calling thread.
+ * @cap: Capture started with `print_capture_begin`.
+ *
+ * Return: None.
+ */
+void print_capture_end(struct print_capture *cap);
+
+/**
+ * print_capture_free() - Free the buffers of a capture.
+ * @cap: Capture to free.
+ *
+ * Return: None.
+ */
+void print_capture_free(struct print_capture *cap);
+
+/**
+ * open_output_file() - Open a file given with the `-o` option for writing.
+ * @fname: Path to the file.
+ *
+ * If output is being captured on the calling thread, the capture buffer is
+ * returned instead and `fname` is not touched.
+ *
+ * Return: Output stream (to be closed with `fclose`) or NULL.
+ */
+FILE *open_output_file(const char *fname);
+
 /**
  * print_divider() - Utility function to print a divider of variable length.
  * @c: Character to use.
@@ -135,35 +204,42 @@ void print_hexdump(uint64_t start_addr, void *values, uint32_t num_values,
 	uint8_t num_groups, size_t value_size);
 
 /**
- * gen_json_data() - Create a JSON object from arbitrary data.
- * @dev: Device handle (optional).
- * @n_fields: Number of fields in each row (object).
- * @n_rows: Number of rows (objects).
- * @populate_values: Implementation specific function to populate JSON values.
- * @data: Implementation specific data (optional).
- * @out: Argument to store the generated JSON object.
+ * print_json_stream_begin() - Start streaming a JSON document.
+ * @jw: Writer to initialise.
+ * @stream: Output stream.
  *
- * This function allocates the memory for a top level JSON parent,
- * populates it with children objects, and returns the resulting object via
- * the `out` parameter. If you only want to print the resulting JSON, see the
- * function `print_json_data`.
+ * Opens the top level JSON object. Members can then be written directly
+ * with the `json_writer_*` functions; nothing is built in memory.
  *
  * Return: EXIT_SUCCESS or EXIT_FAILURE.
  */
-int gen_json_data(ami_device *dev, int n_fields, int n_rows,
-	app_value_builder populate_values, void *data, JsonNode **out);
+int print_json_stream_begin(struct json_writer *jw, FILE *stream);
 
 /**
- * print_json_obj() - Print a JSON object as a human readable string
- * @obj: Object to print.
+ * print_cbor_stream_begin() - Start streaming a CBOR document.
+ * @jw: Writer to initialise.
  * @stream: Output stream.
  *
+ * Same as `print_json_stream_begin`, but the document is encoded as CBOR.
+ * It starts with the self-described CBOR tag (0xD9D9F7) so files can be
+ * recognised, and carries the same keys as the JSON document; integers
+ * and floats keep their type.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ */
+int print_cbor_stream_begin(struct json_writer *jw, FILE *stream);
+
+/**
+ * print_json_stream_end() - Finish a document started with
+ *   `print_json_stream_begin` or `print_cbor_stream_begin`.
+ * @jw: Writer handle.
+ *
  * Return: EXIT_SUCCESS or EXIT_FAILURE.
  */
-int print_json_obj(JsonNode *obj, FILE *stream);
+int print_json_stream_end(struct json_writer *jw);
 
 /**
- * print_json_data() - Print arbitrary data as a JSON string.
+ * print_json_stream() - Stream arbitrary data as a JSON string.
  * @dev: Device handle (optional).
  * @n_fields: Number of fields in each row (object).
  * @n_rows: Number of rows (objects).
@@ -171,9 +247,29 @@ int print_json_obj(JsonNode *obj, FILE *stream);
  * @populate_values: Implementation specific function to populate JSON values.
  * @data: Implementation specific data (optional).
  *
+ * `populate_values` is passed a `struct json_writer` positioned inside the
+ * top level object as its `values` argument.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ */
+int print_json_stream(ami_device *dev, int n_fields, int n_rows, FILE *stream,
+	app_value_builder populate_values, void *data);
+
+/**
+ * print_cbor_stream() - Stream arbitrary data as a CBOR document.
+ * @dev: Device handle (optional).
+ * @n_fields: Number of fields in each row (object).
+ * @n_rows: Number of rows (objects).
+ * @stream: Output stream.
+ * @populate_values: Implementation specific function to populate values.
+ * @data: Implementation specific data (optional).
+ *
+ * Same as `print_json_stream`; `populate_values` is still passed
+ * `APP_OUT_FORMAT_JSON` as the writer takes care of the encoding.
+ *
  * Return: EXIT_SUCCESS or EXIT_FAILURE.
  */
-int print_json_data(ami_device *dev, int n_fields, int n_rows, FILE *stream,
+int print_cbor_stream(ami_device *dev, int n_fields, int n_rows, FILE *stream,
 	app_value_builder populate_values, void *data);
 
 /**
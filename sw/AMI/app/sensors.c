@@ -10,7 +10,8 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
-#include <math.h>
+#include <signal.h>
+#include <time.h>
 
 /* API includes */
 #include "ami.h"
@@ -18,10 +19,12 @@
 #include "ami_device.h"
 
 /* App includes */
-#include "json.h"
+#include "json_writer.h"
 #include "printer.h"
 #include "sensors.h"
 #include "apputils.h"
+#include "fanout.h"
+#include "subsys.h"
 
 /*****************************************************************************/
 /* Defines                                                                   */
@@ -34,10 +37,32 @@
 #define TABLE_VALUE		(1)
 #define TABLE_STATUS		(2)
 
-#define UNIT_MOD_BASE		(10)
 #define UNIT_STR_SIZE		(2 + 1)
 #define LIMIT_STR_SIZE		(7 + 1)  /* xxx.xxx + NULL */
-#define AUX_CABLE_CONNECTED_THRESHOLD_MV	(10.0)
+#define AUX_CABLE_CONNECTED_THRESHOLD_MV	(10000)
+
+/* Fixed-point values are printed with this many decimal places */
+#define FIXED_DECIMALS		(3)
+#define FIXED_SCALE		(1000LL)  /* 10^FIXED_DECIMALS */
+#define FIXED_MAX_EXP		(18)      /* largest power of ten in a long long */
+
+/* Watch mode */
+#define WATCH_COL_NAME		(0)
+#define WATCH_COL_VALUE		(1)
+#define WATCH_COL_STATUS	(2)
+#define WATCH_COL_MIN		(3)
+#define WATCH_COL_MAX		(4)
+#define WATCH_COL_AVG		(5)
+#define WATCH_NUM_COLS		(3)
+#define WATCH_NUM_COLS_WINDOW	(6)
+#define WATCH_VALUE_WIDTH	(14)  /* wide enough for most values + unit */
+#define WATCH_STATUS_WIDTH	(7)   /* strlen("invalid") */
+#define WATCH_MIN_INTERVAL_MS	(10)
+#define WATCH_MAX_WINDOW	(3600)
+
+#define MS_PER_S		(1000)
+#define NS_PER_MS		(1000000L)
+#define NS_PER_S		(1000000000L)
 
 /*****************************************************************************/
 /* Structs                                                                   */
@@ -58,21 +83,60 @@
  * @limit_c_r: Return value of relevant `ami_sensor_get_xxx_limit` call.
  * @limit_f: Fatal limit.
  * @limit_f_r: Return value of relevant `ami_sensor_get_xxx_limit` call.
+ *
+ * All values are raw readings: the value in base units is `value * 10^mod`.
  */
 struct sensor_values {
-	double value;
+	long value;
 	enum ami_sensor_status status;
 	enum ami_sensor_unit_mod mod;
-	double max;
-	int    max_r;
-	double avg;
-	int    avg_r;
-	double limit_w;
-	int    limit_w_r;
-	double limit_c;
-	int    limit_c_r;
-	double limit_f;
-	int    limit_f_r;
+	long max;
+	int  max_r;
+	long avg;
+	int  avg_r;
+	long limit_w;
+	int  limit_w_r;
+	long limit_c;
+	int  limit_c_r;
+	long limit_f;
+	int  limit_f_r;
+};
+
+/**
+ * struct watch_row - A single sensor type being watched.
+ * @sensor: Sensor name (owned by the device sensor list).
+ * @type: Sensor type (a single `enum ami_sensor_type` value).
+ * @mod: Unit modifier of the raw values.
+ * @unit: Unit string.
+ * @samples: Ring buffer of the most recent valid values (raw).
+ * @n_samples: Number of valid entries in `samples`.
+ * @head: Next slot to write in `samples`.
+ *
+ * The unit modifier is read once when the watch starts, so every tick is a
+ * single value read per row.
+ */
+struct watch_row {
+	const char *sensor;
+	uint32_t    type;
+	int         mod;
+	char        unit[UNIT_STR_SIZE];
+	long       *samples;
+	int         n_samples;
+	int         head;
+};
+
+/*****************************************************************************/
+/* Global variables                                                          */
+/*****************************************************************************/
+
+static volatile sig_atomic_t watch_stop = 0;
+
+static const long long pow10_table[FIXED_MAX_EXP + 1] = {
+	1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL,
+	100000000LL, 1000000000LL, 10000000000LL, 100000000000LL,
+	1000000000000LL, 10000000000000LL, 100000000000000LL,
+	1000000000000000LL, 10000000000000000LL, 100000000000000000LL,
+	1000000000000000000LL
 };
 
 /*****************************************************************************/
@@ -128,6 +192,68 @@ static int parse_extra(struct app_option *options, int *extra)
 	return ret;
 }
 
+/**
+ * fixed_to_milli() - Convert a raw reading into thousandths of a base unit.
+ * @num: Raw value (or sum of raw values).
+ * @den: Divisor applied to `num` (e.g. number of samples); must be > 0.
+ * @mod: Unit modifier, i.e. `num / den` is in units of 10^mod.
+ *
+ * Only integer arithmetic is used; the result is rounded half away
+ * from zero.
+ *
+ * Return: `(num / den) * 10^(mod + FIXED_DECIMALS)`, rounded.
+ */
+static long long fixed_to_milli(long long num, long long den, int mod)
+{
+	int shift = mod + FIXED_DECIMALS;
+
+	if (shift > FIXED_MAX_EXP)
+		shift = FIXED_MAX_EXP;
+	else if (shift < -FIXED_MAX_EXP)
+		shift = -FIXED_MAX_EXP;
+
+	if (shift >= 0)
+		num *= pow10_table[shift];
+	else
+		den *= pow10_table[-shift];
+
+	if (num >= 0)
+		return (num + (den / 2)) / den;
+
+	return -((-num + (den / 2)) / den);
+}
+
+/**
+ * format_fixed() - Format a fixed-point value as an exact decimal.
+ * @buf: Output buffer.
+ * @size: Size of `buf`.
+ * @milli: Value in thousandths of a base unit (see `fixed_to_milli`).
+ * @unit: Unit string to append after a space (NULL for none).
+ *
+ * Produces the same text as `"%.3f %s"` for the converted value, except
+ * that halfway cases are rounded in decimal rather than depending on the
+ * binary representation of a double.
+ *
+ * Return: Number of characters written, as `snprintf`.
+ */
+static int format_fixed(char *buf, size_t size, long long milli, const char *unit)
+{
+	unsigned long long abs_milli = (milli < 0) ?
+		(0ULL - (unsigned long long)milli) : ((unsigned long long)milli);
+
+	return snprintf(
+		buf,
+		size,
+		"%s%llu.%0*llu%s%s",
+		(milli < 0) ? ("-") : (""),
+		abs_milli / FIXED_SCALE,
+		FIXED_DECIMALS,
+		abs_milli % FIXED_SCALE,
+		(unit) ? (" ") : (""),
+		(unit) ? (unit) : ("")
+	);
+}
+
 /**
  * make_unit_string() - Construct a human readable sensor unit string.
  * @mod: Unit modifier.
@@ -268,16 +394,14 @@ static int populate_sensor_header(ami_device *dev, char **header,
  * @sensor_type: Sensor type (relevant bit MUST be extracted from bitflag).
  * @extra_fields: Extra fields bitflag.
  * @values: Struct to hold all relevant sensor data.
- * @convert_units: Boolean indicating whether sensor values should be converted
- *   based on the sensor unit modifier.
  *
- * Note, if `convert_units` is NULL, all values will be converted to their
- * non-modified version (as if the mod was AMI_SENSOR_UNIT_MOD_NONE).
+ * Values are returned unconverted together with their unit modifier; use
+ * `fixed_to_milli` to scale them.
  *
  * Return: None.
  */
 static void get_all_sensor_values(ami_device *dev, const char *sensor,
-	int sensor_type, int extra_fields, struct sensor_values *values, bool convert_units)
+	int sensor_type, int extra_fields, struct sensor_values *values)
 {
 	long v = 0, a = 0, m = 0;
 	long lw = 0, lc = 0, lf = 0;
@@ -361,37 +485,43 @@ static void get_all_sensor_values(ami_device *dev, const char *sensor,
 			break;
 	}
 
-	if (convert_units) {
-		/* Convert units */
-		values->value = (double)v * pow(UNIT_MOD_BASE, (double)modifier);
-
-		if ((extra_fields & EXTRA_FIELDS_MAX) && ((values->max_r) == AMI_STATUS_OK))
-			values->max = (double)m * pow(UNIT_MOD_BASE, (double)modifier);
-
-		if ((extra_fields & EXTRA_FIELDS_AVG) && ((values->max_r) == AMI_STATUS_OK))
-			values->avg = (double)a * pow(UNIT_MOD_BASE, (double)modifier);
+	values->mod = modifier;
+	values->value = v;
+	values->max = m;
+	values->avg = a;
+	values->limit_w = lw;
+	values->limit_c = lc;
+	values->limit_f = lf;
+}
 
-		if (extra_fields & EXTRA_FIELDS_LIMITS) {
-			if (values->limit_w_r == AMI_STATUS_OK)
-				values->limit_w = (double)lw * pow(UNIT_MOD_BASE, (double)modifier);
+/**
+ * watch_handle_signal() - Stop watch mode on SIGINT/SIGTERM.
+ * @sig: Signal number. Not used.
+ *
+ * Return: None.
+ */
+static void watch_handle_signal(int sig)
+{
+	watch_stop = 1;
+}
 
-			if (values->limit_c_r == AMI_STATUS_OK)
-				values->limit_c = (double)lc * pow(UNIT_MOD_BASE, (double)modifier);
+/**
+ * sensor_status_str() - Convert a sensor status into a table string.
+ * @status: Sensor status.
+ *
+ * Return: "valid", "valid*" (cached) or "invalid".
+ */
+static const char *sensor_status_str(enum ami_sensor_status status)
+{
+	switch (status) {
+		case AMI_SENSOR_STATUS_OK:
+			return "valid";
 
-			if (values->limit_f_r == AMI_STATUS_OK)
-				values->limit_f = (double)lf * pow(UNIT_MOD_BASE, (double)modifier);
-		}
+		case AMI_SENSOR_STATUS_OK_CACHED:
+			return "valid*";
 
-		values->mod = AMI_SENSOR_UNIT_MOD_NONE;
-	} else {
-		/* Store original values */
-		values->mod = modifier;
-		values->value = (double)v;
-		values->max = (double)m;
-		values->avg = (double)a;
-		values->limit_w = (double)lw;
-		values->limit_c = (double)lc;
-		values->limit_f = (double)lf;
+		default:
+			return "invalid";
 	}
 }
 
@@ -418,7 +548,7 @@ static int mk_sensor_row(ami_device *dev, const char *sensor,
 	if (!dev || !sensor || !row)
 		return EXIT_FAILURE;
 
-	get_all_sensor_values(dev, sensor, sensor_type, extra_fields, &values, true);
+	get_all_sensor_values(dev, sensor, sensor_type, extra_fields, &values);
 
 	if (make_unit_string(AMI_SENSOR_UNIT_MOD_NONE, sensor_type, unit) == EXIT_FAILURE)
 		memset(unit, 0x00, UNIT_STR_SIZE);
@@ -430,28 +560,25 @@ static int mk_sensor_row(ami_device *dev, const char *sensor,
 		col++;
 
 	/* Print value - always valid. */
-	sprintf(row[col++], "%.3f %s", values.value, unit);
+	format_fixed(row[col++], TABLE_FIELD_MAX,
+		fixed_to_milli(values.value, 1, values.mod), unit);
 
 	/* Print status - always valid. */
-	sprintf(
-		row[col++],
-		"%s",
-		(((values.status == AMI_SENSOR_STATUS_OK) || (values.status == AMI_SENSOR_STATUS_OK_CACHED)) ?
-			((values.status == AMI_SENSOR_STATUS_OK_CACHED) ? ("valid*") : ("valid")) :
-			("invalid"))
-	);
+	sprintf(row[col++], "%s", sensor_status_str(values.status));
 
 	/* Extra attributes. */
 	if (extra_fields & EXTRA_FIELDS_MAX) {
 		if (values.max_r == AMI_STATUS_OK)
-			sprintf(row[col++], "%.3f %s", values.max, unit);
+			format_fixed(row[col++], TABLE_FIELD_MAX,
+				fixed_to_milli(values.max, 1, values.mod), unit);
 		else
 			sprintf(row[col++], "%s", "N/A");
 	}
 
 	if (extra_fields & EXTRA_FIELDS_AVG) {
 		if (values.avg_r == AMI_STATUS_OK)
-			sprintf(row[col++], "%.3f %s", values.avg, unit);
+			format_fixed(row[col++], TABLE_FIELD_MAX,
+				fixed_to_milli(values.avg, 1, values.mod), unit);
 		else
 			sprintf(row[col++], "%s", "N/A");
 	}
@@ -468,19 +595,22 @@ static int mk_sensor_row(ami_device *dev, const char *sensor,
 
 			/* Warning limit */
 			if (values.limit_w_r == AMI_STATUS_OK)
-				sprintf(limit_w_str, "%.3f", values.limit_w);
+				format_fixed(limit_w_str, LIMIT_STR_SIZE,
+					fixed_to_milli(values.limit_w, 1, values.mod), NULL);
 			else
 				sprintf(limit_w_str, "%s", "N/A");
 
 			/* Critical limit */
 			if (values.limit_c_r == AMI_STATUS_OK)
-				sprintf(limit_c_str, "%.3f", values.limit_c);
+				format_fixed(limit_c_str, LIMIT_STR_SIZE,
+					fixed_to_milli(values.limit_c, 1, values.mod), NULL);
 			else
 				sprintf(limit_c_str, "%s", "N/A");
 
 			/* Fatal limit */
 			if (values.limit_f_r == AMI_STATUS_OK)
-				sprintf(limit_f_str, "%.3f", values.limit_f);
+				format_fixed(limit_f_str, LIMIT_STR_SIZE,
+					fixed_to_milli(values.limit_f, 1, values.mod), NULL);
 			else
 				sprintf(limit_f_str, "%s", "N/A");
 
@@ -545,153 +675,143 @@ static int construct_sensor_table(ami_device *dev, char ***rows,
 }
 
 /**
- * mk_sensor_node() - Construct a single Json node for a sensor.
+ * mk_sensor_node() - Stream a single Json object for a sensor.
  * @dev: Device handle.
  * @sensor: Sensor name.
  * @sensor_type: Sensor type (relevant bits MUST be extracted).
  * @extra_fields: Extra fields bitflag.
- * @parent: Parent node.
+ * @jw: JSON writer, positioned inside the sensor group object.
  *
  * Return: EXIT_SUCCESS or EXIT_FAILURE.
  */
 static int mk_sensor_node(ami_device *dev, const char *sensor,
-	int sensor_type, int extra_fields, JsonNode *parent)
+	int sensor_type, int extra_fields, struct json_writer *jw)
 {
-	int ret = EXIT_SUCCESS;
+	const char *type_key = NULL;
 	struct sensor_values values = { 0 };
 
-	JsonNode *row = NULL;  /* sensor object belonging to the group */
-	/* Object attributes */
-	JsonNode *unit_node = NULL;
-	JsonNode *value_node = NULL;
-	JsonNode *status_node = NULL;
-	JsonNode *max_node = NULL;
-	JsonNode *avg_node = NULL;
-	JsonNode *limits_node = NULL;
-
-	if (!dev || !sensor || !parent)
+	if (!dev || !sensor || !jw)
 		return EXIT_FAILURE;
 
-	get_all_sensor_values(dev, sensor, sensor_type, extra_fields, &values, false);
+	switch (sensor_type) {
+		case AMI_SENSOR_TYPE_TEMP:
+			type_key = "temp";
+			break;
 
-	row = json_mkobject();
+		case AMI_SENSOR_TYPE_CURRENT:
+			type_key = "current";
+			break;
 
-	/* All objects have value, status, and unit. */
-	value_node = json_mknumber(values.value);
-	unit_node = json_mknumber(values.mod);
-	status_node = json_mknumber(values.status);
+		case AMI_SENSOR_TYPE_VOLTAGE:
+			type_key = "voltage";
+			break;
+
+		case AMI_SENSOR_TYPE_POWER:
+			type_key = "power";
+			break;
 
-	json_append_member(row, "unit_mod", unit_node);
-	json_append_member(row, "value", value_node);
-	json_append_member(row, "status", status_node);
+		default:
+			return EXIT_FAILURE;
+	}
+
+	get_all_sensor_values(dev, sensor, sensor_type, extra_fields, &values);
+
+	json_writer_key(jw, type_key);
+	json_writer_begin_object(jw);
+
+	/* All objects have value, status, and unit. */
+	json_writer_key(jw, "unit_mod");
+	json_writer_int(jw, values.mod);
+	json_writer_key(jw, "value");
+	json_writer_int(jw, values.value);
+	json_writer_key(jw, "status");
+	json_writer_int(jw, values.status);
 
 	/* Extra attributes. */
 	if (extra_fields & EXTRA_FIELDS_MAX) {
+		json_writer_key(jw, "max");
+
 		if (values.max_r == AMI_STATUS_OK)
-			max_node = json_mknumber(values.max);
+			json_writer_int(jw, values.max);
 		else
-			max_node = json_mknull();
-
-		json_append_member(row, "max", max_node);
+			json_writer_null(jw);
 	}
 
 	if (extra_fields & EXTRA_FIELDS_AVG) {
+		json_writer_key(jw, "average");
+
 		if (values.avg_r == AMI_STATUS_OK)
-			avg_node = json_mknumber(values.avg);
+			json_writer_int(jw, values.avg);
 		else
-			avg_node = json_mknull();
-
-		json_append_member(row, "average", avg_node);
+			json_writer_null(jw);
 	}
 
 	if (extra_fields & EXTRA_FIELDS_LIMITS) {
-		JsonNode *limit_w = NULL;
-		JsonNode *limit_c = NULL;
-		JsonNode *limit_f = NULL;
+		json_writer_key(jw, "limits");
+		json_writer_begin_object(jw);
 
 		/* Warning */
+		json_writer_key(jw, "warning");
 		if (values.limit_w_r == AMI_STATUS_OK)
-			limit_w = json_mknumber(values.limit_w);
+			json_writer_int(jw, values.limit_w);
 		else
-			limit_w = json_mknull();
+			json_writer_null(jw);
 
 		/* Critical */
+		json_writer_key(jw, "critical");
 		if (values.limit_c_r == AMI_STATUS_OK)
-			limit_c = json_mknumber(values.limit_c);
+			json_writer_int(jw, values.limit_c);
 		else
-			limit_c = json_mknull();
+			json_writer_null(jw);
 
 		/* Fatal */
+		json_writer_key(jw, "fatal");
 		if (values.limit_f_r == AMI_STATUS_OK)
-			limit_f = json_mknumber(values.limit_f);
+			json_writer_int(jw, values.limit_f);
 		else
-			limit_f = json_mknull();
+			json_writer_null(jw);
 
-		limits_node = json_mkobject();
-		json_append_member(limits_node, "warning", limit_w);
-		json_append_member(limits_node, "critical", limit_c);
-		json_append_member(limits_node, "fatal", limit_f);
-		json_append_member(row, "limits", limits_node);
+		json_writer_end_object(jw);
 	}
 
-	switch (sensor_type) {
-		case AMI_SENSOR_TYPE_TEMP:
-			json_append_member(parent, "temp", row);
-			break;
-
-		case AMI_SENSOR_TYPE_CURRENT:
-			json_append_member(parent, "current", row);
-			break;
-
-		case AMI_SENSOR_TYPE_VOLTAGE:
-			json_append_member(parent, "voltage", row);
-			break;
-
-		case AMI_SENSOR_TYPE_POWER:
-			json_append_member(parent, "power", row);
-			break;
-
-		default:
-			ret = EXIT_FAILURE;
-			break;
-	}
-
-	return ret;
+	json_writer_end_object(jw);
+	return EXIT_SUCCESS;
 }
 
 /**
  * construct_sensor_json() - Callback for the `populate_sensor_values` function.
  * @dev: Device handle.
- * @parent: Pre-allocated pointer to topmost JSON object.
+ * @jw: JSON writer, positioned inside the topmost JSON object.
  * @sensor: Populate data for this sensor.
  * @extra_fields: Extra fields bitflag.
  * @j: Current row (a row is a single sensor object like `"voltage": {...}`)
  *
- * This function creates a variable number of JSON nodes and appends them to
- * the parent in a predefined format, and for each object, it increments `j`.
+ * This function streams a variable number of JSON objects in a predefined
+ * format, grouped under the sensor name, and for each object, it
+ * increments `j`.
  *
  * Return: EXIT_SUCCESS or EXIT_FAILURE
  */
-static int construct_sensor_json(ami_device *dev, JsonNode *parent,
+static int construct_sensor_json(ami_device *dev, struct json_writer *jw,
 	const char *sensor, int extra_fields, int *j)
 {
 	int i = 0;
 	int ret = EXIT_SUCCESS;
-	JsonNode *current_group = NULL;
 	uint32_t sensor_type = 0;
 
-	if (!j || !parent || !dev || !sensor)
+	if (!j || !jw || !dev || !sensor)
 		return EXIT_FAILURE;
 
 	if (ami_sensor_get_type(dev, sensor, &sensor_type) != AMI_STATUS_OK)
 		return EXIT_FAILURE;
 
-	current_group = json_mkobject();
+	json_writer_key(jw, sensor);
+	json_writer_begin_object(jw);
 
 	for (i = 0; i < AMI_SENSOR_TYPE_MAX; i++) {
 		if ((1U << i) & sensor_type) {
 			if (mk_sensor_node(dev, sensor, (1U << i),
-					extra_fields, current_group) == EXIT_FAILURE) {
+					extra_fields, jw) == EXIT_FAILURE) {
 				ret = EXIT_FAILURE;
 				break;
 			}
@@ -700,7 +820,7 @@ static int construct_sensor_json(ami_device *dev, JsonNode *parent,
 		}
 	}
 
-	json_append_member(parent, sensor, current_group);
+	json_writer_end_object(jw);
 	return ret;
 }
 
@@ -741,9 +861,7 @@ static int count_connected_aux_cables(ami_device *dev, struct ami_sensor *sensor
 			enum ami_sensor_status status = AMI_SENSOR_STATUS_INVALID;
 
 			if (ami_sensor_get_voltage_value(dev, sensors->name, &voltage, &status) == AMI_STATUS_OK) {
-				double voltage_v = (double)voltage / 1000.0;
-
-				if (voltage_v > AUX_CABLE_CONNECTED_THRESHOLD_MV && ((status == AMI_SENSOR_STATUS_OK) ||
+				if (voltage > AUX_CABLE_CONNECTED_THRESHOLD_MV && ((status == AMI_SENSOR_STATUS_OK) ||
 										     (status == AMI_SENSOR_STATUS_OK_CACHED))) {
 					aux_count++;
 
@@ -786,7 +904,7 @@ static int count_connected_aux_cables(ami_device *dev, struct ami_sensor *sensor
  * @data: Pointer to `struct app_sensor_data`.
  *
  * Note that this function is used for any generic data structure
- * (JSON and tables, in this case).
+ * (a streaming JSON writer and tables, in this case).
  *
  * Return: EXIT_SUCCESS or EXIT_FAILURE.
  */
@@ -837,8 +955,10 @@ static int populate_sensor_values(ami_device *dev, void *values,
 					j++;
 				}
 			} else if (fmt == APP_OUT_FORMAT_JSON) {
-				JsonNode *parent = (JsonNode*)values;
-				json_append_member(parent, "aux_cable_count", json_mknumber(aux_count));
+				struct json_writer *jw = (struct json_writer*)values;
+
+				json_writer_key(jw, "aux_cable_count");
+				json_writer_int(jw, aux_count);
 			}
 		}
 
@@ -846,7 +966,7 @@ static int populate_sensor_values(ami_device *dev, void *values,
 			case APP_OUT_FORMAT_JSON:
 				ret = construct_sensor_json(
 					dev,
-					(JsonNode*)values,
+					(struct json_writer*)values,
 					current_sensor->name,
 					sensor_data->extra_fields,
 					&j
@@ -888,13 +1008,13 @@ static int populate_sensor_values(ami_device *dev, void *values,
  * @sensor: Print out data for this sensor only (NULL for all sensors).
  * @stream: Optional output stream (defaults to stdout).
  * @fmt: Output format.
- * @json_out: Optional variable to store generated JSON data instead of printing.
+ * @jw: Optional JSON writer to stream into instead of starting a new document.
  *
  * Return: EXIT_SUCCESS or EXIT_FAILURE.
  */
 static int print_sensor_data(ami_device *dev, int extra_fields,
 	const char *sensor, FILE *stream, enum app_out_format fmt,
-	JsonNode **json_out)
+	struct json_writer *jw)
 {
 	int i = 0;
 	int ret = EXIT_FAILURE;
@@ -981,8 +1101,8 @@ static int print_sensor_data(ami_device *dev, int extra_fields,
 	if (stream && (ret != EXIT_FAILURE) && (fmt != APP_OUT_FORMAT_TABLE)) {
 		switch (fmt) {
 			case APP_OUT_FORMAT_JSON:
-				if (!json_out)
-					ret = print_json_data(
+				if (!jw)
+					ret = print_json_stream(
 						dev,
 						n_fields,
 						n_rows,
@@ -991,13 +1111,34 @@ static int print_sensor_data(ami_device *dev, int extra_fields,
 						&data
 					);
 				else
-					ret = gen_json_data(
+					ret = populate_sensor_values(
+						dev,
+						jw,
+						&n_rows,
+						&n_fields,
+						APP_OUT_FORMAT_JSON,
+						&data
+					);
+				break;
+
+			case APP_OUT_FORMAT_CBOR:
+				if (!jw)
+					ret = print_cbor_stream(
 						dev,
 						n_fields,
 						n_rows,
+						stream,
 						&populate_sensor_values,
-						&data,
-						json_out
+						&data
+					);
+				else
+					ret = populate_sensor_values(
+						dev,
+						jw,
+						&n_rows,
+						&n_fields,
+						APP_OUT_FORMAT_JSON,
+						&data
 					);
 				break;
 
@@ -1009,6 +1150,426 @@ static int print_sensor_data(ami_device *dev, int extra_fields,
 	return ret;
 }
 
+/**
+ * watch_read_value() - Sample a single sensor value.
+ * @dev: Device handle.
+ * @row: Watched sensor.
+ * @value: Variable to hold the (unconverted) sensor value.
+ * @status: Variable to hold the sensor status.
+ *
+ * This is one driver request per call - unit modifiers, limits and uptime
+ * statistics are never re-read while watching.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
+ */
+static int watch_read_value(ami_device *dev, struct watch_row *row,
+	long *value, enum ami_sensor_status *status)
+{
+	switch (row->type) {
+		case AMI_SENSOR_TYPE_TEMP:
+			return ami_sensor_get_temp_value(dev, row->sensor, value, status);
+
+		case AMI_SENSOR_TYPE_VOLTAGE:
+			return ami_sensor_get_voltage_value(dev, row->sensor, value, status);
+
+		case AMI_SENSOR_TYPE_CURRENT:
+			return ami_sensor_get_current_value(dev, row->sensor, value, status);
+
+		case AMI_SENSOR_TYPE_POWER:
+			return ami_sensor_get_power_value(dev, row->sensor, value, status);
+
+		default:
+			return AMI_STATUS_ERROR;
+	}
+}
+
+/**
+ * watch_format_row() - Sample a sensor and format its table cells.
+ * @dev: Device handle.
+ * @row: Watched sensor.
+ * @cells: Row of table cells to fill in (the name column is not touched).
+ * @window: Number of samples in the statistics window (0 to disable).
+ *
+ * Return: None.
+ */
+static void watch_format_row(ami_device *dev, struct watch_row *row,
+	char **cells, int window)
+{
+	long raw = 0;
+	enum ami_sensor_status status = AMI_SENSOR_STATUS_INVALID;
+
+	if (watch_read_value(dev, row, &raw, &status) != AMI_STATUS_OK) {
+		snprintf(cells[WATCH_COL_VALUE], TABLE_FIELD_MAX, "%s", "N/A");
+		snprintf(cells[WATCH_COL_STATUS], TABLE_FIELD_MAX, "%s", "invalid");
+		status = AMI_SENSOR_STATUS_INVALID;
+	} else {
+		format_fixed(cells[WATCH_COL_VALUE], TABLE_FIELD_MAX,
+			fixed_to_milli(raw, 1, row->mod), row->unit);
+		snprintf(cells[WATCH_COL_STATUS], TABLE_FIELD_MAX, "%s", sensor_status_str(status));
+	}
+
+	if (window == 0)
+		return;
+
+	/* Only valid samples contribute to the window statistics. */
+	if ((status == AMI_SENSOR_STATUS_OK) || (status == AMI_SENSOR_STATUS_OK_CACHED)) {
+		row->samples[row->head] = raw;
+		row->head = (row->head + 1) % window;
+
+		if (row->n_samples < window)
+			row->n_samples++;
+	}
+
+	if (row->n_samples == 0) {
+		snprintf(cells[WATCH_COL_MIN], TABLE_FIELD_MAX, "%s", "N/A");
+		snprintf(cells[WATCH_COL_MAX], TABLE_FIELD_MAX, "%s", "N/A");
+		snprintf(cells[WATCH_COL_AVG], TABLE_FIELD_MAX, "%s", "N/A");
+	} else {
+		int i = 0;
+		long min = row->samples[0];
+		long max = row->samples[0];
+		long long sum = 0;
+
+		for (i = 0; i < row->n_samples; i++) {
+			if (row->samples[i] < min)
+				min = row->samples[i];
+
+			if (row->samples[i] > max)
+				max = row->samples[i];
+
+			sum += row->samples[i];
+		}
+
+		format_fixed(cells[WATCH_COL_MIN], TABLE_FIELD_MAX,
+			fixed_to_milli(min, 1, row->mod), row->unit);
+		format_fixed(cells[WATCH_COL_MAX], TABLE_FIELD_MAX,
+			fixed_to_milli(max, 1, row->mod), row->unit);
+		format_fixed(cells[WATCH_COL_AVG], TABLE_FIELD_MAX,
+			fixed_to_milli(sum, row->n_samples, row->mod), row->unit);
+	}
+}
+
+/**
+ * watch_sensor_data() - Continuously redraw a sensor table in place.
+ * @dev: Device handle (sensors must have been discovered).
+ * @sensor: Watch this sensor only (NULL for all sensors).
+ * @interval_ms: Sampling interval in milliseconds.
+ * @window: Number of samples in the min/max/average window (0 to disable).
+ *
+ * The table is printed once; afterwards every tick samples each sensor
+ * value and rewrites only the cells whose text changed, using ANSI cursor
+ * movement. Runs until interrupted with SIGINT or SIGTERM.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ */
+static int watch_sensor_data(ami_device *dev, const char *sensor,
+	uint32_t interval_ms, int window)
+{
+	int i = 0, j = 0;
+	int ret = EXIT_FAILURE;
+	int n_rows = 0;
+	int n_groups = 0;
+	int n_cols = (window > 0) ? (WATCH_NUM_COLS_WINDOW) : (WATCH_NUM_COLS);
+	struct ami_sensor single = { 0 };
+	struct ami_sensor *sensors = NULL;
+	struct ami_sensor *cur = NULL;
+	struct watch_row *rows = NULL;
+	char *header[WATCH_NUM_COLS_WINDOW] = { 0 };
+	char ***cells = NULL;
+	int col_align[WATCH_NUM_COLS_WINDOW] = { 0 };
+	int min_widths[WATCH_NUM_COLS_WINDOW] = { 0 };
+	struct table_layout layout = { 0 };
+	struct sigaction sa = { 0 };
+	struct sigaction old_int = { 0 };
+	struct sigaction old_term = { 0 };
+	struct timespec deadline = { 0 };
+
+	if (!dev || (interval_ms == 0))
+		return EXIT_FAILURE;
+
+	if (sensor) {
+		snprintf(single.name, AMI_SENSOR_MAX_STR, "%s", sensor);
+		sensors = &single;
+	} else if (ami_sensor_get_sensors(dev, &sensors, &n_groups) != AMI_STATUS_OK) {
+		APP_API_ERROR("could not get sensor list");
+		return EXIT_FAILURE;
+	}
+
+	/* One row per sensor type, like the regular table. */
+	for (cur = sensors; cur; cur = cur->next) {
+		uint32_t type = 0;
+
+		if (ami_sensor_get_type(dev, cur->name, &type) != AMI_STATUS_OK) {
+			APP_API_ERROR("could not get sensor type");
+			return EXIT_FAILURE;
+		}
+
+		for (i = 0; i < AMI_SENSOR_TYPE_MAX; i++)
+			if ((1U << i) & type)
+				n_rows++;
+	}
+
+	if (n_rows == 0)
+		return EXIT_FAILURE;
+
+	rows = (struct watch_row*)calloc(n_rows, sizeof(struct watch_row));
+	cells = (char***)calloc(n_rows, sizeof(char**));
+
+	if (!rows || !cells)
+		goto done;
+
+	for (i = 0; i < n_cols; i++) {
+		header[i] = (char*)calloc(TABLE_HEADING_MAX, sizeof(char));
+
+		if (!header[i])
+			goto done;
+	}
+
+	/* Build the static part of every row: name, unit and scale. */
+	j = 0;
+	for (cur = sensors; cur; cur = cur->next) {
+		uint32_t type = 0;
+		int group_row = 0;
+
+		ami_sensor_get_type(dev, cur->name, &type);
+
+		for (i = 0; (i < AMI_SENSOR_TYPE_MAX) && (j < n_rows); i++) {
+			struct watch_row *row = &rows[j];
+			enum ami_sensor_unit_mod mod = AMI_SENSOR_UNIT_MOD_NONE;
+			int c = 0;
+
+			if (!((1U << i) & type))
+				continue;
+
+			row->sensor = cur->name;
+			row->type = (1U << i);
+
+			switch (row->type) {
+				case AMI_SENSOR_TYPE_TEMP:
+					ami_sensor_get_temp_unit_mod(dev, cur->name, &mod);
+					break;
+
+				case AMI_SENSOR_TYPE_VOLTAGE:
+					ami_sensor_get_voltage_unit_mod(dev, cur->name, &mod);
+					break;
+
+				case AMI_SENSOR_TYPE_CURRENT:
+					ami_sensor_get_current_unit_mod(dev, cur->name, &mod);
+					break;
+
+				case AMI_SENSOR_TYPE_POWER:
+					ami_sensor_get_power_unit_mod(dev, cur->name, &mod);
+					break;
+
+				default:
+					break;
+			}
+
+			row->mod = mod;
+
+			if (make_unit_string(AMI_SENSOR_UNIT_MOD_NONE, row->type, row->unit) == EXIT_FAILURE)
+				memset(row->unit, 0x00, UNIT_STR_SIZE);
+
+			if (window > 0) {
+				row->samples = (long*)calloc(window, sizeof(long));
+
+				if (!row->samples)
+					goto done;
+			}
+
+			cells[j] = (char**)calloc(n_cols, sizeof(char*));
+
+			if (!cells[j])
+				goto done;
+
+			for (c = 0; c < n_cols; c++) {
+				cells[j][c] = (char*)calloc(TABLE_FIELD_MAX, sizeof(char));
+
+				if (!cells[j][c])
+					goto done;
+			}
+
+			if (group_row++ == 0)
+				snprintf(cells[j][WATCH_COL_NAME], TABLE_FIELD_MAX, "%s", cur->name);
+
+			j++;
+		}
+	}
+
+	sprintf(header[WATCH_COL_NAME], "%s", "Name");
+	sprintf(header[WATCH_COL_VALUE], "%s", "Value");
+	sprintf(header[WATCH_COL_STATUS], "%s", "Status");
+
+	if (window > 0) {
+		snprintf(header[WATCH_COL_MIN], TABLE_HEADING_MAX, "Min (%d)", window);
+		snprintf(header[WATCH_COL_MAX], TABLE_HEADING_MAX, "Max (%d)", window);
+		snprintf(header[WATCH_COL_AVG], TABLE_HEADING_MAX, "Average (%d)", window);
+	}
+
+	/* Leave room for values to grow without reflowing the table. */
+	for (i = 0; i < n_cols; i++) {
+		switch (i) {
+			case WATCH_COL_NAME:
+				col_align[i] = TABLE_ALIGN_LEFT;
+				min_widths[i] = 0;
+				break;
+
+			case WATCH_COL_STATUS:
+				col_align[i] = TABLE_ALIGN_LEFT;
+				min_widths[i] = WATCH_STATUS_WIDTH;
+				break;
+
+			default:
+				col_align[i] = TABLE_ALIGN_RIGHT;
+				min_widths[i] = WATCH_VALUE_WIDTH;
+				break;
+		}
+	}
+
+	/* First sample and full table. */
+	for (j = 0; j < n_rows; j++)
+		watch_format_row(dev, &rows[j], cells[j], window);
+
+	printf("\r\nSampling every %u ms, press Ctrl+C to stop.\r\n", interval_ms);
+
+	if (print_table_layout(header, cells, n_cols, n_rows, TABLE_DIVIDER_GROUPS,
+			NULL, col_align, min_widths, &layout) == EXIT_FAILURE)
+		goto done;
+
+	sa.sa_handler = &watch_handle_signal;
+	sigemptyset(&sa.sa_mask);
+	sigaction(SIGINT, &sa, &old_int);
+	sigaction(SIGTERM, &sa, &old_term);
+
+	/* Hide the cursor while redrawing. */
+	printf("\033[?25l");
+	fflush(stdout);
+
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+	while (!watch_stop) {
+		struct timespec now = { 0 };
+
+		deadline.tv_nsec += (long)(interval_ms % MS_PER_S) * NS_PER_MS;
+		deadline.tv_sec += interval_ms / MS_PER_S + deadline.tv_nsec / NS_PER_S;
+		deadline.tv_nsec %= NS_PER_S;
+
+		/* Don't try to catch up after a stall (e.g. terminal suspended). */
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		if ((now.tv_sec > deadline.tv_sec) ||
+				((now.tv_sec == deadline.tv_sec) && (now.tv_nsec > deadline.tv_nsec)))
+			deadline = now;
+
+		if ((clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) != 0) ||
+				watch_stop)
+			continue;
+
+		for (j = 0; j < n_rows; j++) {
+			char *prev[WATCH_NUM_COLS_WINDOW] = { 0 };
+			char fresh[WATCH_NUM_COLS_WINDOW][TABLE_FIELD_MAX] = { { 0 } };
+			char *fresh_p[WATCH_NUM_COLS_WINDOW] = { 0 };
+
+			for (i = 0; i < n_cols; i++) {
+				prev[i] = cells[j][i];
+				fresh_p[i] = fresh[i];
+			}
+
+			watch_format_row(dev, &rows[j], fresh_p, window);
+
+			/* Redraw only what changed. */
+			for (i = WATCH_COL_VALUE; i < n_cols; i++) {
+				if (strcmp(prev[i], fresh[i]) == 0)
+					continue;
+
+				print_table_cell(&layout, j, i, fresh[i], col_align);
+				snprintf(cells[j][i], TABLE_FIELD_MAX, "%s", fresh[i]);
+			}
+		}
+
+		fflush(stdout);
+	}
+
+	printf("\033[?25h");
+	fflush(stdout);
+
+	sigaction(SIGINT, &old_int, NULL);
+	sigaction(SIGTERM, &old_term, NULL);
+	watch_stop = 0;
+	ret = EXIT_SUCCESS;
+
+done:
+	free_table_layout(&layout);
+
+	for (i = 0; i < n_cols; i++)
+		free(header[i]);
+
+	if (rows) {
+		for (j = 0; j < n_rows; j++)
+			free(rows[j].samples);
+
+		free(rows);
+	}
+
+	if (cells) {
+		for (j = 0; j < n_rows; j++) {
+			if (!cells[j])
+				continue;
+
+			for (i = 0; i < n_cols; i++)
+				free(cells[j][i]);
+
+			free(cells[j]);
+		}
+
+		free(cells);
+	}
+
+	if (ret != EXIT_SUCCESS)
+		APP_ERROR("could not watch sensor data");
+
+	return ret;
+}
+
+/**
+ * parse_report_options() - Parse the options shared by all sensor reports.
+ * @options: List of command line options.
+ * @extra_fields: Variable to hold the requested extra fields.
+ * @sensor_filter: Variable to hold the requested sensor (NULL for all).
+ * @format: Variable to hold the output format.
+ * @stream: Variable to hold the output file stream.
+ * @fmt_given: Variable to hold whether a format was given.
+ * @output_given: Variable to hold whether an output file was given.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ */
+static int parse_report_options(struct app_option *options, int *extra_fields,
+	const char **sensor_filter, enum app_out_format *format, FILE **stream,
+	bool *fmt_given, bool *output_given)
+{
+	bool verbose = false;
+	struct app_option *opt = NULL;
+
+	if (parse_output_options(options, format, &verbose, stream,
+			fmt_given, output_given) == EXIT_FAILURE)
+		return EXIT_FAILURE;
+
+	/* Verbose option takes precedence over -x */
+	if (verbose) {
+		/* TODO: This will output more information in the future. */
+		*extra_fields |= EXTRA_FIELDS_ALL;
+	} else {
+		/* Check if user requested extra fields. */
+		parse_extra(options, extra_fields);
+	}
+
+	/* Check if user specified a sensor. */
+	if (NULL != (opt = find_app_option('n', options))) {
+		*sensor_filter = opt->arg;
+	}
+
+	return EXIT_SUCCESS;
+}
+
 /*****************************************************************************/
 /* Public function definitions                                               */
 /*****************************************************************************/
@@ -1021,7 +1582,6 @@ int report_sensors(struct app_option *options)
 	int ret = EXIT_FAILURE;
 	const char *sensor_filter = NULL;  /* default: all sensors */
 
-	bool verbose = false;
 	int extra_fields = EXTRA_FIELDS_NONE;  /* default: no extra fields */
 	enum app_out_format format = APP_OUT_FORMAT_TABLE;  /* default: table */
 	FILE *stream = NULL;
@@ -1031,32 +1591,18 @@ int report_sensors(struct app_option *options)
 
 	/* options may be NULL */
 
-	if (parse_output_options(options, &format, &verbose, &stream,
-			&fmt_given, &output_given) == EXIT_FAILURE)
+	if (parse_report_options(options, &extra_fields, &sensor_filter,
+			&format, &stream, &fmt_given, &output_given) == EXIT_FAILURE)
 		return EXIT_FAILURE;
 
-	/* Verbose option takes precedence over -x */
-	if (verbose) {
-		/* TODO: This will output more information in the future. */
-		extra_fields |= EXTRA_FIELDS_ALL;
-	} else {
-		/* Check if user requested extra fields. */
-		parse_extra(options, &extra_fields);
-	}
-
-	/* Check if user specified a sensor. */
-	if (NULL != (opt = find_app_option('n', options))) {
-		sensor_filter = opt->arg;
-	}
-
 	/* Check for -d | --device */
 	if (NULL != (opt = find_app_option('d', options))) {
 		ami_device *dev = NULL;
 
 		/* Search for device. */
-		if (ami_dev_find(opt->arg, &dev) == AMI_STATUS_OK) {
+		if (app_dev_find(opt->arg, &dev) == AMI_STATUS_OK) {
 			/* Find device sensors. */
-			if(AMI_STATUS_OK != ami_sensor_discover(dev)) {
+			if(AMI_STATUS_OK != app_sensor_discover(dev)) {
 				APP_API_ERROR("device has no sensor data");
 			} else {
 				/* Print sensor information. */
@@ -1077,17 +1623,21 @@ int report_sensors(struct app_option *options)
 	} else {
 		ami_device *dev = NULL;
 		ami_device *prev = NULL;
-		JsonNode *parent = NULL;
+		struct json_writer jw = { 0 };
+		struct json_writer *parent = NULL;
 
-		if (fmt_given && output_given && (format == APP_OUT_FORMAT_JSON))
-			parent = json_mkobject();
+		if (fmt_given && output_given && (format == APP_OUT_FORMAT_JSON) &&
+				(print_json_stream_begin(&jw, stream) == EXIT_SUCCESS))
+			parent = &jw;
+		else if (fmt_given && output_given && (format == APP_OUT_FORMAT_CBOR) &&
+				(print_cbor_stream_begin(&jw, stream) == EXIT_SUCCESS))
+			parent = &jw;
 
 		APP_WARN("enumerating all devices");
 
 		while (ami_dev_find_next(&dev, AMI_ANY_DEV, AMI_ANY_DEV, 0, prev) == AMI_STATUS_OK) {
 			uint16_t bdf = 0;
 			char bdf_str[AMI_BDF_STR_LEN] = { 0 };
-			JsonNode *child = NULL;
 
 			if (ami_dev_get_pci_bdf(dev, &bdf) == AMI_STATUS_OK) {
 				snprintf(
@@ -1106,7 +1656,7 @@ int report_sensors(struct app_option *options)
 				snprintf(bdf_str, AMI_BDF_STR_LEN, "%02x:%02x.%01x", 0, 0, 0);
 			}
 
-			ret = ami_sensor_discover(dev);
+			ret = app_sensor_discover(dev);
 
 			if (ret != AMI_STATUS_OK) {
 				APP_API_ERROR("device has no sensor data");
@@ -1114,39 +1664,41 @@ int report_sensors(struct app_option *options)
 				break;
 			}
 
+			if (parent != NULL) {
+				json_writer_key(parent, bdf_str);
+				json_writer_begin_object(parent);
+			}
+
 			ret = print_sensor_data(
 				dev,
 				extra_fields,
 				sensor_filter,
 				stream,
 				format,
-				(parent == NULL) ? (NULL) : (&child)
+				parent
 			);
 
+			if (parent != NULL)
+				json_writer_end_object(parent);
+
 			if (ret != EXIT_SUCCESS) {
 				APP_ERROR("could not print sensor data");
 				ami_dev_delete(&dev);
 				break;
 			}
 
-			if ((parent != NULL) && (child != NULL))
-				json_append_member(parent, bdf_str, child);
-
 			/* Move to next device. */
 			ami_dev_delete(&prev);
 			prev = dev;
 			dev = NULL;
 		}
 
-		if ((ret == EXIT_SUCCESS) && (parent != NULL))
-			print_json_obj(parent, stream);
-
 		/* Delete final device. */
 		ami_dev_delete(&prev);
 
-		/* Delete JSON */
-		if (parent != NULL)
-			json_delete(parent);
+		/* Terminate the JSON document, even if a device failed. */
+		if ((parent != NULL) && (print_json_stream_end(parent) != EXIT_SUCCESS))
+			ret = EXIT_FAILURE;
 	}
 
 	if (stream)
@@ -1154,3 +1706,114 @@ int report_sensors(struct app_option *options)
 
 	return ret;
 }
+
+/*
+ * Print sensor information for a single, already open, device.
+ */
+int report_device_sensors(ami_device *dev, struct app_option *options)
+{
+	int ret = EXIT_FAILURE;
+	const char *sensor_filter = NULL;  /* default: all sensors */
+	int extra_fields = EXTRA_FIELDS_NONE;  /* default: no extra fields */
+	enum app_out_format format = APP_OUT_FORMAT_TABLE;  /* default: table */
+	FILE *stream = NULL;
+	bool output_given = false, fmt_given = false;
+
+	if (!dev)
+		return EXIT_FAILURE;
+
+	if (parse_report_options(options, &extra_fields, &sensor_filter,
+			&format, &stream, &fmt_given, &output_given) == EXIT_FAILURE)
+		return EXIT_FAILURE;
+
+	if (app_sensor_discover(dev) != AMI_STATUS_OK) {
+		APP_API_ERROR("device has no sensor data");
+	} else {
+		ret = print_sensor_data(
+			dev,
+			extra_fields,
+			sensor_filter,
+			stream,
+			format,
+			NULL
+		);
+	}
+
+	if (stream)
+		fclose(stream);
+
+	return ret;
+}
+
+/*
+ * Primary callback for the "sensors --watch" mode.
+ */
+int watch_sensors(struct app_option *options)
+{
+	int ret = EXIT_FAILURE;
+	int window = 0;
+	unsigned long interval_ms = 0;
+	const char *sensor_filter = NULL;
+	struct app_option *opt = NULL;
+	ami_device *dev = NULL;
+	char *end = NULL;
+
+	if (!options)
+		return EXIT_FAILURE;
+
+	if (find_app_option('o', options) || find_app_option('f', options) ||
+			find_app_option('x', options) || find_app_option('v', options)) {
+		APP_ERROR("-o, -f, -x and -v cannot be used together with --watch");
+		return EXIT_FAILURE;
+	}
+
+	if (NULL == (opt = find_app_option('w', options)))
+		return EXIT_FAILURE;
+
+	interval_ms = strtoul(opt->arg, &end, 0);
+
+	if ((*end != '\0') || (interval_ms < WATCH_MIN_INTERVAL_MS) ||
+			(interval_ms > UINT32_MAX)) {
+		APP_ERROR("invalid watch interval");
+		return EXIT_FAILURE;
+	}
+
+	if (NULL != (opt = find_app_option('W', options))) {
+		unsigned long w = strtoul(opt->arg, &end, 0);
+
+		if ((*end != '\0') || (w == 0) || (w > WATCH_MAX_WINDOW)) {
+			APP_ERROR("invalid window size");
+			return EXIT_FAILURE;
+		}
+
+		window = (int)w;
+	}
+
+	if (NULL != (opt = find_app_option('n', options)))
+		sensor_filter = opt->arg;
+
+	if ((NULL == (opt = find_app_option('d', options))) ||
+			is_device_list(opt->arg)) {
+		APP_ERROR("a single device must be specified with -d when using --watch");
+		return EXIT_FAILURE;
+	}
+
+	/* Cells are redrawn with ANSI escapes, which only make sense on a tty. */
+	if (!isatty(STDOUT_FILENO)) {
+		APP_ERROR("--watch requires stdout to be a terminal");
+		return EXIT_FAILURE;
+	}
+
+	if (app_dev_find(opt->arg, &dev) != AMI_STATUS_OK) {
+		APP_API_ERROR("could not find the requested device");
+		return EXIT_FAILURE;
+	}
+
+	if (app_sensor_discover(dev) != AMI_STATUS_OK)
+		APP_API_ERROR("device has no sensor data");
+	else
+		ret = watch_sensor_data(dev, sensor_filter, (uint32_t)interval_ms, window);
+
+	ami_dev_delete(&dev);
+	return ret;
+}
@@ -66,4 +66,26 @@ struct app_sensor_data {
  */
 int report_sensors(struct app_option *options);
 
+/**
+ * report_device_sensors() - Print sensor information for a single device.
+ * @dev: Device handle.
+ * @options: List of command line options (`-d` is ignored).
+ *
+ * Used when the "sensors" command runs against several devices at once.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ */
+int report_device_sensors(ami_device *dev, struct app_option *options);
+
+/**
+ * watch_sensors() - Continuously display sensor information.
+ * @options: List of command line options (must include -w).
+ *
+ * Keeps the device open and redraws only the table cells which change
+ * between samples until interrupted.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ */
+int watch_sensors(struct app_option *options);
+
 #endif  /* AMI_APP_SENSORS_H */
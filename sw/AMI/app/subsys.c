@@ -0,0 +1,306 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * subsys.c - This file contains the lazy initialisation of the subsystems
+ *            used by ami_tool commands and the startup timing report
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+/* Standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+
+/* API includes */
+#include "ami.h"
+#include "ami_device.h"
+#include "ami_sensor.h"
+
+/* App includes */
+#include "amiapp.h"
+#include "subsys.h"
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+#define NS_PER_S		(1000000000ULL)
+#define NS_PER_MS		(1000000.0)
+
+/*****************************************************************************/
+/* Structs                                                                   */
+/*****************************************************************************/
+
+/**
+ * struct app_phase_time - Time accumulated by a single phase.
+ * @name: Phase name as printed in the report.
+ * @ns: Total time spent in the phase.
+ * @count: Number of times the phase was entered.
+ */
+struct app_phase_time {
+	const char *name;
+	uint64_t    ns;
+	uint32_t    count;
+};
+
+/*****************************************************************************/
+/* Global variables                                                          */
+/*****************************************************************************/
+
+static pthread_mutex_t subsys_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static bool driver_ready = false;
+static struct ami_version driver_ver = { 0 };
+
+static bool devices_ready = false;
+static uint16_t num_devices = 0;
+
+static bool profile_ready = false;
+static uint16_t profile = PROFILE_DEFAULT;
+
+static bool timing_enabled = false;
+static struct app_phase_time phases[APP_PHASE_MAX] = {
+	[APP_PHASE_PARSE]   = { "parse",   0, 0 },
+	[APP_PHASE_DRIVER]  = { "driver",  0, 0 },
+	[APP_PHASE_DEVICES] = { "devices", 0, 0 },
+	[APP_PHASE_PROFILE] = { "profile", 0, 0 },
+	[APP_PHASE_SENSORS] = { "sensors", 0, 0 },
+	[APP_PHASE_COMMAND] = { "command", 0, 0 },
+};
+
+/*****************************************************************************/
+/* Local function definitions                                                */
+/*****************************************************************************/
+
+/**
+ * now_ns() - Read the monotonic clock.
+ *
+ * Return: Current time in nanoseconds.
+ */
+static uint64_t now_ns(void)
+{
+	struct timespec ts = { 0 };
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * NS_PER_S) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * init_driver() - Query the driver version. Caller holds `subsys_lock`.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
+ */
+static int init_driver(void)
+{
+	uint64_t start = 0;
+
+	if (driver_ready)
+		return AMI_STATUS_OK;
+
+	start = app_timing_start();
+
+	if (ami_get_driver_version(&driver_ver) == AMI_STATUS_OK)
+		driver_ready = true;
+
+	app_timing_stop(APP_PHASE_DRIVER, start);
+	return (driver_ready) ? (AMI_STATUS_OK) : (AMI_STATUS_ERROR);
+}
+
+/**
+ * init_devices() - Read the device map. Caller holds `subsys_lock`.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
+ */
+static int init_devices(void)
+{
+	uint64_t start = 0;
+
+	if (devices_ready)
+		return AMI_STATUS_OK;
+
+	start = app_timing_start();
+
+	if (ami_dev_get_num_devices(&num_devices) == AMI_STATUS_OK)
+		devices_ready = true;
+
+	app_timing_stop(APP_PHASE_DEVICES, start);
+	return (devices_ready) ? (AMI_STATUS_OK) : (AMI_STATUS_ERROR);
+}
+
+/*****************************************************************************/
+/* Public function definitions                                               */
+/*****************************************************************************/
+
+/*
+ * Bring up the subsystems a command depends on.
+ */
+int app_subsys_require(uint32_t needs)
+{
+	int ret = EXIT_SUCCESS;
+
+	pthread_mutex_lock(&subsys_lock);
+
+	if ((needs & APP_NEEDS_DRIVER) && (init_driver() != AMI_STATUS_OK)) {
+		APP_API_ERROR("unable to retrieve driver version");
+		ret = EXIT_FAILURE;
+	} else if ((needs & (APP_NEEDS_DEVICES | APP_NEEDS_SENSORS)) &&
+			(init_devices() != AMI_STATUS_OK)) {
+		APP_API_ERROR("unable to read the device list, is the driver loaded?");
+		ret = EXIT_FAILURE;
+	}
+
+	pthread_mutex_unlock(&subsys_lock);
+	return ret;
+}
+
+/*
+ * Get the driver version.
+ */
+int app_driver_version(struct ami_version *ver)
+{
+	int ret = AMI_STATUS_ERROR;
+
+	if (!ver)
+		return AMI_STATUS_ERROR;
+
+	pthread_mutex_lock(&subsys_lock);
+
+	ret = init_driver();
+
+	if (ret == AMI_STATUS_OK)
+		*ver = driver_ver;
+
+	pthread_mutex_unlock(&subsys_lock);
+	return ret;
+}
+
+/*
+ * Get the profile of the installed devices.
+ */
+uint16_t app_profile(void)
+{
+	uint16_t ret = PROFILE_DEFAULT;
+	uint16_t pci_dev_id = 0;
+	uint64_t start = 0;
+	ami_device *dev = NULL;
+
+	pthread_mutex_lock(&subsys_lock);
+
+	if (profile_ready) {
+		ret = profile;
+		goto unlock;
+	}
+
+	/* Errors are only reported once; the default profile shows everything. */
+	profile_ready = true;
+	start = app_timing_start();
+
+	if (init_devices() != AMI_STATUS_OK) {
+		APP_API_ERROR("Error getting number of devices");
+		goto done;
+	}
+
+	/* Find device */
+	if (ami_dev_find_next(&dev, AMI_ANY_DEV, AMI_ANY_DEV, AMI_ANY_DEV, NULL) != AMI_STATUS_OK) {
+		APP_API_ERROR("could not find the requested device");
+		goto done;
+	}
+
+	if (ami_dev_get_pci_device(dev, &pci_dev_id) != AMI_STATUS_OK) {
+		APP_API_ERROR("could not get pci device id");
+		goto done;
+	}
+
+	/* use pci_dev_id to choose profile */
+	profile = (pci_dev_id == AMI_PCIE_DEVICE_ID_RAVE) ? PROFILE_RAVE : PROFILE_V80;
+
+done:
+	if (dev)
+		ami_dev_delete(&dev);
+
+	app_timing_stop(APP_PHASE_PROFILE, start);
+	ret = profile;
+
+unlock:
+	pthread_mutex_unlock(&subsys_lock);
+	return ret;
+}
+
+/*
+ * Discover the sensors of a device if not yet done.
+ */
+int app_sensor_discover(ami_device *dev)
+{
+	int ret = AMI_STATUS_ERROR;
+	int num = 0;
+	uint64_t start = 0;
+
+	if (!dev)
+		return AMI_STATUS_ERROR;
+
+	if ((ami_sensor_get_num_total(dev, &num) == AMI_STATUS_OK) && (num > 0))
+		return AMI_STATUS_OK;
+
+	start = app_timing_start();
+	ret = ami_sensor_discover(dev);
+	app_timing_stop(APP_PHASE_SENSORS, start);
+
+	return ret;
+}
+
+/*
+ * Turn on the collection of startup timings.
+ */
+void app_timing_enable(void)
+{
+	timing_enabled = true;
+}
+
+/*
+ * Start timing a phase.
+ */
+uint64_t app_timing_start(void)
+{
+	return (timing_enabled) ? (now_ns()) : (0);
+}
+
+/*
+ * Account the time spent in a phase.
+ */
+void app_timing_stop(enum app_phase phase, uint64_t start)
+{
+	uint64_t end = 0;
+
+	if (!timing_enabled || (phase >= APP_PHASE_MAX))
+		return;
+
+	end = now_ns();
+
+	/* Sensor discovery may run on several fanout threads at once. */
+	__atomic_add_fetch(&phases[phase].ns, end - start, __ATOMIC_RELAXED);
+	__atomic_add_fetch(&phases[phase].count, 1, __ATOMIC_RELAXED);
+}
+
+/*
+ * Print the collected startup timings.
+ */
+void app_timing_report(FILE *stream)
+{
+	int i = 0;
+
+	if (!timing_enabled || !stream)
+		return;
+
+	fprintf(stream, "\r\nTiming (ms)\r\n");
+
+	for (i = 0; i < APP_PHASE_MAX; i++) {
+		if (phases[i].count == 0)
+			fprintf(stream, "  %-8s %10s\r\n", phases[i].name, "-");
+		else
+			fprintf(stream, "  %-8s %10.3f  (x%u)\r\n", phases[i].name,
+				(double)phases[i].ns / NS_PER_MS, phases[i].count);
+	}
+}
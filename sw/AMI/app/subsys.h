@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * subsys.h - This file contains the lazy initialisation of the subsystems
+ *            used by ami_tool commands and the startup timing report
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+#ifndef AMI_APP_SUBSYS_H
+#define AMI_APP_SUBSYS_H
+
+/* Standard includes */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* API includes */
+#include "ami.h"
+#include "ami_device.h"
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+/* Values for the `needs` member of `struct app_cmd` */
+#define APP_NEEDS_NONE		(0)
+#define APP_NEEDS_DRIVER	(1 << APP_SUBSYS_DRIVER)
+#define APP_NEEDS_DEVICES	(1 << APP_SUBSYS_DEVICES)
+#define APP_NEEDS_SENSORS	(1 << APP_SUBSYS_SENSORS)
+
+/*****************************************************************************/
+/* Enums                                                                     */
+/*****************************************************************************/
+
+/**
+ * enum app_subsys - Subsystems a command may depend on.
+ * @APP_SUBSYS_DRIVER: Driver version (checks that the driver is loaded).
+ * @APP_SUBSYS_DEVICES: Device discovery.
+ * @APP_SUBSYS_SENSORS: Sensor discovery (done per device, on first use).
+ * @APP_SUBSYS_MAX: Number of subsystems.
+ */
+enum app_subsys {
+	APP_SUBSYS_DRIVER = 0,
+	APP_SUBSYS_DEVICES,
+	APP_SUBSYS_SENSORS,
+
+	APP_SUBSYS_MAX
+};
+
+/**
+ * enum app_phase - Startup phases reported by `--timing`.
+ * @APP_PHASE_PARSE: Command line parsing.
+ * @APP_PHASE_DRIVER: Driver version query.
+ * @APP_PHASE_DEVICES: Device discovery.
+ * @APP_PHASE_PROFILE: Device profile detection (help screen only).
+ * @APP_PHASE_SENSORS: Sensor discovery.
+ * @APP_PHASE_COMMAND: Command callback, including any lazy initialisation.
+ * @APP_PHASE_MAX: Number of phases.
+ */
+enum app_phase {
+	APP_PHASE_PARSE = 0,
+	APP_PHASE_DRIVER,
+	APP_PHASE_DEVICES,
+	APP_PHASE_PROFILE,
+	APP_PHASE_SENSORS,
+	APP_PHASE_COMMAND,
+
+	APP_PHASE_MAX
+};
+
+/*****************************************************************************/
+/* Public function declarations                                              */
+/*****************************************************************************/
+
+/**
+ * app_subsys_require() - Bring up the subsystems a command depends on.
+ * @needs: Bitmask of `APP_NEEDS_*` values.
+ *
+ * Each subsystem is initialised at most once per process, so commands run
+ * by "batch" only pay for it the first time. Subsystems which are not
+ * declared are never touched. Sensor discovery is per device and happens
+ * on first use in `app_sensor_discover`.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int app_subsys_require(uint32_t needs);
+
+/**
+ * app_driver_version() - Get the driver version.
+ * @ver: Variable to hold the version.
+ *
+ * The driver is queried on the first call only.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
+ */
+int app_driver_version(struct ami_version *ver);
+
+/**
+ * app_profile() - Get the profile of the installed devices.
+ *
+ * The first device found is used to choose between the V80 and RAVE
+ * profiles. The devices are scanned on the first call only.
+ *
+ * Return: PROFILE_V80, PROFILE_RAVE or PROFILE_DEFAULT
+ */
+uint16_t app_profile(void);
+
+/**
+ * app_sensor_discover() - Discover the sensors of a device if not yet done.
+ * @dev: Device handle.
+ *
+ * Handles cached by "batch" keep their sensors between commands, so
+ * discovery is skipped for a device which already has sensors.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
+ */
+int app_sensor_discover(ami_device *dev);
+
+/**
+ * app_timing_enable() - Turn on the collection of startup timings.
+ *
+ * Return: None.
+ */
+void app_timing_enable(void);
+
+/**
+ * app_timing_start() - Start timing a phase.
+ *
+ * Return: Opaque start time to pass to `app_timing_stop`.
+ */
+uint64_t app_timing_start(void);
+
+/**
+ * app_timing_stop() - Account the time spent in a phase.
+ * @phase: Phase being timed.
+ * @start: Value returned by `app_timing_start`.
+ *
+ * Phases may be entered several times (e.g., by "batch"); the time and the
+ * number of entries are accumulated. Does nothing unless timing is enabled.
+ *
+ * Return: None.
+ */
+void app_timing_stop(enum app_phase phase, uint64_t start);
+
+/**
+ * app_timing_report() - Print the collected startup timings.
+ * @stream: Output stream.
+ *
+ * Does nothing unless timing is enabled.
+ *
+ * Return: None.
+ */
+void app_timing_report(FILE *stream);
+
+#endif  /* AMI_APP_SUBSYS_H */
@@ -19,6 +19,38 @@
 
 #define COLUMN_PADDING (0)
 
+/*****************************************************************************/
+/* Local function definitions                                                */
+/*****************************************************************************/
+
+/**
+ * row_divider() - Check if a divider should be printed before a row.
+ * @divider_fmt: Row divider printing rule.
+ * @row: Row index.
+ * @values: Row values.
+ *
+ * Return: true if a divider should be printed.
+ */
+static bool row_divider(enum table_divider_format divider_fmt, int row,
+	char* values[])
+{
+	switch (divider_fmt) {
+		case TABLE_DIVIDER_HEADER_ONLY:
+			return (row == 0);
+
+		case TABLE_DIVIDER_ALL:
+			return true;
+
+		case TABLE_DIVIDER_GROUPS:
+			return ((row == 0) || (strlen(values[0]) != 0));
+
+		default:
+			break;
+	}
+
+	return false;
+}
+
 /*****************************************************************************/
 /* Public function declarations                                              */
 /*****************************************************************************/
@@ -87,12 +119,26 @@ int print_table_row(int num_cols, char* values[],
  */
 int print_table(char* header[], char** values[], int num_cols, int num_rows,
 	enum table_divider_format divider_fmt, FILE *stream, int *col_align)
+{
+	return print_table_layout(header, values, num_cols, num_rows,
+		divider_fmt, stream, col_align, NULL, NULL);
+}
+
+/*
+ * Print a table and optionally record its layout.
+ */
+int print_table_layout(char* header[], char** values[], int num_cols, int num_rows,
+	enum table_divider_format divider_fmt, FILE *stream, int *col_align,
+	const int *min_widths, struct table_layout *layout)
 {
 	int i = 0, j = 0;
 	int table_width = 0;
+	int num_lines = 0;
 	int *column_widths = NULL;
 	bool print_divider = false;
 
+	/* min_widths and layout are optional */
+
 	if (!header || !values)
 		return EXIT_FAILURE;
 
@@ -101,6 +147,20 @@ int print_table(char* header[], char** values[], int num_cols, int num_rows,
 	if (!column_widths)
 		return EXIT_FAILURE;
 
+	if (layout) {
+		layout->col_offsets = (int*)calloc(num_cols, sizeof(int));
+		layout->row_lines = (int*)calloc((num_rows > 0) ? (num_rows) : (1), sizeof(int));
+
+		if (!layout->col_offsets || !layout->row_lines) {
+			free(layout->col_offsets);
+			free(layout->row_lines);
+			layout->col_offsets = NULL;
+			layout->row_lines = NULL;
+			free(column_widths);
+			return EXIT_FAILURE;
+		}
+	}
+
 	/* Need to figure out max width of each column. */
 	for (i = 0; i < num_cols; i++) {
 		/* Start with the header size */
@@ -115,19 +175,26 @@ int print_table(char* header[], char** values[], int num_cols, int num_rows,
 				max_col = col_width;
 		}
 
+		if (min_widths && (min_widths[i] > max_col))
+			max_col = min_widths[i];
+
 		column_widths[i] = max_col;
 	}
 
 	/* Calculate total table width */
 	for (i = 0; i < num_cols; i++) {
-		table_width += column_widths[i] + COLUMN_PADDING;
-
 		/* Account for column separator */
 		if (i > 0)
 			table_width += 3;
+
+		if (layout)
+			layout->col_offsets[i] = table_width;
+
+		table_width += column_widths[i] + COLUMN_PADDING;
 	}
 
 	my_fprintf(stream, "\r\n");  /* whitespace padding */
+	num_lines++;
 
 	switch (divider_fmt) {
 		case TABLE_DIVIDER_HEADER_ONLY:
@@ -151,32 +218,11 @@ int print_table(char* header[], char** values[], int num_cols, int num_rows,
 		stream,
 		col_align
 	);
+	num_lines++;
 
 	/* Print rows */
 	for (j = 0; j < num_rows; j++) {
-		switch (divider_fmt) {
-			case TABLE_DIVIDER_HEADER_ONLY:
-				if (j == 0)
-					print_divider = true;
-				else
-					print_divider = false;
-				break;
-
-			case TABLE_DIVIDER_ALL:
-				print_divider = true;
-				break;
-
-			case TABLE_DIVIDER_GROUPS:
-				if ((j != 0) && (strlen(values[j][0]) == 0))
-					print_divider = false;
-				else
-					print_divider = true;
-				break;
-
-			default:
-				print_divider = false;
-				break;
-		}
+		print_divider = row_divider(divider_fmt, j, values[j]);
 
 		print_table_row(
 			num_cols,
@@ -188,11 +234,187 @@ int print_table(char* header[], char** values[], int num_cols, int num_rows,
 			stream,
 			col_align
 		);
+
+		if (print_divider)
+			num_lines++;
+
+		if (layout)
+			layout->row_lines[j] = num_lines;
+
+		num_lines++;
 	}
 
 	my_fprintf(stream, "\r\n");  /* whitespace padding */
+	num_lines++;
+
+	/* Hand the column widths over to the layout, or clean up. */
+	if (layout) {
+		layout->num_cols = num_cols;
+		layout->num_rows = num_rows;
+		layout->num_lines = num_lines;
+		layout->col_widths = column_widths;
+	} else {
+		free(column_widths);
+	}
 
-	/* Cleanup. */
-	free(column_widths);
 	return EXIT_SUCCESS;
 }
+
+/*
+ * Print the header of a table which is streamed row by row.
+ */
+int print_table_stream_begin(struct table_stream *ts, char* header[],
+	int num_cols, const int *col_widths, enum table_divider_format divider_fmt,
+	FILE *stream, int *col_align)
+{
+	int i = 0;
+
+	/* stream and col_align are optional */
+
+	if (!ts || !header || !col_widths || (num_cols <= 0))
+		return EXIT_FAILURE;
+
+	memset(ts, 0, sizeof(*ts));
+	ts->col_widths = (int*)calloc(num_cols, sizeof(int));
+
+	if (!ts->col_widths)
+		return EXIT_FAILURE;
+
+	/* Widths are fixed up front; they must fit the header too. */
+	for (i = 0; i < num_cols; i++) {
+		int len = strlen(header[i]);
+
+		ts->col_widths[i] = (col_widths[i] > len) ? (col_widths[i]) : (len);
+
+		if (i > 0)
+			ts->table_width += 3;
+
+		ts->table_width += ts->col_widths[i] + COLUMN_PADDING;
+	}
+
+	ts->num_cols = num_cols;
+	ts->divider_fmt = divider_fmt;
+	ts->stream = stream;
+	ts->col_align = col_align;
+
+	my_fprintf(stream, "\r\n");  /* whitespace padding */
+
+	return print_table_row(
+		num_cols,
+		header,
+		ts->col_widths,
+		COLUMN_PADDING,
+		ts->table_width,
+		false,
+		stream,
+		col_align
+	);
+}
+
+/*
+ * Print the next row of a streamed table.
+ */
+int print_table_stream_row(struct table_stream *ts, char* values[])
+{
+	int ret = EXIT_FAILURE;
+
+	if (!ts || !ts->col_widths || !values)
+		return EXIT_FAILURE;
+
+	ret = print_table_row(
+		ts->num_cols,
+		values,
+		ts->col_widths,
+		COLUMN_PADDING,
+		ts->table_width,
+		row_divider(ts->divider_fmt, ts->num_rows, values),
+		ts->stream,
+		ts->col_align
+	);
+
+	if (ret == EXIT_SUCCESS) {
+		ts->num_rows++;
+
+		if (ts->stream)
+			fflush(ts->stream);
+		else
+			fflush(stdout);
+	}
+
+	return ret;
+}
+
+/*
+ * Finish a streamed table.
+ */
+void print_table_stream_end(struct table_stream *ts)
+{
+	if (!ts || !ts->col_widths)
+		return;
+
+	my_fprintf(ts->stream, "\r\n");  /* whitespace padding */
+
+	free(ts->col_widths);
+	ts->col_widths = NULL;
+}
+
+/*
+ * Redraw a single table cell in place.
+ */
+int print_table_cell(struct table_layout *layout, int row, int col,
+	const char *value, int *col_align)
+{
+	int up = 0;
+	int width = 0;
+
+	/* col_align is optional */
+
+	if (!layout || !value || !layout->col_widths || (row < 0) ||
+			(row >= layout->num_rows) || (col < 0) || (col >= layout->num_cols))
+		return EXIT_FAILURE;
+
+	up = layout->num_lines - layout->row_lines[row];
+	width = layout->col_widths[col] + COLUMN_PADDING;
+
+	/* Move up to the row, across to the cell, draw it and move back down. */
+	if (col_align && (col_align[col] == TABLE_ALIGN_RIGHT))
+		my_fprintf(
+			NULL,
+			"\033[%dA\033[%dG%*.*s\033[%dB\r",
+			up,
+			layout->col_offsets[col] + 1,
+			width,
+			width,
+			value,
+			up
+		);
+	else
+		my_fprintf(
+			NULL,
+			"\033[%dA\033[%dG%-*.*s\033[%dB\r",
+			up,
+			layout->col_offsets[col] + 1,
+			width,
+			width,
+			value,
+			up
+		);
+
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Free a table layout.
+ */
+void free_table_layout(struct table_layout *layout)
+{
+	if (!layout)
+		return;
+
+	free(layout->col_widths);
+	free(layout->col_offsets);
+	free(layout->row_lines);
+	layout->col_widths = NULL;
+	layout->col_offsets = NULL;
+	layout->row_lines = NULL;
+}
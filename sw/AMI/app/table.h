@@ -40,6 +40,56 @@ enum table_align {
 	TABLE_ALIGN_LEFT,
 };
 
+/*****************************************************************************/
+/* Structs                                                                   */
+/*****************************************************************************/
+
+/**
+ * struct table_layout - Screen position of every cell of a printed table.
+ * @num_cols: Number of columns.
+ * @num_rows: Number of rows (excluding the header).
+ * @num_lines: Total number of lines printed for the table.
+ * @col_widths: Width of each column.
+ * @col_offsets: Zero based screen column at which each column starts.
+ * @row_lines: Zero based line (relative to the start of the table) on
+ *     which each row was printed.
+ *
+ * Filled in by `print_table_layout` and consumed by `print_table_cell` to
+ * redraw individual cells in place. Release with `free_table_layout`.
+ */
+struct table_layout {
+	int num_cols;
+	int num_rows;
+	int num_lines;
+	int *col_widths;
+	int *col_offsets;
+	int *row_lines;
+};
+
+/**
+ * struct table_stream - A table printed one row at a time.
+ * @num_cols: Number of columns.
+ * @num_rows: Number of rows printed so far (excluding the header).
+ * @table_width: Total table width.
+ * @col_widths: Width of each column, fixed when the header is printed.
+ * @divider_fmt: Row divider printing rule.
+ * @stream: Output stream (defaults to stdout).
+ * @col_align: Optional alignment of columns.
+ *
+ * Unlike `print_table`, column widths can't depend on values which have
+ * not been printed yet, so they are given up front. Values wider than
+ * their column break the alignment and should be truncated by the caller.
+ */
+struct table_stream {
+	int num_cols;
+	int num_rows;
+	int table_width;
+	int *col_widths;
+	enum table_divider_format divider_fmt;
+	FILE *stream;
+	int *col_align;
+};
+
 /*****************************************************************************/
 /* Public function declarations                                              */
 /*****************************************************************************/
@@ -76,4 +126,89 @@ int print_table_row(int num_cols, char* values[],
 int print_table(char* header[], char** values[], int num_cols, int num_rows,
 	enum table_divider_format divider_fmt, FILE *stream, int *col_align);
 
+/**
+ * print_table_layout() - Print a table and record where each cell was drawn.
+ * @header: List of table headings.
+ * @values: Table rows.
+ * @num_cols: Number of columns in each row.
+ * @num_rows: Number of rows in the table.
+ * @divider_fmt: Row divider printing rule.
+ * @stream: Output stream
+ * @col_align: Optional alignment of columns (defaults to left).
+ * @min_widths: Optional minimum width of each column.
+ * @layout: Optional variable to store the table layout.
+ *
+ * Same as `print_table`, but columns can be widened up front so that
+ * values which change later still fit, and the resulting layout can be
+ * used to redraw individual cells with `print_table_cell`.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ */
+int print_table_layout(char* header[], char** values[], int num_cols, int num_rows,
+	enum table_divider_format divider_fmt, FILE *stream, int *col_align,
+	const int *min_widths, struct table_layout *layout);
+
+/**
+ * print_table_stream_begin() - Start a table which is printed row by row.
+ * @ts: Streamed table state.
+ * @header: List of table headings.
+ * @num_cols: Number of columns in each row.
+ * @col_widths: Width of each column (widened to fit the header).
+ * @divider_fmt: Row divider printing rule.
+ * @stream: Output stream
+ * @col_align: Optional alignment of columns (defaults to left).
+ *
+ * Prints the header. Rows are added with `print_table_stream_row` and
+ * the table must be finished with `print_table_stream_end`.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ */
+int print_table_stream_begin(struct table_stream *ts, char* header[],
+	int num_cols, const int *col_widths, enum table_divider_format divider_fmt,
+	FILE *stream, int *col_align);
+
+/**
+ * print_table_stream_row() - Print the next row of a streamed table.
+ * @ts: Streamed table state.
+ * @values: Row values.
+ *
+ * The row is flushed to the output stream straight away.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ */
+int print_table_stream_row(struct table_stream *ts, char* values[]);
+
+/**
+ * print_table_stream_end() - Finish a streamed table and release its memory.
+ * @ts: Streamed table state.
+ *
+ * Return: None.
+ */
+void print_table_stream_end(struct table_stream *ts);
+
+/**
+ * print_table_cell() - Redraw a single cell of a table on the terminal.
+ * @layout: Layout returned by `print_table_layout`.
+ * @row: Row index.
+ * @col: Column index.
+ * @value: New cell contents (truncated to the column width).
+ * @col_align: Optional alignment of columns (defaults to left).
+ *
+ * The cursor must be on the line directly below the table, where
+ * `print_table_layout` left it; it is returned there afterwards. Only
+ * stdout is updated.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ */
+int print_table_cell(struct table_layout *layout, int row, int col,
+	const char *value, int *col_align);
+
+/**
+ * free_table_layout() - Release memory held by a table layout.
+ * @layout: Layout to free.
+ *
+ * Return: None.
+ */
+void free_table_layout(struct table_layout *layout);
+
 #endif /* AMI_APP_TABLE_H */
@@ -0,0 +1,421 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * test_json_writer.c - Unit test file for json_writer.c
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+/* Standard includes */
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+/* External includes */
+#include "cmocka.h"
+
+/* App includes */
+#include "json_writer.h"
+
+/*****************************************************************************/
+/* Structs                                                                   */
+/*****************************************************************************/
+
+/**
+ * struct cbor_item - A single decoded CBOR token.
+ * @major: Major type (or the initial byte for major type 7).
+ * @indef: Container of indefinite length.
+ * @arg: Argument (integer value, string length, tag number).
+ * @f: Float value.
+ * @str: Start of a text string (not terminated).
+ */
+struct cbor_item {
+	int major;
+	bool indef;
+	uint64_t arg;
+	double f;
+	const char *str;
+};
+
+/**
+ * struct cbor_reader - Minimal CBOR decoder state.
+ * @buf: Encoded document.
+ * @len: Length of `buf`.
+ * @pos: Offset of the next token.
+ */
+struct cbor_reader {
+	const uint8_t *buf;
+	size_t len;
+	size_t pos;
+};
+
+/*****************************************************************************/
+/* Local functions                                                           */
+/*****************************************************************************/
+
+/*
+ * Decode the next token; returns false on truncated input.
+ */
+static bool cbor_next(struct cbor_reader *r, struct cbor_item *item)
+{
+	uint8_t ib = 0;
+	int info = 0;
+	int n = 0;
+	int i = 0;
+
+	if (r->pos >= r->len)
+		return false;
+
+	memset(item, 0, sizeof(*item));
+	ib = r->buf[r->pos++];
+	item->major = ib >> 5;
+	info = ib & 0x1F;
+
+	if (item->major == 7) {
+		item->major = ib;
+
+		if (ib == CBOR_FLOAT32) {
+			uint32_t bits = 0;
+			float single = 0;
+
+			if (r->pos + 4 > r->len)
+				return false;
+
+			for (i = 0; i < 4; i++)
+				bits = (bits << 8) | r->buf[r->pos++];
+
+			memcpy(&single, &bits, sizeof(single));
+			item->f = single;
+		} else if (ib == CBOR_FLOAT64) {
+			uint64_t bits = 0;
+
+			if (r->pos + 8 > r->len)
+				return false;
+
+			for (i = 0; i < 8; i++)
+				bits = (bits << 8) | r->buf[r->pos++];
+
+			memcpy(&item->f, &bits, sizeof(item->f));
+		}
+		return true;
+	}
+
+	if (info < 24) {
+		item->arg = info;
+	} else if (info == 31) {
+		item->indef = true;
+	} else {
+		n = 1 << (info - 24);
+
+		if (r->pos + n > r->len)
+			return false;
+
+		for (i = 0; i < n; i++)
+			item->arg = (item->arg << 8) | r->buf[r->pos++];
+	}
+
+	if (item->major == CBOR_MAJOR_TEXT) {
+		if (r->pos + item->arg > r->len)
+			return false;
+
+		item->str = (const char*)&r->buf[r->pos];
+		r->pos += item->arg;
+	}
+
+	return true;
+}
+
+/*
+ * Check that the next token is the given text string.
+ */
+static void expect_text(struct cbor_reader *r, const char *str)
+{
+	struct cbor_item item = { 0 };
+
+	assert_true(cbor_next(r, &item));
+	assert_int_equal(item.major, CBOR_MAJOR_TEXT);
+	assert_int_equal(item.arg, strlen(str));
+	assert_memory_equal(item.str, str, strlen(str));
+}
+
+/*
+ * Check that the next token is a single byte with the given value.
+ */
+static void expect_simple(struct cbor_reader *r, int ib)
+{
+	struct cbor_item item = { 0 };
+
+	assert_true(cbor_next(r, &item));
+	assert_int_equal(item.major, ib);
+}
+
+/*
+ * Check that the next token is the given integer.
+ */
+static void expect_int(struct cbor_reader *r, int64_t num)
+{
+	struct cbor_item item = { 0 };
+
+	assert_true(cbor_next(r, &item));
+
+	if (num < 0) {
+		assert_int_equal(item.major, CBOR_MAJOR_NINT);
+		assert_int_equal(item.arg, (uint64_t)(-1 - num));
+	} else {
+		assert_int_equal(item.major, CBOR_MAJOR_UINT);
+		assert_int_equal(item.arg, (uint64_t)num);
+	}
+}
+
+/*
+ * Check that the next token is a float of the given width and value.
+ */
+static void expect_float(struct cbor_reader *r, int ib, double num)
+{
+	struct cbor_item item = { 0 };
+
+	assert_true(cbor_next(r, &item));
+	assert_int_equal(item.major, ib);
+	assert_true(item.f == num);
+}
+
+/*****************************************************************************/
+/* Tests                                                                     */
+/*****************************************************************************/
+
+void test_happy_json_writer_cbor(void **state)
+{
+	struct json_writer jw = { 0 };
+	struct cbor_reader r = { 0 };
+	struct cbor_item item = { 0 };
+	char *buf = NULL;
+	size_t len = 0;
+	FILE *stream = open_memstream(&buf, &len);
+
+	assert_non_null(stream);
+	assert_int_equal(json_writer_init_cbor(&jw, stream), EXIT_SUCCESS);
+
+	json_writer_begin_object(&jw);
+	json_writer_key(&jw, "small");
+	json_writer_int(&jw, 23);
+	json_writer_key(&jw, "u16");
+	json_writer_int(&jw, 300);
+	json_writer_key(&jw, "u64");
+	json_writer_int(&jw, 0x100000000LL);
+	json_writer_key(&jw, "neg");
+	json_writer_int(&jw, -500);
+	json_writer_key(&jw, "f32");
+	json_writer_number(&jw, 1.5);
+	json_writer_key(&jw, "f64");
+	json_writer_number(&jw, 0.1);
+	json_writer_key(&jw, "str");
+	json_writer_string(&jw, "abc");
+	json_writer_key(&jw, "list");
+	json_writer_begin_array(&jw);
+	json_writer_bool(&jw, true);
+	json_writer_bool(&jw, false);
+	json_writer_null(&jw);
+	json_writer_string(&jw, NULL);
+	json_writer_end_array(&jw);
+	json_writer_end_object(&jw);
+
+	assert_int_equal(json_writer_finish(&jw), EXIT_SUCCESS);
+	fclose(stream);
+
+	r.buf = (const uint8_t*)buf;
+	r.len = len;
+
+	assert_true(cbor_next(&r, &item));
+	assert_int_equal(item.major, CBOR_MAJOR_MAP);
+	assert_true(item.indef);
+
+	expect_text(&r, "small");
+	expect_int(&r, 23);
+	expect_text(&r, "u16");
+	expect_int(&r, 300);
+	expect_text(&r, "u64");
+	expect_int(&r, 0x100000000LL);
+	expect_text(&r, "neg");
+	expect_int(&r, -500);
+	expect_text(&r, "f32");
+	expect_float(&r, CBOR_FLOAT32, 1.5);
+	expect_text(&r, "f64");
+	expect_float(&r, CBOR_FLOAT64, 0.1);
+	expect_text(&r, "str");
+	expect_text(&r, "abc");
+	expect_text(&r, "list");
+
+	assert_true(cbor_next(&r, &item));
+	assert_int_equal(item.major, CBOR_MAJOR_ARRAY);
+	assert_true(item.indef);
+
+	expect_simple(&r, CBOR_TRUE);
+	expect_simple(&r, CBOR_FALSE);
+	expect_simple(&r, CBOR_NULL);
+	expect_simple(&r, CBOR_NULL);
+	expect_simple(&r, CBOR_BREAK);
+	expect_simple(&r, CBOR_BREAK);
+
+	/* Nothing trails the document. */
+	assert_int_equal(r.pos, r.len);
+
+	free(buf);
+}
+
+void test_happy_json_writer_raw_cbor(void **state)
+{
+	static const uint8_t nested[] = {
+		0xD9, 0xD9, 0xF7,		/* self-described CBOR */
+		CBOR_MAP_INDEF, 0x61, 'x', 0x01, CBOR_BREAK
+	};
+	struct json_writer jw = { 0 };
+	struct cbor_reader r = { 0 };
+	struct cbor_item item = { 0 };
+	char *buf = NULL;
+	size_t len = 0;
+	FILE *stream = open_memstream(&buf, &len);
+
+	assert_non_null(stream);
+	assert_int_equal(json_writer_init_cbor(&jw, stream), EXIT_SUCCESS);
+
+	json_writer_begin_object(&jw);
+	json_writer_key(&jw, "dev");
+	json_writer_raw(&jw, (const char*)nested, sizeof(nested));
+	json_writer_key(&jw, "empty");
+	json_writer_raw(&jw, NULL, 0);
+
+	assert_int_equal(json_writer_finish(&jw), EXIT_SUCCESS);
+	fclose(stream);
+
+	r.buf = (const uint8_t*)buf;
+	r.len = len;
+
+	assert_true(cbor_next(&r, &item));
+	assert_int_equal(item.major, CBOR_MAJOR_MAP);
+	expect_text(&r, "dev");
+
+	/* The tag of the nested document is dropped. */
+	assert_true(cbor_next(&r, &item));
+	assert_int_equal(item.major, CBOR_MAJOR_MAP);
+	expect_text(&r, "x");
+	expect_int(&r, 1);
+	expect_simple(&r, CBOR_BREAK);
+
+	expect_text(&r, "empty");
+	expect_simple(&r, CBOR_NULL);
+	expect_simple(&r, CBOR_BREAK);
+	assert_int_equal(r.pos, r.len);
+
+	free(buf);
+}
+
+void test_happy_json_writer_int(void **state)
+{
+	struct json_writer jw = { 0 };
+	char *buf = NULL;
+	size_t len = 0;
+	FILE *stream = open_memstream(&buf, &len);
+
+	assert_non_null(stream);
+	assert_int_equal(json_writer_init(&jw, stream), EXIT_SUCCESS);
+
+	/* Integers look the same as they did through `json_writer_number`. */
+	json_writer_begin_object(&jw);
+	json_writer_key(&jw, "a");
+	json_writer_int(&jw, -7);
+	json_writer_key(&jw, "b");
+	json_writer_number(&jw, 4096);
+	json_writer_end_object(&jw);
+
+	assert_int_equal(json_writer_finish(&jw), EXIT_SUCCESS);
+	fclose(stream);
+
+	assert_string_equal(buf, "{\n\t\"a\": -7,\n\t\"b\": 4096\n}");
+	free(buf);
+}
+
+void test_happy_json_writer_compact(void **state)
+{
+	struct json_writer jw = { 0 };
+	char *buf = NULL;
+	size_t len = 0;
+	FILE *stream = open_memstream(&buf, &len);
+
+	assert_non_null(stream);
+	assert_int_equal(json_writer_init_compact(&jw, stream), EXIT_SUCCESS);
+
+	json_writer_begin_object(&jw);
+	json_writer_key(&jw, "line");
+	json_writer_int(&jw, 3);
+	json_writer_key(&jw, "out");
+	json_writer_string(&jw, "a\r\nb");
+	json_writer_key(&jw, "list");
+	json_writer_begin_array(&jw);
+	json_writer_bool(&jw, true);
+	json_writer_null(&jw);
+	json_writer_end_array(&jw);
+	json_writer_key(&jw, "empty");
+	json_writer_begin_object(&jw);
+	json_writer_end_object(&jw);
+	json_writer_end_object(&jw);
+
+	assert_int_equal(json_writer_finish(&jw), EXIT_SUCCESS);
+	fclose(stream);
+
+	assert_string_equal(buf,
+		"{\"line\":3,\"out\":\"a\\r\\nb\",\"list\":[true,null],\"empty\":{}}");
+	free(buf);
+}
+
+void test_fail_json_writer_cbor(void **state)
+{
+	struct json_writer jw = { 0 };
+	struct cbor_reader r = { 0 };
+	struct cbor_item item = { 0 };
+	char *buf = NULL;
+	size_t len = 0;
+	FILE *stream = NULL;
+
+	/* Invalid arguments */
+	assert_int_equal(json_writer_init_cbor(NULL, stdout), EXIT_FAILURE);
+	assert_int_equal(json_writer_init_cbor(&jw, NULL), EXIT_FAILURE);
+
+	/* A dangling key is completed with null and reported. */
+	stream = open_memstream(&buf, &len);
+	assert_non_null(stream);
+	assert_int_equal(json_writer_init_cbor(&jw, stream), EXIT_SUCCESS);
+
+	json_writer_begin_object(&jw);
+	json_writer_key(&jw, "k");
+
+	assert_int_equal(json_writer_finish(&jw), EXIT_FAILURE);
+	fclose(stream);
+
+	r.buf = (const uint8_t*)buf;
+	r.len = len;
+
+	assert_true(cbor_next(&r, &item));
+	assert_int_equal(item.major, CBOR_MAJOR_MAP);
+	expect_text(&r, "k");
+	expect_simple(&r, CBOR_NULL);
+	expect_simple(&r, CBOR_BREAK);
+
+	free(buf);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_happy_json_writer_cbor),
+		cmocka_unit_test(test_happy_json_writer_raw_cbor),
+		cmocka_unit_test(test_happy_json_writer_int),
+		cmocka_unit_test(test_happy_json_writer_compact),
+		cmocka_unit_test(test_fail_json_writer_cbor),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
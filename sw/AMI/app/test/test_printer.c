@@ -54,21 +54,6 @@ static int populate_header(ami_device *dev, char **header,
 /* Redefinitions/Wrapping                                                    */
 /*****************************************************************************/
 
-char *__wrap_json_stringify(const JsonNode *node, const char *space)
-{
-	return (char*)mock();
-}
-
-void __wrap_json_delete(JsonNode *node)
-{
-	function_called();
-}
-
-JsonNode *__wrap_json_mkobject(void)
-{
-	return (JsonNode*)mock();
-}
-
 int __wrap_print_table(char* header[], char** values[], int num_cols, int num_rows,
 	enum table_divider_format divider_fmt, FILE *stream, int *col_align)
 {
@@ -193,8 +178,8 @@ void test_happy_print_hexdump(void **state)
 	 * <addr> 9                (1)
 	 * <newline>               (1)
 	 */
-	expect_function_calls(__wrap_printf, (3 * 4) + 2);
-	print_hexdump(0, values, 9, 2);
+	expect_function_calls(__wrap_vfprintf, (3 * 4) + 2);
+	print_hexdump(0, values, 9, 2, sizeof(uint32_t));
 }
 
 void test_fail_print_hexdump(void **state)
@@ -203,13 +188,50 @@ void test_fail_print_hexdump(void **state)
 	uint32_t values[] = { 0 };
 
 	/* Failure path - invalid `values` argument */
-	print_hexdump(0, NULL, 1, 1);
+	print_hexdump(0, NULL, 1, 1, sizeof(uint32_t));
 
 	/* Failure path - num_values == 0 */
-	print_hexdump(0, values, 0, 1);
+	print_hexdump(0, values, 0, 1, sizeof(uint32_t));
 
 	/* Failure path - num_groups == 0 */
-	print_hexdump(0, values, 1, 0);
+	print_hexdump(0, values, 1, 0, sizeof(uint32_t));
+}
+
+void test_happy_print_capture(void **state)
+{
+	struct print_capture cap = { 0 };
+	FILE *f = NULL;
+
+	assert_int_equal(print_capture_begin(&cap), EXIT_SUCCESS);
+
+	/* Happy path - the output file is redirected into the capture */
+	f = open_output_file("unused");
+	assert_non_null(f);
+
+	/* Happy path - print to the captured stdout and output file */
+	expect_function_calls(__wrap_vfprintf, 2);
+	my_fprintf(f, "%s", "a");
+
+	fclose(f);
+	print_capture_end(&cap);
+	print_capture_free(&cap);
+	assert_null(cap.out);
+	assert_null(cap.file);
+}
+
+void test_fail_print_capture(void **state)
+{
+	struct print_capture cap = { 0 };
+
+	/* Failure path - invalid `cap` argument */
+	assert_int_equal(print_capture_begin(NULL), EXIT_FAILURE);
+
+	/* Failure path - only a single output file per capture */
+	assert_int_equal(print_capture_begin(&cap), EXIT_SUCCESS);
+	fclose(open_output_file("unused"));
+	assert_null(open_output_file("unused"));
+	print_capture_end(&cap);
+	print_capture_free(&cap);
 }
 
 void test_happy_print_table_data(void **state)
@@ -369,129 +391,65 @@ void test_fail_print_table_data(void **state)
 	);
 }
 
-void test_happy_gen_json_data(void **state)
+void test_happy_print_json_stream(void **state)
 {
-	JsonNode node = { 0 };
-	JsonNode *out = NULL;
+	char *buf = NULL;
+	size_t len = 0;
+	FILE *stream = open_memstream(&buf, &len);
 
-	/* Happy path - correct pointer returned */
-	will_return(__wrap_json_mkobject, &node);
-	will_return(populate_values, EXIT_SUCCESS);
-	assert_int_equal(
-		gen_json_data(
-			NULL, 0, 0, populate_values, NULL, &out
-		),
-		EXIT_SUCCESS
-	);
-	assert_ptr_equal(out, &node);
-}
+	assert_non_null(stream);
 
-void test_fail_gen_json_data(void **state)
-{
-	/* Failure path - invalid `out` argument */
-	will_return(__wrap_json_mkobject, NULL);
+	/* Happy path - document is opened and closed around the values */
+	will_return(populate_values, EXIT_SUCCESS);
 	assert_int_equal(
-		gen_json_data(
-			NULL, 0, 0, populate_values, NULL, NULL
+		print_json_stream(
+			NULL, 0, 0, stream, populate_values, NULL
 		),
-		EXIT_FAILURE
-	);
-}
-
-void test_happy_print_json_obj(void **state)
-{
-	JsonNode node = { 0 };
-	char *json = calloc(3, sizeof(char));
-	strcpy(json, "a");
-	assert_non_null(json);
-
-	/* Happy path - return code OK and expected functions called */
-	will_return(__wrap_json_stringify, json);
-	expect_function_call(__wrap_fprintf);
-	assert_int_equal(
-		print_json_obj(&node, stdout),
 		EXIT_SUCCESS
 	);
-}
 
-void test_fail_print_json_obj(void **state)
-{
-	JsonNode node = { 0 };
-
-	/* Failure path - invalid `obj` argument */
-	assert_int_equal(
-		print_json_obj(NULL, stdout),
-		EXIT_FAILURE
-	);
-
-	/* Failure path - invalid `stream` argument */
-	assert_int_equal(
-		print_json_obj(&node, NULL),
-		EXIT_FAILURE
-	);
+	fclose(stream);
+	assert_string_equal(buf, "\r\n{}\r\n");
+	free(buf);
 }
 
-void test_happy_print_json_data(void **state)
+void test_fail_print_json_stream(void **state)
 {
-	/* Need to execute happy path for both `gen_json_data` and `print_json_obj`. */
-	JsonNode node1 = { 0 };
-	JsonNode node2 = { 0 };
-	char *json = calloc(3, sizeof(char));
-	strcpy(json, "a");
-	assert_non_null(json);
-
-	/* parent node inside print_json_data */
-	will_return(__wrap_json_mkobject, &node1);
-	/* gen_json_data setup */
-	will_return(__wrap_json_mkobject, &node2);
-	will_return(populate_values, EXIT_SUCCESS);
-	/* print_json_obj setup */
-	will_return(__wrap_json_stringify, json);
-	expect_function_call(__wrap_fprintf);
-	/* print_json_data setup*/
-	expect_function_call(__wrap_json_delete);
-	assert_int_equal(
-		print_json_data(
-			NULL, 0, 0, stdout, populate_values, NULL
-		),
-		EXIT_SUCCESS
-	);
-}
+	char *buf = NULL;
+	size_t len = 0;
+	FILE *stream = NULL;
 
-void test_fail_print_json_data(void **state)
-{
 	/* Failure path - invalid `stream` argument */
-	will_return(__wrap_json_mkobject, NULL);
 	assert_int_equal(
-		print_json_data(
+		print_json_stream(
 			NULL, 0, 0, NULL, populate_values, NULL
 		),
 		EXIT_FAILURE
 	);
 
-	/* Failure path - gen_json_data fails */
-	will_return(__wrap_json_mkobject, NULL);
-	will_return(__wrap_json_mkobject, NULL);
-	will_return(populate_values, EXIT_FAILURE);
-	expect_function_call(__wrap_json_delete);
+	/* Failure path - invalid `populate_values` argument */
 	assert_int_equal(
-		print_json_data(
-			NULL, 0, 0, stdout, populate_values, NULL
+		print_json_stream(
+			NULL, 0, 0, stdout, NULL, NULL
 		),
 		EXIT_FAILURE
 	);
 
-	/* Failure path - print_json_obj fails */
-	will_return(__wrap_json_mkobject, NULL);
-	will_return(__wrap_json_mkobject, NULL);
-	will_return(populate_values, EXIT_SUCCESS);
-	expect_function_call(__wrap_json_delete);
+	/* Failure path - populate_values fails, document is still closed */
+	stream = open_memstream(&buf, &len);
+	assert_non_null(stream);
+
+	will_return(populate_values, EXIT_FAILURE);
 	assert_int_equal(
-		print_json_data(
-			NULL, 0, 0, stdout, populate_values, NULL
+		print_json_stream(
+			NULL, 0, 0, stream, populate_values, NULL
 		),
 		EXIT_FAILURE
 	);
+
+	fclose(stream);
+	assert_string_equal(buf, "\r\n{}\r\n");
+	free(buf);
 }
 
 /*****************************************************************************/
@@ -504,14 +462,12 @@ int main(void)
 		cmocka_unit_test(test_happy_print_divider),
 		cmocka_unit_test(test_happy_print_hexdump),
 		cmocka_unit_test(test_fail_print_hexdump),
+		cmocka_unit_test(test_happy_print_capture),
+		cmocka_unit_test(test_fail_print_capture),
 		cmocka_unit_test(test_happy_print_table_data),
 		cmocka_unit_test(test_fail_print_table_data),
-		cmocka_unit_test(test_happy_gen_json_data),
-		cmocka_unit_test(test_fail_gen_json_data),
-		cmocka_unit_test(test_happy_print_json_obj),
-		cmocka_unit_test(test_fail_print_json_obj),
-		cmocka_unit_test(test_happy_print_json_data),
-		cmocka_unit_test(test_fail_print_json_data),
+		cmocka_unit_test(test_happy_print_json_stream),
+		cmocka_unit_test(test_fail_print_json_stream),
 	};
 
 	return cmocka_run_group_tests(tests, NULL, NULL);
@@ -313,6 +313,12 @@ int __wrap_ami_sensor_discover(ami_device *dev)
 	return (int)mock();
 }
 
+int __wrap_app_sensor_discover(ami_device *dev)
+{
+	/* Keep the existing `ami_sensor_discover` expectations. */
+	return __wrap_ami_sensor_discover(dev);
+}
+
 int __wrap_ami_sensor_get_sensors(ami_device *dev, struct ami_sensor **sensors, int *num)
 {
 	static struct ami_sensor sensor = {
@@ -331,30 +337,34 @@ int __wrap_ami_sensor_get_num_total(ami_device *dev, int *num)
 	return (int)mock();
 }
 
-/* Json lib */
+/* JSON writer */
+
+void __wrap_json_writer_begin_object(struct json_writer *jw)
+{
+
+}
 
-JsonNode *__wrap_json_mknull(void)
+void __wrap_json_writer_end_object(struct json_writer *jw)
 {
 
 }
 
-JsonNode *__wrap_json_mknumber(double n)
+void __wrap_json_writer_key(struct json_writer *jw, const char *key)
 {
 
 }
 
-JsonNode *__wrap_json_mkobject(void)
+void __wrap_json_writer_number(struct json_writer *jw, double num)
 {
-	static JsonNode node = { 0 };
-	return &node;
+
 }
 
-void __wrap_json_append_member(JsonNode *object, const char *key, JsonNode *value)
+void __wrap_json_writer_int(struct json_writer *jw, int64_t num)
 {
 
 }
 
-void __wrap_json_delete(JsonNode *node)
+void __wrap_json_writer_null(struct json_writer *jw)
 {
 
 }
@@ -368,22 +378,30 @@ int __wrap_print_table_data(ami_device *dev, int n_fields, int n_rows, FILE *str
 	return (int)mock();
 }
 
-int __wrap_print_json_data(ami_device *dev, int n_fields, int n_rows, FILE *stream,
+int __wrap_print_json_stream(ami_device *dev, int n_fields, int n_rows, FILE *stream,
 	app_value_builder populate_values, void *data)
 {
 	return 0;
 }
 
-int __wrap_print_json_obj(JsonNode *obj, FILE *stream)
+int __wrap_print_json_stream_begin(struct json_writer *jw, FILE *stream)
+{
+	return 0;
+}
+
+int __wrap_print_json_stream_end(struct json_writer *jw)
 {
 	return 0;
 }
 
-int __wrap_gen_json_data(ami_device *dev, int n_fields, int n_rows,
-	app_value_builder populate_values, void *data, JsonNode **out)
+int __wrap_print_cbor_stream(ami_device *dev, int n_fields, int n_rows, FILE *stream,
+	app_value_builder populate_values, void *data)
+{
+	return 0;
+}
+
+int __wrap_print_cbor_stream_begin(struct json_writer *jw, FILE *stream)
 {
-	static JsonNode node = { 0 };
-	*out = &node;
 	return 0;
 }
 
@@ -392,6 +410,11 @@ struct app_option* __wrap_find_app_option(const int val, struct app_option *opti
 	return (struct app_option*)mock();
 }
 
+bool __wrap_is_device_list(const char *arg)
+{
+	return false;
+}
+
 int __wrap_parse_output_options(struct app_option *options, enum app_out_format *fmt,
 	bool *verbose, FILE **stream, bool *fmt_given, bool *output_given)
 {
@@ -740,6 +763,65 @@ void test_fail_report_sensors(void **state)
 
 /* Using `report_sensors` to test `print_sensor_data` */
 
+void test_happy_report_device_sensors(void **state)
+{
+	ami_device *dev = (ami_device*)1;
+
+	/* Happy path - all sensors, table format */
+	will_return(__wrap_parse_output_options, APP_OUT_FORMAT_TABLE); /* fmt */
+	will_return(__wrap_parse_output_options, false);                /* verbose */
+	will_return(__wrap_parse_output_options, NULL);                 /* stream */
+	will_return(__wrap_parse_output_options, false);                /* format_given */
+	will_return(__wrap_parse_output_options, false);                /* output_given */
+	will_return(__wrap_parse_output_options, EXIT_SUCCESS);         /* return */
+	will_return(__wrap_find_app_option, NULL);
+	will_return(__wrap_ami_sensor_discover, AMI_STATUS_OK);
+	will_return(__wrap_ami_sensor_get_num_total, 1);
+	will_return(__wrap_ami_sensor_get_num_total, AMI_STATUS_OK);
+	will_return(__wrap_print_table_data, EXIT_SUCCESS);
+	assert_int_equal(
+		report_device_sensors(dev, NULL),
+		EXIT_SUCCESS
+	);
+}
+
+void test_fail_report_device_sensors(void **state)
+{
+	ami_device *dev = (ami_device*)1;
+
+	/* Failure path - invalid `dev` argument */
+	assert_int_equal(
+		report_device_sensors(NULL, NULL),
+		EXIT_FAILURE
+	);
+
+	/* Failure path - parse_output_options fails */
+	will_return(__wrap_parse_output_options, APP_OUT_FORMAT_TABLE); /* fmt */
+	will_return(__wrap_parse_output_options, false);                /* verbose */
+	will_return(__wrap_parse_output_options, NULL);                 /* stream */
+	will_return(__wrap_parse_output_options, false);                /* format_given */
+	will_return(__wrap_parse_output_options, false);                /* output_given */
+	will_return(__wrap_parse_output_options, EXIT_FAILURE);         /* return */
+	assert_int_equal(
+		report_device_sensors(dev, NULL),
+		EXIT_FAILURE
+	);
+
+	/* Failure path - ami_sensor_discover fails */
+	will_return(__wrap_parse_output_options, APP_OUT_FORMAT_TABLE); /* fmt */
+	will_return(__wrap_parse_output_options, false);                /* verbose */
+	will_return(__wrap_parse_output_options, NULL);                 /* stream */
+	will_return(__wrap_parse_output_options, false);                /* format_given */
+	will_return(__wrap_parse_output_options, false);                /* output_given */
+	will_return(__wrap_parse_output_options, EXIT_SUCCESS);         /* return */
+	will_return(__wrap_find_app_option, NULL);
+	will_return(__wrap_ami_sensor_discover, AMI_STATUS_ERROR);
+	assert_int_equal(
+		report_device_sensors(dev, NULL),
+		EXIT_FAILURE
+	);
+}
+
 void test_fail_print_sensor_data(void **state)
 {
 	struct app_option opt = { 0 };
@@ -787,7 +869,7 @@ void test_fail_print_sensor_data(void **state)
 void test_fail_static_print_sensor_data(void **state)
 {
 	ami_device *dev = (ami_device*)1;
-	JsonNode **out = (JsonNode**)1;
+	struct json_writer *jw = (struct json_writer*)1;
 
 	/* Failure path - invalid `dev` argument */
 	assert_int_equal(
@@ -797,7 +879,7 @@ void test_fail_static_print_sensor_data(void **state)
 			"foo",
 			NULL,
 			APP_OUT_FORMAT_TABLE,
-			out
+			jw
 		),
 		EXIT_FAILURE
 	);
@@ -1081,96 +1163,36 @@ void test_fail_static_populate_sensor_header(void **state)
 
 void test_happy_static_get_all_sensor_values(void **state)
 {
+	int i = 0;
 	ami_device *dev = (ami_device*)1;
 	const char *sensor = "foo";
-	double value = 0, max = 0, avg = 0;
-	enum ami_sensor_unit_mod mod = 0;
-	enum ami_sensor_status status = 0;
-	int max_ret = 1, avg_ret = 1;
-
-	/* Happy path - temperature */
-	get_all_sensor_values(
-		dev, sensor,
-		AMI_SENSOR_TYPE_TEMP, EXTRA_FIELDS_ALL,
-		&value, &status,
-		&mod,
-		&max_ret, &max,
-		&avg_ret, &avg
-	);
-	ASSERT_NE_AND_SET(value, 0);
-	ASSERT_NE_AND_SET(status, 0);
-	ASSERT_NE_AND_SET(mod, 0);
-	ASSERT_NE_AND_SET(max_ret, 1);
-	ASSERT_NE_AND_SET(max, 0);
-	ASSERT_NE_AND_SET(avg_ret, 1);
-	ASSERT_NE_AND_SET(avg, 0);
-
-	/* Happy path - power */
-	get_all_sensor_values(
-		dev, sensor,
-		AMI_SENSOR_TYPE_POWER, EXTRA_FIELDS_ALL,
-		&value, &status,
-		&mod,
-		&max_ret, &max,
-		&avg_ret, &avg
-	);
-	ASSERT_NE_AND_SET(value, 0);
-	ASSERT_NE_AND_SET(status, 0);
-	ASSERT_NE_AND_SET(mod, 0);
-	ASSERT_NE_AND_SET(max_ret, 1);
-	ASSERT_NE_AND_SET(max, 0);
-	ASSERT_NE_AND_SET(avg_ret, 1);
-	ASSERT_NE_AND_SET(avg, 0);
-
-	/* Happy path - current */
-	get_all_sensor_values(
-		dev, sensor,
-		AMI_SENSOR_TYPE_CURRENT, EXTRA_FIELDS_ALL,
-		&value, &status,
-		&mod,
-		&max_ret, &max,
-		&avg_ret, &avg
-	);
-	ASSERT_NE_AND_SET(value, 0);
-	ASSERT_NE_AND_SET(status, 0);
-	ASSERT_NE_AND_SET(mod, 0);
-	ASSERT_NE_AND_SET(max_ret, 1);
-	ASSERT_NE_AND_SET(max, 0);
-	ASSERT_NE_AND_SET(avg_ret, 1);
-	ASSERT_NE_AND_SET(avg, 0);
-
-	/* Happy path - voltage */
-	get_all_sensor_values(
-		dev, sensor,
-		AMI_SENSOR_TYPE_VOLTAGE, EXTRA_FIELDS_ALL,
-		&value, &status,
-		&mod,
-		&max_ret, &max,
-		&avg_ret, &avg
-	);
-	ASSERT_NE_AND_SET(value, 0);
-	ASSERT_NE_AND_SET(status, 0);
-	ASSERT_NE_AND_SET(mod, 0);
-	ASSERT_NE_AND_SET(max_ret, 1);
-	ASSERT_NE_AND_SET(max, 0);
-	ASSERT_NE_AND_SET(avg_ret, 1);
-	ASSERT_NE_AND_SET(avg, 0);
-
-	/* Happy path - omit `mod` argument */
-	get_all_sensor_values(
-		dev, sensor,
-		AMI_SENSOR_TYPE_VOLTAGE, EXTRA_FIELDS_ALL,
-		&value, &status,
-		NULL,
-		&max_ret, &max,
-		&avg_ret, &avg
-	);
-	ASSERT_NE_AND_SET(value, 0);
-	ASSERT_NE_AND_SET(status, 0);
-	ASSERT_NE_AND_SET(max_ret, 1);
-	ASSERT_NE_AND_SET(max, 0);
-	ASSERT_NE_AND_SET(avg_ret, 1);
-	ASSERT_NE_AND_SET(avg, 0);
+	struct sensor_values values = { 0 };
+	int types[] = {
+		AMI_SENSOR_TYPE_TEMP,
+		AMI_SENSOR_TYPE_POWER,
+		AMI_SENSOR_TYPE_CURRENT,
+		AMI_SENSOR_TYPE_VOLTAGE,
+	};
+
+	/* Happy path - raw values are returned with their modifier */
+	for (i = 0; i < (sizeof(types) / sizeof(types[0])); i++) {
+		memset(&values, 0, sizeof(values));
+		values.max_r = 1;
+		values.avg_r = 1;
+
+		get_all_sensor_values(
+			dev, sensor,
+			types[i], EXTRA_FIELDS_MAX | EXTRA_FIELDS_AVG,
+			&values
+		);
+
+		assert_int_equal(values.value, 1);
+		assert_int_equal(values.status, AMI_SENSOR_STATUS_OK);
+		assert_int_equal(values.max_r, AMI_STATUS_OK);
+		assert_int_equal(values.max, 1);
+		assert_int_equal(values.avg_r, AMI_STATUS_OK);
+		assert_int_equal(values.avg, 1);
+	}
 }
 
 void test_fail_static_get_all_sensor_values(void **state)
@@ -1178,100 +1200,46 @@ void test_fail_static_get_all_sensor_values(void **state)
 	/* Note: this is a void function so no errors are returned. */
 	ami_device *dev = (ami_device*)1;
 	const char *sensor = "foo";
-	double value = 0, max = 0, avg = 0;
-	enum ami_sensor_unit_mod mod = 0;
-	enum ami_sensor_status status = 0;
-	int max_ret = 0, avg_ret = 0;
+	struct sensor_values values = { 0 };
 
-	/* Failure path - invalid `dev` argument */
-	get_all_sensor_values(
-		NULL, sensor,
-		0, 0,
-		&value, &status,
-		&mod,
-		&max_ret, &max,
-		&avg_ret, &avg
-	);
-
-	/* Failure path - invalid `sensor` argument */
-	get_all_sensor_values(
-		dev, NULL,
-		0, 0,
-		&value, &status,
-		&mod,
-		&max_ret, &max,
-		&avg_ret, &avg
-	);
-
-	/* Failure path - invalid `value` argument */
-	get_all_sensor_values(
-		dev, sensor,
-		0, 0,
-		NULL, &status,
-		&mod,
-		&max_ret, &max,
-		&avg_ret, &avg
-	);
-
-	/* Failure path - invalid `status` argument */
-	get_all_sensor_values(
-		dev, sensor,
-		0, 0,
-		&value, NULL,
-		&mod,
-		&max_ret, &max,
-		&avg_ret, &avg
-	);
-
-	/* Failure path - invalid `max_ret` argument */
-	get_all_sensor_values(
-		dev, sensor,
-		0, 0,
-		&value, &status,
-		&mod,
-		NULL, &max,
-		&avg_ret, &avg
-	);
-
-	/* Failure path - invalid `max` argument */
-	get_all_sensor_values(
-		dev, sensor,
-		0, 0,
-		&value, &status,
-		&mod,
-		&max_ret, NULL,
-		&avg_ret, &avg
-	);
-
-	/* Failure path - invalid `avg_ret` argument */
-	get_all_sensor_values(
-		dev, sensor,
-		0, 0,
-		&value, &status,
-		&mod,
-		&max_ret, &max,
-		NULL, &avg
-	);
-
-	/* Failure path - invalid `avg` argument */
-	get_all_sensor_values(
-		dev, sensor,
-		0, 0,
-		&value, &status,
-		&mod,
-		&max_ret, &max,
-		&avg_ret, NULL
-	);
+	/* Failure path - invalid `values` argument */
+	get_all_sensor_values(dev, sensor, AMI_SENSOR_TYPE_TEMP, 0, NULL);
 
 	/* Failure path - invalid sensor type */
-	get_all_sensor_values(
-		dev, sensor,
-		-1, 0,
-		&value, &status,
-		&mod,
-		&max_ret, &max,
-		&avg_ret, &avg
-	);
+	get_all_sensor_values(dev, sensor, -1, 0, &values);
+	assert_int_equal(values.value, 0);
+	assert_int_equal(values.mod, AMI_SENSOR_UNIT_MOD_NONE);
+}
+
+void test_happy_static_format_fixed(void **state)
+{
+	char buf[TABLE_FIELD_MAX] = { 0 };
+
+	/* Unit modifiers */
+	assert_int_equal(fixed_to_milli(12, 1, AMI_SENSOR_UNIT_MOD_NONE), 12000);
+	assert_int_equal(fixed_to_milli(12, 1, AMI_SENSOR_UNIT_MOD_KILO), 12000000);
+	assert_int_equal(fixed_to_milli(12345, 1, AMI_SENSOR_UNIT_MOD_MILLI), 12345);
+	assert_int_equal(fixed_to_milli(1234567, 1, AMI_SENSOR_UNIT_MOD_MICRO), 1235);
+
+	/* Halfway cases round away from zero */
+	assert_int_equal(fixed_to_milli(1500, 1, AMI_SENSOR_UNIT_MOD_MICRO), 2);
+	assert_int_equal(fixed_to_milli(-1500, 1, AMI_SENSOR_UNIT_MOD_MICRO), -2);
+
+	/* Averages */
+	assert_int_equal(fixed_to_milli(10, 3, AMI_SENSOR_UNIT_MOD_NONE), 3333);
+	assert_int_equal(fixed_to_milli(20, 3, AMI_SENSOR_UNIT_MOD_MILLI), 7);
+
+	format_fixed(buf, sizeof(buf), 12345, "V");
+	assert_string_equal(buf, "12.345 V");
+
+	format_fixed(buf, sizeof(buf), -5, "C");
+	assert_string_equal(buf, "-0.005 C");
+
+	format_fixed(buf, sizeof(buf), 7000, "");
+	assert_string_equal(buf, "7.000 ");
+
+	format_fixed(buf, sizeof(buf), 42, NULL);
+	assert_string_equal(buf, "0.042");
 }
 
 void test_happy_static_mk_sensor_row(void **state)
@@ -1401,7 +1369,7 @@ void test_fail_static_construct_sensor_table(void **state)
 void test_fail_static_mk_sensor_node(void **state)
 {
 	ami_device *dev = (ami_device*)1;
-	JsonNode node = { 0 };
+	struct json_writer node = { 0 };
 
 	/* Failure path - invalid `dev` argument */
 	assert_int_equal(
@@ -1427,7 +1395,7 @@ void test_fail_static_mk_sensor_node(void **state)
 		EXIT_FAILURE
 	);
 
-	/* Failure path - invalid `parent` argument */
+	/* Failure path - invalid `jw` argument */
 	assert_int_equal(
 		mk_sensor_node(
 			dev,
@@ -1456,7 +1424,7 @@ void test_fail_static_construct_sensor_json(void **state)
 {
 	ami_device *dev = (ami_device*)1;
 	int j = 0;
-	JsonNode node = { 0 };
+	struct json_writer node = { 0 };
 
 	/* Failure path - invalid `j` argument */
 	assert_int_equal(
@@ -1470,7 +1438,7 @@ void test_fail_static_construct_sensor_json(void **state)
 		EXIT_FAILURE
 	);
 
-	/* Failure path - invalid `parent` argument */
+	/* Failure path - invalid `jw` argument */
 	assert_int_equal(
 		construct_sensor_json(
 			dev,
@@ -1531,7 +1499,7 @@ void test_happy_static_populate_sensor_values(void **state)
 	char *row[5] = { 0 };
 	char ***values = NULL;
 	/* JSON data */
-	JsonNode node = { 0 };
+	struct json_writer node = { 0 };
 
 	for (i = 0; i < 5; i++) {
 		row[i] = calloc(10, sizeof(char));
@@ -1719,6 +1687,8 @@ int main(void)
 	const struct CMUnitTest tests[] = {
 		cmocka_unit_test(test_happy_report_sensors),
 		cmocka_unit_test(test_fail_report_sensors),
+		cmocka_unit_test(test_happy_report_device_sensors),
+		cmocka_unit_test(test_fail_report_device_sensors),
 		cmocka_unit_test(test_fail_print_sensor_data),
 		cmocka_unit_test(test_fail_static_print_sensor_data),
 		cmocka_unit_test(test_fail_static_parse_extra),
@@ -1728,6 +1698,7 @@ int main(void)
 		cmocka_unit_test(test_fail_static_populate_sensor_header),
 		cmocka_unit_test(test_happy_static_get_all_sensor_values),
 		cmocka_unit_test(test_fail_static_get_all_sensor_values),
+		cmocka_unit_test(test_happy_static_format_fixed),
 		cmocka_unit_test(test_happy_static_mk_sensor_row),
 		cmocka_unit_test(test_fail_static_mk_sensor_row),
 		cmocka_unit_test(test_fail_static_construct_sensor_table),
@@ -0,0 +1,207 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * test_subsys.c - Unit test file for subsys.c
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+/* Standard includes */
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+/* External includes */
+#include "cmocka.h"
+
+/* App includes */
+#include "amiapp.h"
+#include "subsys.h"
+
+/* API includes */
+#include "ami.h"
+#include "ami_device.h"
+#include "ami_sensor.h"
+
+/*
+ * NOTE: The subsystem state is process wide, so the tests below depend on
+ * running in the order listed in `main`.
+ */
+
+/*****************************************************************************/
+/* Redefinitions/Wrapping                                                    */
+/*****************************************************************************/
+
+const char *__wrap_ami_get_last_error(void)
+{
+	return "";
+}
+
+int __wrap_ami_get_driver_version(struct ami_version *ami_version)
+{
+	function_called();
+	ami_version->major = 3;
+	return (int)mock();
+}
+
+int __wrap_ami_dev_get_num_devices(uint16_t *num)
+{
+	function_called();
+	*num = 1;
+	return (int)mock();
+}
+
+int __wrap_ami_dev_find_next(ami_device **dev, int b, int d, int f, ami_device *prev)
+{
+	*dev = (ami_device*)mock();
+	return (int)mock();
+}
+
+int __wrap_ami_dev_get_pci_device(ami_device *dev, uint16_t *device)
+{
+	*device = (uint16_t)mock();
+	return (int)mock();
+}
+
+void __wrap_ami_dev_delete(ami_device **dev)
+{
+	function_called();
+	*dev = NULL;
+}
+
+int __wrap_ami_sensor_get_num_total(ami_device *dev, int *num)
+{
+	*num = (int)mock();
+	return AMI_STATUS_OK;
+}
+
+int __wrap_ami_sensor_discover(ami_device *dev)
+{
+	function_called();
+	return (int)mock();
+}
+
+/*****************************************************************************/
+/* Tests                                                                     */
+/*****************************************************************************/
+
+void test_fail_app_subsys_require(void **state)
+{
+	/* Failure path - driver not loaded */
+	expect_function_call(__wrap_ami_get_driver_version);
+	will_return(__wrap_ami_get_driver_version, AMI_STATUS_ERROR);
+	assert_int_equal(app_subsys_require(APP_NEEDS_DRIVER), EXIT_FAILURE);
+
+	/* Failure path - device list unreadable */
+	expect_function_call(__wrap_ami_dev_get_num_devices);
+	will_return(__wrap_ami_dev_get_num_devices, AMI_STATUS_ERROR);
+	assert_int_equal(app_subsys_require(APP_NEEDS_SENSORS), EXIT_FAILURE);
+}
+
+void test_happy_app_subsys_require(void **state)
+{
+	struct ami_version ver = { 0 };
+
+	/* Nothing declared - nothing touched */
+	assert_int_equal(app_subsys_require(APP_NEEDS_NONE), EXIT_SUCCESS);
+
+	/* Failed subsystems are retried, successful ones are not */
+	expect_function_call(__wrap_ami_get_driver_version);
+	will_return(__wrap_ami_get_driver_version, AMI_STATUS_OK);
+	expect_function_call(__wrap_ami_dev_get_num_devices);
+	will_return(__wrap_ami_dev_get_num_devices, AMI_STATUS_OK);
+	assert_int_equal(
+		app_subsys_require(APP_NEEDS_DRIVER | APP_NEEDS_DEVICES),
+		EXIT_SUCCESS
+	);
+
+	assert_int_equal(
+		app_subsys_require(APP_NEEDS_DRIVER | APP_NEEDS_DEVICES),
+		EXIT_SUCCESS
+	);
+
+	/* Cached driver version */
+	assert_int_equal(app_driver_version(&ver), AMI_STATUS_OK);
+	assert_int_equal(ver.major, 3);
+	assert_int_equal(app_driver_version(NULL), AMI_STATUS_ERROR);
+}
+
+void test_happy_app_profile(void **state)
+{
+	ami_device *dev = (ami_device*)0x1;
+
+	/* Devices are already up, only the first device is opened */
+	will_return(__wrap_ami_dev_find_next, dev);
+	will_return(__wrap_ami_dev_find_next, AMI_STATUS_OK);
+	will_return(__wrap_ami_dev_get_pci_device, AMI_PCIE_DEVICE_ID_RAVE);
+	will_return(__wrap_ami_dev_get_pci_device, AMI_STATUS_OK);
+	expect_function_call(__wrap_ami_dev_delete);
+	assert_int_equal(app_profile(), PROFILE_RAVE);
+
+	/* Cached */
+	assert_int_equal(app_profile(), PROFILE_RAVE);
+}
+
+void test_happy_app_sensor_discover(void **state)
+{
+	ami_device *dev = (ami_device*)0x1;
+
+	/* Not yet discovered */
+	will_return(__wrap_ami_sensor_get_num_total, 0);
+	expect_function_call(__wrap_ami_sensor_discover);
+	will_return(__wrap_ami_sensor_discover, AMI_STATUS_OK);
+	assert_int_equal(app_sensor_discover(dev), AMI_STATUS_OK);
+
+	/* Already discovered (e.g., cached batch handle) */
+	will_return(__wrap_ami_sensor_get_num_total, 4);
+	assert_int_equal(app_sensor_discover(dev), AMI_STATUS_OK);
+}
+
+void test_fail_app_sensor_discover(void **state)
+{
+	ami_device *dev = (ami_device*)0x1;
+
+	assert_int_equal(app_sensor_discover(NULL), AMI_STATUS_ERROR);
+
+	will_return(__wrap_ami_sensor_get_num_total, 0);
+	expect_function_call(__wrap_ami_sensor_discover);
+	will_return(__wrap_ami_sensor_discover, AMI_STATUS_ERROR);
+	assert_int_equal(app_sensor_discover(dev), AMI_STATUS_ERROR);
+}
+
+void test_happy_app_timing(void **state)
+{
+	uint64_t start = 0;
+
+	/* Disabled by default */
+	assert_int_equal(app_timing_start(), 0);
+
+	app_timing_enable();
+	start = app_timing_start();
+	assert_true(start != 0);
+
+	app_timing_stop(APP_PHASE_COMMAND, start);
+	app_timing_stop(APP_PHASE_MAX, start);
+	app_timing_report(stderr);
+	app_timing_report(NULL);
+}
+
+/*****************************************************************************/
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_fail_app_subsys_require),
+		cmocka_unit_test(test_happy_app_subsys_require),
+		cmocka_unit_test(test_happy_app_profile),
+		cmocka_unit_test(test_happy_app_sensor_discover),
+		cmocka_unit_test(test_fail_app_sensor_discover),
+		cmocka_unit_test(test_happy_app_timing),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -2,7 +2,7 @@
 /*
  * test_table.c - Unit test file for table.c
  *
- * Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+ * Copyright (c) 2023-2026 Advanced Micro Devices, Inc. All rights reserved.
  */
 
 /* Standard includes */
@@ -230,6 +230,161 @@ void test_fail_print_table(void **state)
 	);
 }
 
+void test_happy_print_table_layout(void **state)
+{
+	int i = 0;
+	char *header[] = { "a", "b" };
+	char* row1[] = { "a", "ab" };
+	char* row2[] = { "c", "cd" };
+	char* row3[] = { "", "ef" };
+	char** values[] = { row1, row2, row3 };
+	int min_widths[] = { 0, 5 };
+	int right_align[] = { TABLE_ALIGN_RIGHT, TABLE_ALIGN_RIGHT };
+	struct table_layout layout = { 0 };
+
+	/*
+	 * Happy path - TABLE_DIVIDER_GROUPS with a minimum column width
+	 *
+	 * Line 0 is whitespace, line 1 the header, line 2 a divider,
+	 * line 3 the first row, line 4 a divider, lines 5 and 6 the
+	 * remaining rows and line 7 whitespace.
+	 */
+	expect_function_calls(__wrap_my_fprintf, 4);
+	for (i = 0; i < 3; i++) {
+		if (i != 2)
+			expect_function_call(__wrap_print_divider);
+		expect_function_calls(__wrap_my_fprintf, 3);
+	}
+	expect_function_call(__wrap_my_fprintf);
+	assert_int_equal(
+		print_table_layout(header, values, 2, 3, TABLE_DIVIDER_GROUPS,
+			NULL, NULL, min_widths, &layout),
+		EXIT_SUCCESS
+	);
+	assert_int_equal(layout.num_cols, 2);
+	assert_int_equal(layout.num_rows, 3);
+	assert_int_equal(layout.num_lines, 8);
+	assert_int_equal(layout.col_widths[0], 1);
+	assert_int_equal(layout.col_widths[1], 5);
+	assert_int_equal(layout.col_offsets[0], 0);
+	assert_int_equal(layout.col_offsets[1], 4);
+	assert_int_equal(layout.row_lines[0], 3);
+	assert_int_equal(layout.row_lines[1], 5);
+	assert_int_equal(layout.row_lines[2], 6);
+
+	/* Happy path - redraw a single cell */
+	expect_function_call(__wrap_my_fprintf);
+	assert_int_equal(
+		print_table_cell(&layout, 1, 1, "xy", right_align),
+		EXIT_SUCCESS
+	);
+
+	free_table_layout(&layout);
+	assert_null(layout.col_widths);
+}
+
+void test_fail_print_table_cell(void **state)
+{
+	int widths[] = { 1 };
+	int offsets[] = { 0 };
+	int lines[] = { 3 };
+	struct table_layout layout = { 1, 1, 5, widths, offsets, lines };
+
+	/* Failure path - invalid `layout` argument */
+	assert_int_equal(
+		print_table_cell(NULL, 0, 0, "a", NULL),
+		EXIT_FAILURE
+	);
+
+	/* Failure path - invalid `value` argument */
+	assert_int_equal(
+		print_table_cell(&layout, 0, 0, NULL, NULL),
+		EXIT_FAILURE
+	);
+
+	/* Failure path - row out of range */
+	assert_int_equal(
+		print_table_cell(&layout, 1, 0, "a", NULL),
+		EXIT_FAILURE
+	);
+
+	/* Failure path - column out of range */
+	assert_int_equal(
+		print_table_cell(&layout, 0, 1, "a", NULL),
+		EXIT_FAILURE
+	);
+}
+
+void test_happy_print_table_stream(void **state)
+{
+	char *header[] = { "abc", "b" };
+	char *row1[] = { "a", "ab" };
+	char *row2[] = { "", "cd" };
+	int widths[] = { 1, 4 };
+	struct table_stream ts = { 0 };
+
+	/* Happy path - header widens the first column, groups divider rule */
+	expect_function_calls(__wrap_my_fprintf, 4);  /* padding + header */
+	assert_int_equal(
+		print_table_stream_begin(&ts, header, 2, widths,
+			TABLE_DIVIDER_GROUPS, NULL, NULL),
+		EXIT_SUCCESS
+	);
+	assert_int_equal(ts.col_widths[0], 3);
+	assert_int_equal(ts.col_widths[1], 4);
+	assert_int_equal(ts.table_width, 10);
+
+	expect_function_call(__wrap_print_divider);
+	expect_function_calls(__wrap_my_fprintf, 3);
+	assert_int_equal(print_table_stream_row(&ts, row1), EXIT_SUCCESS);
+
+	/* No divider for a row continuing a group */
+	expect_function_calls(__wrap_my_fprintf, 3);
+	assert_int_equal(print_table_stream_row(&ts, row2), EXIT_SUCCESS);
+	assert_int_equal(ts.num_rows, 2);
+
+	expect_function_call(__wrap_my_fprintf);
+	print_table_stream_end(&ts);
+	assert_null(ts.col_widths);
+}
+
+void test_fail_print_table_stream(void **state)
+{
+	char *header[] = { "a" };
+	char *row[] = { "a" };
+	int widths[] = { 1 };
+	struct table_stream ts = { 0 };
+
+	/* Failure path - invalid arguments */
+	assert_int_equal(
+		print_table_stream_begin(NULL, header, 1, widths,
+			TABLE_DIVIDER_NONE, NULL, NULL),
+		EXIT_FAILURE
+	);
+	assert_int_equal(
+		print_table_stream_begin(&ts, NULL, 1, widths,
+			TABLE_DIVIDER_NONE, NULL, NULL),
+		EXIT_FAILURE
+	);
+	assert_int_equal(
+		print_table_stream_begin(&ts, header, 1, NULL,
+			TABLE_DIVIDER_NONE, NULL, NULL),
+		EXIT_FAILURE
+	);
+
+	/* Failure path - calloc fails */
+	WRAPPER_ACTION(FAIL, calloc);
+	assert_int_equal(
+		print_table_stream_begin(&ts, header, 1, widths,
+			TABLE_DIVIDER_NONE, NULL, NULL),
+		EXIT_FAILURE
+	);
+
+	/* Failure path - table not started */
+	assert_int_equal(print_table_stream_row(&ts, row), EXIT_FAILURE);
+	print_table_stream_end(&ts);
+}
+
 /*****************************************************************************/
 
 int main(void)
@@ -239,6 +394,10 @@ int main(void)
 		cmocka_unit_test(test_fail_print_table_row),
 		cmocka_unit_test(test_happy_print_table),
 		cmocka_unit_test(test_fail_print_table),
+		cmocka_unit_test(test_happy_print_table_layout),
+		cmocka_unit_test(test_fail_print_table_cell),
+		cmocka_unit_test(test_happy_print_table_stream),
+		cmocka_unit_test(test_fail_print_table_stream),
 	};
 
 	return cmocka_run_group_tests(tests, NULL, NULL);
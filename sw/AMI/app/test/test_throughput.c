@@ -0,0 +1,223 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * test_throughput.c - Unit test file for throughput.c
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+/* Standard includes */
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+
+/* External includes */
+#include "cmocka.h"
+
+/* App includes */
+#include "throughput.h"
+
+/* API includes */
+#include "ami.h"
+#include "ami_device.h"
+
+/*****************************************************************************/
+/* Redefinitions/Wrapping                                                    */
+/*****************************************************************************/
+
+int __wrap_ami_dev_get_pci_vendor(ami_device *dev, uint16_t *vendor)
+{
+	*vendor = (uint16_t)mock();
+	return (int)mock();
+}
+
+int __wrap_ami_dev_get_pci_device(ami_device *dev, uint16_t *device)
+{
+	*device = (uint16_t)mock();
+	return (int)mock();
+}
+
+/*****************************************************************************/
+/* Local functions                                                           */
+/*****************************************************************************/
+
+/*
+ * Point the cache at a fresh temporary directory.
+ */
+static void use_temp_cache(char *dir, size_t size)
+{
+	snprintf(dir, size, "/tmp/test_throughput_XXXXXX");
+	assert_non_null(mkdtemp(dir));
+	assert_int_equal(setenv("XDG_CACHE_HOME", dir, 1), 0);
+}
+
+/*
+ * Remove the temporary cache created by `use_temp_cache`.
+ */
+static void remove_temp_cache(const char *dir)
+{
+	char path[256] = { 0 };
+
+	snprintf(path, sizeof(path), "%s/ami_tool/throughput", dir);
+	unlink(path);
+	snprintf(path, sizeof(path), "%s/ami_tool", dir);
+	rmdir(path);
+	rmdir(dir);
+}
+
+/*****************************************************************************/
+/* Tests                                                                     */
+/*****************************************************************************/
+
+void test_happy_rate_update(void **state)
+{
+	struct app_rate rate = { 1000.0, 0 };
+
+	/* The first measurement replaces the seed. */
+	rate_update(&rate, 4000, 2.0);
+	assert_true(rate.bytes_per_sec == 2000.0);
+	assert_int_equal(rate.samples, 1);
+
+	/* Later measurements are weighted by APP_RATE_ALPHA. */
+	rate_update(&rate, 12000, 2.0);
+	assert_true(rate.bytes_per_sec ==
+		(APP_RATE_ALPHA * 6000.0) + ((1.0 - APP_RATE_ALPHA) * 2000.0));
+	assert_int_equal(rate.samples, 2);
+
+	assert_int_equal(rate_estimate_ms(&rate, 0), 1);
+	rate.bytes_per_sec = 1000.0;
+	assert_int_equal(rate_estimate_ms(&rate, 2500), 2500);
+}
+
+void test_fail_rate_update(void **state)
+{
+	struct app_rate rate = { 1000.0, 3 };
+
+	/* Empty or zero-length measurements are ignored. */
+	rate_update(&rate, 0, 1.0);
+	rate_update(&rate, 1000, 0);
+	rate_update(NULL, 1000, 1.0);
+	assert_true(rate.bytes_per_sec == 1000.0);
+	assert_int_equal(rate.samples, 3);
+
+	rate.bytes_per_sec = 0;
+	assert_int_equal(rate_estimate_ms(&rate, 1000), 1);
+	assert_int_equal(rate_estimate_ms(NULL, 1000), 1);
+}
+
+void test_happy_rate_format(void **state)
+{
+	char buf[APP_RATE_STR_LEN] = { 0 };
+
+	rate_format(buf, sizeof(buf), 512);
+	assert_string_equal(buf, "512.00 B/s");
+	rate_format(buf, sizeof(buf), 1250000);
+	assert_string_equal(buf, "1.25 MB/s");
+	rate_format(buf, sizeof(buf), 5e12);
+	assert_string_equal(buf, "5000.00 GB/s");
+}
+
+void test_happy_rate_key(void **state)
+{
+	char buf[APP_RATE_KEY_LEN] = { 0 };
+	ami_device *dev = (ami_device*)buf;
+
+	will_return(__wrap_ami_dev_get_pci_vendor, 0x10ee);
+	will_return(__wrap_ami_dev_get_pci_vendor, AMI_STATUS_OK);
+	will_return(__wrap_ami_dev_get_pci_device, 0x50b4);
+	will_return(__wrap_ami_dev_get_pci_device, AMI_STATUS_OK);
+	assert_int_equal(rate_key(dev, "copy", buf, sizeof(buf)), EXIT_SUCCESS);
+	assert_string_equal(buf, "copy:10ee:50b4");
+}
+
+void test_fail_rate_key(void **state)
+{
+	char buf[APP_RATE_KEY_LEN] = { 0 };
+	ami_device *dev = (ami_device*)buf;
+
+	assert_int_equal(rate_key(NULL, "copy", buf, sizeof(buf)), EXIT_FAILURE);
+	assert_int_equal(rate_key(dev, "a copy", buf, sizeof(buf)), EXIT_FAILURE);
+
+	will_return(__wrap_ami_dev_get_pci_vendor, 0);
+	will_return(__wrap_ami_dev_get_pci_vendor, AMI_STATUS_ERROR);
+	assert_int_equal(rate_key(dev, "copy", buf, sizeof(buf)), EXIT_FAILURE);
+
+	/* Truncated */
+	will_return(__wrap_ami_dev_get_pci_vendor, 0x10ee);
+	will_return(__wrap_ami_dev_get_pci_vendor, AMI_STATUS_OK);
+	will_return(__wrap_ami_dev_get_pci_device, 0x50b4);
+	will_return(__wrap_ami_dev_get_pci_device, AMI_STATUS_OK);
+	assert_int_equal(rate_key(dev, "copy", buf, 8), EXIT_FAILURE);
+}
+
+void test_happy_rate_store(void **state)
+{
+	char dir[64] = { 0 };
+	struct app_rate a = { 1500.0, 2 };
+	struct app_rate b = { 2500.0, 7 };
+	struct app_rate out = { 0 };
+
+	use_temp_cache(dir, sizeof(dir));
+
+	/* Nothing stored yet */
+	assert_int_equal(rate_load("copy:10ee:50b4", &out), EXIT_FAILURE);
+	assert_int_equal(out.samples, 0);
+
+	assert_int_equal(rate_store("copy:10ee:50b4", &a), EXIT_SUCCESS);
+	assert_int_equal(rate_store("copy:10ee:50b5", &b), EXIT_SUCCESS);
+
+	assert_int_equal(rate_load("copy:10ee:50b4", &out), EXIT_SUCCESS);
+	assert_true(out.bytes_per_sec == 1500.0);
+	assert_int_equal(out.samples, 2);
+
+	/* Replacing one entry keeps the other. */
+	a.bytes_per_sec = 1700.0;
+	a.samples = 3;
+	assert_int_equal(rate_store("copy:10ee:50b4", &a), EXIT_SUCCESS);
+	assert_int_equal(rate_load("copy:10ee:50b4", &out), EXIT_SUCCESS);
+	assert_true(out.bytes_per_sec == 1700.0);
+	assert_int_equal(out.samples, 3);
+	assert_int_equal(rate_load("copy:10ee:50b5", &out), EXIT_SUCCESS);
+	assert_true(out.bytes_per_sec == 2500.0);
+	assert_int_equal(out.samples, 7);
+
+	remove_temp_cache(dir);
+}
+
+void test_fail_rate_store(void **state)
+{
+	struct app_rate rate = { 1000.0, 1 };
+
+	assert_int_equal(rate_store(NULL, &rate), EXIT_FAILURE);
+	assert_int_equal(rate_store("copy", NULL), EXIT_FAILURE);
+	assert_int_equal(rate_store("bad key", &rate), EXIT_FAILURE);
+	assert_int_equal(rate_load(NULL, &rate), EXIT_FAILURE);
+
+	/* No usable cache location */
+	assert_int_equal(setenv("XDG_CACHE_HOME", "", 1), 0);
+	assert_int_equal(unsetenv("HOME"), 0);
+	assert_int_equal(rate_store("copy", &rate), EXIT_FAILURE);
+	assert_int_equal(rate_load("copy", &rate), EXIT_FAILURE);
+}
+
+/*****************************************************************************/
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_happy_rate_update),
+		cmocka_unit_test(test_fail_rate_update),
+		cmocka_unit_test(test_happy_rate_format),
+		cmocka_unit_test(test_happy_rate_key),
+		cmocka_unit_test(test_fail_rate_key),
+		cmocka_unit_test(test_happy_rate_store),
+		cmocka_unit_test(test_fail_rate_store),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,287 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * throughput.c - This file contains utilities for tracking the measured
+ *                throughput of long running operations
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+/* Standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <linux/limits.h>
+
+/* API includes */
+#include "ami.h"
+
+/* App includes */
+#include "throughput.h"
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+#define RATE_CACHE_DIR		"ami_tool"
+#define RATE_CACHE_FILE		"throughput"
+#define RATE_CACHE_LINE_LEN	(256)
+
+#define MS_PER_S		(1000.0)
+#define BYTES_PER_KB		(1000.0)
+
+/*****************************************************************************/
+/* Local function definitions                                                */
+/*****************************************************************************/
+
+/**
+ * cache_path() - Get the path of the cache file.
+ * @buf: Buffer to hold the path.
+ * @size: Size of `buf`.
+ * @create: Create the parent directories if they don't exist.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+static int cache_path(char *buf, size_t size, bool create)
+{
+	const char *base = getenv("XDG_CACHE_HOME");
+	char dir[PATH_MAX] = { 0 };
+	int n = 0;
+
+	if (base && *base) {
+		n = snprintf(dir, sizeof(dir), "%s", base);
+	} else {
+		base = getenv("HOME");
+
+		if (!base || !*base)
+			return EXIT_FAILURE;
+
+		n = snprintf(dir, sizeof(dir), "%s/.cache", base);
+	}
+
+	if ((n < 0) || (n >= sizeof(dir)))
+		return EXIT_FAILURE;
+
+	if (create && (mkdir(dir, 0755) != 0) && (errno != EEXIST))
+		return EXIT_FAILURE;
+
+	n = snprintf(buf, size, "%s/%s", dir, RATE_CACHE_DIR);
+
+	if ((n < 0) || (n >= size))
+		return EXIT_FAILURE;
+
+	if (create && (mkdir(buf, 0755) != 0) && (errno != EEXIST))
+		return EXIT_FAILURE;
+
+	n = snprintf(buf, size, "%s/%s/%s", dir, RATE_CACHE_DIR, RATE_CACHE_FILE);
+
+	if ((n < 0) || (n >= size))
+		return EXIT_FAILURE;
+
+	return EXIT_SUCCESS;
+}
+
+/**
+ * parse_line() - Parse a single cache file entry.
+ * @line: Line to parse.
+ * @key: Buffer of `APP_RATE_KEY_LEN` bytes to hold the key.
+ * @rate: Variable to hold the throughput.
+ *
+ * Return: true if the line is a valid entry.
+ */
+static bool parse_line(const char *line, char *key, struct app_rate *rate)
+{
+	char fmt[32] = { 0 };
+
+	snprintf(fmt, sizeof(fmt), "%%%ds %%lf %%u", APP_RATE_KEY_LEN - 1);
+
+	if (sscanf(line, fmt, key, &rate->bytes_per_sec, &rate->samples) != 3)
+		return false;
+
+	return (rate->bytes_per_sec > 0);
+}
+
+/*****************************************************************************/
+/* Public function definitions                                               */
+/*****************************************************************************/
+
+/*
+ * Build the cache key of an operation on a device model.
+ */
+int rate_key(ami_device *dev, const char *op, char *buf, size_t size)
+{
+	uint16_t vendor = 0;
+	uint16_t device = 0;
+	int n = 0;
+
+	if (!dev || !op || !buf || strpbrk(op, " \t\r\n"))
+		return EXIT_FAILURE;
+
+	if ((ami_dev_get_pci_vendor(dev, &vendor) != AMI_STATUS_OK) ||
+			(ami_dev_get_pci_device(dev, &device) != AMI_STATUS_OK))
+		return EXIT_FAILURE;
+
+	n = snprintf(buf, size, "%s:%04x:%04x", op, vendor, device);
+
+	if ((n < 0) || (n >= size) || (n >= APP_RATE_KEY_LEN))
+		return EXIT_FAILURE;
+
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Read a stored throughput from the cache file.
+ */
+int rate_load(const char *key, struct app_rate *rate)
+{
+	int ret = EXIT_FAILURE;
+	char path[PATH_MAX] = { 0 };
+	char line[RATE_CACHE_LINE_LEN] = { 0 };
+	FILE *fp = NULL;
+
+	if (!key || !rate)
+		return EXIT_FAILURE;
+
+	if (cache_path(path, sizeof(path), false) != EXIT_SUCCESS)
+		return EXIT_FAILURE;
+
+	fp = fopen(path, "r");
+
+	if (!fp)
+		return EXIT_FAILURE;
+
+	while (fgets(line, sizeof(line), fp)) {
+		char entry_key[APP_RATE_KEY_LEN] = { 0 };
+		struct app_rate entry = { 0 };
+
+		if (parse_line(line, entry_key, &entry) &&
+				(strcmp(entry_key, key) == 0)) {
+			*rate = entry;
+			ret = EXIT_SUCCESS;
+			break;
+		}
+	}
+
+	fclose(fp);
+	return ret;
+}
+
+/*
+ * Write a throughput to the cache file.
+ */
+int rate_store(const char *key, const struct app_rate *rate)
+{
+	int ret = EXIT_FAILURE;
+	char path[PATH_MAX] = { 0 };
+	char tmp[PATH_MAX] = { 0 };
+	char line[RATE_CACHE_LINE_LEN] = { 0 };
+	FILE *in = NULL;
+	FILE *out = NULL;
+	int n = 0;
+
+	if (!key || !rate || (strlen(key) >= APP_RATE_KEY_LEN) ||
+			strpbrk(key, " \t\r\n"))
+		return EXIT_FAILURE;
+
+	if (cache_path(path, sizeof(path), true) != EXIT_SUCCESS)
+		return EXIT_FAILURE;
+
+	n = snprintf(tmp, sizeof(tmp), "%s.%d", path, (int)getpid());
+
+	if ((n < 0) || (n >= sizeof(tmp)))
+		return EXIT_FAILURE;
+
+	out = fopen(tmp, "w");
+
+	if (!out)
+		return EXIT_FAILURE;
+
+	/* Copy every valid entry except the one being replaced. */
+	in = fopen(path, "r");
+
+	if (in) {
+		while (fgets(line, sizeof(line), in)) {
+			char entry_key[APP_RATE_KEY_LEN] = { 0 };
+			struct app_rate entry = { 0 };
+
+			if (parse_line(line, entry_key, &entry) &&
+					(strcmp(entry_key, key) != 0))
+				fprintf(out, "%s %.0f %u\n", entry_key,
+					entry.bytes_per_sec, entry.samples);
+		}
+
+		fclose(in);
+	}
+
+	fprintf(out, "%s %.0f %u\n", key, rate->bytes_per_sec, rate->samples);
+
+	if ((fflush(out) == 0) && !ferror(out))
+		ret = EXIT_SUCCESS;
+
+	if (fclose(out) != 0)
+		ret = EXIT_FAILURE;
+
+	if ((ret == EXIT_SUCCESS) && (rename(tmp, path) != 0))
+		ret = EXIT_FAILURE;
+
+	if (ret != EXIT_SUCCESS)
+		unlink(tmp);
+
+	return ret;
+}
+
+/*
+ * Fold a measurement into a throughput.
+ */
+void rate_update(struct app_rate *rate, uint64_t bytes, double seconds)
+{
+	double sample = 0;
+
+	if (!rate || (bytes == 0) || (seconds <= 0))
+		return;
+
+	sample = (double)bytes / seconds;
+
+	if (rate->samples == 0)
+		rate->bytes_per_sec = sample;
+	else
+		rate->bytes_per_sec = (APP_RATE_ALPHA * sample) +
+			((1.0 - APP_RATE_ALPHA) * rate->bytes_per_sec);
+
+	rate->samples++;
+}
+
+/*
+ * Estimate the duration of a transfer.
+ */
+uint64_t rate_estimate_ms(const struct app_rate *rate, uint64_t bytes)
+{
+	double ms = 0;
+
+	if (!rate || (rate->bytes_per_sec <= 0))
+		return 1;
+
+	ms = ((double)bytes * MS_PER_S) / rate->bytes_per_sec;
+
+	return (ms < 1) ? 1 : (uint64_t)(ms + 0.5);
+}
+
+/*
+ * Format a throughput for display.
+ */
+int rate_format(char *buf, size_t size, double bytes_per_sec)
+{
+	static const char *units[] = { "B/s", "KB/s", "MB/s", "GB/s" };
+	int i = 0;
+
+	while ((bytes_per_sec >= BYTES_PER_KB) &&
+			(i < (sizeof(units) / sizeof(units[0])) - 1)) {
+		bytes_per_sec /= BYTES_PER_KB;
+		i++;
+	}
+
+	return snprintf(buf, size, "%.2f %s", bytes_per_sec, units[i]);
+}
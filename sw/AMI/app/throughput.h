@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * throughput.h - This file contains utilities for tracking the measured
+ *                throughput of long running operations
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+#ifndef AMI_APP_THROUGHPUT_H
+#define AMI_APP_THROUGHPUT_H
+
+/* Standard includes */
+#include <stddef.h>
+#include <stdint.h>
+
+/* API includes */
+#include "ami_device.h"
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+#define APP_RATE_KEY_LEN	(64)
+#define APP_RATE_ALPHA		(0.3)	/* EWMA weight of the newest sample */
+#define APP_RATE_STR_LEN	(16)
+
+/*****************************************************************************/
+/* Structs                                                                   */
+/*****************************************************************************/
+
+/**
+ * struct app_rate - Smoothed throughput of an operation.
+ * @bytes_per_sec: Exponentially weighted moving average of the throughput.
+ * @samples: Number of measurements folded into `bytes_per_sec`; 0 means
+ *     the value is only a seed and is replaced by the first measurement.
+ */
+struct app_rate {
+	double   bytes_per_sec;
+	uint32_t samples;
+};
+
+/*****************************************************************************/
+/* Public function declarations                                              */
+/*****************************************************************************/
+
+/**
+ * rate_key() - Build the cache key of an operation on a device model.
+ * @dev: Device handle.
+ * @op: Operation name (must not contain whitespace).
+ * @buf: Buffer to hold the key.
+ * @size: Size of `buf`.
+ *
+ * Devices are grouped by PCI vendor and device ID, so the key is the
+ * same for every card of the same model.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int rate_key(ami_device *dev, const char *op, char *buf, size_t size);
+
+/**
+ * rate_load() - Read a stored throughput from the cache file.
+ * @key: Key returned by `rate_key`.
+ * @rate: Variable to hold the stored throughput.
+ *
+ * The cache lives in `$XDG_CACHE_HOME/ami_tool/throughput` (or
+ * `$HOME/.cache/ami_tool/throughput`). `rate` is left untouched if there
+ * is no entry for `key`.
+ *
+ * Return: EXIT_SUCCESS if an entry was found, EXIT_FAILURE otherwise.
+ */
+int rate_load(const char *key, struct app_rate *rate);
+
+/**
+ * rate_store() - Write a throughput to the cache file.
+ * @key: Key returned by `rate_key`.
+ * @rate: Throughput to store.
+ *
+ * Entries for other keys are preserved. The file is replaced atomically.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int rate_store(const char *key, const struct app_rate *rate);
+
+/**
+ * rate_update() - Fold a measurement into a throughput.
+ * @rate: Throughput to update.
+ * @bytes: Number of bytes transferred.
+ * @seconds: Time taken to transfer `bytes`.
+ *
+ * Return: None.
+ */
+void rate_update(struct app_rate *rate, uint64_t bytes, double seconds);
+
+/**
+ * rate_estimate_ms() - Estimate the duration of a transfer.
+ * @rate: Throughput.
+ * @bytes: Number of bytes to transfer.
+ *
+ * Return: Estimated duration in milliseconds (at least 1).
+ */
+uint64_t rate_estimate_ms(const struct app_rate *rate, uint64_t bytes);
+
+/**
+ * rate_format() - Format a throughput for display (e.g., "1.25 MB/s").
+ * @buf: Buffer to hold the string.
+ * @size: Size of `buf`.
+ * @bytes_per_sec: Throughput.
+ *
+ * Return: Number of characters written (as `snprintf`).
+ */
+int rate_format(char *buf, size_t size, double bytes_per_sec);
+
+#endif  /* AMI_APP_THROUGHPUT_H */
@@ -28,6 +28,10 @@
 
 #define AMC_PROXY_MSLEEP_1S		(1000)
 
+/* Service time in the default completion payload, not returned for identify */
+#define AMC_PROXY_SVC_TIME_VALID	BIT(31)
+#define AMC_PROXY_SVC_TIME_MASK		(AMC_PROXY_SVC_TIME_VALID - 1)
+
 
 /*****************************************************************************/
 /* Enums                                                                     */
@@ -45,6 +49,8 @@
  * @AMC_PROXY_CMD_OPCODE_PDI_PROGRAM: pdi program
  * @AMC_PROXY_CMD_OPCODE_SENSOR: sensor request
  * @AMC_PROXY_CMD_OPCODE_PARTITION_COPY: partition copy request
+ * @AMC_PROXY_CMD_OPCODE_PARTITION_DIGEST: partition digest request
+ * @AMC_PROXY_CMD_OPCODE_SVC_STATS: service time statistics request
  * @AMC_PROXY_CMD_OPCODE_IDENTIFY: identity request
  */
 enum amc_proxy_cmd_opcode {
@@ -58,6 +64,8 @@ enum amc_proxy_cmd_opcode {
 	AMC_PROXY_CMD_OPCODE_PDI_PROGRAM       = 0xB,
 	AMC_PROXY_CMD_OPCODE_SENSOR            = 0xC,
 	AMC_PROXY_CMD_OPCODE_PARTITION_COPY    = 0xD,
+	AMC_PROXY_CMD_OPCODE_PARTITION_DIGEST  = 0xE,
+	AMC_PROXY_CMD_OPCODE_SVC_STATS         = 0xF,
 	AMC_PROXY_CMD_OPCODE_IDENTIFY          = 0x202,
 
 	/* Other commands to be added here */
@@ -150,7 +158,7 @@ AP_STATIC_ASSERT(sizeof(struct amc_proxy_cmd_request_hdr) == 8,\
  *
  * @cid:        unique command id
  * @cstate:     command state
- * @specific:   flag indicates there is command specific info in result
+ * @specific:   flag indicates the response data follows inline in the entry extension
  * @state:      flag indicates this is a new entry
  * @header:     Used to convert between data buffer and header structure
  *
@@ -203,6 +211,24 @@ struct com_queue_entry {
 AP_STATIC_ASSERT(sizeof(struct com_queue_entry) == AMC_PROXY_RESPONSE_SIZE,\
 	"com_queue_entry structure no longer is 16 bytes in size");
 
+/**
+ * struct com_queue_entry_ext: completion queue entry with inline data
+ *
+ * @entry: the fixed size completion entry
+ * @data: response data, only valid if `entry.hdr.specific` is set
+ *
+ * When the sGCQ CQ extension is negotiated the device can follow the
+ * completion entry with up to AMC_PROXY_RESPONSE_INLINE_SIZE bytes of
+ * response data, saving a round trip through shared memory.
+ */
+struct com_queue_entry_ext {
+	struct com_queue_entry entry;
+	uint8_t data[AMC_PROXY_RESPONSE_INLINE_SIZE];
+};
+AP_STATIC_ASSERT(sizeof(struct com_queue_entry_ext) ==
+	AMC_PROXY_RESPONSE_SIZE + AMC_PROXY_RESPONSE_INLINE_SIZE,\
+	"com_queue_entry_ext structure has unexpected padding");
+
 /**
  * struct amc_proxy_cmd_req_sensor_payload: sensor_page request command
  *
@@ -213,6 +239,7 @@ AP_STATIC_ASSERT(sizeof(struct com_queue_entry) == AMC_PROXY_RESPONSE_SIZE,\
  * @sid: sensor request id (amc_proxy_cmd_sensor_repo)
  * @addr_type: pre-allocated address type
  * @sensor_id: sensor id values used to get single instantaneous sensor data
+ * @inline_resp: 1 to return the sensor data inline in the completion entry
  * @resvd: reserved for future use
  * @pad: padding for alignment
  *
@@ -226,7 +253,8 @@ struct amc_proxy_cmd_req_sensor_payload {
 	uint32_t sid:8;
 	uint32_t addr_type:3;
 	uint32_t sensor_id:8;
-	uint32_t resvd:5;
+	uint32_t inline_resp:1;
+	uint32_t resvd:4;
 	uint32_t pad;
 };
 
@@ -281,6 +309,7 @@ struct amc_proxy_cmd_data_payload {
  * @req_type: the request type, read or write
  * @len: the number of bytes to read/write
  * @offset: the offset into the eeprom address space
+ * @inline_resp: 1 to return read data inline in the completion entry
  * @resvd: reserved for future use
  */
 struct amc_proxy_cmd_eeprom_payload {
@@ -288,7 +317,8 @@ struct amc_proxy_cmd_eeprom_payload {
 	uint32_t req_type:1;
 	uint32_t len:8;
 	uint32_t offset:8;
-	uint32_t resvd:15;
+	uint32_t inline_resp:1;
+	uint32_t resvd:14;
 };
 
 /**
@@ -300,6 +330,7 @@ struct amc_proxy_cmd_eeprom_payload {
  * @offset: offset within page to read/write
  * @len: number of bytes to read/write
  * @req_type: the request type, read or write
+ * @inline_resp: 1 to return read data inline in the completion entry
  * @resvd: reserved for future use
  */
 struct amc_proxy_cmd_module_payload {
@@ -309,7 +340,8 @@ struct amc_proxy_cmd_module_payload {
 	uint8_t  offset;
 	uint8_t  len;
 	uint32_t req_type:1;
-	uint32_t resvd:31;
+	uint32_t inline_resp:1;
+	uint32_t resvd:30;
 };
 
 /**
@@ -346,6 +378,38 @@ struct amc_proxy_cmd_heartbeat_payload {
 	uint32_t flags;              /* Flags value (for write) */
 };
 
+/**
+ * struct amc_proxy_cmd_digest_payload: partition digest request payload command
+ *
+ * @address: address in shared memory to write the MD5 digest to
+ * @boot_device: the boot device, primary or secondary
+ * @partition: the partition index
+ * @length: the number of bytes to digest from the start of the partition
+ * @resvd: reserved for future use
+ */
+struct amc_proxy_cmd_digest_payload {
+	uint64_t address;
+	uint32_t boot_device;
+	uint32_t partition;
+	uint32_t length;
+	uint32_t resvd;
+};
+
+/**
+ * struct amc_proxy_cmd_svc_stats_payload: service stats request payload command
+ *
+ * @opcode: the opcode to return the service time of
+ * @clear: 1 to clear the opcode's service time once read
+ * @inline_resp: must be 1, the stats are only returned inline
+ * @resvd: reserved for future use
+ */
+struct amc_proxy_cmd_svc_stats_payload {
+	uint32_t opcode:16;
+	uint32_t clear:1;
+	uint32_t inline_resp:1;
+	uint32_t resvd:14;
+};
+
 /**
  * struct amc_proxy_cmd_request: request command, header & payload (if applicable)
  *
@@ -357,6 +421,8 @@ struct amc_proxy_cmd_heartbeat_payload {
  * @module_payload: the module read/write request payload
  * @debug_verbosity_payload: the debug verbosity request payload
  * @fpt_partition_payload: the FPT partition request payload
+ * @digest_payload: the partition digest request payload
+ * @svc_stats_payload: the service stats request payload
  */
 struct amc_proxy_cmd_request {
 	struct amc_proxy_cmd_request_hdr hdr;
@@ -368,6 +434,8 @@ struct amc_proxy_cmd_request {
 		struct amc_proxy_cmd_module_payload module_payload;
 		uint8_t debug_verbosity_payload;
 		struct amc_proxy_cmd_fpt_partition_payload fpt_partition_payload;
+		struct amc_proxy_cmd_digest_payload digest_payload;
+		struct amc_proxy_cmd_svc_stats_payload svc_stats_payload;
 	};
 };
 
@@ -375,11 +443,11 @@ struct amc_proxy_cmd_request {
  * struct amc_proxy_cmd_resp_default_payload: default completion payload
  *
  * @resvd0: reserved
- * @resvd1: reserved
+ * @svc_time: firmware service time in ms, valid if AMC_PROXY_SVC_TIME_VALID is set
  */
 struct amc_proxy_cmd_resp_default_payload {
 	uint32_t resvd0;
-	uint32_t resvd1;
+	uint32_t svc_time;
 };
 
 /**
@@ -568,12 +636,14 @@ static int amc_result_to_linux_errno(enum amc_proxy_result res)
 /**
  * cmd_complete() - handle the completion command response
  * @ccmd: the completion command
+ * @ccmd_size: size of the completion command, including any inline data
  * @inst: the proxy instance
  *
  * Find the matching cmd from submitted_cmd list using the cid
  * remove it and then invoke registered dcallback
  */
-static void cmd_complete(struct amc_proxy_instance *inst, struct com_queue_entry *ccmd)
+static void cmd_complete(struct amc_proxy_instance *inst, struct com_queue_entry *ccmd,
+	uint32_t ccmd_size)
 {
 	struct amc_proxy_cmd_struct *cmd = NULL;
 	struct list_head *pos = NULL, *next = NULL;
@@ -597,6 +667,17 @@ static void cmd_complete(struct amc_proxy_instance *inst, struct com_queue_entry
 
 			cmd->cmd_response_code = cmd_resp->ret;
 
+			/* Inline data is only ever sent if the request asked for it */
+			if (ccmd->hdr.specific && cmd->cmd_inline_buf &&
+				(ccmd_size > sizeof(struct com_queue_entry))) {
+				struct com_queue_entry_ext *ccmd_ext =
+					(struct com_queue_entry_ext *)ccmd;
+
+				cmd->cmd_inline_len = min_t(uint32_t, cmd->cmd_inline_size,
+					ccmd_size - sizeof(struct com_queue_entry));
+				memcpy(cmd->cmd_inline_buf, ccmd_ext->data, cmd->cmd_inline_len);
+			}
+
 			/* Suppress hearbeat message so as not to flood dmesg */
 			if (cmd->cmd_suppress_dbg == false) {
 					PR_DBG(
@@ -763,8 +844,8 @@ static void submitted_cmd_check_timeout(struct amc_proxy_instance *inst)
  */
 static int complete_response_thread(void *data)
 {
-	struct com_queue_entry ccmd;
-	uint32_t ccmd_size = sizeof(struct com_queue_entry);
+	struct com_queue_entry_ext ccmd;
+	uint32_t ccmd_size = 0;
 	struct amc_proxy_instance *amc_proxy_inst = NULL;
 	bool response_failed = false;
 
@@ -778,6 +859,11 @@ static int complete_response_thread(void *data)
 	while (1) {
 		if (response_failed == false) {
 
+			/* Room for inline data only if the CQ extension was negotiated */
+			ccmd_size = sizeof(struct com_queue_entry);
+			if (amc_proxy_inst->gcq_handle->ulCQExtSize)
+				ccmd_size = sizeof(struct com_queue_entry_ext);
+
 			/* Perform the read from the gcq_handle */
 			if (gcq_read(amc_proxy_inst->gcq_handle,
 				(uint8_t*)&ccmd,
@@ -786,7 +872,7 @@ static int complete_response_thread(void *data)
 				* Get the entry from submitted_cmds list,
 				* remove and invoke callback
 				*/
-				cmd_complete(amc_proxy_inst, &ccmd);
+				cmd_complete(amc_proxy_inst, &ccmd.entry, ccmd_size);
 			}
 
 			/* Check for any commands that might have timed out & notify via callback */
@@ -929,6 +1015,17 @@ int amc_proxy_bind_callback(GCQCfg *gcq_handle, amc_proxy_event_callback *event_
 	return ret;
 }
 
+/*
+ * Get the largest response which can be carried inline
+ */
+uint32_t amc_proxy_inline_size(const GCQCfg *gcq_handle)
+{
+	if (!gcq_handle || (gcq_handle->ulCQExtSize < AMC_PROXY_RESPONSE_EXT_SIZE))
+		return 0;
+
+	return AMC_PROXY_RESPONSE_INLINE_SIZE;
+}
+
 /*
  * Close the AMC proxy layer, free any resources used and close
  * the gcq handle
@@ -1070,6 +1167,7 @@ int amc_proxy_request_sensor(struct amc_proxy_cmd_struct *cmd,
 		request_cmd_entry.sensor_payload.offset = 0;
 		request_cmd_entry.sensor_payload.addr_type = 0;
 		request_cmd_entry.sensor_payload.sensor_id = sensor_req->sensor_id;
+		request_cmd_entry.sensor_payload.inline_resp = (cmd->cmd_inline_buf != NULL);
 
 		ret = gcq_write(amc_ctxt->inst.gcq_handle,
 				(uint8_t*)&request_cmd_entry,
@@ -1236,6 +1334,93 @@ int amc_proxy_request_partition_copy(struct amc_proxy_cmd_struct *cmd,
 	return ret;
 }
 
+/*
+ * Generate a partition digest request
+ */
+int amc_proxy_request_partition_digest(struct amc_proxy_cmd_struct *cmd,
+				struct amc_proxy_partition_digest_request *partition_digest)
+{
+	struct amc_proxy_list_entry *amc_ctxt = NULL;
+	int ret = -EPERM;
+
+	if (!cmd || !partition_digest) {
+		return -EINVAL;
+	}
+
+	amc_ctxt = find_matching_gcq_proxy_instance(cmd->cmd_gcq_cfg);
+	if (amc_ctxt && amc_ctxt->inst.initialised) {
+
+		struct amc_proxy_cmd_request request_cmd_entry = {{{{0}}}};
+		struct amc_proxy_cmd_request_hdr *request_hdr = NULL;
+		request_hdr = &request_cmd_entry.hdr;
+		request_hdr->state = AMC_PROXY_REQUEST_CMD_NEW;
+		request_hdr->opcode = AMC_PROXY_CMD_OPCODE_PARTITION_DIGEST;
+		request_hdr->count = sizeof(request_cmd_entry.digest_payload);
+		request_hdr->cid = cmd->cmd_cid;
+
+		request_cmd_entry.digest_payload.address = partition_digest->address;
+		request_cmd_entry.digest_payload.boot_device = partition_digest->boot_device;
+		request_cmd_entry.digest_payload.partition = partition_digest->partition;
+		request_cmd_entry.digest_payload.length = partition_digest->length;
+
+		ret = gcq_write(amc_ctxt->inst.gcq_handle,
+				(uint8_t*)&request_cmd_entry,
+				sizeof(request_cmd_entry), 0);
+		if (ret == GCQ_ERRORS_NONE) {
+			mutex_lock(&amc_ctxt->inst.lock);
+			list_add_tail(&cmd->cmd_list, &amc_ctxt->inst.submitted_cmds);
+			mutex_unlock(&amc_ctxt->inst.lock);
+		} else {
+			PR_ERR("write request failed; %d", ret);
+			ret = -EIO;
+		}
+	}
+	return ret;
+}
+
+/*
+ * Generate a service stats request
+ */
+int amc_proxy_request_svc_stats(struct amc_proxy_cmd_struct *cmd,
+				struct amc_proxy_svc_stats_request *svc_stats)
+{
+	struct amc_proxy_list_entry *amc_ctxt = NULL;
+	int ret = -EPERM;
+
+	if (!cmd || !svc_stats || !cmd->cmd_inline_buf) {
+		return -EINVAL;
+	}
+
+	amc_ctxt = find_matching_gcq_proxy_instance(cmd->cmd_gcq_cfg);
+	if (amc_ctxt && amc_ctxt->inst.initialised) {
+
+		struct amc_proxy_cmd_request request_cmd_entry = {{{{0}}}};
+		struct amc_proxy_cmd_request_hdr *request_hdr = NULL;
+		request_hdr = &request_cmd_entry.hdr;
+		request_hdr->state = AMC_PROXY_REQUEST_CMD_NEW;
+		request_hdr->opcode = AMC_PROXY_CMD_OPCODE_SVC_STATS;
+		request_hdr->count = sizeof(request_cmd_entry.svc_stats_payload);
+		request_hdr->cid = cmd->cmd_cid;
+
+		request_cmd_entry.svc_stats_payload.opcode = svc_stats->opcode;
+		request_cmd_entry.svc_stats_payload.clear = svc_stats->clear;
+		request_cmd_entry.svc_stats_payload.inline_resp = 1;
+
+		ret = gcq_write(amc_ctxt->inst.gcq_handle,
+				(uint8_t*)&request_cmd_entry,
+				sizeof(request_cmd_entry), 0);
+		if (ret == GCQ_ERRORS_NONE) {
+			mutex_lock(&amc_ctxt->inst.lock);
+			list_add_tail(&cmd->cmd_list, &amc_ctxt->inst.submitted_cmds);
+			mutex_unlock(&amc_ctxt->inst.lock);
+		} else {
+			PR_ERR("write request failed; %d", ret);
+			ret = -EIO;
+		}
+	}
+	return ret;
+}
+
 /*
  * Generate heartbeat request
  */
@@ -1304,6 +1489,7 @@ int amc_proxy_request_eeprom_read_write(struct amc_proxy_cmd_struct *cmd,
 		request_cmd_entry.eeprom_payload.address = eeprom_rw->address;
 		request_cmd_entry.eeprom_payload.len= eeprom_rw->length;
 		request_cmd_entry.eeprom_payload.offset = eeprom_rw->offset;
+		request_cmd_entry.eeprom_payload.inline_resp = (cmd->cmd_inline_buf != NULL);
 		ret = gcq_write(amc_ctxt->inst.gcq_handle,
 				(uint8_t*)&request_cmd_entry,
 				sizeof(request_cmd_entry), 0);
@@ -1348,6 +1534,7 @@ int amc_proxy_request_module_read_write(struct amc_proxy_cmd_struct *cmd,
 		request_cmd_entry.module_payload.offset = module_rw->offset;
 		request_cmd_entry.module_payload.len = module_rw->length;
 		request_cmd_entry.module_payload.req_type = module_rw->type;
+		request_cmd_entry.module_payload.inline_resp = (cmd->cmd_inline_buf != NULL);
 		ret = gcq_write(amc_ctxt->inst.gcq_handle,
 				(uint8_t*)&request_cmd_entry,
 				sizeof(request_cmd_entry), 0);
@@ -1593,6 +1780,67 @@ int amc_proxy_get_response_partition_copy(struct amc_proxy_cmd_struct *cmd)
 	return ret;
 }
 
+/*
+ * Read back the partition digest response
+ */
+int amc_proxy_get_response_partition_digest(struct amc_proxy_cmd_struct *cmd)
+{
+	struct amc_proxy_list_entry *amc_ctxt = NULL;
+	int ret = -EPERM;
+
+	if (!cmd) {
+		return -EINVAL;
+	}
+
+	amc_ctxt = find_matching_gcq_proxy_instance(cmd->cmd_gcq_cfg);
+	if (amc_ctxt && amc_ctxt->inst.initialised)
+		ret = amc_result_to_linux_errno(cmd->cmd_response_code);
+
+	return ret;
+}
+
+/*
+ * Read back the service stats response
+ */
+int amc_proxy_get_response_svc_stats(struct amc_proxy_cmd_struct *cmd)
+{
+	struct amc_proxy_list_entry *amc_ctxt = NULL;
+	int ret = -EPERM;
+
+	if (!cmd) {
+		return -EINVAL;
+	}
+
+	amc_ctxt = find_matching_gcq_proxy_instance(cmd->cmd_gcq_cfg);
+	if (amc_ctxt && amc_ctxt->inst.initialised) {
+		ret = amc_result_to_linux_errno(cmd->cmd_response_code);
+		if (!ret && (cmd->cmd_inline_len < sizeof(struct amc_proxy_svc_time)))
+			ret = -EIO;
+	}
+
+	return ret;
+}
+
+/*
+ * Read back the firmware service time of a completed command
+ */
+int amc_proxy_get_response_service_time(struct amc_proxy_cmd_struct *cmd,
+				uint32_t *service_ms)
+{
+	struct amc_proxy_cmd_resp_default_payload *default_payload = NULL;
+
+	if (!cmd || !service_ms) {
+		return -EINVAL;
+	}
+
+	default_payload = (struct amc_proxy_cmd_resp_default_payload *)&cmd->cmd_response;
+	if (!(default_payload->svc_time & AMC_PROXY_SVC_TIME_VALID))
+		return -ENODATA;
+
+	*service_ms = default_payload->svc_time & AMC_PROXY_SVC_TIME_MASK;
+	return 0;
+}
+
 /*
  * Read back the heartbeat response
  */
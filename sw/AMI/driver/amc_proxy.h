@@ -19,6 +19,10 @@
 /*****************************************************************************/
 #define AMC_PROXY_REQUEST_SIZE		(512)
 #define AMC_PROXY_RESPONSE_SIZE		(16)
+#define AMC_PROXY_RESPONSE_EXT_SIZE	(240)
+#define AMC_PROXY_RESPONSE_INLINE_SIZE	(AMC_PROXY_RESPONSE_EXT_SIZE - sizeof(uint32_t))
+
+#define AMC_PROXY_SVC_TIME_BUCKETS	(12)
 
 
 /*****************************************************************************/
@@ -181,6 +185,53 @@ struct amc_proxy_partition_copy_request {
 	uint64_t address;
 };
 
+/**
+ * struct amc_proxy_partition_digest_request: the partition digest request data
+ *
+ * @boot_device: the boot device, primary or secondary
+ * @partition: the partition index
+ * @length: the number of bytes to digest from the start of the partition
+ * @address: start offset of PCI memory the digest is written to
+ */
+struct amc_proxy_partition_digest_request {
+	uint32_t boot_device;
+	uint32_t partition;
+	uint32_t length;
+	uint64_t address;
+};
+
+/**
+ * struct amc_proxy_svc_stats_request: the service stats request data
+ *
+ * @opcode: the opcode to return the service time of
+ * @clear: true to clear the opcode's service time once read
+ */
+struct amc_proxy_svc_stats_request {
+	uint16_t opcode;
+	bool clear;
+};
+
+/**
+ * struct amc_proxy_svc_time: firmware service time of one opcode
+ *
+ * Returned inline by the service stats request. Bucket 0 of the histogram
+ * counts requests served within 1ms, bucket n those taking [2^(n-1), 2^n) ms
+ * and the last bucket everything slower.
+ *
+ * @count: number of requests served
+ * @min_ms: fastest service time
+ * @max_ms: slowest service time
+ * @total_ms: sum of all service times
+ * @histogram: log2 histogram of service times
+ */
+struct amc_proxy_svc_time {
+	uint32_t count;
+	uint32_t min_ms;
+	uint32_t max_ms;
+	uint32_t total_ms;
+	uint32_t histogram[AMC_PROXY_SVC_TIME_BUCKETS];
+};
+
 /**
  * struct amc_proxy_hearbeat_request: the heartbeat request data
  *
@@ -295,6 +346,9 @@ struct amc_proxy_heartbeat_response {
  * @cmd_suppress_dbg: flag to indicate debug suppressed for command
  * @cmd_opcode: opcode associated with the command
  * @timed_out: boolean indicating if this command timed out
+ * @cmd_inline_buf: buffer for a response carried inline, NULL to use shared memory
+ * @cmd_inline_size: size of `cmd_inline_buf`
+ * @cmd_inline_len: number of bytes received in `cmd_inline_buf`
  */
 struct amc_proxy_cmd_struct {
 	struct list_head	cmd_list;
@@ -310,6 +364,9 @@ struct amc_proxy_cmd_struct {
 	bool			cmd_suppress_dbg;
 	uint32_t		cmd_opcode;
 	bool			timed_out;
+	uint8_t			*cmd_inline_buf;
+	uint32_t		cmd_inline_size;
+	uint32_t		cmd_inline_len;
 };
 
 
@@ -346,6 +403,19 @@ int amc_proxy_bind_callback(GCQCfg *gcq_handle, amc_proxy_event_callback *event_
  */
 int amc_proxy_close(const GCQCfg *gcq_handle);
 
+/**
+ * amc_proxy_inline_size() - Get the largest response which can be carried inline
+ *
+ * @gcq_handle: handle to the fw interface
+ *
+ * Sensor, eeprom read and module read responses up to this size can be
+ * returned in the completion entry instead of shared memory, by setting
+ * `cmd_inline_buf` before the request is made.
+ *
+ * Return: The size in bytes, 0 if the CQ extension was not negotiated
+ */
+uint32_t amc_proxy_inline_size(const GCQCfg *gcq_handle);
+
 /**
  * amc_proxy_request_abort() - Abort a request already in progress
  *
@@ -412,6 +482,28 @@ int amc_proxy_request_device_boot(struct amc_proxy_cmd_struct *cmd,
 int amc_proxy_request_partition_copy(struct amc_proxy_cmd_struct *cmd,
 	struct amc_proxy_partition_copy_request *partition_copy);
 
+/**
+ * amc_proxy_request_partition_digest() - Digest a partition range
+ *
+ * @cmd: the proxy command structure
+ * @partition_digest: a structure populated with the partition digest request
+ *
+ * Return: The errno return code
+ */
+int amc_proxy_request_partition_digest(struct amc_proxy_cmd_struct *cmd,
+	struct amc_proxy_partition_digest_request *partition_digest);
+
+/**
+ * amc_proxy_request_svc_stats() - Read the firmware service time of an opcode
+ *
+ * @cmd: the proxy command structure, `cmd_inline_buf` must be set
+ * @svc_stats: a structure populated with the service stats request
+ *
+ * Return: The errno return code
+ */
+int amc_proxy_request_svc_stats(struct amc_proxy_cmd_struct *cmd,
+	struct amc_proxy_svc_stats_request *svc_stats);
+
 /**
  * amc_proxy_request_heartbeat() - heartbeat request
  *
@@ -530,6 +622,39 @@ int amc_proxy_get_response_device_boot(struct amc_proxy_cmd_struct *cmd);
  */
 int amc_proxy_get_response_partition_copy(struct amc_proxy_cmd_struct *cmd);
 
+/**
+ * amc_proxy_get_response_partition_digest() - retrieve the partition digest response
+ *
+ * @cmd: the proxy command structure
+ *
+ * Return: The errno return code
+ */
+int amc_proxy_get_response_partition_digest(struct amc_proxy_cmd_struct *cmd);
+
+/**
+ * amc_proxy_get_response_svc_stats() - retrieve the service stats response
+ *
+ * @cmd: the proxy command structure
+ *
+ * The `struct amc_proxy_svc_time` is returned in `cmd_inline_buf`.
+ *
+ * Return: The errno return code
+ */
+int amc_proxy_get_response_svc_stats(struct amc_proxy_cmd_struct *cmd);
+
+/**
+ * amc_proxy_get_response_service_time() - retrieve the firmware service time
+ *
+ * @cmd: the proxy command structure of a completed command
+ * @service_ms: the time AMC took to serve the command, in ms
+ *
+ * Not valid for identify, which uses the whole completion payload.
+ *
+ * Return: The errno return code, -ENODATA if AMC did not report a time
+ */
+int amc_proxy_get_response_service_time(struct amc_proxy_cmd_struct *cmd,
+	uint32_t *service_ms);
+
 /**
  * amc_proxy_get_response_heartbeat() - retrieve the heartbeat response
  *
@@ -9,6 +9,7 @@
 #include <linux/delay.h>
 #include <linux/device.h>
 #include <linux/types.h>
+#include <linux/ktime.h>
 
 #include "ami_gcq.h"
 #include "ami_top.h"
@@ -50,6 +51,14 @@ static DEFINE_XARRAY_ALLOC(cid_xarray);
 #define AMC_GCQ_MAGIC_NO                (0x564D5230)
 #define VERSION_BUF_SIZE                (8)
 
+/*
+ * sGCQ completion coalescing - max completions per update and max hold time.
+ * Off by default: the firmware only starts the hold timer on its next pass,
+ * so an isolated request would always pay the delay.
+ */
+#define AMC_GCQ_COALESCE_COUNT          (0)
+#define AMC_GCQ_COALESCE_DELAY_MS       (1)
+
 /* Number of permitted failures before raising a fatal event */
 #define HEARTBEAT_FAIL_THRESHOLD        (3)
 
@@ -530,8 +539,14 @@ static int acquire_gcq_log_page_sema(struct amc_control_ctxt *amc_ctrl_ctxt, uin
 		return -EIO;
 	}
 
-	*addr = get_gcq_log_page_addr(amc_ctrl_ctxt);
-	*len = AMC_LOG_PAGE_SIZE;
+	/* Keep sensor data with its sGCQ instance when there is one */
+	if (amc_ctrl_ctxt->telemetry_enabled) {
+		*addr = amc_ctrl_ctxt->amc_shared_mem.telemetry.data_off;
+		*len = amc_ctrl_ctxt->amc_shared_mem.telemetry.data_len;
+	} else {
+		*addr = get_gcq_log_page_addr(amc_ctrl_ctxt);
+		*len = AMC_LOG_PAGE_SIZE;
+	}
 
 	return SUCCESS;
 }
@@ -548,6 +563,34 @@ static void release_amc_log_page_sema(struct amc_control_ctxt *amc_ctrl_ctxt)
 		up(&(amc_ctrl_ctxt->gcq_log_page_sema));
 }
 
+/**
+ * get_cmd_gcq_cfg() - Get the sGCQ instance a command is sent on.
+ * @amc_ctrl_ctxt: AMC data struct instance.
+ * @cmd_id: The command ID.
+ *
+ * Sensor, heartbeat, debug verbosity and service stats requests use the
+ * telemetry instance when the AMC provides one, so they are never queued
+ * behind PDI, flash and EEPROM requests.
+ *
+ * Return: The sGCQ instance.
+ */
+static GCQCfg *get_cmd_gcq_cfg(struct amc_control_ctxt *amc_ctrl_ctxt, enum amc_cmd_id cmd_id)
+{
+	if (!amc_ctrl_ctxt->telemetry_enabled)
+		return &amc_ctrl_ctxt->gcq_consumer;
+
+	switch (cmd_id) {
+	case AMC_CMD_ID_SENSOR:
+	case AMC_CMD_ID_HEARTBEAT:
+	case AMC_CMD_ID_DEBUG_VERBOSITY:
+	case AMC_CMD_ID_SVC_STATS:
+		return &amc_ctrl_ctxt->gcq_telemetry;
+
+	default:
+		return &amc_ctrl_ctxt->gcq_consumer;
+	}
+}
+
 /**
  * amc_shared_mem_size() - Get the size of AMC shared memory.
  * @amc_ctrl_ctxt: AMC data struct instance.
@@ -693,6 +736,37 @@ static void memcpy_gcq_payload_to_device(struct amc_control_ctxt	*amc_ctrl_ctxt,
 	);
 }
 
+/**
+ * copy_read_response() - copy read data back from the device.
+ * @amc_ctrl_ctxt: AMC data struct instance.
+ * @cmd: the completed proxy command.
+ * @offset: the shared memory offset, if the data was not returned inline.
+ * @dst: the destination address.
+ * @len: the length.
+ *
+ * Return: 0 or negative error code.
+ */
+static int copy_read_response(struct amc_control_ctxt		*amc_ctrl_ctxt,
+			      struct amc_proxy_cmd_struct	*cmd,
+			      uint32_t				offset,
+			      void				*dst,
+			      size_t				len)
+{
+	if (!cmd->cmd_inline_buf) {
+		memcpy_gcq_payload_from_device(amc_ctrl_ctxt, offset, dst, len);
+		return SUCCESS;
+	}
+
+	/* The data was copied to `dst` when the response arrived */
+	if (cmd->cmd_inline_len < len) {
+		AMI_ERR(amc_ctrl_ctxt, "Short inline response, %d of %zu bytes",
+			cmd->cmd_inline_len, len);
+		return -EIO;
+	}
+
+	return SUCCESS;
+}
+
 /**
  * get_gcq_version() - get the sGCQ version.
  * @amc_ctrl_ctxt: AMC data struct instance.
@@ -822,6 +896,14 @@ static enum amc_cmd_id get_cmd_command_id(enum gcq_submit_cmd_req cmd_req)
 			id = AMC_CMD_ID_SET_FPT_PARTITION;
 			break;
 
+		case GCQ_SUBMIT_CMD_GET_PARTITION_DIGEST:
+			id = AMC_CMD_ID_PARTITION_DIGEST;
+			break;
+
+		case GCQ_SUBMIT_CMD_GET_SVC_STATS:
+			id = AMC_CMD_ID_SVC_STATS;
+			break;
+
 		case GCQ_SUBMIT_CMD_GET_INLET_TEMP_SENSOR:
 		case GCQ_SUBMIT_CMD_GET_OUTLET_TEMP_SENSOR:
 		case GCQ_SUBMIT_CMD_GET_BOARD_TEMP_SENSOR:
@@ -949,6 +1031,75 @@ static int map_amc_endpoints(struct pci_dev		*dev,
 	return ret;
 }
 
+/**
+ * setup_telemetry_channel() - open the sGCQ instance for telemetry requests.
+ * @amc_ctrl_ctxt: AMC data struct instance.
+ *
+ * The AMC only publishes the instance in the partition table once it is
+ * serving it, an AMC without one (or a bad entry) leaves every request
+ * on the first instance.
+ *
+ * Return: None.
+ */
+static void setup_telemetry_channel(struct amc_control_ctxt *amc_ctrl_ctxt)
+{
+	struct amc_channel *telemetry = NULL;
+	int ret = 0;
+
+	if (!amc_ctrl_ctxt)
+		return;
+
+	telemetry = &amc_ctrl_ctxt->amc_shared_mem.telemetry;
+	memcpy_fromio(telemetry,
+		      amc_ctrl_ctxt->gcq_payload_base_virt_addr +
+		      offsetof(struct amc_shared_mem, telemetry),
+		      sizeof(struct amc_channel));
+
+	if (!telemetry->ring_buf_len) {
+		AMI_VDBG(amc_ctrl_ctxt, "No telemetry sGCQ instance");
+		return;
+	}
+
+	if (!telemetry->gcq_off || (telemetry->gcq_off >= XILINX_SGCQ_SIZE_BYTES) ||
+	    (((u64)telemetry->ring_buf_off + telemetry->ring_buf_len) >
+	     amc_ctrl_ctxt->amc_shared_mem.data.amc_data_end) ||
+	    (((u64)telemetry->data_off + telemetry->data_len) >
+	     amc_shared_mem_size(amc_ctrl_ctxt)) ||
+	    (telemetry->data_len < SENSOR_RSP_LEN)) {
+		AMI_WARN(amc_ctrl_ctxt, "Invalid telemetry sGCQ instance, not used");
+		return;
+	}
+
+	amc_ctrl_ctxt->gcq_telemetry.ullBaseAddr  =
+		(uint64_t)(amc_ctrl_ctxt->gcq_base_virt_addr + telemetry->gcq_off);
+	amc_ctrl_ctxt->gcq_telemetry.ullRingAddr  =
+		(uint64_t)(amc_ctrl_ctxt->gcq_payload_base_virt_addr + telemetry->ring_buf_off);
+	amc_ctrl_ctxt->gcq_telemetry.ulRingLength = telemetry->ring_buf_len;
+	amc_ctrl_ctxt->gcq_telemetry.ulSQSlotSize = AMC_PROXY_REQUEST_SIZE;
+	amc_ctrl_ctxt->gcq_telemetry.ulCQSlotSize = AMC_PROXY_RESPONSE_SIZE;
+	amc_ctrl_ctxt->gcq_telemetry.ulCoalesceCount   = AMC_GCQ_COALESCE_COUNT;
+	amc_ctrl_ctxt->gcq_telemetry.ulCoalesceDelayMs = AMC_GCQ_COALESCE_DELAY_MS;
+	amc_ctrl_ctxt->gcq_telemetry.ulCQExtSize  = AMC_PROXY_RESPONSE_EXT_SIZE;
+
+	ret = amc_proxy_init(1, &amc_ctrl_ctxt->gcq_telemetry);
+	if (ret) {
+		AMI_WARN(amc_ctrl_ctxt, "Telemetry sGCQ instance not opened %d", ret);
+		return;
+	}
+
+	ret = amc_proxy_bind_callback(&amc_ctrl_ctxt->gcq_telemetry, amc_proxy_callback);
+	if (ret) {
+		AMI_WARN(amc_ctrl_ctxt, "Telemetry sGCQ callback not bound %d", ret);
+		amc_proxy_close(&amc_ctrl_ctxt->gcq_telemetry);
+		return;
+	}
+
+	amc_ctrl_ctxt->telemetry_enabled = true;
+	AMI_VDBG(amc_ctrl_ctxt,
+		 "Telemetry sGCQ instance at 0x%x, ring 0x%x, data 0x%x",
+		 telemetry->gcq_off, telemetry->ring_buf_off, telemetry->data_off);
+}
+
 /**
  * unmap_pci_io() - unmap the PCI IO.
  * @dev: the device.
@@ -1239,6 +1390,9 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 	uint64_t payload_address = 0;
 	uint16_t cid = 0;
 	struct completion *req_complete = NULL;
+	ktime_t submit_time = 0;
+	uint32_t service_ms = 0;
+	GCQCfg *gcq_cfg = NULL;
 
 	/* data_buf is required only for some commands */
 	if (!amc_ctrl_ctxt)
@@ -1258,6 +1412,8 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 		goto done;
 	}
 
+	gcq_cfg = get_cmd_gcq_cfg(amc_ctrl_ctxt, cmd_id);
+
 	if (cmd_id != AMC_CMD_ID_HEARTBEAT)
 		AMI_DBG(amc_ctrl_ctxt, "Submitting command [%d] with resp len %d", cmd_id, data_size);
 
@@ -1291,6 +1447,29 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 			}
 			break;
 
+		case AMC_CMD_ID_PARTITION_DIGEST:
+			if (!data_buf || (data_size < sizeof(struct ami_ioc_partition_digest_value))) {
+				AMI_ERR(amc_ctrl_ctxt, "Invalid partition digest data");
+				ret = -EINVAL;
+				goto done;
+			}
+			break;
+
+		case AMC_CMD_ID_SVC_STATS:
+			if (!data_buf || (data_size < sizeof(struct amc_proxy_svc_time))) {
+				AMI_ERR(amc_ctrl_ctxt, "Invalid service stats data");
+				ret = -EINVAL;
+				goto done;
+			}
+
+			/* The stats are only returned inline */
+			if (amc_proxy_inline_size(gcq_cfg) <
+					sizeof(struct amc_proxy_svc_time)) {
+				ret = -EOPNOTSUPP;
+				goto done;
+			}
+			break;
+
 		/* data_buf not required */
 		case AMC_CMD_ID_DEVICE_BOOT:
 		case AMC_CMD_ID_DEBUG_VERBOSITY:
@@ -1393,6 +1572,13 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 				payload_size = length;
 			}
 
+			/* Small responses come back inline, larger ones still use the log page */
+			if (amc_proxy_inline_size(gcq_cfg)) {
+				amc_proxy_cmd->cmd_inline_buf = data_buf;
+				amc_proxy_cmd->cmd_inline_size = min_t(uint32_t, data_size,
+					amc_proxy_inline_size(gcq_cfg));
+			}
+
 			/* Sensor request ID */
 			sid = get_sid(cmd_req, flags);
 			if (sid == AMC_PROXY_CMD_SENSOR_REPO_UNKNOWN) {
@@ -1443,11 +1629,52 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 		}
 		break;
 
+		case AMC_CMD_ID_PARTITION_DIGEST:
+			/*
+			* The digest is written by AMC into the shared memory, the
+			* response payload is too small to hold it.
+			*/
+			if (acquire_gcq_data(amc_ctrl_ctxt, (uint32_t *)&(payload_address), &length)) {
+				ret = -EIO;
+				goto done;
+			}
+
+			data_page_acquired = true;
+			payload_size = MD5_SIZE;
+			break;
+
+		case AMC_CMD_ID_SVC_STATS:
+			amc_proxy_cmd->cmd_inline_buf = data_buf;
+			amc_proxy_cmd->cmd_inline_size = sizeof(struct amc_proxy_svc_time);
+			break;
+
 		case AMC_CMD_ID_EEPROM_READ_WRITE:
 		case AMC_CMD_ID_MODULE_READ_WRITE:
 		{
 			int req_type = MAX_AMC_PROXY_CMD_RW_REQUEST;
 
+			switch (cmd_id) {
+			case AMC_CMD_ID_EEPROM_READ_WRITE:
+				req_type = EEPROM_GET_TYPE(flags);
+				break;
+
+			case AMC_CMD_ID_MODULE_READ_WRITE:
+				req_type = MODULE_RW_TYPE(flags);
+				break;
+
+			default:
+				break;
+			}
+
+			/* Reads which fit in the completion entry don't need the data page */
+			if ((req_type == AMC_PROXY_CMD_RW_REQUEST_READ) && data_size &&
+				(data_size <= amc_proxy_inline_size(gcq_cfg))) {
+				amc_proxy_cmd->cmd_inline_buf = data_buf;
+				amc_proxy_cmd->cmd_inline_size = data_size;
+				payload_size = data_size;
+				break;
+			}
+
 			if (acquire_gcq_data(amc_ctrl_ctxt, (uint32_t *)&(payload_address), &length)) {
 				ret = -EIO;
 				goto done;
@@ -1469,19 +1696,6 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 			}
 
 			/* Check if we need to copy the payload data */
-			switch (cmd_id) {
-			case AMC_CMD_ID_EEPROM_READ_WRITE:
-				req_type = EEPROM_GET_TYPE(flags);
-				break;
-
-			case AMC_CMD_ID_MODULE_READ_WRITE:
-				req_type = MODULE_RW_TYPE(flags);
-				break;
-
-			default:
-				break;
-			}
-
 			if (req_type == AMC_PROXY_CMD_RW_REQUEST_WRITE)
 				/* Copy payload data to address */
 				memcpy_gcq_payload_to_device(amc_ctrl_ctxt, payload_address, data_buf, data_size);
@@ -1510,11 +1724,13 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 	/* Set timeout in ms */
 	amc_proxy_cmd->cmd_timeout_jiffies = jiffies + REQUEST_MSQ_TIMEOUT;
 	amc_proxy_cmd->cmd_arg = amc_ctrl_ctxt;
-	amc_proxy_cmd->cmd_gcq_cfg = &amc_ctrl_ctxt->gcq_consumer;
+	amc_proxy_cmd->cmd_gcq_cfg = gcq_cfg;
 	amc_proxy_cmd->cmd_rcode = 0;
 	amc_proxy_cmd->cmd_suppress_dbg = false;
 	amc_proxy_cmd->cmd_opcode = cmd_id;
 
+	submit_time = ktime_get();
+
 	/* Multiple thread now generating gcq command requests, protect concurrent access */
 	mutex_lock(&amc_ctrl_ctxt->gcq_cmd_lock);
 
@@ -1664,6 +1880,32 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 			break;
 	}
 
+	case AMC_CMD_ID_PARTITION_DIGEST:
+	{
+		struct amc_proxy_partition_digest_request partition_digest = { 0 };
+		struct ami_ioc_partition_digest_value *partition_digest_data =
+			(struct ami_ioc_partition_digest_value*)data_buf;
+
+		partition_digest.boot_device = partition_digest_data->boot_device;
+		partition_digest.partition = partition_digest_data->partition;
+		partition_digest.length = partition_digest_data->length;
+		partition_digest.address = payload_address;
+		/* Reading back the whole partition takes as long as a copy. */
+		amc_proxy_cmd->cmd_timeout_jiffies = jiffies + REQUEST_COPY_TIMEOUT;
+		ret = amc_proxy_request_partition_digest(amc_proxy_cmd, &partition_digest);
+		break;
+	}
+
+	case AMC_CMD_ID_SVC_STATS:
+	{
+		struct amc_proxy_svc_stats_request svc_stats = { 0 };
+
+		svc_stats.opcode = SVC_STATS_OPCODE(flags);
+		svc_stats.clear = SVC_STATS_CLEAR(flags);
+		ret = amc_proxy_request_svc_stats(amc_proxy_cmd, &svc_stats);
+		break;
+	}
+
 	default:
 		ret = -EINVAL;
 		AMI_ERR(amc_ctrl_ctxt, "Unsupported request %d", cmd_id);
@@ -1710,6 +1952,15 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 				amc_proxy_cmd->cmd_rcode,
 				cmd_id);
 		}
+
+		/* Split the round trip into AMC service time and transport/queueing */
+		if ((cmd_id != AMC_CMD_ID_IDENTIFY) &&
+				!amc_proxy_get_response_service_time(amc_proxy_cmd, &service_ms))
+			AMI_DBG(amc_ctrl_ctxt,
+				"cmd_id: %d round trip %lld us, AMC service %u ms",
+				cmd_id,
+				ktime_us_delta(ktime_get(), submit_time),
+				service_ms);
 	}
 
 	switch (cmd_id) {
@@ -1731,7 +1982,7 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 
 		case AMC_CMD_ID_SENSOR:
 			ret = amc_proxy_get_response_sensor(amc_proxy_cmd);
-			if (!ret)
+			if (!ret && !amc_proxy_cmd->cmd_inline_len)
 				memcpy_gcq_payload_from_device(amc_ctrl_ctxt, payload_address, data_buf, data_size);
 			break;
 
@@ -1759,14 +2010,16 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 			ret = amc_proxy_get_response_eeprom_read_write(amc_proxy_cmd);
 			if (!ret)
 				if (EEPROM_GET_TYPE(flags) == AMC_PROXY_CMD_RW_REQUEST_READ)
-					memcpy_gcq_payload_from_device(amc_ctrl_ctxt, payload_address, data_buf, data_size);
+					ret = copy_read_response(amc_ctrl_ctxt, amc_proxy_cmd,
+						payload_address, data_buf, data_size);
 			break;
 
 		case AMC_CMD_ID_MODULE_READ_WRITE:
 			ret = amc_proxy_get_response_module_read_write(amc_proxy_cmd);
 			if (!ret)
 				if (MODULE_RW_TYPE(flags) == AMC_PROXY_CMD_RW_REQUEST_READ)
-					memcpy_gcq_payload_from_device(amc_ctrl_ctxt, payload_address, data_buf, data_size);
+					ret = copy_read_response(amc_ctrl_ctxt, amc_proxy_cmd,
+						payload_address, data_buf, data_size);
 			break;
 
 		case AMC_CMD_ID_DEBUG_VERBOSITY:
@@ -1777,6 +2030,18 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 			ret = amc_proxy_get_response_set_fpt_partition(amc_proxy_cmd);
 			break;
 
+		case AMC_CMD_ID_PARTITION_DIGEST:
+			ret = amc_proxy_get_response_partition_digest(amc_proxy_cmd);
+			if (!ret)
+				memcpy_gcq_payload_from_device(amc_ctrl_ctxt, payload_address,
+					((struct ami_ioc_partition_digest_value*)data_buf)->digest,
+					payload_size);
+			break;
+
+		case AMC_CMD_ID_SVC_STATS:
+			ret = amc_proxy_get_response_svc_stats(amc_proxy_cmd);
+			break;
+
 		default:
 			AMI_ERR(amc_ctrl_ctxt, "Unsupported response %d", cmd_id);
 			break;
@@ -1878,6 +2143,9 @@ int setup_amc(struct pci_dev		*dev,
 		(uint64_t)amc_ctxt->amc_shared_mem.ring_buf.ring_buf_len;
 	amc_ctxt->gcq_consumer.ulSQSlotSize = AMC_PROXY_REQUEST_SIZE;
 	amc_ctxt->gcq_consumer.ulCQSlotSize = AMC_PROXY_RESPONSE_SIZE;
+	amc_ctxt->gcq_consumer.ulCoalesceCount   = AMC_GCQ_COALESCE_COUNT;
+	amc_ctxt->gcq_consumer.ulCoalesceDelayMs = AMC_GCQ_COALESCE_DELAY_MS;
+	amc_ctxt->gcq_consumer.ulCQExtSize  = AMC_PROXY_RESPONSE_EXT_SIZE;
 
 	/* Init proxy and bind in callback */
 	ret = amc_proxy_init(0, &amc_ctxt->gcq_consumer);
@@ -1976,6 +2244,9 @@ int setup_amc(struct pci_dev		*dev,
 	 * including the heartbeat and logging threads.
 	 */
 	if (!amc_ctxt->compat_mode) {
+		/* Move health requests off the first instance before the heartbeat starts */
+		setup_telemetry_channel(amc_ctxt);
+
 		/* Spawn the heartbeat thread once version is verified */
 		amc_ctxt->event_cb = event_cb;
 		amc_ctxt->event_cb_data = event_cb_data;
@@ -2048,6 +2319,13 @@ int unset_amc(struct pci_dev *dev, struct amc_control_ctxt *amc_ctrl_ctxt)
 		stop_gcq_services(amc_ctrl_ctxt);
 
 		/* Close the proxy */
+		if (amc_ctrl_ctxt->telemetry_enabled) {
+			amc_ctrl_ctxt->telemetry_enabled = false;
+			ret = amc_proxy_close(&amc_ctrl_ctxt->gcq_telemetry);
+			if (ret)
+				DEV_ERR(dev, "Failed to close the telemetry amc proxy %d", ret);
+		}
+
 		ret = amc_proxy_close(&amc_ctrl_ctxt->gcq_consumer);
 		if (ret)
 			DEV_ERR(dev, "Failed to close the amc proxy %d", ret);
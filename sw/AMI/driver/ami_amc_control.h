@@ -35,6 +35,11 @@
 
 #define SENSOR_RSP_LEN		(4096)
 
+/* GCQ_SUBMIT_CMD_GET_SVC_STATS flags: opcode in [15:0], clear once read in [16] */
+#define MK_SVC_STATS_FLAGS(opcode, clear)	(((uint32_t)(opcode) & 0xFFFF) | ((clear) ? BIT(16) : 0))
+#define SVC_STATS_OPCODE(flags)			((uint16_t)((flags) & 0xFFFF))
+#define SVC_STATS_CLEAR(flags)			(!!((flags) & BIT(16)))
+
 #define AMC_LOG_ENTRY_SIZE	(96)
 #define AMC_LOG_MAX_RECS	(50)
 
@@ -115,6 +120,8 @@ enum gcq_submit_cmd_flags {
  * @GCQ_SUBMIT_CMD_DEVICE_BOOT: Select device boot partition
  * @GCQ_SUBMIT_CMD_COPY_PARTITION: Copy partition to another
  * @GCQ_SUBMIT_CMD_SET_FPT_PARTITION: Set FPT partition
+ * @GCQ_SUBMIT_CMD_GET_PARTITION_DIGEST: Get the MD5 digest of a partition range
+ * @GCQ_SUBMIT_CMD_GET_SVC_STATS: Get the AMC service time of one opcode
  * @GCQ_SUBMIT_CMD_GET_INLET_TEMP_SENSOR: Get inlet temperature data
  * @GCQ_SUBMIT_CMD_GET_OUTLET_TEMP_SENSOR: Get outlet temperature data
  * @GCQ_SUBMIT_CMD_GET_BOARD_TEMP_SENSOR: Get board temp data
@@ -145,6 +152,8 @@ enum gcq_submit_cmd_req {
 	GCQ_SUBMIT_CMD_DEVICE_BOOT		= 0x05,
 	GCQ_SUBMIT_CMD_COPY_PARTITION		= 0x06,
 	GCQ_SUBMIT_CMD_SET_FPT_PARTITION	= 0x07,
+	GCQ_SUBMIT_CMD_GET_PARTITION_DIGEST	= 0x08,
+	GCQ_SUBMIT_CMD_GET_SVC_STATS		= 0x09,
 	GCQ_SUBMIT_CMD_GET_INLET_TEMP_SENSOR	= 0x10,
 	GCQ_SUBMIT_CMD_GET_OUTLET_TEMP_SENSOR	= 0x11,
 	GCQ_SUBMIT_CMD_GET_BOARD_TEMP_SENSOR	= 0x12,
@@ -353,6 +362,8 @@ enum sdr_buf_index {
  * @AMC_CMD_ID_EEPROM_READ_WRITE: eeprom read/write command
  * @AMC_CMD_ID_MODULE_READ_WRITE: module read/write command
  * @AMC_CMD_ID_DEBUG_VERBOSITY: debug verbosity command
+ * @AMC_CMD_ID_PARTITION_DIGEST: partition digest command
+ * @AMC_CMD_ID_SVC_STATS: service time statistics command
  */
 enum amc_cmd_id {
 	AMC_CMD_ID_UNKNOWN	= -EINVAL,
@@ -366,6 +377,8 @@ enum amc_cmd_id {
 	AMC_CMD_ID_EEPROM_READ_WRITE,
 	AMC_CMD_ID_MODULE_READ_WRITE,
 	AMC_CMD_ID_DEBUG_VERBOSITY,
+	AMC_CMD_ID_PARTITION_DIGEST,
+	AMC_CMD_ID_SVC_STATS,
 
 	AMC_CMD_ID_MAX
 };
@@ -632,6 +645,24 @@ struct amc_data {
 	uint32_t	amc_data_end;
 };
 
+/**
+ * struct amc_channel - Stores an extra sGCQ instance - part of the partition table.
+ * @gcq_off:            the offset of the instance from the sGCQ base
+ * @ring_buf_off:       the offset of its ring buffer
+ * @ring_buf_len:       the length of its ring buffer
+ * @data_off:           the offset of its payload area
+ * @data_len:           the length of its payload area
+ *
+ * All zero until the AMC is serving the instance.
+ */
+struct amc_channel {
+	uint32_t	gcq_off;
+	uint32_t	ring_buf_off;
+	uint32_t	ring_buf_len;
+	uint32_t	data_off;
+	uint32_t	data_len;
+};
+
 /**
  * struct amc_shared_mem - sGCQ memory partition table, should be positioned at shared memory offset 0,
  *     and initialized by AMC software on RPU device.
@@ -643,6 +674,7 @@ struct amc_data {
  * @amc_uuid:           amc uuid struct.
  * @amc_log_msg:        amc log struct.
  * @amc_data:           amc data struct.
+ * @telemetry:          sGCQ instance for sensor and health requests.
  */
 struct amc_shared_mem {
 	uint32_t		amc_magic_no;
@@ -651,6 +683,7 @@ struct amc_shared_mem {
 	struct amc_uuid		uuid;
 	struct amc_log_msg	log_msg;
 	struct amc_data		data;
+	struct amc_channel	telemetry;
 };
 
 /**
@@ -677,10 +710,14 @@ struct amc_version {
  * @gcq_ring_buf_base_virt_addr: the ring buffer virtual address
  * @amc_shared_mem: the shared memory base address
  * @gcq_consumer: handle to the sGCQ consumer
+ * @gcq_telemetry: handle to the sGCQ consumer for sensor and health requests
+ * @telemetry_enabled: flag used to determine if gcq_telemetry is in use,
+ *   otherwise every request goes on gcq_consumer
  * @lock: lock to protect cid creation
  * @gcq_cmd_lock: protect concurrent gcq commands
  * @gcq_halted: block/allow request messages
- * @gcq_log_page_sema: log page access semaphore
+ * @gcq_log_page_sema: sensor page access semaphore, the log page or the
+ *   gcq_telemetry payload area
  * @gcq_data_sema: data access semaphore
  * @version: AMC version
  * @heartbeat_thread: thread that generates heartbest requests
@@ -701,6 +738,8 @@ struct amc_control_ctxt {
 	void __iomem		*gcq_ring_buf_base_virt_addr;
 	struct amc_shared_mem	amc_shared_mem;
 	GCQCfg			gcq_consumer;
+	GCQCfg			gcq_telemetry;
+	bool			telemetry_enabled;
 	struct mutex		lock;
 	struct mutex		gcq_cmd_lock;
 	bool			gcq_halted;
@@ -158,6 +158,7 @@ long dev_unlocked_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
 		case AMI_IOC_GET_FPT_HDR:
 		case AMI_IOC_GET_FPT_PARTITION:
 		case AMI_IOC_SET_FPT_PARTITION:
+		case AMI_IOC_GET_PARTITION_DIGEST:
 		case AMI_IOC_READ_EEPROM:
 		case AMI_IOC_WRITE_EEPROM:
 		case AMI_IOC_READ_MODULE:
@@ -584,6 +585,34 @@ long dev_unlocked_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
 		break;
 	}
 
+	case AMI_IOC_GET_PARTITION_DIGEST:
+	{
+		/* `arg` is a pointer to `struct ami_ioc_partition_digest_value` */
+		struct ami_ioc_partition_digest_value data = { 0 };
+
+		if (copy_from_user(&data, (struct ami_ioc_partition_digest_value*)arg, sizeof(data))) {
+			ret = -EFAULT;
+			goto done;
+		}
+
+		if (data.length == 0) {
+			ret = -EINVAL;
+			goto done;
+		}
+
+		ret = submit_gcq_command(pf_dev->amc_ctrl_ctxt,
+				GCQ_SUBMIT_CMD_GET_PARTITION_DIGEST, 0, (uint8_t*)&data, sizeof(data));
+		if (!ret) {
+			ret = copy_to_user((
+				struct ami_ioc_partition_digest_value*)arg,
+				&data, sizeof(data)
+			);
+		} else {
+			AMI_ERR(pf_dev->amc_ctrl_ctxt, "Failed to digest partition %d", data.partition);
+		}
+		break;
+	}
+
 	case AMI_IOC_READ_EEPROM:
 	{
 		struct ami_ioc_eeprom_payload data = { 0 };
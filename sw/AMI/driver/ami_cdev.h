@@ -203,6 +203,20 @@ struct ami_ioc_fpt_partition_value {
 	uint32_t flags;
 };
 
+/**
+ * struct ami_ioc_partition_digest_value - the partition digest request.
+ * @boot_device: Target boot device.
+ * @partition: The partition to digest.
+ * @length: Number of bytes to digest from the start of the partition.
+ * @digest: The MD5 digest of the partition range (16 bytes). Populated by the driver.
+ */
+struct ami_ioc_partition_digest_value {
+	uint32_t boot_device;
+	uint32_t partition;
+	uint32_t length;
+	uint8_t  digest[MD5_SIZE];
+};
+
 /**
  * struct ami_ioc_eeprom_payload - payload struct for dynamically sized ioctl eeprom data
  * @addr: Location of data buffer in userspace memory.
@@ -258,7 +272,8 @@ enum ami_ioc_app_setup {
 #define AMI_IOC_READ_MODULE		_IOW(AMI_IOC_MAGIC, 13, struct ami_ioc_module_payload*)
 #define AMI_IOC_WRITE_MODULE		_IOW(AMI_IOC_MAGIC, 14, struct ami_ioc_module_payload*)
 #define AMI_IOC_DEBUG_VERBOSITY		_IOW(AMI_IOC_MAGIC, 15, uint8_t)
-#define AMI_IOC_MAX			(16)
+#define AMI_IOC_GET_PARTITION_DIGEST	_IOWR(AMI_IOC_MAGIC, 16, struct ami_ioc_partition_digest_value*)
+#define AMI_IOC_MAX			(17)
 
 /* End shared data. */
 
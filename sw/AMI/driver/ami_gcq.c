@@ -28,7 +28,7 @@
 #define GCQ_ATTACH_RETRY_TIMEOUT_MS     (1000)
 
 #define GCQ_VER_MAJOR                   (1)
-#define GCQ_VER_MINOR                   (0)
+#define GCQ_VER_MINOR                   (1)
 #define GCQ_VER_PATCH                   (0)
 
 #define GET_GCQ_MAJOR(version)          (version >> 16)
@@ -36,6 +36,20 @@
 
 #define GCQ_ALLOC_MAGIC                 (0x5847513F)
 #define GCQ_MIN_NUM_SLOTS               (2)
+
+/* Completion coalescing config, read by the producer from the header flags */
+#define GCQ_HDR_FLAG_COALESCE           (0x80000000)
+#define GCQ_HDR_COALESCE_COUNT_MASK     (0x000000FF)
+#define GCQ_HDR_COALESCE_DELAY_SHIFT    (8)
+#define GCQ_HDR_COALESCE_DELAY_MASK     (0x00FFFF00)
+
+/* CQ entry extension, each CQ slot is followed by `size` bytes past the CQ slots (since v1.1) */
+#define GCQ_VER_MINOR_CQ_EXT            (1)
+#define GCQ_HDR_FLAG_CQ_EXT             (0x40000000)
+#define GCQ_HDR_CQ_EXT_SIZE_SHIFT       (24)
+#define GCQ_HDR_CQ_EXT_SIZE_MASK        (0x3F000000)
+#define GCQ_HDR_CQ_EXT_SIZE_UNIT        (16)
+#define GCQ_CQ_EXT_LEN_SIZE             (sizeof(uint32_t))
 #ifndef GCQ_MAX_INSTANCES
 #define GCQ_MAX_INSTANCES               (4)   /* Default value, but can be overridden by build environmental variable  */
 #endif
@@ -140,8 +154,12 @@ typedef struct GCQInstance
 	bool     iInitialised;
 	uint64_t ullBaseAddr;
 	uint64_t ullRingAddr;
+	uint64_t ullRingLen;
 	uint32_t ulConsumerSlotSize;
 	uint32_t ulProducerSlotSize;
+	uint32_t ulProducerVerMinor;
+	uint32_t ulConsumerExtSize;
+	uint64_t ullConsumerExtAddr;
 	GCQRing  xGCQSq; ____cacheline_aligned_in_smp
 	GCQRing  xGCQCq; ____cacheline_aligned_in_smp
 	GCQRing  *pxGCQProducer;
@@ -475,6 +493,10 @@ static GCQ_ERRORS_TYPE gcq_initialise(GCQInstance **ppxGCQInstance,
 			pxGCQInstance->iInitialised    = false;
 			pxGCQInstance->ullBaseAddr     = ullBaseAddr;
 			pxGCQInstance->ullRingAddr     = ullRingAddr;
+			pxGCQInstance->ullRingLen      = ullRingLen;
+			pxGCQInstance->ulProducerVerMinor = 0;
+			pxGCQInstance->ulConsumerExtSize  = 0;
+			pxGCQInstance->ullConsumerExtAddr = 0;
 			pxGCQInstance->ulUpperFirewall = GCQ_INSTANCE_UPPER_FIREWALL;
 			pxGCQInstance->ulLowerFirewall = GCQ_INSTANCE_LOWER_FIREWALL;
 
@@ -559,6 +581,7 @@ static GCQ_ERRORS_TYPE gcq_attach_consumer(GCQInstance *pxGCQInstance)
 			} else {
 				GCQ_DEBUG("Version: 0x%x 0x%x\n", GET_GCQ_MAJOR(xGCQHeader.ulHdrVersion),
 					GET_GCQ_MINOR(xGCQHeader.ulHdrVersion));
+				pxGCQInstance->ulProducerVerMinor = GET_GCQ_MINOR(xGCQHeader.ulHdrVersion);
 			}
 		}
 
@@ -599,6 +622,78 @@ static GCQ_ERRORS_TYPE gcq_attach_consumer(GCQInstance *pxGCQInstance)
 	return xStatus;
 }
 
+/**
+ * @brief    Build the completion coalescing part of the header flags
+ *
+ * @param    ulCount is the number of completions per pointer update
+ * @param    ulDelayMs is the max time a completion may be held back
+ *
+ * @return   The header flags to pass to the producer
+ *
+ * @note     A count of 0 or 1 disables coalescing. Thresholds are clamped to
+ *           the width of their header fields.
+ */
+static uint32_t gcq_coalescing_flags(uint32_t ulCount, uint32_t ulDelayMs)
+{
+	uint32_t ulFlags = 0;
+
+	if (ulCount > 1) {
+		ulCount = min_t(uint32_t, ulCount, GCQ_COALESCE_COUNT_MAX);
+		ulDelayMs = min_t(uint32_t, ulDelayMs, GCQ_COALESCE_DELAY_MS_MAX);
+
+		ulFlags = GCQ_HDR_FLAG_COALESCE |
+			(ulCount & GCQ_HDR_COALESCE_COUNT_MASK) |
+			((ulDelayMs << GCQ_HDR_COALESCE_DELAY_SHIFT) & GCQ_HDR_COALESCE_DELAY_MASK);
+	}
+
+	GCQ_DEBUG("Coalescing count:%u delay:%ums\r\n", ulCount, ulDelayMs);
+	return ulFlags;
+}
+
+/**
+ * @brief    Negotiate the CQ entry extension and build its header flags
+ *
+ * @param    pxGCQInstance is the instance of the sGCQ
+ * @param    pulExtSize is the extension size to request, updated to the
+ *           size actually used (0 if the producer cannot support it)
+ *
+ * @return   The header flags to pass to the producer
+ *
+ * @note     The extensions are placed after the CQ slots, so the request is
+ *           refused if they do not fit in the ring or the producer predates
+ *           the extension.
+ */
+static uint32_t gcq_cq_ext_flags(GCQInstance *pxGCQInstance, uint32_t *pulExtSize)
+{
+	GCQRing *pxRing = pxGCQInstance->pxGCQConsumer;
+	uint32_t ulExtSize = *pulExtSize;
+	uint64_t ullExtAddr = pxRing->ullRingSlotAddr +
+		(uint64_t)pxRing->ulRingNumSlots * pxRing->ulRingSlotSize;
+
+	pxGCQInstance->ulConsumerExtSize = 0;
+	pxGCQInstance->ullConsumerExtAddr = 0;
+	*pulExtSize = 0;
+
+	if ((0 == ulExtSize) ||
+		(pxGCQInstance->ulProducerVerMinor < GCQ_VER_MINOR_CQ_EXT) ||
+		(ulExtSize > GCQ_CQ_EXT_SIZE_MAX) ||
+		(ulExtSize % GCQ_HDR_CQ_EXT_SIZE_UNIT) ||
+		((ullExtAddr + (uint64_t)pxRing->ulRingNumSlots * ulExtSize) >
+			(pxGCQInstance->ullRingAddr + pxGCQInstance->ullRingLen))) {
+		GCQ_DEBUG("CQ extension of %u bytes not used\r\n", ulExtSize);
+		return 0;
+	}
+
+	pxGCQInstance->ulConsumerExtSize = ulExtSize;
+	pxGCQInstance->ullConsumerExtAddr = ullExtAddr;
+	*pulExtSize = ulExtSize;
+
+	GCQ_DEBUG("CQ extension:%u addr:0x%llx\r\n", ulExtSize, ullExtAddr);
+	return GCQ_HDR_FLAG_CQ_EXT |
+		(((ulExtSize / GCQ_HDR_CQ_EXT_SIZE_UNIT) << GCQ_HDR_CQ_EXT_SIZE_SHIFT) &
+			GCQ_HDR_CQ_EXT_SIZE_MASK);
+}
+
 /**
  * @brief    Function to consume/read data from the sGCQ
  *           Internally the function will:
@@ -608,16 +703,19 @@ static GCQ_ERRORS_TYPE gcq_attach_consumer(GCQInstance *pxGCQInstance)
  *
  * @param    pxGCQInstance is the instance of the sGCQ
  * @param    pucData is the pointer to the data to be populated on receive
- * @param    ulDatalLen is the length of the data received
+ * @param    pulDataLen is the length of the buffer, updated to the length
+ *           of the data received
  *
  * @return   See GCQ_ERRORS_TYPE for possible return values
  */
 static GCQ_ERRORS_TYPE xGCQConsumeData(GCQInstance *pxGCQInstance,
-	uint8_t *pucData, uint32_t ulDataLen)
+	uint8_t *pucData, uint32_t *pulDataLen)
 {
 	GCQ_ERRORS_TYPE xStatus = GCQ_ERRORS_INVALID_ARG;
 
 	uint64_t ullSlotAddr = 0;
+	uint32_t ulDataLen = *pulDataLen;
+	uint32_t ulSlotLen = ulDataLen;
 
 	if ((GCQ_INSTANCE_UPPER_FIREWALL == pxThis->ulUpperFirewall) &&
 		(GCQ_INSTANCE_LOWER_FIREWALL == pxThis->ulLowerFirewall)) {
@@ -638,7 +736,13 @@ static GCQ_ERRORS_TYPE xGCQConsumeData(GCQInstance *pxGCQInstance,
 			xStatus = GCQ_ERRORS_INVALID_ARG;
 		}
 
-		if (ulDataLen > pxGCQInstance->ulConsumerSlotSize) {
+		if ((0 != pxGCQInstance->ulConsumerExtSize) &&
+			(ulDataLen > pxGCQInstance->ulConsumerSlotSize) &&
+			(ulDataLen <= (pxGCQInstance->ulConsumerSlotSize +
+				pxGCQInstance->ulConsumerExtSize - GCQ_CQ_EXT_LEN_SIZE))) {
+			/* The remainder may come from the negotiated extension */
+			ulSlotLen = pxGCQInstance->ulConsumerSlotSize;
+		} else if (ulDataLen > pxGCQInstance->ulConsumerSlotSize) {
 			GCQ_DEBUG(" Error: length 0x%x specified is larger than slot configured\r\n", ulDataLen);
 			xStatus = GCQ_ERRORS_INVALID_ARG;
 		}
@@ -663,7 +767,21 @@ static GCQ_ERRORS_TYPE xGCQConsumeData(GCQInstance *pxGCQInstance,
 			GCQRing *pxRing = pxGCQInstance->pxGCQConsumer;
 			GCQ_DEBUG("Read data from slot addr:0x%llx len:%u\r\n", ullSlotAddr, ulDataLen);
 			/* Process the data & populate the return buffer */
-			memcpy_fromio(pucData, (void __iomem *)ullSlotAddr, ulDataLen);
+			memcpy_fromio(pucData, (void __iomem *)ullSlotAddr, ulSlotLen);
+
+			/* Only read as much of the extension as the producer wrote */
+			if (ulSlotLen < ulDataLen) {
+				uint64_t ullExtAddr = pxGCQInstance->ullConsumerExtAddr +
+					((ullSlotAddr - pxRing->ullRingSlotAddr) / pxRing->ulRingSlotSize) *
+					pxGCQInstance->ulConsumerExtSize;
+				uint32_t ulExtLen = ioread32((void __iomem *)ullExtAddr);
+
+				ulExtLen = min_t(uint32_t, ulExtLen, ulDataLen - ulSlotLen);
+				memcpy_fromio(pucData + ulSlotLen,
+					(void __iomem *)(ullExtAddr + GCQ_CQ_EXT_LEN_SIZE), ulExtLen);
+				ulDataLen = ulSlotLen + ulExtLen;
+			}
+			*pulDataLen = ulDataLen;
 
 			/* Notify the peer the data has been consumed */
 			iowrite32(pxRing->ulRingConsumed, (void __iomem *)pxRing->ullRingConsumedAddr);
@@ -793,7 +911,18 @@ uint32_t gcq_open(void *pvFWIf)
 			msleep(GCQ_ATTACH_RETRY_TIMEOUT_MS);
 		}
 		if (GCQ_ERRORS_NONE == xRet) {
+			uint32_t ulFlags = 0;
+
 			GCQ_DEBUG("Attached ok!\r\n");
+
+			/* Single write so the producer never sees a partial config */
+			ulFlags = gcq_coalescing_flags(pxCfg->ulCoalesceCount,
+					pxCfg->ulCoalesceDelayMs) |
+				gcq_cq_ext_flags(pxGCQInstance, &pxCfg->ulCQExtSize);
+			iowrite32(ulFlags, (void __iomem *)(pxGCQInstance->ullRingAddr +
+				offsetof(GCQHeader, ulHdrFlags)));
+		} else {
+			pxCfg->ulCQExtSize = 0;
 		}
 	}
 
@@ -859,7 +988,7 @@ uint32_t gcq_read(void *pvFWIf,
 		(GCQ_STATE_ATTACHED != pxGCQInstance->xState))
 		return GCQ_ERRORS_INVALID_HANDLE;
 
-	xStatus = xGCQConsumeData(pxGCQInstance, pucData, *pulSize);
+	xStatus = xGCQConsumeData(pxGCQInstance, pucData, pulSize);
 
 	return xStatus;
 }
@@ -31,6 +31,10 @@
 
 #define GCQ_UDID_LEN        ( 16 )
 
+#define GCQ_COALESCE_COUNT_MAX      ( 0xFF )
+#define GCQ_COALESCE_DELAY_MS_MAX   ( 0xFFFF )
+#define GCQ_CQ_EXT_SIZE_MAX         ( 0x3F * 16 )
+
 #define gcq_assert(x)                                                           \
 do { if (x) break;                                                              \
         printk(KERN_EMERG "### ASSERTION FAILED [sGCQ Driver] %s: %s: %d: %s\n",\
@@ -95,6 +99,9 @@ typedef struct GCQCfg
 	uint32_t    ulCQSlotSize;
 	uint32_t    ulSQSlotSize;
 	uint8_t     udid[GCQ_UDID_LEN];
+	uint32_t    ulCoalesceCount;    /* completions per pointer update, 0 to disable */
+	uint32_t    ulCoalesceDelayMs;  /* max time a completion is held back */
+	uint32_t    ulCQExtSize;        /* CQ entry extension to request, 0 if refused by the producer */
 
     void        *pvGCQInstance;  /* opaque handle to store internal context */
 
@@ -133,6 +140,10 @@ uint32_t gcq_close(void *pvFWIf);
 
 /**
  * @brief   Local implementation of gcq_read
+ *
+ * @note    When a CQ entry extension was negotiated `*pulSize` may be up to
+ *          the CQ slot size plus `ulCQExtSize` less 4; on return it holds the
+ *          number of bytes actually read.
  */
 uint32_t gcq_read(void *pvFWIf,
 	uint8_t *pucData, uint32_t *pulSize, uint32_t ulTimeoutMs);
@@ -21,6 +21,16 @@
 #define MAX_POWER_MODE_225W		(2)
 #define MAX_POWER_MODE_350W		(3)
 
+/*
+ * Opcodes AMC keeps service times for. Identify is the one opcode outside
+ * the contiguous range, 0x7 - 0x9 are unused and the statistics request
+ * itself (0xF) is not timed.
+ */
+static const uint16_t svc_time_opcodes[] = {
+	0x000, 0x002, 0x003, 0x004, 0x005, 0x006,
+	0x00A, 0x00B, 0x00C, 0x00D, 0x00E, 0x202,
+};
+
 
 /**
  * get_state_name() - Get the string representation of a device state.
@@ -373,6 +383,71 @@ static ssize_t amc_version_show(struct device		*dev,
 }
 static DEVICE_ATTR_RO(amc_version);
 
+/**
+ * amc_service_times_show() - Sysfs read callback for 'amc_service_times' attribute.
+ * @dev: Device this attribute belongs to.
+ * @da: Pointer to device attribute struct.
+ * @buf: Output character buffer.
+ *
+ * One line per opcode AMC has served: the opcode, count, min/max/avg in ms
+ * and the log2 histogram buckets (see `struct amc_proxy_svc_time`).
+ *
+ * Return: Number of bytes written to output buffer.
+ */
+static ssize_t amc_service_times_show(struct device		*dev,
+				      struct device_attribute	*da,
+				      char			*buf)
+{
+	int ret = 0;
+	int i = 0;
+	int op = 0;
+	struct pf_dev_struct *pf_dev = NULL;
+	struct amc_proxy_svc_time svc_time = { 0 };
+
+	if (!dev || !da || !buf)
+		return -EINVAL;
+
+	pf_dev = get_pf_dev_entry(dev, PF_DEV_CACHE_DEV);
+	if (!pf_dev)
+		return -ENODEV;
+
+	if (!pf_dev->amc_ctrl_ctxt) {
+		put_pf_dev_entry(pf_dev);
+		return -ENODEV;
+	}
+
+	for (op = 0; op < ARRAY_SIZE(svc_time_opcodes); op++) {
+		uint16_t req_opcode = svc_time_opcodes[op];
+
+		memset(&svc_time, 0, sizeof(svc_time));
+
+		/* Old firmware does not support the request, skip the opcode */
+		if (submit_gcq_command(pf_dev->amc_ctrl_ctxt,
+				GCQ_SUBMIT_CMD_GET_SVC_STATS,
+				MK_SVC_STATS_FLAGS(req_opcode, false),
+				(uint8_t *)&svc_time, sizeof(svc_time)))
+			continue;
+
+		if (!svc_time.count)
+			continue;
+
+		ret += scnprintf(buf + ret, PAGE_SIZE - ret,
+			"0x%03x count %u min %u max %u avg %u ms:",
+			req_opcode, svc_time.count, svc_time.min_ms,
+			svc_time.max_ms, svc_time.total_ms / svc_time.count);
+
+		for (i = 0; i < AMC_PROXY_SVC_TIME_BUCKETS; i++)
+			ret += scnprintf(buf + ret, PAGE_SIZE - ret,
+				" %u", svc_time.histogram[i]);
+
+		ret += scnprintf(buf + ret, PAGE_SIZE - ret, "\n");
+	}
+
+	put_pf_dev_entry(pf_dev);
+	return ret;
+}
+static DEVICE_ATTR_RO(amc_service_times);
+
 /**
  * enum sysfs_mfg_field - List of exposed EEPROM fields.
  * @SYSFS_MFG_EEPROM_VERSION: The eeprom version.
@@ -771,6 +846,7 @@ static const struct device_attribute *mgmt_attrs[] = {
 	&dev_attr_dev_state,
 	&dev_attr_dev_name,
 	&dev_attr_amc_version,
+	&dev_attr_amc_service_times,
 
 	/* mfg data */
 	&dev_attr_eeprom_version.attr,
@@ -0,0 +1,868 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * ami_exporterd.c - This file contains a daemon which exports AMI sensor
+ * readings as OpenMetrics text
+ *
+ * Copyright (c) 2023 - 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+/* Standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <getopt.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/* API includes */
+#include "ami.h"
+#include "ami_device.h"
+#include "ami_sensor.h"
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+#define EXPORTER_NAME		"ami_exporterd"
+
+#define DEFAULT_PORT		(9760)
+#define DEFAULT_INTERVAL_MS	(1000)
+#define LISTEN_BACKLOG		(16)
+#define CLIENT_TIMEOUT_MS	(2000)
+
+#define REQUEST_BUF_SIZE	(1024)
+#define VALUE_STR_SIZE		(48)
+#define MAX_FRAC_DIGITS		(9)
+#define TEXT_INITIAL_SIZE	(16 * 1024)
+
+#define HTTP_METRICS_PATH	"/metrics"
+#define OPENMETRICS_TYPE	"application/openmetrics-text; version=1.0.0; charset=utf-8"
+
+/* Number of sensor types (one per bit in `enum ami_sensor_type`). */
+#define NUM_SENSOR_TYPES	(AMI_SENSOR_TYPE_MAX)
+
+/*****************************************************************************/
+/* Structs                                                                   */
+/*****************************************************************************/
+
+/**
+ * struct metric - latest reading of a single sensor type
+ * @sensor_name: sensor name
+ * @type: sensor type (a single `enum ami_sensor_type` value)
+ * @mod: unit modifier (power of ten) of `value`
+ * @value: last reported value
+ * @status: last reported status (AMI_SENSOR_STATUS_INVALID until reported)
+ */
+struct metric {
+	char                      sensor_name[AMI_SENSOR_MAX_STR];
+	enum ami_sensor_type      type;
+	enum ami_sensor_unit_mod  mod;
+	long                      value;
+	enum ami_sensor_status    status;
+};
+
+/**
+ * struct exp_device - exported device
+ * @dev: device handle
+ * @bdf: device BDF string
+ * @metrics: list of metrics belonging to this device
+ * @num_metrics: number of entries in `metrics`
+ * @watch_id: sensor watch identifier
+ * @watching: true if a sensor watch is active
+ */
+struct exp_device {
+	ami_device      *dev;
+	char             bdf[AMI_BDF_STR_LEN];
+	struct metric   *metrics;
+	int              num_metrics;
+	int              watch_id;
+	bool             watching;
+};
+
+/**
+ * struct metric_family - description of an exported metric family
+ * @type: sensor type covered by the family
+ * @name: metric family name
+ * @unit: OpenMetrics unit
+ * @help: help text
+ */
+struct metric_family {
+	enum ami_sensor_type  type;
+	const char           *name;
+	const char           *unit;
+	const char           *help;
+};
+
+/**
+ * struct exporter - global daemon state
+ * @lock: protects all device metrics and the rendered text
+ * @devs: list of exported devices
+ * @num_devs: number of entries in `devs`
+ * @text: rendered OpenMetrics text
+ * @text_len: length of `text`
+ * @text_size: allocated size of `text`
+ * @dirty: true if any metric changed since `text` was rendered, or the
+ *   last render failed
+ * @body: copy of `text` being sent to a client (accept loop only)
+ * @body_size: allocated size of `body`
+ */
+struct exporter {
+	pthread_mutex_t      lock;
+	struct exp_device   *devs;
+	int                  num_devs;
+	char                *text;
+	size_t               text_len;
+	size_t               text_size;
+	bool                 dirty;
+	char                *body;
+	size_t               body_size;
+};
+
+/*****************************************************************************/
+/* Local function declarations                                               */
+/*****************************************************************************/
+
+/**
+ * on_sensor_event() - Sensor watch callback.
+ * @dev: Device handle.
+ * @event: Sensor change event.
+ * @data: Exported device.
+ *
+ * Return: None.
+ */
+static void on_sensor_event(ami_device *dev, const struct ami_sensor_event *event,
+	void *data);
+
+/**
+ * add_device_metrics() - Build the metric list for a device.
+ * @edev: Exported device.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+static int add_device_metrics(struct exp_device *edev);
+
+/**
+ * text_append() - Append formatted text to the rendered output.
+ * @fmt: Format string.
+ *
+ * Must be called with `exporter.lock` held.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+static int text_append(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * format_value() - Format a sensor value in its base unit.
+ * @value: Raw value.
+ * @mod: Unit modifier (power of ten).
+ * @buf: Output buffer (at least VALUE_STR_SIZE bytes).
+ *
+ * Uses integer arithmetic only, so the value is reproduced exactly.
+ *
+ * Return: None.
+ */
+static void format_value(long value, enum ami_sensor_unit_mod mod, char *buf);
+
+/**
+ * render_metrics() - Render all metrics as OpenMetrics text.
+ *
+ * Must be called with `exporter.lock` held.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+static int render_metrics(void);
+
+/**
+ * write_all() - Write an entire buffer to a socket.
+ * @fd: Socket.
+ * @buf: Data to write.
+ * @len: Number of bytes in `buf`.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+static int write_all(int fd, const char *buf, size_t len);
+
+/**
+ * serve_client() - Handle a single HTTP request.
+ * @fd: Connected client socket.
+ *
+ * Clients are served one at a time, so the socket is given a send and
+ * receive timeout to stop an idle or slow client from stalling every
+ * other scrape.
+ *
+ * Return: None.
+ */
+static void serve_client(int fd);
+
+/**
+ * open_listener() - Create the listening socket.
+ * @sock_path: Unix socket path (NULL to use a TCP port).
+ * @port: Local TCP port (only used if `sock_path` is NULL).
+ *
+ * TCP sockets are only bound to the loopback address.
+ *
+ * Return: Socket file descriptor or -1 on error.
+ */
+static int open_listener(const char *sock_path, int port);
+
+/**
+ * on_signal() - Signal handler for SIGINT/SIGTERM.
+ * @sig: Signal number.
+ *
+ * Return: None.
+ */
+static void on_signal(int sig);
+
+/*****************************************************************************/
+/* Global variables                                                          */
+/*****************************************************************************/
+
+static struct exporter exporter = {
+	.lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+static volatile sig_atomic_t quit = 0;
+
+/* Families are emitted in this order; each must be contiguous in the output. */
+static const struct metric_family families[NUM_SENSOR_TYPES] = {
+	{ AMI_SENSOR_TYPE_TEMP,    "ami_sensor_temperature_celsius", "celsius",  "Sensor temperature." },
+	{ AMI_SENSOR_TYPE_VOLTAGE, "ami_sensor_voltage_volts",       "volts",    "Sensor voltage."     },
+	{ AMI_SENSOR_TYPE_CURRENT, "ami_sensor_current_amperes",     "amperes",  "Sensor current."     },
+	{ AMI_SENSOR_TYPE_POWER,   "ami_sensor_power_watts",         "watts",    "Sensor power."       },
+};
+
+static const char *type_names[NUM_SENSOR_TYPES] = {
+	"temperature", "current", "voltage", "power"
+};
+
+static const char short_options[] = "hs:p:i:";
+
+static const struct option long_options[] = {
+	{ "help",     no_argument,       NULL, 'h' },
+	{ "socket",   required_argument, NULL, 's' },
+	{ "port",     required_argument, NULL, 'p' },
+	{ "interval", required_argument, NULL, 'i' },
+	{ },
+};
+
+static const char help_msg[] = \
+	EXPORTER_NAME " - Export AMI sensor readings as OpenMetrics text\r\n"
+	"\r\nUsage:\r\n"
+	"\t" EXPORTER_NAME " [-p <port> | -s <path>] [-i <ms>]\r\n"
+	"\r\nOptions:\r\n"
+	"\t-h --help             Show this screen\r\n"
+	"\t-p --port <port>      Serve on 127.0.0.1:<port> (default 9760)\r\n"
+	"\t-s --socket <path>    Serve on a Unix socket instead of a TCP port\r\n"
+	"\t-i --interval <ms>    Sensor sampling interval (default 1000)\r\n"
+	"\r\nMetrics are served over HTTP at " HTTP_METRICS_PATH ".\r\n"
+;
+
+/*****************************************************************************/
+/* Local function definitions                                                */
+/*****************************************************************************/
+
+/*
+ * Sensor watch callback.
+ */
+static void on_sensor_event(ami_device *dev, const struct ami_sensor_event *event,
+	void *data)
+{
+	struct exp_device *edev = (struct exp_device*)data;
+	int i = 0;
+
+	if (!edev || !event)
+		return;
+
+	pthread_mutex_lock(&exporter.lock);
+
+	for (i = 0; i < edev->num_metrics; i++) {
+		struct metric *m = &edev->metrics[i];
+
+		if ((m->type == event->type) &&
+				(strcmp(m->sensor_name, event->sensor_name) == 0)) {
+			m->value = event->value;
+			m->status = event->status;
+			exporter.dirty = true;
+			break;
+		}
+	}
+
+	pthread_mutex_unlock(&exporter.lock);
+}
+
+/*
+ * Build the metric list for a device.
+ */
+static int add_device_metrics(struct exp_device *edev)
+{
+	struct ami_sensor *sensors = NULL;
+	struct ami_sensor *s = NULL;
+	int num_total = 0;
+	int n = 0;
+
+	if (ami_sensor_get_sensors(edev->dev, &sensors, &n) != AMI_STATUS_OK)
+		return EXIT_FAILURE;
+
+	if (ami_sensor_get_num_total(edev->dev, &num_total) != AMI_STATUS_OK)
+		return EXIT_FAILURE;
+
+	if (num_total <= 0)
+		return EXIT_SUCCESS;
+
+	edev->metrics = (struct metric*)calloc(num_total, sizeof(struct metric));
+
+	if (!edev->metrics)
+		return EXIT_FAILURE;
+
+	for (s = sensors; s && (edev->num_metrics < num_total); s = s->next) {
+		uint32_t type = AMI_SENSOR_TYPE_INVALID;
+		int i = 0;
+
+		if (ami_sensor_get_type(edev->dev, s->name, &type) != AMI_STATUS_OK)
+			continue;
+
+		for (i = 0; (i < NUM_SENSOR_TYPES) && (edev->num_metrics < num_total); i++) {
+			struct metric *m = &edev->metrics[edev->num_metrics];
+			enum ami_sensor_unit_mod mod = AMI_SENSOR_UNIT_MOD_NONE;
+			int ret = AMI_STATUS_ERROR;
+
+			if (!(type & (1 << i)))
+				continue;
+
+			switch (1 << i) {
+			case AMI_SENSOR_TYPE_TEMP:
+				ret = ami_sensor_get_temp_unit_mod(edev->dev, s->name, &mod);
+				break;
+
+			case AMI_SENSOR_TYPE_CURRENT:
+				ret = ami_sensor_get_current_unit_mod(edev->dev, s->name, &mod);
+				break;
+
+			case AMI_SENSOR_TYPE_VOLTAGE:
+				ret = ami_sensor_get_voltage_unit_mod(edev->dev, s->name, &mod);
+				break;
+
+			case AMI_SENSOR_TYPE_POWER:
+				ret = ami_sensor_get_power_unit_mod(edev->dev, s->name, &mod);
+				break;
+
+			default:
+				break;
+			}
+
+			if (ret != AMI_STATUS_OK)
+				continue;
+
+			strncpy(m->sensor_name, s->name, AMI_SENSOR_MAX_STR - 1);
+			m->type = (enum ami_sensor_type)(1 << i);
+			m->mod = mod;
+			m->status = AMI_SENSOR_STATUS_INVALID;
+			edev->num_metrics++;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Append formatted text to the rendered output.
+ */
+static int text_append(const char *fmt, ...)
+{
+	va_list args;
+	int n = 0;
+
+	for (;;) {
+		size_t avail = exporter.text_size - exporter.text_len;
+
+		va_start(args, fmt);
+		n = vsnprintf(&exporter.text[exporter.text_len], avail, fmt, args);
+		va_end(args);
+
+		if (n < 0)
+			return EXIT_FAILURE;
+
+		if ((size_t)n < avail)
+			break;
+
+		/* Grow and retry. */
+		{
+			size_t size = exporter.text_size * 2;
+			char *text = NULL;
+
+			while (size - exporter.text_len <= (size_t)n)
+				size *= 2;
+
+			text = (char*)realloc(exporter.text, size);
+
+			if (!text)
+				return EXIT_FAILURE;
+
+			exporter.text = text;
+			exporter.text_size = size;
+		}
+	}
+
+	exporter.text_len += n;
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Format a sensor value in its base unit.
+ */
+static void format_value(long value, enum ami_sensor_unit_mod mod, char *buf)
+{
+	unsigned long mag = (value < 0) ? (0UL - (unsigned long)value) : ((unsigned long)value);
+	unsigned long div = 1;
+	int digits = 0;
+	int i = 0;
+
+	if (mod >= 0) {
+		for (i = 0; i < mod; i++)
+			value *= 10;
+
+		snprintf(buf, VALUE_STR_SIZE, "%ld", value);
+		return;
+	}
+
+	digits = (-mod > MAX_FRAC_DIGITS) ? (MAX_FRAC_DIGITS) : (-mod);
+
+	for (i = 0; i < digits; i++)
+		div *= 10;
+
+	snprintf(buf, VALUE_STR_SIZE, "%s%lu.%0*lu",
+		(value < 0) ? ("-") : (""), mag / div, digits, mag % div);
+}
+
+/*
+ * Render all metrics as OpenMetrics text.
+ */
+static int render_metrics(void)
+{
+	char val[VALUE_STR_SIZE] = { 0 };
+	int f = 0, d = 0, i = 0, t = 0;
+	int ret = EXIT_SUCCESS;
+
+	exporter.text_len = 0;
+	exporter.text[0] = '\0';
+
+	for (f = 0; (f < NUM_SENSOR_TYPES) && (ret == EXIT_SUCCESS); f++) {
+		const struct metric_family *fam = &families[f];
+
+		ret |= text_append(
+			"# TYPE %s gauge\n# UNIT %s %s\n# HELP %s %s\n",
+			fam->name, fam->name, fam->unit, fam->name, fam->help
+		);
+
+		for (d = 0; d < exporter.num_devs; d++) {
+			struct exp_device *edev = &exporter.devs[d];
+
+			for (i = 0; i < edev->num_metrics; i++) {
+				struct metric *m = &edev->metrics[i];
+
+				if ((m->type != fam->type) ||
+						((m->status != AMI_SENSOR_STATUS_OK) &&
+						(m->status != AMI_SENSOR_STATUS_OK_CACHED)))
+					continue;
+
+				format_value(m->value, m->mod, val);
+				ret |= text_append(
+					"%s{device=\"%s\",sensor=\"%s\"} %s\n",
+					fam->name, edev->bdf, m->sensor_name, val
+				);
+			}
+		}
+	}
+
+	/* Status of every reported sensor, including those with no valid value. */
+	ret |= text_append(
+		"# TYPE ami_sensor_status gauge\n"
+		"# HELP ami_sensor_status Sensor status code (1 = present and valid).\n"
+	);
+
+	for (d = 0; d < exporter.num_devs; d++) {
+		struct exp_device *edev = &exporter.devs[d];
+
+		for (i = 0; i < edev->num_metrics; i++) {
+			struct metric *m = &edev->metrics[i];
+
+			if (m->status == AMI_SENSOR_STATUS_INVALID)
+				continue;
+
+			for (t = 0; t < NUM_SENSOR_TYPES; t++) {
+				if (m->type == (enum ami_sensor_type)(1 << t))
+					break;
+			}
+
+			ret |= text_append(
+				"ami_sensor_status{device=\"%s\",sensor=\"%s\",type=\"%s\"} %d\n",
+				edev->bdf, m->sensor_name,
+				(t < NUM_SENSOR_TYPES) ? (type_names[t]) : ("unknown"),
+				(m->status == AMI_SENSOR_STATUS_OK_CACHED) ?
+					(AMI_SENSOR_STATUS_OK) : (m->status)
+			);
+		}
+	}
+
+	ret |= text_append("# EOF\n");
+
+	/* A partial document must never be served; render again next time. */
+	exporter.dirty = (ret != EXIT_SUCCESS);
+
+	return ret;
+}
+
+/*
+ * Write an entire buffer to a socket.
+ */
+static int write_all(int fd, const char *buf, size_t len)
+{
+	while (len > 0) {
+		ssize_t n = send(fd, buf, len, MSG_NOSIGNAL);
+
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+
+			return EXIT_FAILURE;
+		}
+
+		buf += n;
+		len -= n;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Handle a single HTTP request.
+ */
+static void serve_client(int fd)
+{
+	struct timeval tv = {
+		.tv_sec  = CLIENT_TIMEOUT_MS / 1000,
+		.tv_usec = (CLIENT_TIMEOUT_MS % 1000) * 1000,
+	};
+	char req[REQUEST_BUF_SIZE] = { 0 };
+	char hdr[REQUEST_BUF_SIZE] = { 0 };
+	size_t req_len = 0;
+	size_t body_len = 0;
+	bool rendered = true;
+	bool ok = false;
+	int n = 0;
+
+	setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+	setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+	/* Read until the end of the request headers. */
+	while (req_len < (sizeof(req) - 1)) {
+		ssize_t r = recv(fd, &req[req_len], sizeof(req) - 1 - req_len, 0);
+
+		/* A timeout (EAGAIN) drops the client like any other error. */
+		if ((r < 0) && (errno == EINTR) && !quit)
+			continue;
+
+		if (r <= 0)
+			break;
+
+		req_len += r;
+		req[req_len] = '\0';
+
+		if (strstr(req, "\r\n\r\n") || strstr(req, "\n\n"))
+			break;
+	}
+
+	if ((strncmp(req, "GET ", 4) == 0) &&
+			(strncmp(&req[4], HTTP_METRICS_PATH, strlen(HTTP_METRICS_PATH)) == 0)) {
+		char c = req[4 + strlen(HTTP_METRICS_PATH)];
+
+		ok = ((c == ' ') || (c == '?'));
+	}
+
+	if (!ok) {
+		n = snprintf(hdr, sizeof(hdr),
+			"HTTP/1.1 404 Not Found\r\n"
+			"Content-Length: 0\r\n"
+			"Connection: close\r\n\r\n");
+		write_all(fd, hdr, n);
+		return;
+	}
+
+	/*
+	 * Only re-render if a sensor changed since the last scrape; otherwise
+	 * the cached text is served as-is. The text is copied out so the lock
+	 * is not held while writing to a (possibly slow) client. A failed
+	 * render or copy leaves `body_len` at 0 and the scrape gets a 500
+	 * rather than a partial document.
+	 */
+	pthread_mutex_lock(&exporter.lock);
+
+	if (exporter.dirty)
+		rendered = (render_metrics() == EXIT_SUCCESS);
+
+	if (rendered && (exporter.text_len > exporter.body_size)) {
+		char *tmp = (char*)realloc(exporter.body, exporter.text_len);
+
+		if (tmp) {
+			exporter.body = tmp;
+			exporter.body_size = exporter.text_len;
+		}
+	}
+
+	if (rendered && exporter.body && (exporter.text_len <= exporter.body_size)) {
+		memcpy(exporter.body, exporter.text, exporter.text_len);
+		body_len = exporter.text_len;
+	}
+
+	pthread_mutex_unlock(&exporter.lock);
+
+	if (body_len == 0) {
+		n = snprintf(hdr, sizeof(hdr),
+			"HTTP/1.1 500 Internal Server Error\r\n"
+			"Content-Length: 0\r\n"
+			"Connection: close\r\n\r\n");
+		write_all(fd, hdr, n);
+		return;
+	}
+
+	n = snprintf(hdr, sizeof(hdr),
+		"HTTP/1.1 200 OK\r\n"
+		"Content-Type: " OPENMETRICS_TYPE "\r\n"
+		"Content-Length: %zu\r\n"
+		"Connection: close\r\n\r\n",
+		body_len);
+
+	if (write_all(fd, hdr, n) == EXIT_SUCCESS)
+		write_all(fd, exporter.body, body_len);
+}
+
+/*
+ * Create the listening socket.
+ */
+static int open_listener(const char *sock_path, int port)
+{
+	int fd = -1;
+	int one = 1;
+
+	if (sock_path) {
+		struct sockaddr_un addr = { 0 };
+
+		if (strlen(sock_path) >= sizeof(addr.sun_path)) {
+			fprintf(stderr, "ERROR: socket path is too long\r\n");
+			return -1;
+		}
+
+		fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+		if (fd < 0)
+			return -1;
+
+		addr.sun_family = AF_UNIX;
+		strcpy(addr.sun_path, sock_path);
+		unlink(sock_path);
+
+		if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0)
+			goto fail;
+	} else {
+		struct sockaddr_in addr = { 0 };
+
+		fd = socket(AF_INET, SOCK_STREAM, 0);
+
+		if (fd < 0)
+			return -1;
+
+		setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+		addr.sin_family = AF_INET;
+		addr.sin_port = htons(port);
+		addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+		if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0)
+			goto fail;
+	}
+
+	if (listen(fd, LISTEN_BACKLOG) != 0)
+		goto fail;
+
+	return fd;
+
+fail:
+	fprintf(stderr, "ERROR: could not listen - %s\r\n", strerror(errno));
+	close(fd);
+	return -1;
+}
+
+/*
+ * Signal handler for SIGINT/SIGTERM.
+ */
+static void on_signal(int sig)
+{
+	quit = 1;
+}
+
+/*****************************************************************************/
+/* Main                                                                      */
+/*****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	int ret = EXIT_FAILURE;
+	struct sigaction sa = { 0 };
+	ami_device **devs = NULL;
+	const char *sock_path = NULL;
+	int port = DEFAULT_PORT;
+	uint32_t interval = DEFAULT_INTERVAL_MS;
+	int num_devs = 0;
+	int listen_fd = -1;
+	int opt = 0;
+	int i = 0;
+
+	while ((opt = getopt_long(argc, argv, short_options, long_options, NULL)) != -1) {
+		switch (opt) {
+		case 'h':
+			printf("%s", help_msg);
+			return EXIT_SUCCESS;
+
+		case 's':
+			sock_path = optarg;
+			break;
+
+		case 'p':
+			port = (int)strtol(optarg, NULL, 0);
+			break;
+
+		case 'i':
+			interval = (uint32_t)strtoul(optarg, NULL, 0);
+			break;
+
+		default:
+			fprintf(stderr, "%s", help_msg);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if ((interval == 0) || (!sock_path && ((port <= 0) || (port > UINT16_MAX)))) {
+		fprintf(stderr, "ERROR: invalid arguments\r\n%s", help_msg);
+		return EXIT_FAILURE;
+	}
+
+	/* Open every device once; handles stay open for the daemon lifetime. */
+	if (ami_dev_enumerate_all(&devs, &num_devs, true) != AMI_STATUS_OK) {
+		fprintf(stderr, "ERROR: no devices found - %s\r\n", ami_get_last_error());
+		return EXIT_FAILURE;
+	}
+
+	exporter.text = (char*)malloc(TEXT_INITIAL_SIZE);
+	exporter.devs = (struct exp_device*)calloc(num_devs, sizeof(struct exp_device));
+
+	if (!exporter.text || !exporter.devs) {
+		fprintf(stderr, "ERROR: could not allocate memory\r\n");
+		goto done;
+	}
+
+	exporter.text_size = TEXT_INITIAL_SIZE;
+	exporter.num_devs = num_devs;
+
+	for (i = 0; i < num_devs; i++) {
+		struct exp_device *edev = &exporter.devs[i];
+		uint16_t bdf = 0;
+
+		edev->dev = devs[i];
+		ami_dev_get_pci_bdf(edev->dev, &bdf);
+		snprintf(edev->bdf, sizeof(edev->bdf), AMI_BDF_FORMAT,
+			AMI_PCI_BUS(bdf), AMI_PCI_DEV(bdf), AMI_PCI_FUNC(bdf));
+
+		if (add_device_metrics(edev) != EXIT_SUCCESS)
+			fprintf(stderr, "WARNING: no sensors for device %s\r\n", edev->bdf);
+	}
+
+	/* Render an empty document so the first scrape never hits the devices. */
+	pthread_mutex_lock(&exporter.lock);
+	render_metrics();
+	pthread_mutex_unlock(&exporter.lock);
+
+	/*
+	 * Sampling happens on libami's per-device watch thread. Each sensor is
+	 * read once per interval and the callback only fires on a change, so a
+	 * scrape never touches the hardware.
+	 */
+	for (i = 0; i < num_devs; i++) {
+		struct exp_device *edev = &exporter.devs[i];
+		struct ami_sensor_watch_cfg cfg = {
+			.interval_ms      = interval,
+			.callback         = on_sensor_event,
+			.data             = edev,
+			.default_deadband = 0,
+		};
+
+		if (edev->num_metrics == 0)
+			continue;
+
+		if (ami_sensor_watch(edev->dev, &cfg, &edev->watch_id) == AMI_STATUS_OK)
+			edev->watching = true;
+		else
+			fprintf(stderr, "WARNING: could not watch device %s - %s\r\n",
+				edev->bdf, ami_get_last_error());
+	}
+
+	sa.sa_handler = on_signal;
+	sigemptyset(&sa.sa_mask);
+	sigaction(SIGINT, &sa, NULL);   /* No SA_RESTART so accept() is interrupted */
+	sigaction(SIGTERM, &sa, NULL);
+
+	if ((listen_fd = open_listener(sock_path, port)) < 0)
+		goto done;
+
+	if (sock_path)
+		printf("Serving %d device(s) on unix:%s\r\n", num_devs, sock_path);
+	else
+		printf("Serving %d device(s) on 127.0.0.1:%d\r\n", num_devs, port);
+
+	fflush(stdout);
+
+	while (!quit) {
+		int client = accept(listen_fd, NULL, NULL);
+
+		if (client < 0)
+			continue; /* EINTR or transient error; `quit` is re-checked */
+
+		serve_client(client);
+		close(client);
+	}
+
+	ret = EXIT_SUCCESS;
+
+done:
+	if (listen_fd >= 0) {
+		close(listen_fd);
+
+		if (sock_path)
+			unlink(sock_path);
+	}
+
+	if (exporter.devs) {
+		for (i = 0; i < num_devs; i++) {
+			if (exporter.devs[i].watching)
+				ami_sensor_unwatch(exporter.devs[i].dev, exporter.devs[i].watch_id);
+
+			free(exporter.devs[i].metrics);
+		}
+
+		free(exporter.devs);
+	}
+
+	ami_dev_delete_all(&devs, num_devs);
+	free(exporter.text);
+	free(exporter.body);
+	return ret;
+}
@@ -0,0 +1,362 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * test_ami_exporterd.c - Unit test file for ami_exporterd.c
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+/* Standard includes */
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+/* External includes */
+#include "cmocka.h"
+
+/* Exporter includes */
+#define main exporterd_main
+#include "ami_exporterd.c"  /* Including .c file to test static functions. */
+#undef main
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+#define RESPONSE_BUF_SIZE	(4096)
+
+/*****************************************************************************/
+/* Global variables                                                          */
+/*****************************************************************************/
+
+static bool fail_realloc = false;
+
+/*****************************************************************************/
+/* Redefinitions/Wrapping                                                    */
+/*****************************************************************************/
+
+extern void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+	return (fail_realloc) ? (NULL) : (__real_realloc(ptr, size));
+}
+
+const char *__wrap_ami_get_last_error(void)
+{
+	return "";
+}
+
+int __wrap_ami_dev_enumerate_all(ami_device ***devs, int *num, bool with_sensors)
+{
+	return AMI_STATUS_ERROR;
+}
+
+void __wrap_ami_dev_delete_all(ami_device ***devs, int num)
+{
+
+}
+
+int __wrap_ami_dev_get_pci_bdf(ami_device *dev, uint16_t *bdf)
+{
+	return AMI_STATUS_ERROR;
+}
+
+int __wrap_ami_sensor_get_sensors(ami_device *dev, struct ami_sensor **sensors, int *num)
+{
+	static struct ami_sensor sensor = { "fpga", NULL, NULL };
+
+	*sensors = &sensor;
+	*num = 1;
+	return AMI_STATUS_OK;
+}
+
+int __wrap_ami_sensor_get_num_total(ami_device *dev, int *num)
+{
+	*num = (int)mock();
+	return AMI_STATUS_OK;
+}
+
+int __wrap_ami_sensor_get_type(ami_device *dev, const char *sensor_name, uint32_t *type)
+{
+	*type = (uint32_t)mock();
+	return AMI_STATUS_OK;
+}
+
+int __wrap_ami_sensor_get_temp_unit_mod(ami_device *dev, const char *sensor_name,
+	enum ami_sensor_unit_mod *mod)
+{
+	*mod = AMI_SENSOR_UNIT_MOD_NONE;
+	return AMI_STATUS_OK;
+}
+
+int __wrap_ami_sensor_get_voltage_unit_mod(ami_device *dev, const char *sensor_name,
+	enum ami_sensor_unit_mod *mod)
+{
+	*mod = AMI_SENSOR_UNIT_MOD_MILLI;
+	return AMI_STATUS_OK;
+}
+
+int __wrap_ami_sensor_get_current_unit_mod(ami_device *dev, const char *sensor_name,
+	enum ami_sensor_unit_mod *mod)
+{
+	*mod = AMI_SENSOR_UNIT_MOD_MILLI;
+	return AMI_STATUS_OK;
+}
+
+int __wrap_ami_sensor_get_power_unit_mod(ami_device *dev, const char *sensor_name,
+	enum ami_sensor_unit_mod *mod)
+{
+	return AMI_STATUS_ERROR;
+}
+
+int __wrap_ami_sensor_watch(ami_device *dev, const struct ami_sensor_watch_cfg *cfg,
+	int *watch_id)
+{
+	return AMI_STATUS_ERROR;
+}
+
+int __wrap_ami_sensor_unwatch(ami_device *dev, int watch_id)
+{
+	return AMI_STATUS_OK;
+}
+
+/*****************************************************************************/
+/* Helpers                                                                   */
+/*****************************************************************************/
+
+/*
+ * Send `request` (if any) to `serve_client` over a socket pair and return
+ * the response in `buf`.
+ */
+static void scrape(const char *request, char *buf, size_t size)
+{
+	int sv[2] = { -1, -1 };
+	size_t len = 0;
+	ssize_t n = 0;
+
+	assert_int_equal(socketpair(AF_UNIX, SOCK_STREAM, 0, sv), 0);
+
+	if (request)
+		assert_int_equal(send(sv[1], request, strlen(request), 0), strlen(request));
+
+	serve_client(sv[0]);
+	close(sv[0]);
+
+	while ((len < size - 1) && ((n = recv(sv[1], &buf[len], size - 1 - len, 0)) > 0))
+		len += n;
+
+	buf[len] = '\0';
+	close(sv[1]);
+}
+
+/*
+ * Set up a single device with a temperature and a voltage reading.
+ */
+static int setup_exporter(void **state)
+{
+	static struct exp_device edev = { 0 };
+
+	memset(&edev, 0, sizeof(edev));
+	strcpy(edev.bdf, "c1:00.0");
+
+	will_return(__wrap_ami_sensor_get_num_total, 2);
+	will_return(__wrap_ami_sensor_get_type,
+		AMI_SENSOR_TYPE_TEMP | AMI_SENSOR_TYPE_VOLTAGE | AMI_SENSOR_TYPE_POWER);
+	assert_int_equal(add_device_metrics(&edev), EXIT_SUCCESS);
+	assert_int_equal(edev.num_metrics, 2);
+
+	exporter.devs = &edev;
+	exporter.num_devs = 1;
+	exporter.text = (char*)malloc(TEXT_INITIAL_SIZE);
+	exporter.text_size = TEXT_INITIAL_SIZE;
+	exporter.dirty = true;
+	assert_non_null(exporter.text);
+
+	return 0;
+}
+
+static int teardown_exporter(void **state)
+{
+	free(exporter.devs[0].metrics);
+	free(exporter.text);
+	free(exporter.body);
+	memset(&exporter.devs[0], 0, sizeof(exporter.devs[0]));
+	exporter.devs = NULL;
+	exporter.num_devs = 0;
+	exporter.text = NULL;
+	exporter.text_len = 0;
+	exporter.text_size = 0;
+	exporter.body = NULL;
+	exporter.body_size = 0;
+	fail_realloc = false;
+
+	return 0;
+}
+
+/*****************************************************************************/
+/* Tests                                                                     */
+/*****************************************************************************/
+
+void test_happy_format_value(void **state)
+{
+	char buf[VALUE_STR_SIZE] = { 0 };
+
+	format_value(45, AMI_SENSOR_UNIT_MOD_NONE, buf);
+	assert_string_equal(buf, "45");
+
+	format_value(12, AMI_SENSOR_UNIT_MOD_KILO, buf);
+	assert_string_equal(buf, "12000");
+
+	format_value(12345, AMI_SENSOR_UNIT_MOD_MILLI, buf);
+	assert_string_equal(buf, "12.345");
+
+	format_value(-5, AMI_SENSOR_UNIT_MOD_MILLI, buf);
+	assert_string_equal(buf, "-0.005");
+}
+
+void test_happy_serve_client_metrics(void **state)
+{
+	char buf[RESPONSE_BUF_SIZE] = { 0 };
+	const char *body = NULL;
+	unsigned long len = 0;
+
+	/* Only the temperature has been reported so far. */
+	exporter.devs[0].metrics[0].value = 45;
+	exporter.devs[0].metrics[0].status = AMI_SENSOR_STATUS_OK;
+
+	scrape("GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n", buf, sizeof(buf));
+
+	assert_memory_equal(buf, "HTTP/1.1 200 OK\r\n", strlen("HTTP/1.1 200 OK\r\n"));
+	assert_non_null(strstr(buf, "\r\nContent-Type: " OPENMETRICS_TYPE "\r\n"));
+	assert_non_null(strstr(buf, "\r\nConnection: close\r\n"));
+
+	body = strstr(buf, "\r\n\r\n");
+	assert_non_null(body);
+	body += 4;
+
+	assert_non_null(strstr(buf, "\r\nContent-Length: "));
+	len = strtoul(strstr(buf, "\r\nContent-Length: ") + strlen("\r\nContent-Length: "), NULL, 10);
+	assert_int_equal(len, strlen(body));
+
+	assert_string_equal(body,
+		"# TYPE ami_sensor_temperature_celsius gauge\n"
+		"# UNIT ami_sensor_temperature_celsius celsius\n"
+		"# HELP ami_sensor_temperature_celsius Sensor temperature.\n"
+		"ami_sensor_temperature_celsius{device=\"c1:00.0\",sensor=\"fpga\"} 45\n"
+		"# TYPE ami_sensor_voltage_volts gauge\n"
+		"# UNIT ami_sensor_voltage_volts volts\n"
+		"# HELP ami_sensor_voltage_volts Sensor voltage.\n"
+		"# TYPE ami_sensor_current_amperes gauge\n"
+		"# UNIT ami_sensor_current_amperes amperes\n"
+		"# HELP ami_sensor_current_amperes Sensor current.\n"
+		"# TYPE ami_sensor_power_watts gauge\n"
+		"# UNIT ami_sensor_power_watts watts\n"
+		"# HELP ami_sensor_power_watts Sensor power.\n"
+		"# TYPE ami_sensor_status gauge\n"
+		"# HELP ami_sensor_status Sensor status code (1 = present and valid).\n"
+		"ami_sensor_status{device=\"c1:00.0\",sensor=\"fpga\",type=\"temperature\"} 1\n"
+		"# EOF\n"
+	);
+
+	/* A change is picked up by the next scrape. */
+	exporter.devs[0].metrics[1].value = 850;
+	exporter.devs[0].metrics[1].status = AMI_SENSOR_STATUS_OK_CACHED;
+	exporter.dirty = true;
+
+	scrape("GET /metrics?x=1 HTTP/1.1\r\n\r\n", buf, sizeof(buf));
+	assert_non_null(strstr(buf,
+		"\nami_sensor_voltage_volts{device=\"c1:00.0\",sensor=\"fpga\"} 0.850\n"));
+	assert_non_null(strstr(buf,
+		"\nami_sensor_status{device=\"c1:00.0\",sensor=\"fpga\",type=\"voltage\"} 1\n"));
+}
+
+void test_fail_serve_client_not_found(void **state)
+{
+	char buf[RESPONSE_BUF_SIZE] = { 0 };
+
+	scrape("GET / HTTP/1.1\r\n\r\n", buf, sizeof(buf));
+	assert_string_equal(buf,
+		"HTTP/1.1 404 Not Found\r\n"
+		"Content-Length: 0\r\n"
+		"Connection: close\r\n\r\n");
+
+	scrape("GET /metricsfoo HTTP/1.1\r\n\r\n", buf, sizeof(buf));
+	assert_memory_equal(buf, "HTTP/1.1 404", strlen("HTTP/1.1 404"));
+
+	scrape("POST /metrics HTTP/1.1\r\n\r\n", buf, sizeof(buf));
+	assert_memory_equal(buf, "HTTP/1.1 404", strlen("HTTP/1.1 404"));
+}
+
+void test_fail_serve_client_idle(void **state)
+{
+	char buf[RESPONSE_BUF_SIZE] = { 0 };
+	time_t start = time(NULL);
+
+	/* A client which never sends a request must not stall the daemon. */
+	scrape(NULL, buf, sizeof(buf));
+	assert_true((time(NULL) - start) <= ((CLIENT_TIMEOUT_MS / 1000) + 1));
+	assert_memory_equal(buf, "HTTP/1.1 404", strlen("HTTP/1.1 404"));
+}
+
+void test_fail_serve_client_render(void **state)
+{
+	char buf[RESPONSE_BUF_SIZE] = { 0 };
+	const char *error =
+		"HTTP/1.1 500 Internal Server Error\r\n"
+		"Content-Length: 0\r\n"
+		"Connection: close\r\n\r\n";
+
+	exporter.devs[0].metrics[0].value = 45;
+	exporter.devs[0].metrics[0].status = AMI_SENSOR_STATUS_OK;
+
+	/* Failure path - the text cannot grow, so the render is incomplete */
+	free(exporter.text);
+	exporter.text = (char*)malloc(16);
+	exporter.text_size = 16;
+	assert_non_null(exporter.text);
+
+	fail_realloc = true;
+	scrape("GET /metrics HTTP/1.1\r\n\r\n", buf, sizeof(buf));
+	assert_string_equal(buf, error);
+	assert_true(exporter.dirty);
+
+	/* Happy path - the next scrape renders again */
+	fail_realloc = false;
+	scrape("GET /metrics HTTP/1.1\r\n\r\n", buf, sizeof(buf));
+	assert_memory_equal(buf, "HTTP/1.1 200 OK\r\n", strlen("HTTP/1.1 200 OK\r\n"));
+	assert_non_null(strstr(buf, "\n# EOF\n"));
+	assert_false(exporter.dirty);
+
+	/* Failure path - a longer render does not fit the old body */
+	exporter.devs[0].metrics[1].value = 850;
+	exporter.devs[0].metrics[1].status = AMI_SENSOR_STATUS_OK;
+	exporter.dirty = true;
+	assert_int_equal(render_metrics(), EXIT_SUCCESS);
+
+	fail_realloc = true;
+	scrape("GET /metrics HTTP/1.1\r\n\r\n", buf, sizeof(buf));
+	assert_string_equal(buf, error);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_happy_format_value),
+		cmocka_unit_test_setup_teardown(test_happy_serve_client_metrics,
+			setup_exporter, teardown_exporter),
+		cmocka_unit_test_setup_teardown(test_fail_serve_client_not_found,
+			setup_exporter, teardown_exporter),
+		cmocka_unit_test_setup_teardown(test_fail_serve_client_idle,
+			setup_exporter, teardown_exporter),
+		cmocka_unit_test_setup_teardown(test_fail_serve_client_render,
+			setup_exporter, teardown_exporter),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
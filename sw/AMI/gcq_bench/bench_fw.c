@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * bench_fw.c - gcq_bench wrapper around the firmware sGCQ driver (gcq_driver.c)
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+/* Standard includes */
+#include <stdint.h>
+#include <stddef.h>
+
+/* Firmware includes */
+#include "gcq.h"
+#include "gcq_internal.h"
+
+/* Bench includes */
+#include "gcq_bench.h"
+
+/*****************************************************************************/
+/* Global variables                                                          */
+/*****************************************************************************/
+
+static GCQInstance *fw_inst = NULL;
+static uint32_t fw_sq_size = 0;
+static uint32_t fw_cq_size = 0;
+
+/*****************************************************************************/
+/* Local function definitions                                                */
+/*****************************************************************************/
+
+/**
+ * fw_read_mem32() - Firmware memory read, see `asm/io.h` in the shims.
+ * @addr: Address to read.
+ *
+ * Return: The value read.
+ */
+static uint32_t fw_read_mem32(uint64_t addr)
+{
+	uint32_t val = *(volatile uint32_t *)(uintptr_t)addr;
+
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	return val;
+}
+
+/**
+ * fw_write_mem32() - Firmware memory write, see `asm/io.h` in the shims.
+ * @addr: Address to write.
+ * @val: Value to write.
+ *
+ * Return: None.
+ */
+static void fw_write_mem32(uint64_t addr, uint32_t val)
+{
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	*(volatile uint32_t *)(uintptr_t)addr = val;
+}
+
+static const GCQIOAccess fw_io = {
+	.xGCQReadMem32  = fw_read_mem32,
+	.xGCQWriteMem32 = fw_write_mem32,
+};
+
+/**
+ * map_ret() - Map a firmware driver return code.
+ * @err: Driver return code.
+ *
+ * Return: enum bench_ret
+ */
+static enum bench_ret map_ret(GCQ_ERRORS_TYPE err)
+{
+	switch (err) {
+	case GCQ_ERRORS_NONE:
+		return BENCH_OK;
+
+	case GCQ_ERRORS_CONSUMER_NO_DATA_RECEIVED:
+	case GCQ_ERRORS_PRODUCER_NO_FREE_SLOTS:
+		return BENCH_AGAIN;
+
+	default:
+		return BENCH_ERR;
+	}
+}
+
+/*****************************************************************************/
+/* Public function definitions                                               */
+/*****************************************************************************/
+
+/*
+ * Initialise the firmware (producer mode) instance.
+ */
+enum bench_ret bench_fw_init(void *base, void *ring, uint32_t ring_len,
+	uint32_t sq_size, uint32_t cq_size, uint32_t *num_slots)
+{
+	GCQ_ERRORS_TYPE err = GCQ_ERRORS_NONE;
+
+	if (!num_slots)
+		return BENCH_ERR;
+
+	err = xGCQInit(&fw_inst, &fw_io, GCQ_MODE_TYPE_PRODUCER_MODE,
+		(uint64_t)(uintptr_t)base, (uint64_t)(uintptr_t)ring,
+		ring_len, sq_size, cq_size);
+
+	if (err != GCQ_ERRORS_NONE)
+		return BENCH_ERR;
+
+	fw_sq_size = sq_size;
+	fw_cq_size = cq_size;
+	*num_slots = fw_inst->xGCQSq.ulRingNumSlots;
+
+	return BENCH_OK;
+}
+
+/*
+ * Release the firmware instance.
+ */
+void bench_fw_deinit(void)
+{
+	if (fw_inst)
+		xGCQDeinit(fw_inst);
+
+	fw_inst = NULL;
+}
+
+/*
+ * Consume requests from the SQ.
+ */
+enum bench_ret bench_fw_consume(uint8_t *buf, uint32_t max, int batch, uint32_t *num)
+{
+	enum bench_ret ret = BENCH_ERR;
+
+	*num = 0;
+
+	if (batch)
+		return map_ret(xGCQConsumeDataBatch(fw_inst, buf, fw_sq_size, max, num));
+
+	ret = map_ret(xGCQConsumeData(fw_inst, buf, fw_sq_size));
+	if (ret == BENCH_OK)
+		*num = 1;
+
+	return ret;
+}
+
+/*
+ * Produce responses onto the CQ.
+ */
+enum bench_ret bench_fw_produce(uint8_t *buf, uint32_t count, int batch, uint32_t *num)
+{
+	enum bench_ret ret = BENCH_ERR;
+
+	*num = 0;
+
+	if (batch)
+		return map_ret(xGCQProduceDataBatch(fw_inst, buf, fw_cq_size, count, num));
+
+	ret = map_ret(xGCQProduceData(fw_inst, buf, fw_cq_size));
+	if (ret == BENCH_OK)
+		*num = 1;
+
+	return ret;
+}
+
+/*
+ * Run the completion coalescing timer.
+ */
+void bench_fw_service(uint32_t now_ms)
+{
+	(void)xGCQServiceCoalescing(fw_inst, now_ms);
+}
@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * bench_host.c - gcq_bench wrapper around the host sGCQ driver (ami_gcq.c)
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+/* Standard includes */
+#include <stdint.h>
+#include <string.h>
+
+/* Driver includes */
+#include "ami_gcq.h"
+
+/* Bench includes */
+#include "gcq_bench.h"
+
+/*****************************************************************************/
+/* Global variables                                                          */
+/*****************************************************************************/
+
+static GCQCfg host_cfg = { 0 };
+
+/*****************************************************************************/
+/* Public function definitions                                               */
+/*****************************************************************************/
+
+/*
+ * Open and attach the host (consumer mode) instance.
+ */
+enum bench_ret bench_host_open(void *base, void *ring, uint32_t ring_len,
+	uint32_t sq_size, uint32_t cq_size,
+	uint32_t coalesce_count, uint32_t coalesce_delay_ms)
+{
+	uint32_t ret = GCQ_ERRORS_NONE;
+
+	ret = gcq_init();
+	if ((ret != GCQ_ERRORS_NONE) && (ret != GCQ_ERRORS_DRIVER_IN_USE))
+		return BENCH_ERR;
+
+	memset(&host_cfg, 0, sizeof(host_cfg));
+	host_cfg.ullBaseAddr = (uint64_t)(uintptr_t)base;
+	host_cfg.ullRingAddr = (uint64_t)(uintptr_t)ring;
+	host_cfg.ulRingLength = ring_len;
+	host_cfg.ulSQSlotSize = sq_size;
+	host_cfg.ulCQSlotSize = cq_size;
+	host_cfg.ulCoalesceCount = coalesce_count;
+	host_cfg.ulCoalesceDelayMs = coalesce_delay_ms;
+
+	return (gcq_open(&host_cfg) == GCQ_ERRORS_NONE) ? (BENCH_OK) : (BENCH_ERR);
+}
+
+/*
+ * Close the host instance.
+ */
+void bench_host_close(void)
+{
+	gcq_close(&host_cfg);
+}
+
+/*
+ * Produce one request onto the SQ.
+ */
+enum bench_ret bench_host_submit(uint8_t *buf)
+{
+	switch (gcq_write(&host_cfg, buf, host_cfg.ulSQSlotSize, 0)) {
+	case GCQ_ERRORS_NONE:
+		return BENCH_OK;
+
+	case GCQ_ERRORS_PRODUCER_NO_FREE_SLOTS:
+		return BENCH_AGAIN;
+
+	default:
+		return BENCH_ERR;
+	}
+}
+
+/*
+ * Consume one response from the CQ.
+ */
+enum bench_ret bench_host_complete(uint8_t *buf)
+{
+	uint32_t size = host_cfg.ulCQSlotSize;
+
+	switch (gcq_read(&host_cfg, buf, &size, 0)) {
+	case GCQ_ERRORS_NONE:
+		return BENCH_OK;
+
+	case GCQ_ERRORS_CONSUMER_NO_DATA_RECEIVED:
+		return BENCH_AGAIN;
+
+	default:
+		return BENCH_ERR;
+	}
+}
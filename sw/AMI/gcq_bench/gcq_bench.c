@@ -0,0 +1,568 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * gcq_bench.c - User space benchmark and stress test for the sGCQ transport.
+ *               The host driver ring (ami_gcq.c) and the firmware driver ring
+ *               (gcq_driver.c) are run against each other in two threads over
+ *               an anonymous mapping standing in for the sGCQ BAR.
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+/* Standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+/* Bench includes */
+#include "gcq_bench.h"
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+#define NS_PER_S		(1000000000ULL)
+#define NS_PER_US		(1000ULL)
+#define NS_PER_MS		(1000000ULL)
+
+/* Register block in front of the ring, covers the tail pointer registers */
+#define BENCH_REG_BLOCK_SIZE	(0x1000)
+
+#define BENCH_DEFAULT_OPS	(1000000)
+#define BENCH_DEFAULT_RING_LEN	(0x1000)	/* HAL_RPU_RING_BUFFER_LEN */
+#define BENCH_DEFAULT_SQ_SIZE	(512)		/* AMC_PROXY_REQUEST_SIZE */
+#define BENCH_DEFAULT_CQ_SIZE	(16)		/* AMC_PROXY_RESPONSE_SIZE */
+
+/* Give up if neither side makes progress for this long */
+#define BENCH_STALL_TIMEOUT_NS	(5 * NS_PER_S)
+
+/*****************************************************************************/
+/* Structs                                                                   */
+/*****************************************************************************/
+
+/**
+ * struct bench_msg - Header of every request, echoed back in the response.
+ * @seq: Request sequence number.
+ * @rsvd: Reserved.
+ * @stamp_ns: Time the request was submitted.
+ */
+struct bench_msg {
+	uint32_t seq;
+	uint32_t rsvd;
+	uint64_t stamp_ns;
+};
+
+/**
+ * struct bench_cfg - Benchmark parameters.
+ * @ops: Number of request/response round trips.
+ * @ring_len: Length of the ring buffer.
+ * @sq_size: Submission queue slot size.
+ * @cq_size: Completion queue slot size.
+ * @window: Max requests in flight, 0 for as many as the ring holds.
+ * @fw_delay_us: Time the firmware spends on each request.
+ * @batch: Firmware uses the batched ring API.
+ * @coalesce_count: Completions per CQ pointer update, 0 to disable.
+ * @coalesce_delay_ms: Max time a completion is held back.
+ */
+struct bench_cfg {
+	uint32_t ops;
+	uint32_t ring_len;
+	uint32_t sq_size;
+	uint32_t cq_size;
+	uint32_t window;
+	uint32_t fw_delay_us;
+	bool     batch;
+	uint32_t coalesce_count;
+	uint32_t coalesce_delay_ms;
+};
+
+/**
+ * struct bench_stats - Counters collected during a run.
+ * @sq_full: Host submits refused because the SQ was full.
+ * @cq_empty: Host polls which found no response.
+ * @sq_empty: Firmware polls which found no request.
+ * @cq_full: Firmware produces refused because the CQ was full.
+ * @fw_calls: Firmware consume calls which returned requests.
+ * @fw_max_batch: Largest number of requests returned by one consume call.
+ * @seq_errors: Responses received out of order.
+ * @drv_errors: Unexpected driver return codes.
+ */
+struct bench_stats {
+	uint64_t sq_full;
+	uint64_t cq_empty;
+	uint64_t sq_empty;
+	uint64_t cq_full;
+	uint64_t fw_calls;
+	uint32_t fw_max_batch;
+	uint32_t seq_errors;
+	uint32_t drv_errors;
+};
+
+/*****************************************************************************/
+/* Global variables                                                          */
+/*****************************************************************************/
+
+static struct bench_cfg cfg = {
+	.ops      = BENCH_DEFAULT_OPS,
+	.ring_len = BENCH_DEFAULT_RING_LEN,
+	.sq_size  = BENCH_DEFAULT_SQ_SIZE,
+	.cq_size  = BENCH_DEFAULT_CQ_SIZE,
+};
+
+static struct bench_stats stats = { 0 };
+static uint32_t num_slots = 0;
+static uint64_t *latency = NULL;
+static uint64_t elapsed_ns = 0;
+static bool stop = false;
+
+static const char short_options[] = "hn:l:s:c:w:d:bC:D:";
+
+static const struct option long_options[] = {
+	{ "help",           no_argument,       NULL, 'h' },
+	{ "ops",            required_argument, NULL, 'n' },
+	{ "ring-len",       required_argument, NULL, 'l' },
+	{ "sq-size",        required_argument, NULL, 's' },
+	{ "cq-size",        required_argument, NULL, 'c' },
+	{ "window",         required_argument, NULL, 'w' },
+	{ "fw-delay",       required_argument, NULL, 'd' },
+	{ "batch",          no_argument,       NULL, 'b' },
+	{ "coalesce-count", required_argument, NULL, 'C' },
+	{ "coalesce-delay", required_argument, NULL, 'D' },
+	{ 0 },
+};
+
+static const char help_msg[] = \
+	"gcq_bench - sGCQ transport benchmark (host ring vs firmware ring)\r\n"
+	"\r\n"
+	"Usage:\r\n"
+	"\tgcq_bench [options]\r\n"
+	"\r\n"
+	"Options:\r\n"
+	"\t-h --help                  Show this screen\r\n"
+	"\t-n --ops <n>               Number of round trips (default %u)\r\n"
+	"\t-l --ring-len <bytes>      Ring buffer length (default %u)\r\n"
+	"\t-s --sq-size <bytes>       SQ slot size (default %u)\r\n"
+	"\t-c --cq-size <bytes>       CQ slot size (default %u)\r\n"
+	"\t-w --window <n>            Max requests in flight (default: ring size)\r\n"
+	"\t-d --fw-delay <us>         Firmware service time per request (default 0)\r\n"
+	"\t-b --batch                 Firmware uses the batched consume/produce API\r\n"
+	"\t-C --coalesce-count <n>    Completions per CQ update (default 0, off)\r\n"
+	"\t-D --coalesce-delay <ms>   Max time a completion is held back (default 0)\r\n"
+	"\r\n"
+	"A short ring with a firmware delay keeps both queues full; the number of\r\n"
+	"ring wraps is reported alongside the latency distribution.\r\n";
+
+/*****************************************************************************/
+/* Local function definitions                                                */
+/*****************************************************************************/
+
+/**
+ * now_ns() - Read the monotonic clock.
+ *
+ * Return: Current time in nanoseconds.
+ */
+static uint64_t now_ns(void)
+{
+	struct timespec ts = { 0 };
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * NS_PER_S) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * spin_ns() - Busy wait, standing in for firmware request handling.
+ * @ns: Time to wait.
+ *
+ * Return: None.
+ */
+static void spin_ns(uint64_t ns)
+{
+	uint64_t end = now_ns() + ns;
+
+	while (now_ns() < end)
+		;
+}
+
+/**
+ * parse_u32() - Parse a numeric option.
+ * @arg: Option argument.
+ * @val: Variable to hold the value.
+ *
+ * Return: true if the argument was a valid number.
+ */
+static bool parse_u32(const char *arg, uint32_t *val)
+{
+	char *end = NULL;
+	unsigned long v = strtoul(arg, &end, 0);
+
+	if (!arg[0] || *end || (v > UINT32_MAX))
+		return false;
+
+	*val = (uint32_t)v;
+	return true;
+}
+
+/**
+ * cmp_u64() - qsort comparator.
+ * @a: First value.
+ * @b: Second value.
+ *
+ * Return: <0, 0 or >0.
+ */
+static int cmp_u64(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a;
+	uint64_t y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+/**
+ * percentile_us() - Pick a percentile from sorted latencies.
+ * @sorted: Sorted latencies in ns.
+ * @n: Number of latencies.
+ * @q: Percentile as a fraction.
+ *
+ * Return: Latency in us.
+ */
+static double percentile_us(const uint64_t *sorted, uint32_t n, double q)
+{
+	return (double)sorted[(uint32_t)((double)(n - 1) * q)] / NS_PER_US;
+}
+
+/**
+ * fw_thread() - Firmware side: echo every request back as a response.
+ * @arg: Unused.
+ *
+ * Return: NULL
+ */
+static void *fw_thread(void *arg)
+{
+	uint32_t max = (cfg.batch) ? (num_slots) : (1);
+	uint8_t *req = calloc(max, cfg.sq_size);
+	uint8_t *rsp = calloc(max, cfg.cq_size);
+	uint32_t n = 0, i = 0, done = 0, k = 0;
+	enum bench_ret ret = BENCH_OK;
+
+	if (!req || !rsp) {
+		stats.drv_errors++;
+		goto out;
+	}
+
+	while (!__atomic_load_n(&stop, __ATOMIC_ACQUIRE)) {
+		ret = bench_fw_consume(req, max, cfg.batch, &n);
+
+		if (ret == BENCH_AGAIN) {
+			stats.sq_empty++;
+			bench_fw_service((uint32_t)(now_ns() / NS_PER_MS));
+			sched_yield();
+			continue;
+		} else if (ret != BENCH_OK) {
+			stats.drv_errors++;
+			break;
+		}
+
+		stats.fw_calls++;
+		if (n > stats.fw_max_batch)
+			stats.fw_max_batch = n;
+
+		for (i = 0; i < n; i++) {
+			memset(rsp + (i * cfg.cq_size), 0, cfg.cq_size);
+			memcpy(rsp + (i * cfg.cq_size), req + (i * cfg.sq_size),
+				sizeof(struct bench_msg));
+
+			if (cfg.fw_delay_us)
+				spin_ns((uint64_t)cfg.fw_delay_us * NS_PER_US);
+		}
+
+		for (done = 0; done < n; done += k) {
+			ret = bench_fw_produce(rsp + (done * cfg.cq_size), n - done,
+				cfg.batch, &k);
+
+			if (ret == BENCH_AGAIN) {
+				stats.cq_full++;
+				k = 0;
+				bench_fw_service((uint32_t)(now_ns() / NS_PER_MS));
+				sched_yield();
+
+				if (__atomic_load_n(&stop, __ATOMIC_ACQUIRE))
+					break;
+			} else if (ret != BENCH_OK) {
+				stats.drv_errors++;
+				goto out;
+			}
+		}
+	}
+
+out:
+	free(req);
+	free(rsp);
+	return NULL;
+}
+
+/**
+ * host_thread() - Host side: keep the SQ busy and time every round trip.
+ * @arg: Unused.
+ *
+ * Return: NULL
+ */
+static void *host_thread(void *arg)
+{
+	uint8_t *req = calloc(1, cfg.sq_size);
+	uint8_t *rsp = calloc(1, cfg.cq_size);
+	struct bench_msg *msg = (struct bench_msg *)req;
+	struct bench_msg *echo = (struct bench_msg *)rsp;
+	uint32_t window = (cfg.window) ? (cfg.window) : (UINT32_MAX);
+	uint32_t submitted = 0, completed = 0;
+	uint64_t start = 0, last_progress = 0, t = 0;
+	enum bench_ret ret = BENCH_OK;
+
+	if (!req || !rsp) {
+		stats.drv_errors++;
+		goto out;
+	}
+
+	memset(req, 0xA5, cfg.sq_size);
+	start = last_progress = now_ns();
+
+	while (completed < cfg.ops) {
+		/* Submit until the window or the SQ is full */
+		while ((submitted < cfg.ops) && ((submitted - completed) < window)) {
+			msg->seq = submitted;
+			msg->stamp_ns = now_ns();
+
+			ret = bench_host_submit(req);
+			if (ret == BENCH_AGAIN) {
+				stats.sq_full++;
+				break;
+			} else if (ret != BENCH_OK) {
+				stats.drv_errors++;
+				goto out;
+			}
+
+			submitted++;
+		}
+
+		/* Reap everything which has been published */
+		while ((ret = bench_host_complete(rsp)) == BENCH_OK) {
+			t = now_ns();
+
+			if (echo->seq != completed)
+				stats.seq_errors++;
+
+			latency[completed++] = t - echo->stamp_ns;
+			last_progress = t;
+		}
+
+		if (ret == BENCH_AGAIN) {
+			stats.cq_empty++;
+			/* Let the firmware thread run if it shares our CPU */
+			sched_yield();
+		} else {
+			stats.drv_errors++;
+			goto out;
+		}
+
+		if ((now_ns() - last_progress) > BENCH_STALL_TIMEOUT_NS) {
+			fprintf(stderr, "ERROR: stalled at %u/%u completions\r\n",
+				completed, cfg.ops);
+			stats.drv_errors++;
+			goto out;
+		}
+	}
+
+	elapsed_ns = now_ns() - start;
+
+out:
+	__atomic_store_n(&stop, true, __ATOMIC_RELEASE);
+	if (completed < cfg.ops)
+		cfg.ops = completed;
+
+	free(req);
+	free(rsp);
+	return NULL;
+}
+
+/**
+ * report() - Print the results of a run.
+ *
+ * Return: None.
+ */
+static void report(void)
+{
+	double secs = (double)elapsed_ns / NS_PER_S;
+
+	printf("sGCQ benchmark\r\n");
+	printf("  slots        : %u per queue (SQ %u B, CQ %u B, ring %u B)\r\n",
+		num_slots, cfg.sq_size, cfg.cq_size, cfg.ring_len);
+	printf("  firmware     : %s API, %u us per request\r\n",
+		(cfg.batch) ? ("batched") : ("single slot"), cfg.fw_delay_us);
+
+	if (cfg.coalesce_count > 1)
+		printf("  coalescing   : %u completions / %u ms\r\n",
+			cfg.coalesce_count, cfg.coalesce_delay_ms);
+	else
+		printf("  coalescing   : off\r\n");
+
+	printf("  round trips  : %u (%u ring wraps)\r\n", cfg.ops,
+		(num_slots) ? (cfg.ops / num_slots) : (0));
+
+	if (cfg.ops && elapsed_ns) {
+		qsort(latency, cfg.ops, sizeof(*latency), cmp_u64);
+
+		printf("  throughput   : %.0f ops/s (%.1f MB/s SQ)\r\n",
+			cfg.ops / secs,
+			((double)cfg.ops * cfg.sq_size) / secs / (1024.0 * 1024.0));
+		printf("  latency (us) : p50 %.2f  p99 %.2f  p999 %.2f  max %.2f\r\n",
+			percentile_us(latency, cfg.ops, 0.50),
+			percentile_us(latency, cfg.ops, 0.99),
+			percentile_us(latency, cfg.ops, 0.999),
+			(double)latency[cfg.ops - 1] / NS_PER_US);
+	}
+
+	printf("  host         : %lu SQ full, %lu CQ empty polls\r\n",
+		(unsigned long)stats.sq_full, (unsigned long)stats.cq_empty);
+	printf("  firmware     : %lu SQ empty polls, %lu CQ full, %.2f req/consume (max %u)\r\n",
+		(unsigned long)stats.sq_empty, (unsigned long)stats.cq_full,
+		(stats.fw_calls) ? ((double)cfg.ops / stats.fw_calls) : (0.0),
+		stats.fw_max_batch);
+	printf("  errors       : %u out of order, %u driver\r\n",
+		stats.seq_errors, stats.drv_errors);
+}
+
+/*****************************************************************************/
+/* Public function definitions                                               */
+/*****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	int ret = EXIT_FAILURE;
+	int opt = 0;
+	bool ok = true;
+	size_t map_len = 0;
+	uint8_t *map = NULL;
+	pthread_t fw_tid, host_tid;
+
+	while ((opt = getopt_long(argc, argv, short_options, long_options, NULL)) != -1) {
+		switch (opt) {
+		case 'h':
+			printf(help_msg, BENCH_DEFAULT_OPS, BENCH_DEFAULT_RING_LEN,
+				BENCH_DEFAULT_SQ_SIZE, BENCH_DEFAULT_CQ_SIZE);
+			return EXIT_SUCCESS;
+
+		case 'n':
+			ok = parse_u32(optarg, &cfg.ops);
+			break;
+
+		case 'l':
+			ok = parse_u32(optarg, &cfg.ring_len);
+			break;
+
+		case 's':
+			ok = parse_u32(optarg, &cfg.sq_size);
+			break;
+
+		case 'c':
+			ok = parse_u32(optarg, &cfg.cq_size);
+			break;
+
+		case 'w':
+			ok = parse_u32(optarg, &cfg.window);
+			break;
+
+		case 'd':
+			ok = parse_u32(optarg, &cfg.fw_delay_us);
+			break;
+
+		case 'b':
+			cfg.batch = true;
+			break;
+
+		case 'C':
+			ok = parse_u32(optarg, &cfg.coalesce_count);
+			break;
+
+		case 'D':
+			ok = parse_u32(optarg, &cfg.coalesce_delay_ms);
+			break;
+
+		default:
+			ok = false;
+			break;
+		}
+
+		if (!ok) {
+			fprintf(stderr, "ERROR: invalid option, see --help\r\n");
+			return EXIT_FAILURE;
+		}
+	}
+
+	if ((cfg.ops == 0) ||
+			(cfg.sq_size < sizeof(struct bench_msg)) || (cfg.sq_size % 4) ||
+			(cfg.cq_size < sizeof(struct bench_msg)) || (cfg.cq_size % 4)) {
+		fprintf(stderr, "ERROR: need ops > 0 and 32-bit aligned slots of at least %zu bytes\r\n",
+			sizeof(struct bench_msg));
+		return EXIT_FAILURE;
+	}
+
+	latency = calloc(cfg.ops, sizeof(*latency));
+	map_len = BENCH_REG_BLOCK_SIZE + cfg.ring_len;
+	map = mmap(NULL, map_len, PROT_READ | PROT_WRITE,
+		MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+	if (!latency || (map == MAP_FAILED)) {
+		fprintf(stderr, "ERROR: out of memory\r\n");
+		goto unmap;
+	}
+
+	/* The firmware owns the ring and writes the header the host attaches to */
+	if (bench_fw_init(map, map + BENCH_REG_BLOCK_SIZE, cfg.ring_len,
+			cfg.sq_size, cfg.cq_size, &num_slots) != BENCH_OK) {
+		fprintf(stderr, "ERROR: firmware ring init failed (ring too short?)\r\n");
+		goto unmap;
+	}
+
+	if (bench_host_open(map, map + BENCH_REG_BLOCK_SIZE, cfg.ring_len,
+			cfg.sq_size, cfg.cq_size,
+			cfg.coalesce_count, cfg.coalesce_delay_ms) != BENCH_OK) {
+		fprintf(stderr, "ERROR: host ring attach failed\r\n");
+		goto fw_deinit;
+	}
+
+	if (pthread_create(&fw_tid, NULL, fw_thread, NULL)) {
+		fprintf(stderr, "ERROR: could not start firmware thread\r\n");
+		goto host_close;
+	}
+
+	if (pthread_create(&host_tid, NULL, host_thread, NULL)) {
+		fprintf(stderr, "ERROR: could not start host thread\r\n");
+		__atomic_store_n(&stop, true, __ATOMIC_RELEASE);
+		pthread_join(fw_tid, NULL);
+		goto host_close;
+	}
+
+	pthread_join(host_tid, NULL);
+	pthread_join(fw_tid, NULL);
+
+	report();
+
+	if ((stats.seq_errors == 0) && (stats.drv_errors == 0))
+		ret = EXIT_SUCCESS;
+
+host_close:
+	bench_host_close();
+fw_deinit:
+	bench_fw_deinit();
+unmap:
+	if (map != MAP_FAILED)
+		munmap(map, map_len);
+
+	free(latency);
+	return ret;
+}
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * gcq_bench.h - Glue between the benchmark and the two sGCQ ring
+ *               implementations. The host and firmware drivers both define
+ *               `GCQ_ERRORS_TYPE`, `GCQInstance` etc. so each is wrapped in
+ *               its own translation unit behind this interface.
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+#ifndef GCQ_BENCH_H
+#define GCQ_BENCH_H
+
+/* Standard includes */
+#include <stdint.h>
+
+/*****************************************************************************/
+/* Enums                                                                     */
+/*****************************************************************************/
+
+/**
+ * enum bench_ret - Result of a single ring operation.
+ * @BENCH_OK: Operation completed.
+ * @BENCH_AGAIN: Ring full (produce) or empty (consume), retry later.
+ * @BENCH_ERR: Any other driver error.
+ */
+enum bench_ret {
+	BENCH_OK = 0,
+	BENCH_AGAIN,
+	BENCH_ERR,
+};
+
+/*****************************************************************************/
+/* Host side (sw/AMI/driver/ami_gcq.c)                                       */
+/*****************************************************************************/
+
+/**
+ * bench_host_open() - Open and attach the host (consumer mode) instance.
+ * @base: Start of the register block.
+ * @ring: Start of the ring buffer.
+ * @ring_len: Length of the ring buffer.
+ * @sq_size: Submission queue slot size.
+ * @cq_size: Completion queue slot size.
+ * @coalesce_count: Completions per pointer update, 0 to disable.
+ * @coalesce_delay_ms: Max time the firmware may hold a completion back.
+ *
+ * The firmware instance must have been initialised first so the ring
+ * header is present.
+ *
+ * Return: BENCH_OK or BENCH_ERR.
+ */
+enum bench_ret bench_host_open(void *base, void *ring, uint32_t ring_len,
+	uint32_t sq_size, uint32_t cq_size,
+	uint32_t coalesce_count, uint32_t coalesce_delay_ms);
+
+/**
+ * bench_host_close() - Close the host instance.
+ *
+ * Return: None.
+ */
+void bench_host_close(void);
+
+/**
+ * bench_host_submit() - Produce one request onto the SQ.
+ * @buf: Request, `sq_size` bytes.
+ *
+ * Return: BENCH_OK, BENCH_AGAIN if the SQ is full or BENCH_ERR.
+ */
+enum bench_ret bench_host_submit(uint8_t *buf);
+
+/**
+ * bench_host_complete() - Consume one response from the CQ.
+ * @buf: Buffer for the response, `cq_size` bytes.
+ *
+ * Return: BENCH_OK, BENCH_AGAIN if the CQ is empty or BENCH_ERR.
+ */
+enum bench_ret bench_host_complete(uint8_t *buf);
+
+/*****************************************************************************/
+/* Firmware side (fw/AMC/src/device_drivers/gcq_driver)                      */
+/*****************************************************************************/
+
+/**
+ * bench_fw_init() - Initialise the firmware (producer mode) instance.
+ * @base: Start of the register block.
+ * @ring: Start of the ring buffer.
+ * @ring_len: Length of the ring buffer.
+ * @sq_size: Submission queue slot size.
+ * @cq_size: Completion queue slot size.
+ * @num_slots: Variable to hold the number of slots per queue.
+ *
+ * Return: BENCH_OK or BENCH_ERR.
+ */
+enum bench_ret bench_fw_init(void *base, void *ring, uint32_t ring_len,
+	uint32_t sq_size, uint32_t cq_size, uint32_t *num_slots);
+
+/**
+ * bench_fw_deinit() - Release the firmware instance.
+ *
+ * Return: None.
+ */
+void bench_fw_deinit(void);
+
+/**
+ * bench_fw_consume() - Consume requests from the SQ.
+ * @buf: Buffer for `max` requests of `sq_size` bytes each.
+ * @max: Maximum number of requests.
+ * @batch: Use the batched API (one pointer read/write per call).
+ * @num: Variable to hold the number of requests consumed.
+ *
+ * Return: BENCH_OK, BENCH_AGAIN if the SQ is empty or BENCH_ERR.
+ */
+enum bench_ret bench_fw_consume(uint8_t *buf, uint32_t max, int batch, uint32_t *num);
+
+/**
+ * bench_fw_produce() - Produce responses onto the CQ.
+ * @buf: `count` responses of `cq_size` bytes each.
+ * @count: Number of responses.
+ * @batch: Use the batched API (one pointer write per call).
+ * @num: Variable to hold the number of responses produced.
+ *
+ * Return: BENCH_OK, BENCH_AGAIN if the CQ is full or BENCH_ERR.
+ */
+enum bench_ret bench_fw_produce(uint8_t *buf, uint32_t count, int batch, uint32_t *num);
+
+/**
+ * bench_fw_service() - Run the completion coalescing timer.
+ * @now_ms: Current time in ms.
+ *
+ * Return: None.
+ */
+void bench_fw_service(uint32_t now_ms);
+
+#endif  /* GCQ_BENCH_H */
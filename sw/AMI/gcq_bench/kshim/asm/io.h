@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * io.h - User space stand-in for <asm/io.h>. The "device" is an anonymous
+ *        mapping shared with the firmware thread, so MMIO accessors become
+ *        plain memory accesses with the ordering the sGCQ protocol relies on.
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+#ifndef GCQ_BENCH_SHIM_ASM_IO_H
+#define GCQ_BENCH_SHIM_ASM_IO_H
+
+#include <string.h>
+
+#include <linux/types.h>
+
+#define __iomem
+
+/* A pointer read must not let later slot reads move ahead of it. */
+static inline uint32_t ioread32(const volatile void __iomem *addr)
+{
+	uint32_t val = *(const volatile uint32_t *)addr;
+
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	return val;
+}
+
+/* A pointer write must not become visible before the slot data. */
+static inline void iowrite32(uint32_t val, volatile void __iomem *addr)
+{
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	*(volatile uint32_t *)addr = val;
+}
+
+static inline void memcpy_fromio(void *dst, const volatile void __iomem *src, size_t len)
+{
+	memcpy(dst, (const void *)src, len);
+}
+
+static inline void memcpy_toio(volatile void __iomem *dst, const void *src, size_t len)
+{
+	memcpy((void *)dst, src, len);
+}
+
+#endif  /* GCQ_BENCH_SHIM_ASM_IO_H */
@@ -0,0 +1,15 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * delay.h - User space stand-in for <linux/delay.h>
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+#ifndef GCQ_BENCH_SHIM_LINUX_DELAY_H
+#define GCQ_BENCH_SHIM_LINUX_DELAY_H
+
+#include <unistd.h>
+
+#define msleep(ms)	usleep((ms) * 1000)
+
+#endif  /* GCQ_BENCH_SHIM_LINUX_DELAY_H */
@@ -0,0 +1,11 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * idr.h - User space stand-in for <linux/idr.h> (nothing is used)
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+#ifndef GCQ_BENCH_SHIM_LINUX_IDR_H
+#define GCQ_BENCH_SHIM_LINUX_IDR_H
+
+#endif  /* GCQ_BENCH_SHIM_LINUX_IDR_H */
@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * kernel.h - User space stand-in for <linux/kernel.h>, used to build the host
+ *            sGCQ driver into gcq_bench
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+#ifndef GCQ_BENCH_SHIM_LINUX_KERNEL_H
+#define GCQ_BENCH_SHIM_LINUX_KERNEL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <linux/types.h>
+
+#define KERN_EMERG			""
+#define printk(fmt, ...)		fprintf(stderr, fmt, ##__VA_ARGS__)
+#define dump_stack()			do { } while (0)
+#define BUG()				abort()
+
+#define likely(x)			__builtin_expect(!!(x), 1)
+#define unlikely(x)			__builtin_expect(!!(x), 0)
+
+#define min_t(type, x, y)		((type)(x) < (type)(y) ? (type)(x) : (type)(y))
+
+#define ____cacheline_aligned_in_smp	__attribute__((__aligned__(64)))
+
+#endif  /* GCQ_BENCH_SHIM_LINUX_KERNEL_H */
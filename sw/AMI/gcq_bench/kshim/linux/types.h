@@ -0,0 +1,16 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * types.h - User space stand-in for <linux/types.h>, used to build the host
+ *           sGCQ driver into gcq_bench
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+#ifndef GCQ_BENCH_SHIM_LINUX_TYPES_H
+#define GCQ_BENCH_SHIM_LINUX_TYPES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#endif  /* GCQ_BENCH_SHIM_LINUX_TYPES_H */
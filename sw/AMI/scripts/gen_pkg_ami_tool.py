@@ -236,6 +236,10 @@ def main(args):
         exec_step_cmd('BUILD_AMI_TOOL', step, build_ami_tool, shell=True, cwd=PROJECT_DIR)
         check_file_exists('BUILD_AMI_TOOL', join(PROJECT_DIR, 'app', 'build', 'ami_tool'))
 
+        build_ami_exporterd = 'cd exporter && make clean && make'
+        exec_step_cmd('BUILD_AMI_EXPORTERD', step, build_ami_exporterd, shell=True, cwd=PROJECT_DIR)
+        check_file_exists('BUILD_AMI_EXPORTERD', join(PROJECT_DIR, 'exporter', 'build', 'ami_exporterd'))
+
         step = 'clean AMI Library and ami_tool'
         clean_ami_lib = 'cd api && make clean'
         exec_step_cmd('CLEAN_AMI_LIB', step, clean_ami_lib, shell=True, cwd=PROJECT_DIR)
@@ -244,13 +248,17 @@ def main(args):
         step = 'clean ami_tool'
         clean_ami_tool = 'cd app && make clean'
         exec_step_cmd('CLEAN_AMI_TOOL', step, clean_ami_tool, shell=True, cwd=PROJECT_DIR)
+
+        clean_ami_exporterd = 'cd exporter && make clean'
+        exec_step_cmd('CLEAN_AMI_EXPORTERD', step, clean_ami_exporterd, shell=True, cwd=PROJECT_DIR)
         end_step('BUILD_AMI_TOOL', start_time)
 
-        # Find app sources
-        for path, _, files in walk(join(PROJECT_DIR, 'app')):
-            for name in files:
-                if not path.endswith(('test')):
-                    ami_tool_srcs.append(join(path, name).split(PROJECT_DIR)[-1].split('/', 1)[-1])
+        # Find app and exporter sources
+        for src_dir in ['app', 'exporter']:
+            for path, _, files in walk(join(PROJECT_DIR, src_dir)):
+                for name in files:
+                    if not path.endswith(('test')):
+                        ami_tool_srcs.append(join(path, name).split(PROJECT_DIR)[-1].split('/', 1)[-1])
 
         config['pkg']              =  {}
         config['pkg']['name']      = 'amitool'
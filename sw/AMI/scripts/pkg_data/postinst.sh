@@ -91,6 +91,13 @@ else
     make
     install -m 755 build/ami_tool /usr/local/bin/
 
+    # The metrics exporter daemon ships with the tool
+    find /usr/local/bin -type f -name "ami_exporterd" -delete
+    cd "/usr/src/${MOD_NAME}-${MOD_VER_STR}/exporter" || exit 1
+    make clean
+    make
+    install -m 755 build/ami_exporterd /usr/local/bin/
+
     echo "SUCCESS: ${MOD_NAME} ${MOD_VER_STR} installed"
 fi
 
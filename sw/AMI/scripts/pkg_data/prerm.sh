@@ -44,8 +44,9 @@ elif [ "${MOD_NAME}" == "libami" ]; then
     rm -rf "/usr/include/${MOD_NAME}"
 
 else
-    # Remove binary
+    # Remove binaries
     find /usr/local/bin -type f -name "${MOD_NAME}" -delete
+    find /usr/local/bin -type f -name "ami_exporterd" -delete
 
     # Remove source files
     echo "Removing source files from /usr/src/${MOD_NAME}-${MOD_VER_STR}"